@@ -0,0 +1,64 @@
+/**
+ * @file bench_codec.cpp
+ * @brief Benchmarks for the hex and Base64 text codecs
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "bench_helpers.h"
+
+#include "../src/Utils.h"
+
+#include <benchmark/benchmark.h>
+
+static void BM_ToHex(benchmark::State& state)
+{
+    const auto bytes = make_bench_bytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto hex = seal::utils::to_hex(bytes);
+        benchmark::DoNotOptimize(hex.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ToHex)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_FromHex(benchmark::State& state)
+{
+    const std::string hex =
+        seal::utils::to_hex(make_bench_bytes(static_cast<size_t>(state.range(0))));
+    std::vector<unsigned char> out;
+    for (auto _ : state)
+    {
+        const bool ok = seal::utils::from_hex(hex, out);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FromHex)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_ToBase64(benchmark::State& state)
+{
+    const auto bytes = make_bench_bytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto b64 = seal::utils::toBase64(bytes);
+        benchmark::DoNotOptimize(b64.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ToBase64)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
+
+static void BM_FromBase64(benchmark::State& state)
+{
+    const std::string b64 =
+        seal::utils::toBase64(make_bench_bytes(static_cast<size_t>(state.range(0))));
+    for (auto _ : state)
+    {
+        auto bytes = seal::utils::fromBase64(b64);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FromBase64)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
@@ -0,0 +1,115 @@
+/**
+ * @file bench_crypto.cpp
+ * @brief Benchmarks for key derivation, packet sealing and locked memory
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "bench_helpers.h"
+
+#include <benchmark/benchmark.h>
+
+// One password KDF run per iteration. The argument is log2 N for scrypt at
+// r = 8, p = 1; cfg::SCRYPT_N (2^16) is what every default packet pays.
+static void BM_DeriveMasterKeyScrypt(benchmark::State& state)
+{
+    auto password = make_bench_password();
+    const auto salt = make_bench_bytes(seal::cfg::SALT_LEN);
+    seal::KdfParams kdf;
+    kdf.log2Cost = static_cast<uint8_t>(state.range(0));
+    for (auto _ : state)
+    {
+        auto key = seal::Cryptography::deriveMasterKey(password, salt, kdf);
+        benchmark::DoNotOptimize(key.data());
+    }
+}
+BENCHMARK(BM_DeriveMasterKeyScrypt)->Arg(14)->Arg(16)->Unit(benchmark::kMillisecond);
+
+static void BM_DeriveMasterKeyArgon2id(benchmark::State& state)
+{
+    if (!seal::Cryptography::argon2Available())
+    {
+        state.SkipWithError("Argon2id needs OpenSSL 3.2 or later");
+        return;
+    }
+    auto password = make_bench_password();
+    const auto salt = make_bench_bytes(seal::cfg::SALT_LEN);
+    auto kdf = *seal::KdfParams::parse("argon2id:m=64,t=3,p=1");
+    kdf.lanes = static_cast<uint8_t>(state.range(0));
+    for (auto _ : state)
+    {
+        auto key = seal::Cryptography::deriveMasterKey(password, salt, kdf);
+        benchmark::DoNotOptimize(key.data());
+    }
+}
+BENCHMARK(BM_DeriveMasterKeyArgon2id)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond);
+
+// Self-salted packets: each iteration includes one default scrypt run.
+static void BM_EncryptPacket(benchmark::State& state)
+{
+    auto password = make_bench_password();
+    const auto plain = make_bench_bytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto packet = seal::Cryptography::encryptPacket(plain, password);
+        benchmark::DoNotOptimize(packet.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_EncryptPacket)->Arg(64)->Arg(4 << 10)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_DecryptPacket(benchmark::State& state)
+{
+    auto password = make_bench_password();
+    const auto plain = make_bench_bytes(static_cast<size_t>(state.range(0)));
+    const auto packet = seal::Cryptography::encryptPacket(plain, password);
+    for (auto _ : state)
+    {
+        auto out = seal::Cryptography::decryptPacket(packet, password);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_DecryptPacket)->Arg(64)->Arg(4 << 10)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// AES-256-GCM alone under an already derived key (the vault record path).
+static void BM_EncryptWithKey(benchmark::State& state)
+{
+    const auto key = make_bench_bytes(seal::cfg::KEY_LEN);
+    const auto plain = make_bench_bytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto packet = seal::Cryptography::encryptWithKey(plain, key);
+        benchmark::DoNotOptimize(packet.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_EncryptWithKey)->Arg(64)->Arg(4 << 10)->Arg(64 << 10)->Arg(1 << 20);
+
+static void BM_DecryptWithKey(benchmark::State& state)
+{
+    const auto key = make_bench_bytes(seal::cfg::KEY_LEN);
+    const auto plain = make_bench_bytes(static_cast<size_t>(state.range(0)));
+    const auto packet = seal::Cryptography::encryptWithKey(plain, key);
+    for (auto _ : state)
+    {
+        auto out = seal::Cryptography::decryptWithKey(packet, key);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_DecryptWithKey)->Arg(64)->Arg(4 << 10)->Arg(64 << 10)->Arg(1 << 20);
+
+// Small sizes land in the slab arenas, the others take guard-paged regions.
+static void BM_LockedAllocate(benchmark::State& state)
+{
+    seal::locked_allocator<unsigned char> alloc;
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        unsigned char* p = alloc.allocate(n);
+        benchmark::DoNotOptimize(p);
+        alloc.deallocate(p, n);
+    }
+}
+BENCHMARK(BM_LockedAllocate)->Arg(32)->Arg(256)->Arg(4 << 10)->Arg(64 << 10);
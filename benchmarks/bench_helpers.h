@@ -0,0 +1,73 @@
+/**
+ * @file bench_helpers.h
+ * @brief Shared fixtures for the seal_bench microbenchmarks
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#pragma once
+
+#include "../src/Cryptography.h"
+
+#include <openssl/rand.h>
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief secure_string holding @p s (benchmarks never use real secrets).
+ * @param s Password text.
+ * @return Locked copy of @p s.
+ */
+inline seal::secure_string<> make_bench_password(const std::string& s = "bench_password")
+{
+    seal::secure_string<> result;
+    for (char c : s)
+        result.push_back(c);
+    return result;
+}
+
+/**
+ * @brief @p n random bytes, so GCM and the codecs never see a trivial pattern.
+ * @param n Byte count.
+ * @return Random buffer.
+ */
+inline std::vector<unsigned char> make_bench_bytes(size_t n)
+{
+    std::vector<unsigned char> out(n);
+    if (n && RAND_bytes(out.data(), static_cast<int>(n)) != 1)
+        throw std::runtime_error("RAND_bytes failed");
+    return out;
+}
+
+/**
+ * @brief Scratch directory removed on destruction.
+ */
+class BenchScratch
+{
+public:
+    explicit BenchScratch(const std::string& name)
+        : m_Dir(std::filesystem::temp_directory_path() / name)
+    {
+        std::filesystem::remove_all(m_Dir);
+        std::filesystem::create_directories(m_Dir);
+    }
+    ~BenchScratch()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_Dir, ec);
+    }
+    BenchScratch(const BenchScratch&) = delete;
+    BenchScratch& operator=(const BenchScratch&) = delete;
+
+    /// @brief Path of @p file inside the scratch directory.
+    [[nodiscard]] std::string path(const std::string& file) const
+    {
+        return (m_Dir / file).string();
+    }
+
+private:
+    std::filesystem::path m_Dir;
+};
@@ -0,0 +1,27 @@
+/**
+ * @file bench_main.cpp
+ * @brief Entry point of seal_bench
+ * @author seal Contributors
+ * @date 2024
+ *
+ * Runs with the usual Google Benchmark flags; for CI trend tracking use
+ * `seal_bench --benchmark_out=bench.json --benchmark_out_format=json`.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <QtCore/QLoggingCategory>
+
+int main(int argc, char** argv)
+{
+    // The per-operation seal.* log lines would otherwise be part of every
+    // measurement.
+    QLoggingCategory::setFilterRules(QStringLiteral("seal.*=false"));
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -11,6 +11,9 @@ import QtQuick.Layouts
 // Required properties are injected by the ListView delegate system from the model's
 // role names. `recordIndex` is the real index into Backend::m_Records (stable across
 // filtering); `index` is the visual row position (changes when the filter narrows).
+// clicked() carries the keyboard modifiers so the table can tell a plain click
+// from a Ctrl (toggle) or Shift (range) multi-select click. `auditFlags` carries
+// the last password audit's findings (1 = breached, 2 = reused), never the password.
 
 Item {
     id: root
@@ -20,11 +23,12 @@ Item {
     required property string maskedUsername
     required property string maskedPassword
     required property int recordIndex     // Stable index into Backend::m_Records
-    required property bool selected       // Driven by parent's selectedRow binding
+    required property bool selected       // Driven by parent's selectedRow / selectedRecords binding
+    required property int auditFlags      // seal::VaultAuditFlag bits; 0 = not flagged
     property bool isHovered: mouseArea.containsMouse
     readonly property real contentShift: root.selected ? 2 : root.isHovered ? 1 : 0.0
 
-    signal clicked()
+    signal clicked(int modifiers)
 
     implicitHeight: 48
 
@@ -165,6 +169,27 @@ Item {
                     color: root.selected || root.isHovered ? Theme.accent3 : Theme.accent3Dim
                     Behavior on color { ColorAnimation { duration: Theme.hoverDuration } }
                 }
+
+                // Audit badge. A breach outranks reuse: it is the one to fix first.
+                Rectangle {
+                    readonly property bool breached: (root.auditFlags & 1) !== 0
+                    visible: root.auditFlags !== 0
+                    Layout.alignment: Qt.AlignVCenter
+                    implicitWidth: badgeText.implicitWidth + 12
+                    implicitHeight: badgeText.implicitHeight + 4
+                    radius: height / 2
+                    color: Theme.bgBadge
+
+                    Text {
+                        id: badgeText
+                        anchors.centerIn: parent
+                        text: parent.breached ? "PWNED" : "REUSED"
+                        font.family: Theme.fontFamily
+                        font.pixelSize: Theme.fontSizeSmall
+                        font.bold: true
+                        color: parent.breached ? Theme.textError : Theme.textWarning
+                    }
+                }
             }
         }
 
@@ -174,7 +199,7 @@ Item {
             anchors.fill: parent
             hoverEnabled: true
             cursorShape: Qt.PointingHandCursor
-            onClicked: root.clicked()
+            onClicked: function(mouse) { root.clicked(mouse.modifiers) }
         }
     }
 }
@@ -13,12 +13,20 @@ import QtQuick.Controls
 // The model is a VaultListModel (QAbstractListModel subclass) that exposes
 // platform, maskedUsername, maskedPassword, and recordIndex roles. Filtering
 // is handled inside the model (C++ side) so the ListView just renders what it gets.
-
+//
+// Multi-select: Ctrl+click toggles a row and Shift+click adds the range from the
+// last clicked row. The set is kept as record indices (not visual rows) so it can
+// be handed straight to Backend's bulk operations; a plain click, any change in
+// the row count (filter, delete, load), or any change to the records behind the
+// indices (VaultListModel::recordsChanged: a save compacting deletions, a reload)
+// drops it again.
 Rectangle {
     id: root
 
     property var model              // VaultListModel instance from Backend
     property int selectedRow: -1    // Visual index of the selected row (-1 = none)
+    property var selectedRecords: []   // Multi-selected record indices (Ctrl/Shift+click)
+    property int anchorRow: -1         // Visual row Shift+click ranges start from
     property bool searchActive: false  // True when the search bar has text
     property bool vaultLoaded: false   // Controls which empty-state placeholder shows
     property bool isCompact: false     // Compact mode: scroll to top and hide scrollbar
@@ -27,9 +35,49 @@ Rectangle {
     readonly property bool showEmptyVaultState: listView.count === 0 && root.vaultLoaded && !root.searchActive
 
     signal rowClicked(int row)
+    signal multiSelectionStarted()     // First Ctrl/Shift+click; the single selection is folded in
     signal addAccountRequested()
     signal clearSearchRequested()
 
+    function clearMultiSelection() {
+        root.selectedRecords = [];
+    }
+
+    // The first multi-select click folds the current single selection into the set.
+    function seededSelection() {
+        var records = root.selectedRecords.slice();
+        if (records.length === 0) {
+            if (root.selectedRow >= 0)
+                records.push(root.model.recordIndexForRow(root.selectedRow));
+            root.multiSelectionStarted();
+        }
+        return records;
+    }
+
+    function toggleRow(row) {
+        var records = seededSelection();
+        var record = root.model.recordIndexForRow(row);
+        var at = records.indexOf(record);
+        if (at >= 0)
+            records.splice(at, 1);
+        else
+            records.push(record);
+        root.selectedRecords = records;
+        root.anchorRow = row;
+    }
+
+    function selectRange(row) {
+        var records = seededSelection();
+        var from = Math.min(root.anchorRow, row);
+        var to = Math.max(root.anchorRow, row);
+        for (var r = from; r <= to; ++r) {
+            var record = root.model.recordIndexForRow(r);
+            if (records.indexOf(record) < 0)
+                records.push(record);
+        }
+        root.selectedRecords = records;
+    }
+
     component EmptyStatePanel: Rectangle {
         id: panel
         property string titleText: ""
@@ -289,13 +337,33 @@ Rectangle {
             // Snap to top when entering compact mode.
             onInteractiveChanged: if (!interactive) positionViewAtBeginning()
 
-            // Each delegate receives `selected` from the parent's binding; clicking
-            // a row emits rowClicked(index) which Main.qml handles with toggle logic
-            // (clicking the same row again deselects it).
+            // Record indices in the set may no longer be on screen, or exist.
+            onCountChanged: root.clearMultiSelection()
+
+            // The indices may now name other records, even with the same row count.
+            Connections {
+                target: root.model
+                function onRecordsChanged() { root.clearMultiSelection() }
+            }
+
+            // Each delegate receives `selected` from the parent's bindings; a plain
+            // click emits rowClicked(index) which Main.qml handles with toggle logic
+            // (clicking the same row again deselects it). Ctrl/Shift clicks stay in
+            // the table and edit selectedRecords.
             delegate: AccountRow {
                 width: listView.width
-                selected: root.selectedRow === index
-                onClicked: root.rowClicked(index)
+                selected: root.selectedRow === index || root.selectedRecords.indexOf(recordIndex) >= 0
+                onClicked: function(modifiers) {
+                    if ((modifiers & Qt.ShiftModifier) && root.anchorRow >= 0) {
+                        root.selectRange(index);
+                    } else if (modifiers & (Qt.ControlModifier | Qt.ShiftModifier)) {
+                        root.toggleRow(index);
+                    } else {
+                        root.clearMultiSelection();
+                        root.anchorRow = index;
+                        root.rowClicked(index);
+                    }
+                }
             }
 
             // Empty state placeholders. Two variants:
@@ -17,6 +17,9 @@ import QtQuick.Layouts
 // icon swap (crosshairs vs X), and text that includes the countdown timer.
 //
 // Edit, Delete, and Fill require a row selection; Add is always enabled.
+// With a multi-selection (bulkCount > 0) Delete acts on every selected row and
+// Move/Rotate appear; Edit and Fill stay single-row only. Audit checks the
+// whole vault and needs no selection.
 
 RowLayout {
     id: root
@@ -27,10 +30,14 @@ RowLayout {
     property int fillCountdownSeconds: 0
     property bool isCompact: false
     property bool isBusy: false
+    property int bulkCount: 0        // Rows in the table's multi-selection
 
     signal addClicked()
     signal editClicked()
     signal deleteClicked()
+    signal moveClicked()
+    signal rotateClicked()
+    signal auditClicked()
     signal fillClicked()
     signal cancelFillClicked()
 
@@ -67,9 +74,9 @@ RowLayout {
 
     TintedButton {
         visible: !root.isCompact
-        text: "Delete"
+        text: root.bulkCount > 1 ? "Delete (" + root.bulkCount + ")" : "Delete"
         faIcon: Theme.iconTrash
-        enabled: root.hasSelection
+        enabled: root.hasSelection || root.bulkCount > 0
         tintTop:         Theme.btnDeleteTop
         tintEnd:         Theme.btnDeleteEnd
         tintHoverTop:    Theme.btnDeleteHoverTop
@@ -81,6 +88,52 @@ RowLayout {
         onClicked: root.deleteClicked()
     }
 
+    TintedButton {
+        visible: !root.isCompact && root.bulkCount > 0
+        text: "Move"
+        faIcon: Theme.iconFolderOpen
+        tintTop:         Theme.btnEditTop
+        tintEnd:         Theme.btnEditEnd
+        tintHoverTop:    Theme.btnEditHoverTop
+        tintHoverEnd:    Theme.btnEditHoverEnd
+        tintPressed:     Theme.btnEditPressed
+        tintText:        Theme.btnEditText
+        tintTextHover:   Theme.btnEditTextHover
+
+        onClicked: root.moveClicked()
+    }
+
+    TintedButton {
+        visible: !root.isCompact && root.bulkCount > 0
+        text: "Rotate"
+        faIcon: Theme.iconKey
+        tintTop:         Theme.btnEditTop
+        tintEnd:         Theme.btnEditEnd
+        tintHoverTop:    Theme.btnEditHoverTop
+        tintHoverEnd:    Theme.btnEditHoverEnd
+        tintPressed:     Theme.btnEditPressed
+        tintText:        Theme.btnEditText
+        tintTextHover:   Theme.btnEditTextHover
+
+        onClicked: root.rotateClicked()
+    }
+
+    TintedButton {
+        visible: !root.isCompact && root.bulkCount === 0
+        text: "Audit"
+        faIcon: Theme.iconShieldHalved
+        enabled: !root.isBusy
+        tintTop:         Theme.btnEditTop
+        tintEnd:         Theme.btnEditEnd
+        tintHoverTop:    Theme.btnEditHoverTop
+        tintHoverEnd:    Theme.btnEditHoverEnd
+        tintPressed:     Theme.btnEditPressed
+        tintText:        Theme.btnEditText
+        tintTextHover:   Theme.btnEditTextHover
+
+        onClicked: root.auditClicked()
+    }
+
     // Fill button. Separate from TintedButton because it has two entirely different
     // visual states (normal yellow-green vs armed opaque orange) that need independent
     // color branches in the gradient stops, plus dynamic text showing the countdown.
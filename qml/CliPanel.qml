@@ -6,43 +6,41 @@ import QtQuick.Layouts
 //
 // Replaces the main vault UI (SearchBar, AccountsTable, ActionBar)
 // when CLI mode is toggled via the window chrome button. Commands are dispatched
-// to Backend.executeCliCommand() and output is received via Backend.cliOutputReady.
+// to Backend.executeCliCommand() and output is received via Backend.cliOutputReady,
+// which delivers at most one batch of lines per frame. Long jobs run on a worker,
+// so the panel stays usable; :cancel or Escape stops them.
 
 Item {
     id: root
 
     // Accumulated output text. Using a single string + TextArea instead of
     // a ListView so the user can select and copy arbitrary spans of output.
-    // Capped at _maxLines to prevent unbounded growth during long sessions.
+    // The lines live in a ring of _maxLines so long sessions stay bounded;
+    // the text is rebuilt once per delivered batch, not once per line.
     property string outputText: ""
-    property int _lineCount: 0
+    property var _lines: []
     readonly property int _maxLines: 500
-    readonly property int _trimTarget: 400
-
-    function _appendOutput(line) {
-        if (outputText.length > 0)
-            outputText += "\n"
-        outputText += line
-        _lineCount++
-
-        // Trim oldest lines in batches to avoid O(n) split/join on every append.
-        if (_lineCount > _maxLines) {
-            var lines = outputText.split("\n")
-            outputText = lines.slice(lines.length - _trimTarget).join("\n")
-            _lineCount = _trimTarget
-        }
+
+    function _appendLines(lines) {
+        for (var i = 0; i < lines.length; ++i)
+            _lines.push(lines[i])
+        if (_lines.length > _maxLines)
+            _lines.splice(0, _lines.length - _maxLines)
+        outputText = _lines.join("\n")
 
         Qt.callLater(function() {
             outputScroll.ScrollBar.vertical.position = 1.0 - outputScroll.ScrollBar.vertical.size
         })
     }
 
+    function _appendOutput(line) { _appendLines([line]) }
+
     Connections {
         target: Backend
-        function onCliOutputReady(text) { root._appendOutput(text) }
+        function onCliOutputReady(lines) { root._appendLines(lines) }
         function onCliOutputCleared() {
+            root._lines = []
             root.outputText = ""
-            root._lineCount = 0
         }
     }
 
@@ -114,7 +112,9 @@ Item {
             TextField {
                 id: inputField
                 Layout.fillWidth: true
-                placeholderText: "Type a command... (:help for commands)"
+                placeholderText: Backend.isCliRunning
+                                 ? "Running... (:cancel or Esc to stop)"
+                                 : "Type a command... (:help for commands)"
                 placeholderTextColor: Theme.textPlaceholder
                 color: Theme.textPrimary
                 font.family: Theme.fontMono
@@ -137,6 +137,11 @@ Item {
 
                 Keys.onReturnPressed: submitCommand()
                 Keys.onEnterPressed: submitCommand()
+                Keys.onEscapePressed: function(event) {
+                    event.accepted = Backend.isCliRunning
+                    if (event.accepted)
+                        Backend.cancelCliCommand()
+                }
 
                 function submitCommand() {
                     var cmd = inputField.text.trim()
@@ -149,8 +154,12 @@ Item {
         }
     }
 
-    // Focus the input field when the panel becomes visible
+    // Focus the input field when the panel becomes visible. The panel is
+    // created on first entry into CLI mode, already visible.
     onVisibleChanged: {
         if (visible) inputField.forceActiveFocus()
     }
+    Component.onCompleted: {
+        if (visible) inputField.forceActiveFocus()
+    }
 }
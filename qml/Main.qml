@@ -1,3 +1,5 @@
+pragma ComponentBehavior: Bound
+
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
@@ -8,8 +10,8 @@ import QtQuick.Window
 // Responsibilities:
 //   - Owns the top-level layout (header, search, table, actions, footer)
 //   - Wires every Backend signal to the appropriate dialog (password, error, info, edit, delete)
-//   - Manages dialog instances (created once, shown/hidden via open()/close() to avoid
-//     repeated QML object creation and to preserve state across re-shows)
+//   - Manages dialog instances (created on first use through a Loader, then kept
+//     and shown/hidden via open()/close() to preserve state across re-shows)
 //   - Drives startup (autoLoadVault) and shutdown (cleanup) lifecycle hooks
 //
 // Data flow:
@@ -56,22 +58,32 @@ ApplicationWindow {
         target: Backend
 
         function onErrorOccurred(title, message) {
-            errorDialog.title = title;
-            errorDialog.message = message;
-            errorDialog.open();
+            var dlg = window.dialog(errorDialogLoader);
+            dlg.title = title;
+            dlg.message = message;
+            dlg.open();
         }
 
         // Resolves record index to platform name for the confirmation message.
         function onConfirmDeleteRequested(index, platform) {
-            confirmDlg.deleteIndex = index;
-            confirmDlg.message = "Are you sure you want to delete the account for '" + platform + "'?";
-            confirmDlg.open();
+            var dlg = window.dialog(confirmDlgLoader);
+            dlg.deleteIndex = index;
+            dlg.message = "Are you sure you want to delete the account for '" + platform + "'?";
+            dlg.open();
         }
 
         function onInfoMessage(title, message) {
-            infoDialog.title = title;
-            infoDialog.message = message;
-            infoDialog.open();
+            var dlg = window.dialog(infoDialogLoader);
+            dlg.title = title;
+            dlg.message = message;
+            dlg.open();
+        }
+
+        // The CLI panel is built the first time CLI mode is entered and kept
+        // afterwards, so its scrollback survives toggling back and forth.
+        function onCliModeChanged() {
+            if (Backend.isCliMode)
+                cliPanelLoader.active = true;
         }
 
         // First password prompt, no error message.
@@ -106,27 +118,69 @@ ApplicationWindow {
             }
         }
 
+        // Vault load/save worker progress. total is 0 until the worker knows
+        // the record count; the footer bar is hidden again once busy clears.
+        function onOperationProgress(done, total) {
+            statusFooter.operationRunning = true;
+            statusFooter.progressDone = done;
+            statusFooter.progressTotal = total;
+        }
+
+        function onBusyChanged() {
+            if (!Backend.isBusy)
+                statusFooter.operationRunning = false;
+        }
+
         // Deferred edit path: if no password was set when the user clicked Edit,
         // the Backend queued the decrypt and emits this signal once the password
         // dialog completes and decryption succeeds. The data map carries the
         // plaintext fields for one-time display in the edit dialog.
         function onEditAccountReady(data) {
-            accountDlg.dialogTitle = "Edit Account";
-            accountDlg.editIndex = data.editIndex;
-            accountDlg.initialService = data.service;
-            accountDlg.initialUsername = data.username;
-            accountDlg.initialPassword = data.password;
-            accountDlg.open();
+            var dlg = window.dialog(accountDlgLoader);
+            dlg.dialogTitle = "Edit Account";
+            dlg.editIndex = data.editIndex;
+            dlg.initialService = data.service;
+            dlg.initialUsername = data.username;
+            dlg.initialPassword = data.password;
+            dlg.open();
         }
     }
 
+    // Returns the dialog behind a lazily loaded Loader, creating it on first
+    // use. Loaders are synchronous, so the item exists when this returns.
+    function dialog(loader) {
+        loader.active = true;
+        return loader.item;
+    }
+
     function openAddAccountDialog() {
-        accountDlg.dialogTitle = "Add Account";
-        accountDlg.editIndex = -1;
-        accountDlg.initialService = "";
-        accountDlg.initialUsername = "";
-        accountDlg.initialPassword = "";
-        accountDlg.open();
+        var dlg = window.dialog(accountDlgLoader);
+        dlg.dialogTitle = "Add Account";
+        dlg.editIndex = -1;
+        dlg.initialService = "";
+        dlg.initialUsername = "";
+        dlg.initialPassword = "";
+        dlg.open();
+    }
+
+    // Confirmation for a bulk action over record indices ("delete" or "rotate").
+    function confirmBulk(action, records) {
+        var dlg = window.dialog(bulkConfirmDlgLoader);
+        dlg.action = action;
+        dlg.records = records.slice();
+        if (action === "rotate") {
+            dlg.title = "Confirm Rotate";
+            dlg.titleIcon = Theme.iconKey;
+            dlg.tone = Theme.btnEditText;
+            dlg.message = "Replace the passwords of " + records.length
+                        + " accounts with newly generated ones? The old passwords are lost once the vault is saved.";
+        } else {
+            dlg.title = "Confirm Delete";
+            dlg.titleIcon = Theme.iconTrash;
+            dlg.tone = Theme.btnDeleteText;
+            dlg.message = "Are you sure you want to delete " + records.length + " accounts?";
+        }
+        dlg.open();
     }
 
     Component.onCompleted: {
@@ -421,8 +475,10 @@ ApplicationWindow {
                 onSearchRequested: function(text) { Backend.searchFilter = text }
             }
 
-            // Toggle-select: clicking the same row deselects it.
+            // Toggle-select: clicking the same row deselects it. Ctrl/Shift
+            // clicks build a multi-selection inside the table instead.
             AccountsTable {
+                id: accountsTable
                 Layout.fillWidth: true
                 Layout.fillHeight: true
                 visible: !Backend.isCliMode
@@ -436,6 +492,7 @@ ApplicationWindow {
                 onRowClicked: function(row) {
                     Backend.selectedIndex = (Backend.selectedIndex === row) ? -1 : row;
                 }
+                onMultiSelectionStarted: Backend.selectedIndex = -1
 
                 onAddAccountRequested: window.openAddAccountDialog()
                 onClearSearchRequested: {
@@ -456,6 +513,7 @@ ApplicationWindow {
                 fillCountdownSeconds: Backend.fillCountdownSeconds
                 isCompact: Backend.isCompact
                 isBusy: Backend.isBusy
+                bulkCount: accountsTable.selectedRecords.length
 
                 onAddClicked: {
                     window.openAddAccountDialog();
@@ -469,20 +527,26 @@ ApplicationWindow {
                     var realIdx = Backend.vaultModel.recordIndexForRow(Backend.selectedIndex);
                     var data = Backend.decryptAccountForEdit(realIdx);
                     if (!data.service) return;
-                    accountDlg.dialogTitle = "Edit Account";
-                    accountDlg.editIndex = realIdx;
-                    accountDlg.initialService = data.service;
-                    accountDlg.initialUsername = data.username;
-                    accountDlg.initialPassword = data.password;
-                    accountDlg.open();
+                    var dlg = window.dialog(accountDlgLoader);
+                    dlg.dialogTitle = "Edit Account";
+                    dlg.editIndex = realIdx;
+                    dlg.initialService = data.service;
+                    dlg.initialUsername = data.username;
+                    dlg.initialPassword = data.password;
+                    dlg.open();
                 }
 
                 onDeleteClicked: {
+                    if (accountsTable.selectedRecords.length > 0) {
+                        window.confirmBulk("delete", accountsTable.selectedRecords);
+                        return;
+                    }
                     if (!Backend.hasSelection) return;
                     var realIdx = Backend.vaultModel.recordIndexForRow(Backend.selectedIndex);
-                    confirmDlg.deleteIndex = realIdx;
-                    confirmDlg.message = "Are you sure you want to delete this account?";
-                    confirmDlg.open();
+                    var dlg = window.dialog(confirmDlgLoader);
+                    dlg.deleteIndex = realIdx;
+                    dlg.message = "Are you sure you want to delete this account?";
+                    dlg.open();
                 }
 
                 // Arms global mouse/keyboard hooks via FillController. The seal
@@ -498,31 +562,45 @@ ApplicationWindow {
                 onCancelFillClicked: {
                     Backend.cancelFill();
                 }
+
+                // Bulk actions take record indices straight from the table's
+                // multi-selection, so no row-to-record mapping is needed here.
+                onMoveClicked: Backend.moveAccounts(accountsTable.selectedRecords)
+                onRotateClicked: window.confirmBulk("rotate", accountsTable.selectedRecords)
+                onAuditClicked: Backend.auditPasswords()
             }
 
-            // CLI panel (shown only in CLI mode)
-            CliPanel {
+            // CLI panel (shown only in CLI mode, created on first entry)
+            Loader {
+                id: cliPanelLoader
                 Layout.fillWidth: true
                 Layout.fillHeight: true
                 visible: Backend.isCliMode
+                active: false
+                sourceComponent: Component { CliPanel { } }
             }
         }
 
         // Status footer (hidden in compact mode)
         StatusFooter {
+            id: statusFooter
             Layout.fillWidth: true
             visible: !Backend.isCompact
             statusText: Backend.statusText
             fillArmed: Backend.isFillArmed
             vaultFileName: Backend.vaultFileName
             accountCount: Backend.vaultModel.count
+            onCancelRequested: Backend.cancelOperation()
         }
     }
 
     // -- Dialogs --
-    // All dialogs are instantiated once at startup and reused via open()/close().
-    // This avoids repeated QML object construction (expensive for styled popups)
-    // and keeps dialog state (e.g. error messages) stable across re-shows.
+    // The password dialog is needed on nearly every start, so it is built with
+    // the window. The others sit behind inactive Loaders and are only built
+    // the first time window.dialog() opens them. After that they are reused
+    // via open()/close() like before, which keeps dialog state (e.g. error
+    // messages) stable across re-shows. The Loaders fill the window so
+    // `anchors.centerIn: parent` in each popup still centres it.
 
     // Master password entry. Blocks all interaction until submitted. The Backend
     // stores a pending action lambda that re-executes once the password is set,
@@ -538,26 +616,63 @@ ApplicationWindow {
     }
 
     // Add/edit dialog. editIdx == -1 means add; >= 0 means edit.
-    AccountDialog {
-        id: accountDlg
-        onAccepted: function(service, username, password, editIdx) {
-            if (editIdx >= 0)
-                Backend.editAccount(editIdx, service, username, password);
-            else
-                Backend.addAccount(service, username, password);
+    Loader {
+        id: accountDlgLoader
+        anchors.fill: parent
+        active: false
+        sourceComponent: Component {
+            AccountDialog {
+                onAccepted: function(service, username, password, editIdx) {
+                    if (editIdx >= 0)
+                        Backend.editAccount(editIdx, service, username, password);
+                    else
+                        Backend.addAccount(service, username, password);
+                }
+            }
         }
     }
 
     // Soft-delete: marks record as deleted in memory, removed on next save.
-    ConfirmDialog {
-        id: confirmDlg
-        title: "Confirm Delete"
-        property int deleteIndex: -1
+    Loader {
+        id: confirmDlgLoader
+        anchors.fill: parent
+        active: false
+        sourceComponent: Component {
+            ConfirmDialog {
+                id: confirmDlg
+                title: "Confirm Delete"
+                property int deleteIndex: -1
+
+                onConfirmed: {
+                    if (confirmDlg.deleteIndex >= 0)
+                        Backend.deleteAccount(confirmDlg.deleteIndex);
+                    confirmDlg.deleteIndex = -1;
+                }
+            }
+        }
+    }
 
-        onConfirmed: {
-            if (deleteIndex >= 0)
-                Backend.deleteAccount(deleteIndex);
-            deleteIndex = -1;
+    // Bulk delete / password rotation over the table's multi-selection. Both
+    // run as one Backend call, so the model refreshes once for the whole set.
+    Loader {
+        id: bulkConfirmDlgLoader
+        anchors.fill: parent
+        active: false
+        sourceComponent: Component {
+            ConfirmDialog {
+                id: bulkConfirmDlg
+                property string action: ""
+                property var records: []
+
+                onConfirmed: {
+                    if (bulkConfirmDlg.action === "delete")
+                        Backend.deleteAccounts(bulkConfirmDlg.records);
+                    else if (bulkConfirmDlg.action === "rotate")
+                        Backend.rotateAccountPasswords(bulkConfirmDlg.records);
+                    accountsTable.clearMultiSelection();
+                    bulkConfirmDlg.records = [];
+                }
+            }
         }
     }
 
@@ -565,207 +680,221 @@ ApplicationWindow {
     // contentItem entirely: shows an exclamation icon + message + single OK
     // button (no Yes/No). This avoids creating a separate Popup component
     // just for a different button layout.
-    ConfirmDialog {
-        id: errorDialog
-        tone: Theme.textError
-        contentItem: ColumnLayout {
-            spacing: 0
+    Loader {
+        id: errorDialogLoader
+        anchors.fill: parent
+        active: false
+        sourceComponent: Component {
+            ConfirmDialog {
+                id: errorDialog
+                tone: Theme.textError
+                contentItem: ColumnLayout {
+                    spacing: 0
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        Layout.topMargin: 24
+                        Layout.leftMargin: 24
+                        Layout.rightMargin: 24
+                        spacing: 8
+
+                        Item {
+                            Layout.alignment: Qt.AlignVCenter
+                            Layout.preferredWidth: Theme.px(28)
+                            Layout.preferredHeight: Theme.px(28)
+
+                            SvgIcon {
+                                source: Theme.iconTriangleExclamation
+                                width: Theme.px(14)
+                                height: Theme.px(14)
+                                color: Theme.textError
+                                anchors.centerIn: parent
+                            }
+                        }
 
-            RowLayout {
-                Layout.fillWidth: true
-                Layout.topMargin: 24
-                Layout.leftMargin: 24
-                Layout.rightMargin: 24
-                spacing: 8
-
-                Item {
-                    Layout.alignment: Qt.AlignVCenter
-                    Layout.preferredWidth: Theme.px(28)
-                    Layout.preferredHeight: Theme.px(28)
-
-                    SvgIcon {
-                        source: Theme.iconTriangleExclamation
-                        width: Theme.px(14)
-                        height: Theme.px(14)
-                        color: Theme.textError
-                        anchors.centerIn: parent
+                        Text {
+                            Layout.fillWidth: true
+                            text: errorDialog.title
+                            font.family: Theme.fontFamily
+                            font.pixelSize: Theme.px(16)
+                            font.bold: true
+                            color: Theme.textPrimary
+                        }
                     }
-                }
 
-                Text {
-                    Layout.fillWidth: true
-                    text: errorDialog.title
-                    font.family: Theme.fontFamily
-                    font.pixelSize: Theme.px(16)
-                    font.bold: true
-                    color: Theme.textPrimary
-                }
-            }
-
-            Text {
-                Layout.fillWidth: true
-                Layout.topMargin: 12
-                Layout.leftMargin: 24
-                Layout.rightMargin: 24
-                text: errorDialog.message
-                font.family: Theme.fontFamily
-                font.pixelSize: Theme.fontSizeMedium
-                color: Theme.textSecondary
-                wrapMode: Text.WordWrap
-            }
-
-            RowLayout {
-                Layout.fillWidth: true
-                Layout.topMargin: 24
-                Layout.bottomMargin: 20
-                Layout.rightMargin: 24
-                spacing: Theme.spacingSmall
-
-                Item { Layout.fillWidth: true }
-
-                Button {
-                    id: errorOkButton
-                    text: "OK"
-                    onClicked: errorDialog.close()
-
-                    HoverHandler { id: errorOkHover; cursorShape: Qt.PointingHandCursor }
-
-                    scale: pressed ? 0.97 : 1.0
-                    Behavior on scale { NumberAnimation { duration: 200; easing.type: Easing.OutBack; easing.overshoot: 2.0 } }
-
-                    contentItem: Text {
-                        text: "OK"
+                    Text {
+                        Layout.fillWidth: true
+                        Layout.topMargin: 12
+                        Layout.leftMargin: 24
+                        Layout.rightMargin: 24
+                        text: errorDialog.message
                         font.family: Theme.fontFamily
                         font.pixelSize: Theme.fontSizeMedium
-                        font.weight: Font.DemiBold
-                        color: Theme.textOnAccent
-                        horizontalAlignment: Text.AlignHCenter
-                        verticalAlignment: Text.AlignVCenter
+                        color: Theme.textSecondary
+                        wrapMode: Text.WordWrap
                     }
-                    background: Rectangle {
-                        implicitWidth: 110
-                        implicitHeight: 34
-                        radius: Theme.radiusMedium
-                        clip: true
-                        gradient: Gradient {
-                            GradientStop { position: 0; color: errorOkButton.pressed ? Theme.btnPressTop : errorOkButton.hovered ? Theme.btnHoverTop : Theme.btnGradTop; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
-                            GradientStop { position: 1; color: errorOkButton.pressed ? Theme.btnPressBot : errorOkButton.hovered ? Theme.btnHoverBot : Theme.btnGradBot; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
-                        }
-                        border.width: 1
-                        border.color: errorOkButton.hovered ? Theme.borderBright : Theme.borderBtn
-                        Behavior on border.color { ColorAnimation { duration: Theme.hoverDuration } }
-
-                        RippleEffect {
-                            id: errorOkRipple
-                            baseColor: Qt.rgba(Theme.textOnAccent.r, Theme.textOnAccent.g, Theme.textOnAccent.b, 0.30)
-                            cornerRadius: parent.radius
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        Layout.topMargin: 24
+                        Layout.bottomMargin: 20
+                        Layout.rightMargin: 24
+                        spacing: Theme.spacingSmall
+
+                        Item { Layout.fillWidth: true }
+
+                        Button {
+                            id: errorOkButton
+                            text: "OK"
+                            onClicked: errorDialog.close()
+
+                            HoverHandler { id: errorOkHover; cursorShape: Qt.PointingHandCursor }
+
+                            scale: pressed ? 0.97 : 1.0
+                            Behavior on scale { NumberAnimation { duration: 200; easing.type: Easing.OutBack; easing.overshoot: 2.0 } }
+
+                            contentItem: Text {
+                                text: "OK"
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeMedium
+                                font.weight: Font.DemiBold
+                                color: Theme.textOnAccent
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+                            background: Rectangle {
+                                implicitWidth: 110
+                                implicitHeight: 34
+                                radius: Theme.radiusMedium
+                                clip: true
+                                gradient: Gradient {
+                                    GradientStop { position: 0; color: errorOkButton.pressed ? Theme.btnPressTop : errorOkButton.hovered ? Theme.btnHoverTop : Theme.btnGradTop; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
+                                    GradientStop { position: 1; color: errorOkButton.pressed ? Theme.btnPressBot : errorOkButton.hovered ? Theme.btnHoverBot : Theme.btnGradBot; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
+                                }
+                                border.width: 1
+                                border.color: errorOkButton.hovered ? Theme.borderBright : Theme.borderBtn
+                                Behavior on border.color { ColorAnimation { duration: Theme.hoverDuration } }
+
+                                RippleEffect {
+                                    id: errorOkRipple
+                                    baseColor: Qt.rgba(Theme.textOnAccent.r, Theme.textOnAccent.g, Theme.textOnAccent.b, 0.30)
+                                    cornerRadius: parent.radius
+                                }
+                            }
+                            onPressed: errorOkRipple.trigger(errorOkHover.point.position.x, errorOkHover.point.position.y)
                         }
                     }
-                    onPressed: errorOkRipple.trigger(errorOkHover.point.position.x, errorOkHover.point.position.y)
                 }
             }
         }
     }
 
     // Success/info messages (e.g. "Vault saved", "Directory encrypted").
-    ConfirmDialog {
-        id: infoDialog
-        tone: Theme.accent
-
-        contentItem: ColumnLayout {
-            spacing: 0
+    Loader {
+        id: infoDialogLoader
+        anchors.fill: parent
+        active: false
+        sourceComponent: Component {
+            ConfirmDialog {
+                id: infoDialog
+                tone: Theme.accent
+
+                contentItem: ColumnLayout {
+                    spacing: 0
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        Layout.topMargin: 24
+                        Layout.leftMargin: 24
+                        Layout.rightMargin: 24
+                        spacing: 8
+
+                        Item {
+                            Layout.alignment: Qt.AlignVCenter
+                            Layout.preferredWidth: Theme.px(28)
+                            Layout.preferredHeight: Theme.px(28)
+
+                            SvgIcon {
+                                source: Theme.iconCircleCheck
+                                width: Theme.px(14)
+                                height: Theme.px(14)
+                                color: Theme.accent
+                                anchors.centerIn: parent
+                            }
+                        }
 
-            RowLayout {
-                Layout.fillWidth: true
-                Layout.topMargin: 24
-                Layout.leftMargin: 24
-                Layout.rightMargin: 24
-                spacing: 8
-
-                Item {
-                    Layout.alignment: Qt.AlignVCenter
-                    Layout.preferredWidth: Theme.px(28)
-                    Layout.preferredHeight: Theme.px(28)
-
-                    SvgIcon {
-                        source: Theme.iconCircleCheck
-                        width: Theme.px(14)
-                        height: Theme.px(14)
-                        color: Theme.accent
-                        anchors.centerIn: parent
+                        Text {
+                            Layout.fillWidth: true
+                            text: infoDialog.title
+                            font.family: Theme.fontFamily
+                            font.pixelSize: Theme.px(16)
+                            font.bold: true
+                            color: Theme.textPrimary
+                        }
                     }
-                }
-
-                Text {
-                    Layout.fillWidth: true
-                    text: infoDialog.title
-                    font.family: Theme.fontFamily
-                    font.pixelSize: Theme.px(16)
-                    font.bold: true
-                    color: Theme.textPrimary
-                }
-            }
-
-            Text {
-                Layout.fillWidth: true
-                Layout.topMargin: 12
-                Layout.leftMargin: 24
-                Layout.rightMargin: 24
-                text: infoDialog.message
-                font.family: Theme.fontFamily
-                font.pixelSize: Theme.fontSizeMedium
-                color: Theme.textSecondary
-                wrapMode: Text.WordWrap
-            }
 
-            RowLayout {
-                Layout.fillWidth: true
-                Layout.topMargin: 24
-                Layout.bottomMargin: 20
-                Layout.rightMargin: 24
-                spacing: Theme.spacingSmall
-
-                Item { Layout.fillWidth: true }
-
-                Button {
-                    id: infoOkButton
-                    text: "OK"
-                    onClicked: infoDialog.close()
-
-                    HoverHandler { id: infoOkHover; cursorShape: Qt.PointingHandCursor }
-
-                    scale: pressed ? 0.97 : 1.0
-                    Behavior on scale { NumberAnimation { duration: 200; easing.type: Easing.OutBack; easing.overshoot: 2.0 } }
-
-                    contentItem: Text {
-                        text: "OK"
+                    Text {
+                        Layout.fillWidth: true
+                        Layout.topMargin: 12
+                        Layout.leftMargin: 24
+                        Layout.rightMargin: 24
+                        text: infoDialog.message
                         font.family: Theme.fontFamily
                         font.pixelSize: Theme.fontSizeMedium
-                        font.weight: Font.DemiBold
-                        color: Theme.textOnAccent
-                        horizontalAlignment: Text.AlignHCenter
-                        verticalAlignment: Text.AlignVCenter
+                        color: Theme.textSecondary
+                        wrapMode: Text.WordWrap
                     }
-                    background: Rectangle {
-                        implicitWidth: 110
-                        implicitHeight: 34
-                        radius: Theme.radiusMedium
-                        clip: true
-                        gradient: Gradient {
-                            GradientStop { position: 0; color: infoOkButton.pressed ? Theme.btnPressTop : infoOkButton.hovered ? Theme.btnHoverTop : Theme.btnGradTop; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
-                            GradientStop { position: 1; color: infoOkButton.pressed ? Theme.btnPressBot : infoOkButton.hovered ? Theme.btnHoverBot : Theme.btnGradBot; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
-                        }
-                        border.width: 1
-                        border.color: infoOkButton.hovered ? Theme.borderBright : Theme.borderBtn
-                        Behavior on border.color { ColorAnimation { duration: Theme.hoverDuration } }
-
-                        RippleEffect {
-                            id: infoOkRipple
-                            baseColor: Qt.rgba(Theme.textOnAccent.r, Theme.textOnAccent.g, Theme.textOnAccent.b, 0.30)
-                            cornerRadius: parent.radius
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        Layout.topMargin: 24
+                        Layout.bottomMargin: 20
+                        Layout.rightMargin: 24
+                        spacing: Theme.spacingSmall
+
+                        Item { Layout.fillWidth: true }
+
+                        Button {
+                            id: infoOkButton
+                            text: "OK"
+                            onClicked: infoDialog.close()
+
+                            HoverHandler { id: infoOkHover; cursorShape: Qt.PointingHandCursor }
+
+                            scale: pressed ? 0.97 : 1.0
+                            Behavior on scale { NumberAnimation { duration: 200; easing.type: Easing.OutBack; easing.overshoot: 2.0 } }
+
+                            contentItem: Text {
+                                text: "OK"
+                                font.family: Theme.fontFamily
+                                font.pixelSize: Theme.fontSizeMedium
+                                font.weight: Font.DemiBold
+                                color: Theme.textOnAccent
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+                            background: Rectangle {
+                                implicitWidth: 110
+                                implicitHeight: 34
+                                radius: Theme.radiusMedium
+                                clip: true
+                                gradient: Gradient {
+                                    GradientStop { position: 0; color: infoOkButton.pressed ? Theme.btnPressTop : infoOkButton.hovered ? Theme.btnHoverTop : Theme.btnGradTop; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
+                                    GradientStop { position: 1; color: infoOkButton.pressed ? Theme.btnPressBot : infoOkButton.hovered ? Theme.btnHoverBot : Theme.btnGradBot; Behavior on color { ColorAnimation { duration: Theme.hoverDuration } } }
+                                }
+                                border.width: 1
+                                border.color: infoOkButton.hovered ? Theme.borderBright : Theme.borderBtn
+                                Behavior on border.color { ColorAnimation { duration: Theme.hoverDuration } }
+
+                                RippleEffect {
+                                    id: infoOkRipple
+                                    baseColor: Qt.rgba(Theme.textOnAccent.r, Theme.textOnAccent.g, Theme.textOnAccent.b, 0.30)
+                                    cornerRadius: parent.radius
+                                }
+                            }
+                            onPressed: infoOkRipple.trigger(infoOkHover.point.position.x, infoOkHover.point.position.y)
                         }
                     }
-                    onPressed: infoOkRipple.trigger(infoOkHover.point.position.x, infoOkHover.point.position.y)
                 }
             }
         }
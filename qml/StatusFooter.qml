@@ -4,10 +4,13 @@ import QtQuick.Layouts
 // Bottom status bar. Spans the full window width (sits outside the inner
 // content margins) to create a clear visual boundary.
 //
-// Layout: [status text] ... [vault filename] | [N accounts] [armed dot]
+// Layout: [status text] [progress bar, cancel] ... [vault filename] | [N accounts] [armed dot]
 //
 // The pulsing orange dot appears only when auto-fill hooks are armed,
 // giving the user a persistent visual reminder that global hooks are active.
+//
+// The progress bar shows while a vault load/save runs on the worker thread.
+// It is determinate once the worker has reported a record total.
 
 Rectangle {
     id: root
@@ -16,6 +19,11 @@ Rectangle {
     property bool fillArmed: false
     property string vaultFileName: ""
     property int accountCount: 0
+    property bool operationRunning: false
+    property int progressDone: 0
+    property int progressTotal: 0
+
+    signal cancelRequested()
 
     implicitHeight: 36
     gradient: Gradient {
@@ -47,6 +55,43 @@ Rectangle {
             color: Theme.textSubtle
         }
 
+        // Vault load/save progress
+        Rectangle {
+            visible: root.operationRunning
+            Layout.preferredWidth: 120
+            Layout.preferredHeight: 4
+            radius: 2
+            color: Theme.borderSoft
+
+            Rectangle {
+                anchors.left: parent.left
+                anchors.top: parent.top
+                anchors.bottom: parent.bottom
+                radius: parent.radius
+                color: Theme.accent
+                width: root.progressTotal > 0
+                       ? parent.width * Math.min(1, root.progressDone / root.progressTotal)
+                       : 0
+                Behavior on width { NumberAnimation { duration: 120 } }
+            }
+        }
+
+        Text {
+            visible: root.operationRunning
+            text: "Cancel"
+            font.family: Theme.fontFamily
+            font.pixelSize: Theme.fontSizeSmall
+            color: cancelArea.containsMouse ? Theme.accent : Theme.textMuted
+
+            MouseArea {
+                id: cancelArea
+                anchors.fill: parent
+                hoverEnabled: true
+                cursorShape: Qt.PointingHandCursor
+                onClicked: root.cancelRequested()
+            }
+        }
+
         Item { Layout.fillWidth: true }
 
         // Vault filename
@@ -0,0 +1,626 @@
+#include "Agent.h"
+
+#include "ScopedDpapiUnprotect.h"
+#include "Utils.h"
+#include "WorkingSet.h"
+
+#ifdef USE_QT_UI
+#include <QtCore/QString>
+#include "Vault.h"
+#endif
+
+#include <sddl.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+using seal::agent::Verb;
+
+// A connected client gets this long to finish sending a line or to take
+// a reply before it is dropped, so a stalled script cannot hold the pipe.
+constexpr DWORD kIoTimeoutMs = 5000;
+// How long a client waits for the agent to finish with another client.
+constexpr DWORD kBusyWaitMs = 2000;
+constexpr DWORD kPipeBuffer = 64 * 1024;
+
+constexpr std::array<Verb, 5> kVerbs{
+    Verb::Ping, Verb::Encrypt, Verb::Decrypt, Verb::Lookup, Verb::Lock};
+
+std::string_view trimLine(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\n')
+        line.remove_suffix(1);
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    return line;
+}
+
+#ifdef USE_QT_UI
+std::span<const unsigned char> asBytes(std::string_view s)
+{
+    return {reinterpret_cast<const unsigned char*>(s.data()), s.size()};
+}
+#endif
+
+// Same rule as `seal -d`: hex is the stricter test, so it goes first.
+bool looksHex(std::string_view s)
+{
+    return s.size() % 2 == 0 && s.size() >= 4 &&
+           std::all_of(
+               s.begin(), s.end(), [](unsigned char c) { return std::isxdigit(c) != 0; });
+}
+
+// TOKEN_USER of @p process, as a buffer the SID points into. Empty if the
+// token cannot be opened or read.
+std::vector<unsigned char> tokenUser(HANDLE process)
+{
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(process, TOKEN_QUERY, &token))
+        return {};
+
+    DWORD needed = 0;
+    (void)GetTokenInformation(token, TokenUser, nullptr, 0, &needed);
+    std::vector<unsigned char> buffer(needed);
+    const bool ok =
+        needed != 0 && GetTokenInformation(token, TokenUser, buffer.data(), needed, &needed);
+    CloseHandle(token);
+    if (!ok)
+        buffer.clear();
+    return buffer;
+}
+
+std::string currentUserSid()
+{
+    const std::vector<unsigned char> user = tokenUser(GetCurrentProcess());
+    LPSTR sid = nullptr;
+    if (user.empty() ||
+        !ConvertSidToStringSidA(reinterpret_cast<const TOKEN_USER*>(user.data())->User.Sid, &sid))
+        throw std::runtime_error("Cannot read the user SID");
+    std::string out(sid);
+    LocalFree(sid);
+    return out;
+}
+
+// Whether the process serving @p pipe runs as this user in this session.
+// The pipe name alone proves nothing: any process can create it first and
+// would then receive `encrypt` plaintext and answer `decrypt` and `lookup`.
+bool servedByCurrentUser(HANDLE pipe)
+{
+    ULONG serverPid = 0;
+    DWORD serverSession = 0;
+    DWORD session = 0;
+    if (!GetNamedPipeServerProcessId(pipe, &serverPid) ||
+        !ProcessIdToSessionId(serverPid, &serverSession) ||
+        !ProcessIdToSessionId(GetCurrentProcessId(), &session) || serverSession != session)
+        return false;
+
+    HANDLE server = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, serverPid);
+    if (!server)
+        return false;
+    const std::vector<unsigned char> serverUser = tokenUser(server);
+    CloseHandle(server);
+    const std::vector<unsigned char> user = tokenUser(GetCurrentProcess());
+    return !serverUser.empty() && !user.empty() &&
+           EqualSid(reinterpret_cast<const TOKEN_USER*>(serverUser.data())->User.Sid,
+                    reinterpret_cast<const TOKEN_USER*>(user.data())->User.Sid);
+}
+
+// Run an overlapped ReadFile/WriteFile that was just started to completion,
+// or cancel it after timeoutMs. Returns false on failure or timeout.
+bool finishIo(HANDLE pipe, OVERLAPPED& ov, BOOL started, DWORD timeoutMs, DWORD& bytes)
+{
+    if (!started && GetLastError() != ERROR_IO_PENDING)
+        return false;
+    if (WaitForSingleObject(ov.hEvent, timeoutMs) != WAIT_OBJECT_0)
+    {
+        CancelIoEx(pipe, &ov);
+        (void)GetOverlappedResult(pipe, &ov, &bytes, TRUE);
+        return false;
+    }
+    return GetOverlappedResult(pipe, &ov, &bytes, FALSE) != 0;
+}
+
+bool writeAll(HANDLE pipe, HANDLE event, std::string_view data)
+{
+    while (!data.empty())
+    {
+        OVERLAPPED ov{};
+        ov.hEvent = event;
+        DWORD written = 0;
+        const auto chunk = static_cast<DWORD>(std::min<size_t>(data.size(), kPipeBuffer));
+        const BOOL started = WriteFile(pipe, data.data(), chunk, nullptr, &ov);
+        if (!finishIo(pipe, ov, started, kIoTimeoutMs, written) || written == 0)
+            return false;
+        data.remove_prefix(written);
+    }
+    return true;
+}
+
+// Read from the pipe into `buffer` until it holds a full line. Returns
+// false on disconnect, timeout, or a line over kMaxLine.
+bool readLine(HANDLE pipe, HANDLE event, std::string& buffer, size_t& scanned)
+{
+    std::array<char, 4096> chunk;
+    for (;;)
+    {
+        if (buffer.find('\n', scanned) != std::string::npos)
+            return true;
+        scanned = buffer.size();
+        if (buffer.size() > seal::agent::kMaxLine)
+            return false;
+
+        OVERLAPPED ov{};
+        ov.hEvent = event;
+        DWORD got = 0;
+        const BOOL started =
+            ReadFile(pipe, chunk.data(), static_cast<DWORD>(chunk.size()), nullptr, &ov);
+        const bool ok = finishIo(pipe, ov, started, kIoTimeoutMs, got);
+        if (got)
+            buffer.append(chunk.data(), got);
+        SecureZeroMemory(chunk.data(), got);
+        if (!ok || got == 0)
+            return false;
+    }
+}
+
+}  // namespace
+
+namespace seal::agent
+{
+
+std::string_view name(Verb verb) noexcept
+{
+    switch (verb)
+    {
+        case Verb::Ping:
+            return "ping";
+        case Verb::Encrypt:
+            return "encrypt";
+        case Verb::Decrypt:
+            return "decrypt";
+        case Verb::Lookup:
+            return "lookup";
+        case Verb::Lock:
+            return "lock";
+    }
+    return "unknown";
+}
+
+std::optional<Request> parseRequest(std::string_view line)
+{
+    line = trimLine(line);
+    const size_t space = line.find(' ');
+    const std::string_view word = line.substr(0, space);
+    for (Verb verb : kVerbs)
+    {
+        if (word == name(verb))
+        {
+            Request request;
+            request.verb = verb;
+            if (space != std::string_view::npos)
+                request.payload.assign(line.substr(space + 1));
+            return request;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string formatRequest(Verb verb, std::string_view payload)
+{
+    std::string line(name(verb));
+    if (!payload.empty())
+    {
+        line += ' ';
+        line += payload;
+    }
+    line += '\n';
+    return line;
+}
+
+std::optional<Reply> parseReply(std::string_view line)
+{
+    line = trimLine(line);
+    const size_t space = line.find(' ');
+    const std::string_view word = line.substr(0, space);
+    if (word != "ok" && word != "err")
+        return std::nullopt;
+
+    Reply reply;
+    reply.ok = word == "ok";
+    if (space != std::string_view::npos)
+        reply.payload.assign(line.substr(space + 1));
+    return reply;
+}
+
+std::string formatReply(bool ok, std::string_view payload)
+{
+    std::string line = ok ? "ok" : "err";
+    if (!payload.empty())
+    {
+        line += ' ';
+        line += payload;
+    }
+    line += '\n';
+    return line;
+}
+
+std::wstring pipeName()
+{
+    DWORD session = 0;
+    (void)ProcessIdToSessionId(GetCurrentProcessId(), &session);
+    const std::string sid = currentUserSid();
+    std::wstring name = L"\\\\.\\pipe\\seal-agent-";
+    name.append(sid.begin(), sid.end());
+    name += L'-';
+    name += std::to_wstring(session);
+    return name;
+}
+
+std::optional<Reply> call(Verb verb, std::string_view payload)
+{
+    const std::wstring path = pipeName();
+    HANDLE pipe = INVALID_HANDLE_VALUE;
+    for (int attempt = 0; attempt < 2 && pipe == INVALID_HANDLE_VALUE; ++attempt)
+    {
+        // Identification level: a process squatting on the name could learn
+        // who connected, but never act as this user.
+        pipe = CreateFileW(path.c_str(),
+                           GENERIC_READ | GENERIC_WRITE,
+                           0,
+                           nullptr,
+                           OPEN_EXISTING,
+                           FILE_FLAG_OVERLAPPED | SECURITY_SQOS_PRESENT | SECURITY_IDENTIFICATION,
+                           nullptr);
+        if (pipe == INVALID_HANDLE_VALUE &&
+            (GetLastError() != ERROR_PIPE_BUSY || !WaitNamedPipeW(path.c_str(), kBusyWaitMs)))
+            return std::nullopt;
+    }
+    if (pipe == INVALID_HANDLE_VALUE)
+        return std::nullopt;
+    if (!servedByCurrentUser(pipe))
+    {
+        CloseHandle(pipe);
+        throw std::runtime_error("Agent pipe is not served by this user");
+    }
+
+    HANDLE event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    std::string request = formatRequest(verb, payload);
+    std::string buffer;
+    size_t scanned = 0;
+    const bool ok =
+        event && writeAll(pipe, event, request) && readLine(pipe, event, buffer, scanned);
+    seal::Cryptography::cleanseString(request);
+    if (event)
+        CloseHandle(event);
+    CloseHandle(pipe);
+    if (!ok)
+    {
+        seal::Cryptography::cleanseString(buffer);
+        throw std::runtime_error("Agent connection failed");
+    }
+
+    auto reply = parseReply(std::string_view(buffer).substr(0, buffer.find('\n')));
+    seal::Cryptography::cleanseString(buffer);
+    if (!reply)
+        throw std::runtime_error("Malformed agent reply");
+    return reply;
+}
+
+struct Server::VaultState
+{
+#ifdef USE_QT_UI
+    std::vector<seal::VaultRecord> records;
+    seal::VaultKeyCache keyCache;
+#endif
+};
+
+Server::Server(Password password)
+    : m_Password(std::move(password)),
+      m_Guard(&m_Password)
+{
+}
+
+Server::~Server()
+{
+    m_Keyring.clear();
+#ifdef USE_QT_UI
+    if (m_Vault)
+        m_Vault->keyCache.clear();
+#endif
+}
+
+size_t Server::loadVault(const std::string& vaultPath)
+{
+#ifdef USE_QT_UI
+    auto vault = std::make_unique<VaultState>();
+    {
+        ScopedDpapiUnprotect scope(m_Guard);
+        vault->records =
+            seal::loadVaultIndex(QString::fromStdString(vaultPath), m_Password, &vault->keyCache);
+    }
+    const auto live = static_cast<size_t>(std::count_if(vault->records.begin(),
+                                                        vault->records.end(),
+                                                        [](const auto& r) { return !r.deleted; }));
+    m_Vault = std::move(vault);
+    // Best-effort, like VirtualLock itself; `--stats` shows the outcome.
+    (void)seal::working_set::reserve(m_Vault->records.size(),
+                                     seal::Cryptography::kdfParams().memoryBytes());
+    return live;
+#else
+    (void)vaultPath;
+    throw std::runtime_error("Vault support unavailable in this build");
+#endif
+}
+
+std::string Server::handle(std::string_view line)
+{
+    auto request = parseRequest(line);
+    if (!request)
+        return formatReply(false, "bad_request");
+    // An encrypt payload is the caller's plaintext; wipe it on every branch.
+    struct PayloadWipe
+    {
+        std::string& payload;
+        ~PayloadWipe() { seal::Cryptography::cleanseString(payload); }
+    } wipe{request->payload};
+    if (m_Locked)
+        return formatReply(false, "locked");
+
+    switch (request->verb)
+    {
+        case Verb::Ping:
+            return formatReply(true);
+        case Verb::Encrypt:
+            return encrypt(request->payload);
+        case Verb::Decrypt:
+            return decrypt(request->payload);
+        case Verb::Lookup:
+            return lookup(request->payload);
+        case Verb::Lock:
+            m_Locked = true;
+            return formatReply(true);
+    }
+    return formatReply(false, "bad_request");
+}
+
+std::string Server::encrypt(std::string_view b64)
+{
+    std::vector<unsigned char> plain(3 * (b64.size() / 4));
+    const auto written = seal::utils::base64Decode(b64, plain);
+    if (!written)
+        return formatReply(false, "invalid_encoding");
+    plain.resize(*written);
+
+    try
+    {
+        ScopedDpapiUnprotect scope(m_Guard);
+        auto master = m_Keyring.batchKey(m_Password);
+        std::vector<unsigned char> packet;
+        try
+        {
+            packet = seal::Cryptography::sealKeyedPacket(
+                plain, master, m_Keyring.salt(), m_Keyring.kdf());
+        }
+        catch (...)
+        {
+            seal::Cryptography::cleanseString(master);
+            throw;
+        }
+        seal::Cryptography::cleanseString(master, plain);
+        return formatReply(true, seal::utils::to_hex(packet));
+    }
+    catch (const std::exception&)
+    {
+        seal::Cryptography::cleanseString(plain);
+        return formatReply(false, "encrypt_failed");
+    }
+}
+
+std::string Server::decrypt(std::string_view encoded)
+{
+    std::vector<unsigned char> packet;
+    if (looksHex(encoded))
+    {
+        if (!seal::utils::from_hex(encoded, packet))
+            return formatReply(false, "invalid_encoding");
+    }
+    else
+    {
+        packet.resize(3 * (encoded.size() / 4));
+        const auto written = seal::utils::base64Decode(encoded, packet);
+        if (!written || *written == 0)
+            return formatReply(false, "invalid_encoding");
+        packet.resize(*written);
+    }
+
+    std::vector<unsigned char> plain;
+    try
+    {
+        ScopedDpapiUnprotect scope(m_Guard);
+        if (seal::Cryptography::isSegmentedPacket(packet))
+        {
+            // Keyed packets (this agent's own among them) hit the master-key
+            // cache; plain segmented ones derive their salt as before.
+            auto key = m_Keyring.fileKey(m_Password, packet);
+            try
+            {
+                plain = seal::Cryptography::openSegmentedPacket(packet, key);
+            }
+            catch (...)
+            {
+                seal::Cryptography::cleanseString(key);
+                throw;
+            }
+            seal::Cryptography::cleanseString(key);
+        }
+        else
+        {
+            plain = seal::Cryptography::decryptPacket(std::span<const unsigned char>(packet),
+                                                      m_Password);
+        }
+    }
+    catch (const std::exception&)
+    {
+        return formatReply(false, "decrypt_failed");
+    }
+
+    std::string reply = formatReply(true, seal::utils::toBase64(plain));
+    seal::Cryptography::cleanseString(plain);
+    return reply;
+}
+
+std::string Server::lookup(std::string_view platform)
+{
+#ifdef USE_QT_UI
+    if (!m_Vault)
+        return formatReply(false, "no_vault");
+    const auto& records = m_Vault->records;
+    auto it = std::find_if(records.begin(),
+                           records.end(),
+                           [&](const seal::VaultRecord& r)
+                           { return !r.deleted && r.platform == platform; });
+    if (it == records.end())
+        return formatReply(false, "not_found");
+
+    try
+    {
+        ScopedDpapiUnprotect scope(m_Guard);
+        auto cred = seal::decryptCredentialOnDemand(*it, m_Password, &m_Vault->keyCache);
+        std::string user = seal::utils::secureWideToUtf8(cred.username);
+        std::string pass = seal::utils::secureWideToUtf8(cred.password);
+        cred.cleanse();
+        std::string payload = seal::utils::toBase64(asBytes(user));
+        payload += ' ';
+        payload += seal::utils::toBase64(asBytes(pass));
+        std::string reply = formatReply(true, payload);
+        seal::Cryptography::cleanseString(user, pass, payload);
+        return reply;
+    }
+    catch (const std::exception&)
+    {
+        return formatReply(false, "decrypt_failed");
+    }
+#else
+    (void)platform;
+    return formatReply(false, "no_vault");
+#endif
+}
+
+Stop Server::serve(std::chrono::seconds idleTtl)
+{
+    // Protected DACL: the current user and SYSTEM only, nothing inherited.
+    const std::string sddl = "D:P(A;;GA;;;SY)(A;;GA;;;" + currentUserSid() + ")";
+    PSECURITY_DESCRIPTOR sd = nullptr;
+    if (!ConvertStringSecurityDescriptorToSecurityDescriptorA(
+            sddl.c_str(), SDDL_REVISION_1, &sd, nullptr))
+        throw std::runtime_error("Cannot build the agent pipe ACL");
+    SECURITY_ATTRIBUTES sa{sizeof(sa), sd, FALSE};
+
+    // FIRST_PIPE_INSTANCE fails if the name exists, so the agent never joins
+    // a pipe someone else created.
+    HANDLE pipe = CreateNamedPipeW(
+        pipeName().c_str(),
+        PIPE_ACCESS_DUPLEX | FILE_FLAG_FIRST_PIPE_INSTANCE | FILE_FLAG_OVERLAPPED,
+        PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+        1,
+        kPipeBuffer,
+        kPipeBuffer,
+        0,
+        &sa);
+    const DWORD createError = GetLastError();
+    LocalFree(sd);
+    if (pipe == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error(createError == ERROR_ACCESS_DENIED ||
+                                         createError == ERROR_PIPE_BUSY
+                                     ? "Agent already running"
+                                     : "Cannot create the agent pipe");
+    }
+    HANDLE event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!event)
+    {
+        CloseHandle(pipe);
+        throw std::runtime_error("CreateEvent failed");
+    }
+
+    const DWORD idleMs =
+        idleTtl.count() > 0
+            ? static_cast<DWORD>(std::min<long long>(
+                  std::chrono::duration_cast<std::chrono::milliseconds>(idleTtl).count(),
+                  INFINITE - 1))
+            : INFINITE;
+    Stop stop = Stop::Locked;
+    while (!m_Locked)
+    {
+        OVERLAPPED ov{};
+        ov.hEvent = event;
+        if (!ConnectNamedPipe(pipe, &ov))
+        {
+            const DWORD error = GetLastError();
+            if (error == ERROR_IO_PENDING)
+            {
+                const DWORD wait = WaitForSingleObject(event, idleMs);
+                DWORD unused = 0;
+                if (wait == WAIT_TIMEOUT)
+                {
+                    CancelIoEx(pipe, &ov);
+                    (void)GetOverlappedResult(pipe, &ov, &unused, TRUE);
+                    stop = Stop::Idle;
+                    break;
+                }
+                if (wait != WAIT_OBJECT_0 || !GetOverlappedResult(pipe, &ov, &unused, FALSE))
+                {
+                    CloseHandle(event);
+                    CloseHandle(pipe);
+                    throw std::runtime_error("Waiting for agent clients failed");
+                }
+            }
+            else if (error != ERROR_PIPE_CONNECTED)
+            {
+                CloseHandle(event);
+                CloseHandle(pipe);
+                throw std::runtime_error("ConnectNamedPipe failed");
+            }
+        }
+
+        // One client at a time; requests are milliseconds, and a client that
+        // stalls mid-line is cut off after kIoTimeoutMs.
+        std::string buffer;
+        size_t scanned = 0;
+        while (!m_Locked && readLine(pipe, event, buffer, scanned))
+        {
+            const size_t end = buffer.find('\n');
+            std::string reply = handle(std::string_view(buffer).substr(0, end));
+            const bool sent = writeAll(pipe, event, reply);
+            seal::Cryptography::cleanseString(reply);
+            std::fill_n(buffer.begin(), end + 1, '\0');
+            buffer.erase(0, end + 1);
+            scanned = 0;
+            if (!sent)
+                break;
+        }
+        // After `lock`, let the client read its reply and hang up before the
+        // disconnect discards anything still in the pipe.
+        if (m_Locked)
+            (void)readLine(pipe, event, buffer, scanned);
+        seal::Cryptography::cleanseString(buffer);
+        DisconnectNamedPipe(pipe);
+    }
+
+    CloseHandle(event);
+    CloseHandle(pipe);
+    m_Keyring.clear();
+#ifdef USE_QT_UI
+    if (m_Vault)
+        m_Vault->keyCache.clear();
+#endif
+    return stop;
+}
+
+}  // namespace seal::agent
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "Cryptography.h"
+#include "CryptoGuards.h"
+#include "FileKeyring.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace seal
+{
+/**
+ * @namespace seal::agent
+ * @brief Long-running unlocked agent that serves scripted requests over a named pipe.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup CLI
+ *
+ * `seal agent` reads the master password once and keeps it, DPAPI-guarded,
+ * in locked memory; `seal -e --agent`, `seal -d --agent`, `seal lookup` and
+ * `seal lock` then talk to it instead of prompting and running a KDF of
+ * their own. A script that reads thirty secrets pays for one unlock.
+ *
+ * ## :material-pipe: Protocol
+ *
+ * One request per line, one reply line per request, any number of
+ * requests per connection:
+ *
+ * | Request                 | Reply                              |
+ * |-------------------------|------------------------------------|
+ * | `ping`                  | `ok`                               |
+ * | `encrypt <b64 plain>`   | `ok <hex packet>`                  |
+ * | `decrypt <hex or b64>`  | `ok <b64 plain>`                   |
+ * | `lookup <platform>`     | `ok <b64 username> <b64 password>` |
+ * | `lock`                  | `ok`, then the agent exits         |
+ *
+ * Failures reply `err <reason>` with a fixed snake_case reason.
+ *
+ * ## :material-key-chain: Keys
+ *
+ * Encryption seals keyed segmented packets under the agent's FileKeyring
+ * batch salt (Cryptography::sealKeyedPacket()), so no request runs a KDF;
+ * the packets still decrypt anywhere with just the password. Decryption
+ * reuses the keyring's master-key cache for keyed packets and pays one KDF
+ * for packets that carry a salt of their own (`seal -e` output). Lookups
+ * go through a VaultKeyCache over the vault loaded at startup.
+ *
+ * ## :material-shield-lock: Access
+ *
+ * The pipe is per user and per logon session, created with a protected
+ * DACL that grants only the current user and SYSTEM, rejects remote
+ * clients, and refuses to start if the name already exists. Clients
+ * connect at identification level, so the agent can never impersonate
+ * them. After an idle TTL with no request the agent wipes its keys and exits.
+ */
+namespace agent
+{
+
+/**
+ * @brief Request verbs.
+ * @ingroup CLI
+ */
+enum class Verb : uint8_t
+{
+    Ping,     ///< Liveness check
+    Encrypt,  ///< Seal Base64 plaintext, reply with a hex packet
+    Decrypt,  ///< Open a hex or Base64 packet, reply with Base64 plaintext
+    Lookup,   ///< Decrypt the credential of a vault platform
+    Lock      ///< Wipe keys and stop the agent
+};
+
+/**
+ * @struct Request
+ * @brief One parsed request line.
+ * @ingroup CLI
+ */
+struct Request
+{
+    Verb verb = Verb::Ping;
+    std::string payload;  ///< Everything after the verb and one space
+};
+
+/**
+ * @struct Reply
+ * @brief One parsed reply line.
+ * @ingroup CLI
+ */
+struct Reply
+{
+    bool ok = false;
+    std::string payload;  ///< Result on success, the reason on failure
+};
+
+/// @brief Longest request or reply line accepted, newline excluded.
+inline constexpr size_t kMaxLine = size_t{8} << 20;
+
+/// @brief Default idle time before the agent exits.
+inline constexpr std::chrono::minutes kDefaultTtl{15};
+
+/// @brief Wire name of @p verb (e.g. `encrypt`).
+[[nodiscard]] std::string_view name(Verb verb) noexcept;
+
+/**
+ * @brief Parse a request line.
+ * @param line Line without its `\n`; a trailing `\r` is ignored.
+ * @return The request, or `std::nullopt` for an unknown verb.
+ */
+[[nodiscard]] std::optional<Request> parseRequest(std::string_view line);
+
+/// @brief Render a request line, `\n` included.
+[[nodiscard]] std::string formatRequest(Verb verb, std::string_view payload = {});
+
+/**
+ * @brief Parse a reply line.
+ * @param line Line without its `\n`; a trailing `\r` is ignored.
+ * @return The reply, or `std::nullopt` if it is neither `ok` nor `err`.
+ */
+[[nodiscard]] std::optional<Reply> parseReply(std::string_view line);
+
+/// @brief Render a reply line, `\n` included.
+[[nodiscard]] std::string formatReply(bool ok, std::string_view payload = {});
+
+/**
+ * @brief Pipe path of the current user's agent in this logon session.
+ * @return `\\.\pipe\seal-agent-<user SID>-<session id>`.
+ * @throw std::runtime_error if the process token cannot be read.
+ */
+[[nodiscard]] std::wstring pipeName();
+
+/**
+ * @brief Send one request to the running agent and wait for its reply.
+ *
+ * Nothing is sent until the process serving the pipe is known to run as
+ * this user in this session, so a process that squats on the pipe name
+ * neither receives the request nor gets to forge the reply.
+ *
+ * @param verb    Request verb.
+ * @param payload Request payload.
+ * @return The reply, or `std::nullopt` if no agent is listening.
+ * @throw std::runtime_error on a broken connection, a malformed reply, or a
+ *        pipe served by another user or session.
+ */
+[[nodiscard]] std::optional<Reply> call(Verb verb, std::string_view payload = {});
+
+/**
+ * @brief Why Server::serve() returned.
+ * @ingroup CLI
+ */
+enum class Stop : uint8_t
+{
+    Locked,  ///< A client sent `lock`
+    Idle     ///< No request within the idle TTL
+};
+
+/**
+ * @class Server
+ * @brief Unlocked key holder behind the agent pipe.
+ * @ingroup CLI
+ *
+ * handle() is the whole protocol and needs no pipe, so it can be driven
+ * in-process; serve() only connects clients to it, one at a time.
+ */
+class Server
+{
+public:
+    using Password = seal::basic_secure_string<wchar_t>;
+
+    /// @brief Take ownership of @p password and DPAPI-protect it until needed.
+    explicit Server(Password password);
+
+    /// @brief Destructor. Wipes the password and every cached key.
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * @brief Load the vault `lookup` requests are answered from.
+     *
+     * Decrypting the index also proves the password before any client
+     * relies on it.
+     *
+     * @param vaultPath Vault file (UTF-8).
+     * @return Number of live records.
+     * @throw std::runtime_error on a wrong password, a bad file, or a build
+     *        without vault support.
+     */
+    size_t loadVault(const std::string& vaultPath);
+
+    /**
+     * @brief Answer one request line.
+     * @param line Request line, with or without its `\n`.
+     * @return Reply line, `\n` included.
+     */
+    [[nodiscard]] std::string handle(std::string_view line);
+
+    /// @brief True once a `lock` request was handled.
+    [[nodiscard]] bool locked() const noexcept { return m_Locked; }
+
+    /**
+     * @brief Create the agent pipe and answer clients until locked or idle.
+     * @param idleTtl Time without a request before returning; zero waits forever.
+     * @return Why the loop ended.
+     * @throw std::runtime_error if the pipe cannot be created (e.g. an agent
+     *        is already running) or waiting on it fails.
+     */
+    Stop serve(std::chrono::seconds idleTtl);
+
+private:
+    struct VaultState;
+
+    std::string encrypt(std::string_view b64);
+    std::string decrypt(std::string_view encoded);
+    std::string lookup(std::string_view platform);
+
+    Password m_Password;
+    DPAPIGuard<Password> m_Guard;
+    FileKeyring m_Keyring;
+    std::unique_ptr<VaultState> m_Vault;
+    bool m_Locked = false;
+};
+
+}  // namespace agent
+}  // namespace seal
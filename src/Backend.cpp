@@ -2,6 +2,8 @@
 
 #include "Backend.h"
 
+#include "BreachIndex.h"
+#include "CameraSelector.h"
 #include "CliDispatch.h"
 #include "CliHandler.h"
 #include "Clipboard.h"
@@ -16,15 +18,21 @@
 #include "VaultModel.h"
 #include "WindowChrome.h"
 #include "WindowController.h"
+#include "WorkingSet.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
+#include <QtCore/QSettings>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtGui/QGuiApplication>
+#include <QtGui/QSessionManager>
 #include <QtGui/QWindow>
+#include <QtQml/QJSEngine>
 
 #include <windows.h>
 
@@ -34,7 +42,10 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 // Concrete alias used throughout this file.
 using ScopedDpapiUnprotect =
@@ -43,6 +54,43 @@ using ScopedDpapiUnprotect =
 namespace seal
 {
 
+// Vault files at least this large are loaded memory-mapped, so credential
+// packets stay in the file rather than in the heap (see VaultMapping).
+constexpr qint64 kMappedVaultBytes = 4 * 1024 * 1024;
+
+// CLI output reaches QML at most once per frame, and no more lines are kept
+// queued than CliPanel.qml retains.
+constexpr int kCliFlushIntervalMs = 16;
+constexpr qsizetype kCliMaxPendingLines = 500;
+
+// QSettings key of the vault opened or saved last, tried before any scan.
+constexpr auto kLastVaultKey = "vault/lastPath";
+
+// QSettings key of the opt-in credential prefetch on row selection.
+constexpr auto kPrefetchKey = "fill/prefetchOnSelect";
+
+// QSettings keys of the opt-in quick unlock and the lifetime of a parked session.
+constexpr auto kQuickUnlockKey = "security/quickUnlock";
+constexpr auto kQuickUnlockMinutesKey = "security/quickUnlockMinutes";
+
+// QSettings key of the breach list (Pwned Passwords index or dump) last audited against.
+constexpr auto kBreachIndexKey = "audit/breachIndex";
+
+static std::chrono::minutes quickUnlockLifetime()
+{
+    const int minutes =
+        QSettings().value(kQuickUnlockMinutesKey, seal::cfg::QUICK_UNLOCK_MINUTES).toInt();
+    return std::chrono::minutes(
+        std::clamp(minutes, 1, static_cast<int>(seal::cfg::QUICK_UNLOCK_MAX_MINUTES)));
+}
+
+// First `*.seal` file in @p root, or an empty string. Runs on pool threads.
+static QString firstVaultIn(const QString& root)
+{
+    const QFileInfoList files = QDir(root).entryInfoList(QStringList() << "*.seal", QDir::Files);
+    return files.isEmpty() ? QString{} : files.first().absoluteFilePath();
+}
+
 basic_secure_string<wchar_t, locked_allocator<wchar_t>> Backend::qstringToSecureWide(
     const QString& qstr)
 {
@@ -63,10 +111,22 @@ Backend::Backend(QObject* parent)
     : QObject(parent),
       m_Model(new VaultListModel(this)),
       m_FillController(new FillController(this)),
-      m_WindowController(new WindowController(this))
+      m_WindowController(new WindowController(this)),
+      m_KeyCache(std::make_shared<seal::VaultKeyCache>()),
+      m_Prefetch(std::make_unique<seal::CredentialPrefetch>(
+          std::chrono::milliseconds(seal::cfg::PREFETCH_TTL_MS))),
+      m_PrefetchEnabled(QSettings().value(kPrefetchKey, false).toBool()),
+      m_QuickUnlock(std::make_unique<seal::QuickUnlock>()),
+      m_QuickUnlockEnabled(QSettings().value(kQuickUnlockKey, false).toBool()),
+      m_CameraPrewarm(std::make_unique<seal::CameraPrewarm>()),
+      m_CliFlushTimer(new QTimer(this))
 {
     m_Model->setRecords(&m_Records, &m_RecordsGeneration);
 
+    m_CliFlushTimer->setSingleShot(true);
+    m_CliFlushTimer->setInterval(kCliFlushIntervalMs);
+    connect(m_CliFlushTimer, &QTimer::timeout, this, &Backend::flushCliOutput);
+
     // Relay WindowController state to QML.
     connect(m_WindowController,
             &WindowController::alwaysOnTopChanged,
@@ -74,6 +134,29 @@ Backend::Backend(QObject* parent)
             &Backend::alwaysOnTopChanged);
     connect(m_WindowController, &WindowController::compactChanged, this, &Backend::compactChanged);
 
+    // The password dialog offers QR unlock; get the camera stack loaded
+    // while the user decides, off the UI thread.
+    connect(this, &Backend::passwordRequired, this, [this] { m_CameraPrewarm->start(); });
+
+    // A vault change noticed while locked is merged once the password is back.
+    connect(this,
+            &Backend::passwordSetChanged,
+            this,
+            [this]
+            {
+                if (m_PasswordSet && m_DiskChangePending)
+                    QTimer::singleShot(0, this, [this] { onVaultFileChanged(); });
+            });
+
+    // A parked quick-unlock session must not survive the logon session.
+    if (qGuiApp)
+    {
+        connect(qGuiApp,
+                &QGuiApplication::commitDataRequest,
+                this,
+                [this](QSessionManager&) { m_QuickUnlock->clear(); });
+    }
+
     // Relay FillController state to QML so the UI can react to fill progress.
     connect(m_FillController, &FillController::armedChanged, this, &Backend::fillArmedChanged);
     connect(m_FillController,
@@ -121,6 +204,20 @@ Backend::Backend(QObject* parent)
             });
 }
 
+void Backend::setQmlInstance(Backend* backend)
+{
+    s_QmlInstance = backend;
+}
+
+Backend* Backend::create(QQmlEngine*, QJSEngine* jsEngine)
+{
+    Q_ASSERT(s_QmlInstance);
+    Q_ASSERT(jsEngine->thread() == s_QmlInstance->thread());
+    // The engine must not delete an instance that lives on RunQMLMode()'s stack.
+    QJSEngine::setObjectOwnership(s_QmlInstance, QJSEngine::CppOwnership);
+    return s_QmlInstance;
+}
+
 Backend::~Backend()
 {
     try
@@ -164,7 +261,65 @@ void Backend::setSelectedIndex(int index)
     if (m_SelectedIndex == index)
         return;
     m_SelectedIndex = index;
+    // The previous row's credential must not outlive its selection.
+    m_Prefetch->clear();
     emit selectionChanged();
+    startPrefetch();
+}
+
+bool Backend::isPrefetchEnabled() const
+{
+    return m_PrefetchEnabled;
+}
+
+void Backend::setPrefetchEnabled(bool enabled)
+{
+    if (m_PrefetchEnabled == enabled)
+        return;
+    m_PrefetchEnabled = enabled;
+    QSettings().setValue(kPrefetchKey, enabled);
+    if (enabled)
+        startPrefetch();
+    else
+        m_Prefetch->clear();
+    emit prefetchEnabledChanged();
+}
+
+bool Backend::isQuickUnlockEnabled() const
+{
+    return m_QuickUnlockEnabled;
+}
+
+void Backend::setQuickUnlockEnabled(bool enabled)
+{
+    if (m_QuickUnlockEnabled == enabled)
+        return;
+    m_QuickUnlockEnabled = enabled;
+    QSettings().setValue(kQuickUnlockKey, enabled);
+    if (!enabled)
+        m_QuickUnlock->clear();
+    emit quickUnlockEnabledChanged();
+}
+
+void Backend::startPrefetch()
+{
+    const int index = m_SelectedIndex;
+    if (!m_PrefetchEnabled || !m_PasswordSet || index < 0 || index >= (int)m_Records.size() ||
+        m_Records[index].deleted)
+        return;
+
+    seal::basic_secure_string<wchar_t> pw;
+    {
+        ScopedDpapiUnprotect scope(m_DPAPIGuard);
+        pw.s.assign(m_Password.s.begin(), m_Password.s.end());
+    }
+    m_Prefetch->start(index, m_RecordsGeneration, m_Records[index], std::move(pw), m_KeyCache);
+
+    // Wipe an untaken result once its TTL is up; a later prefetch's sweep
+    // leaves that one alone until its own TTL passes.
+    QTimer::singleShot(std::chrono::milliseconds(seal::cfg::PREFETCH_TTL_MS),
+                       this,
+                       [this] { m_Prefetch->sweep(); });
 }
 
 QString Backend::statusText() const
@@ -220,6 +375,10 @@ bool Backend::ensurePassword()
     if (m_PasswordSet)
         return true;
 
+    // A session parked by lockVault() resumes after Windows Hello instead.
+    if (tryQuickUnlock())
+        return false;
+
     // Signal the QML layer to show the password dialog.
     // The caller should have already stashed a lambda in m_PendingAction
     // so submitPassword() can resume the operation once the user enters it.
@@ -227,11 +386,92 @@ bool Backend::ensurePassword()
     return false;
 }
 
+bool Backend::tryQuickUnlock()
+{
+    if (!m_QuickUnlockEnabled || !m_QuickUnlock->parked())
+        return false;
+    if (m_UnlockThread)
+        return true;
+
+    using Presence = seal::QuickUnlock::Presence;
+    const auto windows = QGuiApplication::topLevelWindows();
+    const HWND owner = windows.isEmpty() ? nullptr : (HWND)windows.first()->winId();
+    const auto started = std::chrono::steady_clock::now();
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=auth.quick_unlock.begin", "result=start", "worker=true"}));
+    setStatus("Confirm it's you with Windows Hello");
+
+    // The check blocks on a WinRT operation, which the GUI thread (an STA)
+    // may not do. The worker touches nothing but its own result.
+    auto presence = std::make_shared<std::atomic<Presence>>(Presence::Unavailable);
+    auto* worker = QThread::create(
+        [owner, presence]()
+        {
+            presence->store(seal::QuickUnlock::verifyPresence(owner, L"Unlock your seal vault"),
+                            std::memory_order_release);
+        });
+    m_UnlockThread = worker;
+
+    connect(worker,
+            &QThread::finished,
+            this,
+            [this, worker, presence, started]()
+            {
+                // cleanup() may have given up on this worker already.
+                if (m_UnlockThread != worker)
+                    return;
+                worker->deleteLater();
+                m_UnlockThread = nullptr;
+
+                const Presence result = presence->load(std::memory_order_acquire);
+                if (result == Presence::Verified && !m_PasswordSet &&
+                    m_QuickUnlock->restore(m_Password, *m_KeyCache))
+                {
+                    m_DPAPIGuard = decltype(m_DPAPIGuard)(&m_Password);
+                    m_PasswordSet = true;
+                    qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                        {"event=auth.password.set",
+                         "result=ok",
+                         "source=quick_unlock",
+                         seal::diag::kv("cached_keys", m_KeyCache->size()),
+                         seal::diag::kv("pending_action", m_PendingAction != nullptr),
+                         seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                    setStatus("Vault unlocked");
+                    emit passwordSetChanged();
+                    if (m_PendingAction)
+                    {
+                        auto action = std::move(m_PendingAction);
+                        m_PendingAction = nullptr;
+                        action();
+                    }
+                    return;
+                }
+
+                const char* reason = result == Presence::Declined      ? "reason=declined"
+                                     : result == Presence::Unavailable ? "reason=unavailable"
+                                                                       : "reason=expired";
+                qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=auth.quick_unlock.finish",
+                     "result=fail",
+                     reason,
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                if (!m_PasswordSet)
+                    emit passwordRequired();
+            });
+    worker->start();
+    return true;
+}
+
 void Backend::submitPassword(QString password)
 {
     auto wide = qstringToSecureWide(password);
     // Wipe the input QString to reduce plaintext residency in pageable memory.
     password.fill(QChar(0));
+    // Keys cached under the previous password are meaningless for this one,
+    // and so is a session parked for quick unlock.
+    m_KeyCache->clear();
+    m_Prefetch->clear();
+    m_QuickUnlock->clear();
     m_Password = std::move(wide);
     // Wrap the password in a DPAPI guard: when "protected", the memory is
     // encrypted in-place by the OS, making it unreadable even if the process
@@ -373,13 +613,97 @@ void Backend::cancelFillIfArmed()
     }
 }
 
+bool Backend::vaultOperationPending()
+{
+    if (!m_VaultThread)
+        return false;
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.op.skip", "result=skip", "reason=op_in_progress"}));
+    setStatus("Busy - wait for the current vault operation");
+    return true;
+}
+
+seal::VaultProgress Backend::makeProgressReporter(std::shared_ptr<std::atomic<bool>> cancel)
+{
+    // Called from the worker (and its thread pool), so it only touches the
+    // shared atomics and posts to the GUI thread. Updates are collapsed to
+    // whole-percent steps so a large vault doesn't flood the event loop.
+    auto lastPercent = std::make_shared<std::atomic<int>>(-1);
+    return [this, cancel = std::move(cancel), lastPercent](size_t done, size_t total)
+    {
+        if (cancel->load(std::memory_order_relaxed))
+            return false;
+        const int percent = total > 0 ? static_cast<int>(done * 100 / total) : 100;
+        int last = lastPercent->load(std::memory_order_relaxed);
+        while (percent > last && !lastPercent->compare_exchange_weak(last, percent))
+        {
+        }
+        if (percent > last)
+        {
+            QMetaObject::invokeMethod(
+                this,
+                [this, done, total]()
+                { emit operationProgress(static_cast<int>(done), static_cast<int>(total)); },
+                Qt::QueuedConnection);
+        }
+        return true;
+    };
+}
+
+void Backend::startVaultOperation(QThread* worker,
+                                  VaultOperation kind,
+                                  std::shared_ptr<std::atomic<bool>> cancel,
+                                  std::function<void()> onFinished)
+{
+    m_VaultThread = worker;
+    m_VaultOperation = kind;
+    m_VaultCancel = std::move(cancel);
+    m_Busy = true;
+    emit busyChanged();
+    emit operationProgress(0, 0);
+
+    connect(worker,
+            &QThread::finished,
+            this,
+            [this, worker, onFinished = std::move(onFinished)]()
+            {
+                // cleanup() may already have reaped this worker.
+                if (m_VaultThread != worker)
+                    return;
+                worker->deleteLater();
+                m_VaultThread = nullptr;
+                // The worker may have cached a key after lockVault() wiped the
+                // cache; drop anything it added if it no longer belongs.
+                if (!m_PasswordSet || (m_VaultCancel && m_VaultCancel->load()))
+                    m_KeyCache->clear();
+                m_VaultCancel.reset();
+                m_Busy = false;
+                emit busyChanged();
+                onFinished();
+            });
+    worker->start();
+}
+
+void Backend::cancelOperation()
+{
+    if (!m_VaultCancel)
+        return;
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.op.cancel.request"}));
+    m_VaultCancel->store(true);
+    setStatus("Cancelling...");
+}
+
 void Backend::loadVaultFromPath(const QString& filePath, bool isAutoLoad)
 {
+    if (vaultOperationPending())
+        return;
+
     const std::string opId = seal::diag::nextOpId("vault_load");
     const auto started = std::chrono::steady_clock::now();
     const std::string pathMeta = seal::diag::pathSummary(filePath.toUtf8().toStdString());
 
-    // Cancel any active fill before replacing the records vector,
+    // Cancel any active fill before the records vector is replaced,
     // otherwise FillController's borrowed pointer to m_Records would dangle.
     cancelFillIfArmed();
     qCInfo(logBackend).noquote() << QString::fromStdString(
@@ -387,64 +711,133 @@ void Backend::loadVaultFromPath(const QString& filePath, bool isAutoLoad)
                                 "result=start",
                                 seal::diag::kv("op", opId),
                                 seal::diag::kv("auto", isAutoLoad),
-                                pathMeta}));
-    try
+                                pathMeta,
+                                "worker=true"}));
+
+    // The key derivation runs on a worker thread so the window stays
+    // responsive. It gets its own copy of the password; m_Records is only
+    // replaced back on the GUI thread once the load has succeeded.
+    struct LoadResult
+    {
+        std::vector<seal::VaultRecord> records;
+        seal::VaultJournalState journal;
+        std::string error;
+    };
+    auto result = std::make_shared<LoadResult>();
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    const auto loadMode = QFileInfo(filePath).size() >= kMappedVaultBytes
+                              ? seal::VaultLoadMode::Mapped
+                              : seal::VaultLoadMode::Resident;
+    seal::basic_secure_string<wchar_t> pw;
     {
         ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
-        m_Records = seal::loadVaultIndex(filePath, m_Password);
-        ++m_RecordsGeneration;
-        m_CurrentVaultPath = filePath;
-        qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
-            {"event=vault.load.finish",
-             "result=ok",
-             seal::diag::kv("op", opId),
-             seal::diag::kv("record_count", m_Records.size()),
-             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
-        refreshModel();
-        if (isAutoLoad)
-            setStatus(QString("Auto-loaded %1 account(s) from %2")
-                          .arg(m_Records.size())
-                          .arg(QFileInfo(filePath).fileName()));
-        else
-            setStatus(QString("Loaded %1 account(s) from vault").arg(m_Records.size()));
-        emit vaultLoadedChanged();
-        emit vaultFileNameChanged();
+        pw.s.assign(m_Password.s.begin(), m_Password.s.end());
     }
-    catch (const std::runtime_error& e)
-    {
-        if (std::string(e.what()) == "Wrong password")
+
+    auto* worker = QThread::create(
+        [filePath,
+         loadMode,
+         pw = std::move(pw),
+         keyCache = m_KeyCache,
+         progress = makeProgressReporter(cancel),
+         result]() mutable
         {
-            // Wrong-password retry flow:
-            // 1. Destroy the DPAPI guard and wipe the bad password.
-            // 2. Clear passwordSet so the UI knows no valid key is loaded.
-            // 3. Stash a lambda that re-attempts this same load once the
-            //    user enters a new password (the pending-action pattern).
-            // 4. Signal QML to re-show the password dialog with an error hint.
-            qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+            try
+            {
+                result->records = seal::loadVaultIndex(
+                    filePath, pw, keyCache.get(), progress, &result->journal, loadMode);
+            }
+            catch (const std::exception& e)
+            {
+                result->error = e.what();
+            }
+            catch (...)
+            {
+                result->error = "Unknown error";
+            }
+            seal::Cryptography::cleanseString(pw);
+        });
+
+    startVaultOperation(
+        worker,
+        VaultOperation::Load,
+        cancel,
+        [this, filePath, isAutoLoad, opId, started, result, cancel]()
+        {
+            if (cancel->load())
+            {
+                qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.load.finish",
+                     "result=cancelled",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                setStatus("Vault load cancelled");
+                return;
+            }
+            if (result->error == "Wrong password")
+            {
+                // Wrong-password retry flow:
+                // 1. Destroy the DPAPI guard and wipe the bad password.
+                // 2. Clear passwordSet so the UI knows no valid key is loaded.
+                // 3. Stash a lambda that re-attempts this same load once the
+                //    user enters a new password (the pending-action pattern).
+                // 4. Signal QML to re-show the password dialog with an error hint.
+                qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.load.finish",
+                     "result=retry",
+                     seal::diag::kv("op", opId),
+                     "reason=wrong_password",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                m_DPAPIGuard = {};
+                seal::Cryptography::cleanseString(m_Password);
+                m_KeyCache->clear();
+                m_Prefetch->clear();
+                m_PasswordSet = false;
+                emit passwordSetChanged();
+                m_PendingAction = [this, filePath, isAutoLoad]()
+                { loadVaultFromPath(filePath, isAutoLoad); };
+                emit passwordRetryRequired("Wrong password - try again.");
+                return;
+            }
+            if (!result->error.empty())
+            {
+                const char* what = result->error.c_str();
+                qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.load.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("reason", seal::diag::reasonFromMessage(what)),
+                     seal::diag::kv("detail", seal::diag::sanitizeAscii(what)),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                emit errorOccurred("Error", QString("Failed to load vault: %1").arg(what));
+                setStatus("Failed to load vault");
+                return;
+            }
+
+            cancelFillIfArmed();
+            m_Records = std::move(result->records);
+            ++m_RecordsGeneration;
+            m_Journal = std::move(result->journal);
+            m_CurrentVaultPath = filePath;
+            rememberVaultPath(filePath);
+            watchVaultFile();
+            qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
                 {"event=vault.load.finish",
-                 "result=retry",
+                 "result=ok",
                  seal::diag::kv("op", opId),
-                 "reason=wrong_password",
+                 seal::diag::kv("record_count", m_Records.size()),
                  seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
-            m_DPAPIGuard = {};
-            seal::Cryptography::cleanseString(m_Password);
-            m_PasswordSet = false;
-            emit passwordSetChanged();
-            m_PendingAction = [this, filePath, isAutoLoad]()
-            { loadVaultFromPath(filePath, isAutoLoad); };
-            emit passwordRetryRequired("Wrong password - try again.");
-            return;
-        }
-        qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
-            {"event=vault.load.finish",
-             "result=fail",
-             seal::diag::kv("op", opId),
-             seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
-             seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
-             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
-        emit errorOccurred("Error", QString("Failed to load vault: %1").arg(e.what()));
-        setStatus("Failed to load vault");
-    }
+            reserveLockedMemory();
+            refreshModel();
+            if (isAutoLoad)
+                setStatus(QString("Auto-loaded %1 account(s) from %2")
+                              .arg(m_Records.size())
+                              .arg(QFileInfo(filePath).fileName()));
+            else
+                setStatus(QString("Loaded %1 account(s) from vault").arg(m_Records.size()));
+            emit vaultLoadedChanged();
+            emit vaultFileNameChanged();
+        });
 }
 
 void Backend::loadVault()
@@ -458,6 +851,8 @@ void Backend::loadVault()
         ensurePassword();
         return;
     }
+    if (vaultOperationPending())
+        return;
 
     QString fileName =
         seal::OpenFileDialog("Load Vault File", "seal Vault (*.seal)|*.seal|All Files (*)|*.*|");
@@ -475,6 +870,8 @@ void Backend::saveVault()
         ensurePassword();
         return;
     }
+    if (vaultOperationPending())
+        return;
 
     // Re-use the existing path, or prompt for a new one on first save.
     QString fileName = m_CurrentVaultPath;
@@ -489,6 +886,14 @@ void Backend::saveVault()
     if (!fileName.endsWith(".seal", Qt::CaseInsensitive))
         fileName += ".seal";
 
+    // Someone else wrote the open vault since we last read it: merge their
+    // changes first, or the rewrite below would silently discard them.
+    if (fileName == m_CurrentVaultPath && seal::vaultFileChanged(m_Journal))
+    {
+        reloadVaultFromDisk(true);
+        return;
+    }
+
     const std::string opId = seal::diag::nextOpId("vault_save");
     const auto started = std::chrono::steady_clock::now();
     qCInfo(logBackend).noquote() << QString::fromStdString(
@@ -496,46 +901,115 @@ void Backend::saveVault()
                                 "result=start",
                                 seal::diag::kv("op", opId),
                                 seal::diag::kv("record_count", m_Records.size()),
-                                seal::diag::pathSummary(fileName.toUtf8().toStdString())}));
-    ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
-    bool saveOk = seal::saveVaultV2(fileName, m_Records, m_Password);
-    if (saveOk)
-    {
-        m_CurrentVaultPath = fileName;
-
-        // Clear dirty flags and purge soft-deleted records now that
-        // they've been committed to disk.
-        for (auto& rec : m_Records)
-            rec.dirty = false;
-        cancelFillIfArmed();
-        std::erase_if(m_Records, [](const seal::VaultRecord& r) { return r.deleted; });
+                                seal::diag::pathSummary(fileName.toUtf8().toStdString()),
+                                "worker=true"}));
+    // saveVaultV2 may re-seal older records, and the saved snapshot replaces
+    // m_Records afterwards, so no fill may hold a borrowed pointer across it.
+    cancelFillIfArmed();
 
-        refreshModel();
-        qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
-            {"event=vault.save.finish",
-             "result=ok",
-             seal::diag::kv("op", opId),
-             seal::diag::kv("record_count", m_Records.size()),
-             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
-        setStatus(QString("Saved %1 account(s) to vault").arg(m_Records.size()));
-        emit vaultLoadedChanged();
-        emit vaultFileNameChanged();
-    }
-    else
+    // The worker saves a snapshot with its own password copy. Record
+    // mutations are refused while it runs (vaultOperationPending), so the
+    // snapshot -- including any records migrated in place -- becomes the
+    // new m_Records when the save succeeds.
+    auto snapshot = std::make_shared<std::vector<seal::VaultRecord>>(m_Records);
+    auto journal = std::make_shared<seal::VaultJournalState>(m_Journal);
+    auto saved = std::make_shared<std::atomic<bool>>(false);
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    seal::basic_secure_string<wchar_t> pw;
     {
-        qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
-            {"event=vault.save.finish",
-             "result=fail",
-             seal::diag::kv("op", opId),
-             "reason=save_failed",
-             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
-        emit errorOccurred("Error", "Failed to save vault file");
-        setStatus("Failed to save vault");
+        ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
+        pw.s.assign(m_Password.s.begin(), m_Password.s.end());
     }
+
+    auto* worker = QThread::create(
+        [fileName,
+         snapshot,
+         journal,
+         pw = std::move(pw),
+         keyCache = m_KeyCache,
+         progress = makeProgressReporter(cancel),
+         saved]() mutable
+        {
+            bool ok = false;
+            try
+            {
+                ok = seal::saveVaultV2(
+                    fileName, *snapshot, pw, keyCache.get(), progress, journal.get());
+            }
+            catch (...)
+            {
+            }
+            saved->store(ok, std::memory_order_release);
+            seal::Cryptography::cleanseString(pw);
+        });
+
+    startVaultOperation(
+        worker,
+        VaultOperation::Save,
+        cancel,
+        [this, fileName, opId, started, snapshot, journal, saved, cancel]()
+        {
+            // A save that reached the disk is adopted even if cancel came
+            // too late to stop it; otherwise m_Records and the journal stamp
+            // would no longer describe the file.
+            const bool ok = saved->load(std::memory_order_acquire);
+            if (!ok && cancel->load())
+            {
+                qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.save.finish",
+                     "result=cancelled",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                setStatus("Vault save cancelled");
+                return;
+            }
+            if (!ok)
+            {
+                qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.save.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     "reason=save_failed",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                emit errorOccurred("Error", "Failed to save vault file");
+                setStatus("Failed to save vault");
+                return;
+            }
+
+            m_CurrentVaultPath = fileName;
+            rememberVaultPath(fileName);
+            watchVaultFile();
+
+            // Adopt the saved (possibly migrated) records, then clear dirty
+            // flags and purge soft-deleted records now that they've been
+            // committed to disk.
+            cancelFillIfArmed();
+            m_Records = std::move(*snapshot);
+            ++m_RecordsGeneration;
+            m_Journal = std::move(*journal);
+            for (auto& rec : m_Records)
+                rec.dirty = false;
+            // Compacting shifts every later index, so it is a mutation too.
+            if (std::erase_if(m_Records, [](const seal::VaultRecord& r) { return r.deleted; }))
+                ++m_RecordsGeneration;
+
+            refreshModel();
+            qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                {"event=vault.save.finish",
+                 "result=ok",
+                 seal::diag::kv("op", opId),
+                 seal::diag::kv("record_count", m_Records.size()),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+            setStatus(QString("Saved %1 account(s) to vault").arg(m_Records.size()));
+            emit vaultLoadedChanged();
+            emit vaultFileNameChanged();
+        });
 }
 
 void Backend::unloadVault()
 {
+    if (vaultOperationPending())
+        return;
     // Cancel any active fill before clearing records, otherwise
     // FillController's borrowed pointer to m_Records would dangle.
     cancelFillIfArmed();
@@ -543,13 +1017,232 @@ void Backend::unloadVault()
         {"event=vault.unload", "result=ok", seal::diag::kv("record_count", m_Records.size())}));
     m_Records.clear();
     ++m_RecordsGeneration;
+    m_KeyCache->clear();
+    m_Prefetch->clear();
+    m_Journal = {};
     m_CurrentVaultPath.clear();
+    watchVaultFile();
+    m_DiskChangePending = false;
     refreshModel();
     setStatus("Vault unloaded");
     emit vaultLoadedChanged();
     emit vaultFileNameChanged();
 }
 
+void Backend::watchVaultFile()
+{
+    const std::string path = m_CurrentVaultPath.toStdString();
+    if (m_Watcher && m_Watcher->path() == path)
+        return;
+    m_Watcher.reset();
+    if (path.empty())
+        return;
+    try
+    {
+        // Runs on the watcher thread; hop to the GUI thread before touching
+        // any state. Events still queued when this object dies are dropped.
+        m_Watcher = std::make_unique<seal::FileWatcher>(
+            path,
+            [this]
+            {
+                QMetaObject::invokeMethod(
+                    this, [this] { onVaultFileChanged(); }, Qt::QueuedConnection);
+            });
+    }
+    catch (const std::exception& e)
+    {
+        qCWarning(logBackend).noquote() << QString::fromStdString(
+            seal::diag::joinFields({"event=vault.watch.start",
+                                    "result=fail",
+                                    seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                                    seal::diag::pathSummary(path)}));
+    }
+}
+
+void Backend::onVaultFileChanged()
+{
+    // Our own saves land here too; they leave the stamp m_Journal recorded.
+    if (m_CurrentVaultPath.isEmpty() || !seal::vaultFileChanged(m_Journal))
+    {
+        m_DiskChangePending = false;
+        return;
+    }
+    if (!m_PasswordSet)
+    {
+        m_DiskChangePending = true;
+        return;
+    }
+    // A load or save is still running; look again once it had time to end.
+    if (m_VaultThread)
+    {
+        QTimer::singleShot(
+            seal::cfg::FILE_WATCH_DEBOUNCE_MS, this, [this] { onVaultFileChanged(); });
+        return;
+    }
+    reloadVaultFromDisk();
+}
+
+void Backend::reloadVaultFromDisk(bool thenSave)
+{
+    if (vaultOperationPending())
+        return;
+    m_DiskChangePending = false;
+
+    const QString filePath = m_CurrentVaultPath;
+    const std::string opId = seal::diag::nextOpId("vault_reload");
+    const auto started = std::chrono::steady_clock::now();
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.reload.begin",
+                                "result=start",
+                                seal::diag::kv("op", opId),
+                                seal::diag::kv("then_save", thenSave),
+                                seal::diag::pathSummary(filePath.toUtf8().toStdString()),
+                                "worker=true"}));
+
+    // The worker only needs what identifies a record's sealing and its
+    // platform name, not the packets themselves.
+    auto known = std::make_shared<std::vector<seal::VaultRecord>>();
+    known->reserve(m_Records.size());
+    for (const auto& rec : m_Records)
+    {
+        seal::VaultRecord slim;
+        slim.platform = rec.platform;
+        slim.keySalt = rec.keySalt;
+        slim.id = rec.id;
+        slim.sealTag = rec.sealTag;
+        slim.keyed = rec.keyed;
+        slim.dirty = rec.dirty;
+        slim.deleted = rec.deleted;
+        known->push_back(std::move(slim));
+    }
+
+    struct ReloadResult
+    {
+        std::vector<seal::VaultRecord> records;
+        seal::VaultJournalState journal;
+        std::string error;
+    };
+    auto result = std::make_shared<ReloadResult>();
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    const auto loadMode = QFileInfo(filePath).size() >= kMappedVaultBytes
+                              ? seal::VaultLoadMode::Mapped
+                              : seal::VaultLoadMode::Resident;
+    seal::basic_secure_string<wchar_t> pw;
+    {
+        ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
+        pw.s.assign(m_Password.s.begin(), m_Password.s.end());
+    }
+
+    auto* worker = QThread::create(
+        [filePath,
+         loadMode,
+         known,
+         pw = std::move(pw),
+         keyCache = m_KeyCache,
+         progress = makeProgressReporter(cancel),
+         result]() mutable
+        {
+            try
+            {
+                result->records = seal::loadVaultIndex(filePath,
+                                                       pw,
+                                                       keyCache.get(),
+                                                       progress,
+                                                       &result->journal,
+                                                       loadMode,
+                                                       known.get());
+            }
+            catch (const std::exception& e)
+            {
+                result->error = e.what();
+            }
+            catch (...)
+            {
+                result->error = "Unknown error";
+            }
+            seal::Cryptography::cleanseString(pw);
+        });
+
+    startVaultOperation(
+        worker,
+        VaultOperation::Load,
+        cancel,
+        [this, filePath, thenSave, opId, started, result, cancel]()
+        {
+            if (cancel->load() || filePath != m_CurrentVaultPath)
+            {
+                // Usually lockVault(); the change is picked up after unlock.
+                m_DiskChangePending = !filePath.isEmpty() && filePath == m_CurrentVaultPath;
+                qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.reload.finish",
+                     "result=cancelled",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                return;
+            }
+            if (!result->error.empty())
+            {
+                // Typically a writer caught mid-save, or another instance
+                // that changed the master password. Keep what we have.
+                const char* what = result->error.c_str();
+                qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.reload.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("reason", seal::diag::reasonFromMessage(what)),
+                     seal::diag::kv("detail", seal::diag::sanitizeAscii(what)),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                setStatus("Vault changed on disk but could not be reloaded");
+                if (thenSave)
+                    emit errorOccurred(
+                        "Error",
+                        QString("The vault file was changed by another program and could not be "
+                                "reloaded (%1). It was not saved, so those changes are kept.")
+                            .arg(what));
+                return;
+            }
+
+            cancelFillIfArmed();
+            const seal::VaultMergeResult merge =
+                seal::mergeReloadedRecords(m_Records, std::move(result->records));
+            ++m_RecordsGeneration;
+            m_Journal = std::move(result->journal);
+            if (merge.changed())
+                m_Prefetch->clear();
+            qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                {"event=vault.reload.finish",
+                 "result=ok",
+                 seal::diag::kv("op", opId),
+                 seal::diag::kv("record_count", m_Records.size()),
+                 seal::diag::kv("added", merge.added),
+                 seal::diag::kv("updated", merge.updated),
+                 seal::diag::kv("removed", merge.removed),
+                 seal::diag::kv("conflicts", merge.conflicts),
+                 seal::diag::kv("kept", merge.kept),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+            reserveLockedMemory();
+            refreshModel();
+            setStatus(QString("Vault changed on disk: %1 added, %2 updated, %3 removed")
+                          .arg(merge.added)
+                          .arg(merge.updated)
+                          .arg(merge.removed));
+            QStringList notes;
+            if (merge.conflicts > 0)
+                notes << QString("%1 account(s) were changed both here and in the file on disk. "
+                                 "Your version was kept; the other one was added as a "
+                                 "\"(conflicted copy)\".")
+                             .arg(merge.conflicts);
+            if (merge.kept > 0)
+                notes << QString("%1 account(s) with unsaved changes here were deleted from the "
+                                 "file on disk. Your version was kept and will be saved again.")
+                             .arg(merge.kept);
+            if (!notes.isEmpty())
+                emit infoMessage("Vault Changed", notes.join("\n\n"));
+            if (thenSave)
+                saveVault();
+        });
+}
+
 void Backend::addAccount(const QString& service, const QString& username, const QString& password)
 {
     if (service.isEmpty() || username.isEmpty() || password.isEmpty())
@@ -557,6 +1250,8 @@ void Backend::addAccount(const QString& service, const QString& username, const
         emit errorOccurred("Warning", "All fields are required");
         return;
     }
+    if (vaultOperationPending())
+        return;
 
     if (!m_PasswordSet)
     {
@@ -574,10 +1269,12 @@ void Backend::addAccount(const QString& service, const QString& username, const
             // pageable QString.  The shared_ptrs keep the secure strings
             // alive across the std::function copy boundary.
             cancelFillIfArmed();
-            ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
-            seal::VaultRecord newRecord = seal::encryptCredential(
-                service.toUtf8().toStdString(), *secUser, *secPass, m_Password);
+            seal::VaultRecord newRecord;
+            const bool sealed =
+                sealAccount(service, *secUser, *secPass, "event=vault.record.add", newRecord);
             seal::Cryptography::cleanseString(*secUser, *secPass);
+            if (!sealed)
+                return;
             m_Records.push_back(std::move(newRecord));
             ++m_RecordsGeneration;
             qCInfo(logBackend).noquote() << QString::fromStdString(
@@ -600,11 +1297,13 @@ void Backend::addAccount(const QString& service, const QString& username, const
     auto secUsername = qstringToSecureWide(username);
     auto secPassword = qstringToSecureWide(password);
 
-    ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
-    seal::VaultRecord newRecord = seal::encryptCredential(
-        service.toUtf8().toStdString(), secUsername, secPassword, m_Password);
+    seal::VaultRecord newRecord;
+    const bool sealed =
+        sealAccount(service, secUsername, secPassword, "event=vault.record.add", newRecord);
 
     seal::Cryptography::cleanseString(secUsername, secPassword);
+    if (!sealed)
+        return;
 
     cancelFillIfArmed();
     m_Records.push_back(std::move(newRecord));
@@ -621,92 +1320,574 @@ void Backend::addAccount(const QString& service, const QString& username, const
     emit vaultFileNameChanged();
 }
 
-void Backend::editAccount(int index,
-                          const QString& service,
-                          const QString& username,
-                          const QString& password)
+void Backend::editAccount(int index,
+                          const QString& service,
+                          const QString& username,
+                          const QString& password)
+{
+    if (index < 0 || index >= (int)m_Records.size())
+        return;
+
+    if (service.isEmpty() || username.isEmpty() || password.isEmpty())
+    {
+        emit errorOccurred("Warning", "All fields are required");
+        return;
+    }
+    if (vaultOperationPending())
+        return;
+
+    if (!m_PasswordSet)
+    {
+        // Capture only the index (not username/password) to avoid holding
+        // plaintext credentials in pageable heap memory. After the master
+        // password is entered, re-decrypt and re-show the edit dialog so
+        // the user can re-enter their changes.
+        m_PendingAction = [this, index]()
+        {
+            QVariantMap data = decryptAccountForEdit(index);
+            if (!data.isEmpty())
+                emit editAccountReady(data);
+        };
+        ensurePassword();
+        return;
+    }
+
+    auto secUsername = qstringToSecureWide(username);
+    auto secPassword = qstringToSecureWide(password);
+
+    // Replace the record entirely - re-encrypt with a fresh salt/IV. The
+    // record keeps its id so an incremental save overwrites it in place,
+    // and its seal tag so a reload can tell whether the disk copy moved on.
+    cancelFillIfArmed();
+    seal::VaultRecord edited;
+    const bool sealed =
+        sealAccount(service, secUsername, secPassword, "event=vault.record.edit", edited);
+    seal::Cryptography::cleanseString(secUsername, secPassword);
+    if (!sealed)
+        return;
+    const bool audited = m_Records[index].audit != 0;
+    edited.id = m_Records[index].id;
+    edited.sealTag = m_Records[index].sealTag;
+    m_Records[index] = std::move(edited);
+    ++m_RecordsGeneration;
+
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.record.edit",
+                                "result=ok",
+                                seal::diag::kv("index", index),
+                                seal::diag::kv("service_len", service.size())}));
+    refreshModel();
+    // The new password has not been audited; drop the row's stale badge.
+    if (audited)
+        m_Model->auditChanged();
+    setStatus("Account updated");
+}
+
+bool Backend::sealAccount(const QString& service,
+                          const seal::basic_secure_string<wchar_t>& username,
+                          const seal::basic_secure_string<wchar_t>& password,
+                          const char* event,
+                          seal::VaultRecord& out)
+{
+    try
+    {
+        ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
+        out = seal::encryptCredential(service.toUtf8().toStdString(),
+                                      username,
+                                      password,
+                                      m_Password,
+                                      seal::vaultKeySalt(m_Records),
+                                      m_Records,
+                                      m_KeyCache.get());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+            {event,
+             "result=fail",
+             seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what()))}));
+        emit errorOccurred("Error", QString("Failed to encrypt credential: %1").arg(e.what()));
+        setStatus("Account not saved");
+        return false;
+    }
+}
+
+void Backend::deleteAccount(int index)
+{
+    if (index < 0 || index >= (int)m_Records.size())
+        return;
+    if (vaultOperationPending())
+        return;
+
+    // Soft-delete, flag the record so it's excluded from the model
+    // immediately, but keep it around until saveVault() commits to disk.
+    cancelFillIfArmed();
+    m_Records[index].deleted = true;
+    m_Records[index].dirty = true;
+    ++m_RecordsGeneration;
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.record.delete",
+                                "result=ok",
+                                "mode=soft_delete",
+                                seal::diag::kv("index", index)}));
+    refreshModel();
+    setStatus("Account deleted");
+
+    // If every record is now deleted, notify QML so it can show the
+    // empty-vault state.
+    bool anyVisible = false;
+    for (const auto& rec : m_Records)
+    {
+        if (!rec.deleted)
+        {
+            anyVisible = true;
+            break;
+        }
+    }
+    if (!anyVisible)
+    {
+        emit vaultLoadedChanged();
+        emit vaultFileNameChanged();
+    }
+}
+
+std::vector<size_t> Backend::liveRecordIndices(const QVariantList& indices) const
+{
+    std::vector<size_t> out;
+    out.reserve(indices.size());
+    for (const QVariant& v : indices)
+    {
+        bool ok = false;
+        const int index = v.toInt(&ok);
+        if (ok && index >= 0 && index < (int)m_Records.size() && !m_Records[index].deleted)
+            out.push_back(static_cast<size_t>(index));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+void Backend::finishBulkChange(bool save)
+{
+    ++m_RecordsGeneration;
+    refreshModel();
+
+    const bool anyVisible = std::any_of(
+        m_Records.begin(), m_Records.end(), [](const seal::VaultRecord& r) { return !r.deleted; });
+    if (!anyVisible)
+    {
+        emit vaultLoadedChanged();
+        emit vaultFileNameChanged();
+    }
+    if (save)
+        saveVault();
+}
+
+void Backend::deleteAccounts(const QVariantList& indices, bool save)
+{
+    const std::vector<size_t> targets = liveRecordIndices(indices);
+    if (targets.empty())
+        return;
+    if (vaultOperationPending())
+        return;
+
+    cancelFillIfArmed();
+    for (size_t index : targets)
+    {
+        m_Records[index].deleted = true;
+        m_Records[index].dirty = true;
+    }
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.record.delete",
+                                "result=ok",
+                                "mode=soft_delete",
+                                seal::diag::kv("records", targets.size()),
+                                seal::diag::kv("save", save)}));
+    setStatus(QString("Deleted %1 accounts").arg(targets.size()));
+    finishBulkChange(save);
+}
+
+void Backend::moveAccounts(const QVariantList& indices, bool save)
+{
+    const std::vector<size_t> targets = liveRecordIndices(indices);
+    if (targets.empty())
+        return;
+    if (vaultOperationPending())
+        return;
+
+    if (!m_PasswordSet)
+    {
+        m_PendingAction = [this, indices, save]() { moveAccounts(indices, save); };
+        ensurePassword();
+        return;
+    }
+
+    QString targetPath = seal::SaveFileDialog("Move Accounts To Vault",
+                                              "seal Vault (*.seal)|*.seal|All Files (*)|*.*|");
+    if (targetPath.isEmpty())
+        return;
+    if (!targetPath.endsWith(".seal", Qt::CaseInsensitive))
+        targetPath += ".seal";
+    if (!m_CurrentVaultPath.isEmpty() &&
+        QFileInfo(targetPath).absoluteFilePath().compare(
+            QFileInfo(m_CurrentVaultPath).absoluteFilePath(), Qt::CaseInsensitive) == 0)
+    {
+        emit errorOccurred("Warning", "Choose a different vault to move the accounts into");
+        return;
+    }
+
+    const std::string opId = seal::diag::nextOpId("vault_move");
+    const auto started = std::chrono::steady_clock::now();
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.record.move.begin",
+                                "result=start",
+                                seal::diag::kv("op", opId),
+                                seal::diag::kv("records", targets.size()),
+                                seal::diag::pathSummary(targetPath.toUtf8().toStdString()),
+                                "worker=true"}));
+    // The copies carry their own packets, so the worker never reads
+    // m_Records; the originals are only soft-deleted once the target is on
+    // disk, and mutations stay refused until then.
+    cancelFillIfArmed();
+    auto copies =
+        std::make_shared<std::vector<seal::VaultRecord>>(seal::detachedCopies(m_Records, targets));
+    std::vector<uint64_t> movedIds;
+    movedIds.reserve(targets.size());
+    for (size_t index : targets)
+        movedIds.push_back(m_Records[index].id);
+
+    auto error = std::make_shared<std::string>();
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    seal::basic_secure_string<wchar_t> pw;
+    {
+        ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
+        pw.s.assign(m_Password.s.begin(), m_Password.s.end());
+    }
+
+    auto* worker = QThread::create(
+        [targetPath,
+         copies,
+         error,
+         pw = std::move(pw),
+         keyCache = m_KeyCache,
+         progress = makeProgressReporter(cancel)]() mutable
+        {
+            try
+            {
+                // An existing target must open under the same master
+                // password; its records are kept and the copies appended.
+                std::vector<seal::VaultRecord> merged;
+                seal::VaultJournalState journal;
+                if (QFileInfo::exists(targetPath))
+                    merged = seal::loadVaultIndex(targetPath, pw, keyCache.get(), {}, &journal);
+                merged.insert(merged.end(),
+                              std::make_move_iterator(copies->begin()),
+                              std::make_move_iterator(copies->end()));
+                if (!seal::saveVaultV2(
+                        targetPath, merged, pw, keyCache.get(), progress, &journal))
+                    *error = "save_failed";
+            }
+            catch (const std::exception& e)
+            {
+                *error = seal::diag::reasonFromMessage(e.what());
+            }
+            catch (...)
+            {
+                *error = "unknown";
+            }
+            seal::Cryptography::cleanseString(pw);
+        });
+
+    startVaultOperation(
+        worker,
+        VaultOperation::Save,
+        cancel,
+        [this, targetPath, opId, started, movedIds, error, cancel, save]()
+        {
+            if (cancel->load())
+            {
+                qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.record.move.finish",
+                     "result=cancelled",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                setStatus("Move cancelled");
+                return;
+            }
+            if (!error->empty())
+            {
+                qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.record.move.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("reason", *error),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                emit errorOccurred("Error",
+                                   "Failed to move accounts into " +
+                                       QFileInfo(targetPath).fileName());
+                setStatus("Move failed");
+                return;
+            }
+
+            size_t moved = 0;
+            for (auto& rec : m_Records)
+            {
+                if (!rec.deleted &&
+                    std::find(movedIds.begin(), movedIds.end(), rec.id) != movedIds.end())
+                {
+                    rec.deleted = true;
+                    rec.dirty = true;
+                    ++moved;
+                }
+            }
+            qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                {"event=vault.record.move.finish",
+                 "result=ok",
+                 seal::diag::kv("op", opId),
+                 seal::diag::kv("records", moved),
+                 seal::diag::kv("save", save),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+            setStatus(QString("Moved %1 accounts to %2")
+                          .arg(moved)
+                          .arg(QFileInfo(targetPath).fileName()));
+            finishBulkChange(save);
+        });
+}
+
+void Backend::rotateAccountPasswords(const QVariantList& indices, int length, bool save)
 {
-    if (index < 0 || index >= (int)m_Records.size())
+    const std::vector<size_t> targets = liveRecordIndices(indices);
+    if (targets.empty())
         return;
-
-    if (service.isEmpty() || username.isEmpty() || password.isEmpty())
-    {
-        emit errorOccurred("Warning", "All fields are required");
+    if (vaultOperationPending())
         return;
-    }
 
     if (!m_PasswordSet)
     {
-        // Capture only the index (not username/password) to avoid holding
-        // plaintext credentials in pageable heap memory. After the master
-        // password is entered, re-decrypt and re-show the edit dialog so
-        // the user can re-enter their changes.
-        m_PendingAction = [this, index]()
-        {
-            QVariantMap data = decryptAccountForEdit(index);
-            if (!data.isEmpty())
-                emit editAccountReady(data);
-        };
+        m_PendingAction = [this, indices, length, save]()
+        { rotateAccountPasswords(indices, length, save); };
         ensurePassword();
         return;
     }
 
-    auto secUsername = qstringToSecureWide(username);
-    auto secPassword = qstringToSecureWide(password);
-
-    // Replace the record entirely - re-encrypt with a fresh salt/IV.
     cancelFillIfArmed();
-    ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
-    m_Records[index] = seal::encryptCredential(
-        service.toUtf8().toStdString(), secUsername, secPassword, m_Password);
-    ++m_RecordsGeneration;
-
-    seal::Cryptography::cleanseString(secUsername, secPassword);
+    const auto started = std::chrono::steady_clock::now();
+    size_t rotated = 0;
+    try
+    {
+        ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
+        rotated = seal::rotateCredentialPasswords(m_Records,
+                                                  targets,
+                                                  length,
+                                                  m_Password,
+                                                  seal::vaultKeySalt(m_Records),
+                                                  m_KeyCache.get());
+    }
+    catch (const std::exception& e)
+    {
+        qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+            {"event=vault.record.rotate",
+             "result=fail",
+             seal::diag::kv("records", targets.size()),
+             seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what()))}));
+        emit errorOccurred("Error", "Failed to rotate passwords");
+        setStatus("Password rotation failed");
+        return;
+    }
 
     qCInfo(logBackend).noquote() << QString::fromStdString(
-        seal::diag::joinFields({"event=vault.record.edit",
+        seal::diag::joinFields({"event=vault.record.rotate",
                                 "result=ok",
-                                seal::diag::kv("index", index),
-                                seal::diag::kv("service_len", service.size())}));
-    refreshModel();
-    setStatus("Account updated");
+                                seal::diag::kv("records", rotated),
+                                seal::diag::kv("length", length),
+                                seal::diag::kv("save", save),
+                                seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+    setStatus(QString("Rotated %1 passwords").arg(rotated));
+    finishBulkChange(save);
+    m_Model->auditChanged();
 }
 
-void Backend::deleteAccount(int index)
+void Backend::auditPasswords()
 {
-    if (index < 0 || index >= (int)m_Records.size())
+    if (!vaultLoaded() || vaultOperationPending())
         return;
 
-    // Soft-delete, flag the record so it's excluded from the model
-    // immediately, but keep it around until saveVault() commits to disk.
-    cancelFillIfArmed();
-    m_Records[index].deleted = true;
-    m_Records[index].dirty = true;
-    ++m_RecordsGeneration;
-    qCInfo(logBackend).noquote() << QString::fromStdString(
-        seal::diag::joinFields({"event=vault.record.delete",
-                                "result=ok",
-                                "mode=soft_delete",
-                                seal::diag::kv("index", index)}));
-    refreshModel();
-    setStatus("Account deleted");
+    if (!m_PasswordSet)
+    {
+        m_PendingAction = [this]() { auditPasswords(); };
+        ensurePassword();
+        return;
+    }
 
-    // If every record is now deleted, notify QML so it can show the
-    // empty-vault state.
-    bool anyVisible = false;
-    for (const auto& rec : m_Records)
+    QString breachPath = QSettings().value(kBreachIndexKey).toString();
+    if (breachPath.isEmpty() || !QFileInfo::exists(breachPath))
     {
-        if (!rec.deleted)
-        {
-            anyVisible = true;
-            break;
-        }
+        breachPath = seal::OpenFileDialog(
+            "Pwned Passwords List (cancel to check reuse only)",
+            "Pwned Passwords (*.sidx;*.txt)|*.sidx;*.txt|All Files (*)|*.*|");
+        if (!breachPath.isEmpty())
+            QSettings().setValue(kBreachIndexKey, breachPath);
     }
-    if (!anyVisible)
+
+    const std::string opId = seal::diag::nextOpId("vault_audit");
+    const auto started = std::chrono::steady_clock::now();
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.audit.begin",
+                                "result=start",
+                                seal::diag::kv("op", opId),
+                                seal::diag::kv("records", m_Records.size()),
+                                seal::diag::kv("breach_list", !breachPath.isEmpty()),
+                                "worker=true"}));
+    // The worker reads a snapshot, so nothing it touches moves under it;
+    // results are applied by id in case a reload reshuffled m_Records.
+    cancelFillIfArmed();
+    auto snapshot = std::make_shared<std::vector<seal::VaultRecord>>(m_Records);
+    auto flags = std::make_shared<std::vector<uint8_t>>();
+    auto summary = std::make_shared<seal::VaultAuditSummary>();
+    auto indexed = std::make_shared<bool>(false);
+    auto listFailed = std::make_shared<bool>(false);
+    auto error = std::make_shared<std::string>();
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    seal::basic_secure_string<wchar_t> pw;
     {
-        emit vaultLoadedChanged();
-        emit vaultFileNameChanged();
+        ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
+        pw.s.assign(m_Password.s.begin(), m_Password.s.end());
     }
+
+    auto* worker = QThread::create(
+        [snapshot,
+         flags,
+         summary,
+         indexed,
+         listFailed,
+         error,
+         cancel,
+         breachPath = breachPath.toLocal8Bit().toStdString(),
+         pw = std::move(pw),
+         keyCache = m_KeyCache,
+         progress = makeProgressReporter(cancel)]() mutable
+        {
+            try
+            {
+                // A dump is indexed once, on the first audit against it.
+                std::unique_ptr<seal::BreachIndex> breaches;
+                if (!breachPath.empty())
+                {
+                    seal::BreachIndex::BuildStats built;
+                    try
+                    {
+                        breaches = seal::BreachIndex::openOrBuild(
+                            breachPath, true, [&](uint64_t) { return !cancel->load(); }, &built);
+                    }
+                    catch (...)
+                    {
+                        *listFailed = true;
+                        throw;
+                    }
+                    *indexed = built.lines != 0;
+                }
+                *flags = seal::auditCredentials(
+                    *snapshot, pw, keyCache.get(), breaches.get(), progress, summary.get());
+            }
+            catch (const std::exception& e)
+            {
+                *error = seal::diag::reasonFromMessage(e.what());
+            }
+            catch (...)
+            {
+                *error = "unknown";
+            }
+            seal::Cryptography::cleanseString(pw);
+        });
+
+    startVaultOperation(
+        worker,
+        VaultOperation::Load,
+        cancel,
+        [this,
+         opId,
+         started,
+         snapshot,
+         flags,
+         summary,
+         indexed,
+         listFailed,
+         error,
+         cancel,
+         breachPath]()
+        {
+            if (cancel->load() || !vaultLoaded())
+            {
+                qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.audit.finish",
+                     "result=cancelled",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                setStatus("Audit cancelled");
+                return;
+            }
+            if (!error->empty())
+            {
+                qCWarning(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=vault.audit.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("reason", *error),
+                     seal::diag::kv("breach_list_failed", *listFailed),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                // A list that will not open is forgotten, so the next audit asks again.
+                if (*listFailed)
+                {
+                    QSettings().remove(kBreachIndexKey);
+                    emit errorOccurred("Error",
+                                       "Cannot use " + QFileInfo(breachPath).fileName() +
+                                           " as a Pwned Passwords list");
+                }
+                else
+                {
+                    emit errorOccurred("Error", "Password audit failed");
+                }
+                setStatus("Audit failed");
+                return;
+            }
+
+            std::unordered_map<uint64_t, uint8_t> byId;
+            byId.reserve(snapshot->size());
+            for (size_t i = 0; i < snapshot->size(); ++i)
+                byId.emplace((*snapshot)[i].id, (*flags)[i]);
+            for (auto& rec : m_Records)
+            {
+                auto it = byId.find(rec.id);
+                rec.audit = it != byId.end() ? it->second : 0;
+            }
+            m_Model->auditChanged();
+
+            qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                {"event=vault.audit.finish",
+                 "result=ok",
+                 seal::diag::kv("op", opId),
+                 seal::diag::kv("checked", summary->checked),
+                 seal::diag::kv("breached", summary->breached),
+                 seal::diag::kv("reused", summary->reused),
+                 seal::diag::kv("index_built", *indexed),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+            setStatus(QString("Audit: %1 breached, %2 reused")
+                          .arg(summary->breached)
+                          .arg(summary->reused));
+            QString message =
+                breachPath.isEmpty()
+                    ? QString("Checked %1 passwords for reuse (no breach list selected).\n")
+                          .arg(summary->checked)
+                    : QString("Checked %1 passwords against %2.\n")
+                          .arg(summary->checked)
+                          .arg(QFileInfo(breachPath).fileName());
+            message += QString("%1 found in breaches, %2 reused across %3 groups.")
+                           .arg(summary->breached)
+                           .arg(summary->reused)
+                           .arg(summary->reuseGroups);
+            emit infoMessage("Password Audit", message);
+        });
 }
 
 QVariantMap Backend::decryptAccountForEdit(int index)
@@ -740,7 +1921,7 @@ QVariantMap Backend::decryptAccountForEdit(int index)
                 const seal::VaultRecord& record = m_Records[index];
                 ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
                 seal::DecryptedCredential cred =
-                    seal::decryptCredentialOnDemand(record, m_Password);
+                    seal::decryptCredentialOnDemand(record, m_Password, m_KeyCache.get());
                 data["service"] = QString::fromUtf8(record.platform.c_str());
                 data["username"] =
                     QString::fromWCharArray(cred.username.data(), (int)cred.username.size());
@@ -775,7 +1956,8 @@ QVariantMap Backend::decryptAccountForEdit(int index)
         // On-demand decrypt - credential blob stays encrypted at rest.
         const seal::VaultRecord& record = m_Records[index];
         ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
-        seal::DecryptedCredential cred = seal::decryptCredentialOnDemand(record, m_Password);
+        seal::DecryptedCredential cred =
+            seal::decryptCredentialOnDemand(record, m_Password, m_KeyCache.get());
 
         result["service"] = QString::fromUtf8(record.platform.c_str());
         result["username"] =
@@ -808,15 +1990,21 @@ constexpr DWORD kTabKeySettleDelayMs = 100;  // Wait for Tab to advance focus
 
 // Types username + tab + password into the currently focused window.
 // Takes a snapshot of the record and password so the worker thread
-// never touches Backend's shared state.
+// never touches Backend's shared state (the key cache is internally locked).
+// A non-null @p prefetched credential is typed instead of decrypting.
 static bool doTypeLogin(
     const seal::VaultRecord& record,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPw)
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPw,
+    seal::VaultKeyCache* keyCache,
+    seal::DecryptedCredential* prefetched)
 {
     seal::DecryptedCredential cred;
     try
     {
-        cred = seal::decryptCredentialOnDemand(record, masterPw);
+        if (prefetched)
+            cred = std::move(*prefetched);
+        else
+            cred = seal::decryptCredentialOnDemand(record, masterPw, keyCache);
     }
     catch (const std::exception& e)
     {
@@ -865,15 +2053,20 @@ static bool doTypeLogin(
 
 // Types only the password into the currently focused window.
 // Takes a snapshot of the record and password so the worker thread
-// never touches Backend's shared state.
+// never touches Backend's shared state (the key cache is internally locked).
 static bool doTypePassword(
     const seal::VaultRecord& record,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPw)
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPw,
+    seal::VaultKeyCache* keyCache,
+    seal::DecryptedCredential* prefetched)
 {
     seal::DecryptedCredential cred;
     try
     {
-        cred = seal::decryptCredentialOnDemand(record, masterPw);
+        if (prefetched)
+            cred = std::move(*prefetched);
+        else
+            cred = seal::decryptCredentialOnDemand(record, masterPw, keyCache);
     }
     catch (const std::exception& e)
     {
@@ -1011,22 +2204,32 @@ void Backend::scheduleTypingAction(int index, TypingMode mode, const QString& la
                     seal::basic_secure_string<wchar_t> pw;
                     pw.s.assign(m_Password.s.begin(), m_Password.s.end());
                     auto success = std::make_shared<std::atomic<bool>>(false);
+                    seal::DecryptedCredential prefetched;
+                    const bool hit = m_Prefetch->take(index, m_RecordsGeneration, prefetched);
 
                     auto* worker = QThread::create(
-                        [record = std::move(record), pw = std::move(pw), mode, success]() mutable
+                        [record = std::move(record),
+                         pw = std::move(pw),
+                         prefetched = std::move(prefetched),
+                         hit,
+                         keyCache = m_KeyCache,
+                         mode,
+                         success]() mutable
                         {
+                            seal::DecryptedCredential* ready = hit ? &prefetched : nullptr;
                             bool ok = false;
                             if (mode == Backend::TypingMode::Login)
-                                ok = doTypeLogin(record, pw);
+                                ok = doTypeLogin(record, pw, keyCache.get(), ready);
                             else
-                                ok = doTypePassword(record, pw);
+                                ok = doTypePassword(record, pw, keyCache.get(), ready);
                             success->store(ok, std::memory_order_release);
                             seal::Cryptography::cleanseString(pw);
+                            prefetched.cleanse();
                         });
                     connect(worker,
                             &QThread::finished,
                             this,
-                            [this, worker, label, service, opId, started, modeToken, success]()
+                            [this, worker, label, service, opId, started, modeToken, success, hit]()
                             {
                                 worker->deleteLater();
                                 m_DPAPIGuard.reprotect();
@@ -1043,6 +2246,7 @@ void Backend::scheduleTypingAction(int index, TypingMode mode, const QString& la
                                                 "result=ok",
                                                 seal::diag::kv("op", opId),
                                                 seal::diag::kv("mode", modeToken),
+                                                seal::diag::kv("prefetched", hit),
                                                 seal::diag::kv("service_len", service.size()),
                                                 seal::diag::kv("duration_ms",
                                                                seal::diag::elapsedMs(started))}));
@@ -1132,44 +2336,102 @@ void Backend::decryptDirectory()
     emit infoMessage("Success", QString("Decrypted %1 file(s) in directory").arg(count));
 }
 
-void Backend::autoLoadVault()
+void Backend::startVaultDiscovery()
 {
-    if (!m_CurrentVaultPath.isEmpty())
+    if (m_DiscoveryStarted)
         return;
+    m_DiscoveryStarted = true;
 
-    // Search for a .seal vault file in well-known locations, in priority order:
+    const auto started = std::chrono::steady_clock::now();
+    const QString lastPath = QSettings().value(kLastVaultKey).toString();
     // 1. Next to the executable   2. Current working directory   3. Home directory
     QStringList searchPaths;
     searchPaths << QCoreApplication::applicationDirPath() << QDir::currentPath()
                 << QDir::homePath();
+    searchPaths.removeDuplicates();
 
-    QString foundVaultPath;
+    m_DiscoveryThread = QThread::create(
+        [this, lastPath, searchPaths, started]()
+        {
+            QString found;
+            std::string_view source = "none";
+            if (!lastPath.isEmpty() && QFileInfo::exists(lastPath))
+            {
+                found = lastPath;
+                source = "last";
+            }
+            else
+            {
+                // Each listing may be a network round trip; list all roots at
+                // once and keep the match of the highest-priority root.
+                const QStringList hits =
+                    QtConcurrent::blockingMapped<QStringList>(searchPaths, firstVaultIn);
+                for (const QString& hit : hits)
+                {
+                    if (!hit.isEmpty())
+                    {
+                        found = hit;
+                        source = "scan";
+                        break;
+                    }
+                }
+            }
 
-    for (const QString& searchPath : searchPaths)
-    {
-        QDir dir(searchPath);
-        QFileInfoList files = dir.entryInfoList(QStringList() << "*.seal", QDir::Files);
+            qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                {"event=vault.autoload.scan",
+                 found.isEmpty() ? "result=none" : "result=found",
+                 seal::diag::kv("source", source),
+                 seal::diag::kv("search_roots", searchPaths.size()),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                 found.isEmpty() ? std::string{}
+                                 : seal::diag::pathSummary(found.toUtf8().toStdString())}));
 
-        if (!files.isEmpty())
-            foundVaultPath = files.first().absoluteFilePath();
-        if (!foundVaultPath.isEmpty())
-            break;
-    }
+            QMetaObject::invokeMethod(
+                this,
+                [this, found]()
+                {
+                    m_DiscoveredVaultPath = found;
+                    m_DiscoveryDone = true;
+                    openDiscoveredVault();
+                },
+                Qt::QueuedConnection);
+        });
 
-    if (foundVaultPath.isEmpty())
-    {
-        qCInfo(logBackend).noquote() << QString::fromStdString(
-            seal::diag::joinFields({"event=vault.autoload.scan",
-                                    "result=none",
-                                    seal::diag::kv("search_roots", searchPaths.size())}));
+    connect(m_DiscoveryThread,
+            &QThread::finished,
+            this,
+            [this]()
+            {
+                // cleanup() may already have reaped this worker.
+                if (!m_DiscoveryThread)
+                    return;
+                m_DiscoveryThread->deleteLater();
+                m_DiscoveryThread = nullptr;
+            });
+    m_DiscoveryThread->start();
+}
+
+void Backend::autoLoadVault()
+{
+    if (!m_CurrentVaultPath.isEmpty())
+        return;
+
+    m_AutoLoadRequested = true;
+    startVaultDiscovery();
+    openDiscoveredVault();
+}
+
+void Backend::openDiscoveredVault()
+{
+    if (!m_AutoLoadRequested || !m_DiscoveryDone)
+        return;
+    m_AutoLoadRequested = false;
+
+    // The user may have opened a vault by hand while discovery ran.
+    const QString foundVaultPath = m_DiscoveredVaultPath;
+    if (foundVaultPath.isEmpty() || !m_CurrentVaultPath.isEmpty() || m_VaultThread)
         return;
-    }
 
-    qCInfo(logBackend).noquote() << QString::fromStdString(
-        seal::diag::joinFields({"event=vault.autoload.scan",
-                                "result=found",
-                                seal::diag::kv("search_roots", searchPaths.size()),
-                                seal::diag::pathSummary(foundVaultPath.toUtf8().toStdString())}));
     if (!m_PasswordSet)
     {
         // Capture the discovered path so the deferred action can load it
@@ -1182,6 +2444,30 @@ void Backend::autoLoadVault()
     loadVaultFromPath(foundVaultPath, true);
 }
 
+void Backend::reserveLockedMemory()
+{
+    const uint64_t kdfBytes = seal::Cryptography::kdfParams().memoryBytes();
+    const bool ok = seal::working_set::reserve(m_Records.size(), kdfBytes);
+    const auto ws = seal::working_set::stats();
+    const auto fields = seal::diag::joinFields(
+        {"event=memory.working_set.reserve",
+         ok ? "result=ok" : "result=fail",
+         seal::diag::kv("record_count", m_Records.size()),
+         seal::diag::kv("budget_bytes", ws.budgetBytes),
+         seal::diag::kv("locked_bytes", ws.lockedBytes),
+         seal::diag::kv("lock_failures", ws.lockFailures),
+         seal::diag::kv("ws_min", ws.minimum)});
+    if (ok)
+        qCInfo(logBackend).noquote() << QString::fromStdString(fields);
+    else
+        qCWarning(logBackend).noquote() << QString::fromStdString(fields);
+}
+
+void Backend::rememberVaultPath(const QString& path)
+{
+    QSettings().setValue(kLastVaultKey, QFileInfo(path).absoluteFilePath());
+}
+
 void Backend::armFill(int index)
 {
     if (index < 0 || index >= (int)m_Records.size())
@@ -1201,7 +2487,12 @@ void Backend::armFill(int index)
     bool armed = false;
     try
     {
-        armed = m_FillController->arm(index, m_Records, m_Password, m_RecordsGeneration);
+        armed = m_FillController->arm(index,
+                                      m_Records,
+                                      m_Password,
+                                      m_RecordsGeneration,
+                                      m_KeyCache.get(),
+                                      m_Prefetch.get());
     }
     catch (...)
     {
@@ -1267,6 +2558,9 @@ void Backend::cleanup()
     qCInfo(logBackend).noquote() << QString::fromStdString(
         seal::diag::joinFields({"event=app.cleanup.begin", "result=start"}));
 
+    // No reload may start while the workers below are being reaped.
+    m_Watcher.reset();
+
     // Wait for any active QR capture thread to finish before destroying
     // members it may reference. Without this, the thread could call
     // QMetaObject::invokeMethod(this, ...) on a dangling pointer.
@@ -1284,8 +2578,54 @@ void Backend::cleanup()
         }
     }
 
+    // The prewarm touches the capture stack, which must outlive it.
+    m_CameraPrewarm->stop();
+
+    // Discovery only touches the file system, but its result is posted back
+    // to this object, so it must finish before the object goes away.
+    if (m_DiscoveryThread)
+    {
+        m_DiscoveryThread->wait();
+        m_DiscoveryThread->deleteLater();
+        m_DiscoveryThread = nullptr;
+    }
+
+    // A Windows Hello prompt may still be open. Its worker only holds its
+    // own result, so after a short wait it is left to finish on its own.
+    if (m_UnlockThread)
+    {
+        if (m_UnlockThread->wait(1000))
+            m_UnlockThread->deleteLater();
+        m_UnlockThread = nullptr;
+    }
+
+    // A CLI job holds its own password copy; stop it between items.
+    if (m_CliThread)
+    {
+        m_CliCancel->store(true);
+        m_CliThread->wait();
+        m_CliThread->deleteLater();
+        m_CliThread = nullptr;
+        m_CliCancel.reset();
+    }
+
     m_FillController->cancel();
 
+    // Stop any vault worker before wiping the password. Loads are cancelled;
+    // saves run to completion so closing the window never drops the write.
+    // Clearing m_VaultThread turns the queued finished handler into a no-op.
+    if (m_VaultThread)
+    {
+        if (m_VaultOperation == VaultOperation::Load)
+            m_VaultCancel->store(true);
+        m_VaultThread->wait();
+        m_VaultThread->deleteLater();
+        m_VaultThread = nullptr;
+        m_VaultCancel.reset();
+        m_Busy = false;
+        emit busyChanged();
+    }
+
     // If the user configured an auto-encrypt directory, encrypt it now
     // before we wipe the master password.
     if (!m_AutoEncryptDirectory.isEmpty() && m_PasswordSet)
@@ -1320,6 +2660,9 @@ void Backend::cleanup()
         m_PasswordSet = false;
         emit passwordSetChanged();
     }
+    m_KeyCache->clear();
+    m_Prefetch->clear();
+    m_QuickUnlock->clear();
 
     seal::Cryptography::trimWorkingSet();
     qCInfo(logBackend).noquote() << QString::fromStdString(
@@ -1356,11 +2699,31 @@ void Backend::lockVault()
     qCInfo(logBackend).noquote() << QString::fromStdString(
         seal::diag::joinFields({"event=vault.lock", "result=ok"}));
     m_FillController->cancel();
+    // A running load is abandoned; a running save finishes on its own
+    // password copy so the file on disk is never left half-written.
+    if (m_VaultThread && m_VaultOperation == VaultOperation::Load)
+        cancelOperation();
+    cancelCliCommand();
     m_DPAPIGuard = {};
+    if (m_QuickUnlockEnabled)
+    {
+        // Park instead of wipe: the parked copy is DPAPI-protected and the
+        // keys never leave their protection; both expire on their own.
+        const auto lifetime = quickUnlockLifetime();
+        m_QuickUnlock->park(m_Password, *m_KeyCache, lifetime);
+        QTimer::singleShot(lifetime, this, [this]() { m_QuickUnlock->sweep(); });
+        qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+            {"event=auth.quick_unlock.park",
+             "result=ok",
+             seal::diag::kv("lifetime_min", static_cast<long long>(lifetime.count()))}));
+    }
     seal::Cryptography::cleanseString(m_Password);
+    m_KeyCache->clear();
+    m_Prefetch->clear();
     m_PasswordSet = false;
     emit passwordSetChanged();
-    setStatus("Vault locked - password required for next action");
+    setStatus(m_QuickUnlockEnabled ? "Vault locked - Windows Hello unlocks it again"
+                                   : "Vault locked - password required for next action");
 }
 
 bool Backend::isCompact() const
@@ -1378,6 +2741,11 @@ bool Backend::isCliMode() const
     return m_CliMode;
 }
 
+bool Backend::isCliRunning() const
+{
+    return m_CliThread != nullptr;
+}
+
 void Backend::toggleCliMode()
 {
     m_CliMode = !m_CliMode;
@@ -1388,12 +2756,12 @@ void Backend::toggleCliMode()
     if (m_CliMode && !m_CliWelcomeShown)
     {
         m_CliWelcomeShown = true;
-        emit cliOutputReady(QStringLiteral("seal - Interactive Mode"));
-        emit cliOutputReady(
+        appendCliOutput(QStringLiteral("seal - Interactive Mode"));
+        appendCliOutput(
             QStringLiteral("Commands: :help | :open | :copy | :clear | :gen | :fill | :cls | :qr"));
-        emit cliOutputReady(
+        appendCliOutput(
             QStringLiteral("Type text to encrypt, paste hex to decrypt, or enter a file path."));
-        emit cliOutputReady(QString{});
+        appendCliOutput(QString{});
     }
 }
 
@@ -1409,10 +2777,26 @@ void Backend::executeCliCommand(const QString& command)
     qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
         {"event=cli.command.begin", seal::diag::kv("input_len", input.size())}));
 
+    if (trimmed == ":cancel" || trimmed == ":stop")
+    {
+        if (m_CliThread)
+            cancelCliCommand();
+        else
+            appendCliOutput(QStringLiteral("(nothing to cancel)"));
+        return;
+    }
+
     // --- Built-in commands (no password needed) ---
     seal::CliCallbacks cb;
-    cb.output = [this](const QString& s) { emit cliOutputReady(s); };
-    cb.clearOutput = [this]() { emit cliOutputCleared(); };
+    cb.output = [this](const QString& s) { appendCliOutput(s); };
+    cb.clearOutput = [this]()
+    {
+        {
+            std::lock_guard lock(m_CliOutputMutex);
+            m_CliOutputPending.clear();
+        }
+        emit cliOutputCleared();
+    };
     cb.requestQrCapture = [this]() { requestQrCapture(); };
     cb.armFill = [this](int i) { armFill(i); };
     cb.records = &m_Records;
@@ -1426,6 +2810,14 @@ void Backend::executeCliCommand(const QString& command)
 
     // --- Password-requiring commands ---
 
+    if (m_CliThread)
+    {
+        qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+            {"event=cli.command.finish", "result=skip", "reason=job_running"}));
+        appendCliOutput(QStringLiteral("(busy) previous command still running - :cancel stops it"));
+        return;
+    }
+
     if (!m_PasswordSet)
     {
         qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
@@ -1435,9 +2827,53 @@ void Backend::executeCliCommand(const QString& command)
         return;
     }
 
-    try
+    // The job runs on a worker with its own password copy, like vault loads,
+    // so lockVault() can wipe m_Password while it is still running.
+    seal::basic_secure_string<wchar_t> pw;
     {
         ScopedDpapiUnprotect dpapiScope(m_DPAPIGuard);
+        pw.s.assign(m_Password.s.begin(), m_Password.s.end());
+    }
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    const auto started = std::chrono::steady_clock::now();
+
+    auto* worker = QThread::create(
+        [this, input = std::move(input), pw = std::move(pw), cancel]()
+        { runCliDispatch(input, pw, *cancel); });
+
+    m_CliThread = worker;
+    m_CliCancel = cancel;
+    emit cliRunningChanged();
+
+    connect(worker,
+            &QThread::finished,
+            this,
+            [this, worker, started]()
+            {
+                // cleanup() may already have reaped this worker.
+                if (m_CliThread != worker)
+                    return;
+                worker->deleteLater();
+                m_CliThread = nullptr;
+                const bool cancelled = m_CliCancel->load();
+                m_CliCancel.reset();
+                qCInfo(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+                    {"event=cli.job.finish",
+                     cancelled ? "result=cancelled" : "result=ok",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+                if (cancelled)
+                    appendCliOutput(QStringLiteral("(cancelled)"));
+                emit cliRunningChanged();
+            });
+    worker->start();
+}
+
+void Backend::runCliDispatch(const std::string& input,
+                             const seal::basic_secure_string<wchar_t>& password,
+                             const std::atomic<bool>& cancel)
+{
+    try
+    {
         std::string stripped = seal::utils::stripQuotes(seal::utils::trim(input));
 
         // Strip control characters that may survive from clipboard paste.
@@ -1451,8 +2887,9 @@ void Backend::executeCliCommand(const QString& command)
             stripped.pop_back();
         }
 
-        seal::CliDispatchCallbacks dcb{
-            .output = [this](const QString& s) { emit cliOutputReady(s); }, .password = m_Password};
+        seal::CliDispatchCallbacks dcb{.output = [this](const QString& s) { appendCliOutput(s); },
+                                       .password = password,
+                                       .cancel = &cancel};
 
         // Priority 1: file or directory path
         if (seal::utils::isDirectoryA(stripped))
@@ -1477,7 +2914,7 @@ void Backend::executeCliCommand(const QString& command)
         }
 
         // Priority 2: hex token -> decrypt
-        auto hexTokens = seal::utils::extractHexTokens(input);
+        auto hexTokens = seal::utils::findHexTokens(input);
         if (!hexTokens.empty())
         {
             qCInfo(logBackend).noquote() << QString::fromStdString(
@@ -1485,7 +2922,7 @@ void Backend::executeCliCommand(const QString& command)
                                         "result=dispatch",
                                         "route=hex",
                                         seal::diag::kv("token_count", hexTokens.size())}));
-            seal::CliDispatchHexTokens(input, dcb);
+            seal::CliDispatchHexTokens(hexTokens, dcb);
             return;
         }
 
@@ -1516,8 +2953,45 @@ void Backend::executeCliCommand(const QString& command)
              seal::diag::kv("reason", seal::diag::reasonFromMessage(ex.what())),
              seal::diag::kv("detail", seal::diag::sanitizeAscii(ex.what())),
              seal::diag::kv("input_len", input.size())}));
-        emit cliOutputReady(QString("Error: %1").arg(QString::fromUtf8(ex.what())));
+        appendCliOutput(QString("Error: %1").arg(QString::fromUtf8(ex.what())));
+    }
+}
+
+void Backend::cancelCliCommand()
+{
+    if (!m_CliCancel || m_CliCancel->exchange(true))
+        return;
+    qCInfo(logBackend).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=cli.job.cancel.request"}));
+    appendCliOutput(QStringLiteral("(cancelling after the current item...)"));
+}
+
+void Backend::appendCliOutput(const QString& line)
+{
+    {
+        std::lock_guard lock(m_CliOutputMutex);
+        m_CliOutputPending.append(line);
+        if (m_CliOutputPending.size() > kCliMaxPendingLines)
+            m_CliOutputPending.remove(0, m_CliOutputPending.size() - kCliMaxPendingLines);
+        if (m_CliFlushQueued)
+            return;
+        m_CliFlushQueued = true;
+    }
+    // The timer lives on the GUI thread; workers reach it through the queue.
+    QMetaObject::invokeMethod(
+        this, [this]() { m_CliFlushTimer->start(); }, Qt::QueuedConnection);
+}
+
+void Backend::flushCliOutput()
+{
+    QStringList lines;
+    {
+        std::lock_guard lock(m_CliOutputMutex);
+        lines.swap(m_CliOutputPending);
+        m_CliFlushQueued = false;
     }
+    if (!lines.isEmpty())
+        emit cliOutputReady(lines);
 }
 
 void Backend::handleQrResultForCli(const QString& text)
@@ -1531,7 +3005,7 @@ void Backend::handleQrResultForCli(const QString& text)
                                 "copied=true"}));
     seal::Cryptography::cleanseString(narrow);
     // Mask the QR text in CLI output - value is on the clipboard (TTL-scrubbed).
-    emit cliOutputReady(
+    appendCliOutput(
         QString("(QR captured) %1  [copied]").arg(QString(text.size(), QChar('*'))));
 }
 
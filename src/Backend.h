@@ -3,19 +3,30 @@
 #ifdef USE_QT_UI
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QTimer>
 #include <QVariantMap>
+#include <QtQml/qqmlregistration.h>
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "Cryptography.h"
+#include "FileWatcher.h"
+#include "QuickUnlock.h"
 #include "Vault.h"
 #include "VaultModel.h"
 
+class QJSEngine;
+class QQmlEngine;
+
 namespace seal
 {
 
+class CameraPrewarm;
 class FillController;
 class WindowController;
 
@@ -59,6 +70,22 @@ class WindowController;
  * 5. unloadVault() clears records but retains the master password;
  *    call cleanup() to wipe the password and release all resources.
  *
+ * Loads and saves run on a worker thread: isBusy is raised for the
+ * duration, operationProgress() reports per-record progress, and
+ * cancelOperation() stops the worker at the next record boundary. Record
+ * mutations are refused until the worker finishes.
+ *
+ * Vault keys derived while the password is set are kept in a session
+ * VaultKeyCache, so repeat decrypts (edit, type, auto-fill) skip the KDF.
+ * The cache is wiped by lockVault(), unloadVault(), cleanup(), and any
+ * password change.
+ *
+ * With quick unlock enabled, lockVault() parks the password and the cached
+ * keys in a QuickUnlock instead of wiping them; the next action that needs
+ * the password asks for Windows Hello and resumes without a prompt or a
+ * KDF run. The parked secrets expire after the configured lifetime and are
+ * wiped by cleanup(), session end, and manual password entry.
+ *
  * ## :material-key: Pending-Action Pattern
  *
  * Many operations (loadVault, addAccount, armFill, ...) require the master
@@ -100,11 +127,21 @@ class WindowController;
  * text is proposed via qrTextReady() to pre-fill the password dialog;
  * the password is not committed until the user confirms.
  *
+ * ## :material-language-javascript: QML Registration
+ *
+ * Backend is registered as the `seal` module's `Backend` singleton rather
+ * than as a context property, so qmlcachegen knows its type and compiles
+ * the bindings that use it ahead of time. The instance itself is still
+ * owned by RunQMLMode(), which hands it over with setQmlInstance() before
+ * loading Main.qml.
+ *
  * @see FillController, VaultListModel, Cryptography
  */
 class Backend : public QObject
 {
     Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
 
     Q_PROPERTY(VaultListModel* vaultModel READ vaultModel CONSTANT)
     Q_PROPERTY(bool vaultLoaded READ vaultLoaded NOTIFY vaultLoadedChanged)
@@ -124,6 +161,11 @@ class Backend : public QObject
     Q_PROPERTY(bool isAlwaysOnTop READ isAlwaysOnTop NOTIFY alwaysOnTopChanged)
     Q_PROPERTY(bool isCompact READ isCompact NOTIFY compactChanged)
     Q_PROPERTY(bool isCliMode READ isCliMode NOTIFY cliModeChanged)
+    Q_PROPERTY(bool isCliRunning READ isCliRunning NOTIFY cliRunningChanged)
+    Q_PROPERTY(bool prefetchEnabled READ isPrefetchEnabled WRITE setPrefetchEnabled NOTIFY
+                   prefetchEnabledChanged)
+    Q_PROPERTY(bool quickUnlockEnabled READ isQuickUnlockEnabled WRITE setQuickUnlockEnabled NOTIFY
+                   quickUnlockEnabledChanged)
 
 public:
     /// @brief Construct the backend, creating the vault model and fill controller.
@@ -132,6 +174,15 @@ public:
     /// @brief Destructor. Wipes sensitive data and removes hooks.
     ~Backend() override;
 
+    /// @brief Set the instance the QML engine receives for the `Backend` singleton.
+    static void setQmlInstance(Backend* backend);
+
+    /**
+     * @brief Singleton factory called by the QML engine.
+     * @return The instance passed to setQmlInstance(), with C++ ownership.
+     */
+    static Backend* create(QQmlEngine* qmlEngine, QJSEngine* jsEngine);
+
     /// @brief Get the vault list model for QML binding.
     VaultListModel* vaultModel() const;
 
@@ -179,12 +230,41 @@ public:
     /// @brief Get seconds remaining before auto-fill times out.
     int fillCountdownSeconds() const;
 
+    /// @brief Check whether selecting a row decrypts its credential ahead of a fill.
+    bool isPrefetchEnabled() const;
+
+    /**
+     * @brief Opt in to (or out of) credential prefetch on row selection.
+     *
+     * Persisted in QSettings. While enabled, setSelectedIndex() starts a
+     * background decrypt of the new row; typeLogin(), typePassword() and
+     * armFill() then use the result if it is still fresh. Disabling drops
+     * any prefetched credential.
+     *
+     * @param enabled New setting.
+     */
+    void setPrefetchEnabled(bool enabled);
+
+    /// @brief Check whether lockVault() parks the session for a quick unlock.
+    bool isQuickUnlockEnabled() const;
+
+    /**
+     * @brief Opt in to (or out of) quick unlock after lockVault().
+     *
+     * Persisted in QSettings (`security/quickUnlock`); the lifetime of the
+     * parked secrets comes from `security/quickUnlockMinutes`, clamped to
+     * seal::cfg::QUICK_UNLOCK_MAX_MINUTES. Disabling wipes anything parked.
+     *
+     * @param enabled New setting.
+     */
+    void setQuickUnlockEnabled(bool enabled);
+
     /**
      * @brief Open a vault file via file dialog and load its index.
      *
      * Prompts for master password if not already set. Decrypts platform
-     * names (index only - credentials stay encrypted until needed).
-     * Emits vaultLoadedChanged on success.
+     * names (index only - credentials stay encrypted until needed) on a
+     * worker thread; emits vaultLoadedChanged once the worker succeeds.
      */
     Q_INVOKABLE void loadVault();
 
@@ -192,7 +272,8 @@ public:
      * @brief Save the current vault records to disk.
      *
      * Writes all records (including any pending adds/edits/deletes)
-     * using saveVaultV2 format. Prompts for file path on first save.
+     * using saveVaultV2 format on a worker thread. Prompts for file path
+     * on first save.
      */
     Q_INVOKABLE void saveVault();
 
@@ -246,6 +327,56 @@ public:
      */
     Q_INVOKABLE void deleteAccount(int index);
 
+    /**
+     * @brief Mark several credentials as deleted in one step.
+     *
+     * Like deleteAccount(), but the whole selection costs one generation
+     * bump and one model refresh.
+     *
+     * @param indices Record indices (not visual rows) to delete
+     * @param save    Save the vault once afterwards
+     */
+    Q_INVOKABLE void deleteAccounts(const QVariantList& indices, bool save = false);
+
+    /**
+     * @brief Move several credentials into another vault file.
+     *
+     * Asks for the target `.seal` file, which is created if it does not
+     * exist and must otherwise open with the current master password. The
+     * records are appended there on a worker thread and soft-deleted here
+     * once the target has been written.
+     *
+     * @param indices Record indices (not visual rows) to move
+     * @param save    Save this vault once afterwards
+     */
+    Q_INVOKABLE void moveAccounts(const QVariantList& indices, bool save = false);
+
+    /**
+     * @brief Replace the passwords of several credentials with generated ones.
+     *
+     * Runs seal::rotateCredentialPasswords(): one password batch and one
+     * vault key derivation for the whole selection.
+     *
+     * @param indices Record indices (not visual rows) to rotate
+     * @param length  Characters per new password
+     * @param save    Save the vault once afterwards
+     * @throw std::runtime_error on decryption/authentication failure.
+     */
+    Q_INVOKABLE void rotateAccountPasswords(const QVariantList& indices,
+                                            int length = 20,
+                                            bool save = false);
+
+    /**
+     * @brief Flag breached and reused passwords across the vault.
+     *
+     * Runs seal::auditCredentials() on a worker over a snapshot of the
+     * records, against the breach list remembered in QSettings
+     * (`audit/breachIndex`). Without one, asks for a Pwned Passwords dump
+     * or index; cancelling the dialog audits reuse only. The flags are
+     * shown as row badges until the records change or the vault unloads.
+     */
+    Q_INVOKABLE void auditPasswords();
+
     /**
      * @brief Decrypt a credential for display in the edit dialog.
      *
@@ -303,7 +434,10 @@ public:
     /**
      * @brief Attempt to auto-load a vault from well-known locations.
      *
-     * Searches for a `.seal` vault file in priority order:
+     * Opens the vault found by startVaultDiscovery(), starting the
+     * discovery first if nobody has yet. If it is still running, the load
+     * happens as soon as it finishes. Candidates, in priority order:
+     * 0. The vault opened or saved last time, if the file still exists
      * 1. Next to the executable
      * 2. Current working directory
      * 3. User's home directory
@@ -312,6 +446,17 @@ public:
      */
     Q_INVOKABLE void autoLoadVault();
 
+    /**
+     * @brief Look for the auto-load vault on a worker thread.
+     *
+     * Called by RunQMLMode() before Main.qml is loaded, so the file system
+     * round trips (slow on roaming profiles and redirected folders) overlap
+     * engine and window creation. The remembered path costs only one
+     * existence check. The directory scan runs only if that file is gone,
+     * and it lists all roots concurrently. No-op once started.
+     */
+    void startVaultDiscovery();
+
     /**
      * @brief Clean up resources before application exit.
      *
@@ -371,8 +516,13 @@ public:
     Q_INVOKABLE void toggleAlwaysOnTop();
 
     /// @brief Wipe the master password without unloading the vault.
+    /// A running vault load is cancelled; a running save is left to finish.
     Q_INVOKABLE void lockVault();
 
+    /// @brief Ask the running vault load/save worker to stop.
+    /// No-op when no vault operation is in progress.
+    Q_INVOKABLE void cancelOperation();
+
     /// @brief Toggle compact mode (shrinks window to a minimal strip).
     Q_INVOKABLE void toggleCompact();
 
@@ -384,7 +534,7 @@ public:
      *
      * Supported input types (tried in order):
      * - **Built-in commands**: `:help`, `:open`, `:copy`, `:clear`, `:cls`,
-     *   `:gen [len]`, `:qr`, `:fill <index>`, `:hex`, `:unhex` (no password needed).
+     *   `:gen [len]`, `:qr`, `:fill <index>`, `:hex`, `:unhex`, `:cancel` (no password needed).
      * - **File/directory paths**: encrypt or decrypt based on `.seal` extension.
      * - **Hex tokens**: decrypt and copy to clipboard.
      * - **Base64 ciphertext**: decrypt and copy to clipboard.
@@ -393,10 +543,18 @@ public:
      * Commands that require the master password trigger the password dialog
      * via the pending-action pattern if the password is not yet set.
      *
+     * Built-ins run inline. Everything that needs the password runs on a
+     * worker thread with its own password copy, so the panel stays usable
+     * while a directory or a long token list is processed; one such job
+     * runs at a time and `:cancel` stops it between items.
+     *
      * @param command The command string entered by the user.
      */
     Q_INVOKABLE void executeCliCommand(const QString& command);
 
+    /// @brief Stop the running CLI job after the file or token in progress.
+    Q_INVOKABLE void cancelCliCommand();
+
     /// @brief Handle QR capture result when in CLI mode.
     /// @param text The captured QR text.
     Q_INVOKABLE void handleQrResultForCli(const QString& text);
@@ -410,6 +568,9 @@ public:
     /// @brief Check whether the CLI panel is active.
     bool isCliMode() const;
 
+    /// @brief Check whether a CLI job is running on its worker thread.
+    bool isCliRunning() const;
+
 signals:
     void vaultLoadedChanged();    ///< Vault open/close state changed.
     void vaultFileNameChanged();  ///< Vault file name changed.
@@ -420,6 +581,14 @@ signals:
     void countdownTextChanged();  ///< Countdown display text changed.
     void busyChanged();           ///< Background operation started or finished.
 
+    void prefetchEnabledChanged();     ///< Prefetch-on-selection setting changed.
+    void quickUnlockEnabledChanged();  ///< Quick-unlock setting changed.
+
+    /// @brief Progress of the running vault load/save.
+    /// @param done  Records processed so far.
+    /// @param total Records in the operation (0 while still unknown).
+    void operationProgress(int done, int total);
+
     /// @brief An error occurred that should be shown to the user.
     /// @param title   Dialog title
     /// @param message Error description
@@ -464,10 +633,11 @@ signals:
     void alwaysOnTopChanged();           ///< Always-on-top toggled.
     void compactChanged();               ///< Compact mode toggled.
     void cliModeChanged();               ///< CLI mode toggled.
+    void cliRunningChanged();            ///< CLI job started or finished.
 
-    /// @brief Output text from CLI command execution.
-    /// @param text The output line to display in the CLI panel.
-    void cliOutputReady(const QString& text);
+    /// @brief Output from CLI command execution, coalesced per frame.
+    /// @param lines The output lines to append to the CLI panel, oldest first.
+    void cliOutputReady(const QStringList& lines);
 
     /// @brief CLI panel output should be cleared.
     void cliOutputCleared();
@@ -492,18 +662,105 @@ private:
      */
     void cancelFillIfArmed();
 
+    /**
+     * @brief Seal an account under the vault key for addAccount()/editAccount().
+     *
+     * Wraps seal::encryptCredential() so a failure, most often a mistyped
+     * master password that does not open the vault's existing records, is
+     * logged and reported through errorOccurred() instead of escaping.
+     *
+     * @param service  Platform name.
+     * @param username Username in locked memory.
+     * @param password Password in locked memory.
+     * @param event    Log event field, e.g. "event=vault.record.add".
+     * @param[out] out Receives the sealed record on success.
+     * @return true on success.
+     */
+    bool sealAccount(const QString& service,
+                     const seal::basic_secure_string<wchar_t>& username,
+                     const seal::basic_secure_string<wchar_t>& password,
+                     const char* event,
+                     seal::VaultRecord& out);
+
+    /// @brief Kind of vault worker currently running.
+    enum class VaultOperation
+    {
+        Load,
+        Save
+    };
+
+    /**
+     * @brief Refuse to start a vault-mutating action while a worker runs.
+     * @return true (after updating the status text) if a load/save is in progress.
+     */
+    bool vaultOperationPending();
+
+    /**
+     * @brief Build a progress callback that forwards to operationProgress().
+     *
+     * The callback is safe to call from worker threads; it posts at most one
+     * update per whole percent and returns false once @p cancel is set.
+     */
+    seal::VaultProgress makeProgressReporter(std::shared_ptr<std::atomic<bool>> cancel);
+
+    /**
+     * @brief Mark the backend busy and start a vault worker thread.
+     *
+     * @param worker     Unstarted thread running the load/save.
+     * @param kind       Whether the worker loads or saves.
+     * @param cancel     Cancellation flag shared with the worker.
+     * @param onFinished Runs on the GUI thread after the worker exits.
+     */
+    void startVaultOperation(QThread* worker,
+                             VaultOperation kind,
+                             std::shared_ptr<std::atomic<bool>> cancel,
+                             std::function<void()> onFinished);
+
     /**
      * @brief Attempt to load a vault from the given path.
      *
-     * On wrong-password, clears the master key, re-queues itself as
-     * the pending action, and emits passwordRetryRequired() so the UI
-     * can re-prompt.
+     * Runs loadVaultIndex() on a worker thread and applies the result on
+     * the GUI thread. On wrong-password, clears the master key, re-queues
+     * itself as the pending action, and emits passwordRetryRequired() so
+     * the UI can re-prompt.
      *
      * @param filePath Absolute path to the .seal vault file
      * @param isAutoLoad True when called from autoLoadVault()
      */
     void loadVaultFromPath(const QString& filePath, bool isAutoLoad = false);
 
+    /**
+     * @brief Run the password-requiring part of a CLI command.
+     *
+     * Called on the CLI worker thread; routes @p input to the CliDispatch
+     * handlers and reports through appendCliOutput() only.
+     *
+     * @param input    Trimmed command text.
+     * @param password Worker-owned copy of the master password.
+     * @param cancel   Set by cancelCliCommand(); checked between items.
+     */
+    void runCliDispatch(const std::string& input,
+                        const seal::basic_secure_string<wchar_t>& password,
+                        const std::atomic<bool>& cancel);
+
+    /**
+     * @brief Queue one line for the CLI panel. Safe to call from any thread.
+     *
+     * Lines are held in a bounded backlog and delivered by flushCliOutput()
+     * at most once per frame; when a job outruns the panel, the oldest
+     * undelivered lines are dropped, as the panel would trim them anyway.
+     */
+    void appendCliOutput(const QString& line);
+
+    /// @brief Deliver the queued CLI lines in one cliOutputReady(). GUI thread only.
+    void flushCliOutput();
+
+    /// @brief Load the discovered vault once discovery finished and autoLoadVault() asked.
+    void openDiscoveredVault();
+
+    /// @brief Remember @p path as the vault discovery tries first next start.
+    static void rememberVaultPath(const QString& path);
+
     /**
      * @brief Update the status bar text and emit statusTextChanged().
      * @param text New status message
@@ -537,6 +794,80 @@ private:
      */
     void refreshModel();
 
+    /**
+     * @brief Decrypt the selected record in the background if prefetch is on.
+     *
+     * No-op without a password, with prefetch disabled, or for an invalid
+     * or deleted row. Schedules a sweep so the result is wiped once its
+     * TTL passes even if no fill takes it.
+     */
+    void startPrefetch();
+
+    /**
+     * @brief Start a Windows Hello check to restore a parked session.
+     *
+     * On success the parked password and keys are restored and the pending
+     * action runs; otherwise the password dialog is shown as usual.
+     *
+     * @return `true` if a check is running (the caller must not prompt), or
+     *         `false` when quick unlock is off or nothing is parked.
+     */
+    bool tryQuickUnlock();
+
+    /**
+     * @brief Watch m_CurrentVaultPath for changes made outside this session.
+     *
+     * Replaces the watcher when the path changed and drops it when no vault
+     * is open. A watcher that cannot start is logged and left off.
+     */
+    void watchVaultFile();
+
+    /**
+     * @brief React to a settled change of the watched vault file.
+     *
+     * Ignores our own writes (the file still has the stamp m_Journal
+     * recorded), waits out a running load or save, and defers the reload
+     * until the vault is unlocked.
+     */
+    void onVaultFileChanged();
+
+    /**
+     * @brief Re-read the changed vault file and merge it into m_Records.
+     *
+     * Runs loadVaultIndex() on a worker with the open records as known
+     * records, so only re-sealed records are decrypted, then applies
+     * mergeReloadedRecords() and one incremental model refresh.
+     * Conflicting edits are kept as "(conflicted copy)" records.
+     *
+     * @param thenSave Call saveVault() once the merge succeeded; a failed
+     *                 reload skips the save rather than overwrite the file.
+     */
+    void reloadVaultFromDisk(bool thenSave = false);
+
+    /**
+     * @brief Resolve QML record indices to live, distinct record positions.
+     * @return Ascending indices; out-of-range and deleted entries are dropped.
+     */
+    std::vector<size_t> liveRecordIndices(const QVariantList& indices) const;
+
+    /**
+     * @brief Publish a bulk record change: one generation bump, one refresh.
+     *
+     * Also notifies QML when no visible record is left, and saves once if
+     * @p save is set.
+     *
+     * @param save Call saveVault() afterwards.
+     */
+    void finishBulkChange(bool save);
+
+    /**
+     * @brief Size the working-set quota for the loaded vault.
+     *
+     * Calls working_set::reserve() with the record count and the process
+     * KDF's memory, and logs the outcome with the locked-memory counters.
+     */
+    void reserveLockedMemory();
+
     /**
      * @brief Convert a QString to a secure wide-character string.
      *
@@ -549,6 +880,8 @@ private:
     static seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>> qstringToSecureWide(
         const QString& qstr);
 
+    static inline Backend* s_QmlInstance = nullptr;  ///< Set by setQmlInstance().
+
     std::function<void()> m_PendingAction;  ///< Action deferred until password is entered.
 
     VaultListModel* m_Model = nullptr;               ///< Vault list model for QML binding.
@@ -559,12 +892,29 @@ private:
     seal::DPAPIGuard<seal::basic_secure_string<wchar_t>>
         m_DPAPIGuard;            ///< DPAPI in-memory encryption for m_Password.
     bool m_PasswordSet = false;  ///< Whether master password has been entered.
+    std::shared_ptr<seal::VaultKeyCache>
+        m_KeyCache;  ///< Derived vault keys for m_Password; cleared whenever it is wiped.
+    std::unique_ptr<seal::CredentialPrefetch>
+        m_Prefetch;                  ///< Selected row's credential, decrypted ahead of a fill.
+    bool m_PrefetchEnabled = false;  ///< Opt-in; see setPrefetchEnabled().
+
+    std::unique_ptr<seal::QuickUnlock>
+        m_QuickUnlock;                  ///< Session parked by lockVault() for a quick unlock.
+    bool m_QuickUnlockEnabled = false;  ///< Opt-in; see setQuickUnlockEnabled().
+    QThread* m_UnlockThread = nullptr;  ///< Windows Hello check in progress.
+    std::unique_ptr<seal::CameraPrewarm>
+        m_CameraPrewarm;  ///< Loads the capture stack while the password dialog is up.
 
     QString m_CurrentVaultPath;                ///< Path to the currently loaded vault file.
     std::vector<seal::VaultRecord> m_Records;  ///< In-memory vault records.
     uint64_t m_RecordsGeneration = 0;          ///< Monotonic counter incremented on every records
                                        ///< mutation so borrowed-pointer holders (FillController,
                                        ///< VaultListModel) can detect stale references.
+    seal::VaultJournalState
+        m_Journal;  ///< On-disk state of m_CurrentVaultPath for incremental (journal) saves.
+    std::unique_ptr<seal::FileWatcher>
+        m_Watcher;                     ///< Reports outside changes to m_CurrentVaultPath.
+    bool m_DiskChangePending = false;  ///< The file changed while locked; reload on unlock.
     QString m_AutoEncryptDirectory;  ///< Directory for auto-encrypt on save.
 
     int m_SelectedIndex = -1;                        ///< Currently selected row (-1 = none).
@@ -575,6 +925,20 @@ private:
     bool m_CliMode = false;                          ///< CLI panel active.
     bool m_CliWelcomeShown = false;                  ///< Welcome banner shown once.
     QThread* m_QrThread = nullptr;                   ///< Active QR capture worker thread.
+    QThread* m_VaultThread = nullptr;                ///< Active vault load/save worker thread.
+    VaultOperation m_VaultOperation = VaultOperation::Load;  ///< Kind of m_VaultThread.
+    std::shared_ptr<std::atomic<bool>> m_VaultCancel;        ///< Cancel flag for m_VaultThread.
+    QThread* m_CliThread = nullptr;                          ///< Active CLI job worker thread.
+    QThread* m_DiscoveryThread = nullptr;                    ///< Vault discovery worker thread.
+    QString m_DiscoveredVaultPath;                           ///< Discovery result; empty = none.
+    bool m_DiscoveryStarted = false;                         ///< startVaultDiscovery() ran.
+    bool m_DiscoveryDone = false;                            ///< m_DiscoveredVaultPath is final.
+    bool m_AutoLoadRequested = false;                        ///< autoLoadVault() awaits discovery.
+    std::shared_ptr<std::atomic<bool>> m_CliCancel;          ///< Cancel flag for m_CliThread.
+    QTimer* m_CliFlushTimer = nullptr;                       ///< Paces flushCliOutput().
+    std::mutex m_CliOutputMutex;                             ///< Guards the two members below.
+    QStringList m_CliOutputPending;                          ///< CLI lines not yet sent to QML.
+    bool m_CliFlushQueued = false;                           ///< A flush is already armed.
 };
 
 }  // namespace seal
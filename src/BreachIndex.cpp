@@ -0,0 +1,353 @@
+#include "BreachIndex.h"
+
+#include "CryptoConfig.h"
+
+#include <openssl/evp.h>
+
+#include <windows.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace seal
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little,
+              "The breach index is written and mapped in native (little-endian) order");
+
+constexpr char kMagic[8] = {'S', 'E', 'A', 'L', 'H', 'I', 'B', 'P'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kPrefixBytes = 8;
+constexpr size_t kHeaderBytes = 64;
+constexpr size_t kFanoutEntries = 65537;  // one start per 16-bit bucket, plus the end
+constexpr size_t kFanoutBytes = kFanoutEntries * sizeof(uint64_t);
+constexpr size_t kChunkEntries = 1 << 16;         // prefixes per write
+constexpr uint64_t kProgressBytes = 64ULL << 20;  // dump bytes between progress calls
+constexpr uint64_t kDumpBytesPerLine = 44;        // "HEX40:count\r\n" on average
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t prefixBytes;
+    uint64_t count;
+    uint64_t bloomBits;
+    uint32_t bloomHashes;
+    unsigned char reserved[28];
+};
+static_assert(sizeof(Header) == kHeaderBytes);
+
+int hexNibble(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// Parse `HEX40` or `HEX40:count` into the digest's first two 64-bit words.
+bool parseHashLine(const std::string& line, uint64_t& hi, uint64_t& lo)
+{
+    if (line.size() < 40 || (line.size() > 40 && line[40] != ':'))
+        return false;
+    hi = 0;
+    lo = 0;
+    for (size_t i = 0; i < 40; ++i)
+    {
+        const int n = hexNibble(line[i]);
+        if (n < 0)
+            return false;
+        if (i < 16)
+            hi = (hi << 4) | static_cast<uint64_t>(n);
+        else if (i < 32)
+            lo = (lo << 4) | static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+uint64_t readU64BE(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+// Bloom probe @p i: double hashing over two independent words of the digest.
+uint64_t bloomBit(uint64_t hi, uint64_t lo, uint32_t i, uint64_t bits)
+{
+    return (hi + static_cast<uint64_t>(i) * (lo | 1)) % bits;
+}
+
+}  // namespace
+
+BreachIndex::BreachIndex(const std::string& path)
+{
+    HANDLE file = CreateFileA(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot open breach index");
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) ||
+        static_cast<uint64_t>(size.QuadPart) < kHeaderBytes + kFanoutBytes)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Invalid breach index");
+    }
+    HANDLE section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = section ? MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (section)
+            CloseHandle(section);
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map breach index");
+    }
+    m_File = file;
+    m_Section = section;
+    m_View = static_cast<const unsigned char*>(view);
+
+    // Everything below is read straight from the view, so the header has
+    // to account for every byte before any of it is trusted.
+    Header header;
+    std::memcpy(&header, m_View, sizeof(header));
+    const uint64_t fileBytes = static_cast<uint64_t>(size.QuadPart);
+    const uint64_t prefixRoom = (fileBytes - kHeaderBytes - kFanoutBytes) / sizeof(uint64_t);
+    m_Fanout = reinterpret_cast<const uint64_t*>(m_View + kHeaderBytes);
+    const bool valid =
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 && header.version == kVersion &&
+        header.prefixBytes == kPrefixBytes && header.count <= prefixRoom &&
+        header.bloomBits % 64 == 0 && (header.bloomBits == 0) == (header.bloomHashes == 0) &&
+        header.bloomHashes <= 32 &&
+        fileBytes == kHeaderBytes + kFanoutBytes + header.count * sizeof(uint64_t) +
+                         header.bloomBits / 8 &&
+        m_Fanout[0] == 0 && m_Fanout[kFanoutEntries - 1] == header.count;
+    if (!valid)
+    {
+        UnmapViewOfFile(view);
+        CloseHandle(section);
+        CloseHandle(file);
+        throw std::runtime_error("Invalid breach index");
+    }
+    m_Prefixes = m_Fanout + kFanoutEntries;
+    m_Count = header.count;
+    m_BloomBits = header.bloomBits;
+    m_BloomHashes = header.bloomHashes;
+    if (m_BloomBits != 0)
+        m_Bloom = m_Prefixes + m_Count;
+}
+
+BreachIndex::~BreachIndex()
+{
+    if (m_View)
+        UnmapViewOfFile(m_View);
+    if (m_Section)
+        CloseHandle(static_cast<HANDLE>(m_Section));
+    if (m_File)
+        CloseHandle(static_cast<HANDLE>(m_File));
+    m_View = nullptr;
+    m_Section = nullptr;
+    m_File = nullptr;
+}
+
+bool BreachIndex::contains(std::span<const unsigned char, 20> sha1) const noexcept
+{
+    const uint64_t hi = readU64BE(sha1.data());
+    const uint64_t lo = readU64BE(sha1.data() + 8);
+    if (m_Bloom)
+    {
+        for (uint32_t i = 0; i < m_BloomHashes; ++i)
+        {
+            const uint64_t bit = bloomBit(hi, lo, i, m_BloomBits);
+            if ((m_Bloom[bit / 64] & (1ULL << (bit % 64))) == 0)
+                return false;
+        }
+    }
+    const uint64_t bucket = hi >> 48;
+    const uint64_t* first = m_Prefixes + m_Fanout[bucket];
+    const uint64_t* last = m_Prefixes + m_Fanout[bucket + 1];
+    // A corrupt fanout must not walk outside the prefix array.
+    if (first > last || last > m_Prefixes + m_Count)
+        return false;
+    const uint64_t* it = std::lower_bound(first, last, hi);
+    return it != last && *it == hi;
+}
+
+BreachIndex::BuildStats BreachIndex::build(std::istream& dump,
+                                           const std::string& indexPath,
+                                           uint64_t bloomEntries,
+                                           const BuildProgress& progress)
+{
+    BuildStats stats;
+    const uint64_t bloomBits =
+        bloomEntries ? (bloomEntries * cfg::BREACH_BLOOM_BITS_PER_ENTRY + 63) / 64 * 64 : 0;
+    std::vector<uint64_t> bloom(bloomBits / 64, 0);
+
+    const std::string tmpPath = indexPath + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Cannot create breach index");
+    auto fail = [&](const char* what)
+    {
+        out.close();
+        DeleteFileA(tmpPath.c_str());
+        throw std::runtime_error(what);
+    };
+
+    // Header and fanout are patched in once the counts are known.
+    const std::vector<char> placeholder(kHeaderBytes + kFanoutBytes, 0);
+    out.write(placeholder.data(), static_cast<std::streamsize>(placeholder.size()));
+
+    std::vector<uint64_t> fanout(kFanoutEntries, 0);
+    std::vector<uint64_t> chunk;
+    chunk.reserve(kChunkEntries);
+    auto flushChunk = [&]
+    {
+        out.write(reinterpret_cast<const char*>(chunk.data()),
+                  static_cast<std::streamsize>(chunk.size() * sizeof(uint64_t)));
+        chunk.clear();
+    };
+
+    std::string line;
+    uint64_t bytesRead = 0;
+    uint64_t nextReport = kProgressBytes;
+    uint64_t previous = 0;
+    while (std::getline(dump, line))
+    {
+        bytesRead += line.size() + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        uint64_t hi = 0;
+        uint64_t lo = 0;
+        if (!parseHashLine(line, hi, lo))
+            fail("Malformed breach dump line");
+        if (stats.entries > 0 && hi < previous)
+            fail("Breach dump is not sorted by hash");
+        ++stats.lines;
+        for (uint32_t i = 0; bloomBits && i < cfg::BREACH_BLOOM_HASHES; ++i)
+        {
+            const uint64_t bit = bloomBit(hi, lo, i, bloomBits);
+            bloom[bit / 64] |= 1ULL << (bit % 64);
+        }
+        // Distinct hashes can share a prefix; the index stores it once.
+        if (stats.entries > 0 && hi == previous)
+            continue;
+        previous = hi;
+        ++stats.entries;
+        ++fanout[(hi >> 48) + 1];
+        chunk.push_back(hi);
+        if (chunk.size() == kChunkEntries)
+            flushChunk();
+        if (bytesRead >= nextReport)
+        {
+            nextReport += kProgressBytes;
+            if (progress && !progress(bytesRead))
+                fail("Operation cancelled");
+        }
+    }
+    if (dump.bad())
+        fail("Cannot read breach dump");
+    flushChunk();
+    out.write(reinterpret_cast<const char*>(bloom.data()),
+              static_cast<std::streamsize>(bloom.size() * sizeof(uint64_t)));
+    for (size_t b = 1; b < kFanoutEntries; ++b)
+        fanout[b] += fanout[b - 1];
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.prefixBytes = kPrefixBytes;
+    header.count = stats.entries;
+    header.bloomBits = bloomBits;
+    header.bloomHashes = bloomBits ? cfg::BREACH_BLOOM_HASHES : 0;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(fanout.data()),
+              static_cast<std::streamsize>(kFanoutBytes));
+    out.flush();
+    if (!out)
+        fail("Cannot write breach index");
+    out.close();
+    if (!MoveFileExA(tmpPath.c_str(),
+                     indexPath.c_str(),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileA(tmpPath.c_str());
+        throw std::runtime_error("Cannot write breach index");
+    }
+
+    stats.bloomBits = bloomBits;
+    stats.indexBytes = kHeaderBytes + kFanoutBytes + stats.entries * sizeof(uint64_t) +
+                       bloomBits / 8;
+    return stats;
+}
+
+std::unique_ptr<BreachIndex> BreachIndex::openOrBuild(const std::string& path,
+                                                      bool bloom,
+                                                      const BuildProgress& progress,
+                                                      BuildStats* built)
+{
+    if (built)
+        *built = {};
+    if (isIndexFile(path))
+        return std::make_unique<BreachIndex>(path);
+
+    const std::string indexPath = path + ".sidx";
+    std::error_code ec;
+    const auto dumpStamp = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        throw std::runtime_error("Cannot open breach dump");
+    const auto indexStamp = std::filesystem::last_write_time(indexPath, ec);
+    if (!ec && indexStamp >= dumpStamp && isIndexFile(indexPath))
+        return std::make_unique<BreachIndex>(indexPath);
+
+    const uint64_t dumpBytes = std::filesystem::file_size(path, ec);
+    const uint64_t bloomEntries = bloom && !ec ? dumpBytes / kDumpBytesPerLine + 1 : 0;
+    std::vector<char> buffer(1 << 20);
+    std::ifstream dump;
+    dump.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    dump.open(path, std::ios::binary);
+    if (!dump)
+        throw std::runtime_error("Cannot open breach dump");
+    const BuildStats stats = build(dump, indexPath, bloomEntries, progress);
+    if (built)
+        *built = stats;
+    return std::make_unique<BreachIndex>(indexPath);
+}
+
+bool BreachIndex::isIndexFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(kMagic)] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+void BreachIndex::sha1(std::span<const unsigned char> data, std::span<unsigned char, 20> out)
+{
+    unsigned int len = 0;
+    if (EVP_Digest(data.data(), data.size(), out.data(), &len, EVP_sha1(), nullptr) != 1 ||
+        len != out.size())
+        throw std::runtime_error("SHA-1 digest failed");
+}
+
+}  // namespace seal
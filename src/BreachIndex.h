@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace seal
+{
+
+/**
+ * @class BreachIndex
+ * @brief Read-only, memory-mapped index of breached password hashes.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Crypto
+ *
+ * The Have I Been Pwned "Pwned Passwords" dump is a ~40 GB text file of
+ * `SHA1HEX:count` lines sorted by hash. build() converts it once into a
+ * compact binary file; the index then opens in constant time and answers
+ * contains() in O(log n) straight out of the mapped view, with no parse
+ * step and no heap copy of the dump.
+ *
+ * File format (little-endian):
+ * `magic "SEALHIBP"(8) | version(4) | prefix_bytes(4) | count(8) |
+ *  bloom_bits(8) | bloom_hashes(4) | reserved(28) | fanout(65537 x 8) |
+ *  prefixes(count x 8) | bloom(bloom_bits / 8)`.
+ *
+ * - Each entry is the first 8 bytes of a SHA-1, read big-endian, so the
+ *   array sorts numerically. Against the full dump, a random password
+ *   falsely matches with probability about count / 2^64 (around 5e-11).
+ * - `fanout[b]` is the first entry whose top 16 bits are `b`. A lookup
+ *   only binary-searches its bucket, a few pages of the file.
+ * - The optional Bloom filter answers most misses without touching the
+ *   prefix array. Its probe positions come from the hash itself, which
+ *   is already uniform.
+ *
+ * Instances are immutable after construction, so contains() is safe to
+ * call from any number of threads.
+ */
+class BreachIndex
+{
+public:
+    /// @brief Outcome of build().
+    struct BuildStats
+    {
+        uint64_t lines = 0;       ///< Hash lines read from the dump
+        uint64_t entries = 0;     ///< Distinct prefixes written
+        uint64_t bloomBits = 0;   ///< Bloom filter size; 0 without one
+        uint64_t indexBytes = 0;  ///< Size of the index file
+    };
+
+    /// @brief Progress callback for build(): dump bytes consumed; `false` cancels.
+    using BuildProgress = std::function<bool(uint64_t bytesRead)>;
+
+    /**
+     * @brief Map the index file at @p path.
+     * @param path Index written by build() (ANSI, as passed to the Win32 `A` APIs).
+     * @throw std::runtime_error if the file cannot be opened or is not a valid index.
+     */
+    explicit BreachIndex(const std::string& path);
+
+    /// @brief Destructor. Unmaps the view and closes the file.
+    ~BreachIndex();
+
+    BreachIndex(const BreachIndex&) = delete;
+    BreachIndex& operator=(const BreachIndex&) = delete;
+
+    /// @brief Whether @p sha1 (a full 20-byte digest) is in the index.
+    [[nodiscard]] bool contains(std::span<const unsigned char, 20> sha1) const noexcept;
+
+    /// @brief Number of prefixes in the index.
+    [[nodiscard]] uint64_t size() const noexcept { return m_Count; }
+
+    /// @brief Whether the index carries a Bloom filter.
+    [[nodiscard]] bool hasBloom() const noexcept { return m_BloomBits != 0; }
+
+    /**
+     * @brief Convert a sorted SHA-1 dump into an index file.
+     *
+     * Streams @p dump line by line (`HEX40` or `HEX40:count`, CRLF or LF)
+     * and writes the prefixes as it goes, so memory stays bounded by the
+     * Bloom filter. The index is built in `indexPath.tmp` and renamed over
+     * @p indexPath only once complete.
+     *
+     * @param dump         Dump text, sorted by hash as HIBP publishes it.
+     * @param indexPath    Output index file.
+     * @param bloomEntries Expected hash count to size a Bloom filter for
+     *                     (cfg::BREACH_BLOOM_BITS_PER_ENTRY bits each); 0
+     *                     builds the index without one.
+     * @param progress     Optional; called every few MiB of input.
+     * @return What was written.
+     * @throw std::runtime_error on a malformed or unsorted line, I/O failure,
+     *        or cancellation ("Operation cancelled").
+     */
+    static BuildStats build(std::istream& dump,
+                            const std::string& indexPath,
+                            uint64_t bloomEntries = 0,
+                            const BuildProgress& progress = {});
+
+    /**
+     * @brief Open the breach list at @p path, indexing a dump on first use.
+     *
+     * An index file opens directly. Anything else is taken for a dump and
+     * indexed into `<path>.sidx` beside it, which is reused for as long as
+     * it is at least as new as the dump.
+     *
+     * @param path     Index file, or the dump to index.
+     * @param bloom    Give a newly built index a Bloom filter, sized from the
+     *                 dump's file size.
+     * @param progress Forwarded to build().
+     * @param built    Optional; receives the build() result, or all zeros
+     *                 when no index was built.
+     * @throw std::runtime_error as the constructor and build() do.
+     */
+    static std::unique_ptr<BreachIndex> openOrBuild(const std::string& path,
+                                                    bool bloom,
+                                                    const BuildProgress& progress = {},
+                                                    BuildStats* built = nullptr);
+
+    /// @brief Whether @p path starts with the index magic.
+    [[nodiscard]] static bool isIndexFile(const std::string& path);
+
+    /**
+     * @brief SHA-1 of @p data, the digest HIBP indexes passwords (UTF-8) by.
+     * @throw std::runtime_error if the digest fails.
+     */
+    static void sha1(std::span<const unsigned char> data, std::span<unsigned char, 20> out);
+
+private:
+    void* m_File = nullptr;                 ///< File handle.
+    void* m_Section = nullptr;              ///< File mapping handle.
+    const unsigned char* m_View = nullptr;  ///< Mapped file.
+    const uint64_t* m_Fanout = nullptr;     ///< 65537 bucket starts.
+    const uint64_t* m_Prefixes = nullptr;   ///< Sorted 8-byte hash prefixes.
+    const uint64_t* m_Bloom = nullptr;      ///< Bloom filter words; null without one.
+    uint64_t m_Count = 0;                   ///< Entries in m_Prefixes.
+    uint64_t m_BloomBits = 0;               ///< Bits in m_Bloom.
+    uint32_t m_BloomHashes = 0;             ///< Probes per lookup.
+};
+
+}  // namespace seal
@@ -8,6 +8,7 @@
 
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgproc.hpp>
+#include <opencv2/videoio/registry.hpp>
 
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -21,12 +22,17 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <cwctype>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 namespace
@@ -114,14 +120,36 @@ bool TryGetEnvIndex(const char* key, int& out)
     return false;
 }
 
+// One DirectShow video capture device. The device path is the
+// kernel-streaming symbolic link; it survives reboots and re-plugging into
+// the same port, unlike the OpenCV index, which shifts whenever another
+// camera appears. Software cameras often have no path.
+struct VideoDevice
+{
+    std::wstring name;
+    std::wstring path;
+};
+
+// Read a BSTR property from a moniker's property bag, or an empty string.
+std::wstring ReadBagString(IPropertyBag* bag, const wchar_t* property)
+{
+    std::wstring out;
+    VARIANT var;
+    VariantInit(&var);
+    if (SUCCEEDED(bag->Read(property, &var, 0)) && var.vt == VT_BSTR && var.bstrVal)
+        out = var.bstrVal;
+    VariantClear(&var);
+    return out;
+}
+
 // Walk DirectShow's COM device enumerator (CLSID_SystemDeviceEnum) to list
-// all video capture devices by their "FriendlyName" property.
-// Returns one name per device in enumeration order (index 0 = first device).
-// Empty strings are inserted for devices whose name cannot be read so that
-// indices stay aligned with OpenCV's integer camera indices.
-std::vector<std::wstring> EnumerateVideoDeviceNamesDShow()
+// all video capture devices by their "FriendlyName" and "DevicePath"
+// properties. Returns one entry per device in enumeration order (index 0 =
+// first device). Devices whose properties cannot be read get empty strings
+// so that indices stay aligned with OpenCV's integer camera indices.
+std::vector<VideoDevice> EnumerateVideoDevicesDShow()
 {
-    std::vector<std::wstring> names;
+    std::vector<VideoDevice> devices;
 
     // Try MTA first; if the thread is already STA (e.g. Qt event loop),
     // CoInitializeEx returns RPC_E_CHANGED_MODE - retry with STA to match.
@@ -154,22 +182,13 @@ std::vector<std::wstring> EnumerateVideoDeviceNamesDShow()
                 IPropertyBag* bag = nullptr;
                 if (SUCCEEDED(moniker->BindToStorage(0, 0, IID_IPropertyBag, (void**)&bag)) && bag)
                 {
-                    VARIANT varName;
-                    VariantInit(&varName);
-                    if (SUCCEEDED(bag->Read(L"FriendlyName", &varName, 0)) && varName.vt == VT_BSTR)
-                    {
-                        names.emplace_back(varName.bstrVal);
-                    }
-                    else
-                    {
-                        names.emplace_back(L"");
-                    }
-                    VariantClear(&varName);
+                    devices.push_back(
+                        {ReadBagString(bag, L"FriendlyName"), ReadBagString(bag, L"DevicePath")});
                     bag->Release();
                 }
                 else
                 {
-                    names.emplace_back(L"");
+                    devices.emplace_back();
                 }
                 moniker->Release();
             }
@@ -185,7 +204,167 @@ std::vector<std::wstring> EnumerateVideoDeviceNamesDShow()
         CoUninitialize();
     }
 
-    return names;
+    return devices;
+}
+
+// A device list younger than this is reused instead of enumerating again,
+// so a capture started right after CameraPrewarm::start() skips the enumeration.
+constexpr std::chrono::seconds kDeviceListTtl{30};
+
+std::mutex g_DeviceListMutex;
+std::vector<VideoDevice> g_DeviceList;
+std::chrono::steady_clock::time_point g_DeviceListAt;
+bool g_DeviceListValid = false;
+
+std::vector<VideoDevice> CurrentVideoDevices()
+{
+    std::lock_guard lock(g_DeviceListMutex);
+    const auto now = std::chrono::steady_clock::now();
+    if (!g_DeviceListValid || now - g_DeviceListAt > kDeviceListTtl)
+    {
+        g_DeviceList = EnumerateVideoDevicesDShow();
+        g_DeviceListAt = now;
+        g_DeviceListValid = true;
+    }
+    return g_DeviceList;
+}
+
+// Drop the cached device list, e.g. after a cached device failed to open.
+void InvalidateVideoDevices()
+{
+    std::lock_guard lock(g_DeviceListMutex);
+    g_DeviceListValid = false;
+}
+
+// The last camera that opened and streamed, persisted per user under
+// HKCU\Software\seal\Camera so the next capture can open it directly.
+constexpr const wchar_t* kCameraChoiceKey = L"Software\\seal\\Camera";
+
+struct CameraChoice
+{
+    std::wstring path;
+    std::wstring name;
+    int api = cv::CAP_ANY;
+};
+
+const char* BackendName(int api)
+{
+    switch (api)
+    {
+        case cv::CAP_DSHOW:
+            return "DSHOW";
+        case cv::CAP_MSMF:
+            return "MSMF";
+        default:
+            return "ANY";
+    }
+}
+
+std::wstring ReadChoiceString(HKEY key, const wchar_t* value)
+{
+    DWORD bytes = 0;
+    if (RegGetValueW(key, nullptr, value, RRF_RT_REG_SZ, nullptr, nullptr, &bytes) !=
+            ERROR_SUCCESS ||
+        bytes < sizeof(wchar_t))
+        return {};
+
+    std::wstring out(bytes / sizeof(wchar_t), L'\0');
+    if (RegGetValueW(key, nullptr, value, RRF_RT_REG_SZ, nullptr, out.data(), &bytes) !=
+        ERROR_SUCCESS)
+        return {};
+    out.resize(wcsnlen(out.c_str(), out.size()));
+    return out;
+}
+
+std::optional<CameraChoice> LoadCameraChoice()
+{
+    HKEY key = nullptr;
+    if (RegOpenKeyExW(HKEY_CURRENT_USER, kCameraChoiceKey, 0, KEY_READ, &key) != ERROR_SUCCESS)
+        return std::nullopt;
+
+    CameraChoice choice;
+    choice.path = ReadChoiceString(key, L"DevicePath");
+    choice.name = ReadChoiceString(key, L"FriendlyName");
+    DWORD api = 0;
+    DWORD apiBytes = sizeof(api);
+    const bool haveApi = RegGetValueW(key,
+                                      nullptr,
+                                      L"Backend",
+                                      RRF_RT_REG_DWORD,
+                                      nullptr,
+                                      &api,
+                                      &apiBytes) == ERROR_SUCCESS;
+    RegCloseKey(key);
+
+    if (!haveApi || (api != cv::CAP_DSHOW && api != cv::CAP_MSMF) ||
+        (choice.path.empty() && choice.name.empty()))
+        return std::nullopt;
+    choice.api = static_cast<int>(api);
+    return choice;
+}
+
+void SaveCameraChoice(const CameraChoice& choice)
+{
+    HKEY key = nullptr;
+    if (RegCreateKeyExW(HKEY_CURRENT_USER,
+                        kCameraChoiceKey,
+                        0,
+                        nullptr,
+                        0,
+                        KEY_SET_VALUE,
+                        nullptr,
+                        &key,
+                        nullptr) != ERROR_SUCCESS)
+        return;
+
+    auto setString = [key](const wchar_t* value, const std::wstring& text)
+    {
+        RegSetValueExW(key,
+                       value,
+                       0,
+                       REG_SZ,
+                       reinterpret_cast<const BYTE*>(text.c_str()),
+                       static_cast<DWORD>((text.size() + 1) * sizeof(wchar_t)));
+    };
+    setString(L"DevicePath", choice.path);
+    setString(L"FriendlyName", choice.name);
+    const DWORD api = static_cast<DWORD>(choice.api);
+    RegSetValueExW(
+        key, L"Backend", 0, REG_DWORD, reinterpret_cast<const BYTE*>(&api), sizeof(api));
+    RegCloseKey(key);
+}
+
+void ForgetCameraChoice()
+{
+    RegDeleteKeyW(HKEY_CURRENT_USER, kCameraChoiceKey);
+}
+
+// Current index of a remembered device: by device path, else by a friendly
+// name that matches exactly one device. -1 if it is not attached.
+int FindCameraChoice(const std::vector<VideoDevice>& devices, const CameraChoice& choice)
+{
+    if (!choice.path.empty())
+    {
+        for (size_t i = 0; i < devices.size(); ++i)
+        {
+            if (_wcsicmp(devices[i].path.c_str(), choice.path.c_str()) == 0)
+                return static_cast<int>(i);
+        }
+    }
+
+    int match = -1;
+    if (!choice.name.empty())
+    {
+        for (size_t i = 0; i < devices.size(); ++i)
+        {
+            if (devices[i].name != choice.name)
+                continue;
+            if (match >= 0)
+                return -1;  // Ambiguous: two identical cameras.
+            match = static_cast<int>(i);
+        }
+    }
+    return match;
 }
 
 // Pick the best camera index using a priority cascade:
@@ -543,7 +722,12 @@ int EnvIntOrDefault(const char* key, int defaultValue, int minValue, int maxValu
 // Enumerate, probe, score, and select the best available camera.
 bool PickBestCamera(cv::VideoCapture& cap, cv::Mat& frame)
 {
-    const auto names = EnumerateVideoDeviceNamesDShow();
+    const auto devices = CurrentVideoDevices();
+    std::vector<std::wstring> names;
+    names.reserve(devices.size());
+    for (const auto& device : devices)
+        names.push_back(device.name);
+
     const int preferredByName = names.empty() ? -1 : ChooseCameraIndexFromNames(names, true);
     const auto cameraPriority = BuildCameraPriorityList(names, preferredByName);
     const int preferredIndexHint = preferredByName >= 0
@@ -555,6 +739,38 @@ bool PickBestCamera(cv::VideoCapture& cap, cv::Mat& frame)
     const bool allowObsCamera = EnvFlagEnabled("SEAL_ALLOW_OBS_CAMERA");
     const bool quickCameraSelect = !EnvFlagEnabled("SEAL_DISABLE_CAMERA_QUICK_SELECT");
 
+    // Fast path: reopen the camera that worked last time without probing
+    // anything else. A forced index always wins over the remembered choice.
+    const std::optional<CameraChoice> remembered =
+        quickCameraSelect && !hasForcedIndex ? LoadCameraChoice() : std::nullopt;
+    if (remembered)
+    {
+        const int idx = FindCameraChoice(devices, *remembered);
+        const bool allowed = idx >= 0 && (allowVirtualFallback || !IsVirtualCameraName(names[idx]));
+        const char* backend = BackendName(remembered->api);
+        if (allowed && TryOpenCamera(cap, idx, remembered->api, backend, frame, true))
+        {
+            writeCameraDiag(seal::console::Tone::Success,
+                            {"event=camera.select.finish",
+                             "result=ok",
+                             "source=remembered",
+                             seal::diag::kv("index", idx),
+                             seal::diag::kv("backend", narrowToken(backend)),
+                             seal::diag::kv("width", frame.cols),
+                             seal::diag::kv("height", frame.rows)});
+            return true;
+        }
+
+        writeCameraDiag(seal::console::Tone::Warning,
+                        {"event=camera.select.remembered",
+                         "result=fail",
+                         idx < 0 ? "reason=not_attached"
+                                 : (allowed ? "reason=open_failed" : "reason=virtual_not_allowed"),
+                         nameMeta(remembered->name)});
+        ForgetCameraChoice();
+        InvalidateVideoDevices();
+    }
+
     struct BackendTry
     {
         int api;
@@ -738,6 +954,9 @@ bool PickBestCamera(cv::VideoCapture& cap, cv::Mat& frame)
         return false;
     }
 
+    if (chosen.knownByName)
+        SaveCameraChoice({devices[chosen.index].path, devices[chosen.index].name, chosen.api});
+
     writeCameraDiag(seal::console::Tone::Success,
                     {"event=camera.select.finish",
                      "result=ok",
@@ -750,4 +969,37 @@ bool PickBestCamera(cv::VideoCapture& cap, cv::Mat& frame)
     return true;
 }
 
+void CameraPrewarm::start()
+{
+    if (m_Running.exchange(true))
+        return;
+    // m_Running was clear, so a previous prewarm has already finished and
+    // this join does not wait.
+    stop();
+
+    m_Thread = std::jthread(
+        [this]
+        {
+            const auto started = std::chrono::steady_clock::now();
+            // Loading the videoio backend pulls in its DLLs (a plugin in
+            // some OpenCV builds); the device list warms DirectShow's COM
+            // enumerator and is reused by the next PickBestCamera().
+            const bool haveDshow = cv::videoio_registry::hasBackend(cv::CAP_DSHOW);
+            const size_t count = CurrentVideoDevices().size();
+            writeCameraDiag(seal::console::Tone::Debug,
+                            {"event=camera.prewarm.finish",
+                             "result=ok",
+                             seal::diag::kv("dshow", haveDshow),
+                             seal::diag::kv("count", count),
+                             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+            m_Running.store(false);
+        });
+}
+
+void CameraPrewarm::stop()
+{
+    if (m_Thread.joinable())
+        m_Thread.join();
+}
+
 }  // namespace seal
@@ -3,6 +3,9 @@
 #include <opencv2/core.hpp>
 #include <opencv2/videoio.hpp>
 
+#include <atomic>
+#include <thread>
+
 namespace seal
 {
 
@@ -17,9 +20,16 @@ namespace seal
  *
  * Priority cascade:
  *   1. `SEAL_CAMERA_INDEX` env var (user override)
- *   2. `SEAL_PREFERRED_CAMERA` keyword match
- *   3. First non-virtual camera (skips OBS, Camo, DroidCam, etc.)
- *   4. Fallback to index 0
+ *   2. The last camera that worked, opened directly without probing others
+ *   3. `SEAL_PREFERRED_CAMERA` keyword match
+ *   4. First non-virtual camera (skips OBS, Camo, DroidCam, etc.)
+ *   5. Fallback to index 0
+ *
+ * The winning device path, friendly name and backend are remembered under
+ * `HKCU\Software\seal\Camera`. A remembered device that is missing or
+ * fails to stream is forgotten and the full probe runs instead.
+ * `SEAL_DISABLE_CAMERA_QUICK_SELECT` bypasses the remembered choice along
+ * with the other quick-select shortcuts.
  *
  * @param[out] cap   OpenCV VideoCapture, opened on success.
  * @param[out] frame Probe frame from the selected camera.
@@ -27,6 +37,42 @@ namespace seal
  */
 bool PickBestCamera(cv::VideoCapture& cap, cv::Mat& frame);
 
+/**
+ * @class CameraPrewarm
+ * @brief Warms the capture stack on a background thread.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup QrCapture
+ *
+ * Loads the DirectShow videoio backend and enumerates devices so the next
+ * PickBestCamera() within 30 s reuses the list. Opens no camera, so the
+ * camera light stays off.
+ *
+ * The owner keeps the worker inside its own lifetime: stop() (or the
+ * destructor) waits for a running prewarm, so it never outlives the
+ * capture stack it touches. Not thread-safe; call from the owner's thread.
+ */
+class CameraPrewarm
+{
+public:
+    CameraPrewarm() = default;
+
+    /// @brief Destructor. Waits for a running prewarm.
+    ~CameraPrewarm() { stop(); }
+
+    CameraPrewarm(const CameraPrewarm&) = delete;
+    CameraPrewarm& operator=(const CameraPrewarm&) = delete;
+
+    /// @brief Start a prewarm and return immediately; ignored while one is running.
+    void start();
+
+    /// @brief Wait for a running prewarm to finish. Safe to call repeatedly.
+    void stop();
+
+private:
+    std::jthread m_Thread;               ///< The current or last prewarm.
+    std::atomic<bool> m_Running{false};  ///< Set while m_Thread is warming.
+};
+
 /**
  * @brief Read an integer from an environment variable with range clamping.
  * @param key          Environment variable name.
@@ -13,10 +13,16 @@
 #include <cstring>
 #include <span>
 #include <string>
+#include <string_view>
 
 namespace seal
 {
 
+static bool cancelRequested(const CliDispatchCallbacks& cb)
+{
+    return cb.cancel && cb.cancel->load(std::memory_order_relaxed);
+}
+
 void CliDispatchFile(const std::string& stripped, const CliDispatchCallbacks& cb)
 {
     std::string target = stripped;
@@ -61,11 +67,13 @@ void CliDispatchFile(const std::string& stripped, const CliDispatchCallbacks& cb
     }
 }
 
-void CliDispatchHexTokens(const std::string& input, const CliDispatchCallbacks& cb)
+void CliDispatchHexTokens(std::span<const std::string_view> tokens,
+                          const CliDispatchCallbacks& cb)
 {
-    auto hexTokens = seal::utils::extractHexTokens(input);
-    for (const auto& tok : hexTokens)
+    for (const auto tok : tokens)
     {
+        if (cancelRequested(cb))
+            return;
         try
         {
             auto plain = seal::FileOperations::decryptLine(tok, cb.password);
@@ -123,6 +131,9 @@ void CliDispatchDirectory(const std::string& dir, const CliDispatchCallbacks& cb
 
     do
     {
+        if (cancelRequested(cb))
+            break;
+
         const char* name = fd.cFileName;
         if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
             continue;
@@ -150,6 +161,13 @@ void CliDispatchDirectory(const std::string& dir, const CliDispatchCallbacks& cb
 
     FindClose(h);
 
+    if (cancelRequested(cb))
+    {
+        cb.output(QString("[dir] %1: stopped after %2 files")
+                      .arg(QString::fromStdString(dir))
+                      .arg(total));
+        return;
+    }
     cb.output(QString("[dir] %1: %2 files processed").arg(QString::fromStdString(dir)).arg(total));
 }
 
@@ -6,8 +6,11 @@
 
 #include <QtCore/QString>
 
+#include <atomic>
 #include <functional>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace seal
 {
@@ -25,16 +28,19 @@ struct CliDispatchCallbacks
 {
     std::function<void(const QString&)> output;    ///< Emit a line of CLI output.
     const basic_secure_string<wchar_t>& password;  ///< Borrowed ref to master password.
+    const std::atomic<bool>* cancel = nullptr;     ///< Stops multi-item dispatch between items.
 };
 
 /// @brief Dispatch a file path: encrypt or decrypt based on `.seal` extension.
 void CliDispatchFile(const std::string& stripped, const CliDispatchCallbacks& cb);
 
-/// @brief Recursively encrypt or decrypt all files in a directory.
+/// @brief Recursively encrypt or decrypt all files in a directory, stopping on `cb.cancel`.
 void CliDispatchDirectory(const std::string& dir, const CliDispatchCallbacks& cb);
 
-/// @brief Dispatch hex tokens: decrypt each and copy to clipboard.
-void CliDispatchHexTokens(const std::string& input, const CliDispatchCallbacks& cb);
+/// @brief Dispatch hex tokens (from utils::findHexTokens()): decrypt each and copy to clipboard.
+/// Stops before the next token once `cb.cancel` is set.
+void CliDispatchHexTokens(std::span<const std::string_view> tokens,
+                          const CliDispatchCallbacks& cb);
 
 /// @brief Try to dispatch base64 ciphertext: decrypt and copy to clipboard.
 /// @return `true` if handled, `false` if not valid base64 ciphertext.
@@ -3,8 +3,10 @@
 #include "CliHandler.h"
 #include "Clipboard.h"
 #include "Cryptography.h"
+#include "Metrics.h"
 #include "PasswordGen.h"
 #include "Utils.h"
+#include "WorkingSet.h"
 
 #include <QtCore/QString>
 #include <QtCore/QStringLiteral>
@@ -32,6 +34,8 @@ bool HandleCliBuiltin(const QString& command, const CliCallbacks& cb)
         cb.output(QStringLiteral("  :open :edit   Open seal input file in Notepad"));
         cb.output(QStringLiteral("  :copy :clip   Copy seal file to clipboard"));
         cb.output(QStringLiteral("  :clear :none  Clear clipboard"));
+        cb.output(QStringLiteral("  :stats        Show KDF, crypto and fill metrics"));
+        cb.output(QStringLiteral("  :cancel       Stop the running file/decrypt job"));
         cb.output(QStringLiteral("  :help         Show this help"));
         return true;
     }
@@ -60,6 +64,16 @@ bool HandleCliBuiltin(const QString& command, const CliCallbacks& cb)
         return true;
     }
 
+    if (command == ":stats")
+    {
+        const std::string report = seal::metrics::report(seal::metrics::snapshot()) +
+                                   seal::working_set::report(seal::working_set::stats());
+        const QString text = QString::fromStdString(report);
+        for (const QString& line : text.split(QLatin1Char('\n'), Qt::SkipEmptyParts))
+            cb.output(line);
+        return true;
+    }
+
     if (command == ":cls" || command == ":clear-screen")
     {
         cb.clearOutput();
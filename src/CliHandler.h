@@ -37,7 +37,7 @@ struct CliCallbacks
  * @ingroup CliHandler
  *
  * Handles: `:help`, `:open`, `:copy`, `:clear`, `:cls`, `:gen`, `:qr`,
- * `:fill`, `:hex`, `:unhex`.
+ * `:fill`, `:hex`, `:unhex`, `:stats`.
  *
  * @param command Trimmed command string.
  * @param cb      Callbacks for output and Backend interaction.
@@ -1,5 +1,6 @@
 #include "CliModes.h"
 
+#include "Agent.h"
 #include "Clipboard.h"
 #include "Console.h"
 #include "ConsoleStyle.h"
@@ -10,10 +11,15 @@
 #include "ScopedDpapiUnprotect.h"
 #include "Utils.h"
 
+#include <fcntl.h>
+#include <io.h>
+
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -24,13 +30,84 @@ void writeCliDiag(seal::console::Tone tone, std::initializer_list<std::string> f
 {
     seal::console::writeTagged(std::cerr, tone, "CLI", seal::diag::joinFields(fields));
 }
+
+// Text for -e/-d: the inline argument if given, otherwise all of stdin
+// with trailing newlines of piped or pasted input stripped.
+std::string readTextInput(const std::string& inlineData)
+{
+    std::string input = inlineData;
+    if (input.empty())
+    {
+        input.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+        while (!input.empty() && (input.back() == '\n' || input.back() == '\r'))
+            input.pop_back();
+    }
+    return input;
+}
+
+// Send one request to the running agent and return the payload of an `ok`
+// reply. A missing agent or a refused request is reported under `event`.
+std::optional<std::string> callAgent(std::string_view event,
+                                     seal::agent::Verb verb,
+                                     std::string_view payload = {})
+{
+    std::optional<seal::agent::Reply> reply;
+    try
+    {
+        reply = seal::agent::call(verb, payload);
+    }
+    catch (const std::exception& e)
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {seal::diag::kv("event", event),
+                      "result=fail",
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                      seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what()))});
+        return std::nullopt;
+    }
+    if (!reply)
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {seal::diag::kv("event", event),
+                      "result=fail",
+                      "reason=agent_not_running",
+                      "hint=start_it_with_seal_agent"});
+        return std::nullopt;
+    }
+    if (!reply->ok)
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {seal::diag::kv("event", event),
+                      "result=fail",
+                      seal::diag::kv("reason", seal::diag::sanitizeAscii(reply->payload))});
+        return std::nullopt;
+    }
+    return std::move(reply->payload);
+}
 }  // namespace
 
 namespace seal
 {
 
-int HandleGenMode(int length)
+int HandleGenMode(int length, size_t count)
 {
+    if (count > 1)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        auto batch = seal::GeneratePasswords(count, length);
+        std::cout.write(batch.text.data(), static_cast<std::streamsize>(batch.text.size()));
+        std::cout.flush();
+        writeCliDiag(seal::console::Tone::Success,
+                     {"event=cli.password.generate.finish",
+                      "result=ok",
+                      seal::diag::kv("length", batch.length),
+                      seal::diag::kv("count", batch.count),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      "copied=false"});
+        seal::Cryptography::cleanseString(batch.text);
+        return 0;
+    }
+
     auto password = seal::GeneratePassword(length);
 
     std::cout << password.view() << "\n";
@@ -48,6 +125,24 @@ int HandleGenMode(int length)
 
 int HandleShredMode(const std::string& path)
 {
+    if (seal::utils::isDirectoryA(path))
+    {
+        const auto started = std::chrono::steady_clock::now();
+        writeCliDiag(seal::console::Tone::Step,
+                     {"event=cli.shred.begin",
+                      "result=start",
+                      "target=directory",
+                      seal::diag::pathSummary(path)});
+        bool ok = seal::FileOperations::shredDirectory(path);
+        writeCliDiag(ok ? seal::console::Tone::Success : seal::console::Tone::Error,
+                     {"event=cli.shred.finish",
+                      ok ? "result=ok" : "result=fail",
+                      "target=directory",
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(path)});
+        return ok ? 0 : 1;
+    }
+
     if (!seal::utils::fileExistsA(path))
     {
         writeCliDiag(seal::console::Tone::Error,
@@ -82,8 +177,37 @@ int HandleShredMode(const std::string& path)
     return ok ? 0 : 1;
 }
 
-int HandleHashMode(const std::string& path)
+int HandleHashMode(const std::string& path, const std::string& manifestPath, bool blake2)
 {
+    const auto algo = blake2 ? seal::HashAlgorithm::Blake2b : seal::HashAlgorithm::Sha256;
+    if (seal::utils::isDirectoryA(path))
+    {
+        const auto started = std::chrono::steady_clock::now();
+        std::ofstream file;
+        if (!manifestPath.empty())
+        {
+            file.open(manifestPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                writeCliDiag(seal::console::Tone::Error,
+                             {"event=cli.hash.finish",
+                              "result=fail",
+                              "reason=cannot_open_output",
+                              seal::diag::pathSummary(manifestPath)});
+                return 1;
+            }
+        }
+        bool ok =
+            seal::FileOperations::hashDirectory(path, file.is_open() ? file : std::cout, algo);
+        writeCliDiag(ok ? seal::console::Tone::Success : seal::console::Tone::Error,
+                     {"event=cli.hash.finish",
+                      ok ? "result=ok" : "result=fail",
+                      "target=directory",
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(path)});
+        return ok ? 0 : 1;
+    }
+
     if (!seal::utils::fileExistsA(path))
     {
         writeCliDiag(seal::console::Tone::Error,
@@ -94,7 +218,7 @@ int HandleHashMode(const std::string& path)
         return 1;
     }
 
-    std::string hash = seal::FileOperations::hashFile(path);
+    std::string hash = seal::FileOperations::hashFile(path, algo);
     if (hash.empty())
     {
         writeCliDiag(seal::console::Tone::Error,
@@ -116,7 +240,8 @@ int HandleHashMode(const std::string& path)
 
 int HandleVerifyMode(const std::string& path)
 {
-    if (!seal::utils::fileExistsA(path))
+    const bool directory = seal::utils::isDirectoryA(path);
+    if (!directory && !seal::utils::fileExistsA(path))
     {
         writeCliDiag(seal::console::Tone::Error,
                      {"event=cli.verify.finish",
@@ -133,15 +258,26 @@ int HandleVerifyMode(const std::string& path)
         seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> dpapi(&password);
         ScopedUnprotect<decltype(dpapi)> dpapiScope(dpapi);
 
-        std::ifstream in(path, std::ios::binary);
-        std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)),
-                                        std::istreambuf_iterator<char>());
-        in.close();
+        if (directory)
+        {
+            // One `path: OK|FAILED` line per file on stdout, the summary on stderr.
+            const auto summary = seal::FileOperations::verifyDirectory(path, password, std::cout);
+            seal::Cryptography::cleanseString(password);
+            writeCliDiag(summary.ok() ? seal::console::Tone::Success : seal::console::Tone::Error,
+                         {"event=cli.verify.finish",
+                          summary.ok() ? "result=ok" : "result=fail",
+                          "target=directory",
+                          seal::diag::kv("passed", summary.passed),
+                          seal::diag::kv("failed", summary.failed),
+                          seal::diag::kv("listed", summary.listed),
+                          seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                          seal::diag::pathSummary(path)});
+            return summary.ok() ? 0 : 1;
+        }
 
-        // Verify the GCM tag without allocating a full plaintext buffer.
-        // verifyPacket processes ciphertext in 64 KB chunks, keeping peak
-        // memory at ~n (file blob) instead of ~2n (blob + plaintext).
-        seal::Cryptography::verifyPacket(std::span<const unsigned char>(blob), password);
+        // Streams the file through fixed buffers; peak memory does not
+        // depend on its size.
+        seal::FileOperations::verifyFile(path, password);
         seal::Cryptography::cleanseString(password);
 
         writeCliDiag(seal::console::Tone::Success,
@@ -164,6 +300,56 @@ int HandleVerifyMode(const std::string& path)
     }
 }
 
+int HandleCatMode(const std::string& path, uint64_t offset, uint64_t length)
+{
+    if (!seal::utils::fileExistsA(path))
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.cat.finish",
+                      "result=fail",
+                      "reason=file_not_found",
+                      seal::diag::pathSummary(path)});
+        return 1;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    try
+    {
+        seal::basic_secure_string<wchar_t> password = seal::readPasswordConsole();
+        seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> dpapi(&password);
+        ScopedUnprotect<decltype(dpapi)> dpapiScope(dpapi);
+
+        // The plaintext is arbitrary bytes: no newline translation.
+        std::cout.flush();
+        (void)_setmode(_fileno(stdout), _O_BINARY);
+        const uint64_t written =
+            seal::FileOperations::decryptRange(path, offset, length, std::cout, password);
+        std::cout.flush();
+        seal::Cryptography::cleanseString(password);
+
+        writeCliDiag(seal::console::Tone::Success,
+                     {"event=cli.cat.finish",
+                      "result=ok",
+                      seal::diag::kv("offset", offset),
+                      seal::diag::kv("bytes", written),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(path)});
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout.flush();
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.cat.finish",
+                      "result=fail",
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                      seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(path)});
+        return 1;
+    }
+}
+
 int HandleWipeMode()
 {
     (void)seal::Clipboard::copyWithTTL("");
@@ -173,7 +359,252 @@ int HandleWipeMode()
     return 0;
 }
 
-int HandleFileEncrypt(const std::string& inputPath, const std::string& outputPath)
+int HandleSyncMode(const std::string& srcDir, const std::string& mirrorDir)
+{
+    if (!seal::utils::isDirectoryA(srcDir))
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.sync.finish",
+                      "result=fail",
+                      "reason=directory_not_found",
+                      seal::diag::pathSummary(srcDir)});
+        return 1;
+    }
+
+    const std::string opId = seal::diag::nextOpId("cli_sync");
+    const auto started = std::chrono::steady_clock::now();
+    try
+    {
+        seal::basic_secure_string<wchar_t> password = seal::readPasswordConsole();
+        seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> dpapi(&password);
+        ScopedUnprotect<decltype(dpapi)> dpapiScope(dpapi);
+
+        writeCliDiag(seal::console::Tone::Step,
+                     {"event=cli.sync.begin",
+                      "result=start",
+                      seal::diag::kv("op", opId),
+                      seal::diag::pathSummary(srcDir, "src"),
+                      seal::diag::pathSummary(mirrorDir, "dst")});
+
+        bool ok = seal::FileOperations::syncDirectory(srcDir, mirrorDir, password);
+        seal::Cryptography::cleanseString(password);
+        writeCliDiag(ok ? seal::console::Tone::Success : seal::console::Tone::Error,
+                     {"event=cli.sync.finish",
+                      ok ? "result=ok" : "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(srcDir, "src"),
+                      seal::diag::pathSummary(mirrorDir, "dst")});
+        return ok ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.sync.finish",
+                      "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                      seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(srcDir)});
+        return 1;
+    }
+}
+
+int HandlePackMode(const std::string& dir, const std::string& archivePath)
+{
+    if (!seal::utils::isDirectoryA(dir))
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.pack.finish",
+                      "result=fail",
+                      "reason=directory_not_found",
+                      seal::diag::pathSummary(dir)});
+        return 1;
+    }
+
+    // Default archive: the directory name plus .seal, next to the directory.
+    std::string archive = archivePath;
+    if (archive.empty())
+    {
+        archive = dir;
+        while (archive.size() > 1 && (archive.back() == '\\' || archive.back() == '/'))
+            archive.pop_back();
+        archive += ".seal";
+    }
+
+    const std::string opId = seal::diag::nextOpId("cli_pack");
+    const auto started = std::chrono::steady_clock::now();
+    try
+    {
+        seal::basic_secure_string<wchar_t> password = seal::readPasswordConsole();
+        seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> dpapi(&password);
+        ScopedUnprotect<decltype(dpapi)> dpapiScope(dpapi);
+
+        writeCliDiag(seal::console::Tone::Step,
+                     {"event=cli.pack.begin",
+                      "result=start",
+                      seal::diag::kv("op", opId),
+                      seal::diag::pathSummary(dir, "src"),
+                      seal::diag::pathSummary(archive, "dst")});
+
+        bool ok = seal::FileOperations::packDirectory(dir, archive, password);
+        seal::Cryptography::cleanseString(password);
+        writeCliDiag(ok ? seal::console::Tone::Success : seal::console::Tone::Error,
+                     {"event=cli.pack.finish",
+                      ok ? "result=ok" : "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(dir, "src"),
+                      seal::diag::pathSummary(archive, "dst")});
+        return ok ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.pack.finish",
+                      "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                      seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(dir)});
+        return 1;
+    }
+}
+
+int HandleUnpackMode(const std::string& archivePath,
+                     const std::string& dstDir,
+                     const std::string& member,
+                     bool listOnly)
+{
+    if (!seal::utils::fileExistsA(archivePath))
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.unpack.finish",
+                      "result=fail",
+                      "reason=file_not_found",
+                      seal::diag::pathSummary(archivePath)});
+        return 1;
+    }
+
+    // Default root: the archive name without .seal, like decrypt.
+    std::string dst = dstDir;
+    if (dst.empty())
+    {
+        if (seal::utils::endsWithCi(archivePath, ".seal"))
+            dst = seal::utils::strip_ext_ci(archivePath, std::string_view{".seal"});
+        else
+            dst = archivePath + ".unpacked";
+    }
+
+    const std::string opId = seal::diag::nextOpId("cli_unpack");
+    const auto started = std::chrono::steady_clock::now();
+    try
+    {
+        seal::basic_secure_string<wchar_t> password = seal::readPasswordConsole();
+        seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> dpapi(&password);
+        ScopedUnprotect<decltype(dpapi)> dpapiScope(dpapi);
+
+        if (listOnly)
+        {
+            // Only the index is decrypted; no member is read.
+            const auto members = seal::FileOperations::listArchive(archivePath, password);
+            seal::Cryptography::cleanseString(password);
+            std::string listing;
+            for (const auto& m : members)
+                listing += std::to_string(m.size) + "  " + m.path + "\n";
+            std::cout << listing << std::flush;
+            writeCliDiag(seal::console::Tone::Success,
+                         {"event=cli.unpack.finish",
+                          "result=ok",
+                          "target=list",
+                          seal::diag::kv("op", opId),
+                          seal::diag::kv("members", members.size()),
+                          seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                          seal::diag::pathSummary(archivePath)});
+            return 0;
+        }
+
+        writeCliDiag(seal::console::Tone::Step,
+                     {"event=cli.unpack.begin",
+                      "result=start",
+                      seal::diag::kv("op", opId),
+                      seal::diag::pathSummary(archivePath, "src"),
+                      seal::diag::pathSummary(dst, "dst")});
+
+        bool ok = seal::FileOperations::unpackArchive(archivePath, dst, password, member);
+        seal::Cryptography::cleanseString(password);
+        writeCliDiag(ok ? seal::console::Tone::Success : seal::console::Tone::Error,
+                     {"event=cli.unpack.finish",
+                      ok ? "result=ok" : "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(archivePath, "src"),
+                      seal::diag::pathSummary(dst, "dst")});
+        return ok ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.unpack.finish",
+                      "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                      seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+                      seal::diag::pathSummary(archivePath)});
+        return 1;
+    }
+}
+
+int HandleKdfCalibrateMode(unsigned targetMs, unsigned memoryMiB)
+{
+    const uint64_t budget = uint64_t{memoryMiB} << 20;
+    std::vector<seal::KdfAlgorithm> algorithms{seal::KdfAlgorithm::Scrypt};
+    if (seal::Cryptography::argon2Available())
+        algorithms.push_back(seal::KdfAlgorithm::Argon2id);
+
+    std::string recommended;
+    for (auto algorithm : algorithms)
+    {
+        const char* name = algorithm == seal::KdfAlgorithm::Argon2id ? "argon2id" : "scrypt";
+        writeCliDiag(seal::console::Tone::Step,
+                     {"event=cli.kdf.calibrate.begin",
+                      "result=start",
+                      seal::diag::kv("algorithm", name),
+                      seal::diag::kv("target_ms", targetMs),
+                      seal::diag::kv("memory_mib", memoryMiB)});
+        try
+        {
+            const auto result = seal::Cryptography::calibrateKdf(algorithm, targetMs, budget);
+            const std::string spec = result.params.str();
+            std::cout << spec << "  " << static_cast<long long>(result.milliseconds + 0.5)
+                      << " ms, " << (result.params.memoryBytes() >> 20) << " MiB\n";
+            // Argon2id is preferred when present: its lanes run in parallel.
+            recommended = spec;
+        }
+        catch (const std::exception& e)
+        {
+            writeCliDiag(seal::console::Tone::Error,
+                         {"event=cli.kdf.calibrate.finish",
+                          "result=fail",
+                          seal::diag::kv("algorithm", name),
+                          seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                          seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what()))});
+            return 1;
+        }
+    }
+    std::cout << "\nTo use it, set SEAL_KDF=" << recommended << " (or pass --kdf "
+              << recommended << ").\n";
+    writeCliDiag(seal::console::Tone::Success,
+                 {"event=cli.kdf.calibrate.finish",
+                  "result=ok",
+                  seal::diag::kv("kdf", recommended)});
+    return 0;
+}
+
+int HandleFileEncrypt(const std::string& inputPath, const std::string& outputPath, unsigned threads)
 {
     if (!seal::utils::fileExistsA(inputPath))
     {
@@ -205,7 +636,7 @@ int HandleFileEncrypt(const std::string& inputPath, const std::string& outputPat
                       seal::diag::kv("op", opId),
                       seal::diag::pathSummary(inputPath)});
 
-        bool ok = seal::FileOperations::encryptFileTo(inputPath, dest, password);
+        bool ok = seal::FileOperations::encryptFileTo(inputPath, dest, password, threads);
         if (!ok)
         {
             writeCliDiag(seal::console::Tone::Error,
@@ -244,7 +675,7 @@ int HandleFileEncrypt(const std::string& inputPath, const std::string& outputPat
     }
 }
 
-int HandleFileDecrypt(const std::string& inputPath, const std::string& outputPath)
+int HandleFileDecrypt(const std::string& inputPath, const std::string& outputPath, unsigned threads)
 {
     if (!seal::utils::fileExistsA(inputPath))
     {
@@ -281,7 +712,7 @@ int HandleFileDecrypt(const std::string& inputPath, const std::string& outputPat
                       seal::diag::kv("op", opId),
                       seal::diag::pathSummary(inputPath)});
 
-        bool ok = seal::FileOperations::decryptFileTo(inputPath, dest, password);
+        bool ok = seal::FileOperations::decryptFileTo(inputPath, dest, password, threads);
         if (!ok)
         {
             writeCliDiag(seal::console::Tone::Error,
@@ -331,16 +762,7 @@ int HandleStringMode(bool encryptMode, const std::string& inlineData)
         seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> dpapi(&password);
         ScopedUnprotect<decltype(dpapi)> dpapiScope(dpapi);
 
-        // Get input: inline argument or stdin
-        std::string input = inlineData;
-        if (input.empty())
-        {
-            input.assign(std::istreambuf_iterator<char>(std::cin),
-                         std::istreambuf_iterator<char>());
-            // Strip trailing newline from piped/pasted input
-            while (!input.empty() && (input.back() == '\n' || input.back() == '\r'))
-                input.pop_back();
-        }
+        std::string input = readTextInput(inlineData);
 
         if (input.empty())
         {
@@ -436,4 +858,123 @@ int HandleStringMode(bool encryptMode, const std::string& inlineData)
     }
 }
 
+int HandleAgentMode(const std::string& vaultPath, unsigned ttlMinutes)
+{
+    const auto started = std::chrono::steady_clock::now();
+    try
+    {
+        seal::agent::Server server(seal::readPasswordConsole());
+        const size_t records = vaultPath.empty() ? 0 : server.loadVault(vaultPath);
+
+        writeCliDiag(seal::console::Tone::Step,
+                     {"event=cli.agent.begin",
+                      "result=start",
+                      seal::diag::kv("ttl_min", ttlMinutes),
+                      seal::diag::kv("record_count", records),
+                      vaultPath.empty() ? "vault=none" : seal::diag::pathSummary(vaultPath)});
+
+        const auto stop = server.serve(std::chrono::minutes(ttlMinutes));
+        writeCliDiag(seal::console::Tone::Success,
+                     {"event=cli.agent.finish",
+                      "result=ok",
+                      stop == seal::agent::Stop::Idle ? "reason=idle_timeout" : "reason=locked",
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.agent.finish",
+                      "result=fail",
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                      seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+        return 1;
+    }
+}
+
+int HandleAgentStringMode(bool encryptMode, const std::string& inlineData)
+{
+    std::string input = readTextInput(inlineData);
+    if (input.empty())
+    {
+        writeCliDiag(seal::console::Tone::Error,
+                     {"event=cli.text.finish", "result=fail", "via=agent", "reason=no_input"});
+        return 1;
+    }
+
+    if (encryptMode)
+    {
+        std::string b64 = seal::utils::toBase64(std::span<const unsigned char>(
+            reinterpret_cast<const unsigned char*>(input.data()), input.size()));
+        const auto hex = callAgent("cli.text.finish", seal::agent::Verb::Encrypt, b64);
+        seal::Cryptography::cleanseString(input, b64);
+        if (!hex)
+            return 1;
+
+        std::vector<unsigned char> raw;
+        (void)seal::utils::from_hex(std::string_view{*hex}, raw);
+        std::cout << "(hex) " << *hex << "\n";
+        std::cout << "(b64) " << seal::utils::toBase64(std::span<const unsigned char>(raw))
+                  << "\n";
+        writeCliDiag(seal::console::Tone::Success,
+                     {"event=cli.text.finish",
+                      "result=ok",
+                      "mode=encrypt",
+                      "via=agent",
+                      seal::diag::kv("hex_len", hex->size())});
+        return 0;
+    }
+
+    auto b64 = callAgent("cli.text.finish", seal::agent::Verb::Decrypt, input);
+    const size_t inputLen = input.size();
+    seal::Cryptography::cleanseString(input);
+    if (!b64)
+        return 1;
+    auto plain = seal::utils::fromBase64(*b64);
+    seal::Cryptography::cleanseString(*b64);
+    std::cout << std::string_view(reinterpret_cast<const char*>(plain.data()), plain.size())
+              << "\n";
+    seal::Cryptography::cleanseString(plain);
+    writeCliDiag(seal::console::Tone::Success,
+                 {"event=cli.text.finish",
+                  "result=ok",
+                  "mode=decrypt",
+                  "via=agent",
+                  seal::diag::kv("input_len", inputLen)});
+    return 0;
+}
+
+int HandleLookupMode(const std::string& platform)
+{
+    auto payload = callAgent("cli.lookup.finish", seal::agent::Verb::Lookup, platform);
+    if (!payload)
+        return 1;
+
+    // `<b64 username> <b64 password>`
+    const size_t space = payload->find(' ');
+    auto user = seal::utils::fromBase64(payload->substr(0, space));
+    auto pass = space == std::string::npos ? std::vector<unsigned char>{}
+                                           : seal::utils::fromBase64(payload->substr(space + 1));
+    seal::Cryptography::cleanseString(*payload);
+    std::cout << std::string_view(reinterpret_cast<const char*>(user.data()), user.size())
+              << "\n"
+              << std::string_view(reinterpret_cast<const char*>(pass.data()), pass.size())
+              << "\n";
+    seal::Cryptography::cleanseString(user, pass);
+    writeCliDiag(seal::console::Tone::Success,
+                 {"event=cli.lookup.finish",
+                  "result=ok",
+                  seal::diag::kv("platform_len", platform.size())});
+    return 0;
+}
+
+int HandleLockMode()
+{
+    if (!callAgent("cli.agent.lock", seal::agent::Verb::Lock))
+        return 1;
+    writeCliDiag(seal::console::Tone::Success, {"event=cli.agent.lock", "result=ok"});
+    return 0;
+}
+
 }  // namespace seal
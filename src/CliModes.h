@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace seal
@@ -7,39 +9,91 @@ namespace seal
 
 /// @brief Generate a random password of the given length and copy to clipboard.
 /// @param length Desired password length (clamped to 8..128).
+/// @param count  Passwords to generate; more than one prints them all, one per
+///               line, in a single write and leaves the clipboard alone.
 /// @return 0 on success.
-int HandleGenMode(int length);
+int HandleGenMode(int length, size_t count = 1);
 
-/// @brief Securely shred (overwrite + delete) a file.
-/// @param path Filesystem path to the file to shred.
-/// @return 0 on success, 1 if the file is not found or shredding fails.
+/// @brief Securely shred (overwrite + delete) a file, or a whole directory tree.
+/// @param path File to shred, or directory whose files are shredded in parallel.
+/// @return 0 on success, 1 if the path is not found or any file fails to shred.
 int HandleShredMode(const std::string& path);
 
-/// @brief Compute and print the SHA-256 hash of a file.
-/// @param path Filesystem path to the file to hash.
-/// @return 0 on success, 1 if the file is not found or hashing fails.
-int HandleHashMode(const std::string& path);
+/// @brief Compute and print the hash of a file, or a manifest for a directory.
+/// @param path         File to hash, or directory whose files are hashed in parallel.
+/// @param manifestPath Directory mode: write the manifest here instead of stdout.
+/// @param blake2       Use BLAKE2b-512 instead of SHA-256.
+/// @return 0 on success, 1 if the path is not found or any file fails to hash.
+int HandleHashMode(const std::string& path,
+                   const std::string& manifestPath = {},
+                   bool blake2 = false);
 
-/// @brief Verify a password against an encrypted file.
-/// @param path Filesystem path to the encrypted file.
-/// @return 0 if the password is correct, 1 on wrong password or error.
+/// @brief Verify a password against an encrypted file, or every `.seal` file in a directory.
+/// @param path Encrypted file, or directory whose `.seal` files are verified in parallel.
+/// @return 0 if every file verifies, 1 on wrong password or error.
 int HandleVerifyMode(const std::string& path);
 
+/// @brief Decrypt a byte range of an encrypted file to stdout.
+/// @param path   Encrypted file.
+/// @param offset First plaintext byte.
+/// @param length Bytes to print; clipped at the end of the plaintext.
+/// @return 0 on success, 1 on wrong password, damage or error.
+/// @see FileOperations::decryptRange
+int HandleCatMode(const std::string& path, uint64_t offset, uint64_t length);
+
 /// @brief Clear the clipboard and console buffer.
 /// @return 0 on success.
 int HandleWipeMode();
 
+/// @brief Incrementally mirror a directory into an encrypted copy.
+/// @param srcDir    Plaintext tree; left untouched.
+/// @param mirrorDir Encrypted mirror holding the `.seal` copies and the manifest.
+/// @return 0 if every new or changed file was sealed, 1 on any failure.
+/// @see FileOperations::syncDirectory
+int HandleSyncMode(const std::string& srcDir, const std::string& mirrorDir);
+
+/// @brief Pack a directory tree into one encrypted archive.
+/// @param dir         Plaintext tree; left untouched.
+/// @param archivePath Archive to write, replaced atomically (default: dir + ".seal").
+/// @return 0 if every file was packed, 1 on any failure.
+/// @see FileOperations::packDirectory
+int HandlePackMode(const std::string& dir, const std::string& archivePath);
+
+/// @brief List or extract the members of an archive written by HandlePackMode().
+/// @param archivePath Archive to read.
+/// @param dstDir      Extraction root (default: strip ".seal"; ignored with @p listOnly).
+/// @param member      Extract only this member path; empty extracts all.
+/// @param listOnly    Print `size  path` per member instead of extracting.
+/// @return 0 on success, 1 on wrong password, damage or any failed member.
+int HandleUnpackMode(const std::string& archivePath,
+                     const std::string& dstDir,
+                     const std::string& member = {},
+                     bool listOnly = false);
+
+/// @brief Measure KDF parameters for a target unlock time and print them.
+/// @param targetMs  Target time of one key derivation in milliseconds.
+/// @param memoryMiB Largest KDF working set to consider, in MiB.
+/// @return 0 on success, 1 if calibration fails.
+/// @see Cryptography::calibrateKdf
+int HandleKdfCalibrateMode(unsigned targetMs, unsigned memoryMiB);
+
 /// @brief Encrypt a file to a new destination.
 /// @param inputPath  Source file to encrypt.
 /// @param outputPath Destination path (default: inputPath + ".seal").
+/// @param threads    Worker threads for large files (0 = one per CPU).
 /// @return 0 on success, 1 on error.
-int HandleFileEncrypt(const std::string& inputPath, const std::string& outputPath);
+int HandleFileEncrypt(const std::string& inputPath,
+                      const std::string& outputPath,
+                      unsigned threads = 0);
 
 /// @brief Decrypt a file to a new destination.
 /// @param inputPath  Encrypted source file.
 /// @param outputPath Destination path (default: strip ".seal" extension).
+/// @param threads    Worker threads for large segmented files (0 = one per CPU).
 /// @return 0 on success, 1 on error.
-int HandleFileDecrypt(const std::string& inputPath, const std::string& outputPath);
+int HandleFileDecrypt(const std::string& inputPath,
+                      const std::string& outputPath,
+                      unsigned threads = 0);
 
 /// @brief Encrypt or decrypt a string with hex/base64 auto-detection.
 ///
@@ -53,4 +107,26 @@ int HandleFileDecrypt(const std::string& inputPath, const std::string& outputPat
 /// @return 0 on success, 1 on error.
 int HandleStringMode(bool encryptMode, const std::string& inlineData);
 
+/// @brief Unlock once and answer agent requests until locked or idle.
+/// @param vaultPath  Vault that `lookup` requests are answered from (empty = none).
+/// @param ttlMinutes Minutes without a request before the agent exits (0 = never).
+/// @return 0 once the agent stops, 1 on a wrong password or pipe error.
+/// @see agent::Server
+int HandleAgentMode(const std::string& vaultPath, unsigned ttlMinutes);
+
+/// @brief HandleStringMode() through the running agent: no prompt and no KDF.
+/// @param encryptMode `true` to encrypt plaintext, `false` to decrypt hex or base64.
+/// @param inlineData  Input string (if empty, reads from stdin).
+/// @return 0 on success, 1 if no agent is running or the request fails.
+int HandleAgentStringMode(bool encryptMode, const std::string& inlineData);
+
+/// @brief Print the username, then the password, of a vault platform held by the agent.
+/// @param platform Exact platform name.
+/// @return 0 on success, 1 if no agent is running or the platform is unknown.
+int HandleLookupMode(const std::string& platform);
+
+/// @brief Tell the running agent to wipe its keys and exit.
+/// @return 0 on success, 1 if no agent is running.
+int HandleLockMode();
+
 }  // namespace seal
@@ -4,11 +4,17 @@
 #include <shellapi.h>
 #include <tlhelp32.h>
 
+#include <algorithm>
 #include <atomic>
 #include <bit>
 #include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <cstring>
+#include <map>
 #include <mutex>
+#include <stop_token>
+#include <string_view>
 #include <thread>
 
 namespace
@@ -34,16 +40,146 @@ struct ClipboardLock
     ClipboardLock& operator=(const ClipboardLock&) = delete;
 };
 
-// Joinable TTL thread wrapped in unique_ptr. Clipboard::shutdown() explicitly
-// resets the pointer (which joins the thread) before main() returns.  This
-// avoids relying on static-destruction ordering where DLL unloading may have
-// already invalidated clipboard API entry points, causing a deadlock on join.
-std::unique_ptr<std::jthread> s_TtlThread;
+// Empty the clipboard if it still holds @p val. Runs on the TTL service
+// thread; a copy made by anyone since then is left alone.
+void scrubIfUnchanged(const seal::secure_string<>& val)
+{
+    // Open clipboard without emptying - we only want to read-compare.
+    // ClipboardLock intentionally skips EmptyClipboard (see its comment).
+    ClipboardLock lock;
+    if (!lock.ok)
+    {
+        return;
+    }
+
+    bool same = false;
+    HANDLE h = GetClipboardData(CF_UNICODETEXT);
+    wchar_t* w = h ? static_cast<wchar_t*>(GlobalLock(h)) : nullptr;
+    if (w)
+    {
+        // Round-trip current clipboard UTF-16 back to UTF-8 into locked
+        // memory so the comparison buffer is also non-pageable.
+        int need = WideCharToMultiByte(CP_UTF8, 0, w, -1, nullptr, 0, nullptr, nullptr);
+        seal::secure_string<> cur;
+        if (need > 0)
+        {
+            cur.s.resize(static_cast<size_t>(need), '\0');
+            int written =
+                WideCharToMultiByte(CP_UTF8, 0, w, -1, cur.s.data(), need, nullptr, nullptr);
+            if (written > 0 && !cur.empty() && cur.s.back() == '\0')
+            {
+                cur.s.pop_back();
+            }
+        }
+        GlobalUnlock(h);
+
+        // Constant-time compare to prevent a timing side-channel
+        // from leaking clipboard contents byte-by-byte.
+        same = seal::Cryptography::ctEqualAny(cur.s, val.s);
+    }
 
-// Serializes access to s_TtlThread. Without this, concurrent copyWithTTL
-// calls race on the jthread assignment (one thread may be mid-join while
-// another writes a new jthread value, causing undefined behavior).
-std::mutex s_TtlMutex;
+    // Only clear if nobody else has changed the clipboard
+    if (same)
+    {
+        EmptyClipboard();
+    }
+}
+
+// One long-lived thread that scrubs every copyWithTTL() value at its
+// deadline. Entries sit in a deadline-ordered queue; the thread sleeps on a
+// condition variable until the earliest deadline or until the queue
+// changes, so it wakes exactly at expiry and never polls. Scheduling only
+// takes the queue lock, so a burst of copies never waits on the thread.
+class TtlService
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Queue @p val for scrubbing at @p deadline. Every entry already queued
+    // is superseded - its value is no longer on the clipboard - and is
+    // wiped and dropped on the spot.
+    void schedule(seal::secure_string<> val, Clock::time_point deadline)
+    {
+        std::lock_guard lock(m_Mutex);
+        wipeLocked();
+        m_Pending.emplace(deadline, std::move(val));
+        ++m_Generation;
+        if (!m_Thread.joinable())
+            m_Thread = std::jthread([this](std::stop_token stop) { run(stop); });
+        m_Wake.notify_one();
+    }
+
+    // Stop and join the thread. Pending values are wiped without touching
+    // the clipboard. A later schedule() starts a fresh thread.
+    void shutdown()
+    {
+        std::jthread thread;
+        {
+            std::lock_guard lock(m_Mutex);
+            thread = std::move(m_Thread);
+        }
+        thread.request_stop();
+        if (thread.joinable())
+            thread.join();
+    }
+
+private:
+    void run(std::stop_token stop)
+    {
+        std::unique_lock lock(m_Mutex);
+        while (!stop.stop_requested())
+        {
+            if (m_Pending.empty())
+            {
+                m_Wake.wait(lock, stop, [this] { return !m_Pending.empty(); });
+                continue;
+            }
+
+            // Sleep until the earliest deadline, or until schedule() changes
+            // the queue.
+            const auto deadline = m_Pending.begin()->first;
+            if (Clock::now() < deadline)
+            {
+                const uint64_t generation = m_Generation;
+                m_Wake.wait_until(lock,
+                                  stop,
+                                  deadline,
+                                  [this, generation] { return m_Generation != generation; });
+                continue;
+            }
+
+            // Scrub outside the lock; the clipboard calls can block on
+            // another process holding it open.
+            auto node = m_Pending.extract(m_Pending.begin());
+            lock.unlock();
+            scrubIfUnchanged(node.mapped());
+            seal::Cryptography::cleanseString(node.mapped());
+            seal::Cryptography::trimWorkingSet();
+            lock.lock();
+        }
+        wipeLocked();
+    }
+
+    void wipeLocked()
+    {
+        for (auto& [deadline, val] : m_Pending)
+            seal::Cryptography::cleanseString(val);
+        m_Pending.clear();
+    }
+
+    std::mutex m_Mutex;
+    std::condition_variable_any m_Wake;
+    std::multimap<Clock::time_point, seal::secure_string<>> m_Pending;
+    uint64_t m_Generation = 0;  // Bumped by every schedule()
+
+    // Declared last so it is joined before the queue it reads is destroyed.
+    // Clipboard::shutdown() joins it before main() returns, which avoids
+    // relying on static-destruction ordering where DLL unloading may have
+    // already invalidated clipboard API entry points.
+    std::jthread m_Thread;
+};
+
+TtlService s_Ttl;
 
 }  // namespace
 
@@ -130,84 +266,8 @@ bool Clipboard::copyWithTTL(const char* data, size_t n, DWORD ttl_ms)
         return false;
     }
 
-    // Joinable TTL thread: Sleeps for the TTL in short increments (so it
-    // can respond to stop_requested during shutdown), then checks whether
-    // the clipboard still holds our value before clearing.
-    // The lock serializes concurrent copyWithTTL calls so the unique_ptr
-    // reset (which joins the previous thread) is not a data race.
-    std::lock_guard<std::mutex> ttlLock(s_TtlMutex);
-    s_TtlThread = std::make_unique<std::jthread>(
-        [val = std::move(val), ttl_ms](std::stop_token stop) mutable
-        {
-            // Sleep in 100ms increments so the thread can exit promptly
-            // when Clipboard::shutdown() or the jthread destructor requests stop.
-            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ttl_ms);
-            while (std::chrono::steady_clock::now() < deadline)
-            {
-                if (stop.stop_requested())
-                {
-                    seal::Cryptography::cleanseString(val);
-                    return;
-                }
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
-
-            // Check stop one more time before entering the clipboard API
-            // sequence. shutdown() may have been called while we were in the
-            // final sleep increment; this prevents entering blocking Win32
-            // clipboard calls after the process has started tearing down.
-            if (stop.stop_requested())
-            {
-                seal::Cryptography::cleanseString(val);
-                return;
-            }
-
-            // Open clipboard without emptying - we only want to read-compare.
-            // ClipboardLock intentionally skips EmptyClipboard (see its comment).
-            ClipboardLock lock;
-            if (!lock.ok)
-            {
-                seal::Cryptography::cleanseString(val);
-                seal::Cryptography::trimWorkingSet();
-                return;
-            }
-
-            bool same = false;
-            HANDLE h = GetClipboardData(CF_UNICODETEXT);
-            wchar_t* w = h ? static_cast<wchar_t*>(GlobalLock(h)) : nullptr;
-            if (w)
-            {
-                // Round-trip current clipboard UTF-16 back to UTF-8 into locked
-                // memory so the comparison buffer is also non-pageable.
-                int need = WideCharToMultiByte(CP_UTF8, 0, w, -1, nullptr, 0, nullptr, nullptr);
-                seal::secure_string<> cur;
-                if (need > 0)
-                {
-                    cur.s.resize(static_cast<size_t>(need), '\0');
-                    int written = WideCharToMultiByte(
-                        CP_UTF8, 0, w, -1, cur.s.data(), need, nullptr, nullptr);
-                    if (written > 0 && !cur.empty() && cur.s.back() == '\0')
-                    {
-                        cur.s.pop_back();
-                    }
-                }
-                GlobalUnlock(h);
-
-                // Constant-time compare to prevent a timing side-channel
-                // from leaking clipboard contents byte-by-byte.
-                same = seal::Cryptography::ctEqualAny(cur.s, val.s);
-            }
-
-            // Only clear if nobody else has changed the clipboard
-            if (same)
-            {
-                EmptyClipboard();
-            }
-
-            seal::Cryptography::cleanseString(val);
-            seal::Cryptography::trimWorkingSet();
-        });
-
+    s_Ttl.schedule(std::move(val),
+                   TtlService::Clock::now() + std::chrono::milliseconds(ttl_ms));
     return true;
 }
 
@@ -220,8 +280,7 @@ bool Clipboard::copyWithTTL(const char* s, DWORD ttl_ms)
 
 void Clipboard::shutdown()
 {
-    std::lock_guard<std::mutex> lock(s_TtlMutex);
-    s_TtlThread.reset();  // requests stop + joins + destroys
+    s_Ttl.shutdown();
 }
 
 bool Clipboard::copyInputFile()
@@ -361,7 +420,127 @@ static bool isKeyboardHookPresent()
     return false;
 }
 
-bool typeSecret(const wchar_t* bytes, int len, DWORD delay_ms)
+// Adaptive pacing sends key events in batches of this many characters
+// (two events each), doubling while the target keeps up.
+constexpr size_t TYPE_INITIAL_BATCH = 8;
+constexpr size_t TYPE_MAX_BATCH = 64;
+
+// A target that answers a queue probe within TYPE_FAST_MS is keeping up;
+// one slower than TYPE_SLOW_MS is falling behind. A target that does not
+// answer within TYPE_PROBE_TIMEOUT_MS is treated as hung.
+constexpr double TYPE_FAST_MS = 2.0;
+constexpr double TYPE_SLOW_MS = 16.0;
+constexpr DWORD TYPE_PROBE_TIMEOUT_MS = 250;
+
+// SEAL_TYPE_PACING=jittered opts every caller into the per-key fallback.
+static TypePacing resolvePacing(TypePacing pacing)
+{
+    if (pacing != TypePacing::Default)
+        return pacing;
+
+    static const TypePacing fromEnv = []
+    {
+        const char* raw = std::getenv("SEAL_TYPE_PACING");
+        return raw && std::string_view{raw} == "jittered" ? TypePacing::Jittered
+                                                          : TypePacing::Adaptive;
+    }();
+    return fromEnv;
+}
+
+// Round trip of a WM_NULL through the target thread, in milliseconds, or a
+// negative value if the thread did not answer in time. A sent message is
+// handled the next time the thread looks at its queue, so the round trip is
+// roughly how long the target spends on each input message it is working
+// through.
+static double queueProbeMs(HWND target)
+{
+    const long long before = perfCounter();
+    DWORD_PTR result = 0;
+    if (!SendMessageTimeoutW(target,
+                             WM_NULL,
+                             0,
+                             0,
+                             SMTO_ABORTIFHUNG | SMTO_BLOCK,
+                             TYPE_PROBE_TIMEOUT_MS,
+                             &result))
+        return -1.0;
+    return static_cast<double>(perfCounter() - before) * 1000.0 /
+           static_cast<double>(perfFrequency());
+}
+
+// Send one event at a time with a randomised inter-key delay (5 + tick % 8
+// = 5..12ms) after each down/up pair. The jitter prevents input-rate
+// limiters in web apps and remote desktops from dropping or reordering
+// keystrokes that arrive faster than their processing loop.
+static bool sendJittered(INPUT* events, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        SendInput(1, &events[i], sizeof(INPUT));
+        if ((i & 1) == 1)
+        {
+            Sleep(5 + (GetTickCount64() & 7));
+        }
+    }
+    return true;
+}
+
+// Send events in batched SendInput calls, probing the foreground thread
+// after each batch. The batch doubles while the target answers within
+// TYPE_FAST_MS and halves (with a pause of about one probe) when it slows
+// down, so an app that can take a whole password gets it in a few calls
+// and a busy one is never flooded. A hung or vanished target falls back to
+// jittered pacing for whatever is left.
+static bool sendAdaptive(INPUT* events, size_t count)
+{
+    const HWND target = GetForegroundWindow();
+    if (!target)
+        return sendJittered(events, count);
+
+    // Catch a target that is still starting up. This only ever waits once
+    // per process; later calls return immediately.
+    DWORD pid = 0;
+    GetWindowThreadProcessId(target, &pid);
+    if (HANDLE process = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid))
+    {
+        WaitForInputIdle(process, 50);
+        CloseHandle(process);
+    }
+
+    size_t batch = TYPE_INITIAL_BATCH;
+    size_t sent = 0;
+    while (sent < count)
+    {
+        const UINT n = static_cast<UINT>(std::min(batch * 2, count - sent));
+        const UINT inserted = SendInput(n, &events[sent], sizeof(INPUT));
+        if (inserted == 0)
+        {
+            // Blocked by UIPI (elevated target) or a desktop switch; the
+            // rest would be dropped just the same.
+            OutputDebugStringA("[seal] WARN: SendInput was blocked during auto-type\n");
+            return false;
+        }
+        sent += inserted;
+        if (sent >= count)
+            break;
+
+        const double probeMs = queueProbeMs(target);
+        if (probeMs < 0.0)
+            return sendJittered(&events[sent], count - sent);
+        if (probeMs <= TYPE_FAST_MS)
+        {
+            batch = std::min(batch * 2, TYPE_MAX_BATCH);
+        }
+        else if (probeMs >= TYPE_SLOW_MS)
+        {
+            batch = std::max<size_t>(batch / 2, 1);
+            Sleep(static_cast<DWORD>(std::min(probeMs, 50.0)));
+        }
+    }
+    return true;
+}
+
+bool typeSecret(const wchar_t* bytes, int len, DWORD delay_ms, TypePacing pacing)
 {
     if (!bytes)
     {
@@ -386,7 +565,8 @@ bool typeSecret(const wchar_t* bytes, int len, DWORD delay_ms)
         return false;
 
     // Give the user time to switch focus to the target window
-    Sleep(delay_ms);
+    if (delay_ms > 0)
+        Sleep(delay_ms);
 
     // Build key-down / key-up pairs for each UTF-16 code unit.
     // KEYEVENTF_UNICODE tells SendInput to use the scan-code field as a raw
@@ -405,24 +585,15 @@ bool typeSecret(const wchar_t* bytes, int len, DWORD delay_ms)
         seq.push_back(up);
     }
 
-    // Send one event at a time with a randomised inter-key delay (5 + tick % 8
-    // = 5..12ms) after each down/up pair. The jitter prevents input-rate
-    // limiters in web apps and remote desktops from dropping or reordering
-    // keystrokes that arrive faster than their processing loop.
-    for (size_t i = 0; i < seq.size(); ++i)
-    {
-        SendInput(1, &seq[i], sizeof(INPUT));
-        if ((i & 1) == 1)
-        {
-            Sleep(5 + (GetTickCount64() & 7));
-        }
-    }
+    const bool ok = resolvePacing(pacing) == TypePacing::Jittered
+                        ? sendJittered(seq.data(), seq.size())
+                        : sendAdaptive(seq.data(), seq.size());
 
     // Scrub sensitive keystroke data before returning. SecureZeroMemory is
     // not elided by the compiler (unlike memset), so the INPUT array is
     // guaranteed to be zeroed in physical memory.
     SecureZeroMemory(seq.data(), seq.size() * sizeof(INPUT));
-    return true;
+    return ok;
 }
 
 bool openInputInNotepad()
@@ -3,6 +3,7 @@
 #include "Cryptography.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace seal
@@ -42,14 +43,16 @@ namespace seal
  *     Compare -->|no| Skip["leave clipboard"]
  * ```
  *
- * copyWithTTL() copies data to the clipboard and then spawns a
- * joinable background thread (auto-joined on reassignment or
- * process exit) that sleeps for a configurable duration
- * (default 6 s). When the thread wakes it performs a
- * constant-time comparison (`Cryptography::ctEqualAny`) of the current
- * clipboard content against the original value and empties the
- * clipboard only if the content is unchanged - so a manual paste
- * by the user between apps is never clobbered.
+ * copyWithTTL() copies data to the clipboard and queues the value
+ * with a deadline (default 6 s) on a single long-lived service
+ * thread. The thread sleeps on a condition variable until the
+ * earliest deadline, so it wakes exactly at expiry, and a new copy
+ * supersedes the queued one without waiting on anything. At
+ * expiry it performs a constant-time comparison
+ * (`Cryptography::ctEqualAny`) of the current clipboard content
+ * against the original value and empties the clipboard only if the
+ * content is unchanged - so a manual paste by the user between apps
+ * is never clobbered.
  *
  * ## :material-file-lock: Input-File Helper
  *
@@ -84,21 +87,22 @@ public:
      * @brief Copy a byte buffer to the clipboard and auto-scrub after a timeout.
      *
      * Copies @p n bytes of UTF-8 data to the clipboard via setText, then
-     * spawns a joinable background thread (`std::jthread`, auto-joined on
-     * reassignment or process exit) that sleeps for @p ttl_ms milliseconds.
-     * When the thread wakes it re-opens the clipboard, performs a constant-time
-     * comparison of the current content against the original value, and
-     * empties the clipboard only if the content is unchanged. The original
-     * buffer is securely wiped regardless.
+     * queues the value on the clipboard service thread to expire in
+     * @p ttl_ms milliseconds; any value still queued from an earlier copy
+     * is superseded and wiped at once. At expiry the service re-opens the
+     * clipboard, performs a constant-time comparison of the current content
+     * against the original value, and empties the clipboard only if the
+     * content is unchanged. The original buffer is securely wiped regardless.
+     * Never blocks on the service thread.
      *
      * @param data   Pointer to the raw UTF-8 byte buffer.
      * @param n      Length of @p data in bytes.
      * @param ttl_ms Milliseconds before the clipboard is scrubbed (default 6000).
      * @return `true` if the initial clipboard set succeeded.
      *
-     * @post A background thread (joined at process exit) will clear the
+     * @post The service thread (joined by shutdown()) will clear the
      *       clipboard after @p ttl_ms if the content has not been replaced
-     *       by another application.
+     *       in the meantime.
      *
      * @see setText
      * @see Cryptography::ctEqualAny
@@ -168,24 +172,41 @@ public:
     [[nodiscard]] static bool copyInputFile();
 
     /**
-     * @brief Explicitly join the TTL scrub thread before static destruction.
+     * @brief Explicitly join the TTL service thread before static destruction.
      *
      * Call from `main()` (or an RAII guard on the stack of `main`) to ensure
-     * the background thread is joined while the process is still fully
+     * the service thread is joined while the process is still fully
      * initialized. Without this, the `jthread` destructor runs during
      * static destruction where DLL unloading may have already invalidated
-     * clipboard API entry points, causing a potential deadlock.
+     * clipboard API entry points, causing a potential deadlock. Values still
+     * queued are wiped without touching the clipboard.
      */
     static void shutdown();
 };
 
+/**
+ * @brief How typeSecret() paces the key events it injects.
+ */
+enum class TypePacing : uint8_t
+{
+    Default,   ///< `SEAL_TYPE_PACING=jittered` selects Jittered, otherwise Adaptive
+    Adaptive,  ///< Batched `SendInput` calls sized to how fast the target keeps up
+    Jittered   ///< One event at a time with a randomised 5-12 ms gap per key
+};
+
 /**
  * @brief Type a UTF-16 string into the active window using `SendInput`.
  *
  * Waits @p delay_ms milliseconds (to let the user switch focus), then
  * synthesizes `KEYEVENTF_UNICODE` key-down / key-up pairs for each wide
- * character. A small randomised inter-keystroke delay is added after each
- * pair to improve compatibility with input-rate-limited applications.
+ * character.
+ *
+ * Adaptive pacing sends the events in batched `SendInput` arrays. After
+ * each batch it times a `WM_NULL` round trip through the foreground
+ * window's thread. The batch grows while the target answers promptly and
+ * shrinks, with a short pause, when it lags. A target that stops
+ * answering gets the rest with jittered pacing, the per-key delays that
+ * input-rate-limited apps such as some remote desktops need.
  *
  * Both the `INPUT` sequence and the working copy of the string are securely
  * wiped with `SecureZeroMemory` before the function returns.
@@ -193,13 +214,19 @@ public:
  * @param bytes    UTF-16 string to type.
  * @param len      Number of wide characters, or `-1` for null-terminated.
  * @param delay_ms Delay in milliseconds before typing begins (default 4000).
- * @return `true` if the input was valid and keystrokes were dispatched
- *         (individual `SendInput` results are not verified).
+ * @param pacing   Injection pacing (default: adaptive unless overridden
+ *                 by `SEAL_TYPE_PACING`).
+ * @return `true` if the input was valid and keystrokes were dispatched;
+ *         `false` also when adaptive pacing finds `SendInput` blocked
+ *         (e.g. an elevated target).
  *
  * @pre The target window must have keyboard focus when typing begins.
  * @post All intermediate buffers are securely wiped.
  */
-[[nodiscard]] bool typeSecret(const wchar_t* bytes, int len, DWORD delay_ms = 4000);
+[[nodiscard]] bool typeSecret(const wchar_t* bytes,
+                              int len,
+                              DWORD delay_ms = 4000,
+                              TypePacing pacing = TypePacing::Default);
 
 /**
  * @brief Open the `seal` input file in Notepad.
@@ -0,0 +1,106 @@
+#include "Compression.h"
+
+#include <windows.h>
+
+#include <compressapi.h>
+
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "Cabinet.lib")
+#endif
+
+namespace seal::compression
+{
+
+namespace
+{
+
+// One compressor and one decompressor per thread, created on first use:
+// the file pipelines call in once per segment, and creating a handle
+// costs more than compressing a small segment.
+struct ThreadCodecs
+{
+    COMPRESSOR_HANDLE compressor = nullptr;
+    DECOMPRESSOR_HANDLE decompressor = nullptr;
+
+    ~ThreadCodecs()
+    {
+        if (compressor)
+            CloseCompressor(compressor);
+        if (decompressor)
+            CloseDecompressor(decompressor);
+    }
+};
+
+thread_local ThreadCodecs t_Codecs;
+
+COMPRESSOR_HANDLE threadCompressor()
+{
+    if (!t_Codecs.compressor &&
+        !CreateCompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, nullptr, &t_Codecs.compressor))
+        throw std::runtime_error("CreateCompressor failed");
+    return t_Codecs.compressor;
+}
+
+DECOMPRESSOR_HANDLE threadDecompressor()
+{
+    if (!t_Codecs.decompressor &&
+        !CreateDecompressor(COMPRESS_ALGORITHM_XPRESS_HUFF, nullptr, &t_Codecs.decompressor))
+        throw std::runtime_error("CreateDecompressor failed");
+    return t_Codecs.decompressor;
+}
+
+}  // namespace
+
+std::vector<unsigned char> compress(std::span<const unsigned char> data)
+{
+    std::vector<unsigned char> out;
+    if (data.empty())
+        return out;
+
+    // The first call only sizes the output: it fails with
+    // ERROR_INSUFFICIENT_BUFFER and reports the worst case.
+    COMPRESSOR_HANDLE h = threadCompressor();
+    SIZE_T size = 0;
+    BOOL ok = Compress(h, data.data(), data.size(), nullptr, 0, &size);
+    if (!ok && GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+    {
+        out.resize(size);
+        ok = Compress(h, data.data(), data.size(), out.data(), out.size(), &size);
+    }
+    if (!ok)
+        throw std::runtime_error("Compress failed");
+    out.resize(size);
+    return out;
+}
+
+size_t compressInto(std::span<const unsigned char> data, std::span<unsigned char> out)
+{
+    if (data.empty() || out.empty())
+        return 0;
+    SIZE_T size = 0;
+    if (Compress(threadCompressor(), data.data(), data.size(), out.data(), out.size(), &size))
+        return size;
+    if (GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+        return 0;
+    throw std::runtime_error("Compress failed");
+}
+
+void decompress(std::span<const unsigned char> packed, std::span<unsigned char> out)
+{
+    if (packed.empty())
+    {
+        if (!out.empty())
+            throw std::runtime_error("Compressed data too short");
+        return;
+    }
+
+    SIZE_T size = 0;
+    const BOOL ok = Decompress(
+        threadDecompressor(), packed.data(), packed.size(), out.data(), out.size(), &size);
+    if (!ok || size != out.size())
+        throw std::runtime_error("Corrupt compressed data");
+}
+
+}  // namespace seal::compression
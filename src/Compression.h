@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace seal
+{
+/**
+ * @namespace seal::compression
+ * @brief Lossless compression through the Windows Compression API.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup IO_FileOperations
+ *
+ * Uses XPRESS with Huffman coding (`COMPRESS_ALGORITHM_XPRESS_HUFF`),
+ * which ships with Windows 8 and later in `Cabinet.dll`, so no
+ * compression library has to be linked. It compresses at hundreds of
+ * MB/s per core and decompresses faster still: cheap enough to run in
+ * front of the cipher on every write.
+ *
+ * Compressed data does not record its own size for the caller; whoever
+ * stores it records the raw length next to it and hands that to
+ * decompress(), which refuses anything that does not expand to exactly
+ * that many bytes. Compress before encrypting, never after: ciphertext
+ * does not compress.
+ */
+namespace compression
+{
+
+/**
+ * @brief Compress @p data.
+ * @param data Raw bytes.
+ * @return Compressed bytes; empty for empty @p data.
+ * @throw std::runtime_error if the compressor fails.
+ */
+[[nodiscard]] std::vector<unsigned char> compress(std::span<const unsigned char> data);
+
+/**
+ * @brief Compress @p data into @p out if it fits.
+ *
+ * Allocation-free apart from the first call on a thread, which creates
+ * that thread's compressor. Sizing @p out below `data.size()` makes this
+ * the "does it compress?" test as well.
+ *
+ * @param data Raw bytes.
+ * @param out  Destination; its size is the largest acceptable result.
+ * @return Compressed length, or 0 if the result would not fit in @p out.
+ * @throw std::runtime_error if the compressor fails for any other reason.
+ */
+[[nodiscard]] size_t compressInto(std::span<const unsigned char> data,
+                                  std::span<unsigned char> out);
+
+/**
+ * @brief Decompress @p packed into @p out.
+ * @param packed Output of compress().
+ * @param out    Receives the raw bytes; its size is the recorded raw length.
+ * @throw std::runtime_error on corrupt input or a raw length other than `out.size()`.
+ */
+void decompress(std::span<const unsigned char> packed, std::span<unsigned char> out);
+
+}  // namespace compression
+}  // namespace seal
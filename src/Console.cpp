@@ -2,6 +2,8 @@
 
 #include <commdlg.h>
 
+#include <algorithm>
+
 namespace
 {
 
@@ -60,6 +62,23 @@ constexpr int kCtrlZ = 26;
 constexpr int kBackspace = 8;
 constexpr int kExtendedKey1 = 0;
 constexpr int kExtendedKey2 = 224;
+constexpr size_t kInputBatch = 4096;     // console input records drained per read
+constexpr size_t kBulkReserve = 1 << 16;  // initial BulkInput::text capacity
+
+// Make room for @p extra more characters in @p s without leaving a copy
+// of its contents behind: when the buffer has to grow, the old one is
+// wiped before it is freed. Growth doubles, as the library's would.
+template <class Str>
+void reserveWiped(Str& s, size_t extra)
+{
+    if (s.size() + extra <= s.capacity())
+        return;
+    Str bigger;
+    bigger.reserve(std::max(s.capacity() * 2, s.size() + extra));
+    bigger.assign(s);
+    SecureZeroMemory(s.data(), s.capacity() * sizeof(typename Str::value_type));
+    s.swap(bigger);
+}
 
 }  // namespace
 
@@ -67,18 +86,37 @@ namespace seal
 {
 
 // Shared console-setup logic used by both constructors.
-static void initConsoleLayout(HANDLE output, SHORT& width, int& showCount, size_t entryCount)
+void MaskedCredentialView::initLayout()
 {
     CONSOLE_SCREEN_BUFFER_INFO info{};
-    GetConsoleScreenBufferInfo(output, &info);
-    width = info.dwSize.X;
+    GetConsoleScreenBufferInfo(m_Output, &info);
+    m_Width = info.dwSize.X;
+    m_Attributes = info.wAttributes;
+    m_Remote = seal::Cryptography::isRemoteSession();
 
     SHORT winTop = info.srWindow.Top;
     SHORT winBot = info.srWindow.Bottom;
     SHORT winH = static_cast<SHORT>(winBot - winTop + 1);
 
     int maxItems = std::max<SHORT>(0, static_cast<SHORT>(winH - 2));
-    showCount = static_cast<int>(std::min<size_t>(static_cast<size_t>(maxItems), entryCount));
+    m_ShowCount = static_cast<int>(std::min<size_t>(static_cast<size_t>(maxItems), entryCount()));
+
+    // The view is anchored to the bottom of the window: header, entries, status.
+    m_Rows = static_cast<SHORT>(1 + m_ShowCount + 1);
+    m_OriginY = static_cast<SHORT>(winBot - m_Rows + 1);
+    if (m_OriginY < winTop)
+    {
+        m_OriginY = winTop;
+    }
+    m_StatusRow = static_cast<SHORT>(m_OriginY + m_Rows - 1);
+
+    // The front buffer starts out matching no real cell, so the first flush
+    // writes (and thereby clears) the whole area.
+    const size_t cells = static_cast<size_t>(m_Width) * static_cast<size_t>(m_Rows);
+    m_Back.assign(cells, CHAR_INFO{});
+    CHAR_INFO unknown{};
+    unknown.Attributes = 0xFFFF;
+    m_Front.assign(cells, unknown);
 }
 
 MaskedCredentialView::MaskedCredentialView(const std::vector<seal::secure_triplet16_t>& entries)
@@ -86,7 +124,7 @@ MaskedCredentialView::MaskedCredentialView(const std::vector<seal::secure_triple
       m_Output(GetStdHandle(STD_OUTPUT_HANDLE)),
       m_pEntries(&entries)
 {
-    initConsoleLayout(m_Output, m_Width, m_ShowCount, m_pEntries->size());
+    initLayout();
     render();
 }
 
@@ -98,73 +136,62 @@ MaskedCredentialView::MaskedCredentialView(std::vector<std::wstring> serviceName
       m_DecryptEntry(std::move(decryptEntry)),
       m_OnDemandMode(true)
 {
-    initConsoleLayout(m_Output, m_Width, m_ShowCount, m_ServiceNames.size());
+    initLayout();
     render();
 }
 
-void MaskedCredentialView::render()
+size_t MaskedCredentialView::entryCount() const
 {
-    CONSOLE_SCREEN_BUFFER_INFO info{};
-    GetConsoleScreenBufferInfo(m_Output, &info);
-
-    SHORT winTop = info.srWindow.Top;
-    SHORT winBot = info.srWindow.Bottom;
-    int needed = 1 + m_ShowCount + 1;
+    return m_OnDemandMode ? m_ServiceNames.size() : m_pEntries->size();
+}
 
-    SHORT startY = static_cast<SHORT>(winBot - needed + 1);
-    if (startY < winTop)
+std::wstring MaskedCredentialView::serviceName(size_t index) const
+{
+    if (m_OnDemandMode)
     {
-        startY = winTop;
+        return m_ServiceNames[index];
     }
+    const auto& entry = (*m_pEntries)[index];
+    return std::wstring(entry.primary.data(), entry.primary.size());
+}
 
-    // Clear the display area
-    std::string blank(static_cast<size_t>(m_Width), ' ');
-    for (SHORT r = startY; r < startY + needed && r <= winBot; ++r)
+void MaskedCredentialView::composeRow(SHORT row, std::wstring_view text)
+{
+    // Text past the right edge is clipped; the rest of the row is blanked.
+    CHAR_INFO* cells = m_Back.data() + static_cast<size_t>(row) * static_cast<size_t>(m_Width);
+    for (SHORT x = 0; x < m_Width; ++x)
     {
-        COORD c{0, r};
-        DWORD written = 0;
-        SetConsoleCursorPosition(m_Output, c);
-        WriteConsoleA(m_Output, blank.c_str(), static_cast<DWORD>(blank.size()), &written, nullptr);
+        const size_t i = static_cast<size_t>(x);
+        cells[i].Char.UnicodeChar = i < text.size() ? text[i] : L' ';
+        cells[i].Attributes = m_Attributes;
     }
+}
 
-    // Header line
-    SetConsoleCursorPosition(m_Output, {0, startY});
-    DWORD written;
-    WriteConsoleA(m_Output,
-                  "--- Decrypted entries (Click **** to copy; Enter/Esc to continue) ---",
-                  69,
-                  &written,
-                  nullptr);
-    SetConsoleCursorPosition(m_Output, {0, static_cast<SHORT>(startY + 1)});
+void MaskedCredentialView::render()
+{
+    composeRow(0, L"--- Decrypted entries (Click **** to copy; Enter/Esc to continue) ---");
 
     // Build hit regions: each row is "1) ServiceName:********:********"
     // The two "********" spans become clickable zones mapped to (username, password).
     // Console coordinates (column, row) are stored so handleClick can match mouse events.
+    // Only the rows inside the viewport are formatted.
     m_Regions.clear();
     m_Regions.reserve(static_cast<size_t>(m_ShowCount));
 
     for (int i = 0; i < m_ShowCount; ++i)
     {
-        GetConsoleScreenBufferInfo(m_Output, &info);
-        SHORT y = info.dwCursorPosition.Y;
+        const size_t index = m_Scroll + static_cast<size_t>(i);
+        const SHORT row = static_cast<SHORT>(1 + i);
+        const SHORT y = static_cast<SHORT>(m_OriginY + row);
 
-        std::wstring idx = std::to_wstring(i + 1) + L") ";
+        std::wstring idx = std::to_wstring(index + 1) + L") ";
         // Space needed for ":********:********"
         constexpr int MASKED_TAIL = 1 + MASKED_WIDTH + 1 + MASKED_WIDTH;
 
         int maxService = std::max<SHORT>(
             0, static_cast<SHORT>(m_Width - static_cast<int>(idx.size()) - MASKED_TAIL));
 
-        std::wstring svc;
-        if (m_OnDemandMode)
-        {
-            svc = m_ServiceNames[static_cast<size_t>(i)];
-        }
-        else
-        {
-            const auto& entry = (*m_pEntries)[static_cast<size_t>(i)];
-            svc.assign(entry.primary.data(), entry.primary.size());
-        }
+        std::wstring svc = serviceName(index);
 
         // Truncate long service names with ellipsis
         if (static_cast<int>(svc.size()) > maxService)
@@ -181,11 +208,7 @@ void MaskedCredentialView::render()
         }
 
         std::wstring prefix = idx + svc + L":";
-        std::wstring line = prefix + L"********:********";
-
-        SetConsoleCursorPosition(m_Output, {0, y});
-        WriteConsoleW(m_Output, line.c_str(), static_cast<DWORD>(line.size()), &written, nullptr);
-        SetConsoleCursorPosition(m_Output, {0, static_cast<SHORT>(y + 1)});
+        composeRow(row, prefix + L"********:********");
 
         // Map column ranges to the two masked fields on this row:
         //   [u0..u1] = first "********" (username)
@@ -194,71 +217,144 @@ void MaskedCredentialView::render()
         SHORT u1 = static_cast<SHORT>(u0 + MASKED_WIDTH - 1);
         SHORT p0 = static_cast<SHORT>(u1 + 2);  // +2 skips past the ':' separator
         SHORT p1 = static_cast<SHORT>(p0 + MASKED_WIDTH - 1);
-        m_Regions.push_back(HitRegion{y, u0, u1, p0, p1});
+        m_Regions.push_back(HitRegion{index, y, u0, u1, p0, p1});
     }
 
-    GetConsoleScreenBufferInfo(m_Output, &info);
-    m_StatusRow = info.dwCursorPosition.Y;
-
-    // Show overflow indicator if not all entries fit
-    size_t totalEntries = m_OnDemandMode ? m_ServiceNames.size() : m_pEntries->size();
+    // Show the visible range if not all entries fit
+    const size_t totalEntries = entryCount();
     if (static_cast<size_t>(m_ShowCount) < totalEntries)
     {
-        setStatus("[showing " + std::to_string(m_ShowCount) + " of " +
-                  std::to_string(totalEntries) + "]");
+        m_Status = L"[showing " + std::to_wstring(m_Scroll + 1) + L"-" +
+                   std::to_wstring(m_Scroll + static_cast<size_t>(m_ShowCount)) + L" of " +
+                   std::to_wstring(totalEntries) + L"; wheel/PgUp/PgDn to scroll]";
+    }
+    composeRow(static_cast<SHORT>(m_Rows - 1), m_Status);
+    flush();
+}
+
+void MaskedCredentialView::flush()
+{
+    // Diff the back buffer against the last frame, one changed span per row.
+    struct Span
+    {
+        SHORT row;
+        SHORT first;
+        SHORT last;
+    };
+    std::vector<Span> spans;
+    SMALL_RECT dirty{m_Width, m_Rows, -1, -1};
+
+    for (SHORT r = 0; r < m_Rows; ++r)
+    {
+        const size_t base = static_cast<size_t>(r) * static_cast<size_t>(m_Width);
+        SHORT first = -1;
+        SHORT last = -1;
+        for (SHORT x = 0; x < m_Width; ++x)
+        {
+            const CHAR_INFO& back = m_Back[base + static_cast<size_t>(x)];
+            const CHAR_INFO& front = m_Front[base + static_cast<size_t>(x)];
+            if (back.Char.UnicodeChar != front.Char.UnicodeChar ||
+                back.Attributes != front.Attributes)
+            {
+                if (first < 0)
+                {
+                    first = x;
+                }
+                last = x;
+            }
+        }
+        if (first < 0)
+        {
+            continue;
+        }
+        spans.push_back(Span{r, first, last});
+        dirty.Left = std::min(dirty.Left, first);
+        dirty.Right = std::max(dirty.Right, last);
+        dirty.Top = std::min(dirty.Top, r);
+        dirty.Bottom = std::max(dirty.Bottom, r);
+    }
+
+    if (spans.empty())
+    {
+        return;
+    }
+
+    const COORD size{m_Width, m_Rows};
+    auto write = [&](SHORT left, SHORT top, SHORT right, SHORT bottom)
+    {
+        SMALL_RECT region{left,
+                          static_cast<SHORT>(m_OriginY + top),
+                          right,
+                          static_cast<SHORT>(m_OriginY + bottom)};
+        WriteConsoleOutputW(m_Output, m_Back.data(), size, COORD{left, top}, &region);
+    };
+
+    // Locally a few narrow writes beat one wide one; over RDP, or when most
+    // of the view changed (scrolling), a single write of the dirty rectangle
+    // costs one round trip instead of one per row.
+    if (m_Remote || spans.size() > MAX_SPAN_WRITES)
+    {
+        write(dirty.Left, dirty.Top, dirty.Right, dirty.Bottom);
+    }
+    else
+    {
+        for (const Span& span : spans)
+        {
+            write(span.first, span.row, span.last, span.row);
+        }
+    }
+
+    for (const Span& span : spans)
+    {
+        const size_t base = static_cast<size_t>(span.row) * static_cast<size_t>(m_Width);
+        std::copy(m_Back.begin() + static_cast<ptrdiff_t>(base + span.first),
+                  m_Back.begin() + static_cast<ptrdiff_t>(base + span.last + 1),
+                  m_Front.begin() + static_cast<ptrdiff_t>(base + span.first));
     }
 }
 
+void MaskedCredentialView::scrollTo(size_t first)
+{
+    const size_t total = entryCount();
+    const size_t maxFirst = total - std::min(total, static_cast<size_t>(m_ShowCount));
+    first = std::min(first, maxFirst);
+    if (first == m_Scroll)
+    {
+        return;
+    }
+    m_Scroll = first;
+    render();
+}
+
 void MaskedCredentialView::setStatus(const std::string& msg)
 {
-    CONSOLE_SCREEN_BUFFER_INFO info{};
-    GetConsoleScreenBufferInfo(m_Output, &info);
-    std::string blank(static_cast<size_t>(info.dwSize.X), ' ');
-    COORD c{0, m_StatusRow};
-    DWORD written;
-    SetConsoleCursorPosition(m_Output, c);
-    WriteConsoleA(m_Output, blank.c_str(), static_cast<DWORD>(blank.size()), &written, nullptr);
-    SetConsoleCursorPosition(m_Output, c);
-    WriteConsoleA(m_Output, msg.c_str(), static_cast<DWORD>(msg.size()), &written, nullptr);
+    // Status messages are ASCII, so widening byte by byte is exact.
+    setStatusW(std::wstring(msg.begin(), msg.end()));
 }
 
 void MaskedCredentialView::setStatusW(const std::wstring& msg)
 {
-    CONSOLE_SCREEN_BUFFER_INFO info{};
-    GetConsoleScreenBufferInfo(m_Output, &info);
-    std::string blank(static_cast<size_t>(info.dwSize.X), ' ');
-    COORD c{0, m_StatusRow};
-    DWORD written;
-    SetConsoleCursorPosition(m_Output, c);
-    WriteConsoleA(m_Output, blank.c_str(), static_cast<DWORD>(blank.size()), &written, nullptr);
-    SetConsoleCursorPosition(m_Output, c);
-    WriteConsoleW(m_Output, msg.c_str(), static_cast<DWORD>(msg.size()), &written, nullptr);
+    m_Status = msg;
+    composeRow(static_cast<SHORT>(m_Rows - 1), m_Status);
+    flush();
 }
 
 void MaskedCredentialView::handleClick(SHORT x, SHORT y)
 {
-    for (size_t i = 0; i < m_Regions.size(); ++i)
+    for (const HitRegion& region : m_Regions)
     {
-        if (y != m_Regions[i].row)
+        if (y != region.row)
         {
             continue;
         }
+        const size_t i = region.index;
 
         // Resolve the service name for status display.
-        std::wstring svc;
-        if (m_OnDemandMode)
-        {
-            svc = m_ServiceNames[i];
-        }
-        else
-        {
-            const auto& entry = (*m_pEntries)[i];
-            svc.assign(entry.primary.data(), entry.primary.size());
-        }
+        std::wstring svc = serviceName(i);
 
         // Determine which field the user clicked.
-        bool isUsername = (x >= m_Regions[i].usernameStart && x <= m_Regions[i].usernameEnd);
-        bool isPassword = (x >= m_Regions[i].passwordStart && x <= m_Regions[i].passwordEnd);
+        bool isUsername = (x >= region.usernameStart && x <= region.usernameEnd);
+        bool isPassword = (x >= region.passwordStart && x <= region.passwordEnd);
         if (!isUsername && !isPassword)
             break;
 
@@ -333,6 +429,31 @@ void MaskedCredentialView::run()
             {
                 break;
             }
+
+            const size_t page = static_cast<size_t>(std::max(1, m_ShowCount));
+            switch (vk)
+            {
+                case VK_UP:
+                    scrollTo(m_Scroll - std::min<size_t>(m_Scroll, 1));
+                    break;
+                case VK_DOWN:
+                    scrollTo(m_Scroll + 1);
+                    break;
+                case VK_PRIOR:
+                    scrollTo(m_Scroll - std::min(m_Scroll, page));
+                    break;
+                case VK_NEXT:
+                    scrollTo(m_Scroll + page);
+                    break;
+                case VK_HOME:
+                    scrollTo(0);
+                    break;
+                case VK_END:
+                    scrollTo(entryCount());
+                    break;
+                default:
+                    break;
+            }
         }
 
         if (rec.EventType == MOUSE_EVENT)
@@ -342,6 +463,13 @@ void MaskedCredentialView::run()
             {
                 handleClick(m.dwMousePosition.X, m.dwMousePosition.Y);
             }
+            else if (m.dwEventFlags == MOUSE_WHEELED)
+            {
+                // The high word is the signed wheel delta; positive rolls away from the user.
+                const bool up = static_cast<SHORT>(HIWORD(m.dwButtonState)) > 0;
+                const size_t step = static_cast<size_t>(SCROLL_STEP);
+                scrollTo(up ? m_Scroll - std::min(m_Scroll, step) : m_Scroll + step);
+            }
         }
     }
 
@@ -387,15 +515,73 @@ std::pair<std::vector<std::string>, bool> readBulkLinesDualFrom(std::istream& in
     return {std::move(lines), uncensored};
 }
 
-// Returns: 1 = terminator found (break), 0 = line handled (continue)
-static int handleNewline(std::string& cur, std::vector<std::string>& lines, bool& uncensored)
+void BulkInput::cleanse()
+{
+    lines.clear();
+    if (!text.empty())
+        SecureZeroMemory(text.data(), text.capacity());
+    text.clear();
+    uncensored = false;
+}
+
+// Whitespace-trimmed view of @p line (the same set utils::trim strips).
+static std::string_view trimView(std::string_view line)
+{
+    constexpr std::string_view kSpace = " \t\r\n\f\v";
+    const size_t first = line.find_first_not_of(kSpace);
+    if (first == std::string_view::npos)
+        return {};
+    return line.substr(first, line.find_last_not_of(kSpace) - first + 1);
+}
+
+// Split the accepted lines out of @p in.text once reading is done, so no
+// later append can move the buffer under the views.
+static void finishBulkInput(BulkInput& in)
+{
+    in.lines.clear();
+    for (size_t begin = 0; begin < in.text.size();)
+    {
+        const size_t end = in.text.find('\n', begin);
+        in.lines.emplace_back(in.text.data() + begin, end - begin);
+        begin = end + 1;
+    }
+}
+
+void readBulkLinesDualFrom(std::istream& in, BulkInput& out)
+{
+    out.cleanse();
+    out.text.reserve(kBulkReserve);
+    std::string l;
+    while (std::getline(in, l))
+    {
+        const std::string_view t = trimView(l);
+        if (t == "?" || t == "!")
+        {
+            out.uncensored = (t == "!");
+            break;
+        }
+        if (!t.empty())
+        {
+            reserveWiped(out.text, l.size() + 1);
+            out.text.append(l);
+            out.text.push_back('\n');
+        }
+    }
+    seal::Cryptography::cleanseString(l);
+    finishBulkInput(out);
+}
+
+// Returns: 1 = terminator found (break), 0 = line handled (continue).
+// @p line is the finished line; it is appended to @p out unless it is a
+// terminator, a command or blank.
+static int handleNewline(std::string_view line, BulkInput& out)
 {
-    std::string t = seal::utils::trim(cur);
+    const std::string_view t = trimView(line);
 
     // Terminator: '?' for censored, '!' for uncensored output
     if (t == "?" || t == "!")
     {
-        uncensored = (t == "!");
+        out.uncensored = (t == "!");
         std::cout << "\n";
         return 1;
     }
@@ -405,7 +591,6 @@ static int handleNewline(std::string& cur, std::vector<std::string>& lines, bool
     {
         if (!seal::openInputInNotepad())
             std::cerr << "(failed to launch Notepad)\n";
-        cur.clear();
         std::cout << "\n";
         return 0;
     }
@@ -414,7 +599,6 @@ static int handleNewline(std::string& cur, std::vector<std::string>& lines, bool
     {
         bool ok = seal::Clipboard::copyInputFile();
         std::cout << (ok ? "(fence copied to clipboard)" : "(failed to copy fence)") << "\n";
-        cur.clear();
         return 0;
     }
 
@@ -422,73 +606,176 @@ static int handleNewline(std::string& cur, std::vector<std::string>& lines, bool
     {
         (void)seal::Clipboard::copyWithTTL("");
         std::cout << "(clipboard cleaned)\n";
-        cur.clear();
         return 0;
     }
 
     if (!t.empty())
     {
-        lines.push_back(cur);
+        reserveWiped(out.text, line.size() + 1);
+        out.text.append(line);
+        out.text.push_back('\n');
     }
-    cur.clear();
     std::cout << "\n";
     return 0;
 }
 
-bool readBulkLinesDualOrEsc(std::pair<std::vector<std::string>, bool>& out)
+bool readBulkLinesDualOrEsc(BulkInput& out)
 {
-    std::vector<std::string> lines;
-    std::string cur;
-    bool uncensored = false;
-
-    for (;;)
+    HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+    DWORD mode = 0;
+    if (!GetConsoleMode(input, &mode))
     {
-        int ch = _getch();
-
-        if (ch == kEscape)
-            return false;
-        if (ch == kCtrlC)
-            throw std::runtime_error("Interrupted");
-        if (ch == kCtrlZ)
-            throw std::runtime_error("EOF");
+        // Redirected: there is nothing to echo or edit, read it as a stream.
+        readBulkLinesDualFrom(std::cin, out);
+        return true;
+    }
 
-        if (ch == '\r' || ch == '\n')
+    // Raw key events, as _getch() sees them: Ctrl+C arrives as a character
+    // rather than a signal, and the console neither echoes nor line-buffers.
+    struct ModeGuard
+    {
+        HANDLE handle;
+        DWORD saved;
+        ~ModeGuard() { SetConsoleMode(handle, saved); }
+    } guard{input, mode};
+    constexpr DWORD kCooked = ENABLE_PROCESSED_INPUT | ENABLE_LINE_INPUT | ENABLE_ECHO_INPUT |
+                              ENABLE_MOUSE_INPUT | ENABLE_WINDOW_INPUT;
+    SetConsoleMode(input, mode & ~kCooked);
+
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    const UINT codepage = GetConsoleCP();
+    out.cleanse();
+    out.text.reserve(kBulkReserve);
+    std::vector<INPUT_RECORD> events(kInputBatch);
+    std::wstring line;  // current line as typed, UTF-16
+    std::wstring echo;  // pending echo for this batch of events
+    // The key events and the echo hold typed characters too; wipe them on
+    // every way out, Escape and exceptions included.
+    struct WipeGuard
+    {
+        std::vector<INPUT_RECORD>& events;
+        std::wstring& line;
+        std::wstring& echo;
+        ~WipeGuard()
         {
-            if (handleNewline(cur, lines, uncensored) == 1)
-                break;
-            continue;
+            SecureZeroMemory(events.data(), events.size() * sizeof(INPUT_RECORD));
+            SecureZeroMemory(line.data(), line.capacity() * sizeof(wchar_t));
+            SecureZeroMemory(echo.data(), echo.capacity() * sizeof(wchar_t));
         }
-
-        // Backspace
-        if (ch == kBackspace)
+    } wipe{events, line, echo};
+    auto wipeLine = [&]
+    {
+        // Capacity, not size: backspaced characters are still in the buffer.
+        SecureZeroMemory(line.data(), line.capacity() * sizeof(wchar_t));
+        line.clear();
+    };
+    auto flushEcho = [&]
+    {
+        if (echo.empty())
+            return;
+        std::cout.flush();
+        DWORD written = 0;
+        WriteConsoleW(output, echo.data(), static_cast<DWORD>(echo.size()), &written, nullptr);
+        echo.clear();
+    };
+    // Convert the finished line to the console codepage and dispatch it.
+    auto endLine = [&]() -> bool
+    {
+        flushEcho();
+        std::string converted;
+        if (!line.empty())
         {
-            if (!cur.empty())
+            const int wlen = static_cast<int>(line.size());
+            const int need =
+                WideCharToMultiByte(codepage, 0, line.data(), wlen, nullptr, 0, nullptr, nullptr);
+            if (need > 0)
             {
-                cur.pop_back();
-                std::cout << "\b \b" << std::flush;
+                converted.resize(static_cast<size_t>(need));
+                WideCharToMultiByte(
+                    codepage, 0, line.data(), wlen, converted.data(), need, nullptr, nullptr);
             }
-            continue;
         }
+        wipeLine();
+        const int r = handleNewline(converted, out);
+        seal::Cryptography::cleanseString(converted);
+        return r == 1;
+    };
 
-        // Skip extended key sequences (arrow keys, function keys, etc.)
-        if (ch == kExtendedKey1 || ch == kExtendedKey2)
+    try
+    {
+        for (;;)
         {
-            (void)_getch();
-            continue;
+            DWORD count = 0;
+            if (!ReadConsoleInputW(input, events.data(), static_cast<DWORD>(events.size()), &count))
+                throw std::runtime_error("EOF");
+            for (DWORD i = 0; i < count; ++i)
+            {
+                if (events[i].EventType != KEY_EVENT || !events[i].Event.KeyEvent.bKeyDown)
+                    continue;
+                const KEY_EVENT_RECORD& key = events[i].Event.KeyEvent;
+                const wchar_t ch = key.uChar.UnicodeChar;
+                const WORD repeat = std::max<WORD>(key.wRepeatCount, 1);
+
+                if (ch == kEscape || key.wVirtualKeyCode == VK_ESCAPE)
+                {
+                    flushEcho();
+                    wipeLine();
+                    out.cleanse();
+                    return false;
+                }
+                if (ch == kCtrlC)
+                    throw std::runtime_error("Interrupted");
+                if (ch == kCtrlZ)
+                    throw std::runtime_error("EOF");
+
+                if (ch == L'\r' || ch == L'\n')
+                {
+                    for (WORD r = 0; r < repeat; ++r)
+                    {
+                        if (endLine())
+                        {
+                            finishBulkInput(out);
+                            return true;
+                        }
+                    }
+                    continue;
+                }
+
+                // Backspace
+                if (ch == kBackspace)
+                {
+                    for (WORD r = 0; r < repeat && !line.empty(); ++r)
+                    {
+                        // Drop a whole surrogate pair at once.
+                        if (line.size() > 1 && IS_LOW_SURROGATE(line.back()))
+                            line.pop_back();
+                        line.pop_back();
+                        reserveWiped(echo, 3);
+                        echo.append(L"\b \b");
+                    }
+                    continue;
+                }
+
+                // Keys with no character (arrows, function keys, modifiers)
+                // and the remaining control characters (e.g. Ctrl+V = 0x16
+                // injected by some console hosts during paste) are dropped
+                // so they don't silently corrupt paths or other input.
+                if (ch < 32 || ch == 127)
+                    continue;
+
+                reserveWiped(line, repeat);
+                reserveWiped(echo, repeat);
+                line.append(repeat, ch);
+                echo.append(repeat, ch);
+            }
+            flushEcho();
         }
-
-        // Drop remaining control characters (e.g. Ctrl+V = 0x16 injected by
-        // some console hosts during paste) so they don't silently corrupt
-        // paths or other input.
-        if (ch < 32 || ch == 127)
-            continue;
-
-        cur.push_back(static_cast<char>(ch));
-        std::cout << static_cast<char>(ch) << std::flush;
     }
-
-    out = {std::move(lines), uncensored};
-    return true;
+    catch (...)
+    {
+        out.cleanse();
+        throw;
+    }
 }
 
 seal::basic_secure_string<wchar_t> readPasswordSecureDesktop(const wchar_t* caption,
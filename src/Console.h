@@ -10,6 +10,7 @@
 #include <functional>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace seal
@@ -39,7 +40,18 @@ namespace seal
  * On construction the console input mode is saved, and mouse input is
  * enabled for hit-testing. On destruction the original mode is restored
  * automatically (RAII). Layout adapts to the current console window
- * size; entries that exceed the visible area are clipped.
+ * size; entries that exceed the visible area scroll with the mouse wheel,
+ * the arrow keys, PgUp/PgDn and Home/End.
+ *
+ * ## :material-monitor-screenshot: Rendering
+ *
+ * Frames are composed into an off-screen `CHAR_INFO` back buffer that
+ * covers only the view's rows, and only the rows inside the viewport are
+ * formatted, so a 10k-entry list costs no more per frame than a short one.
+ * flush() diffs the back buffer against the last frame written and sends
+ * just the changed cells with `WriteConsoleOutputW`; a countdown tick
+ * rewrites one digit. In a remote session every frame goes out as a single
+ * write of the changed rectangle, since each console call is a round trip.
  */
 class MaskedCredentialView
 {
@@ -92,6 +104,7 @@ private:
     /// @brief Hit-test region for one masked credential row.
     struct HitRegion
     {
+        size_t index;         ///< Entry shown on this row
         SHORT row;            ///< Console row (Y coordinate)
         SHORT usernameStart;  ///< First column of the masked username field
         SHORT usernameEnd;    ///< Last column of the masked username field
@@ -101,11 +114,19 @@ private:
 
     static constexpr int COUNTDOWN_SEC = 3;
     static constexpr int MASKED_WIDTH = 8;
+    static constexpr int SCROLL_STEP = 3;         ///< Rows moved per wheel notch
+    static constexpr size_t MAX_SPAN_WRITES = 4;  ///< Dirty rows written one call each
 
+    void initLayout();
     void render();
+    void composeRow(SHORT row, std::wstring_view text);
+    void flush();
+    void scrollTo(size_t first);
     void setStatus(const std::string& msg);
     void setStatusW(const std::wstring& msg);
     void handleClick(SHORT x, SHORT y);
+    [[nodiscard]] size_t entryCount() const;
+    [[nodiscard]] std::wstring serviceName(size_t index) const;
 
     HANDLE m_Input;
     HANDLE m_Output;
@@ -115,6 +136,14 @@ private:
     DecryptOnDemand m_DecryptEntry;            ///< Click-time decryptor (on-demand mode only)
     bool m_OnDemandMode = false;               ///< True when using the on-demand decrypt path
     std::vector<HitRegion> m_Regions;
+    std::vector<CHAR_INFO> m_Back;   ///< Frame being composed, m_Rows x m_Width
+    std::vector<CHAR_INFO> m_Front;  ///< Frame last written to the console
+    std::wstring m_Status;           ///< Text of the status row
+    size_t m_Scroll = 0;             ///< Entry shown on the first list row
+    WORD m_Attributes = 0;           ///< Console text attributes for every cell
+    bool m_Remote = false;           ///< Coalesce writes for RDP sessions
+    SHORT m_OriginY = 0;             ///< Console row of the header line
+    SHORT m_Rows = 0;                ///< Header + visible entries + status
     SHORT m_StatusRow = 0;
     SHORT m_Width = 0;
     int m_ShowCount = 0;
@@ -160,10 +189,42 @@ void interactiveMaskedWin(std::vector<std::wstring> serviceNames,
  */
 std::pair<std::vector<std::string>, bool> readBulkLinesDualFrom(std::istream& in);
 
+/**
+ * @struct BulkInput
+ * @brief One batch of interactive input: every line in a single buffer.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup MaskedCredentialView
+ *
+ * A pasted batch can run to megabytes of hex. Keeping it in one buffer
+ * and handing out views means each byte is copied once on the way in and
+ * never again on the way to FileOperations::processBatch(). The views
+ * stay valid until the buffer is cleansed or reused.
+ */
+struct BulkInput
+{
+    std::string text;                     ///< Accepted lines, each followed by '\n'
+    std::vector<std::string_view> lines;  ///< One view into @c text per line
+    bool uncensored = false;              ///< Terminated with `!` rather than `?`
+
+    /// @brief Wipe @c text and drop the views.
+    void cleanse();
+};
+
+/**
+ * @brief Read non-empty lines from a stream into @p out until a terminator.
+ *
+ * Same rules as the pair-returning overload: `?` or `!` on its own line
+ * ends the batch, and blank lines are skipped.
+ *
+ * @param in  Input stream to read from.
+ * @param out Receives the lines (previous contents are cleansed first).
+ */
+void readBulkLinesDualFrom(std::istream& in, BulkInput& out);
+
 /**
  * @brief Read bulk lines from the console with Escape cancellation.
  *
- * Character-by-character console input reader that supports:
+ * Console input reader that supports:
  * - **Enter** to submit a line
  * - **Backspace** to delete the last character
  * - **Escape** to cancel (returns `false`)
@@ -173,6 +234,15 @@ std::pair<std::vector<std::string>, bool> readBulkLinesDualFrom(std::istream& in
  * - `:copy` / `:clip` to copy the seal file to the clipboard
  * - `:clear` / `:none` to empty the clipboard
  *
+ * Input is drained with `ReadConsoleInputW` in batches of key events, and
+ * the echo is coalesced into one `WriteConsoleW` per line (or per batch,
+ * within a long line), so a multi-megabyte paste costs a few console calls
+ * per line rather than two per character. Characters are stored in the
+ * console input codepage, as `_getch()` delivered them. When standard
+ * input is redirected, the batch is read from it as a stream instead.
+ * Every buffer that held typed characters is wiped before it is freed,
+ * including the ones outgrown along the way.
+ *
  * @param[out] out Receives the collected lines and uncensored flag on success.
  * @return `true` if input was completed normally, `false` if cancelled via
  *         Escape.
@@ -181,7 +251,7 @@ std::pair<std::vector<std::string>, bool> readBulkLinesDualFrom(std::istream& in
  *
  * @see readBulkLinesDualFrom
  */
-bool readBulkLinesDualOrEsc(std::pair<std::vector<std::string>, bool>& out);
+bool readBulkLinesDualOrEsc(BulkInput& out);
 
 /**
  * @brief Prompt for a password using the Windows Credentials UI.
@@ -8,6 +8,11 @@
 #error "Platform not supported: This source targets Windows APIs."
 #endif
 
+#ifndef SEAL_LOCKED_SLAB
+#define SEAL_LOCKED_SLAB 1  // CMake's ENABLE_LOCKED_SLAB=OFF sets 0
+#endif
+
+#include <bit>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
@@ -26,7 +31,40 @@ namespace seal
  * $[\text{AAD}_{4} \mid \text{Salt}_{16} \mid \text{IV}_{12} \mid \text{CT}_{n} \mid
  * \text{Tag}_{16}]$ where $n = |\text{plaintext}|$.
  *
+ * Segmented (STREAM) wire format for large files:
+ * $[\text{Magic}_{4} \mid \text{Salt}_{16} \mid \text{Prefix}_{7} \mid \text{Log2}_{1}]$
+ * followed by segments of $2^{\text{Log2}}$ plaintext bytes, each sealed with
+ * its own tag; only the last segment may be shorter. The keyed variant
+ * (directory batches) appends a $\text{FileNonce}_{16}$ to the header and
+ * seals under $\text{HKDF}(\text{scrypt}(\text{Salt}), \text{FileNonce})$, so
+ * every file of a batch can share one scrypt run.
+ *
+ * Setting cfg::SEGMENT_COMPRESSED in the Log2 byte marks a compressed
+ * segmented file. Each segment is then compressed before sealing unless
+ * that does not pay, so segments vary in length; they are never final.
+ * The file ends in a segment table sealed as the final segment,
+ * $[\text{PlainSize}_{8} \mid \text{Entry}_{4} \cdot n]$ with one stored
+ * length per segment, and a $\text{TableLen}_{8}$ trailer. Readers that
+ * predate the flag reject the Log2 byte instead of misreading the file.
+ *
+ * The two bits under it (cfg::SEGMENT_AEAD_MASK) name the AEAD the
+ * segments are sealed with: 0 is AES-256-GCM, as every file before the
+ * field had, and 1 is ChaCha20-Poly1305 (RFC 8439). Both take the same
+ * 12-byte nonce and 16-byte tag, so nothing else in the layout moves.
+ *
+ * Archives (`seal pack`) are
+ * $[\text{"sla1"}_{4} \mid \text{Salt}_{16} \mid \text{Kdf}_{4}]$, one keyed
+ * segmented packet per member under that salt, the encrypted index and a
+ * $[\text{IndexLen}_{8} \mid \text{"sla1"}_{4}]$ trailer.
+ *
  * scrypt memory usage: $M = 128 \cdot r \cdot N = 128 \cdot 8 \cdot 2^{16} = 64\text{ MiB}$.
+ *
+ * Those scrypt parameters are the built-in default (KdfParams::legacy()).
+ * Anything written with other parameters records them (KdfParams::encode())
+ * next to its salt: packets start with $[\text{"slp2"}_{4} \mid
+ * \text{Kdf}_{4}]$ as their AAD, segmented headers use the magics "sls2" /
+ * "slk2" and end in $\text{Kdf}_{4}$, and vault headers (format 4) follow
+ * the salt with it. Default-parameter output keeps the original formats.
  */
 namespace cfg
 {
@@ -38,12 +76,89 @@ static constexpr size_t FILE_CHUNK = 1 << 20;  ///< Read-buffer chunk size (1 Mi
 static constexpr char AAD_HDR[] = "seal";      ///< Additional authenticated data header
 static constexpr size_t AAD_LEN =
     sizeof(AAD_HDR) - 1;  ///< AAD header length excluding null terminator.
+static constexpr char SEGMENT_HDR[] = "sls1";  ///< Segmented-format magic
+static constexpr size_t SEGMENT_HDR_LEN =
+    sizeof(SEGMENT_HDR) - 1;                  ///< Segmented magic length excluding null terminator.
+static constexpr size_t SEGMENT_PREFIX_LEN = 7;  ///< Per-file random nonce prefix length.
+static constexpr size_t SEGMENT_HEADER_LEN =
+    SEGMENT_HDR_LEN + SALT_LEN + SEGMENT_PREFIX_LEN + 1;  ///< Full segmented header length.
+static constexpr size_t SEGMENT_LEN = FILE_CHUNK;  ///< Plaintext bytes per segment when writing.
+static constexpr char SEGMENT_KEYED_HDR[] = "slk1";  ///< Keyed segmented-format magic
+static constexpr size_t SEGMENT_FILE_NONCE_LEN = 16;  ///< Per-file HKDF nonce length.
+static constexpr size_t SEGMENT_KEYED_HEADER_LEN =
+    SEGMENT_HEADER_LEN + SEGMENT_FILE_NONCE_LEN;  ///< Full keyed segmented header length.
+static constexpr char MANIFEST_HDR[] = "slm1";  ///< Directory-manifest magic
+static constexpr size_t MANIFEST_HDR_LEN =
+    sizeof(MANIFEST_HDR) - 1;  ///< Manifest magic length excluding null terminator.
+static constexpr uint64_t HASH_MAP_MIN = 1 << 20;  ///< Files this large are hashed via mapping.
+static constexpr size_t HASH_MAP_VIEW = 64 << 20;  ///< Bytes mapped per view when hashing.
+static constexpr size_t SHRED_CHUNK = 1 << 20;  ///< Bytes per unbuffered shred write.
+static constexpr size_t SHRED_DEPTH = 4;  ///< Shred writes in flight per file.
+static constexpr size_t SHRED_SSD_LANES = 4;  ///< Files shredded at once per flash volume.
+static constexpr size_t LOCKED_POOL_MAX_REGIONS = 32;  ///< Released regions kept per thread.
+static constexpr size_t LOCKED_POOL_MAX_BYTES =
+    16 << 20;  ///< Committed bytes kept per thread (16 MiB, one pipeline's segment buffers).
+static constexpr bool LOCKED_SLAB =
+    SEAL_LOCKED_SLAB != 0;  ///< Pack small locked allocations into shared slab arenas.
+static constexpr size_t LOCKED_SLAB_MIN_SLOT = 64;   ///< Smallest slab slot, header included.
+static constexpr size_t LOCKED_SLAB_MAX_SLOT =
+    512;  ///< Largest slab slot; bigger requests get their own pages.
+static constexpr size_t LOCKED_SLAB_CANARY_BYTES = 16;  ///< Canary bytes after a slab payload.
+static constexpr size_t LOCKED_SLAB_ARENA = 64 << 10;  ///< Committed bytes per slab arena.
+static constexpr size_t WORKING_SET_RECORD_BYTES =
+    1024;  ///< Locked bytes budgeted per vault record (three decrypted fields in slab slots).
+static constexpr size_t WORKING_SET_BASE =
+    LOCKED_POOL_MAX_BYTES + (4 << 20);  ///< Locked bytes budgeted regardless of vault size.
+static constexpr unsigned PREFETCH_TTL_MS =
+    8000;  ///< Lifetime of a credential decrypted on row selection (covers the 3 s countdown).
+static constexpr unsigned QUICK_UNLOCK_MINUTES =
+    240;  ///< Default lifetime of the secrets parked by lockVault() for quick unlock.
+static constexpr unsigned QUICK_UNLOCK_MAX_MINUTES =
+    1440;  ///< Upper bound on the configured quick-unlock lifetime (one day).
+static constexpr unsigned FILE_WATCH_DEBOUNCE_MS =
+    750;  ///< Quiet time after the last change to a watched vault before it is reloaded.
+static constexpr unsigned BREACH_BLOOM_BITS_PER_ENTRY =
+    10;  ///< Bloom filter bits per breached hash (about 1% false positives with 7 probes).
+static constexpr unsigned BREACH_BLOOM_HASHES = 7;  ///< Bloom filter probes per lookup.
 static constexpr uint64_t SCRYPT_N =
     1ULL << 16;                          ///< scrypt CPU/memory cost parameter ($2^{16} = 65536$).
 static constexpr uint64_t SCRYPT_R = 8;  ///< scrypt block size parameter.
 static constexpr uint64_t SCRYPT_P = 1;  ///< scrypt parallelisation parameter.
 static constexpr uint64_t SCRYPT_MAXMEM =
     128ULL * 1024 * 1024;  ///< scrypt maximum memory allowance (128 MiB, ~2x working set).
+static constexpr size_t KDF_PARAMS_LEN = 4;  ///< Encoded KdfParams length in bytes.
+static constexpr size_t KDF_SALT_LEN =
+    SALT_LEN + KDF_PARAMS_LEN;  ///< Salt followed by its KDF parameters (vault key ids).
+static constexpr uint64_t KDF_MAX_MEMORY =
+    1ULL << 30;  ///< Largest KDF working set a header may ask for (1 GiB).
+static constexpr unsigned KDF_MAX_LANES = 16;  ///< Largest scrypt p / Argon2id lane count.
+static constexpr char PACKET_KDF_HDR[] = "slp2";  ///< Magic of packets with stored KDF parameters
+static constexpr size_t PACKET_KDF_AAD_LEN =
+    sizeof(PACKET_KDF_HDR) - 1 + KDF_PARAMS_LEN;  ///< AAD of such packets: magic | params.
+static constexpr char SEGMENT_KDF_HDR[] = "sls2";  ///< Segmented magic with stored KDF parameters
+static constexpr char SEGMENT_KEYED_KDF_HDR[] =
+    "slk2";  ///< Keyed segmented magic with stored KDF parameters
+static constexpr unsigned char SEGMENT_COMPRESSED =
+    0x80;  ///< Log2-byte flag of a compressed segmented file.
+static constexpr unsigned char SEGMENT_AEAD_MASK =
+    0x60;  ///< Log2-byte bits holding the segments' AeadAlgorithm.
+static constexpr unsigned SEGMENT_AEAD_SHIFT = 5;  ///< Shift of those bits.
+static constexpr uint32_t SEGMENT_ENTRY_COMPRESSED =
+    0x80000000u;  ///< Segment-table flag: this segment holds compressed bytes.
+static constexpr size_t SEGMENT_TABLE_TRAILER_LEN =
+    8;  ///< Compressed segmented trailer: sealed table length.
+static constexpr size_t SEGMENT_MIN_SAVING =
+    16;  ///< A segment is stored compressed only if that saves 1/16 of it.
+static constexpr char ARCHIVE_HDR[] = "sla1";  ///< Archive-container magic
+static constexpr size_t ARCHIVE_HDR_LEN =
+    sizeof(ARCHIVE_HDR) - 1;  ///< Archive magic length excluding null terminator.
+static constexpr size_t ARCHIVE_HEADER_LEN =
+    ARCHIVE_HDR_LEN + SALT_LEN + KDF_PARAMS_LEN;  ///< Archive header: magic | salt | KDF.
+static constexpr size_t ARCHIVE_TRAILER_LEN =
+    8 + ARCHIVE_HDR_LEN;  ///< Archive trailer: index length | magic.
+static constexpr size_t ARCHIVE_BUFFERED = 4 << 20;  ///< Members this small are sealed in memory.
+static constexpr size_t ARCHIVE_WRITE_BUFFER = 1 << 20;  ///< Bytes gathered per archive write.
+static constexpr uint64_t ARCHIVE_INDEX_MAX = 1ULL << 30;  ///< Largest raw archive index.
 
 /// @brief Compile-time validation of cryptographic configuration invariants.
 consteval bool validate()
@@ -52,6 +167,28 @@ consteval bool validate()
     static_assert(KEY_LEN == 32, "AES-256 requires a 32-byte key");
     static_assert(IV_LEN == 12, "AES-GCM requires a 12-byte IV (NIST SP 800-38D)");
     static_assert(TAG_LEN == 16, "GCM tag must be 16 bytes for full authentication strength");
+    static_assert(SEGMENT_PREFIX_LEN + 4 + 1 == IV_LEN,
+                  "segment nonce is prefix | counter(4) | last flag(1)");
+    static_assert((SEGMENT_AEAD_MASK & SEGMENT_COMPRESSED) == 0 &&
+                      (SEGMENT_AEAD_MASK >> SEGMENT_AEAD_SHIFT) == 3 &&
+                      std::countr_zero(SEGMENT_LEN) < (1u << SEGMENT_AEAD_SHIFT),
+                  "segment flags must not overlap the segment size");
+    static_assert(SEGMENT_LEN > 0 && (SEGMENT_LEN & (SEGMENT_LEN - 1)) == 0,
+                  "segment length must be a power of 2");
+    static_assert(sizeof(SEGMENT_KEYED_HDR) == sizeof(SEGMENT_HDR) &&
+                      sizeof(SEGMENT_KDF_HDR) == sizeof(SEGMENT_HDR) &&
+                      sizeof(SEGMENT_KEYED_KDF_HDR) == sizeof(SEGMENT_HDR),
+                  "all segmented magics must have the same length");
+    static_assert(sizeof(PACKET_KDF_HDR) == sizeof(AAD_HDR),
+                  "both packet magics must have the same length");
+    static_assert(std::has_single_bit(LOCKED_SLAB_MIN_SLOT) &&
+                      std::has_single_bit(LOCKED_SLAB_MAX_SLOT) &&
+                      LOCKED_SLAB_MIN_SLOT <= LOCKED_SLAB_MAX_SLOT,
+                  "slab slot sizes must be powers of 2");
+    static_assert(LOCKED_SLAB_ARENA % 4096 == 0 && LOCKED_SLAB_ARENA >= 4 * LOCKED_SLAB_MAX_SLOT,
+                  "slab arenas must be whole pages holding several slots");
+    static_assert(SHRED_CHUNK % 4096 == 0 && SHRED_DEPTH >= 1,
+                  "shred writes must be whole pages to satisfy unbuffered alignment");
     static_assert(SCRYPT_N > 0 && (SCRYPT_N & (SCRYPT_N - 1)) == 0,
                   "scrypt N must be a power of 2");
     static_assert(SCRYPT_R >= 1, "scrypt r must be at least 1");
@@ -87,7 +224,7 @@ static constexpr size_t align_up(size_t v, size_t a)
 static constexpr uint32_t kMagic =
     0x6C616573u;  //!< locked_allocator header integrity magic ("seal"); not the vault file magic.
 static constexpr uint32_t kVersion =
-    1u;  //!< locked_allocator header version; not the vault format version.
+    2u;  //!< locked_allocator header version; not the vault format version.
 static constexpr size_t kCanaryBytes = 32;  //!< Canary bytes after payload (0xD0)
 
 }  // namespace seal
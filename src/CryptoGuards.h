@@ -5,6 +5,7 @@
 #include <wincrypt.h>
 
 #include <openssl/evp.h>
+#include <openssl/kdf.h>
 
 #include <stdexcept>
 
@@ -242,6 +243,120 @@ struct EvpCipherCtx
     EvpCipherCtx& operator=(EvpCipherCtx&&) = delete;
 };
 
+/**
+ * @brief AES-256-GCM implementation, fetched from the default provider once.
+ * @ingroup Crypto
+ *
+ * `EVP_aes_256_gcm()` hands back a legacy handle that every
+ * `EVP_*Init_ex` call re-resolves through the provider store and its
+ * locks. Fetching once and passing the result avoids that per call, which
+ * matters when every worker of a batch seals small packets. The fetched
+ * cipher lives for the whole process.
+ *
+ * @throw std::runtime_error if EVP_CIPHER_fetch() fails.
+ */
+inline const EVP_CIPHER* aes256Gcm()
+{
+    static EVP_CIPHER* const cipher = []
+    {
+        EVP_CIPHER* c = EVP_CIPHER_fetch(nullptr, "AES-256-GCM", nullptr);
+        if (!c)
+        {
+            throw std::runtime_error("EVP_CIPHER_fetch(AES-256-GCM) failed");
+        }
+        return c;
+    }();
+    return cipher;
+}
+
+/**
+ * @brief Process-wide ChaCha20-Poly1305 cipher, fetched once like aes256Gcm().
+ * @throw std::runtime_error if EVP_CIPHER_fetch() fails.
+ */
+inline const EVP_CIPHER* chacha20Poly1305()
+{
+    static EVP_CIPHER* const cipher = []
+    {
+        EVP_CIPHER* c = EVP_CIPHER_fetch(nullptr, "ChaCha20-Poly1305", nullptr);
+        if (!c)
+        {
+            throw std::runtime_error("EVP_CIPHER_fetch(ChaCha20-Poly1305) failed");
+        }
+        return c;
+    }();
+    return cipher;
+}
+
+/**
+ * @class CachedCipherCtx
+ * @brief Lease on the calling thread's reusable EVP_CIPHER_CTX.
+ * @ingroup Crypto
+ *
+ * Drop-in for EvpCipherCtx on hot paths. Each thread keeps one context;
+ * a lease takes it if it is free and otherwise falls back to a private
+ * one, so overlapping leases on one thread still work. Releasing resets
+ * the context, which wipes the key schedule, while the context object
+ * itself is kept for the next lease. Pass aes256Gcm() as the cipher.
+ *
+ * @throw std::runtime_error if EVP_CIPHER_CTX_new() fails.
+ */
+class CachedCipherCtx
+{
+public:
+    EVP_CIPHER_CTX* p{nullptr};
+
+    CachedCipherCtx()
+    {
+        Slot& slot = t_Slot;
+        if (!slot.busy)
+        {
+            if (!slot.ctx)
+                slot.ctx = EVP_CIPHER_CTX_new();
+            slot.busy = slot.ctx != nullptr;
+            p = slot.ctx;
+            m_Cached = slot.busy;
+        }
+        if (!p)
+            p = EVP_CIPHER_CTX_new();
+        if (!p)
+        {
+            throw std::runtime_error("EVP_CIPHER_CTX_new failed");
+        }
+    }
+
+    ~CachedCipherCtx()
+    {
+        if (!m_Cached)
+        {
+            EVP_CIPHER_CTX_free(p);
+            return;
+        }
+        (void)EVP_CIPHER_CTX_reset(p);
+        t_Slot.busy = false;
+    }
+
+    CachedCipherCtx(const CachedCipherCtx&) = delete;
+    CachedCipherCtx& operator=(const CachedCipherCtx&) = delete;
+    CachedCipherCtx(CachedCipherCtx&&) = delete;
+    CachedCipherCtx& operator=(CachedCipherCtx&&) = delete;
+
+private:
+    struct Slot
+    {
+        EVP_CIPHER_CTX* ctx{nullptr};
+        bool busy{false};
+        ~Slot()
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            ctx = nullptr;
+            busy = true;  // leases during thread teardown allocate their own
+        }
+    };
+
+    static inline thread_local Slot t_Slot;
+    bool m_Cached{false};
+};
+
 /**
  * @struct EvpMdCtx
  * @brief RAII owner for an OpenSSL EVP_MD_CTX.
@@ -276,4 +391,56 @@ struct EvpMdCtx
     EvpMdCtx& operator=(EvpMdCtx&&) = delete;
 };
 
+/**
+ * @struct EvpKdfCtx
+ * @brief RAII owner for an OpenSSL EVP_KDF_CTX.
+ * @ingroup Crypto
+ *
+ * Fetches the named KDF implementation and allocates a context for it on
+ * construction; frees the context on destruction. The context holds its
+ * own reference to the fetched KDF. Non-copyable.
+ *
+ * @throw std::runtime_error if EVP_KDF_fetch() or EVP_KDF_CTX_new() fails.
+ */
+struct EvpKdfCtx
+{
+    EVP_KDF_CTX* p{nullptr};
+
+    /// @brief Context for an already fetched KDF; the caller keeps its reference.
+    explicit EvpKdfCtx(EVP_KDF* kdf)
+        : p(EVP_KDF_CTX_new(kdf))
+    {
+        if (!p)
+        {
+            throw std::runtime_error("EVP_KDF_CTX_new failed");
+        }
+    }
+
+    explicit EvpKdfCtx(const char* algorithm)
+    {
+        EVP_KDF* kdf = EVP_KDF_fetch(nullptr, algorithm, nullptr);
+        if (!kdf)
+        {
+            throw std::runtime_error("EVP_KDF_fetch failed");
+        }
+        p = EVP_KDF_CTX_new(kdf);
+        EVP_KDF_free(kdf);
+        if (!p)
+        {
+            throw std::runtime_error("EVP_KDF_CTX_new failed");
+        }
+    }
+    ~EvpKdfCtx()
+    {
+        if (p)
+        {
+            EVP_KDF_CTX_free(p);
+        }
+    }
+    EvpKdfCtx(const EvpKdfCtx&) = delete;
+    EvpKdfCtx& operator=(const EvpKdfCtx&) = delete;
+    EvpKdfCtx(EvpKdfCtx&&) = delete;
+    EvpKdfCtx& operator=(EvpKdfCtx&&) = delete;
+};
+
 }  // namespace seal
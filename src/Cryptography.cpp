@@ -1,9 +1,29 @@
 #include "Cryptography.h"
+#include "Compression.h"
+#include "Metrics.h"
 
 #include <sddl.h>
 
+#include <openssl/core_names.h>
+#include <openssl/opensslv.h>
+#include <openssl/params.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L
+#include <openssl/thread.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #ifdef USE_QT_UI
-#include <QtCore/QElapsedTimer>
 #include <QtCore/QString>
 #include "Diagnostics.h"
 #include "Logging.h"
@@ -174,9 +194,12 @@ void Cryptography::detectDebugger()
 
 void Cryptography::trimWorkingSet()
 {
-    // Force pages out of the working set so plaintext doesn't linger
-    // in physical RAM after sensitive operations complete.
-    EmptyWorkingSet(GetCurrentProcess());
+    // EmptyWorkingSet() used to run here. It cannot evict locked pages, which
+    // are the ones holding secrets, and it evicted everything else, so the UI
+    // page-faulted its way back in after every fill. The secrets are wiped in
+    // place; what can be given back is the locked quota held by wiped
+    // regions parked for reuse.
+    (void)seal::locked_pool::drain();
 }
 
 using PFN_SetProcessMitigationPolicy = BOOL(WINAPI*)(PROCESS_MITIGATION_POLICY, PVOID, SIZE_T);
@@ -318,17 +341,825 @@ std::span<const unsigned char> Cryptography::aadSpan() noexcept
             static_cast<std::size_t>(seal::cfg::AAD_LEN)};
 }
 
+std::span<const unsigned char> Cryptography::packetAad(std::span<const unsigned char> packet)
+{
+    if (packet.size() < seal::cfg::AAD_LEN)
+        throw std::runtime_error("Ciphertext too short (missing AAD)");
+    if (std::memcmp(packet.data(), seal::cfg::AAD_HDR, seal::cfg::AAD_LEN) == 0)
+        return packet.first(seal::cfg::AAD_LEN);
+    if (std::memcmp(packet.data(), seal::cfg::PACKET_KDF_HDR, seal::cfg::AAD_LEN) == 0)
+    {
+        if (packet.size() < seal::cfg::PACKET_KDF_AAD_LEN)
+            throw std::runtime_error("Ciphertext too short (missing AAD)");
+        return packet.first(seal::cfg::PACKET_KDF_AAD_LEN);
+    }
+    throw std::runtime_error("Bad AAD header");
+}
+
+KdfParams Cryptography::packetKdf(std::span<const unsigned char> packet)
+{
+    auto aad = packetAad(packet);
+    if (aad.size() == seal::cfg::AAD_LEN)
+        return KdfParams::legacy();
+    auto kdf = KdfParams::decode(aad.subspan(seal::cfg::AAD_LEN));
+    if (!kdf)
+        throw std::runtime_error("Bad KDF parameters");
+    return *kdf;
+}
+
+namespace
+{
+
+// kdfParams() packed from its encode() bytes, so it is one atomic word.
+uint32_t packKdf(const KdfParams& kdf) noexcept
+{
+    auto b = kdf.encode();
+    return uint32_t{b[0]} | uint32_t{b[1]} << 8 | uint32_t{b[2]} << 16 | uint32_t{b[3]} << 24;
+}
+
+std::atomic<uint32_t> g_KdfParams{packKdf(KdfParams::legacy())};
+std::atomic<bool> g_SegmentCompression{false};
+// setAead()'s choice, or -1 to follow preferredAead().
+std::atomic<int> g_Aead{-1};
+
+// AES and carry-less multiply in hardware are what make OpenSSL's GCM
+// fast; without them its table-based fallback runs several times slower
+// than ChaCha20-Poly1305.
+bool hasAesHardware() noexcept
+{
+#if defined(_M_X64) || defined(_M_IX86)
+    int regs[4]{};
+    __cpuid(regs, 1);
+    return (regs[2] & (1 << 25)) != 0 && (regs[2] & (1 << 1)) != 0;  // AES, PCLMULQDQ
+#elif defined(_M_ARM64)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != FALSE;
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul");
+#else
+    return false;
+#endif
+}
+
+// Bytes a single-shot packet adds to its plaintext with these parameters.
+constexpr size_t packetOverhead(const KdfParams& kdf) noexcept
+{
+    return Cryptography::packetSize(0, kdf);
+}
+
+}  // namespace
+
+void Cryptography::setKdfParams(const KdfParams& kdf)
+{
+    if (!kdf.valid())
+        throw std::invalid_argument("Invalid KDF parameters");
+    if (kdf.algorithm == KdfAlgorithm::Argon2id && !argon2Available())
+        throw std::runtime_error("Argon2id needs OpenSSL 3.2 or later");
+    g_KdfParams.store(packKdf(kdf), std::memory_order_relaxed);
+}
+
+void Cryptography::setSegmentCompression(bool enabled) noexcept
+{
+    g_SegmentCompression.store(enabled, std::memory_order_relaxed);
+}
+
+bool Cryptography::segmentCompression() noexcept
+{
+    return g_SegmentCompression.load(std::memory_order_relaxed);
+}
+
+void Cryptography::setAead(AeadAlgorithm aead) noexcept
+{
+    g_Aead.store(static_cast<int>(aead), std::memory_order_relaxed);
+}
+
+AeadAlgorithm Cryptography::aead() noexcept
+{
+    const int v = g_Aead.load(std::memory_order_relaxed);
+    return v < 0 ? preferredAead() : static_cast<AeadAlgorithm>(v);
+}
+
+AeadAlgorithm Cryptography::preferredAead() noexcept
+{
+    static const AeadAlgorithm preferred =
+        hasAesHardware() ? AeadAlgorithm::Aes256Gcm : AeadAlgorithm::ChaCha20Poly1305;
+    return preferred;
+}
+
+KdfParams Cryptography::kdfParams() noexcept
+{
+    const uint32_t v = g_KdfParams.load(std::memory_order_relaxed);
+    const unsigned char b[seal::cfg::KDF_PARAMS_LEN] = {static_cast<unsigned char>(v),
+                                                        static_cast<unsigned char>(v >> 8),
+                                                        static_cast<unsigned char>(v >> 16),
+                                                        static_cast<unsigned char>(v >> 24)};
+    return KdfParams::decode(b).value_or(KdfParams::legacy());
+}
+
+size_t Cryptography::packetSize(size_t plaintextLen) noexcept
+{
+    return packetSize(plaintextLen, kdfParams());
+}
+
+namespace
+{
+
+// Both ciphers take the same EVP_CTRL_AEAD_* controls, so only the
+// cipher handle differs between them.
+const EVP_CIPHER* aeadCipher(AeadAlgorithm aead)
+{
+    return aead == AeadAlgorithm::ChaCha20Poly1305 ? seal::chacha20Poly1305()
+                                                   : seal::aes256Gcm();
+}
+
+}  // namespace
+
+// Every packet layout funnels into these two, so each layout only has to
+// work out where its IV, AAD, ciphertext and tag live.
+void Cryptography::aeadSeal(std::span<const unsigned char> key,
+                            const unsigned char* iv,
+                            std::span<const unsigned char> aad,
+                            std::span<const unsigned char> plain,
+                            unsigned char* ct,
+                            unsigned char* tag,
+                            AeadAlgorithm aead)
+{
+    seal::CachedCipherCtx ctx;
+    opensslCheck(EVP_EncryptInit_ex(ctx.p, aeadCipher(aead), nullptr, nullptr, nullptr),
+                 "EncryptInit(cipher) failed");
+    opensslCheck(
+        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_AEAD_SET_IVLEN, (int)seal::cfg::IV_LEN, nullptr),
+        "SET_IVLEN failed");
+    opensslCheck(EVP_EncryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv),
+                 "EncryptInit(key/iv) failed");
+
+    int tmp = 0;
+    if (!aad.empty())
+    {
+        opensslCheck(EVP_EncryptUpdate(ctx.p, nullptr, &tmp, aad.data(), (int)aad.size()),
+                     "EncryptUpdate(AAD) failed");
+    }
+
+    int outlen = 0, fin = 0;
+    opensslCheck(EVP_EncryptUpdate(ctx.p, ct, &outlen, plain.data(), (int)plain.size()),
+                 "EncryptUpdate(PT) failed");
+    opensslCheck(EVP_EncryptFinal_ex(ctx.p, ct + outlen, &fin), "EncryptFinal failed");
+    opensslCheck(EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_AEAD_GET_TAG, (int)seal::cfg::TAG_LEN, tag),
+                 "GET_TAG failed");
+    seal::metrics::add(seal::metrics::Counter::PacketsSealed);
+    seal::metrics::add(seal::metrics::Counter::BytesSealed, plain.size());
+}
+
+bool Cryptography::aeadOpen(std::span<const unsigned char> key,
+                            const unsigned char* iv,
+                            std::span<const unsigned char> aad,
+                            std::span<const unsigned char> ct,
+                            const unsigned char* tag,
+                            unsigned char* out,
+                            AeadAlgorithm aead)
+{
+    seal::CachedCipherCtx ctx;
+    opensslCheck(EVP_DecryptInit_ex(ctx.p, aeadCipher(aead), nullptr, nullptr, nullptr),
+                 "DecryptInit(cipher) failed");
+    opensslCheck(
+        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_AEAD_SET_IVLEN, (int)seal::cfg::IV_LEN, nullptr),
+        "SET_IVLEN failed");
+    opensslCheck(EVP_DecryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv),
+                 "DecryptInit(key/iv) failed");
+
+    int tmp = 0;
+    if (!aad.empty())
+    {
+        opensslCheck(EVP_DecryptUpdate(ctx.p, nullptr, &tmp, aad.data(), (int)aad.size()),
+                     "DecryptUpdate(AAD) failed");
+    }
+
+    int outlen = 0, fin = 0;
+    opensslCheck(EVP_DecryptUpdate(ctx.p, out, &outlen, ct.data(), (int)ct.size()),
+                 "DecryptUpdate(CT) failed");
+
+    // SET_TAG takes a void*, not a const void*, so hand it a copy.
+    unsigned char tagCopy[seal::cfg::TAG_LEN];
+    std::memcpy(tagCopy, tag, sizeof(tagCopy));
+    opensslCheck(
+        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_AEAD_SET_TAG, (int)seal::cfg::TAG_LEN, tagCopy),
+        "SET_TAG failed");
+
+    if (EVP_DecryptFinal_ex(ctx.p, out + outlen, &fin) != 1)
+    {
+        if (!ct.empty())
+            SecureZeroMemory(out, ct.size());
+        seal::metrics::add(seal::metrics::Counter::AuthFailures);
+        return false;
+    }
+    seal::metrics::add(seal::metrics::Counter::PacketsOpened);
+    seal::metrics::add(seal::metrics::Counter::BytesOpened, ct.size());
+    return true;
+}
+
+namespace
+{
+
+bool hasMagic(std::span<const unsigned char> data, const char* magic) noexcept
+{
+    return data.size() >= seal::cfg::SEGMENT_HDR_LEN &&
+           std::memcmp(data.data(), magic, seal::cfg::SEGMENT_HDR_LEN) == 0;
+}
+
+// "sls2" / "slk2": the header ends in the KDF parameters of its salt.
+bool hasSegmentKdf(std::span<const unsigned char> data) noexcept
+{
+    return hasMagic(data, seal::cfg::SEGMENT_KDF_HDR) ||
+           hasMagic(data, seal::cfg::SEGMENT_KEYED_KDF_HDR);
+}
+
+}  // namespace
+
+bool Cryptography::isSegmentedPacket(std::span<const unsigned char> data) noexcept
+{
+    return hasMagic(data, seal::cfg::SEGMENT_HDR) || hasMagic(data, seal::cfg::SEGMENT_KDF_HDR) ||
+           isKeyedSegmentPacket(data);
+}
+
+bool Cryptography::isKeyedSegmentPacket(std::span<const unsigned char> data) noexcept
+{
+    return hasMagic(data, seal::cfg::SEGMENT_KEYED_HDR) ||
+           hasMagic(data, seal::cfg::SEGMENT_KEYED_KDF_HDR);
+}
+
+std::vector<unsigned char> Cryptography::makeSegmentHeader(std::span<const unsigned char> salt,
+                                                           bool keyed,
+                                                           const KdfParams& kdf,
+                                                           bool compressed,
+                                                           AeadAlgorithm aead)
+{
+    if (salt.size() != seal::cfg::SALT_LEN)
+        throw std::runtime_error("Invalid salt length");
+
+    // [ magic | salt | nonce prefix | log2(segment size) ] (| file nonce) (| kdf)
+    const bool storeKdf = !kdf.isLegacy();
+    const char* magic = keyed ? (storeKdf ? seal::cfg::SEGMENT_KEYED_KDF_HDR
+                                          : seal::cfg::SEGMENT_KEYED_HDR)
+                              : (storeKdf ? seal::cfg::SEGMENT_KDF_HDR : seal::cfg::SEGMENT_HDR);
+    std::vector<unsigned char> header(
+        (keyed ? seal::cfg::SEGMENT_KEYED_HEADER_LEN : seal::cfg::SEGMENT_HEADER_LEN) +
+        (storeKdf ? seal::cfg::KDF_PARAMS_LEN : 0));
+    std::memcpy(header.data(), magic, seal::cfg::SEGMENT_HDR_LEN);
+    std::memcpy(header.data() + seal::cfg::SEGMENT_HDR_LEN, salt.data(), salt.size());
+    unsigned char* prefix = header.data() + seal::cfg::SEGMENT_HDR_LEN + seal::cfg::SALT_LEN;
+    opensslCheck(RAND_bytes(prefix, (int)seal::cfg::SEGMENT_PREFIX_LEN),
+                 "RAND_bytes(prefix) failed");
+    header[seal::cfg::SEGMENT_HEADER_LEN - 1] =
+        static_cast<unsigned char>(std::countr_zero(seal::cfg::SEGMENT_LEN));
+    if (compressed)
+        header[seal::cfg::SEGMENT_HEADER_LEN - 1] |= seal::cfg::SEGMENT_COMPRESSED;
+    header[seal::cfg::SEGMENT_HEADER_LEN - 1] |=
+        static_cast<unsigned char>(static_cast<unsigned>(aead) << seal::cfg::SEGMENT_AEAD_SHIFT);
+    if (keyed)
+    {
+        opensslCheck(RAND_bytes(header.data() + seal::cfg::SEGMENT_HEADER_LEN,
+                                (int)seal::cfg::SEGMENT_FILE_NONCE_LEN),
+                     "RAND_bytes(file nonce) failed");
+    }
+    if (storeKdf)
+    {
+        auto bytes = kdf.encode();
+        std::copy(bytes.begin(), bytes.end(), header.end() - bytes.size());
+    }
+    return header;
+}
+
+bool Cryptography::isCompressedSegmentPacket(std::span<const unsigned char> header) noexcept
+{
+    return isSegmentedPacket(header) && header.size() >= seal::cfg::SEGMENT_HEADER_LEN &&
+           (header[seal::cfg::SEGMENT_HEADER_LEN - 1] & seal::cfg::SEGMENT_COMPRESSED) != 0;
+}
+
+size_t Cryptography::segmentHeaderSize(std::span<const unsigned char> header)
+{
+    const size_t kdfLen = hasSegmentKdf(header) ? seal::cfg::KDF_PARAMS_LEN : 0;
+    if (isKeyedSegmentPacket(header))
+        return seal::cfg::SEGMENT_KEYED_HEADER_LEN + kdfLen;
+    if (isSegmentedPacket(header))
+        return seal::cfg::SEGMENT_HEADER_LEN + kdfLen;
+    throw std::runtime_error("Bad segmented header");
+}
+
+KdfParams Cryptography::segmentKdf(std::span<const unsigned char> header)
+{
+    const size_t len = segmentHeaderSize(header);
+    if (header.size() < len)
+        throw std::runtime_error("Bad segmented header");
+    if (!hasSegmentKdf(header))
+        return KdfParams::legacy();
+    auto kdf = KdfParams::decode(header.subspan(len - seal::cfg::KDF_PARAMS_LEN));
+    if (!kdf)
+        throw std::runtime_error("Bad KDF parameters");
+    return *kdf;
+}
+
+size_t Cryptography::segmentSize(std::span<const unsigned char> header)
+{
+    if (header.size() < segmentHeaderSize(header))
+        throw std::runtime_error("Bad segmented header");
+    // Bound the declared size so a hostile header cannot make readers
+    // allocate absurd buffers: 4 KiB .. 16 MiB. The byte's top three bits
+    // are the compression flag and the AEAD ID, not part of the size.
+    const unsigned log2 = header[seal::cfg::SEGMENT_HEADER_LEN - 1] &
+                          ~unsigned{seal::cfg::SEGMENT_COMPRESSED | seal::cfg::SEGMENT_AEAD_MASK};
+    if (log2 < 12 || log2 > 24)
+        throw std::runtime_error("Bad segment size");
+    return size_t{1} << log2;
+}
+
+AeadAlgorithm Cryptography::segmentAead(std::span<const unsigned char> header)
+{
+    if (header.size() < segmentHeaderSize(header))
+        throw std::runtime_error("Bad segmented header");
+    const unsigned bits = header[seal::cfg::SEGMENT_HEADER_LEN - 1] & seal::cfg::SEGMENT_AEAD_MASK;
+    const unsigned id = bits >> seal::cfg::SEGMENT_AEAD_SHIFT;
+    if (id > static_cast<unsigned>(AeadAlgorithm::ChaCha20Poly1305))
+        throw std::runtime_error("Unsupported cipher");
+    return static_cast<AeadAlgorithm>(id);
+}
+
+Cryptography::LockedKeyBuffer Cryptography::segmentFileKey(std::span<const unsigned char> masterKey,
+                                                           std::span<const unsigned char> header)
+{
+    if (!isKeyedSegmentPacket(header) || header.size() < seal::cfg::SEGMENT_KEYED_HEADER_LEN)
+        throw std::runtime_error("Bad segmented header");
+    // The label carries the file nonce, so each file of a batch seals under
+    // its own key even though they all share one scrypt output.
+    std::string info("seal/file/v1:");
+    info.append(reinterpret_cast<const char*>(header.data() + seal::cfg::SEGMENT_HEADER_LEN),
+                seal::cfg::SEGMENT_FILE_NONCE_LEN);
+    return deriveSubkey(masterKey, info);
+}
+
+namespace
+{
+
+// The header bytes bound into every segment's AAD (the whole header).
+std::span<const unsigned char> segmentHeaderSpan(std::span<const unsigned char> header)
+{
+    const size_t len = Cryptography::segmentHeaderSize(header);
+    if (header.size() < len)
+        throw std::runtime_error("Bad segmented header");
+    return header.first(len);
+}
+
+// STREAM nonce: prefix(7) | big-endian segment counter(4) | last flag(1).
+std::array<unsigned char, seal::cfg::IV_LEN> segmentNonce(std::span<const unsigned char> header,
+                                                          uint64_t index,
+                                                          bool last)
+{
+    if (index > 0xFFFFFFFFull)
+        throw std::runtime_error("Too many segments");
+    std::array<unsigned char, seal::cfg::IV_LEN> nonce{};
+    std::memcpy(nonce.data(),
+                header.data() + seal::cfg::SEGMENT_HDR_LEN + seal::cfg::SALT_LEN,
+                seal::cfg::SEGMENT_PREFIX_LEN);
+    for (int i = 0; i < 4; ++i)
+        nonce[seal::cfg::SEGMENT_PREFIX_LEN + i] =
+            static_cast<unsigned char>(index >> (8 * (3 - i)));
+    nonce[seal::cfg::IV_LEN - 1] = last ? 1 : 0;
+    return nonce;
+}
+
+}  // namespace
+
+void Cryptography::sealSegment(std::span<const unsigned char> key,
+                               std::span<const unsigned char> header,
+                               uint64_t index,
+                               bool last,
+                               std::span<const unsigned char> plain,
+                               unsigned char* out)
+{
+    if (key.size() != seal::cfg::KEY_LEN)
+        throw std::runtime_error("Invalid key length");
+    header = segmentHeaderSpan(header);
+    auto nonce = segmentNonce(header, index, last);
+    aeadSeal(key, nonce.data(), header, plain, out, out + plain.size(), segmentAead(header));
+}
+
+bool Cryptography::openSegment(std::span<const unsigned char> key,
+                               std::span<const unsigned char> header,
+                               uint64_t index,
+                               bool last,
+                               std::span<const unsigned char> sealed,
+                               unsigned char* out)
+{
+    if (key.size() != seal::cfg::KEY_LEN)
+        throw std::runtime_error("Invalid key length");
+    if (sealed.size() < seal::cfg::TAG_LEN)
+        throw std::runtime_error("Invalid ciphertext/tag sizes");
+    header = segmentHeaderSpan(header);
+    auto nonce = segmentNonce(header, index, last);
+    const size_t ctLen = sealed.size() - seal::cfg::TAG_LEN;
+    return aeadOpen(key,
+                    nonce.data(),
+                    header,
+                    sealed.first(ctLen),
+                    sealed.data() + ctLen,
+                    out,
+                    segmentAead(header));
+}
+
+namespace
+{
+
+void storeU32BE(unsigned char* p, uint32_t v)
+{
+    for (int i = 3; i >= 0; --i, v >>= 8)
+        p[i] = static_cast<unsigned char>(v & 0xFFu);
+}
+
+uint64_t loadBE(const unsigned char* p, size_t n)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; ++i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+// Plaintext bytes of data segment `index` of a file of `plainSize` bytes.
+size_t segmentPlainSize(uint64_t plainSize, size_t segLen, uint64_t index)
+{
+    return static_cast<size_t>(std::min<uint64_t>(segLen, plainSize - index * segLen));
+}
+
+}  // namespace
+
+uint32_t Cryptography::sealCompressedSegment(std::span<const unsigned char> key,
+                                             std::span<const unsigned char> header,
+                                             uint64_t index,
+                                             std::span<const unsigned char> plain,
+                                             unsigned char* out)
+{
+    // Compress straight into the output, capped at the size that would
+    // still be worth it, then seal in place. A chunk that does not fit is
+    // already-compressed or random data and is sealed raw.
+    const size_t limit = plain.size() - plain.size() / seal::cfg::SEGMENT_MIN_SAVING - 1;
+    const size_t packed =
+        plain.size() < seal::cfg::SEGMENT_MIN_SAVING
+            ? 0
+            : seal::compression::compressInto(plain, std::span<unsigned char>(out, limit));
+    if (packed == 0)
+    {
+        sealSegment(key, header, index, false, plain, out);
+        return static_cast<uint32_t>(plain.size() + seal::cfg::TAG_LEN);
+    }
+    sealSegment(key, header, index, false, std::span<const unsigned char>(out, packed), out);
+    return static_cast<uint32_t>(packed + seal::cfg::TAG_LEN) |
+           seal::cfg::SEGMENT_ENTRY_COMPRESSED;
+}
+
+bool Cryptography::openCompressedSegment(std::span<const unsigned char> key,
+                                         std::span<const unsigned char> header,
+                                         uint64_t index,
+                                         uint32_t entry,
+                                         std::span<unsigned char> sealed,
+                                         std::span<unsigned char> out)
+{
+    if (sealed.size() != SegmentTable::storedSize(entry) || sealed.size() < seal::cfg::TAG_LEN)
+        throw std::runtime_error("Invalid ciphertext/tag sizes");
+    if (!(entry & seal::cfg::SEGMENT_ENTRY_COMPRESSED))
+    {
+        if (sealed.size() - seal::cfg::TAG_LEN != out.size())
+            throw std::runtime_error("Invalid ciphertext/tag sizes");
+        return openSegment(key, header, index, false, sealed, out.data());
+    }
+    if (!openSegment(key, header, index, false, sealed, sealed.data()))
+        return false;
+    const auto packed = sealed.first(sealed.size() - seal::cfg::TAG_LEN);
+    try
+    {
+        seal::compression::decompress(packed, out);
+    }
+    catch (...)
+    {
+        OPENSSL_cleanse(packed.data(), packed.size());
+        OPENSSL_cleanse(out.data(), out.size());
+        throw;
+    }
+    OPENSSL_cleanse(packed.data(), packed.size());
+    return true;
+}
+
+std::vector<unsigned char> Cryptography::sealSegmentTable(std::span<const unsigned char> key,
+                                                          std::span<const unsigned char> header,
+                                                          const SegmentTable& table)
+{
+    // [ plainSize(8) | entry(4) * n ], sealed as segment n with the final
+    // flag, then its length: dropping or appending segments breaks the tag.
+    std::vector<unsigned char> plain(8 + 4 * table.entries.size());
+    for (int i = 0; i < 8; ++i)
+        plain[i] = static_cast<unsigned char>(table.plainSize >> (8 * (7 - i)));
+    for (size_t i = 0; i < table.entries.size(); ++i)
+        storeU32BE(plain.data() + 8 + 4 * i, table.entries[i]);
+
+    const size_t sealedLen = plain.size() + seal::cfg::TAG_LEN;
+    std::vector<unsigned char> out(sealedLen + seal::cfg::SEGMENT_TABLE_TRAILER_LEN);
+    sealSegment(key, header, table.entries.size(), true, plain, out.data());
+    for (int i = 0; i < 8; ++i)
+        out[sealedLen + i] = static_cast<unsigned char>(uint64_t{sealedLen} >> (8 * (7 - i)));
+    return out;
+}
+
+size_t Cryptography::segmentTableSize(std::span<const unsigned char> trailer, uint64_t bodyLen)
+{
+    if (trailer.size() != seal::cfg::SEGMENT_TABLE_TRAILER_LEN ||
+        bodyLen < seal::cfg::SEGMENT_TABLE_TRAILER_LEN)
+        throw std::runtime_error("Truncated or malformed file");
+    // At least plainSize and one entry; never more than the file holds.
+    const uint64_t len = loadBE(trailer.data(), trailer.size());
+    if (len < 12 + seal::cfg::TAG_LEN || (len - 8 - seal::cfg::TAG_LEN) % 4 != 0 ||
+        len > bodyLen - seal::cfg::SEGMENT_TABLE_TRAILER_LEN)
+        throw std::runtime_error("Truncated or malformed file");
+    return static_cast<size_t>(len);
+}
+
+Cryptography::SegmentTable Cryptography::openSegmentTable(std::span<const unsigned char> key,
+                                                          std::span<const unsigned char> header,
+                                                          std::span<const unsigned char> sealed,
+                                                          uint64_t dataLen)
+{
+    if (sealed.size() < 12 + seal::cfg::TAG_LEN ||
+        (sealed.size() - 8 - seal::cfg::TAG_LEN) % 4 != 0)
+        throw std::runtime_error("Truncated or malformed file");
+    const size_t count = (sealed.size() - 8 - seal::cfg::TAG_LEN) / 4;
+    std::vector<unsigned char> plain(sealed.size() - seal::cfg::TAG_LEN);
+    if (!openSegment(key, header, count, true, sealed, plain.data()))
+        throw std::runtime_error("Authentication failed (bad password or corrupted data)");
+
+    SegmentTable table;
+    table.plainSize = loadBE(plain.data(), 8);
+    table.entries.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        table.entries[i] = static_cast<uint32_t>(loadBE(plain.data() + 8 + 4 * i, 4));
+
+    // The writer is trusted now, but the entries still have to describe
+    // exactly this file before anyone computes offsets from them.
+    const size_t segLen = segmentSize(header);
+    if (count != std::max<uint64_t>(1, (table.plainSize + segLen - 1) / segLen))
+        throw std::runtime_error("Malformed segment table");
+    uint64_t stored = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t e = table.entries[i];
+        const size_t size = SegmentTable::storedSize(e);
+        const size_t raw = segmentPlainSize(table.plainSize, segLen, i) + seal::cfg::TAG_LEN;
+        const bool fits = (e & seal::cfg::SEGMENT_ENTRY_COMPRESSED)
+                              ? size > seal::cfg::TAG_LEN && size < raw
+                              : size == raw;
+        if (!fits)
+            throw std::runtime_error("Malformed segment table");
+        stored += size;
+    }
+    if (stored != dataLen)
+        throw std::runtime_error("Truncated or malformed file");
+    return table;
+}
+
+std::vector<unsigned char> Cryptography::sealKeyedPacket(std::span<const unsigned char> plaintext,
+                                                         std::span<const unsigned char> masterKey,
+                                                         std::span<const unsigned char> salt,
+                                                         const KdfParams& kdf)
+{
+    auto packet = makeSegmentHeader(salt, true, kdf, false, aead());
+    const size_t headerLen = packet.size();
+    const size_t segLen = segmentSize(packet);
+    const size_t segments = std::max<size_t>(1, (plaintext.size() + segLen - 1) / segLen);
+    auto key = segmentFileKey(masterKey, packet);
+
+    // [ header | seg0 ct+tag | seg1 ct+tag | ... ]; an empty plaintext is
+    // one empty, final segment, as the file writers produce.
+    packet.resize(headerLen + plaintext.size() + segments * seal::cfg::TAG_LEN);
+    std::span<const unsigned char> header(packet.data(), headerLen);
+    try
+    {
+        unsigned char* out = packet.data() + headerLen;
+        for (size_t i = 0; i < segments; ++i)
+        {
+            const size_t offset = i * segLen;
+            auto chunk = plaintext.subspan(offset, std::min(segLen, plaintext.size() - offset));
+            sealSegment(key, header, i, i + 1 == segments, chunk, out);
+            out += chunk.size() + seal::cfg::TAG_LEN;
+        }
+    }
+    catch (...)
+    {
+        cleanseString(key);
+        throw;
+    }
+    cleanseString(key);
+    return packet;
+}
+
+namespace
+{
+
+// Walk the segments of an in-memory segmented packet, opening each one and
+// handing its plaintext to sink(data, size). The sink's buffer is
+// only valid for the duration of the call.
+template <class Sink>
+void openSegments(std::span<const unsigned char> packet,
+                  std::span<const unsigned char> key,
+                  std::vector<unsigned char>& scratch,
+                  Sink&& sink)
+{
+    std::span<const unsigned char> header = segmentHeaderSpan(packet);
+    const size_t segLen = Cryptography::segmentSize(header);
+    const size_t stride = segLen + seal::cfg::TAG_LEN;
+    std::span<const unsigned char> body = packet.subspan(header.size());
+    if (Cryptography::isCompressedSegmentPacket(header))
+    {
+        // [ segments | table | tableLen ]; each segment is opened from a
+        // copy, since compressed ones decrypt in place.
+        const size_t tableLen = Cryptography::segmentTableSize(
+            body.last(std::min(body.size(), seal::cfg::SEGMENT_TABLE_TRAILER_LEN)), body.size());
+        const size_t dataLen = body.size() - seal::cfg::SEGMENT_TABLE_TRAILER_LEN - tableLen;
+        const auto table =
+            Cryptography::openSegmentTable(key, header, body.subspan(dataLen, tableLen), dataLen);
+        std::vector<unsigned char> sealed;
+        scratch.resize(std::min<uint64_t>(segLen, table.plainSize));
+        try
+        {
+            size_t offset = 0;
+            for (size_t i = 0; i < table.entries.size(); ++i)
+            {
+                const size_t size = Cryptography::SegmentTable::storedSize(table.entries[i]);
+                const size_t plainLen = segmentPlainSize(table.plainSize, segLen, i);
+                sealed.assign(body.begin() + offset, body.begin() + offset + size);
+                if (!Cryptography::openCompressedSegment(
+                        key,
+                        header,
+                        i,
+                        table.entries[i],
+                        sealed,
+                        std::span<unsigned char>(scratch.data(), plainLen)))
+                    throw std::runtime_error(
+                        "Authentication failed (bad password or corrupted data)");
+                sink(scratch.data(), plainLen);
+                offset += size;
+            }
+        }
+        catch (...)
+        {
+            Cryptography::cleanseString(sealed);
+            throw;
+        }
+        Cryptography::cleanseString(sealed);
+        return;
+    }
+    if (body.size() < seal::cfg::TAG_LEN ||
+        (body.size() % stride != 0 && body.size() % stride < seal::cfg::TAG_LEN))
+        throw std::runtime_error("Invalid ciphertext/tag sizes");
+
+    // A tiny packet only needs room for its one short segment, not a full
+    // cfg::SEGMENT_LEN buffer.
+    scratch.resize(std::min(segLen, body.size()));
+    uint64_t index = 0;
+    while (!body.empty())
+    {
+        const size_t take = std::min(body.size(), stride);
+        const bool last = take == body.size();
+        if (!Cryptography::openSegment(key, header, index, last, body.first(take), scratch.data()))
+            throw std::runtime_error("Authentication failed (bad password or corrupted data)");
+        sink(scratch.data(), take - seal::cfg::TAG_LEN);
+        body = body.subspan(take);
+        ++index;
+    }
+}
+
+}  // namespace
+
+std::vector<unsigned char> Cryptography::openSegmentedPacket(std::span<const unsigned char> packet,
+                                                             std::span<const unsigned char> key)
+{
+    if (!isSegmentedPacket(packet))
+        throw std::runtime_error("Not a segmented packet");
+
+    std::vector<unsigned char> plain;
+    std::vector<unsigned char> scratch;
+    try
+    {
+        openSegments(packet,
+                     key,
+                     scratch,
+                     [&](const unsigned char* data, size_t size)
+                     { plain.insert(plain.end(), data, data + size); });
+    }
+    catch (...)
+    {
+        cleanseString(plain, scratch);
+        throw;
+    }
+    cleanseString(scratch);
+    return plain;
+}
+
+namespace
+{
+
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L
+EVP_KDF* argon2Kdf()
+{
+    static EVP_KDF* const kdf = []
+    {
+        EVP_KDF* fetched = EVP_KDF_fetch(nullptr, "ARGON2ID", nullptr);
+        if (!fetched)
+            throw std::runtime_error("EVP_KDF_fetch(ARGON2ID) failed");
+        return fetched;
+    }();
+    return kdf;
+}
+
+// OpenSSL refuses an Argon2 derivation that asks for more threads than its
+// pool has free, so the pool is sized for one derivation's lanes and only
+// one derivation at a time uses it; concurrent ones (parallel token or
+// record decrypts) compute their lanes on their own thread instead.
+std::mutex g_Argon2PoolMutex;
+
+void argon2Derive(const char* pass,
+                  size_t passlen,
+                  std::span<const unsigned char> salt,
+                  const KdfParams& kdf,
+                  std::span<unsigned char> out)
+{
+    uint32_t iter = kdf.rounds;
+    uint32_t lanes = kdf.lanes;
+    uint32_t memcost = uint32_t{1} << kdf.log2Cost;  // KiB
+    uint32_t threads = 1;
+
+    std::unique_lock<std::mutex> pool(g_Argon2PoolMutex, std::try_to_lock);
+    if (pool.owns_lock() && lanes > 1)
+    {
+        if (OSSL_get_max_threads(nullptr) < lanes)
+            (void)OSSL_set_max_threads(nullptr, seal::cfg::KDF_MAX_LANES);
+        threads = static_cast<uint32_t>(std::min<uint64_t>(lanes, OSSL_get_max_threads(nullptr)));
+        threads = std::max<uint32_t>(threads, 1);
+    }
+    if (threads <= 1)
+        pool = {};
+
+    seal::EvpKdfCtx kctx(argon2Kdf());
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_octet_string(
+            OSSL_KDF_PARAM_PASSWORD, const_cast<char*>(pass ? pass : ""), passlen),
+        OSSL_PARAM_construct_octet_string(
+            OSSL_KDF_PARAM_SALT, const_cast<unsigned char*>(salt.data()), salt.size()),
+        OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ITER, &iter),
+        OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ARGON2_LANES, &lanes),
+        OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_THREADS, &threads),
+        OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ARGON2_MEMCOST, &memcost),
+        OSSL_PARAM_construct_end()};
+    Cryptography::opensslCheck(EVP_KDF_derive(kctx.p, out.data(), out.size(), params),
+                               "Argon2id failed");
+}
+#endif
+
+}  // namespace
+
+bool Cryptography::argon2Available() noexcept
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L
+    try
+    {
+        (void)argon2Kdf();
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+#else
+    return false;
+#endif
+}
+
 template <secure_password SecurePwd>
 Cryptography::LockedKeyBuffer Cryptography::deriveKey(const SecurePwd& pwd,
                                                       std::span<const unsigned char> salt)
 {
+    return deriveKey(pwd, salt, KdfParams::legacy());
+}
+
+template <secure_password SecurePwd>
+Cryptography::LockedKeyBuffer Cryptography::deriveKey(const SecurePwd& pwd,
+                                                      std::span<const unsigned char> salt,
+                                                      const KdfParams& kdf)
+{
+    if (!kdf.valid())
+        throw std::runtime_error("Bad KDF parameters");
+
     using CharT = std::remove_pointer_t<decltype(pwd.s.data())>;
     // The key material lives in guard-paged, VirtualLock'd memory so it
     // cannot be swapped to disk between derivation and first use.
     LockedKeyBuffer key(seal::cfg::KEY_LEN);
 
     // RWGuard temporarily changes the password's memory page from PAGE_NOACCESS
-    // to PAGE_READWRITE so that scrypt can read the raw bytes. The guard's
+    // to PAGE_READWRITE so that the KDF can read the raw bytes. The guard's
     // destructor restores PAGE_NOACCESS.
     seal::RWGuard<CharT> guard(pwd.s.data());
 
@@ -341,127 +1172,246 @@ Cryptography::LockedKeyBuffer Cryptography::deriveKey(const SecurePwd& pwd,
         passlen = pwd.s.size() * sizeof(CharT);
     }
 
-#ifdef USE_QT_UI
-    QElapsedTimer timer;
-    timer.start();
-#endif
+    const auto started = std::chrono::steady_clock::now();
 
-    opensslCheck(EVP_PBE_scrypt(pass,
-                                passlen,
-                                salt.data(),
-                                salt.size(),
-                                seal::cfg::SCRYPT_N,
-                                seal::cfg::SCRYPT_R,
-                                seal::cfg::SCRYPT_P,
-                                seal::cfg::SCRYPT_MAXMEM,
-                                key.data(),
-                                key.size()),
-                 "scrypt failed");
+    if (kdf.algorithm == KdfAlgorithm::Argon2id)
+    {
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L
+        argon2Derive(pass, passlen, salt, kdf, key);
+#else
+        throw std::runtime_error("Argon2id needs OpenSSL 3.2 or later");
+#endif
+    }
+    else
+    {
+        // OpenSSL wants room for 128 * r * (N + p + 2) bytes; twice the
+        // nominal working set covers that for every valid() N and p.
+        opensslCheck(EVP_PBE_scrypt(pass,
+                                    passlen,
+                                    salt.data(),
+                                    salt.size(),
+                                    uint64_t{1} << kdf.log2Cost,
+                                    kdf.rounds,
+                                    kdf.lanes,
+                                    std::max(seal::cfg::SCRYPT_MAXMEM, 2 * kdf.memoryBytes()),
+                                    key.data(),
+                                    key.size()),
+                     "scrypt failed");
+    }
 
+    seal::metrics::record(seal::metrics::Latency::KeyDerivation,
+                          std::chrono::steady_clock::now() - started);
+    seal::metrics::add(seal::metrics::Counter::KeyDerivations);
 #ifdef USE_QT_UI
-    qCDebug(logCrypto).noquote() << QString::fromStdString(
-        seal::diag::joinFields({"event=crypto.derive_key.finish",
-                                "result=ok",
-                                "algo=scrypt",
-                                seal::diag::kv("duration_ms", timer.elapsed())}));
+    SEAL_LOG(qCDebug,
+             logCrypto,
+             "event=crypto.derive_key.finish",
+             "result=ok",
+             seal::diag::kv("kdf", kdf.str()),
+             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
 #endif
 
     return key;
 }
 
-template <secure_password SecurePwd>
-std::vector<unsigned char> Cryptography::encryptPacket(std::span<const unsigned char> plaintext,
-                                                       const SecurePwd& password)
+Cryptography::KdfCalibration Cryptography::calibrateKdf(KdfAlgorithm algorithm,
+                                                        unsigned targetMs,
+                                                        uint64_t memoryBudget)
 {
-    std::span<const unsigned char> aad = aadSpan();
+    if (algorithm == KdfAlgorithm::Argon2id && !argon2Available())
+        throw std::runtime_error("Argon2id needs OpenSSL 3.2 or later");
+    memoryBudget = std::min(memoryBudget, seal::cfg::KDF_MAX_MEMORY);
 
-    // salt and key
-    std::vector<unsigned char> salt(seal::cfg::SALT_LEN);
-    opensslCheck(RAND_bytes(salt.data(), (int)salt.size()), "RAND_bytes(salt) failed");
-    auto key = deriveKey(password, std::span<const unsigned char>(salt));
+    secure_string<> probe;
+    for (char c : std::string_view("seal kdf calibration"))
+        probe.push_back(c);
+    unsigned char salt[seal::cfg::SALT_LEN];
+    opensslCheck(RAND_bytes(salt, (int)sizeof(salt)), "RAND_bytes(salt) failed");
 
-    // iv
-    std::vector<unsigned char> iv(seal::cfg::IV_LEN);
-    opensslCheck(RAND_bytes(iv.data(), (int)iv.size()), "RAND_bytes(iv) failed");
+    auto measure = [&](const KdfParams& kdf)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto key = deriveKey(probe, salt, kdf);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        cleanseString(key);
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    };
 
-    seal::EvpCipherCtx ctx;
-    opensslCheck(EVP_EncryptInit_ex(ctx.p, EVP_aes_256_gcm(), nullptr, nullptr, nullptr),
-                 "EncryptInit(cipher) failed");
-    opensslCheck(EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)iv.size(), nullptr),
-                 "SET_IVLEN failed");
-    opensslCheck(EVP_EncryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv.data()),
-                 "EncryptInit(key/iv) failed");
+    KdfParams kdf;
+    if (algorithm == KdfAlgorithm::Argon2id)
+    {
+        kdf.algorithm = KdfAlgorithm::Argon2id;
+        kdf.log2Cost = 13;  // 8 MiB, the valid() floor
+        kdf.rounds = 1;
+        kdf.lanes = static_cast<uint8_t>(std::clamp<unsigned>(
+            std::thread::hardware_concurrency(), 1, seal::cfg::KDF_MAX_LANES));
+    }
+    else
+    {
+        kdf.log2Cost = 10;  // 1 MiB at r = 8, the valid() floor
+        kdf.rounds = 8;
+        kdf.lanes = 1;
+    }
 
-    // AAD (optional)
-    if (!aad.empty())
+    // The first run pays for provider and thread-pool start-up; time the
+    // floor again so the doubling below starts from a warm measurement.
+    (void)measure(kdf);
+    KdfCalibration best{kdf, measure(kdf)};
+
+    // Each step roughly doubles the cost, so stop as soon as the doubled
+    // time would miss the target, and only keep a step that measured in.
+    auto tryStep = [&](KdfParams next, double predictedMs)
     {
-        int tmp = 0;
-        opensslCheck(EVP_EncryptUpdate(ctx.p, nullptr, &tmp, aad.data(), (int)aad.size()),
-                     "EncryptUpdate(AAD) failed");
+        if (!next.valid() || next.memoryBytes() > memoryBudget || predictedMs > targetMs)
+            return false;
+        const double ms = measure(next);
+        if (ms > targetMs)
+            return false;
+        best = {next, ms};
+        return true;
+    };
+
+    for (;;)
+    {
+        KdfParams next = best.params;
+        ++next.log2Cost;
+        if (!tryStep(next, best.milliseconds * 2))
+            break;
+    }
+    // Argon2id: once memory is at the budget, spend the rest on passes.
+    while (algorithm == KdfAlgorithm::Argon2id)
+    {
+        KdfParams next = best.params;
+        ++next.rounds;
+        if (!tryStep(next, best.milliseconds * next.rounds / best.params.rounds))
+            break;
     }
+    cleanseString(probe);
+    return best;
+}
 
-    // Encrypt
-    std::vector<unsigned char> ct(plaintext.size() + 16 /*block slop*/);
-    int outlen = 0, fin = 0;
-    opensslCheck(
-        EVP_EncryptUpdate(ctx.p, ct.data(), &outlen, plaintext.data(), (int)plaintext.size()),
-        "EncryptUpdate(PT) failed");
-    int total = outlen;
-    opensslCheck(EVP_EncryptFinal_ex(ctx.p, ct.data() + total, &fin), "EncryptFinal failed");
-    total += fin;
-    ct.resize((size_t)total);
-
-    // Tag
-    std::vector<unsigned char> tag(seal::cfg::TAG_LEN);
-    opensslCheck(EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_GET_TAG, (int)tag.size(), tag.data()),
-                 "GET_TAG failed");
+template <secure_password SecurePwd>
+size_t Cryptography::encryptPacketInto(std::span<const unsigned char> plaintext,
+                                       const SecurePwd& password,
+                                       std::span<unsigned char> out)
+{
+    return encryptPacketInto(plaintext, password, kdfParams(), out);
+}
 
-    // Serialize packet into wire format:
-    // [ AAD (optional) | salt | IV | ciphertext | GCM auth tag ]
+template <secure_password SecurePwd>
+size_t Cryptography::encryptPacketInto(std::span<const unsigned char> plaintext,
+                                       const SecurePwd& password,
+                                       const KdfParams& kdf,
+                                       std::span<unsigned char> out)
+{
+    const size_t total = packetSize(plaintext.size(), kdf);
+    if (out.size() < total)
+        throw std::runtime_error("Output buffer too small");
+
+    // Lay the packet out in the wire format and fill each field in place:
+    // [ AAD | salt | IV | ciphertext | GCM auth tag ]
     // The receiver uses fixed-size fields (SALT_LEN, IV_LEN, TAG_LEN) to
     // parse the packet back apart; ciphertext length is inferred from the
     // remaining bytes. AAD is included unencrypted so the receiver can
-    // verify the header before doing any expensive key derivation.
-    std::vector<unsigned char> out;
-    out.reserve(aad.size() + salt.size() + iv.size() + ct.size() + tag.size());
-    if (!aad.empty())
-        out.insert(out.end(), aad.begin(), aad.end());
-    out.insert(out.end(), salt.begin(), salt.end());
-    out.insert(out.end(), iv.begin(), iv.end());
-    out.insert(out.end(), ct.begin(), ct.end());
-    out.insert(out.end(), tag.begin(), tag.end());
+    // verify the header before doing any expensive key derivation. With
+    // non-legacy KDF parameters the AAD is "slp2" followed by them.
+    std::span<const unsigned char> aad = aadSpan();
+    if (!kdf.isLegacy())
+    {
+        std::memcpy(out.data(), seal::cfg::PACKET_KDF_HDR, seal::cfg::AAD_LEN);
+        auto bytes = kdf.encode();
+        std::copy(bytes.begin(), bytes.end(), out.begin() + seal::cfg::AAD_LEN);
+        aad = out.first(seal::cfg::PACKET_KDF_AAD_LEN);
+    }
+    else
+    {
+        std::copy(aad.begin(), aad.end(), out.begin());
+    }
+    unsigned char* salt = out.data() + aad.size();
+    unsigned char* iv = salt + seal::cfg::SALT_LEN;
+    unsigned char* ct = iv + seal::cfg::IV_LEN;
+    unsigned char* tag = ct + plaintext.size();
+
+    opensslCheck(RAND_bytes(salt, (int)seal::cfg::SALT_LEN), "RAND_bytes(salt) failed");
+    auto key =
+        deriveKey(password, std::span<const unsigned char>(salt, seal::cfg::SALT_LEN), kdf);
+    try
+    {
+        opensslCheck(RAND_bytes(iv, (int)seal::cfg::IV_LEN), "RAND_bytes(iv) failed");
+        aeadSeal(key, iv, aad, plaintext, ct, tag);
+    }
+    catch (...)
+    {
+        cleanseString(key);
+        throw;
+    }
+    cleanseString(key);
 
 #ifdef USE_QT_UI
     qCDebug(logCrypto).noquote() << QString::fromStdString(
         seal::diag::joinFields({"event=crypto.encrypt_packet.finish",
                                 "result=ok",
                                 seal::diag::kv("plaintext_bytes", plaintext.size()),
-                                seal::diag::kv("packet_bytes", out.size())}));
+                                seal::diag::kv("packet_bytes", total)}));
 #endif
-    cleanseString(key);
-    return out;
+    return total;
 }
 
 template <secure_password SecurePwd>
-std::vector<unsigned char> Cryptography::decryptPacket(std::span<const unsigned char> packet,
+std::vector<unsigned char> Cryptography::encryptPacket(std::span<const unsigned char> plaintext,
                                                        const SecurePwd& password)
 {
-    std::span<const unsigned char> aad_expected = aadSpan();
+    // One snapshot sizes and seals the packet, so a concurrent
+    // setKdfParams() cannot change the AAD length in between.
+    const KdfParams kdf = kdfParams();
+    std::vector<unsigned char> out(packetSize(plaintext.size(), kdf));
+    encryptPacketInto(plaintext, password, kdf, out);
+    return out;
+}
+
+template <secure_password SecurePwd>
+size_t Cryptography::decryptPacketInto(std::span<const unsigned char> packet,
+                                       const SecurePwd& password,
+                                       std::span<unsigned char> out)
+{
+    if (isSegmentedPacket(packet))
+    {
+        auto key = deriveSegmentKey(password, packet);
+        std::vector<unsigned char> scratch;
+        size_t written = 0;
+        try
+        {
+            openSegments(packet,
+                         key,
+                         scratch,
+                         [&](const unsigned char* data, size_t size)
+                         {
+                             if (size > out.size() - written)
+                                 throw std::runtime_error("Output buffer too small");
+                             std::memcpy(out.data() + written, data, size);
+                             written += size;
+                         });
+        }
+        catch (...)
+        {
+            if (written)
+                SecureZeroMemory(out.data(), written);
+            cleanseString(key, scratch);
+            throw;
+        }
+        cleanseString(key, scratch);
+        return written;
+    }
+
     const unsigned char* p = packet.data();
     size_t n = packet.size();
 
     // Parse the wire format: [ AAD | salt | IV | ciphertext | tag ]
     // Walk through the packet using known fixed-size field lengths,
     // with 'off' tracking the current read position past the AAD.
-    size_t off = 0;
-    if (!aad_expected.empty())
-    {
-        if (n < aad_expected.size())
-            throw std::runtime_error("Ciphertext too short (missing AAD)");
-        if (std::memcmp(p, aad_expected.data(), aad_expected.size()) != 0)
-            throw std::runtime_error("Bad AAD header");
-        off = aad_expected.size();
-    }
+    std::span<const unsigned char> aad_expected = packetAad(packet);
+    const KdfParams kdf = packetKdf(packet);
+    size_t off = aad_expected.size();
 
     // Structure sizes
     if (n < off + seal::cfg::SALT_LEN + seal::cfg::IV_LEN + seal::cfg::TAG_LEN)
@@ -472,82 +1422,101 @@ std::vector<unsigned char> Cryptography::decryptPacket(std::span<const unsigned
     const unsigned char* salt = p + off;
     const unsigned char* iv = p + off + seal::cfg::SALT_LEN;
     const unsigned char* ct = p + off + seal::cfg::SALT_LEN + seal::cfg::IV_LEN;
-
-    size_t ct_len_with_tag = n - off - seal::cfg::SALT_LEN - seal::cfg::IV_LEN;
-    if (ct_len_with_tag < seal::cfg::TAG_LEN)
-        throw std::runtime_error("Invalid ciphertext/tag sizes");
-
-    size_t ct_len = ct_len_with_tag - seal::cfg::TAG_LEN;
+    size_t ct_len = n - off - seal::cfg::SALT_LEN - seal::cfg::IV_LEN - seal::cfg::TAG_LEN;
     const unsigned char* tag = ct + ct_len;
+    if (out.size() < ct_len)
+        throw std::runtime_error("Output buffer too small");
 
-    // Derive key
-    auto key = deriveKey(password, std::span<const unsigned char>(salt, seal::cfg::SALT_LEN));
-
-    seal::EvpCipherCtx ctx;
-    opensslCheck(EVP_DecryptInit_ex(ctx.p, EVP_aes_256_gcm(), nullptr, nullptr, nullptr),
-                 "DecryptInit(cipher) failed");
-    opensslCheck(
-        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)seal::cfg::IV_LEN, nullptr),
-        "SET_IVLEN failed");
-    opensslCheck(EVP_DecryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv),
-                 "DecryptInit(key/iv) failed");
-
-    // AAD (if required)
-    if (!aad_expected.empty())
+    auto key = deriveKey(password, std::span<const unsigned char>(salt, seal::cfg::SALT_LEN), kdf);
+    bool ok = false;
+    try
     {
-        int tmp = 0;
-        opensslCheck(
-            EVP_DecryptUpdate(ctx.p, nullptr, &tmp, aad_expected.data(), (int)aad_expected.size()),
-            "DecryptUpdate(AAD) failed");
+        ok = aeadOpen(key, iv, aad_expected, {ct, ct_len}, tag, out.data());
     }
+    catch (...)
+    {
+        cleanseString(key);
+        throw;
+    }
+    cleanseString(key);
 
-    // Decrypt
-    std::vector<unsigned char> plain(ct_len);
-    int outlen = 0, fin = 0;
-    opensslCheck(EVP_DecryptUpdate(ctx.p, plain.data(), &outlen, ct, (int)ct_len),
-                 "DecryptUpdate(CT) failed");
-
-    // Set tag and finalize (auth check happens here).
-    // We copy the tag into a mutable buffer because EVP_CIPHER_CTX_ctrl's
-    // SET_TAG parameter is typed as void*, not const void*
-    std::vector<unsigned char> tagCopy(tag, tag + seal::cfg::TAG_LEN);
-    opensslCheck(
-        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tagCopy.data()),
-        "SET_TAG failed");
-
-    int ok = EVP_DecryptFinal_ex(ctx.p, plain.data() + outlen, &fin);
-    if (ok != 1)
+    if (!ok)
     {
 #ifdef USE_QT_UI
         qCWarning(logCrypto).noquote() << QString::fromStdString(seal::diag::joinFields(
             {"event=crypto.decrypt_packet.finish", "result=fail", "reason=gcm_auth_failed"}));
 #endif
-        cleanseString(key);
         throw std::runtime_error("Authentication failed (bad password or corrupted data)");
     }
+    return ct_len;
+}
 
-    plain.resize((size_t)(outlen + fin));
-    cleanseString(key);
+template <secure_password SecurePwd>
+std::vector<unsigned char> Cryptography::decryptPacket(std::span<const unsigned char> packet,
+                                                       const SecurePwd& password)
+{
+    if (isSegmentedPacket(packet))
+    {
+        // The segmented total is only known after walking every segment,
+        // so grow the buffer as they come.
+        auto key = deriveSegmentKey(password, packet);
+        std::vector<unsigned char> plain;
+        std::vector<unsigned char> scratch;
+        try
+        {
+            openSegments(packet,
+                         key,
+                         scratch,
+                         [&](const unsigned char* data, size_t size)
+                         { plain.insert(plain.end(), data, data + size); });
+        }
+        catch (...)
+        {
+            cleanseString(key, plain, scratch);
+            throw;
+        }
+        cleanseString(key, scratch);
+        return plain;
+    }
+
+    // Too-short packets get an empty buffer; decryptPacketInto() rejects
+    // them before it looks at the output size. The buffer assumes the
+    // shorter AAD and is trimmed to what was actually written.
+    const size_t overhead = packetOverhead(KdfParams::legacy());
+    std::vector<unsigned char> plain(packet.size() > overhead ? packet.size() - overhead : 0);
+    plain.resize(decryptPacketInto(packet, password, plain));
     return plain;
 }
 
 template <secure_password SecurePwd>
 void Cryptography::verifyPacket(std::span<const unsigned char> packet, const SecurePwd& password)
 {
-    std::span<const unsigned char> aad_expected = aadSpan();
+    if (isSegmentedPacket(packet))
+    {
+        auto key = deriveSegmentKey(password, packet);
+        std::vector<unsigned char> scratch;
+        try
+        {
+            // Each segment is authenticated on its own; the plaintext is
+            // discarded as soon as its tag checks out.
+            openSegments(packet, key, scratch, [](const unsigned char*, size_t) {});
+        }
+        catch (...)
+        {
+            cleanseString(key, scratch);
+            throw;
+        }
+        cleanseString(key, scratch);
+        return;
+    }
+
     const unsigned char* p = packet.data();
     size_t n = packet.size();
 
     // Parse the wire format (same layout as decryptPacket).
-    size_t off = 0;
-    if (!aad_expected.empty())
-    {
-        if (n < aad_expected.size())
-            throw std::runtime_error("Ciphertext too short (missing AAD)");
-        if (std::memcmp(p, aad_expected.data(), aad_expected.size()) != 0)
-            throw std::runtime_error("Bad AAD header");
-        off = aad_expected.size();
-    }
+    std::span<const unsigned char> aad_expected = packetAad(packet);
+    const KdfParams kdf = packetKdf(packet);
+    size_t off = aad_expected.size();
 
     if (n < off + seal::cfg::SALT_LEN + seal::cfg::IV_LEN + seal::cfg::TAG_LEN)
         throw std::runtime_error("Ciphertext too short");
@@ -563,10 +1532,10 @@ void Cryptography::verifyPacket(std::span<const unsigned char> packet, const Sec
     size_t ct_len = ct_len_with_tag - seal::cfg::TAG_LEN;
     const unsigned char* tag = ct + ct_len;
 
-    auto key = deriveKey(password, std::span<const unsigned char>(salt, seal::cfg::SALT_LEN));
+    auto key = deriveKey(password, std::span<const unsigned char>(salt, seal::cfg::SALT_LEN), kdf);
 
-    seal::EvpCipherCtx ctx;
-    opensslCheck(EVP_DecryptInit_ex(ctx.p, EVP_aes_256_gcm(), nullptr, nullptr, nullptr),
+    seal::CachedCipherCtx ctx;
+    opensslCheck(EVP_DecryptInit_ex(ctx.p, seal::aes256Gcm(), nullptr, nullptr, nullptr),
                  "DecryptInit(cipher) failed");
     opensslCheck(
         EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)seal::cfg::IV_LEN, nullptr),
@@ -600,9 +1569,10 @@ void Cryptography::verifyPacket(std::span<const unsigned char> packet, const Sec
     }
     SecureZeroMemory(scratch, VERIFY_CHUNK);
 
-    std::vector<unsigned char> tagCopy(tag, tag + seal::cfg::TAG_LEN);
+    unsigned char tagCopy[seal::cfg::TAG_LEN];
+    std::memcpy(tagCopy, tag, sizeof(tagCopy));
     opensslCheck(
-        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tagCopy.data()),
+        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tagCopy),
         "SET_TAG failed");
 
     unsigned char finBuf[16]{};
@@ -613,12 +1583,175 @@ void Cryptography::verifyPacket(std::span<const unsigned char> packet, const Sec
 
     if (ok != 1)
     {
+        seal::metrics::add(seal::metrics::Counter::AuthFailures);
 #ifdef USE_QT_UI
         qCWarning(logCrypto).noquote() << QString::fromStdString(seal::diag::joinFields(
             {"event=crypto.verify_packet.finish", "result=fail", "reason=gcm_auth_failed"}));
 #endif
         throw std::runtime_error("Authentication failed (bad password or corrupted data)");
     }
+    seal::metrics::add(seal::metrics::Counter::PacketsOpened);
+    seal::metrics::add(seal::metrics::Counter::BytesOpened, ct_len);
+}
+
+template <secure_password SecurePwd>
+Cryptography::LockedKeyBuffer Cryptography::deriveSegmentKey(const SecurePwd& password,
+                                                             std::span<const unsigned char> header)
+{
+    if (header.size() < segmentHeaderSize(header))
+        throw std::runtime_error("Ciphertext too short");
+    (void)segmentSize(header);
+    auto key = deriveKey(password,
+                         header.subspan(seal::cfg::SEGMENT_HDR_LEN, seal::cfg::SALT_LEN),
+                         segmentKdf(header));
+    if (!isKeyedSegmentPacket(header))
+        return key;
+    auto fileKey = segmentFileKey(key, header);
+    cleanseString(key);
+    return fileKey;
+}
+
+template <secure_password SecurePwd>
+std::vector<std::vector<unsigned char>> Cryptography::encryptBatch(
+    std::span<const std::span<const unsigned char>> plaintexts, const SecurePwd& password)
+{
+    std::vector<std::vector<unsigned char>> packets;
+    if (plaintexts.empty())
+        return packets;
+
+    unsigned char salt[seal::cfg::SALT_LEN];
+    opensslCheck(RAND_bytes(salt, (int)sizeof(salt)), "RAND_bytes(batch salt) failed");
+    const KdfParams kdf = kdfParams();
+    auto master = deriveMasterKey(password, salt, kdf);
+    try
+    {
+        packets.reserve(plaintexts.size());
+        for (const auto& plaintext : plaintexts)
+            packets.push_back(sealKeyedPacket(plaintext, master, salt, kdf));
+    }
+    catch (...)
+    {
+        cleanseString(master);
+        throw;
+    }
+    cleanseString(master);
+    return packets;
+}
+
+template <secure_password SecurePwd>
+Cryptography::LockedKeyBuffer Cryptography::deriveMasterKey(const SecurePwd& password,
+                                                            std::span<const unsigned char> salt)
+{
+    return deriveMasterKey(password, salt, KdfParams::legacy());
+}
+
+template <secure_password SecurePwd>
+Cryptography::LockedKeyBuffer Cryptography::deriveMasterKey(const SecurePwd& password,
+                                                            std::span<const unsigned char> salt,
+                                                            const KdfParams& kdf)
+{
+    if (salt.size() < seal::cfg::SALT_LEN)
+        throw std::runtime_error("Master key salt too short");
+    return deriveKey(password, salt, kdf);
+}
+
+Cryptography::LockedKeyBuffer Cryptography::deriveSubkey(std::span<const unsigned char> masterKey,
+                                                         std::string_view info)
+{
+    if (masterKey.size() != seal::cfg::KEY_LEN)
+        throw std::runtime_error("Invalid master key length");
+
+    // HKDF without a salt is fine here: the input is already a uniformly
+    // random scrypt output, so only the expand step's domain separation
+    // (the info label) matters.
+    static EVP_KDF* const hkdf = []
+    {
+        EVP_KDF* kdf = EVP_KDF_fetch(nullptr, "HKDF", nullptr);
+        if (!kdf)
+            throw std::runtime_error("EVP_KDF_fetch(HKDF) failed");
+        return kdf;
+    }();
+    seal::EvpKdfCtx kctx(hkdf);
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, const_cast<char*>("SHA256"), 0),
+        OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_KEY,
+                                          const_cast<unsigned char*>(masterKey.data()),
+                                          masterKey.size()),
+        OSSL_PARAM_construct_octet_string(
+            OSSL_KDF_PARAM_INFO, const_cast<char*>(info.data()), info.size()),
+        OSSL_PARAM_construct_end()};
+
+    LockedKeyBuffer subkey(seal::cfg::KEY_LEN);
+    opensslCheck(EVP_KDF_derive(kctx.p, subkey.data(), subkey.size(), params),
+                 "HKDF derive failed");
+    return subkey;
+}
+
+size_t Cryptography::encryptWithKeyInto(std::span<const unsigned char> plaintext,
+                                        std::span<const unsigned char> key,
+                                        std::span<unsigned char> out)
+{
+    if (key.size() != seal::cfg::KEY_LEN)
+        throw std::runtime_error("Invalid key length");
+    const size_t total = keyedPacketSize(plaintext.size());
+    if (out.size() < total)
+        throw std::runtime_error("Output buffer too small");
+
+    // Encrypt straight into the final layout: [ AAD | IV | ciphertext | tag ].
+    std::span<const unsigned char> aad = aadSpan();
+    unsigned char* iv = out.data() + aad.size();
+    unsigned char* ct = iv + seal::cfg::IV_LEN;
+    unsigned char* tag = ct + plaintext.size();
+    std::copy(aad.begin(), aad.end(), out.begin());
+    opensslCheck(RAND_bytes(iv, (int)seal::cfg::IV_LEN), "RAND_bytes(iv) failed");
+    aeadSeal(key, iv, aad, plaintext, ct, tag);
+    return total;
+}
+
+std::vector<unsigned char> Cryptography::encryptWithKey(std::span<const unsigned char> plaintext,
+                                                        std::span<const unsigned char> key)
+{
+    std::vector<unsigned char> out(keyedPacketSize(plaintext.size()));
+    (void)encryptWithKeyInto(plaintext, key, out);
+    return out;
+}
+
+size_t Cryptography::decryptWithKeyInto(std::span<const unsigned char> packet,
+                                        std::span<const unsigned char> key,
+                                        std::span<unsigned char> out)
+{
+    if (key.size() != seal::cfg::KEY_LEN)
+        throw std::runtime_error("Invalid key length");
+
+    std::span<const unsigned char> aad_expected = aadSpan();
+    const unsigned char* p = packet.data();
+    size_t n = packet.size();
+
+    // Parse the keyed wire format: [ AAD | IV | ciphertext | tag ].
+    if (n < keyedPacketSize(0))
+        throw std::runtime_error("Ciphertext too short");
+    if (std::memcmp(p, aad_expected.data(), aad_expected.size()) != 0)
+        throw std::runtime_error("Bad AAD header");
+
+    const unsigned char* iv = p + aad_expected.size();
+    const unsigned char* ct = iv + seal::cfg::IV_LEN;
+    size_t ct_len = n - keyedPacketSize(0);
+    const unsigned char* tag = ct + ct_len;
+    if (out.size() < ct_len)
+        throw std::runtime_error("Output buffer too small");
+
+    if (!aeadOpen(key, iv, aad_expected, {ct, ct_len}, tag, out.data()))
+        throw std::runtime_error("Authentication failed (bad password or corrupted data)");
+    return ct_len;
+}
+
+std::vector<unsigned char> Cryptography::decryptWithKey(std::span<const unsigned char> packet,
+                                                        std::span<const unsigned char> key)
+{
+    std::vector<unsigned char> plain(
+        packet.size() > keyedPacketSize(0) ? packet.size() - keyedPacketSize(0) : 0);
+    (void)decryptWithKeyInto(packet, key, plain);
+    return plain;
 }
 
 // Explicit template instantiations for both narrow (char/UTF-8) and wide
@@ -627,6 +1760,12 @@ template Cryptography::LockedKeyBuffer Cryptography::deriveKey(const secure_stri
                                                                std::span<const unsigned char>);
 template Cryptography::LockedKeyBuffer Cryptography::deriveKey(const basic_secure_string<wchar_t>&,
                                                                std::span<const unsigned char>);
+template Cryptography::LockedKeyBuffer Cryptography::deriveKey(const secure_string<>&,
+                                                               std::span<const unsigned char>,
+                                                               const KdfParams&);
+template Cryptography::LockedKeyBuffer Cryptography::deriveKey(const basic_secure_string<wchar_t>&,
+                                                               std::span<const unsigned char>,
+                                                               const KdfParams&);
 
 template std::vector<unsigned char> Cryptography::encryptPacket(std::span<const unsigned char>,
                                                                 const secure_string<>&);
@@ -638,8 +1777,49 @@ template std::vector<unsigned char> Cryptography::decryptPacket(std::span<const
 template std::vector<unsigned char> Cryptography::decryptPacket(
     std::span<const unsigned char>, const basic_secure_string<wchar_t>&);
 
+template size_t Cryptography::encryptPacketInto(std::span<const unsigned char>,
+                                                const secure_string<>&,
+                                                std::span<unsigned char>);
+template size_t Cryptography::encryptPacketInto(std::span<const unsigned char>,
+                                                const basic_secure_string<wchar_t>&,
+                                                std::span<unsigned char>);
+template size_t Cryptography::encryptPacketInto(std::span<const unsigned char>,
+                                                const secure_string<>&,
+                                                const KdfParams&,
+                                                std::span<unsigned char>);
+template size_t Cryptography::encryptPacketInto(std::span<const unsigned char>,
+                                                const basic_secure_string<wchar_t>&,
+                                                const KdfParams&,
+                                                std::span<unsigned char>);
+
+template size_t Cryptography::decryptPacketInto(std::span<const unsigned char>,
+                                                const secure_string<>&,
+                                                std::span<unsigned char>);
+template size_t Cryptography::decryptPacketInto(std::span<const unsigned char>,
+                                                const basic_secure_string<wchar_t>&,
+                                                std::span<unsigned char>);
+
+template std::vector<std::vector<unsigned char>> Cryptography::encryptBatch(
+    std::span<const std::span<const unsigned char>>, const secure_string<>&);
+template std::vector<std::vector<unsigned char>> Cryptography::encryptBatch(
+    std::span<const std::span<const unsigned char>>, const basic_secure_string<wchar_t>&);
+
 template void Cryptography::verifyPacket(std::span<const unsigned char>, const secure_string<>&);
 template void Cryptography::verifyPacket(std::span<const unsigned char>,
                                          const basic_secure_string<wchar_t>&);
 
+template Cryptography::LockedKeyBuffer Cryptography::deriveMasterKey(
+    const secure_string<>&, std::span<const unsigned char>);
+template Cryptography::LockedKeyBuffer Cryptography::deriveMasterKey(
+    const basic_secure_string<wchar_t>&, std::span<const unsigned char>);
+template Cryptography::LockedKeyBuffer Cryptography::deriveMasterKey(
+    const secure_string<>&, std::span<const unsigned char>, const KdfParams&);
+template Cryptography::LockedKeyBuffer Cryptography::deriveMasterKey(
+    const basic_secure_string<wchar_t>&, std::span<const unsigned char>, const KdfParams&);
+
+template Cryptography::LockedKeyBuffer Cryptography::deriveSegmentKey(
+    const secure_string<>&, std::span<const unsigned char>);
+template Cryptography::LockedKeyBuffer Cryptography::deriveSegmentKey(
+    const basic_secure_string<wchar_t>&, std::span<const unsigned char>);
+
 }  // namespace seal
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CryptoGuards.h"
+#include "KdfParams.h"
 
 #include <aclapi.h>
 #include <heapapi.h>
@@ -17,6 +18,7 @@
 #include <span>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 
 #ifdef _MSC_VER
 #pragma comment(lib, "Shell32.lib")
@@ -31,6 +33,19 @@
 namespace seal
 {
 
+/**
+ * @brief AEAD cipher the segments of a segmented packet are sealed with.
+ * @ingroup Crypto
+ *
+ * Recorded in the header (cfg::SEGMENT_AEAD_MASK); both use a 32-byte key,
+ * a 12-byte nonce and a 16-byte tag.
+ */
+enum class AeadAlgorithm : uint8_t
+{
+    Aes256Gcm = 0,        ///< AES-256-GCM; every segmented file written before the field
+    ChaCha20Poly1305 = 1  ///< ChaCha20-Poly1305 (RFC 8439); fast without AES instructions
+};
+
 /**
  * @class Cryptography
  * @brief AES-256-GCM encryption, scrypt key derivation, and secure memory.
@@ -67,6 +82,49 @@ namespace seal
  *     end
  * ```
  *
+ * ## :material-key-chain: Keyed Packets
+ *
+ * Formats that hold many small packets (the vault index) cannot afford one
+ * scrypt per packet. deriveMasterKey() runs scrypt once over a caller-owned
+ * salt, deriveSubkey() expands the result with HKDF-SHA256 into
+ * domain-separated keys, and encryptWithKey() / decryptWithKey() seal
+ * individual packets under such a key with a fresh random IV each:
+ * `AAD(4) | IV(12) | Ciphertext(n) | Tag(16)`.
+ *
+ * Both packet kinds have `...Into()` overloads that write into a span the
+ * caller sized with packetSize() / keyedPacketSize(), so code sealing many
+ * tiny records can reuse one buffer (or decrypt straight into locked
+ * memory) instead of allocating a vector per packet.
+ *
+ * ## :material-view-sequential: Segmented Packets
+ *
+ * Large files use a STREAM-style layout (cfg::SEGMENT_HDR) so each
+ * segment can be authenticated, and its plaintext released, on its own.
+ * makeSegmentHeader() draws a per-file nonce prefix; sealSegment() /
+ * openSegment() bind the segment index and a final-segment flag into the
+ * nonce and the whole header into the AAD, so segments cannot be
+ * reordered, dropped, truncated at a boundary, or spliced between files.
+ * The keyed variant (cfg::SEGMENT_KEYED_HDR) adds a per-file nonce and
+ * seals under segmentFileKey(), an HKDF expansion of the scrypt master
+ * key, so a directory batch can share one scrypt run (see FileKeyring).
+ * decryptPacket() and verifyPacket() accept all of these layouts.
+ *
+ * Segments are sealed with the AeadAlgorithm their header names.
+ * setAead() picks it for new output; by default preferredAead() chooses
+ * AES-256-GCM on CPUs with AES and carry-less multiply instructions and
+ * ChaCha20-Poly1305 elsewhere, where it runs several times faster. Single-
+ * shot and keyed packets are always AES-256-GCM.
+ *
+ * ## :material-tune: KDF Parameters
+ *
+ * Every salt is run through the KDF its KdfParams name: the built-in
+ * scrypt parameters (KdfParams::legacy()) unless the format records
+ * others next to the salt (see cfg). setKdfParams() picks the parameters
+ * new packets, files and vaults are written with, and calibrateKdf()
+ * measures parameters for a latency target on the current machine.
+ * Readers always follow the stored parameters, so output written with
+ * any of them stays readable whatever the process default is.
+ *
  * ## :material-shield: Process Hardening
  *
  * A suite of static methods hardens the process against memory
@@ -76,7 +134,7 @@ namespace seal
  * - disableCrashDumps() - suppresses WER and crash dumps
  * - detectDebugger() - terminates the process if a debugger is detected
  * - setSecureProcessMitigations() - enables DEP, CFG, ASLR, image-load policies
- * - trimWorkingSet() - flushes plaintext from physical RAM
+ * - trimWorkingSet() - returns wiped locked regions to the OS
  *
  * @see locked_allocator, secure_string, cfg
  */
@@ -139,9 +197,9 @@ public:
     ///       the process calls `TerminateProcess` followed by `__fastfail`.
     static void detectDebugger();
 
-    /// @brief Trim the working set via `EmptyWorkingSet()`.
-    /// @post Dirty pages containing decrypted secrets are flushed from
-    ///       physical RAM, reducing the window for cold-boot or swap-file recovery.
+    /// @brief Give back the locked memory held by wiped, parked regions.
+    /// @post The calling thread's locked_pool is empty. Pages of live
+    ///       secrets and the rest of the process's working set are untouched.
     static void trimWorkingSet();
 
     /**
@@ -212,6 +270,82 @@ public:
     [[nodiscard]] static std::vector<unsigned char> decryptPacket(
         std::span<const unsigned char> packet, const SecurePwd& password);
 
+    /**
+     * @brief Size of the encryptPacket() packet for @p plaintextLen bytes.
+     *
+     * GCM is a stream mode, so the packet is the plaintext plus a fixed
+     * `AAD | Salt | IV | Tag` overhead. The AAD is cfg::AAD_LEN bytes
+     * with the legacy KDF parameters and cfg::PACKET_KDF_AAD_LEN with any
+     * other kdfParams().
+     *
+     * Reads kdfParams() once; code that sizes a buffer and then seals into
+     * it should take one snapshot and use the overloads that accept it.
+     */
+    [[nodiscard]] static size_t packetSize(size_t plaintextLen) noexcept;
+
+    /// @brief packetSize() for packets sealed with @p kdf.
+    [[nodiscard]] static constexpr size_t packetSize(size_t plaintextLen,
+                                                     const KdfParams& kdf) noexcept
+    {
+        return (kdf.isLegacy() ? seal::cfg::AAD_LEN : seal::cfg::PACKET_KDF_AAD_LEN) +
+               seal::cfg::SALT_LEN + seal::cfg::IV_LEN + plaintextLen + seal::cfg::TAG_LEN;
+    }
+
+    /**
+     * @brief encryptPacket() into a caller-provided buffer.
+     *
+     * The salt, IV and tag are generated in place and the ciphertext is
+     * written straight to its final offset; nothing is allocated besides
+     * the derived key.
+     *
+     * @tparam SecurePwd Secure password container with `.data()` and `.size()`.
+     * @param plaintext Raw bytes to encrypt.
+     * @param password  Master password for scrypt key derivation.
+     * @param out       At least `packetSize(plaintext.size())` bytes.
+     * @return Bytes written (`packetSize(plaintext.size())`).
+     * @throw std::runtime_error if @p out is too small, or on OpenSSL failure.
+     */
+    template <secure_password SecurePwd>
+    static size_t encryptPacketInto(std::span<const unsigned char> plaintext,
+                                    const SecurePwd& password,
+                                    std::span<unsigned char> out);
+
+    /**
+     * @brief encryptPacketInto() with explicit KDF parameters.
+     *
+     * Pair with `packetSize(plaintext.size(), kdf)` so the buffer and the
+     * packet agree even if setKdfParams() runs in between.
+     *
+     * @param kdf KDF parameters to derive with and record in the AAD.
+     * @return Bytes written (`packetSize(plaintext.size(), kdf)`).
+     */
+    template <secure_password SecurePwd>
+    static size_t encryptPacketInto(std::span<const unsigned char> plaintext,
+                                    const SecurePwd& password,
+                                    const KdfParams& kdf,
+                                    std::span<unsigned char> out);
+
+    /**
+     * @brief decryptPacket() into a caller-provided buffer.
+     *
+     * Pass a locked buffer (e.g. a LockedKeyBuffer or secure string storage)
+     * to keep the plaintext out of pageable memory. A single-shot packet
+     * needs `packet.size() - packetSize(0)` bytes; a segmented one its
+     * total plaintext length. @p out is wiped if authentication fails.
+     *
+     * @tparam SecurePwd Secure password container with `.data()` and `.size()`.
+     * @param packet   Framed encrypted packet (any layout decryptPacket() accepts).
+     * @param password Master password for scrypt key derivation.
+     * @param out      Receives the plaintext.
+     * @return Plaintext bytes written.
+     * @throw std::runtime_error on authentication failure, a malformed
+     *        packet, or if @p out is too small.
+     */
+    template <secure_password SecurePwd>
+    static size_t decryptPacketInto(std::span<const unsigned char> packet,
+                                    const SecurePwd& password,
+                                    std::span<unsigned char> out);
+
     /**
      * @brief Verify a framed AES-256-GCM packet without allocating full plaintext.
      *
@@ -228,6 +362,467 @@ public:
     template <secure_password SecurePwd>
     static void verifyPacket(std::span<const unsigned char> packet, const SecurePwd& password);
 
+    /**
+     * @brief Check whether @p data starts with a segmented-format header magic
+     *        (plain or keyed).
+     * @param data Leading bytes of a packet or file.
+     */
+    [[nodiscard]] static bool isSegmentedPacket(std::span<const unsigned char> data) noexcept;
+
+    /**
+     * @brief Check whether @p data starts with the keyed segmented-format magic.
+     * @param data Leading bytes of a packet or file.
+     */
+    [[nodiscard]] static bool isKeyedSegmentPacket(std::span<const unsigned char> data) noexcept;
+
+    /**
+     * @brief Build a segmented-format header with a fresh random nonce prefix.
+     *
+     * Layout: `Magic(4) | Salt(16) | NoncePrefix(7) | SegmentLog2(1)`, with
+     * the segment size taken from cfg::SEGMENT_LEN. A keyed header appends
+     * a random `FileNonce(16)` and is sealed under segmentFileKey().
+     *
+     * Non-legacy @p kdf parameters switch to the cfg::SEGMENT_KDF_HDR /
+     * cfg::SEGMENT_KEYED_KDF_HDR magic and append `Kdf(4)` after that.
+     *
+     * @param salt       KDF salt the (master) key was derived from (cfg::SALT_LEN bytes).
+     * @param keyed      Build the keyed variant.
+     * @param kdf        Parameters the key was derived with.
+     * @param compressed Set cfg::SEGMENT_COMPRESSED: segments go through
+     *                   sealCompressedSegment() and the file ends in a segment table.
+     * @param aead       Cipher the segments are sealed with.
+     * @return segmentHeaderSize() header bytes.
+     * @throw std::runtime_error on a bad salt length or RNG failure.
+     */
+    [[nodiscard]] static std::vector<unsigned char> makeSegmentHeader(
+        std::span<const unsigned char> salt,
+        bool keyed = false,
+        const KdfParams& kdf = KdfParams::legacy(),
+        bool compressed = false,
+        AeadAlgorithm aead = AeadAlgorithm::Aes256Gcm);
+
+    /**
+     * @brief Check whether a segmented header announces compressed segments.
+     * @param header At least cfg::SEGMENT_HEADER_LEN leading bytes.
+     */
+    [[nodiscard]] static bool isCompressedSegmentPacket(
+        std::span<const unsigned char> header) noexcept;
+
+    /**
+     * @brief Length of the header that @p header's magic announces.
+     * @param header At least cfg::SEGMENT_HDR_LEN leading bytes.
+     * @throw std::runtime_error if @p header has no segmented magic.
+     */
+    [[nodiscard]] static size_t segmentHeaderSize(std::span<const unsigned char> header);
+
+    /**
+     * @brief Validate a segmented header and return its plaintext segment size.
+     * @param header At least segmentHeaderSize() leading bytes.
+     * @throw std::runtime_error on a short or malformed header.
+     */
+    [[nodiscard]] static size_t segmentSize(std::span<const unsigned char> header);
+
+    /**
+     * @brief Cipher a segmented header's segments are sealed with.
+     * @param header At least segmentHeaderSize() leading bytes.
+     * @throw std::runtime_error on a short header or an unknown algorithm ID.
+     */
+    [[nodiscard]] static AeadAlgorithm segmentAead(std::span<const unsigned char> header);
+
+    /**
+     * @brief KDF parameters a segmented header's salt is derived with.
+     * @param header At least segmentHeaderSize() leading bytes.
+     * @throw std::runtime_error on a short header or invalid stored parameters.
+     */
+    [[nodiscard]] static KdfParams segmentKdf(std::span<const unsigned char> header);
+
+    /**
+     * @brief KDF parameters a single-shot packet's salt is derived with.
+     * @param packet Leading bytes of an encryptPacket() packet.
+     * @throw std::runtime_error on an unknown magic or invalid stored parameters.
+     */
+    [[nodiscard]] static KdfParams packetKdf(std::span<const unsigned char> packet);
+
+    /**
+     * @brief Encrypt one segment of a segmented packet.
+     *
+     * @param key    32-byte key derived from the header's salt.
+     * @param header Segmented header (bound into every segment's AAD).
+     * @param index  Zero-based segment index.
+     * @param last   Whether this is the final segment.
+     * @param plain  Segment plaintext (at most segmentSize() bytes).
+     * @param out    Receives `plain.size()` ciphertext bytes followed by the tag.
+     * @throw std::runtime_error on OpenSSL failure or index overflow.
+     */
+    static void sealSegment(std::span<const unsigned char> key,
+                            std::span<const unsigned char> header,
+                            uint64_t index,
+                            bool last,
+                            std::span<const unsigned char> plain,
+                            unsigned char* out);
+
+    /**
+     * @brief Decrypt and authenticate one segment of a segmented packet.
+     *
+     * @param key    32-byte key derived from the header's salt.
+     * @param header Segmented header.
+     * @param index  Zero-based segment index.
+     * @param last   Whether this is the final segment.
+     * @param sealed Segment ciphertext followed by its tag.
+     * @param out    Receives `sealed.size() - TAG_LEN` plaintext bytes; wiped on failure.
+     * @return `false` if the tag does not verify.
+     * @throw std::runtime_error on OpenSSL failure or a malformed segment.
+     */
+    [[nodiscard]] static bool openSegment(std::span<const unsigned char> key,
+                                          std::span<const unsigned char> header,
+                                          uint64_t index,
+                                          bool last,
+                                          std::span<const unsigned char> sealed,
+                                          unsigned char* out);
+
+    /// @brief Segment table of a compressed segmented file (see cfg).
+    struct SegmentTable
+    {
+        uint64_t plainSize = 0;        ///< Plaintext bytes of the whole file.
+        std::vector<uint32_t> entries;  ///< Stored bytes per segment, tag included, plus
+                                        ///< cfg::SEGMENT_ENTRY_COMPRESSED if compressed.
+
+        /// @brief Bytes segment @p e occupies in the file.
+        [[nodiscard]] static constexpr size_t storedSize(uint32_t e) noexcept
+        {
+            return e & ~seal::cfg::SEGMENT_ENTRY_COMPRESSED;
+        }
+    };
+
+    /**
+     * @brief Compress and seal one data segment of a compressed segmented file.
+     *
+     * The segment is stored compressed only if that saves at least
+     * 1/cfg::SEGMENT_MIN_SAVING of it; otherwise it is sealed as is, so
+     * incompressible data costs one failed compression attempt and nothing
+     * on disk. Data segments are never final: the segment table is.
+     *
+     * @param key    32-byte key derived from the header's salt.
+     * @param header Compressed segmented header.
+     * @param index  Zero-based segment index.
+     * @param plain  Segment plaintext (at most segmentSize() bytes).
+     * @param out    At least `plain.size() + cfg::TAG_LEN` bytes; receives
+     *               SegmentTable::storedSize() of the result bytes.
+     * @return The segment's table entry.
+     * @throw std::runtime_error on compressor or OpenSSL failure.
+     */
+    [[nodiscard]] static uint32_t sealCompressedSegment(std::span<const unsigned char> key,
+                                                        std::span<const unsigned char> header,
+                                                        uint64_t index,
+                                                        std::span<const unsigned char> plain,
+                                                        unsigned char* out);
+
+    /**
+     * @brief Open one data segment of a compressed segmented file.
+     *
+     * Compressed segments are decrypted in place in @p sealed, which is
+     * wiped again after decompression.
+     *
+     * @param key    32-byte key derived from the header's salt.
+     * @param header Compressed segmented header.
+     * @param index  Zero-based segment index.
+     * @param entry  The segment's table entry.
+     * @param sealed The segment as stored (SegmentTable::storedSize() bytes).
+     * @param out    Receives the plaintext; sized to the segment's plaintext length.
+     * @return `false` if the tag does not verify.
+     * @throw std::runtime_error on OpenSSL failure or a malformed segment.
+     */
+    [[nodiscard]] static bool openCompressedSegment(std::span<const unsigned char> key,
+                                                    std::span<const unsigned char> header,
+                                                    uint64_t index,
+                                                    uint32_t entry,
+                                                    std::span<unsigned char> sealed,
+                                                    std::span<unsigned char> out);
+
+    /**
+     * @brief Seal the segment table that ends a compressed segmented file.
+     * @param key    32-byte key derived from the header's salt.
+     * @param header Compressed segmented header.
+     * @param table  One entry per data segment, in order.
+     * @return The sealed table followed by its cfg::SEGMENT_TABLE_TRAILER_LEN trailer.
+     * @throw std::runtime_error on OpenSSL failure.
+     */
+    [[nodiscard]] static std::vector<unsigned char> sealSegmentTable(
+        std::span<const unsigned char> key,
+        std::span<const unsigned char> header,
+        const SegmentTable& table);
+
+    /**
+     * @brief Length of the sealed table a compressed segmented file's trailer names.
+     * @param trailer The file's last cfg::SEGMENT_TABLE_TRAILER_LEN bytes.
+     * @param bodyLen File bytes after the header, trailer included.
+     * @throw std::runtime_error if the length cannot be right for @p bodyLen.
+     */
+    [[nodiscard]] static size_t segmentTableSize(std::span<const unsigned char> trailer,
+                                                 uint64_t bodyLen);
+
+    /**
+     * @brief Authenticate and validate a compressed segmented file's table.
+     *
+     * Checks every entry against the header's segment size and the
+     * plaintext size, and that the stored segments add up to @p dataLen,
+     * so callers can compute each segment's offset from the table alone.
+     *
+     * @param key     32-byte key derived from the header's salt.
+     * @param header  Compressed segmented header.
+     * @param sealed  segmentTableSize() bytes read just before the trailer.
+     * @param dataLen File bytes between the header and the table.
+     * @throw std::runtime_error on authentication failure or a malformed table.
+     */
+    [[nodiscard]] static SegmentTable openSegmentTable(std::span<const unsigned char> key,
+                                                       std::span<const unsigned char> header,
+                                                       std::span<const unsigned char> sealed,
+                                                       uint64_t dataLen);
+
+    /// @brief Derived key type backed by guard-paged, locked memory.
+    using LockedKeyBuffer = std::vector<unsigned char, locked_allocator<unsigned char>>;
+
+    /**
+     * @brief Derive the file key of a keyed segmented header.
+     *
+     * HKDF-SHA256 over @p masterKey with the header's file nonce in the
+     * info label, so files sharing a salt still get independent keys.
+     *
+     * @param masterKey 32-byte scrypt output for the header's salt (deriveMasterKey()).
+     * @param header    Keyed segmented header.
+     * @return 32-byte file key in locked memory.
+     * @throw std::runtime_error on a non-keyed header or OpenSSL failure.
+     */
+    [[nodiscard]] static LockedKeyBuffer segmentFileKey(std::span<const unsigned char> masterKey,
+                                                        std::span<const unsigned char> header);
+
+    /**
+     * @brief Seal @p plaintext as a complete keyed segmented packet in memory.
+     *
+     * Draws a fresh keyed header for @p salt (so a fresh file nonce and
+     * nonce prefix) and seals the plaintext under its segmentFileKey().
+     * No KDF runs here; the result decrypts with decryptPacket() and just
+     * the password.
+     *
+     * @param plaintext Raw bytes to encrypt.
+     * @param masterKey 32-byte deriveMasterKey() output for @p salt.
+     * @param salt      Batch salt (cfg::SALT_LEN bytes).
+     * @param kdf       Parameters @p masterKey was derived with.
+     * @return The keyed segmented packet.
+     * @throw std::runtime_error on bad key or salt lengths, or OpenSSL failure.
+     */
+    [[nodiscard]] static std::vector<unsigned char> sealKeyedPacket(
+        std::span<const unsigned char> plaintext,
+        std::span<const unsigned char> masterKey,
+        std::span<const unsigned char> salt,
+        const KdfParams& kdf = KdfParams::legacy());
+
+    /**
+     * @brief Decrypt a whole segmented packet (plain or keyed) under a known key.
+     *
+     * The counterpart of sealKeyedPacket() for callers that already hold
+     * the packet's key, e.g. from FileKeyring::fileKey(): no KDF runs.
+     *
+     * @param packet Segmented packet, header included.
+     * @param key    32-byte key the packet was sealed under.
+     * @return Decrypted plaintext bytes.
+     * @throw std::runtime_error on a non-segmented or malformed packet, or
+     *        on authentication failure.
+     */
+    [[nodiscard]] static std::vector<unsigned char> openSegmentedPacket(
+        std::span<const unsigned char> packet, std::span<const unsigned char> key);
+
+    /**
+     * @brief Encrypt many small plaintexts with a single scrypt run.
+     *
+     * Draws one random batch salt, derives its master key once, and seals
+     * each item with sealKeyedPacket(): its own HKDF subkey and random
+     * nonces under the shared key. Every packet stands alone and decrypts
+     * with decryptPacket(), at the cost of 12 bytes more than
+     * encryptPacket() output per item.
+     *
+     * @tparam SecurePwd Secure password container with `.data()` and `.size()`.
+     * @param plaintexts Items to encrypt.
+     * @param password   Master password.
+     * @return One packet per item, in order.
+     * @throw std::runtime_error on RNG, KDF or OpenSSL failure.
+     */
+    template <secure_password SecurePwd>
+    [[nodiscard]] static std::vector<std::vector<unsigned char>> encryptBatch(
+        std::span<const std::span<const unsigned char>> plaintexts, const SecurePwd& password);
+
+    /**
+     * @brief Derive a master key from a password and an externally stored salt.
+     *
+     * Runs exactly one scrypt with the cfg:: parameters. The caller owns the
+     * salt (e.g. a vault header) and uses the result with deriveSubkey() or
+     * encryptWithKey() to seal any number of packets without further KDF cost.
+     *
+     * @tparam SecurePwd Secure password container with `.data()` and `.size()`.
+     * @param password Master password.
+     * @param salt     Random salt of at least cfg::SALT_LEN bytes.
+     * @return 32-byte key in locked memory.
+     * @throw std::runtime_error on a short salt or scrypt failure.
+     */
+    template <secure_password SecurePwd>
+    [[nodiscard]] static LockedKeyBuffer deriveMasterKey(const SecurePwd& password,
+                                                         std::span<const unsigned char> salt);
+
+    /// @brief deriveMasterKey() with explicit KDF parameters instead of the cfg:: ones.
+    /// @throw std::runtime_error on a short salt, invalid parameters or KDF failure.
+    template <secure_password SecurePwd>
+    [[nodiscard]] static LockedKeyBuffer deriveMasterKey(const SecurePwd& password,
+                                                         std::span<const unsigned char> salt,
+                                                         const KdfParams& kdf);
+
+    /**
+     * @brief Set the KDF parameters new packets, files and vaults are written with.
+     *
+     * Process-wide and safe to call from any thread; output already being
+     * written keeps the parameters it started with. main() sets it from
+     * `SEAL_KDF` or `--kdf` at startup.
+     *
+     * @param kdf Parameters; must be valid().
+     * @throw std::invalid_argument on invalid parameters, std::runtime_error
+     *        if they need Argon2id and this OpenSSL has none.
+     */
+    static void setKdfParams(const KdfParams& kdf);
+
+    /// @brief Parameters set by setKdfParams() (KdfParams::legacy() by default).
+    [[nodiscard]] static KdfParams kdfParams() noexcept;
+
+    /**
+     * @brief Choose whether new segmented files are written compressed.
+     *
+     * Process-wide like setKdfParams(); main() sets it from `--compress`.
+     * Files already being written keep the choice they started with, and
+     * readers follow the header whatever this says.
+     */
+    static void setSegmentCompression(bool enabled) noexcept;
+
+    /// @brief Choice set by setSegmentCompression() (off by default).
+    [[nodiscard]] static bool segmentCompression() noexcept;
+
+    /**
+     * @brief Choose the cipher new segmented output is sealed with.
+     *
+     * Process-wide like setKdfParams(); main() sets it from `--cipher`.
+     * Readers follow the header whatever this says.
+     */
+    static void setAead(AeadAlgorithm aead) noexcept;
+
+    /// @brief Choice set by setAead(), else preferredAead().
+    [[nodiscard]] static AeadAlgorithm aead() noexcept;
+
+    /**
+     * @brief The faster cipher on this CPU.
+     *
+     * AES-256-GCM where the CPU has AES and carry-less multiply
+     * instructions (AES-NI and PCLMULQDQ, or the ARMv8 crypto extension)
+     * for OpenSSL to use; ChaCha20-Poly1305 otherwise. Detected once.
+     */
+    [[nodiscard]] static AeadAlgorithm preferredAead() noexcept;
+
+    /// @brief True if the linked OpenSSL provides Argon2id (3.2 or later).
+    [[nodiscard]] static bool argon2Available() noexcept;
+
+    /// @brief Result of calibrateKdf().
+    struct KdfCalibration
+    {
+        KdfParams params;       ///< Chosen parameters.
+        double milliseconds{};  ///< Measured time of one derivation with them.
+    };
+
+    /**
+     * @brief Pick KDF parameters for a target unlock latency on this machine.
+     *
+     * Times real derivations (of a throwaway password) while raising the
+     * cost: for scrypt, $N$ doubles at $r = 8, p = 1$; for Argon2id, the
+     * memory doubles up to @p memoryBudget with one lane per core (at most
+     * cfg::KDF_MAX_LANES), then the pass count grows. Stops at the last
+     * parameters that stay within @p targetMs and @p memoryBudget, never
+     * below the cheapest valid setting.
+     *
+     * @param algorithm    KDF to calibrate.
+     * @param targetMs     Target time of one derivation in milliseconds.
+     * @param memoryBudget Largest working set in bytes (capped at cfg::KDF_MAX_MEMORY).
+     * @return The parameters and their measured time.
+     * @throw std::runtime_error if the KDF is unavailable or fails.
+     */
+    [[nodiscard]] static KdfCalibration calibrateKdf(KdfAlgorithm algorithm,
+                                                     unsigned targetMs,
+                                                     uint64_t memoryBudget);
+
+    /**
+     * @brief Expand a master key into a domain-separated subkey (HKDF-SHA256).
+     *
+     * @param masterKey 32-byte key from deriveMasterKey().
+     * @param info      Context label; distinct labels yield independent keys.
+     * @return 32-byte subkey in locked memory.
+     * @throw std::runtime_error on a bad key length or OpenSSL failure.
+     */
+    [[nodiscard]] static LockedKeyBuffer deriveSubkey(std::span<const unsigned char> masterKey,
+                                                      std::string_view info);
+
+    /**
+     * @brief Encrypt plaintext under an already derived key.
+     *
+     * Packet format: `AAD(4) | IV(12) | Ciphertext(n) | Tag(16)`. A fresh
+     * random IV is drawn per call, so one key may seal up to 2^32 packets.
+     *
+     * @param plaintext Raw bytes to encrypt.
+     * @param key       32-byte AES-256 key.
+     * @return The framed encrypted packet.
+     * @throw std::runtime_error on a bad key length or OpenSSL failure.
+     */
+    [[nodiscard]] static std::vector<unsigned char> encryptWithKey(
+        std::span<const unsigned char> plaintext, std::span<const unsigned char> key);
+
+    /**
+     * @brief Decrypt a packet produced by encryptWithKey().
+     *
+     * @param packet Framed keyed packet.
+     * @param key    32-byte AES-256 key.
+     * @return Decrypted plaintext bytes.
+     * @throw std::runtime_error on authentication failure or malformed packet.
+     */
+    [[nodiscard]] static std::vector<unsigned char> decryptWithKey(
+        std::span<const unsigned char> packet, std::span<const unsigned char> key);
+
+    /// @brief Size of the encryptWithKey() packet for @p plaintextLen bytes.
+    [[nodiscard]] static constexpr size_t keyedPacketSize(size_t plaintextLen) noexcept
+    {
+        return seal::cfg::AAD_LEN + seal::cfg::IV_LEN + plaintextLen + seal::cfg::TAG_LEN;
+    }
+
+    /**
+     * @brief encryptWithKey() into a caller-provided buffer, allocation-free.
+     *
+     * @param plaintext Raw bytes to encrypt.
+     * @param key       32-byte AES-256 key.
+     * @param out       At least `keyedPacketSize(plaintext.size())` bytes.
+     * @return Bytes written.
+     * @throw std::runtime_error on a bad key length, a short @p out, or OpenSSL failure.
+     */
+    static size_t encryptWithKeyInto(std::span<const unsigned char> plaintext,
+                                     std::span<const unsigned char> key,
+                                     std::span<unsigned char> out);
+
+    /**
+     * @brief decryptWithKey() into a caller-provided buffer, allocation-free.
+     *
+     * @param packet Framed keyed packet.
+     * @param key    32-byte AES-256 key.
+     * @param out    At least `packet.size() - keyedPacketSize(0)` bytes; wiped
+     *               if authentication fails.
+     * @return Plaintext bytes written.
+     * @throw std::runtime_error on authentication failure, a malformed
+     *        packet, or a short @p out.
+     */
+    static size_t decryptWithKeyInto(std::span<const unsigned char> packet,
+                                     std::span<const unsigned char> key,
+                                     std::span<unsigned char> out);
+
 private:
     friend class FileOperations;
 
@@ -237,14 +832,45 @@ private:
     /// @brief Get authenticated AAD span.
     static std::span<const unsigned char> aadSpan() noexcept;
 
-    /// @brief Derived key type backed by guard-paged, locked memory.
-    using LockedKeyBuffer = std::vector<unsigned char, locked_allocator<unsigned char>>;
+    /// @brief The AAD a single-shot packet starts with ("seal", or "slp2" and its KDF bytes).
+    /// @throw std::runtime_error if @p packet starts with neither.
+    static std::span<const unsigned char> packetAad(std::span<const unsigned char> packet);
+
+    /// @brief One-shot AEAD seal: `plain.size()` bytes to @p ct, then the tag to @p tag.
+    static void aeadSeal(std::span<const unsigned char> key,
+                         const unsigned char* iv,
+                         std::span<const unsigned char> aad,
+                         std::span<const unsigned char> plain,
+                         unsigned char* ct,
+                         unsigned char* tag,
+                         AeadAlgorithm aead = AeadAlgorithm::Aes256Gcm);
+
+    /// @brief One-shot AEAD open into @p out; wipes @p out and
+    ///        returns `false` if @p tag does not verify.
+    [[nodiscard]] static bool aeadOpen(std::span<const unsigned char> key,
+                                       const unsigned char* iv,
+                                       std::span<const unsigned char> aad,
+                                       std::span<const unsigned char> ct,
+                                       const unsigned char* tag,
+                                       unsigned char* out,
+                                       AeadAlgorithm aead = AeadAlgorithm::Aes256Gcm);
 
     /// @brief Derive AES-256 key via scrypt into locked memory.
     template <secure_password SecurePwd>
     [[nodiscard]] static LockedKeyBuffer deriveKey(const SecurePwd& pwd,
                                                    std::span<const unsigned char> salt);
 
+    /// @brief Derive AES-256 key with the KDF @p kdf names into locked memory.
+    template <secure_password SecurePwd>
+    [[nodiscard]] static LockedKeyBuffer deriveKey(const SecurePwd& pwd,
+                                                   std::span<const unsigned char> salt,
+                                                   const KdfParams& kdf);
+
+    /// @brief Derive the key a segmented header (plain or keyed) was sealed under.
+    template <secure_password SecurePwd>
+    [[nodiscard]] static LockedKeyBuffer deriveSegmentKey(const SecurePwd& pwd,
+                                                          std::span<const unsigned char> header);
+
     template <class CharT, class Traits, class Alloc>
     static void cleanseOne(std::basic_string<CharT, Traits, Alloc>& s) noexcept
     {
@@ -262,13 +888,15 @@ private:
         if (!s.s.empty())
         {
             CharT* base = s.s.data();
-            if (base)
+            if (base && seal::locked_slab::owns(base))
+            {
+                SecureZeroMemory(base, seal::locked_usable(base));
+            }
+            else if (base)
             {
-                auto* hdr = seal::header_from_payload(base);
-                DWORD oldProt{}, dummy{};
-                (void)VirtualProtect(base, hdr->payloadSpan, PAGE_READWRITE, &oldProt);
-                SecureZeroMemory(base, hdr->usable);
-                (void)VirtualProtect(base, hdr->payloadSpan, oldProt, &dummy);
+                // Free unless the payload rests NOACCESS outside any scope.
+                seal::RWGuard<CharT> rw(base);
+                SecureZeroMemory(base, seal::locked_usable(base));
             }
         }
         s.s.clear();
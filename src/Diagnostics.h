@@ -37,6 +37,10 @@ namespace seal
  *      seal::diag::kv("op", op),
  *      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
  * ```
+ *
+ * `SEAL_LOG` in Logging.h spells the same thing in one line. Either way
+ * the fields are only built when the category is enabled; seal::metrics
+ * covers what must be measured whether or not anyone is logging.
  */
 namespace diag
 {
@@ -0,0 +1,222 @@
+#include "DirectoryManifest.h"
+
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace seal
+{
+
+DirectoryManifest::~DirectoryManifest()
+{
+    Cryptography::cleanseString(m_Key);
+}
+
+template <secure_password SecurePwd>
+void DirectoryManifest::open(const std::string& path, const SecurePwd& password)
+{
+    const size_t prefix = seal::cfg::MANIFEST_HDR_LEN + seal::cfg::SALT_LEN;
+    std::vector<unsigned char> blob;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (in)
+        {
+            blob.assign(std::istreambuf_iterator<char>(in), {});
+            if (in.bad())
+                throw std::runtime_error("Cannot read manifest");
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Path = path;
+    m_Entries.clear();
+    Cryptography::cleanseString(m_Key);
+
+    if (blob.empty())
+    {
+        // First run: a fresh salt, kept for every checkpoint of this run.
+        if (RAND_bytes(m_Salt.data(), (int)m_Salt.size()) != 1)
+            throw std::runtime_error("RAND_bytes(manifest salt) failed");
+        auto master = Cryptography::deriveMasterKey(password, m_Salt);
+        m_Key = Cryptography::deriveSubkey(master, KEY_INFO);
+        Cryptography::cleanseString(master);
+        return;
+    }
+
+    if (blob.size() < prefix || !std::equal(blob.begin(),
+                                            blob.begin() + seal::cfg::MANIFEST_HDR_LEN,
+                                            seal::cfg::MANIFEST_HDR))
+    {
+        throw std::runtime_error("Not a seal manifest");
+    }
+    std::copy_n(blob.begin() + seal::cfg::MANIFEST_HDR_LEN, m_Salt.size(), m_Salt.begin());
+    auto master = Cryptography::deriveMasterKey(password, m_Salt);
+    m_Key = Cryptography::deriveSubkey(master, KEY_INFO);
+    Cryptography::cleanseString(master);
+
+    auto body = Cryptography::decryptWithKey(
+        std::span<const unsigned char>(blob).subspan(prefix), m_Key);
+    try
+    {
+        parse(std::string_view(reinterpret_cast<const char*>(body.data()), body.size()));
+    }
+    catch (...)
+    {
+        Cryptography::cleanseString(body);
+        throw;
+    }
+    Cryptography::cleanseString(body);
+}
+
+bool DirectoryManifest::save() const
+{
+    std::vector<unsigned char> file(seal::cfg::MANIFEST_HDR,
+                                    seal::cfg::MANIFEST_HDR + seal::cfg::MANIFEST_HDR_LEN);
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Key.empty())
+            return false;
+        path = m_Path;
+        file.insert(file.end(), m_Salt.begin(), m_Salt.end());
+        auto body = serialize();
+        auto sealed = Cryptography::encryptWithKey(body, m_Key);
+        Cryptography::cleanseString(body);
+        file.insert(file.end(), sealed.begin(), sealed.end());
+    }
+
+    // Same atomic-replace sequence as the file encryptors: write a temp
+    // file, flush it to disk, then rename it over the previous checkpoint.
+    const std::string tmpPath = path + ".tmp";
+    HANDLE h = CreateFileA(tmpPath.c_str(),
+                           GENERIC_WRITE,
+                           0,
+                           nullptr,
+                           CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL,
+                           nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return false;
+    DWORD written = 0;
+    const bool ok = WriteFile(h, file.data(), static_cast<DWORD>(file.size()), &written, nullptr) &&
+                    written == file.size() && FlushFileBuffers(h);
+    CloseHandle(h);
+    if (!ok || !MoveFileExA(tmpPath.c_str(),
+                            path.c_str(),
+                            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileA(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::optional<DirectoryManifest::Entry> DirectoryManifest::find(const std::string& rel) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Entries.find(rel);
+    if (it == m_Entries.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void DirectoryManifest::record(const std::string& rel, Entry entry)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries[rel] = std::move(entry);
+}
+
+void DirectoryManifest::erase(const std::string& rel)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.erase(rel);
+}
+
+std::vector<std::string> DirectoryManifest::paths() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::vector<std::string> out;
+    out.reserve(m_Entries.size());
+    for (const auto& [rel, entry] : m_Entries)
+        out.push_back(rel);
+    return out;
+}
+
+std::size_t DirectoryManifest::size() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Entries.size();
+}
+
+// Caller holds m_Mutex.
+std::vector<unsigned char> DirectoryManifest::serialize() const
+{
+    std::string text;
+    for (const auto& [rel, entry] : m_Entries)
+    {
+        text += entry.hash;
+        text += '\t';
+        text += std::to_string(entry.size);
+        text += '\t';
+        text += std::to_string(entry.writeTime);
+        text += '\t';
+        text += rel;
+        text += '\n';
+    }
+    std::vector<unsigned char> out(text.begin(), text.end());
+    Cryptography::cleanseString(text);
+    return out;
+}
+
+// Caller holds m_Mutex.
+void DirectoryManifest::parse(std::string_view body)
+{
+    auto number = [](std::string_view field)
+    {
+        uint64_t v = 0;
+        auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), v);
+        if (ec != std::errc{} || end != field.data() + field.size())
+            throw std::runtime_error("Malformed manifest");
+        return v;
+    };
+
+    while (!body.empty())
+    {
+        const size_t eol = body.find('\n');
+        if (eol == std::string_view::npos)
+            throw std::runtime_error("Malformed manifest");
+        std::string_view line = body.substr(0, eol);
+        body.remove_prefix(eol + 1);
+
+        std::string_view fields[4];
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const size_t tab = line.find('\t');
+            if (tab == std::string_view::npos)
+                throw std::runtime_error("Malformed manifest");
+            fields[i] = line.substr(0, tab);
+            line.remove_prefix(tab + 1);
+        }
+        fields[3] = line;
+        if (fields[3].empty())
+            throw std::runtime_error("Malformed manifest");
+
+        Entry entry;
+        entry.hash = std::string(fields[0]);
+        entry.size = number(fields[1]);
+        entry.writeTime = number(fields[2]);
+        m_Entries[std::string(fields[3])] = std::move(entry);
+    }
+}
+
+using SecNarrow = seal::secure_string<>;
+using SecWide = seal::basic_secure_string<wchar_t>;
+
+template void DirectoryManifest::open(const std::string&, const SecNarrow&);
+template void DirectoryManifest::open(const std::string&, const SecWide&);
+
+}  // namespace seal
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Cryptography.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace seal
+{
+
+/**
+ * @class DirectoryManifest
+ * @brief Encrypted record of the files an incremental directory sync has sealed.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup IO_FileOperations
+ *
+ * Maps each source path (relative to the synced root) to the size,
+ * last-write time and SHA-256 (FileOperations::hashFile()) it had when it
+ * was last encrypted. FileOperations::syncDirectory() uses it to skip
+ * files that have not changed since the previous run, and saves it every
+ * so often during a run, so an interrupted run resumes where the last
+ * checkpoint left off.
+ *
+ * File format: `"slm1" | salt(16) | encryptWithKey(body)`, where the key
+ * is the HKDF subkey `"seal/manifest/v1"` of the scrypt master key for the
+ * salt. The body is one `hash \t size \t writeTime \t path` line per
+ * entry; Windows file names cannot contain tabs or newlines. open()
+ * derives the key once, so checkpoints cost no further KDF work.
+ *
+ * All members are safe to call from worker threads.
+ *
+ * @see FileOperations::syncDirectory
+ */
+class DirectoryManifest
+{
+public:
+    /// @brief Recorded state of one source file.
+    struct Entry
+    {
+        uint64_t size = 0;
+        uint64_t writeTime = 0;  ///< File time ticks, as `last_write_time()` reports.
+        std::string hash;        ///< Lowercase hex SHA-256 of the contents.
+
+        bool operator==(const Entry&) const = default;
+    };
+
+    DirectoryManifest() = default;
+
+    /// @brief Destructor. Wipes the manifest key.
+    ~DirectoryManifest();
+
+    DirectoryManifest(const DirectoryManifest&) = delete;
+    DirectoryManifest& operator=(const DirectoryManifest&) = delete;
+
+    /**
+     * @brief Load the manifest at @p path, or start an empty one if it does not exist.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param path     Manifest file; later save() calls write here.
+     * @param password Master password.
+     * @throw std::runtime_error if the file exists but is malformed, cannot
+     *        be read, or fails authentication (wrong password or tampering).
+     */
+    template <secure_password SecurePwd>
+    void open(const std::string& path, const SecurePwd& password);
+
+    /**
+     * @brief Write the entries to the path given to open().
+     *
+     * Writes `path.tmp`, flushes it and renames it over the old manifest,
+     * so a crash leaves either the previous checkpoint or this one.
+     *
+     * @return `false` on I/O failure (the previous manifest is kept).
+     */
+    bool save() const;
+
+    /// @brief Recorded state of @p rel, if any.
+    [[nodiscard]] std::optional<Entry> find(const std::string& rel) const;
+
+    /// @brief Record (or replace) the state of @p rel.
+    void record(const std::string& rel, Entry entry);
+
+    /// @brief Drop @p rel.
+    void erase(const std::string& rel);
+
+    /// @brief Every recorded path, in sorted order.
+    [[nodiscard]] std::vector<std::string> paths() const;
+
+    /// @brief Number of recorded paths.
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    static constexpr std::string_view KEY_INFO = "seal/manifest/v1";
+
+    [[nodiscard]] std::vector<unsigned char> serialize() const;
+    void parse(std::string_view body);
+
+    std::string m_Path;
+    std::array<unsigned char, seal::cfg::SALT_LEN> m_Salt{};
+    Cryptography::LockedKeyBuffer m_Key;
+    mutable std::mutex m_Mutex;  ///< Guards m_Entries.
+    std::map<std::string, Entry> m_Entries;
+};
+
+}  // namespace seal
@@ -0,0 +1,155 @@
+#include "FileKeyring.h"
+
+#include <openssl/rand.h>
+
+#include <algorithm>
+
+namespace seal
+{
+
+FileKeyring::FileKeyring()
+    : m_Kdf(Cryptography::kdfParams())
+{
+    if (RAND_bytes(m_Salt.data(), (int)m_Salt.size()) != 1)
+        throw std::runtime_error("RAND_bytes(batch salt) failed");
+}
+
+FileKeyring::~FileKeyring()
+{
+    clear();
+}
+
+template <secure_password SecurePwd>
+Cryptography::LockedKeyBuffer FileKeyring::fileKey(const SecurePwd& password,
+                                                   std::span<const unsigned char> header)
+{
+    if (header.size() < Cryptography::segmentHeaderSize(header))
+        throw std::runtime_error("Ciphertext too short");
+    (void)Cryptography::segmentSize(header);
+    auto salt = header.subspan(seal::cfg::SEGMENT_HDR_LEN, seal::cfg::SALT_LEN);
+    const KdfParams kdf = Cryptography::segmentKdf(header);
+    if (!Cryptography::isKeyedSegmentPacket(header))
+        return Cryptography::deriveMasterKey(password, salt, kdf);
+
+    auto master = masterKey(password, salt, kdf);
+    try
+    {
+        auto key = Cryptography::segmentFileKey(master, header);
+        Cryptography::cleanseString(master);
+        return key;
+    }
+    catch (...)
+    {
+        Cryptography::cleanseString(master);
+        throw;
+    }
+}
+
+template <secure_password SecurePwd>
+Cryptography::LockedKeyBuffer FileKeyring::masterKey(const SecurePwd& password,
+                                                     std::span<const unsigned char> salt,
+                                                     const KdfParams& kdf)
+{
+    Cryptography::LockedKeyBuffer key;
+    if (lookup(salt, kdf, key))
+        return key;
+
+    // Re-check under the derive lock: another worker may have finished the
+    // same salt while this one waited.
+    std::lock_guard<std::mutex> derive(m_DeriveMutex);
+    if (lookup(salt, kdf, key))
+        return key;
+    key = Cryptography::deriveMasterKey(password, salt, kdf);
+    store(salt, kdf, key);
+    return key;
+}
+
+bool FileKeyring::lookup(std::span<const unsigned char> salt,
+                         const KdfParams& kdf,
+                         Cryptography::LockedKeyBuffer& key) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = std::find_if(m_Entries.begin(),
+                           m_Entries.end(),
+                           [&](const Entry& entry)
+                           {
+                               return entry.kdf == kdf &&
+                                      std::equal(entry.salt.begin(),
+                                                 entry.salt.end(),
+                                                 salt.begin(),
+                                                 salt.end());
+                           });
+    if (it == m_Entries.end())
+        return false;
+
+    // Decrypt a copy so the cached entry never leaves DPAPI protection.
+    Cryptography::LockedKeyBuffer copy(it->key.begin(), it->key.end());
+    if (!CryptUnprotectMemory(
+            copy.data(), static_cast<DWORD>(copy.size()), CRYPTPROTECTMEMORY_SAME_PROCESS))
+    {
+        Cryptography::cleanseString(copy);
+        return false;
+    }
+    Cryptography::cleanseString(key);
+    key = std::move(copy);
+    return true;
+}
+
+void FileKeyring::store(std::span<const unsigned char> salt,
+                        const KdfParams& kdf,
+                        std::span<const unsigned char> key)
+{
+    if (salt.size() != seal::cfg::SALT_LEN || key.size() != seal::cfg::KEY_LEN)
+        return;
+
+    Entry entry;
+    std::copy_n(salt.begin(), entry.salt.size(), entry.salt.begin());
+    entry.kdf = kdf;
+    entry.key.assign(key.begin(), key.end());
+    // The cache is only an accelerator: without DPAPI, drop the key rather
+    // than hold it in the clear for the rest of the batch.
+    if (!CryptProtectMemory(entry.key.data(),
+                            static_cast<DWORD>(entry.key.size()),
+                            CRYPTPROTECTMEMORY_SAME_PROCESS))
+    {
+        Cryptography::cleanseString(entry.key);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Entries.size() >= MAX_ENTRIES)
+    {
+        Cryptography::cleanseString(entry.key);
+        return;
+    }
+    m_Entries.push_back(std::move(entry));
+}
+
+std::size_t FileKeyring::size() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Entries.size();
+}
+
+void FileKeyring::clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto& entry : m_Entries)
+        Cryptography::cleanseString(entry.key);
+    m_Entries.clear();
+}
+
+// Explicit template instantiations for both narrow (char/UTF-8) and wide
+// (wchar_t/UTF-16) password types.
+template Cryptography::LockedKeyBuffer FileKeyring::fileKey(const secure_string<>&,
+                                                            std::span<const unsigned char>);
+template Cryptography::LockedKeyBuffer FileKeyring::fileKey(const basic_secure_string<wchar_t>&,
+                                                            std::span<const unsigned char>);
+template Cryptography::LockedKeyBuffer FileKeyring::masterKey(const secure_string<>&,
+                                                              std::span<const unsigned char>,
+                                                              const KdfParams&);
+template Cryptography::LockedKeyBuffer FileKeyring::masterKey(const basic_secure_string<wchar_t>&,
+                                                              std::span<const unsigned char>,
+                                                              const KdfParams&);
+
+}  // namespace seal
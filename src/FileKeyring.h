@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Cryptography.h"
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace seal
+{
+
+/**
+ * @class FileKeyring
+ * @brief Shared scrypt results for encrypting or decrypting a batch of files.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Crypto
+ *
+ * A keyring draws one random batch salt and takes the process KDF
+ * parameters (Cryptography::kdfParams()) for the batch. Files encrypted
+ * through it get a keyed segmented header (Cryptography::makeSegmentHeader()
+ * with `keyed = true`) and are sealed under Cryptography::segmentFileKey():
+ * the HKDF expansion, by a per-file nonce, of the master key for the batch
+ * salt. That way a directory of ten thousand small files pays for the KDF
+ * once instead of ten thousand times. Every file still carries the salt,
+ * its KDF parameters and its nonce, so it decrypts on its own with only
+ * the password.
+ *
+ * On the way back the keyring caches the master key of each salt and
+ * parameter set it meets (up to a small bound), so decrypting a batch also
+ * runs the KDF once. Cached keys stay DPAPI-encrypted (CryptProtectMemory,
+ * same-process scope) like VaultKeyCache entries, and KDF runs are
+ * serialised so parallel workers never derive the same salt twice.
+ *
+ * A keyring is only valid for the one password it is used with; the owner
+ * keeps it scoped to a single batch. All members are safe to call from
+ * worker threads.
+ *
+ * @see FileOperations::processDirectory, seal::encryptDirectory
+ */
+class FileKeyring
+{
+public:
+    /// @brief Draw a fresh batch salt and take the current Cryptography::kdfParams().
+    /// @throw std::runtime_error on RNG failure.
+    FileKeyring();
+
+    /// @brief Destructor. Wipes every cached key.
+    ~FileKeyring();
+
+    FileKeyring(const FileKeyring&) = delete;
+    FileKeyring& operator=(const FileKeyring&) = delete;
+
+    /// @brief Salt that files encrypted through this keyring are written with.
+    [[nodiscard]] std::span<const unsigned char> salt() const { return m_Salt; }
+
+    /// @brief KDF parameters files encrypted through this keyring are written with.
+    [[nodiscard]] const KdfParams& kdf() const { return m_Kdf; }
+
+    /**
+     * @brief Key a segmented header was (or will be) sealed under.
+     *
+     * Keyed headers go through the master-key cache; plain segmented
+     * headers carry a per-file salt and get a full KDF run as before.
+     * Either way the header's own KDF parameters (Cryptography::segmentKdf())
+     * are used, not kdf().
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param password Master password.
+     * @param header   Segmented header (plain or keyed).
+     * @return 32-byte key in locked memory.
+     * @throw std::runtime_error on a malformed header or KDF failure.
+     */
+    template <secure_password SecurePwd>
+    [[nodiscard]] Cryptography::LockedKeyBuffer fileKey(const SecurePwd& password,
+                                                       std::span<const unsigned char> header);
+
+    /**
+     * @brief Master key of the keyring's own salt(), for Cryptography::sealKeyedPacket().
+     *
+     * Goes through the same cache as fileKey(), so sealing and later
+     * opening packets of this keyring derive the salt once between them.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param password Master password.
+     * @return 32-byte key in locked memory.
+     * @throw std::runtime_error on KDF failure.
+     */
+    template <secure_password SecurePwd>
+    [[nodiscard]] Cryptography::LockedKeyBuffer batchKey(const SecurePwd& password)
+    {
+        return masterKey(password, m_Salt, m_Kdf);
+    }
+
+    /// @brief Number of cached master keys.
+    [[nodiscard]] std::size_t size() const;
+
+    /// @brief Wipe and drop every cached key.
+    void clear();
+
+private:
+    static constexpr std::size_t MAX_ENTRIES = 16;  ///< Further salts are derived uncached.
+
+    struct Entry
+    {
+        std::array<unsigned char, seal::cfg::SALT_LEN> salt{};
+        KdfParams kdf;
+        Cryptography::LockedKeyBuffer key;  ///< DPAPI-protected while cached.
+    };
+
+    template <secure_password SecurePwd>
+    Cryptography::LockedKeyBuffer masterKey(const SecurePwd& password,
+                                            std::span<const unsigned char> salt,
+                                            const KdfParams& kdf);
+    bool lookup(std::span<const unsigned char> salt,
+                const KdfParams& kdf,
+                Cryptography::LockedKeyBuffer& key) const;
+    void store(std::span<const unsigned char> salt,
+               const KdfParams& kdf,
+               std::span<const unsigned char> key);
+
+    std::array<unsigned char, seal::cfg::SALT_LEN> m_Salt{};
+    KdfParams m_Kdf;
+    mutable std::mutex m_Mutex;  ///< Guards m_Entries.
+    std::mutex m_DeriveMutex;    ///< Held across the KDF so each salt is derived once.
+    std::vector<Entry> m_Entries;
+};
+
+}  // namespace seal
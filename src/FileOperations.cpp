@@ -1,23 +1,40 @@
 #include "FileOperations.h"
 
 #include "Clipboard.h"
+#include "Compression.h"
 #include "Console.h"
+#include "DirectoryManifest.h"
+#include "FileKeyring.h"
 #include "Utils.h"
 
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 
+#include <windows.h>
+#include <winioctl.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
+#include <charconv>
 #include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <functional>
-#include <future>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <set>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace
 {
@@ -41,6 +58,346 @@ bool flushFileToDisk(const std::string& path)
     return ok != 0;
 }
 
+// ReadFile until `size` bytes have arrived or the handle reaches end of
+// input. Pipes report their end as ERROR_BROKEN_PIPE rather than a zero read.
+bool readHandle(HANDLE h, unsigned char* buf, size_t size, size_t& got)
+{
+    got = 0;
+    while (got < size)
+    {
+        DWORD n = 0;
+        if (!ReadFile(h, buf + got, static_cast<DWORD>(size - got), &n, nullptr))
+            return GetLastError() == ERROR_BROKEN_PIPE;
+        if (n == 0)
+            return true;
+        got += n;
+    }
+    return true;
+}
+
+bool writeHandle(HANDLE h, const unsigned char* buf, size_t size)
+{
+    while (size > 0)
+    {
+        DWORD n = 0;
+        if (!WriteFile(h, buf, static_cast<DWORD>(size), &n, nullptr) || n == 0)
+            return false;
+        buf += n;
+        size -= n;
+    }
+    return true;
+}
+
+// One overlapped request. The OVERLAPPED block and its event must not move
+// while the request is in flight, so ops live inside their owner.
+struct AsyncOp
+{
+    AsyncOp() { ov.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr); }
+    ~AsyncOp()
+    {
+        if (ov.hEvent)
+            CloseHandle(ov.hEvent);
+    }
+    AsyncOp(const AsyncOp&) = delete;
+    AsyncOp& operator=(const AsyncOp&) = delete;
+
+    OVERLAPPED ov{};
+    bool pending = false;
+    bool atEnd = false;  // read rejected synchronously with ERROR_HANDLE_EOF
+};
+
+// File handle opened for overlapped I/O at explicit offsets, so reads,
+// encryption and writes can all be in flight at once. Opened `unbuffered`,
+// it bypasses the system cache (FILE_FLAG_NO_BUFFERING) when the volume's
+// sector size divides a page; offsets, sizes and buffers must then be
+// sector-aligned. Volumes that cannot satisfy that get cached I/O instead.
+// Every begun request must be finish()ed before its buffer is released.
+class OverlappedFile
+{
+public:
+    OverlappedFile() = default;
+    ~OverlappedFile() { close(); }
+    OverlappedFile(const OverlappedFile&) = delete;
+    OverlappedFile& operator=(const OverlappedFile&) = delete;
+
+    bool openRead(const std::string& path, bool unbuffered)
+    {
+        return open(path,
+                    GENERIC_READ,
+                    FILE_SHARE_READ | FILE_SHARE_WRITE,
+                    OPEN_EXISTING,
+                    FILE_FLAG_SEQUENTIAL_SCAN,
+                    unbuffered);
+    }
+
+    bool create(const std::string& path, bool unbuffered)
+    {
+        return open(path, GENERIC_WRITE, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, unbuffered);
+    }
+
+    // Existing file opened for overwriting in place, write-through.
+    bool openOverwrite(const std::string& path, bool unbuffered)
+    {
+        return open(path, GENERIC_WRITE, 0, OPEN_EXISTING, FILE_FLAG_WRITE_THROUGH, unbuffered);
+    }
+
+    // Sector size when the cache is bypassed, 0 for cached I/O.
+    DWORD sectorSize() const { return m_Sector; }
+
+    bool size(uint64_t& out) const
+    {
+        LARGE_INTEGER li{};
+        if (!GetFileSizeEx(m_Handle, &li))
+            return false;
+        out = static_cast<uint64_t>(li.QuadPart);
+        return true;
+    }
+
+    bool beginRead(AsyncOp& op, uint64_t offset, void* buf, size_t size)
+    {
+        return begin(op, offset, [&](OVERLAPPED* ov)
+                     { return ReadFile(m_Handle, buf, static_cast<DWORD>(size), nullptr, ov); });
+    }
+
+    bool beginWrite(AsyncOp& op, uint64_t offset, const void* buf, size_t size)
+    {
+        return begin(op, offset, [&](OVERLAPPED* ov)
+                     { return WriteFile(m_Handle, buf, static_cast<DWORD>(size), nullptr, ov); });
+    }
+
+    // Wait for @p op. Reads at or past end of file complete with 0 bytes.
+    bool finish(AsyncOp& op, size_t& transferred)
+    {
+        transferred = 0;
+        if (!op.pending)
+            return false;
+        op.pending = false;
+        if (op.atEnd)
+            return true;
+        DWORD n = 0;
+        if (!GetOverlappedResult(m_Handle, &op.ov, &n, TRUE))
+            return GetLastError() == ERROR_HANDLE_EOF;
+        transferred = n;
+        return true;
+    }
+
+    // Abort outstanding requests after a failure; they still need finish().
+    void cancel()
+    {
+        if (m_Handle != INVALID_HANDLE_VALUE)
+            CancelIoEx(m_Handle, nullptr);
+    }
+
+    bool flush() { return FlushFileBuffers(m_Handle) != 0; }
+
+    // Tell the filesystem the first @p size bytes no longer hold data, so
+    // the SSD below can erase them (FSCTL_FILE_LEVEL_TRIM). Fails on
+    // volumes without TRIM support.
+    bool trim(uint64_t size)
+    {
+        FILE_LEVEL_TRIM request{};
+        request.NumRanges = 1;
+        request.Ranges[0].Offset = 0;
+        request.Ranges[0].Length = size;
+        AsyncOp op;
+        if (!op.ov.hEvent)
+            return false;
+        if (!DeviceIoControl(m_Handle,
+                             FSCTL_FILE_LEVEL_TRIM,
+                             &request,
+                             sizeof(request),
+                             nullptr,
+                             0,
+                             nullptr,
+                             &op.ov) &&
+            GetLastError() != ERROR_IO_PENDING)
+            return false;
+        DWORD n = 0;
+        return GetOverlappedResult(m_Handle, &op.ov, &n, TRUE) != 0;
+    }
+
+    // Set the end of file, trimming the sector padding of unbuffered writes.
+    bool truncate(uint64_t size)
+    {
+        FILE_END_OF_FILE_INFO info{};
+        info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+        return SetFileInformationByHandle(m_Handle, FileEndOfFileInfo, &info, sizeof(info)) != 0;
+    }
+
+    void close()
+    {
+        if (m_Handle != INVALID_HANDLE_VALUE)
+            CloseHandle(m_Handle);
+        m_Handle = INVALID_HANDLE_VALUE;
+        m_Sector = 0;
+    }
+
+private:
+    static constexpr DWORD PAGE = 4096;
+
+    bool open(const std::string& path,
+              DWORD access,
+              DWORD share,
+              DWORD disposition,
+              DWORD flags,
+              bool unbuffered)
+    {
+        close();
+        flags |= FILE_FLAG_OVERLAPPED;
+        if (unbuffered)
+        {
+            m_Handle = CreateFileA(path.c_str(),
+                                   access,
+                                   share,
+                                   nullptr,
+                                   disposition,
+                                   flags | FILE_FLAG_NO_BUFFERING,
+                                   nullptr);
+            if (m_Handle != INVALID_HANDLE_VALUE)
+            {
+                FILE_STORAGE_INFO info{};
+                if (GetFileInformationByHandleEx(m_Handle, FileStorageInfo, &info, sizeof(info)))
+                {
+                    m_Sector = std::max(info.LogicalBytesPerSector,
+                                        info.PhysicalBytesPerSectorForPerformance);
+                }
+                if (m_Sector != 0 && PAGE % m_Sector == 0)
+                    return true;
+                close();
+            }
+        }
+        m_Handle = CreateFileA(path.c_str(), access, share, nullptr, disposition, flags, nullptr);
+        return m_Handle != INVALID_HANDLE_VALUE;
+    }
+
+    template <class Issue>
+    bool begin(AsyncOp& op, uint64_t offset, const Issue& issue)
+    {
+        if (op.pending || !op.ov.hEvent)
+            return false;
+        HANDLE event = op.ov.hEvent;
+        op.ov = OVERLAPPED{};
+        op.ov.hEvent = event;
+        op.ov.Offset = static_cast<DWORD>(offset);
+        op.ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        op.atEnd = false;
+        // Immediate completion still signals the event, so finish() treats
+        // it like a queued request.
+        if (!issue(&op.ov))
+        {
+            const DWORD err = GetLastError();
+            if (err == ERROR_HANDLE_EOF)
+                op.atEnd = true;
+            else if (err != ERROR_IO_PENDING)
+                return false;
+        }
+        op.pending = true;
+        return true;
+    }
+
+    HANDLE m_Handle = INVALID_HANDLE_VALUE;
+    DWORD m_Sector = 0;
+};
+
+// Blocking read of exactly @p size bytes at @p offset.
+void readExact(OverlappedFile& in, uint64_t offset, unsigned char* buf, size_t size)
+{
+    AsyncOp op;
+    size_t got = 0;
+    if (size > 0 && (!in.beginRead(op, offset, buf, size) || !in.finish(op, got) || got != size))
+        throw std::runtime_error("Read error");
+}
+
+// Read and authenticate the segment table at the end of a compressed
+// segmented file. Throws like Cryptography::openSegmentTable().
+seal::Cryptography::SegmentTable readSegmentTable(OverlappedFile& in,
+                                                  uint64_t fileSize,
+                                                  std::span<const unsigned char> key,
+                                                  std::span<const unsigned char> header)
+{
+    const uint64_t bodyLen = fileSize - header.size();
+    if (fileSize < header.size() + seal::cfg::SEGMENT_TABLE_TRAILER_LEN)
+        throw std::runtime_error("Truncated or malformed file");
+    std::array<unsigned char, seal::cfg::SEGMENT_TABLE_TRAILER_LEN> trailer{};
+    readExact(in, fileSize - trailer.size(), trailer.data(), trailer.size());
+    const size_t tableLen = seal::Cryptography::segmentTableSize(trailer, bodyLen);
+    const uint64_t dataLen = bodyLen - trailer.size() - tableLen;
+    std::vector<unsigned char> sealed(tableLen);
+    readExact(in, header.size() + dataLen, sealed.data(), sealed.size());
+    return seal::Cryptography::openSegmentTable(key, header, sealed, dataLen);
+}
+
+// Ciphertext staging for streamDecrypt when stdin is a pipe and cannot be
+// re-read after the tag check, and for large packDirectory members sealed
+// off the archive lock. Kept in memory up to cfg::FILE_CHUNK, then moved
+// to a delete-on-close temp file. Only ciphertext passes through it.
+class CiphertextSpool
+{
+public:
+    CiphertextSpool() = default;
+    CiphertextSpool(const CiphertextSpool&) = delete;
+    CiphertextSpool& operator=(const CiphertextSpool&) = delete;
+    ~CiphertextSpool()
+    {
+        if (m_File != INVALID_HANDLE_VALUE)
+            CloseHandle(m_File);
+    }
+
+    bool append(const unsigned char* data, size_t size)
+    {
+        if (m_File == INVALID_HANDLE_VALUE)
+        {
+            if (m_Memory.size() + size <= seal::cfg::FILE_CHUNK)
+            {
+                m_Memory.insert(m_Memory.end(), data, data + size);
+                return true;
+            }
+            char dir[MAX_PATH + 1]{};
+            char name[MAX_PATH + 1]{};
+            if (GetTempPathA(sizeof(dir), dir) == 0 || GetTempFileNameA(dir, "sea", 0, name) == 0)
+                return false;
+            m_File = CreateFileA(name,
+                                 GENERIC_READ | GENERIC_WRITE,
+                                 0,
+                                 nullptr,
+                                 CREATE_ALWAYS,
+                                 FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                                 nullptr);
+            if (m_File == INVALID_HANDLE_VALUE)
+                return false;
+            if (!writeHandle(m_File, m_Memory.data(), m_Memory.size()))
+                return false;
+            m_Memory.clear();
+            m_Memory.shrink_to_fit();
+        }
+        return writeHandle(m_File, data, size);
+    }
+
+    bool rewind()
+    {
+        m_ReadPos = 0;
+        if (m_File == INVALID_HANDLE_VALUE)
+            return true;
+        LARGE_INTEGER zero{};
+        return SetFilePointerEx(m_File, zero, nullptr, FILE_BEGIN) != 0;
+    }
+
+    bool read(unsigned char* buf, size_t size, size_t& got)
+    {
+        if (m_File != INVALID_HANDLE_VALUE)
+            return readHandle(m_File, buf, size, got);
+        got = std::min(size, m_Memory.size() - m_ReadPos);
+        std::memcpy(buf, m_Memory.data() + m_ReadPos, got);
+        m_ReadPos += got;
+        return true;
+    }
+
+private:
+    std::vector<unsigned char> m_Memory;
+    size_t m_ReadPos = 0;
+    HANDLE m_File = INVALID_HANDLE_VALUE;
+};
+
 }  // namespace
 
 namespace seal
@@ -77,16 +434,20 @@ std::string FileOperations::tripleToUtf8(const seal::secure_triplet16_t& t)
 template <secure_password SecurePwd>
 bool FileOperations::encryptFileTo(const std::string& srcPath,
                                    const std::string& dstPath,
-                                   const SecurePwd& pwd)
+                                   const SecurePwd& pwd,
+                                   unsigned threads,
+                                   FileKeyring* keyring)
 {
     // Use streaming path for files larger than FILE_CHUNK to avoid
-    // loading the entire file into memory.
+    // loading the entire file into memory. Batch files always take it:
+    // only the segmented format has a keyed variant, and a compressed one.
     {
         std::error_code ec;
         auto fileSize = std::filesystem::file_size(srcPath, ec);
-        if (!ec && fileSize > seal::cfg::FILE_CHUNK)
+        if (keyring || seal::Cryptography::segmentCompression() ||
+            (!ec && fileSize > seal::cfg::FILE_CHUNK))
         {
-            return encryptFileStreaming(srcPath, dstPath, pwd);
+            return encryptFileStreaming(srcPath, dstPath, pwd, threads, keyring);
         }
     }
 
@@ -137,18 +498,24 @@ bool FileOperations::encryptFileTo(const std::string& srcPath,
 template <secure_password SecurePwd>
 bool FileOperations::decryptFileTo(const std::string& srcPath,
                                    const std::string& dstPath,
-                                   const SecurePwd& pwd)
+                                   const SecurePwd& pwd,
+                                   unsigned threads,
+                                   FileKeyring* keyring)
 {
     // Use streaming path for files larger than FILE_CHUNK + framing overhead
     // to avoid loading the entire file into memory.
     {
-        constexpr size_t kFramingOverhead =
-            seal::cfg::AAD_LEN + seal::cfg::SALT_LEN + seal::cfg::IV_LEN + seal::cfg::TAG_LEN;
+        // The larger of the two single-shot AADs: a KDF-tagged packet
+        // carries its parameters after the magic.
+        constexpr size_t kFramingOverhead = std::max(seal::cfg::AAD_LEN,
+                                                     seal::cfg::PACKET_KDF_AAD_LEN) +
+                                            seal::cfg::SALT_LEN + seal::cfg::IV_LEN +
+                                            seal::cfg::TAG_LEN;
         std::error_code ec;
         auto fileSize = std::filesystem::file_size(srcPath, ec);
         if (!ec && fileSize > seal::cfg::FILE_CHUNK + kFramingOverhead)
         {
-            return decryptFileStreaming(srcPath, dstPath, pwd);
+            return decryptFileStreaming(srcPath, dstPath, pwd, threads, keyring);
         }
     }
 
@@ -160,6 +527,9 @@ bool FileOperations::decryptFileTo(const std::string& srcPath,
     }
     std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)), {});
     in.close();
+    // Small files of a batch still go through the keyring's cached key.
+    if (keyring && seal::Cryptography::isKeyedSegmentPacket(blob))
+        return decryptSegmentedFile(srcPath, dstPath, pwd, threads, keyring);
     try
     {
         auto plain = seal::Cryptography::decryptPacket(std::span<const unsigned char>(blob), pwd);
@@ -216,15 +586,22 @@ std::string FileOperations::encryptLine(const std::string& s, const SecurePwd& p
 }
 
 // Reverse of encryptLine: hex string -> raw ciphertext bytes -> decrypt -> plaintext.
-// Spaces are stripped first so the user can paste hex with whitespace formatting.
+// Spaces are stripped first so the user can paste hex with whitespace formatting;
+// tokens from utils::findHexTokens() have none and are decoded in place.
 template <secure_password SecurePwd>
 seal::secure_string<seal::locked_allocator<char>> FileOperations::decryptLine(
-    const std::string& rawHex, const SecurePwd& pwd)
+    std::string_view rawHex, const SecurePwd& pwd)
 {
-    std::string compact = seal::utils::stripSpaces(rawHex);
+    std::string compact;
+    std::string_view hex = rawHex;
+    if (hex.find_first_of(" \t\n\v\f\r") != std::string_view::npos)
+    {
+        compact = seal::utils::stripSpaces(hex);
+        hex = compact;
+    }
     std::vector<unsigned char> blob;
     // Decode hex back to the raw ciphertext bytes that encryptLine produced.
-    if (!seal::utils::from_hex(std::string_view{compact}, blob))
+    if (!seal::utils::from_hex(hex, blob))
         throw std::runtime_error("Invalid hex input");
     auto bytes = seal::Cryptography::decryptPacket(std::span<const unsigned char>(blob), pwd);
     // Move decrypted bytes into a locked-allocator string (non-pageable memory).
@@ -310,132 +687,301 @@ bool FileOperations::parseTriples(std::string_view plain,
 namespace
 {
 
-// Fixed-size worker pool for processDirectory.  Replaces the previous
-// semaphore + std::async pattern which created an unbounded number of
-// OS threads (one per std::async call) even though only 16 could run
-// concurrently.  Deep directory trees could exhaust the thread quota.
-// This pool creates exactly N workers and uses a bounded queue so
-// Submit() blocks when there is too much outstanding work.
-class WorkPool
+// Work-stealing scheduler for processDirectory.  Each worker owns a deque:
+// tasks it spawns go on the back and it pops from the back (depth-first,
+// cache-warm), while idle workers steal from the front of other deques
+// (breadth-first, so big subtrees spread out).  Tasks never block on
+// other tasks; completion is tracked with counters instead of futures,
+// so a deep tree cannot fill every worker with parents waiting on
+// children.  Threads outside the pool that need a result call runUntil(),
+// which helps drain the deques instead of sleeping on a future.  Tasks
+// spawned as leaves never wait themselves, so a task that must wait inside
+// another can ask runUntil() for leaves only and stay at a bounded depth.
+class WorkStealingScheduler
 {
 public:
-    explicit WorkPool(unsigned nWorkers)
+    using Task = std::function<void()>;
+
+    explicit WorkStealingScheduler(unsigned nWorkers) : m_Queues(nWorkers)
     {
         for (unsigned i = 0; i < nWorkers; ++i)
         {
-            m_Workers.emplace_back([this](std::stop_token stop) { WorkerLoop(stop); });
+            m_Workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingScheduler()
+    {
+        {
+            std::lock_guard lk(m_Mutex);
+            m_Stopped = true;
+        }
+        m_Wake.notify_all();
+        // m_Workers is declared last, so the jthreads join before the
+        // deques they read are destroyed.
+    }
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    // Queue a task.  From a worker it lands on that worker's own deque;
+    // from any other thread the deques are filled round-robin.  A @p leaf
+    // task promises never to call runUntil() itself.
+    void spawn(Task task, bool leaf = false)
+    {
+        const size_t q = (t_Owner == this) ? t_Index
+                                           : m_NextQueue.fetch_add(1, std::memory_order_relaxed) %
+                                                 m_Queues.size();
+        {
+            std::lock_guard lk(m_Queues[q].mutex);
+            m_Queues[q].tasks.push_back({std::move(task), leaf});
         }
+        if (leaf)
+            m_QueuedLeaves.fetch_add(1, std::memory_order_release);
+        m_Queued.fetch_add(1, std::memory_order_release);
+        wake(false);
     }
 
-    std::future<bool> Submit(std::function<bool()> fn)
+    // Run queued tasks on the calling thread until @p done returns true.
+    // Safe to call from inside a task: the caller keeps working instead
+    // of holding a worker hostage.  With @p leavesOnly only leaf tasks are
+    // run, so the calling frame is the deepest one that can wait.
+    template <class Done>
+    void runUntil(const Done& done, bool leavesOnly = false)
     {
-        std::packaged_task<bool()> task(std::move(fn));
-        auto fut = task.get_future();
+        const size_t self = (t_Owner == this) ? t_Index : NO_QUEUE;
+        const std::atomic<size_t>& runnable = leavesOnly ? m_QueuedLeaves : m_Queued;
+        while (!done())
         {
+            if (runOne(self, leavesOnly))
+                continue;
             std::unique_lock lk(m_Mutex);
-            m_SpaceAvailable.wait(lk, [this] { return m_Tasks.size() < MAX_QUEUED || m_Stopped; });
+            if (leavesOnly)
+                ++m_LeafWaiters;
+            m_Wake.wait(lk,
+                        [&]
+                        {
+                            return m_Stopped || done() ||
+                                   runnable.load(std::memory_order_acquire) > 0;
+                        });
+            if (leavesOnly)
+                --m_LeafWaiters;
             if (m_Stopped)
-            {
-                return fut;
-            }
-            m_Tasks.push(std::move(task));
+                return;
         }
-        m_TaskAvailable.notify_one();
-        return fut;
     }
 
-    ~WorkPool()
+    // Wake every waiter so runUntil() re-checks its predicate.
+    void notifyAll() { wake(true); }
+
+private:
+    static constexpr size_t NO_QUEUE = static_cast<size_t>(-1);
+
+    struct Job
+    {
+        Task run;
+        bool leaf = false;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> tasks;
+    };
+
+    void wake(bool all)
     {
+        // Taking the mutex orders the counter update before a waiter's
+        // predicate check, so a notify cannot slip in between.  A
+        // leaves-only waiter could swallow a single notify it cannot act
+        // on, so everyone is woken while one is parked.
         {
             std::lock_guard lk(m_Mutex);
-            m_Stopped = true;
+            all = all || m_LeafWaiters > 0;
+        }
+        if (all)
+            m_Wake.notify_all();
+        else
+            m_Wake.notify_one();
+    }
+
+    bool tryPop(size_t q, bool back, bool leavesOnly, Job& out)
+    {
+        std::lock_guard lk(m_Queues[q].mutex);
+        auto& tasks = m_Queues[q].tasks;
+        if (tasks.empty())
+            return false;
+        if (leavesOnly)
+        {
+            // Nearest leaf from the requested end; the deque stays in order.
+            auto isLeaf = [](const Job& job) { return job.leaf; };
+            auto it = back ? std::find_if(tasks.rbegin(), tasks.rend(), isLeaf).base()
+                           : std::find_if(tasks.begin(), tasks.end(), isLeaf);
+            if (back ? it == tasks.begin() : it == tasks.end())
+                return false;
+            if (back)
+                --it;
+            out = std::move(*it);
+            tasks.erase(it);
+        }
+        else if (back)
+        {
+            out = std::move(tasks.back());
+            tasks.pop_back();
+        }
+        else
+        {
+            out = std::move(tasks.front());
+            tasks.pop_front();
         }
-        m_TaskAvailable.notify_all();
-        m_SpaceAvailable.notify_all();
-        // jthread destructors request stop and join automatically.
+        return true;
     }
 
-    WorkPool(const WorkPool&) = delete;
-    WorkPool& operator=(const WorkPool&) = delete;
+    bool runOne(size_t self, bool leavesOnly = false)
+    {
+        Job job;
+        bool found = self != NO_QUEUE && tryPop(self, true, leavesOnly, job);
+        const size_t n = m_Queues.size();
+        const size_t start = (self == NO_QUEUE) ? 0 : self + 1;
+        for (size_t k = 0; !found && k < n; ++k)
+        {
+            const size_t victim = (start + k) % n;
+            if (victim != self)
+                found = tryPop(victim, false, leavesOnly, job);
+        }
+        if (!found)
+            return false;
+        if (job.leaf)
+            m_QueuedLeaves.fetch_sub(1, std::memory_order_acq_rel);
+        m_Queued.fetch_sub(1, std::memory_order_acq_rel);
+        job.run();
+        return true;
+    }
 
-private:
-    void WorkerLoop(std::stop_token stop)
+    void workerLoop(size_t index)
     {
-        while (!stop.stop_requested())
+        t_Owner = this;
+        t_Index = index;
+        for (;;)
         {
-            std::packaged_task<bool()> task;
-            {
-                std::unique_lock lk(m_Mutex);
-                m_TaskAvailable.wait(lk, [this] { return m_Stopped || !m_Tasks.empty(); });
-                if (m_Stopped && m_Tasks.empty())
-                {
-                    return;
-                }
-                task = std::move(m_Tasks.front());
-                m_Tasks.pop();
-            }
-            m_SpaceAvailable.notify_one();
-            task();
+            if (runOne(index))
+                continue;
+            std::unique_lock lk(m_Mutex);
+            m_Wake.wait(lk,
+                        [this]
+                        { return m_Stopped || m_Queued.load(std::memory_order_acquire) > 0; });
+            if (m_Stopped)
+                return;
         }
     }
 
-    std::vector<std::jthread> m_Workers;
-    std::queue<std::packaged_task<bool()>> m_Tasks;
+    static thread_local WorkStealingScheduler* t_Owner;
+    static thread_local size_t t_Index;
+
+    std::vector<Queue> m_Queues;
+    std::atomic<size_t> m_Queued{0};
+    std::atomic<size_t> m_QueuedLeaves{0};  ///< Leaf tasks among m_Queued
+    size_t m_LeafWaiters = 0;  ///< Leaves-only runUntil() callers asleep; under m_Mutex
+    std::atomic<size_t> m_NextQueue{0};
     std::mutex m_Mutex;
-    std::condition_variable m_TaskAvailable;
-    std::condition_variable m_SpaceAvailable;
-    static constexpr size_t MAX_QUEUED = 32;
+    std::condition_variable m_Wake;
     bool m_Stopped = false;
+    std::vector<std::jthread> m_Workers;
 };
 
-WorkPool& GetPool()
+thread_local WorkStealingScheduler* WorkStealingScheduler::t_Owner = nullptr;
+thread_local size_t WorkStealingScheduler::t_Index = WorkStealingScheduler::NO_QUEUE;
+
+WorkStealingScheduler& GetScheduler()
 {
-    static WorkPool pool(std::min(std::thread::hardware_concurrency(), 8u));
-    return pool;
+    static WorkStealingScheduler scheduler(
+        std::clamp(std::thread::hardware_concurrency(), 1u, 8u));
+    return scheduler;
 }
 
-}  // namespace
+// File tasks queued by walkDirectory() but not yet finished, across every
+// walk.  A listing that reaches the cap helps run file tasks until it drops,
+// so a directory with 100k+ entries feeds the workers at the rate they drain
+// instead of queueing a task (and a path) per entry up front.
+constexpr uint64_t WALK_MAX_QUEUED_FILES = 4096;
+std::atomic<uint64_t> g_QueuedFiles{0};
+
+// Completion record for one directory of a processDirectory walk.  pending
+// counts the listing itself plus every file and subdirectory task spawned
+// from it; whichever task drops it to zero prints the summary and reports
+// the directory's result to its parent.
+struct DirectoryWalk
+{
+    std::string dir;
+    std::shared_ptr<DirectoryWalk> parent;
+    std::atomic<uint64_t> pending{1};
+    std::atomic<uint64_t> ok{0};
+    std::atomic<uint64_t> fail{0};
+    std::atomic<uint64_t> total{0};
+    std::atomic<bool> finished{false};
+};
 
-// Walk a directory with FindFirstFileA/FindNextFileA, encrypting or
-// decrypting every file based on its .seal extension (see processFilePath).
-// Subdirectories are processed recursively via a fixed-size work pool.
+void recordResult(const std::shared_ptr<DirectoryWalk>& walk, bool success);
+
+void releaseWalk(const std::shared_ptr<DirectoryWalk>& walk)
+{
+    if (walk->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    std::cout << "[dir] " << walk->dir << ": " << walk->ok.load() << " ok, " << walk->fail.load()
+              << " failed, " << walk->total.load() << " total\n";
+
+    if (walk->parent)
+    {
+        recordResult(walk->parent, walk->fail.load() == 0);
+        return;
+    }
+    walk->finished.store(true, std::memory_order_release);
+    GetScheduler().notifyAll();
+}
+
+void recordResult(const std::shared_ptr<DirectoryWalk>& walk, bool success)
+{
+    (success ? walk->ok : walk->fail).fetch_add(1, std::memory_order_relaxed);
+    releaseWalk(walk);
+}
+
+// List one directory, spawning a task per file and per subdirectory.
+// Never waits on its children: the last task to finish closes the
+// directory out.  The listing only pauses while WALK_MAX_QUEUED_FILES file
+// tasks are outstanding, and then runs file tasks only: a nested listing
+// could hit the cap again and nest again, one open find handle and one
+// stack frame per level.
 template <secure_password SecurePwd>
-bool FileOperations::processDirectory(const std::string& dir,
-                                      const SecurePwd& password,
-                                      bool recurse)
+void walkDirectory(const std::shared_ptr<DirectoryWalk>& walk,
+                   const SecurePwd& password,
+                   bool recurse,
+                   FileKeyring* keyring)
 {
     WIN32_FIND_DATAA fd{};
-    // "*" wildcard matches all entries in the directory.
-    std::string pattern = seal::utils::joinPath(dir, "*");
-    HANDLE h = FindFirstFileA(pattern.c_str(), &fd);
+    // "*" wildcard matches all entries in the directory. FindExInfoBasic
+    // skips the 8.3 short name lookup, and LARGE_FETCH asks the redirector
+    // for bigger batches per round-trip, which dominates on network shares.
+    std::string pattern = seal::utils::joinPath(walk->dir, "*");
+    HANDLE h = FindFirstFileExA(pattern.c_str(),
+                                FindExInfoBasic,
+                                &fd,
+                                FindExSearchNameMatch,
+                                nullptr,
+                                FIND_FIRST_EX_LARGE_FETCH);
     if (h == INVALID_HANDLE_VALUE)
     {
-        std::cerr << "(dir) cannot list: " << dir << "\n";
-        return false;
+        std::cerr << "(dir) cannot list: " << walk->dir << "\n";
+        walk->fail.fetch_add(1, std::memory_order_relaxed);
+        releaseWalk(walk);
+        return;
     }
 
-    static constexpr size_t MAX_CONCURRENT = 8;
-
-    uint64_t total = 0, ok = 0, fail = 0;
-    std::vector<std::future<bool>> futures;
-
-    // Drain completed futures when the batch reaches the concurrency cap.
-    auto drainFutures = [&]()
-    {
-        for (auto& f : futures)
-        {
-            if (f.get())
-                ++ok;
-            else
-                ++fail;
-        }
-        futures.clear();
-    };
+    // Every child path shares this prefix; only the leaf changes per entry.
+    pattern.pop_back();
+    const size_t prefixLen = pattern.size();
 
-    // SAFETY: pool lambdas below capture `password` by reference. This is
-    // safe because drainFutures() joins ALL futures before this function
-    // returns, guaranteeing password outlives every lambda. If you add an
-    // early-return path, you MUST drain futures first.
+    auto& scheduler = GetScheduler();
     do
     {
         const char* name = fd.cFileName;
@@ -447,7 +993,8 @@ bool FileOperations::processDirectory(const std::string& dir,
         if (fd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
             continue;
 
-        std::string full = seal::utils::joinPath(dir, name);
+        pattern.resize(prefixLen);
+        std::string full = pattern.append(name);
 
         if (seal::utils::endsWithCi(name, ".exe") || _stricmp(name, "seal") == 0)
         {
@@ -457,79 +1004,523 @@ bool FileOperations::processDirectory(const std::string& dir,
 
         if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
         {
-            // Recurse into subdirectories via the work pool so sibling
-            // directories can be processed in parallel without creating
-            // an unbounded number of OS threads.
-            if (recurse)
-            {
-                futures.push_back(GetPool().Submit(
-                    [full, &password]() -> bool
-                    { return FileOperations::processDirectory(full, password, true); }));
-            }
+            if (!recurse)
+                continue;
+            auto child = std::make_shared<DirectoryWalk>();
+            child->dir = std::move(full);
+            child->parent = walk;
+            walk->pending.fetch_add(1, std::memory_order_relaxed);
+            scheduler.spawn([child, &password, keyring]
+                            { walkDirectory(child, password, true, keyring); });
             continue;
         }
 
-        // Submit each file encrypt/decrypt to the work pool.
-        futures.push_back(
-            GetPool().Submit([full, &password]() -> bool
-                             { return FileOperations::processFilePath(full, password); }));
-        ++total;
-
-        if (futures.size() >= MAX_CONCURRENT)
+        if (g_QueuedFiles.load(std::memory_order_acquire) >= WALK_MAX_QUEUED_FILES)
         {
-            drainFutures();
+            scheduler.runUntil(
+                []
+                { return g_QueuedFiles.load(std::memory_order_acquire) < WALK_MAX_QUEUED_FILES; },
+                true);
         }
 
+        walk->total.fetch_add(1, std::memory_order_relaxed);
+        walk->pending.fetch_add(1, std::memory_order_relaxed);
+        g_QueuedFiles.fetch_add(1, std::memory_order_acq_rel);
+        scheduler.spawn(
+            [walk, full = std::move(full), &password, keyring]
+            {
+                bool success = false;
+                try
+                {
+                    success = FileOperations::processFilePath(full, password, keyring);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "(dir) " << full << ": " << e.what() << "\n";
+                }
+                if (g_QueuedFiles.fetch_sub(1, std::memory_order_acq_rel) ==
+                    WALK_MAX_QUEUED_FILES)
+                {
+                    GetScheduler().notifyAll();
+                }
+                recordResult(walk, success);
+            },
+            true);
     } while (FindNextFileA(h, &fd));
 
     FindClose(h);
 
-    drainFutures();
-
-    std::cout << "[dir] " << dir << ": " << ok << " ok, " << fail << " failed, " << total
-              << " total\n";
-    return fail == 0;
+    // Drop the listing's own hold; if every task already finished this
+    // closes the directory out here.
+    releaseWalk(walk);
 }
 
-// Decide whether to encrypt or decrypt a single path based on its extension.
-// Files ending in ".seal" are decrypted (extension removed); all others are
-// encrypted (extension appended).
-template <secure_password SecurePwd>
-bool FileOperations::processFilePath(const std::string& raw, const SecurePwd& password)
+// Page-aligned block, as unbuffered I/O requires of its buffers. It comes
+// from the thread's locked_pool, so it is locked and guard-paged, and the
+// pipelines of consecutive files on one thread reuse the same blocks.
+// Wiped before it goes back to the pool.
+class PageBuffer
 {
-    std::string t = seal::utils::stripQuotes(seal::utils::trim(raw));
-
-    // Strip control characters that may slip through from console paste.
-    std::erase_if(t, [](unsigned char c) { return c < 32 || c == 127; });
-
-    if (t.empty())
-        return false;
+public:
+    PageBuffer() = default;
+    ~PageBuffer() { reset(); }
+    PageBuffer(const PageBuffer&) = delete;
+    PageBuffer& operator=(const PageBuffer&) = delete;
 
-    // Remove a trailing path separator so GetFileAttributesA does not reject
-    // non-root directory paths like "C:\folder\sub\".  Root paths ("C:\")
-    // are left untouched.
-    while (t.size() > 1 && (t.back() == '\\' || t.back() == '/') && !(t.size() == 3 && t[1] == ':'))
+    void allocate(size_t size)
     {
-        t.pop_back();
+        reset();
+        const size_t committed = seal::align_up(size, seal::cachedPageSize());
+        m_Data = seal::locked_pool::acquire(committed);
+        m_Size = size;
+        m_Committed = committed;
     }
 
-    std::string base = seal::utils::basenameA(t);
-    if (seal::utils::endsWithCi(base, ".exe") || _stricmp(base.c_str(), "seal") == 0)
+    void reset()
     {
-        std::cout << "(skipped) " << t << "\n";
-        return true;
+        if (!m_Data)
+            return;
+        SecureZeroMemory(m_Data, m_Committed);
+        seal::locked_pool::release(m_Data, m_Committed);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Committed = 0;
     }
 
-    // "." is a shorthand for the current working directory, letting the
-    // user encrypt/decrypt everything in cwd without typing the full path.
-    if (_stricmp(t.c_str(), ".") == 0)
+    unsigned char* data() { return m_Data; }
+    size_t size() const { return m_Size; }
+
+private:
+    unsigned char* m_Data = nullptr;
+    size_t m_Size = 0;
+    size_t m_Committed = 0;
+};
+
+// One in-flight segment of a SegmentPipeline, with the overlapped requests
+// that fill its input and drain its output.
+struct SegmentSlot
+{
+    PageBuffer in;
+    PageBuffer out;
+    AsyncOp readOp;
+    AsyncOp writeOp;
+    size_t inSize = 0;
+    size_t outSize = 0;  // bytes handed to writeOp
+    uint64_t index = 0;
+    uint32_t entry = 0;  // compressed files: the segment's table entry
+    bool last = false;
+    bool done = false;
+    bool ok = false;
+};
+
+// Seals or opens segments of the segmented format on a set of workers.
+// The caller reads input into slot(i), submit()s it, and wait()s for
+// segments in index order before writing them out, so the ring of slots
+// doubles as the reorder buffer. A slot may only be refilled after the
+// segment it last held has been waited for and written; 2 slots per worker
+// plus 2 for the read and write in flight keep disk and workers busy
+// without unbounded buffering.
+class SegmentPipeline
+{
+public:
+    using Job = std::function<bool(SegmentSlot&)>;
+
+    SegmentPipeline(unsigned threads, size_t inSize, size_t outSize, Job job)
+        : m_Job(std::move(job)),
+          m_Slots(static_cast<size_t>(threads) * 2 + 2)
     {
-        t = std::filesystem::current_path().string();
+        for (auto& s : m_Slots)
+        {
+            s.in.allocate(inSize);
+            s.out.allocate(outSize);
+        }
+        for (unsigned i = 0; i < threads; ++i)
+            m_Workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ~SegmentPipeline()
+    {
+        {
+            std::lock_guard lk(m_Mutex);
+            m_Stopped = true;
+        }
+        m_Work.notify_all();
+        m_Workers.clear();  // joins; queued segments are finished first
+        // The slot buffers wipe themselves when m_Slots is destroyed.
+    }
+
+    SegmentPipeline(const SegmentPipeline&) = delete;
+    SegmentPipeline& operator=(const SegmentPipeline&) = delete;
+
+    size_t depth() const { return m_Slots.size(); }
+    SegmentSlot& slot(uint64_t index) { return m_Slots[index % m_Slots.size()]; }
+
+    void submit(uint64_t index, bool last)
+    {
+        SegmentSlot& s = slot(index);
+        {
+            std::lock_guard lk(m_Mutex);
+            s.index = index;
+            s.last = last;
+            s.done = false;
+            m_Queue.push(&s);
+        }
+        m_Work.notify_one();
+    }
+
+    // Block until segment `index` has been processed; false if its job failed.
+    bool wait(uint64_t index)
+    {
+        SegmentSlot& s = slot(index);
+        std::unique_lock lk(m_Mutex);
+        m_Done.wait(lk, [&] { return s.done; });
+        return s.ok;
+    }
+
+private:
+    void workerLoop()
+    {
+        for (;;)
+        {
+            SegmentSlot* s = nullptr;
+            {
+                std::unique_lock lk(m_Mutex);
+                m_Work.wait(lk, [this] { return m_Stopped || !m_Queue.empty(); });
+                if (m_Queue.empty())
+                    return;
+                s = m_Queue.front();
+                m_Queue.pop();
+            }
+            bool ok = false;
+            try
+            {
+                ok = m_Job(*s);
+            }
+            catch (const std::exception&)
+            {
+                ok = false;
+            }
+            {
+                std::lock_guard lk(m_Mutex);
+                s->ok = ok;
+                s->done = true;
+            }
+            m_Done.notify_all();
+        }
+    }
+
+    Job m_Job;
+    std::vector<SegmentSlot> m_Slots;
+    std::queue<SegmentSlot*> m_Queue;
+    std::mutex m_Mutex;
+    std::condition_variable m_Work;
+    std::condition_variable m_Done;
+    bool m_Stopped = false;
+    std::vector<std::jthread> m_Workers;  // last: joined before the rest is destroyed
+};
+
+// 0 selects one worker per logical CPU; explicit counts are capped so a
+// typo cannot allocate gigabytes of segment buffers.
+unsigned resolveThreads(unsigned requested)
+{
+    unsigned n = requested ? requested : std::thread::hardware_concurrency();
+    return std::clamp(n, 1u, 64u);
+}
+
+}  // namespace
+
+// Walk a directory with FindFirstFileExA/FindNextFileA, encrypting or
+// decrypting every file based on its .seal extension (see processFilePath).
+// Files and subdirectories run as tasks on the work-stealing scheduler.
+template <secure_password SecurePwd>
+bool FileOperations::processDirectory(const std::string& dir,
+                                      const SecurePwd& password,
+                                      bool recurse,
+                                      FileKeyring* keyring)
+{
+    auto root = std::make_shared<DirectoryWalk>();
+    root->dir = dir;
+
+    // One keyring for the whole tree: every file shares the batch salt
+    // and its scrypt result.
+    std::optional<FileKeyring> ownKeyring;
+    if (!keyring)
+        keyring = &ownKeyring.emplace();
+
+    // SAFETY: walk tasks capture `password` and `keyring` by reference. This
+    // is safe because runUntil() returns only after the root walk has
+    // finished, i.e. after every task spawned beneath it has run. If you add
+    // an early-return path, it MUST come before the first spawn.
+    auto& scheduler = GetScheduler();
+    scheduler.spawn([root, &password, recurse, keyring]
+                    { walkDirectory(root, password, recurse, keyring); });
+    scheduler.runUntil([&] { return root->finished.load(std::memory_order_acquire); });
+
+    return root->fail.load() == 0;
+}
+
+namespace
+{
+
+constexpr char SYNC_MANIFEST_NAME[] = ".seal-manifest";
+constexpr size_t SYNC_CHECKPOINT_FILES = 64;
+constexpr uint64_t SYNC_CHECKPOINT_BYTES = 1ULL << 30;
+
+// One new or changed file of a syncDirectory() run.
+struct SyncJob
+{
+    std::string rel;  // manifest key: generic path relative to the source root
+    std::filesystem::path src;
+    std::filesystem::path dst;
+    DirectoryManifest::Entry now;  // size and time as listed; hash filled in by the task
+    std::optional<DirectoryManifest::Entry> prev;
+};
+
+// True if `p` is `root` or lies beneath it (both already canonical).
+bool pathWithin(const std::filesystem::path& p, const std::filesystem::path& root)
+{
+    auto rel = p.lexically_relative(root);
+    return !rel.empty() && *rel.begin() != "..";
+}
+
+}  // namespace
+
+template <secure_password SecurePwd>
+bool FileOperations::syncDirectory(const std::string& srcDir,
+                                   const std::string& dstDir,
+                                   const SecurePwd& password)
+{
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    const fs::path src = fs::weakly_canonical(srcDir, ec);
+    if (ec || !fs::is_directory(src, ec))
+    {
+        std::cerr << "(sync) not a directory: " << srcDir << "\n";
+        return false;
+    }
+    const fs::path dst = fs::weakly_canonical(dstDir, ec);
+    if (ec || pathWithin(dst, src) || pathWithin(src, dst))
+    {
+        // A mirror inside its own source would encrypt its output each run.
+        std::cerr << "(sync) destination must be outside the source tree: " << dstDir << "\n";
+        return false;
+    }
+    fs::create_directories(dst, ec);
+    if (ec)
+    {
+        std::cerr << "(sync) cannot create: " << dstDir << "\n";
+        return false;
+    }
+
+    DirectoryManifest manifest;
+    try
+    {
+        manifest.open((dst / SYNC_MANIFEST_NAME).string(), password);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "(sync) cannot open manifest: " << e.what() << "\n";
+        return false;
+    }
+
+    // Plan on this thread: one stat per file, no reads. Files whose size
+    // and time match the manifest (and whose copy still exists) are done.
+    std::vector<SyncJob> jobs;
+    std::unordered_set<std::string> seen;
+    std::atomic<size_t> unchanged{0};
+    std::atomic<size_t> failed{0};
+    const auto options = fs::directory_options::skip_permission_denied;
+    for (fs::recursive_directory_iterator it(src, options, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        try
+        {
+            std::error_code fec;
+            if (it->is_symlink(fec) || !it->is_regular_file(fec))
+                continue;
+            DirectoryManifest::Entry now;
+            now.size = it->file_size(fec);
+            if (!fec)
+                now.writeTime =
+                    static_cast<uint64_t>(it->last_write_time(fec).time_since_epoch().count());
+            if (fec)
+            {
+                std::cerr << "(sync) cannot stat: " << it->path().string() << "\n";
+                failed.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            const fs::path relPath = it->path().lexically_relative(src);
+            std::string rel = relPath.generic_string();
+            fs::path out = dst / relPath;
+            out += ".seal";
+            seen.insert(rel);
+
+            auto prev = manifest.find(rel);
+            if (prev && prev->size == now.size && prev->writeTime == now.writeTime &&
+                fs::exists(out, fec))
+            {
+                unchanged.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            jobs.push_back({std::move(rel), it->path(), std::move(out), now, std::move(prev)});
+        }
+        catch (const std::exception& e)
+        {
+            // e.g. a name the narrow code page cannot represent
+            std::cerr << "(sync) skipped entry: " << e.what() << "\n";
+            failed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    const bool listed = !ec;
+    if (!listed)
+        std::cerr << "(sync) listing stopped early: " << ec.message() << "\n";
+
+    // Drop copies of files deleted from the source. Only a complete listing
+    // may prune, and only entries whose source is really gone: subtrees the
+    // listing could not enter are left alone.
+    size_t removed = 0;
+    if (listed)
+    {
+        for (const auto& rel : manifest.paths())
+        {
+            if (seen.contains(rel))
+                continue;
+            std::error_code sec;
+            if (fs::symlink_status(src / fs::path(rel), sec).type() != fs::file_type::not_found)
+                continue;
+            fs::path out = dst / fs::path(rel);
+            out += ".seal";
+            fs::remove(out, sec);
+            manifest.erase(rel);
+            ++removed;
+        }
+    }
+
+    FileKeyring keyring;
+    std::atomic<size_t> pending{jobs.size()};
+    std::atomic<size_t> encrypted{0};
+    std::mutex checkpointMutex;
+    size_t sinceFiles = 0;
+    uint64_t sinceBytes = 0;
+
+    // SAFETY: tasks capture this frame by reference. runUntil() returns
+    // only once `pending` reaches zero, i.e. after the last task has run.
+    auto& scheduler = GetScheduler();
+    for (auto& job : jobs)
+    {
+        scheduler.spawn(
+            [&, jobPtr = &job]
+            {
+                SyncJob& j = *jobPtr;
+                bool ok = false;
+                try
+                {
+                    // Stat first, hash second: if the file changes after
+                    // the listing, the stale time makes the next run look
+                    // at it again.
+                    j.now.hash = hashFile(j.src.string());
+                    std::error_code jec;
+                    if (j.now.hash.empty())
+                    {
+                        std::cerr << "(sync) cannot read: " << j.src.string() << "\n";
+                    }
+                    else if (j.prev && j.prev->size == j.now.size && j.prev->hash == j.now.hash &&
+                             fs::exists(j.dst, jec))
+                    {
+                        // Touched but not edited: keep the existing copy.
+                        manifest.record(j.rel, j.now);
+                        unchanged.fetch_add(1, std::memory_order_relaxed);
+                        ok = true;
+                    }
+                    else
+                    {
+                        fs::create_directories(j.dst.parent_path(), jec);
+                        ok = encryptFileTo(j.src.string(), j.dst.string(), password, 1, &keyring);
+                        if (ok)
+                        {
+                            manifest.record(j.rel, j.now);
+                            encrypted.fetch_add(1, std::memory_order_relaxed);
+                            std::cout << "(encrypted) " << j.src.string() << " -> "
+                                      << j.dst.string() << "\n";
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "(sync) " << j.src.string() << ": " << e.what() << "\n";
+                }
+                if (!ok)
+                    failed.fetch_add(1, std::memory_order_relaxed);
+
+                {
+                    std::lock_guard<std::mutex> lk(checkpointMutex);
+                    ++sinceFiles;
+                    sinceBytes += j.now.size;
+                    if (sinceFiles >= SYNC_CHECKPOINT_FILES || sinceBytes >= SYNC_CHECKPOINT_BYTES)
+                    {
+                        sinceFiles = 0;
+                        sinceBytes = 0;
+                        (void)manifest.save();
+                    }
+                }
+
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    scheduler.notifyAll();
+            });
+    }
+    scheduler.runUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
+
+    const bool saved = manifest.save();
+    if (!saved)
+        std::cerr << "(sync) cannot write manifest in: " << dst.string() << "\n";
+
+    std::cout << "(sync) " << encrypted.load() << " encrypted, " << unchanged.load()
+              << " unchanged, " << removed << " removed, " << failed.load() << " failed\n";
+    return saved && listed && failed.load() == 0;
+}
+
+// Decide whether to encrypt or decrypt a single path based on its extension.
+// Files ending in ".seal" are decrypted (extension removed); all others are
+// encrypted (extension appended).
+template <secure_password SecurePwd>
+bool FileOperations::processFilePath(const std::string& raw,
+                                     const SecurePwd& password,
+                                     FileKeyring* keyring)
+{
+    std::string t = seal::utils::stripQuotes(seal::utils::trim(raw));
+
+    // Strip control characters that may slip through from console paste.
+    std::erase_if(t, [](unsigned char c) { return c < 32 || c == 127; });
+
+    if (t.empty())
+        return false;
+
+    // Remove a trailing path separator so GetFileAttributesA does not reject
+    // non-root directory paths like "C:\folder\sub\".  Root paths ("C:\")
+    // are left untouched.
+    while (t.size() > 1 && (t.back() == '\\' || t.back() == '/') && !(t.size() == 3 && t[1] == ':'))
+    {
+        t.pop_back();
+    }
+
+    std::string base = seal::utils::basenameA(t);
+    if (seal::utils::endsWithCi(base, ".exe") || _stricmp(base.c_str(), "seal") == 0)
+    {
+        std::cout << "(skipped) " << t << "\n";
+        return true;
+    }
+
+    // "." is a shorthand for the current working directory, letting the
+    // user encrypt/decrypt everything in cwd without typing the full path.
+    if (_stricmp(t.c_str(), ".") == 0)
+    {
+        t = std::filesystem::current_path().string();
     }
 
     if (seal::utils::isDirectoryA(t))
     {
-        (void)processDirectory(t, password, true);
+        (void)processDirectory(t, password, true, keyring);
         return true;  // recognized as a directory; never fall through to text encryption
     }
 
@@ -539,7 +1530,7 @@ bool FileOperations::processFilePath(const std::string& raw, const SecurePwd& pa
         std::error_code ec;
         if (std::filesystem::is_directory(t, ec))
         {
-            (void)processDirectory(t, password, true);
+            (void)processDirectory(t, password, true, keyring);
             return true;
         }
     }
@@ -555,7 +1546,7 @@ bool FileOperations::processFilePath(const std::string& raw, const SecurePwd& pa
     {
         // Decrypt: strip the .seal extension to restore the original filename.
         std::string newName = seal::utils::strip_ext_ci(t, std::string_view{".seal"});
-        bool success = FileOperations::decryptFileTo(t, newName, password);
+        bool success = FileOperations::decryptFileTo(t, newName, password, 1, keyring);
 
         if (success)
         {
@@ -568,7 +1559,7 @@ bool FileOperations::processFilePath(const std::string& raw, const SecurePwd& pa
     {
         // Encrypt: append .seal so the file is recognized as encrypted later.
         std::string newName = seal::utils::add_ext(t, std::string_view{".seal"});
-        bool success = FileOperations::encryptFileTo(t, newName, password);
+        bool success = FileOperations::encryptFileTo(t, newName, password, 1, keyring);
 
         if (success)
         {
@@ -588,87 +1579,120 @@ struct TokenMapping
     size_t intraTripleIndex;  // which triple within that token's decrypted output
 };
 
-// Decrypt a batch of hex-encoded ciphertext tokens. Extracts service names
-// (non-secret) for display and builds an index map for on-demand re-decryption.
-// Credentials are wiped immediately; only service names are retained.
+// Decrypt a batch of hex-encoded ciphertext tokens. Each token pays its own
+// scrypt run, so the tokens are decrypted in parallel on the shared
+// scheduler; the results are then merged in paste order on this thread.
+// Extracts service names (non-secret) for display and builds an index map
+// for on-demand re-decryption. Credentials are wiped as soon as the merge
+// reaches them, unless @p triples is given (uncensored mode), in which case
+// they are handed over for display instead of being decrypted a second time.
 template <secure_password SecurePwd>
-static void scanHexTokens(const std::vector<std::string>& hexTokens,
+static void scanHexTokens(const std::vector<std::string_view>& hexTokens,
                           const SecurePwd& password,
                           std::vector<std::string>& allHexTokens,
                           std::vector<std::wstring>& serviceNames,
                           std::vector<TokenMapping>& indexMap,
-                          std::vector<std::string>& otherPlain)
+                          std::vector<std::string>& otherPlain,
+                          std::vector<seal::secure_triplet16_t>* triples)
 {
-    for (const auto& tok : hexTokens)
+    struct TokenJob
     {
-        try
-        {
-            auto plain = FileOperations::decryptLine(tok, password);
+        seal::secure_string<seal::locked_allocator<char>> plain;
+        std::string error;
+    };
 
-            std::vector<seal::secure_triplet16<seal::locked_allocator<wchar_t>>> ts;
-            if (FileOperations::parseTriples(plain.view(), ts))
+    std::vector<TokenJob> jobs(hexTokens.size());
+    std::atomic<size_t> pending{jobs.size()};
+    auto& scheduler = GetScheduler();
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        scheduler.spawn(
+            [&tok = hexTokens[i], &job = jobs[i], &pending, &password]
             {
-                size_t tokIdx = allHexTokens.size();
-                allHexTokens.push_back(tok);
-                for (size_t j = 0; j < ts.size(); ++j)
+                try
                 {
-                    // Extract non-secret service name for display.
-                    serviceNames.emplace_back(ts[j].primary.data(), ts[j].primary.size());
-                    indexMap.push_back({tokIdx, j});
+                    job.plain = FileOperations::decryptLine(tok, password);
                 }
-                // Wipe credentials immediately; only service names are kept.
+                catch (const std::exception& ex)
+                {
+                    job.error = ex.what();
+                }
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    GetScheduler().notifyAll();
+            });
+    }
+    scheduler.runUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        auto& plain = jobs[i].plain;
+        if (!jobs[i].error.empty())
+        {
+            std::cerr << "(decrypt failed: " << jobs[i].error << ")\n";
+            continue;
+        }
+
+        std::vector<seal::secure_triplet16_t> ts;
+        if (FileOperations::parseTriples(plain.view(), ts))
+        {
+            size_t tokIdx = allHexTokens.size();
+            allHexTokens.emplace_back(hexTokens[i]);
+            for (size_t j = 0; j < ts.size(); ++j)
+            {
+                // Extract non-secret service name for display.
+                serviceNames.emplace_back(ts[j].primary.data(), ts[j].primary.size());
+                indexMap.push_back({tokIdx, j});
+            }
+            if (triples)
+            {
                 for (auto& t : ts)
-                    seal::Cryptography::cleanseString(t.primary, t.secondary, t.tertiary);
+                    triples->push_back(std::move(t));
             }
             else
             {
-                // Not a triple -- fallback: copy raw plaintext to clipboard.
-                (void)seal::Clipboard::copyWithTTL(plain.view());
-                otherPlain.emplace_back(plain.data(), plain.size());
+                // Wipe credentials immediately; only service names are kept.
+                for (auto& t : ts)
+                    seal::Cryptography::cleanseString(t.primary, t.secondary, t.tertiary);
             }
-            seal::Cryptography::cleanseString(plain);
         }
-        catch (const std::exception& ex)
+        else
         {
-            std::cerr << "(decrypt failed: " << ex.what() << ")\n";
+            // Not a triple -- fallback: copy raw plaintext to clipboard.
+            (void)seal::Clipboard::copyWithTTL(plain.view());
+            otherPlain.emplace_back(plain.data(), plain.size());
         }
+        seal::Cryptography::cleanseString(plain);
     }
 }
 
-// Print decrypted triples to the console in uncensored mode.
-// All triples are re-decrypted for stdout output (unavoidable since the
-// user explicitly chose uncensored) and wiped after printing.
-template <secure_password SecurePwd>
-static void displayTriplesUncensored(const std::vector<std::string>& allHexTokens,
-                                     const std::vector<TokenMapping>& indexMap,
-                                     const SecurePwd& password)
+// Print decrypted triples to the console in uncensored mode (the user
+// explicitly chose this) and wipe them after printing.
+static void displayTriplesUncensored(std::vector<seal::secure_triplet16_t>& triples)
 {
     std::ostringstream oss;
+    // Hold the whole batch readable for one pass rather than toggling
+    // each string's protection per access; closed before the wipe.
+    seal::RWGuardSet open;
+    for (const auto& t : triples)
+    {
+        open.add(t.primary);
+        open.add(t.secondary);
+        open.add(t.tertiary);
+    }
     bool first = true;
-    for (const auto& m : indexMap)
+    for (const auto& t : triples)
     {
-        try
-        {
-            auto plain = FileOperations::decryptLine(allHexTokens[m.hexTokenIndex], password);
-            std::vector<seal::secure_triplet16_t> ts;
-            if (FileOperations::parseTriples(plain.view(), ts) && m.intraTripleIndex < ts.size())
-            {
-                if (!first)
-                    oss << ", ";
-                std::string sv = FileOperations::tripleToUtf8(ts[m.intraTripleIndex]);
-                oss << sv;
-                seal::Cryptography::cleanseString(sv);
-                first = false;
-            }
-            seal::Cryptography::cleanseString(plain);
-            for (auto& t : ts)
-                seal::Cryptography::cleanseString(t.primary, t.secondary, t.tertiary);
-        }
-        catch (const std::exception& ex)
-        {
-            std::cerr << "(decrypt failed: " << ex.what() << ")\n";
-        }
+        if (!first)
+            oss << ", ";
+        std::string sv = FileOperations::tripleToUtf8(t);
+        oss << sv;
+        seal::Cryptography::cleanseString(sv);
+        first = false;
     }
+    open.close();
+    for (auto& t : triples)
+        seal::Cryptography::cleanseString(t.primary, t.secondary, t.tertiary);
+    triples.clear();
     std::string printed = oss.str();
     if (!printed.empty())
         std::cout << printed << "\n";
@@ -690,6 +1714,15 @@ template <secure_password SecurePwd>
 void FileOperations::processBatch(const std::vector<std::string>& lines,
                                   bool uncensored,
                                   const SecurePwd& password)
+{
+    std::vector<std::string_view> views(lines.begin(), lines.end());
+    processBatch(std::span<const std::string_view>(views), uncensored, password);
+}
+
+template <secure_password SecurePwd>
+void FileOperations::processBatch(std::span<const std::string_view> lines,
+                                  bool uncensored,
+                                  const SecurePwd& password)
 {
     if (lines.empty())
         return;
@@ -700,26 +1733,57 @@ void FileOperations::processBatch(const std::vector<std::string>& lines,
     std::vector<std::wstring> serviceNames;
     std::vector<TokenMapping> indexMap;
     std::vector<std::string> otherPlain;
-    std::vector<std::string> encHex;
+    std::vector<std::string_view> toEncrypt;  // views into lines
+    std::vector<std::string_view> pastedHex;  // views into lines
+    std::vector<seal::secure_triplet16_t> shownTriples;
+
+    // Every file and directory named in this batch shares one scrypt run.
+    FileKeyring keyring;
+    constexpr size_t MAX_PATH_CHARS = 32767;
 
     for (const auto& L : lines)
     {
-        // Priority 1: try to handle as a file/directory path.
-        if (processFilePath(L, password))
+        // Priority 1: try to handle as a file/directory path. Nothing longer
+        // than the extended-length path limit can name one, so a pasted
+        // block of hex is not copied just to be rejected.
+        if (L.size() <= MAX_PATH_CHARS && processFilePath(std::string(L), password, &keyring))
             continue;
 
-        // Priority 2: if the line contains hex-encoded ciphertext, decrypt it.
-        auto hexTokens = seal::utils::extractHexTokens(L);
+        // Priority 2: if the line contains hex-encoded ciphertext, decrypt
+        // it below together with the tokens of every other line.
+        auto hexTokens = seal::utils::findHexTokens(L);
         if (!hexTokens.empty())
         {
-            scanHexTokens(hexTokens, password, allHexTokens, serviceNames, indexMap, otherPlain);
+            pastedHex.insert(pastedHex.end(), hexTokens.begin(), hexTokens.end());
             continue;
         }
 
-        // Priority 3: treat as plaintext and encrypt to hex for output.
+        // Priority 3: treat as plaintext; encrypted below as one batch.
+        toEncrypt.push_back(L);
+    }
+
+    if (!pastedHex.empty())
+        scanHexTokens(pastedHex,
+                      password,
+                      allHexTokens,
+                      serviceNames,
+                      indexMap,
+                      otherPlain,
+                      uncensored ? &shownTriples : nullptr);
+
+    // All plaintext lines share one scrypt run (Cryptography::encryptBatch)
+    // instead of paying for one per line.
+    std::vector<std::string> encHex;
+    if (!toEncrypt.empty())
+    {
+        std::vector<std::span<const unsigned char>> items;
+        items.reserve(toEncrypt.size());
+        for (const auto& L : toEncrypt)
+            items.emplace_back(reinterpret_cast<const unsigned char*>(L.data()), L.size());
         try
         {
-            encHex.emplace_back(encryptLine(L, password));
+            for (const auto& packet : seal::Cryptography::encryptBatch(items, password))
+                encHex.push_back(seal::utils::to_hex(packet));
         }
         catch (const std::exception& ex)
         {
@@ -731,8 +1795,8 @@ void FileOperations::processBatch(const std::vector<std::string>& lines,
     {
         if (uncensored)
         {
-            // Uncensored: re-decrypt all for stdout (user explicitly chose this).
-            displayTriplesUncensored(allHexTokens, indexMap, password);
+            // Uncensored: print the triples kept from the first pass.
+            displayTriplesUncensored(shownTriples);
         }
         else
         {
@@ -772,158 +1836,540 @@ void FileOperations::processBatch(const std::vector<std::string>& lines,
         std::cout << hex << "\n";
 }
 
-// Read all of stdin as binary, encrypt, and write raw ciphertext to stdout.
-// Designed for shell pipe integration, e.g.: cat secret | seal --encrypt | ...
+// Encrypt stdin to stdout in cfg::FILE_CHUNK pieces on the raw handles, so
+// memory stays bounded however much is piped through, e.g.:
+//   pg_dump db | seal --encrypt > db.seal
+// The output is a single encryptPacket-format packet (AAD | salt | IV | ct |
+// tag), interoperable with every decrypt path.
 template <secure_password SecurePwd>
 bool FileOperations::streamEncrypt(const SecurePwd& password)
 {
-    try
+    std::vector<unsigned char> plainBuf(seal::cfg::FILE_CHUNK);
+    std::vector<unsigned char> ctBuf(seal::cfg::FILE_CHUNK + 16);  // block slop
+    seal::Cryptography::LockedKeyBuffer key;
+    auto wipe = [&]()
     {
-        // Slurp all of stdin into memory (binary pipe, no line buffering).
-        std::vector<unsigned char> plaintext((std::istreambuf_iterator<char>(std::cin)),
-                                             std::istreambuf_iterator<char>());
+        seal::Cryptography::cleanseString(key);
+        SecureZeroMemory(plainBuf.data(), plainBuf.size());
+        SecureZeroMemory(ctBuf.data(), ctBuf.size());
+    };
 
-        if (plaintext.empty())
+    try
+    {
+        std::cout.flush();
+        HANDLE hIn = GetStdHandle(STD_INPUT_HANDLE);
+        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+
+        // Read the first chunk before deriving the key so empty input is
+        // rejected without paying for the KDF or emitting a header.
+        size_t got = 0;
+        if (!readHandle(hIn, plainBuf.data(), plainBuf.size(), got))
+        {
+            std::cerr << "(encrypt) Failed to read stdin\n";
+            wipe();
+            return false;
+        }
+        if (got == 0)
         {
             std::cerr << "(encrypt) No data read from stdin\n";
             return false;
         }
 
-        auto packet =
-            seal::Cryptography::encryptPacket(std::span<const unsigned char>(plaintext), password);
+        std::vector<unsigned char> salt(seal::cfg::SALT_LEN);
+        seal::Cryptography::opensslCheck(RAND_bytes(salt.data(), (int)salt.size()),
+                                         "RAND_bytes(salt) failed");
+        std::vector<unsigned char> iv(seal::cfg::IV_LEN);
+        seal::Cryptography::opensslCheck(RAND_bytes(iv.data(), (int)iv.size()),
+                                         "RAND_bytes(iv) failed");
+        const seal::KdfParams kdf = seal::Cryptography::kdfParams();
+        key = seal::Cryptography::deriveKey(password, std::span<const unsigned char>(salt), kdf);
 
-        std::cout.write(reinterpret_cast<const char*>(packet.data()),
-                        static_cast<std::streamsize>(packet.size()));
+        seal::CachedCipherCtx ctx;
+        seal::Cryptography::opensslCheck(
+            EVP_EncryptInit_ex(ctx.p, seal::aes256Gcm(), nullptr, nullptr, nullptr),
+            "EncryptInit(cipher) failed");
+        seal::Cryptography::opensslCheck(
+            EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)iv.size(), nullptr),
+            "SET_IVLEN failed");
+        seal::Cryptography::opensslCheck(
+            EVP_EncryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv.data()),
+            "EncryptInit(key/iv) failed");
 
-        if (!std::cout.good())
+        // Same AAD as encryptPacket(): "seal", or "slp2" and the KDF bytes.
+        std::vector<unsigned char> aad(seal::cfg::AAD_HDR,
+                                       seal::cfg::AAD_HDR + seal::cfg::AAD_LEN);
+        if (!kdf.isLegacy())
         {
-            std::cerr << "(encrypt) Failed to write to stdout\n";
-            seal::Cryptography::cleanseString(plaintext);
+            auto bytes = kdf.encode();
+            aad.assign(seal::cfg::PACKET_KDF_HDR, seal::cfg::PACKET_KDF_HDR + seal::cfg::AAD_LEN);
+            aad.insert(aad.end(), bytes.begin(), bytes.end());
+        }
+        {
+            int tmp = 0;
+            seal::Cryptography::opensslCheck(
+                EVP_EncryptUpdate(ctx.p, nullptr, &tmp, aad.data(), (int)aad.size()),
+                "EncryptUpdate(AAD) failed");
+        }
+
+        bool ioOk = writeHandle(hOut, aad.data(), aad.size()) &&
+                    writeHandle(hOut, salt.data(), salt.size()) &&
+                    writeHandle(hOut, iv.data(), iv.size());
+        bool readOk = true;
+        while (ioOk && got > 0)
+        {
+            int outlen = 0;
+            seal::Cryptography::opensslCheck(
+                EVP_EncryptUpdate(
+                    ctx.p, ctBuf.data(), &outlen, plainBuf.data(), static_cast<int>(got)),
+                "EncryptUpdate(PT) failed");
+            SecureZeroMemory(plainBuf.data(), got);
+            ioOk = writeHandle(hOut, ctBuf.data(), static_cast<size_t>(outlen));
+            if (ioOk)
+                readOk = readHandle(hIn, plainBuf.data(), plainBuf.size(), got);
+            if (!readOk)
+                break;
+        }
+        if (!readOk)
+        {
+            std::cerr << "(encrypt) Failed to read stdin\n";
+            wipe();
             return false;
         }
 
-        seal::Cryptography::cleanseString(plaintext);
+        if (ioOk)
+        {
+            int fin = 0;
+            seal::Cryptography::opensslCheck(EVP_EncryptFinal_ex(ctx.p, ctBuf.data(), &fin),
+                                             "EncryptFinal failed");
+            std::vector<unsigned char> tag(seal::cfg::TAG_LEN);
+            seal::Cryptography::opensslCheck(
+                EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_GET_TAG, (int)tag.size(), tag.data()),
+                "GET_TAG failed");
+            ioOk = writeHandle(hOut, ctBuf.data(), static_cast<size_t>(fin)) &&
+                   writeHandle(hOut, tag.data(), tag.size());
+        }
+
+        wipe();
+        if (!ioOk)
+        {
+            std::cerr << "(encrypt) Failed to write to stdout\n";
+            return false;
+        }
         return true;
     }
     catch (const std::exception& e)
     {
+        wipe();
         std::cerr << "(encrypt) " << e.what() << "\n";
         return false;
     }
 }
 
-// Inverse of streamEncrypt: read raw ciphertext from stdin, decrypt, and
-// write plaintext to stdout. Used for shell pipe decryption, e.g.:
-//   cat secret.seal | seal --decrypt > secret.txt
+// Inverse of streamEncrypt: read one packet from stdin and write the
+// plaintext to stdout, e.g.:
+//   seal --decrypt < db.seal | psql db
+//
+// Like decryptFileStreaming, the tag is verified before any plaintext is
+// written. Pass 1 decrypts into a scratch buffer only; pass 2 decrypts to
+// stdout. When stdin is a seekable file, pass 2 re-reads it. Otherwise the
+// ciphertext is staged in a CiphertextSpool as it streams past. Either way
+// memory stays at a few chunks regardless of input size.
 template <secure_password SecurePwd>
 bool FileOperations::streamDecrypt(const SecurePwd& password)
 {
-    try
+    std::vector<unsigned char> ctBuf(seal::cfg::FILE_CHUNK + seal::cfg::TAG_LEN);
+    std::vector<unsigned char> plainBuf(seal::cfg::FILE_CHUNK + seal::cfg::TAG_LEN + 16);
+    seal::Cryptography::LockedKeyBuffer key;
+    auto wipe = [&]()
     {
-        // Slurp all of stdin (raw ciphertext bytes).
-        std::vector<unsigned char> packet((std::istreambuf_iterator<char>(std::cin)),
-                                          std::istreambuf_iterator<char>());
+        seal::Cryptography::cleanseString(key);
+        SecureZeroMemory(ctBuf.data(), ctBuf.size());
+        SecureZeroMemory(plainBuf.data(), plainBuf.size());
+    };
 
-        if (packet.empty())
+    try
+    {
+        std::cout.flush();
+        HANDLE hIn = GetStdHandle(STD_INPUT_HANDLE);
+        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+
+        // The magic says how long the AAD is: "seal" alone, or "slp2"
+        // followed by the KDF parameters.
+        std::vector<unsigned char> header(seal::cfg::AAD_LEN);
+        size_t got = 0;
+        if (!readHandle(hIn, header.data(), header.size(), got))
+        {
+            std::cerr << "(decrypt) Failed to read stdin\n";
+            return false;
+        }
+        if (got == 0)
         {
             std::cerr << "(decrypt) No data read from stdin\n";
             return false;
         }
-
-        auto plaintext =
-            seal::Cryptography::decryptPacket(std::span<const unsigned char>(packet), password);
-
-        std::cout.write(reinterpret_cast<const char*>(plaintext.data()),
-                        static_cast<std::streamsize>(plaintext.size()));
-
-        if (!std::cout.good())
+        const size_t aadLen =
+            got == seal::cfg::AAD_LEN &&
+                    std::memcmp(header.data(), seal::cfg::PACKET_KDF_HDR, seal::cfg::AAD_LEN) == 0
+                ? seal::cfg::PACKET_KDF_AAD_LEN
+                : seal::cfg::AAD_LEN;
+        const size_t headerSize = aadLen + seal::cfg::SALT_LEN + seal::cfg::IV_LEN;
+        header.resize(headerSize);
+        size_t rest = 0;
+        if (got == seal::cfg::AAD_LEN &&
+            !readHandle(hIn, header.data() + got, header.size() - got, rest))
         {
-            std::cerr << "(decrypt) Failed to write to stdout\n";
-            seal::Cryptography::cleanseString(plaintext);
+            std::cerr << "(decrypt) Failed to read stdin\n";
             return false;
         }
-
-        seal::Cryptography::cleanseString(plaintext);
-        return true;
-    }
+        if (got + rest < headerSize)
+        {
+            std::cerr << "(decrypt) Input too short\n";
+            return false;
+        }
+        std::span<const unsigned char> aadExpected;
+        seal::KdfParams kdf;
+        try
+        {
+            aadExpected = seal::Cryptography::packetAad(header);
+            kdf = seal::Cryptography::packetKdf(header);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "(decrypt) " << e.what() << "\n";
+            return false;
+        }
+        std::span<const unsigned char> salt(header.data() + aadExpected.size(),
+                                            seal::cfg::SALT_LEN);
+        std::span<const unsigned char> iv(salt.data() + salt.size(), seal::cfg::IV_LEN);
+
+        // A redirected file can simply be read twice; anything else is spooled.
+        const bool seekable = GetFileType(hIn) == FILE_TYPE_DISK;
+        LARGE_INTEGER ctStart{};
+        BY_HANDLE_FILE_INFORMATION infoBefore{};
+        if (seekable)
+        {
+            LARGE_INTEGER zero{};
+            if (!SetFilePointerEx(hIn, zero, &ctStart, FILE_CURRENT) ||
+                !GetFileInformationByHandle(hIn, &infoBefore))
+            {
+                std::cerr << "(decrypt) Failed to read stdin\n";
+                return false;
+            }
+        }
+        CiphertextSpool spool;
+
+        key = seal::Cryptography::deriveKey(password, salt, kdf);
+        auto initCtx = [&](seal::CachedCipherCtx& ctx)
+        {
+            seal::Cryptography::opensslCheck(
+                EVP_DecryptInit_ex(ctx.p, seal::aes256Gcm(), nullptr, nullptr, nullptr),
+                "DecryptInit(cipher) failed");
+            seal::Cryptography::opensslCheck(
+                EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)iv.size(), nullptr),
+                "SET_IVLEN failed");
+            seal::Cryptography::opensslCheck(
+                EVP_DecryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv.data()),
+                "DecryptInit(key/iv) failed");
+            if (!aadExpected.empty())
+            {
+                int tmp = 0;
+                seal::Cryptography::opensslCheck(
+                    EVP_DecryptUpdate(
+                        ctx.p, nullptr, &tmp, aadExpected.data(), (int)aadExpected.size()),
+                    "DecryptUpdate(AAD) failed");
+            }
+        };
+
+        // --- Pass 1: verify. The last TAG_LEN bytes seen are held back at
+        // the front of ctBuf since the end of a pipe is only known once a
+        // read comes back empty.
+        std::vector<unsigned char> tag(seal::cfg::TAG_LEN);
+        uint64_t ctLen = 0;
+        {
+            seal::CachedCipherCtx verifyCtx;
+            initCtx(verifyCtx);
+
+            size_t pending = 0;
+            for (;;)
+            {
+                if (!readHandle(hIn, ctBuf.data() + pending, seal::cfg::FILE_CHUNK, got))
+                {
+                    std::cerr << "(decrypt) Failed to read stdin\n";
+                    wipe();
+                    return false;
+                }
+                if (got == 0)
+                    break;
+                const size_t total = pending + got;
+                const size_t ready = total > tag.size() ? total - tag.size() : 0;
+                if (ready > 0)
+                {
+                    int outlen = 0;
+                    seal::Cryptography::opensslCheck(
+                        EVP_DecryptUpdate(verifyCtx.p,
+                                          plainBuf.data(),
+                                          &outlen,
+                                          ctBuf.data(),
+                                          static_cast<int>(ready)),
+                        "DecryptUpdate(CT/verify) failed");
+                    SecureZeroMemory(plainBuf.data(), static_cast<size_t>(outlen));
+                    if (!seekable && !spool.append(ctBuf.data(), ready))
+                    {
+                        std::cerr << "(decrypt) Failed to stage ciphertext\n";
+                        wipe();
+                        return false;
+                    }
+                    ctLen += ready;
+                    std::memmove(ctBuf.data(), ctBuf.data() + ready, total - ready);
+                }
+                pending = total - ready;
+            }
+            if (pending < tag.size())
+            {
+                std::cerr << "(decrypt) Input too short\n";
+                wipe();
+                return false;
+            }
+            std::memcpy(tag.data(), ctBuf.data(), tag.size());
+
+            seal::Cryptography::opensslCheck(
+                EVP_CIPHER_CTX_ctrl(
+                    verifyCtx.p, EVP_CTRL_GCM_SET_TAG, (int)tag.size(), tag.data()),
+                "SET_TAG failed");
+            unsigned char finBuf[16]{};
+            int fin = 0;
+            int ok = EVP_DecryptFinal_ex(verifyCtx.p, finBuf, &fin);
+            SecureZeroMemory(finBuf, sizeof(finBuf));
+            if (ok != 1)
+            {
+                std::cerr << "(decrypt) Authentication failed\n";
+                wipe();
+                return false;
+            }
+        }
+
+        // --- Pass 2: decrypt the now-authenticated ciphertext to stdout. A
+        // seekable input must not have changed underneath us in between.
+        if (seekable)
+        {
+            BY_HANDLE_FILE_INFORMATION infoAfter{};
+            if (!GetFileInformationByHandle(hIn, &infoAfter) ||
+                CompareFileTime(&infoBefore.ftLastWriteTime, &infoAfter.ftLastWriteTime) != 0 ||
+                infoBefore.nFileSizeLow != infoAfter.nFileSizeLow ||
+                infoBefore.nFileSizeHigh != infoAfter.nFileSizeHigh ||
+                !SetFilePointerEx(hIn, ctStart, nullptr, FILE_BEGIN))
+            {
+                std::cerr << "(decrypt) Input modified during verification\n";
+                wipe();
+                return false;
+            }
+        }
+        else if (!spool.rewind())
+        {
+            std::cerr << "(decrypt) Failed to stage ciphertext\n";
+            wipe();
+            return false;
+        }
+
+        seal::CachedCipherCtx writeCtx;
+        initCtx(writeCtx);
+        bool ioOk = true;
+        uint64_t remaining = ctLen;
+        while (ioOk && remaining > 0)
+        {
+            const size_t want =
+                static_cast<size_t>(std::min<uint64_t>(remaining, seal::cfg::FILE_CHUNK));
+            bool readOk = seekable ? readHandle(hIn, ctBuf.data(), want, got)
+                                   : spool.read(ctBuf.data(), want, got);
+            if (!readOk || got != want)
+            {
+                std::cerr << "(decrypt) Failed to re-read ciphertext\n";
+                wipe();
+                return false;
+            }
+            int outlen = 0;
+            seal::Cryptography::opensslCheck(
+                EVP_DecryptUpdate(
+                    writeCtx.p, plainBuf.data(), &outlen, ctBuf.data(), static_cast<int>(got)),
+                "DecryptUpdate(CT/write) failed");
+            ioOk = writeHandle(hOut, plainBuf.data(), static_cast<size_t>(outlen));
+            SecureZeroMemory(plainBuf.data(), static_cast<size_t>(outlen));
+            remaining -= got;
+        }
+
+        if (ioOk)
+        {
+            seal::Cryptography::opensslCheck(
+                EVP_CIPHER_CTX_ctrl(
+                    writeCtx.p, EVP_CTRL_GCM_SET_TAG, (int)tag.size(), tag.data()),
+                "SET_TAG(write) failed");
+            unsigned char finBuf[16]{};
+            int fin = 0;
+            // Pass 1 authenticated these bytes, but the second read is a
+            // fresh read (of a spool file, for a pipe); if what came back
+            // differs, the tag says so and the output must be disowned.
+            const int ok = EVP_DecryptFinal_ex(writeCtx.p, finBuf, &fin);
+            if (ok == 1)
+                ioOk = writeHandle(hOut, finBuf, static_cast<size_t>(fin));
+            SecureZeroMemory(finBuf, sizeof(finBuf));
+            if (ok != 1)
+            {
+                std::cerr << "(decrypt) Authentication failed\n";
+                wipe();
+                return false;
+            }
+        }
+
+        wipe();
+        if (!ioOk)
+        {
+            std::cerr << "(decrypt) Failed to write to stdout\n";
+            return false;
+        }
+        return true;
+    }
     catch (const std::exception& e)
     {
+        wipe();
         std::cerr << "(decrypt) " << e.what() << "\n";
         return false;
     }
 }
 
-bool FileOperations::shredFile(const std::string& path)
+namespace
 {
-    // Open with FILE_FLAG_WRITE_THROUGH to bypass the filesystem write cache
-    // and push data directly to the storage controller. This gives a stronger
-    // guarantee that overwrite passes hit the same physical sectors as
-    // the original data.
-    HANDLE hFile = CreateFileA(path.c_str(),
-                               GENERIC_READ | GENERIC_WRITE,
-                               0,
-                               nullptr,
-                               OPEN_EXISTING,
-                               FILE_FLAG_WRITE_THROUGH,
-                               nullptr);
-    if (hFile == INVALID_HANDLE_VALUE)
+
+// Volume GUID path (`\\?\Volume{...}`) of the volume holding @p path, with
+// the trailing backslash dropped so CreateFile opens the volume itself.
+// Empty for paths that do not resolve to a local volume (network shares).
+std::string volumeDevice(const std::string& path)
+{
+    char mount[MAX_PATH];
+    char guid[64];
+    if (!GetVolumePathNameA(path.c_str(), mount, MAX_PATH) ||
+        !GetVolumeNameForVolumeMountPointA(mount, guid, sizeof(guid)))
+        return {};
+    std::string device(guid);
+    if (!device.empty() && device.back() == '\\')
+        device.pop_back();
+    return device;
+}
+
+// True if the volume reports no seek penalty, i.e. sits on flash. A volume
+// that cannot be queried counts as rotational, which only costs the
+// extra passes.
+bool isSolidState(const std::string& device)
+{
+    if (device.empty())
+        return false;
+    HANDLE h = CreateFileA(device.c_str(),
+                           0,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           nullptr,
+                           OPEN_EXISTING,
+                           0,
+                           nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        return false;
+    STORAGE_PROPERTY_QUERY query{};
+    query.PropertyId = StorageDeviceSeekPenaltyProperty;
+    query.QueryType = PropertyStandardQuery;
+    DEVICE_SEEK_PENALTY_DESCRIPTOR desc{};
+    DWORD n = 0;
+    const BOOL ok = DeviceIoControl(h,
+                                    IOCTL_STORAGE_QUERY_PROPERTY,
+                                    &query,
+                                    sizeof(query),
+                                    &desc,
+                                    sizeof(desc),
+                                    &n,
+                                    nullptr);
+    CloseHandle(h);
+    return ok && n >= sizeof(desc) && !desc.IncursSeekPenalty;
+}
+
+// Overwrite @p path in place and delete it. Rotational media get three
+// passes (random, zeros, random). Flash gets one random pass and a TRIM
+// of the whole range: the FTL remaps every rewrite to fresh cells anyway,
+// so more passes only cost time and wear.
+//
+// The file is opened unbuffered and write-through so the passes go to the
+// device rather than the cache, and cfg::SHRED_DEPTH page-aligned
+// cfg::SHRED_CHUNK writes are kept in flight.
+bool shredWith(const std::string& path, bool solidState)
+{
+    OverlappedFile file;
+    if (!file.openOverwrite(path, true))
     {
         std::cerr << "(shred) cannot open: " << path << "\n";
         return false;
     }
 
-    LARGE_INTEGER liSize{};
-    if (!GetFileSizeEx(hFile, &liSize) || std::bit_cast<long long>(liSize) <= 0)
+    uint64_t fileSize = 0;
+    if (!file.size(fileSize) || fileSize == 0)
     {
-        CloseHandle(hFile);
+        file.close();
         // Empty or unreadable file - just delete it.
         return DeleteFileA(path.c_str()) != 0;
     }
 
-    auto fileSize = static_cast<size_t>(std::bit_cast<long long>(liSize));
-    constexpr size_t CHUNK = 65536;
-    std::vector<unsigned char> buf(std::min(fileSize, CHUNK));
+    // Unbuffered writes cover whole sectors. The padding past the end lands
+    // in the file's last cluster and goes away with the file.
+    const DWORD sector = file.sectorSize();
+    const uint64_t span = sector ? seal::cfg::align_up(fileSize, sector) : fileSize;
+    const size_t chunk = static_cast<size_t>(std::min<uint64_t>(span, seal::cfg::SHRED_CHUNK));
 
-    // Three overwrite passes: random, zeros, random.
-    for (int pass = 0; pass < 3; ++pass)
+    struct Slot
     {
-        // Rewind to the start for each pass.
-        LARGE_INTEGER zero{};
-        if (!SetFilePointerEx(hFile, zero, nullptr, FILE_BEGIN))
-        {
-            std::cerr << "(shred) seek failed pass " << (pass + 1) << ": " << path << "\n";
-            CloseHandle(hFile);
-            return false;
-        }
+        PageBuffer buf;
+        AsyncOp op;
+        size_t size = 0;
+    };
+    std::array<Slot, seal::cfg::SHRED_DEPTH> slots;
+    for (auto& slot : slots)
+        slot.buf.allocate(chunk);
 
-        size_t remaining = fileSize;
-        while (remaining > 0)
-        {
-            size_t chunk = std::min(remaining, buf.size());
-            if (pass == 1)
-            {
-                std::fill_n(buf.data(), chunk, static_cast<unsigned char>(0));
-            }
-            else
-            {
-                RAND_bytes(buf.data(), static_cast<int>(chunk));
-            }
+    auto drain = [&](Slot& slot)
+    {
+        size_t written = 0;
+        return !slot.op.pending || (file.finish(slot.op, written) && written == slot.size);
+    };
 
-            DWORD written = 0;
-            if (!WriteFile(hFile, buf.data(), static_cast<DWORD>(chunk), &written, nullptr) ||
-                written != static_cast<DWORD>(chunk))
+    const int passes = solidState ? 1 : 3;
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        bool ok = true;
+        size_t next = 0;
+        for (uint64_t offset = 0; ok && offset < span; offset += chunk)
+        {
+            Slot& slot = slots[next++ % slots.size()];
+            if (!drain(slot))
             {
-                std::cerr << "(shred) write failed pass " << (pass + 1) << ": " << path << "\n";
-                CloseHandle(hFile);
-                return false;
+                ok = false;
+                break;
             }
-            remaining -= chunk;
+            slot.size = static_cast<size_t>(std::min<uint64_t>(chunk, span - offset));
+            if (pass == 1)
+                std::fill_n(slot.buf.data(), slot.size, static_cast<unsigned char>(0));
+            else if (RAND_bytes(slot.buf.data(), static_cast<int>(slot.size)) != 1)
+                ok = false;
+            ok = ok && file.beginWrite(slot.op, offset, slot.buf.data(), slot.size);
+        }
+        if (!ok)
+            file.cancel();
+        for (auto& slot : slots)
+            ok = drain(slot) && ok;
+        if (!ok || !file.flush())
+        {
+            std::cerr << "(shred) write failed pass " << (pass + 1) << ": " << path << "\n";
+            return false;
         }
-        FlushFileBuffers(hFile);
     }
 
-    CloseHandle(hFile);
-    SecureZeroMemory(buf.data(), buf.size());
+    // Best effort: FAT volumes and some drivers do not support TRIM.
+    if (solidState)
+        (void)file.trim(span);
+    file.close();
 
     if (!DeleteFileA(path.c_str()))
     {
@@ -933,292 +2379,1030 @@ bool FileOperations::shredFile(const std::string& path)
     return true;
 }
 
-std::string FileOperations::hashFile(const std::string& path)
+}  // namespace
+
+bool FileOperations::shredFile(const std::string& path)
 {
-    std::ifstream in(path, std::ios::binary);
-    if (!in)
-    {
-        std::cerr << "(hash) cannot open: " << path << "\n";
-        return {};
-    }
+    return shredWith(path, isSolidState(volumeDevice(path)));
+}
 
-    seal::EvpMdCtx ctx;
-    if (EVP_DigestInit_ex(ctx.p, EVP_sha256(), nullptr) != 1)
-        return {};
+bool FileOperations::shredDirectory(const std::string& dir)
+{
+    namespace fs = std::filesystem;
 
-    constexpr size_t CHUNK = 65536;
-    char buf[CHUNK];
-    while (in.read(buf, CHUNK) || in.gcount() > 0)
+    // Files of one volume, shredded by lanes that each take the next
+    // unclaimed file. A rotational volume gets one lane, since parallel
+    // writes there only add seeks; flash gets cfg::SHRED_SSD_LANES.
+    struct Volume
     {
-        if (EVP_DigestUpdate(ctx.p, buf, static_cast<size_t>(in.gcount())) != 1)
-            return {};
-        if (in.eof())
-            break;
-    }
-
-    unsigned char hash[EVP_MAX_MD_SIZE];
-    unsigned int hashLen = 0;
-    if (EVP_DigestFinal_ex(ctx.p, hash, &hashLen) != 1)
-        return {};
-
-    return seal::utils::to_hex(std::span<const unsigned char>(hash, hashLen));
-}
+        std::string device;
+        bool solidState = false;
+        std::vector<std::string> files;
+        std::atomic<size_t> next{0};
+    };
 
-// Streaming encryption: reads the source file in cfg::FILE_CHUNK increments,
-// feeds each chunk to EVP_EncryptUpdate, and writes ciphertext incrementally.
-// The wire format is identical to encryptPacket (AAD | salt | IV | ct | tag)
-// so the output is interoperable with all existing decrypt paths.
-template <secure_password SecurePwd>
-bool FileOperations::encryptFileStreaming(const std::string& srcPath,
-                                          const std::string& dstPath,
-                                          const SecurePwd& pwd)
-{
-    std::ifstream in(srcPath, std::ios::binary);
-    if (!in)
+    std::error_code ec;
+    const fs::path root = fs::absolute(dir, ec);
+    if (ec)
     {
-        std::cerr << "(encrypt-stream) cannot open: " << srcPath << "\n";
+        std::cerr << "(shred) bad path: " << dir << "\n";
         return false;
     }
 
-    // Generate salt and IV
-    std::vector<unsigned char> salt(seal::cfg::SALT_LEN);
-    seal::Cryptography::opensslCheck(RAND_bytes(salt.data(), (int)salt.size()),
-                                     "RAND_bytes(salt) failed");
-    std::vector<unsigned char> iv(seal::cfg::IV_LEN);
-    seal::Cryptography::opensslCheck(RAND_bytes(iv.data(), (int)iv.size()),
-                                     "RAND_bytes(iv) failed");
-
-    auto key = seal::Cryptography::deriveKey(pwd, std::span<const unsigned char>(salt));
-
-    seal::EvpCipherCtx ctx;
-    seal::Cryptography::opensslCheck(
-        EVP_EncryptInit_ex(ctx.p, EVP_aes_256_gcm(), nullptr, nullptr, nullptr),
-        "EncryptInit(cipher) failed");
-    seal::Cryptography::opensslCheck(
-        EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)iv.size(), nullptr),
-        "SET_IVLEN failed");
-    seal::Cryptography::opensslCheck(
-        EVP_EncryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv.data()),
-        "EncryptInit(key/iv) failed");
-
-    // Feed AAD
-    std::span<const unsigned char> aad = seal::Cryptography::aadSpan();
-    if (!aad.empty())
-    {
-        int tmp = 0;
-        seal::Cryptography::opensslCheck(
-            EVP_EncryptUpdate(ctx.p, nullptr, &tmp, aad.data(), (int)aad.size()),
-            "EncryptUpdate(AAD) failed");
-    }
+    // Volumes are resolved per directory rather than per file; a file sits
+    // on the same volume as its parent unless the parent is a mount point.
+    std::deque<Volume> volumes;
+    std::unordered_map<std::string, Volume*> byDirectory;
+    auto volumeFor = [&](const fs::path& parent) -> Volume&
+    {
+        auto [it, added] = byDirectory.try_emplace(parent.string(), nullptr);
+        if (added)
+        {
+            std::string device = volumeDevice(parent.string());
+            auto same = std::find_if(volumes.begin(),
+                                     volumes.end(),
+                                     [&](const Volume& v) { return v.device == device; });
+            if (same == volumes.end())
+            {
+                Volume& v = volumes.emplace_back();
+                v.solidState = isSolidState(device);
+                v.device = std::move(device);
+                same = std::prev(volumes.end());
+            }
+            it->second = &*same;
+        }
+        return *it->second;
+    };
 
-    // Open output via atomic tmp file
-    std::string tmpPath = dstPath + ".tmp";
-    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
-    if (!out)
+    // Links are removed, never followed, and directories are removed
+    // deepest first once every file under them is gone.
+    std::vector<fs::path> links;
+    std::vector<fs::path> directories{root};
+    bool ok = true;
+    const auto options = fs::directory_options::skip_permission_denied;
+    for (fs::recursive_directory_iterator it(root, options, ec), end; !ec && it != end;
+         it.increment(ec))
     {
-        std::cerr << "(encrypt-stream) cannot write temp file: " << tmpPath << "\n";
-        seal::Cryptography::cleanseString(key);
+        if (it->is_symlink(ec))
+        {
+            if (it->is_directory(ec))
+                it.disable_recursion_pending();
+            links.push_back(it->path());
+            continue;
+        }
+        if (it->is_directory(ec))
+            directories.push_back(it->path());
+        else if (it->is_regular_file(ec))
+            volumeFor(it->path().parent_path()).files.push_back(it->path().string());
+    }
+    if (ec)
+    {
+        std::cerr << "(shred) cannot list: " << dir << "\n";
         return false;
     }
 
-    // Write header: AAD | salt | IV
-    if (!aad.empty())
+    std::atomic<size_t> pending{0};
+    std::atomic<bool> allShredded{true};
+    auto& scheduler = GetScheduler();
+    for (auto& volume : volumes)
     {
-        out.write(reinterpret_cast<const char*>(aad.data()), (std::streamsize)aad.size());
+        const size_t lanes = std::min<size_t>(
+            volume.files.size(), volume.solidState ? seal::cfg::SHRED_SSD_LANES : 1);
+        pending.fetch_add(lanes, std::memory_order_relaxed);
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            scheduler.spawn(
+                [&volume, &pending, &allShredded]
+                {
+                    for (size_t i = volume.next.fetch_add(1, std::memory_order_relaxed);
+                         i < volume.files.size();
+                         i = volume.next.fetch_add(1, std::memory_order_relaxed))
+                    {
+                        bool shredded = false;
+                        try
+                        {
+                            shredded = shredWith(volume.files[i], volume.solidState);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            std::cerr << "(shred) " << volume.files[i] << ": " << e.what()
+                                      << "\n";
+                        }
+                        if (!shredded)
+                            allShredded.store(false, std::memory_order_relaxed);
+                    }
+                    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        GetScheduler().notifyAll();
+                });
+        }
     }
-    out.write(reinterpret_cast<const char*>(salt.data()), (std::streamsize)salt.size());
-    out.write(reinterpret_cast<const char*>(iv.data()), (std::streamsize)iv.size());
-
-    // Encrypt in chunks
-    std::vector<unsigned char> plainBuf(seal::cfg::FILE_CHUNK);
-    std::vector<unsigned char> ctBuf(seal::cfg::FILE_CHUNK + 16);  // block slop
-    bool ioOk = true;
+    scheduler.runUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
 
-    while (in)
+    // A failed file keeps its directories, so nothing else is reported
+    // for them.
+    if (!allShredded.load(std::memory_order_relaxed))
+        return false;
+    for (const auto& link : links)
     {
-        in.read(reinterpret_cast<char*>(plainBuf.data()), (std::streamsize)plainBuf.size());
-        auto bytesRead = static_cast<size_t>(in.gcount());
-        if (bytesRead == 0)
-            break;
-
-        int outlen = 0;
-        seal::Cryptography::opensslCheck(
-            EVP_EncryptUpdate(
-                ctx.p, ctBuf.data(), &outlen, plainBuf.data(), static_cast<int>(bytesRead)),
-            "EncryptUpdate(PT) failed");
-
-        SecureZeroMemory(plainBuf.data(), bytesRead);
-        out.write(reinterpret_cast<const char*>(ctBuf.data()), outlen);
-        if (!out)
+        if (!fs::remove(link, ec))
         {
-            ioOk = false;
-            break;
+            std::cerr << "(shred) failed to delete link: " << link.string() << "\n";
+            ok = false;
         }
     }
-    in.close();
-
-    if (ioOk)
+    for (auto it = directories.rbegin(); ok && it != directories.rend(); ++it)
     {
-        // Finalize
-        int fin = 0;
-        seal::Cryptography::opensslCheck(EVP_EncryptFinal_ex(ctx.p, ctBuf.data(), &fin),
-                                         "EncryptFinal failed");
-        if (fin > 0)
+        if (!fs::remove(*it, ec))
         {
-            out.write(reinterpret_cast<const char*>(ctBuf.data()), fin);
+            std::cerr << "(shred) failed to remove directory: " << it->string() << "\n";
+            ok = false;
         }
-
-        // Write GCM tag
-        std::vector<unsigned char> tag(seal::cfg::TAG_LEN);
-        seal::Cryptography::opensslCheck(
-            EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_GET_TAG, (int)tag.size(), tag.data()),
-            "GET_TAG failed");
-        out.write(reinterpret_cast<const char*>(tag.data()), (std::streamsize)tag.size());
-        out.flush();
-        ioOk = out.good();
     }
+    return ok;
+}
 
-    seal::Cryptography::cleanseString(key);
-    SecureZeroMemory(plainBuf.data(), plainBuf.size());
-    SecureZeroMemory(ctBuf.data(), ctBuf.size());
-    out.close();
+namespace
+{
 
-    if (ioOk)
+// Feed one mapped view to the digest.  A network drop or a failing disk
+// surfaces as EXCEPTION_IN_PAGE_ERROR on the page fault rather than as a
+// read error, so the touch happens under SEH.  No C++ objects live in this
+// frame, as __try requires.
+bool digestMappedView(EVP_MD_CTX* ctx, const unsigned char* view, size_t len)
+{
+    __try
     {
-        flushFileToDisk(tmpPath);
+        return EVP_DigestUpdate(ctx, view, len) == 1;
+    }
+    __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER
+                                                            : EXCEPTION_CONTINUE_SEARCH)
+    {
+        return false;
+    }
+}
 
-        if (!MoveFileExA(tmpPath.c_str(), dstPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+bool digestMapped(EVP_MD_CTX* ctx, HANDLE hFile, uint64_t size)
+{
+    HANDLE hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!hMap)
+        return false;
+
+    bool ok = true;
+    for (uint64_t offset = 0; ok && offset < size; offset += seal::cfg::HASH_MAP_VIEW)
+    {
+        const size_t len =
+            static_cast<size_t>(std::min<uint64_t>(seal::cfg::HASH_MAP_VIEW, size - offset));
+        void* view = MapViewOfFile(hMap,
+                                   FILE_MAP_READ,
+                                   static_cast<DWORD>(offset >> 32),
+                                   static_cast<DWORD>(offset & 0xFFFFFFFF),
+                                   len);
+        if (!view)
         {
-            std::cerr << "(encrypt-stream) cannot rename to destination: " << dstPath << "\n";
-            DeleteFileA(tmpPath.c_str());
-            return false;
+            ok = false;
+            break;
         }
-        return true;
+        ok = digestMappedView(ctx, static_cast<const unsigned char*>(view), len);
+        UnmapViewOfFile(view);
     }
-
-    std::cerr << "(encrypt-stream) write error: " << tmpPath << "\n";
-    DeleteFileA(tmpPath.c_str());
-    return false;
+    CloseHandle(hMap);
+    return ok;
 }
 
-// Streaming decryption with two-pass authentication.
-//
-// Pass 1 (verify): streams the entire ciphertext through GCM decryption into
-// a scratch buffer (immediately wiped) and checks the authentication tag via
-// EVP_DecryptFinal_ex. No plaintext is written to disk during this pass.
-// If the tag fails, the function returns false without ever creating a file.
+bool digestRead(EVP_MD_CTX* ctx, HANDLE hFile)
+{
+    constexpr DWORD CHUNK = 65536;
+    std::vector<unsigned char> buf(CHUNK);
+    for (;;)
+    {
+        DWORD got = 0;
+        if (!ReadFile(hFile, buf.data(), CHUNK, &got, nullptr))
+            return false;
+        if (got == 0)
+            return true;
+        if (EVP_DigestUpdate(ctx, buf.data(), got) != 1)
+            return false;
+    }
+}
+
+}  // namespace
+
+std::string FileOperations::hashFile(const std::string& path, HashAlgorithm algo)
+{
+    HANDLE hFile = CreateFileA(path.c_str(),
+                               GENERIC_READ,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr,
+                               OPEN_EXISTING,
+                               FILE_FLAG_SEQUENTIAL_SCAN,
+                               nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        std::cerr << "(hash) cannot open: " << path << "\n";
+        return {};
+    }
+
+    seal::EvpMdCtx ctx;
+    const EVP_MD* md = (algo == HashAlgorithm::Blake2b) ? EVP_blake2b512() : EVP_sha256();
+    LARGE_INTEGER size{};
+    bool ok = GetFileSizeEx(hFile, &size) && EVP_DigestInit_ex(ctx.p, md, nullptr) == 1;
+    if (ok)
+    {
+        // Mapping has a fixed setup cost; below the threshold a few reads
+        // are cheaper.  A zero-length file cannot be mapped at all.
+        const uint64_t bytes = static_cast<uint64_t>(size.QuadPart);
+        ok = bytes >= seal::cfg::HASH_MAP_MIN ? digestMapped(ctx.p, hFile, bytes)
+                                              : digestRead(ctx.p, hFile);
+    }
+    CloseHandle(hFile);
+    if (!ok)
+    {
+        std::cerr << "(hash) read failed: " << path << "\n";
+        return {};
+    }
+
+    unsigned char hash[EVP_MAX_MD_SIZE];
+    unsigned int hashLen = 0;
+    if (EVP_DigestFinal_ex(ctx.p, hash, &hashLen) != 1)
+        return {};
+
+    return seal::utils::to_hex(std::span<const unsigned char>(hash, hashLen));
+}
+
+bool FileOperations::hashDirectory(const std::string& dir, std::ostream& out, HashAlgorithm algo)
+{
+    namespace fs = std::filesystem;
+
+    struct HashJob
+    {
+        fs::path path;
+        std::string rel;
+        std::string digest;
+    };
+
+    std::error_code ec;
+    const fs::path root = fs::absolute(dir, ec);
+    if (ec)
+    {
+        std::cerr << "(hash) bad path: " << dir << "\n";
+        return false;
+    }
+
+    // Listing first keeps the output order independent of which worker
+    // finished when; the jobs vector is not resized after this.
+    std::vector<HashJob> jobs;
+    bool ok = true;
+    const auto options = fs::directory_options::skip_permission_denied;
+    for (fs::recursive_directory_iterator it(root, options, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        if (it->is_symlink(ec))
+        {
+            if (it->is_directory(ec))
+                it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file(ec))
+            continue;
+        jobs.push_back({it->path(), it->path().lexically_relative(root).generic_string(), {}});
+    }
+    if (ec)
+    {
+        std::cerr << "(hash) cannot list: " << dir << "\n";
+        ok = false;
+    }
+
+    std::atomic<size_t> pending{jobs.size()};
+    auto& scheduler = GetScheduler();
+    for (auto& job : jobs)
+    {
+        scheduler.spawn(
+            [&job, &pending, algo]
+            {
+                try
+                {
+                    job.digest = hashFile(job.path.string(), algo);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "(hash) " << job.rel << ": " << e.what() << "\n";
+                }
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    GetScheduler().notifyAll();
+            });
+    }
+    scheduler.runUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
+
+    std::sort(jobs.begin(),
+              jobs.end(),
+              [](const HashJob& a, const HashJob& b) { return a.rel < b.rel; });
+    for (const auto& job : jobs)
+    {
+        if (job.digest.empty())
+        {
+            ok = false;
+            continue;
+        }
+        out << job.digest << "  " << job.rel << "\n";
+    }
+    out.flush();
+    return ok && out.good();
+}
+
+// Streaming encryption: writes the segmented (STREAM) format, reading the
+// source one cfg::SEGMENT_LEN segment at a time and sealing each under its
+// own tag on a SegmentPipeline. One segment of read-ahead tells us which
+// segment is the last, so growing or short files are handled without
+// trusting a size taken up front.
 //
-// Pass 2 (write): re-reads the ciphertext and decrypts again, this time
-// writing plaintext to a temp file. Since authentication passed in pass 1,
-// the data is known-authentic. The temp file is flushed, renamed to the
-// destination, and the key is wiped.
+// Both files use overlapped I/O: while the workers seal, the next segment
+// is already being read and earlier ones are being written. The plaintext
+// source is read unbuffered where the volume allows it, so encrypting a file
+// does not leave a plaintext copy in the system cache.
 //
-// The two-pass approach costs one extra file read and one extra decrypt, but
-// guarantees that unauthenticated plaintext never reaches disk -- critical for
-// a credential manager where tampered ciphertext must not produce recoverable
-// plaintext.
+// With Cryptography::segmentCompression() on, the workers also compress
+// each segment that shrinks enough, so segments land at running offsets
+// instead of fixed strides and the segment table is written last.
+//
+// A file that fits in a single segment skips the pipeline and is sealed
+// on the calling thread; the output format is the same.
 template <secure_password SecurePwd>
-bool FileOperations::decryptFileStreaming(const std::string& srcPath,
+bool FileOperations::encryptFileStreaming(const std::string& srcPath,
                                           const std::string& dstPath,
-                                          const SecurePwd& pwd)
+                                          const SecurePwd& pwd,
+                                          unsigned threads,
+                                          FileKeyring* keyring)
 {
-    // Snapshot the file's last-write time before reading so we can detect
-    // modifications between the verification pass and the write pass (TOCTOU).
-    WIN32_FILE_ATTRIBUTE_DATA fileAttrBefore{};
-    if (!GetFileAttributesExA(srcPath.c_str(), GetFileExInfoStandard, &fileAttrBefore))
+    OverlappedFile in;
+    if (!in.openRead(srcPath, true))
     {
-        std::cerr << "(decrypt-stream) cannot stat: " << srcPath << "\n";
+        std::cerr << "(encrypt-stream) cannot open: " << srcPath << "\n";
         return false;
     }
 
-    std::ifstream in(srcPath, std::ios::binary);
-    if (!in)
+    // Batch files share the keyring's salt and seal under a per-file HKDF
+    // key; a lone file draws its own salt and runs the KDF itself.
+    const bool compress = seal::Cryptography::segmentCompression();
+    const seal::AeadAlgorithm aead = seal::Cryptography::aead();
+    std::vector<unsigned char> header;
+    seal::Cryptography::LockedKeyBuffer key;
+    if (keyring)
     {
-        std::cerr << "(decrypt-stream) cannot open: " << srcPath << "\n";
+        header = seal::Cryptography::makeSegmentHeader(
+            keyring->salt(), true, keyring->kdf(), compress, aead);
+        key = keyring->fileKey(pwd, header);
+    }
+    else
+    {
+        std::vector<unsigned char> salt(seal::cfg::SALT_LEN);
+        seal::Cryptography::opensslCheck(RAND_bytes(salt.data(), (int)salt.size()),
+                                         "RAND_bytes(salt) failed");
+        const seal::KdfParams kdf = seal::Cryptography::kdfParams();
+        header = seal::Cryptography::makeSegmentHeader(salt, false, kdf, compress, aead);
+        key = seal::Cryptography::deriveKey(pwd, std::span<const unsigned char>(salt), kdf);
+    }
+
+    // Open output via atomic tmp file
+    std::string tmpPath = dstPath + ".tmp";
+    OverlappedFile out;
+    if (!out.create(tmpPath, false))
+    {
+        std::cerr << "(encrypt-stream) cannot write temp file: " << tmpPath << "\n";
+        seal::Cryptography::cleanseString(key);
         return false;
     }
 
-    // Determine file size
-    in.seekg(0, std::ios::end);
-    auto fileSize = static_cast<size_t>(in.tellg());
-    in.seekg(0, std::ios::beg);
+    // Anything thrown from here on (the pipeline's allocations and worker
+    // start, an OpenSSL failure) still wipes the key and removes the temp
+    // file below, like the other streaming paths.
+    bool ioOk = false;
+    try
+    {
+        {
+            AsyncOp op;
+            size_t n = 0;
+            ioOk = out.beginWrite(op, 0, header.data(), header.size()) && out.finish(op, n) &&
+                   n == header.size();
+        }
 
-    std::span<const unsigned char> aadExpected = seal::Cryptography::aadSpan();
-    size_t headerSize = aadExpected.size() + seal::cfg::SALT_LEN + seal::cfg::IV_LEN;
+        const unsigned workers = resolveThreads(threads);
+        seal::Cryptography::SegmentTable table;
+        uint64_t writeAt = header.size();  // where the next sealed segment goes
+
+        // A file that fits in one segment is sealed right here, under the
+        // same (keyring) key: a SegmentPipeline's worker threads and ring
+        // of segment buffers would cost far more than the file itself, and
+        // a directory batch is mostly small files. The read asks for one
+        // byte more than the file held, so a file that grew since shows up
+        // as a full read and takes the pipeline instead.
+        bool inlined = false;
+        uint64_t srcSize = 0;
+        if (ioOk && in.size(srcSize) && srcSize < seal::cfg::SEGMENT_LEN)
+        {
+            const size_t want =
+                seal::align_up(static_cast<size_t>(srcSize) + 1, seal::cachedPageSize());
+            PageBuffer plainBuf;
+            plainBuf.allocate(want);
+            AsyncOp readOp;
+            size_t got = 0;
+            ioOk = in.beginRead(readOp, 0, plainBuf.data(), want) && in.finish(readOp, got);
+            if (ioOk && got < want)
+            {
+                PageBuffer sealedBuf;
+                sealedBuf.allocate(got + seal::cfg::TAG_LEN);
+                const auto plain = std::span<const unsigned char>(plainBuf.data(), got);
+                size_t sealedSize = got + seal::cfg::TAG_LEN;
+                if (compress)
+                {
+                    const auto entry = seal::Cryptography::sealCompressedSegment(
+                        key, header, 0, plain, sealedBuf.data());
+                    sealedSize = seal::Cryptography::SegmentTable::storedSize(entry);
+                    table.plainSize = got;
+                    table.entries.push_back(entry);
+                }
+                else
+                {
+                    seal::Cryptography::sealSegment(key, header, 0, true, plain, sealedBuf.data());
+                }
+                AsyncOp writeOp;
+                size_t n = 0;
+                ioOk = out.beginWrite(writeOp, writeAt, sealedBuf.data(), sealedSize) &&
+                       out.finish(writeOp, n) && n == sealedSize;
+                writeAt += sealedSize;
+                inlined = true;
+            }
+        }
 
-    if (fileSize < headerSize + seal::cfg::TAG_LEN)
+        if (!inlined)
+        {
+            SegmentPipeline pipeline(
+                workers,
+                seal::cfg::SEGMENT_LEN,
+                seal::cfg::SEGMENT_LEN + seal::cfg::TAG_LEN,
+                [&](SegmentSlot& slot)
+                {
+                    const auto plain = std::span<const unsigned char>(slot.in.data(), slot.inSize);
+                    if (compress)
+                    {
+                        slot.entry = seal::Cryptography::sealCompressedSegment(
+                            key, header, slot.index, plain, slot.out.data());
+                        slot.outSize = seal::Cryptography::SegmentTable::storedSize(slot.entry);
+                    }
+                    else
+                    {
+                        seal::Cryptography::sealSegment(
+                            key, header, slot.index, slot.last, plain, slot.out.data());
+                        slot.outSize = slot.inSize + seal::cfg::TAG_LEN;
+                    }
+                    SecureZeroMemory(slot.in.data(), slot.inSize);
+                    return true;
+                });
+
+            uint64_t issued = 0;     // reads begun for segments [0, issued)
+            uint64_t flushed = 0;    // writes begun for segments [0, flushed)
+            uint64_t submitted = 0;  // segments handed to the workers
+
+            // Begin writing segment `index` once it is sealed; segments leave
+            // in order and the write completes in the background.
+            auto flush = [&](uint64_t index)
+            {
+                SegmentSlot& slot = pipeline.slot(index);
+                if (!pipeline.wait(index))
+                {
+                    std::cerr << "(encrypt-stream) encryption failed: " << srcPath << "\n";
+                    return false;
+                }
+                if (compress)
+                {
+                    table.plainSize += slot.inSize;
+                    table.entries.push_back(slot.entry);
+                }
+                const uint64_t at = writeAt;
+                writeAt += slot.outSize;
+                return out.beginWrite(slot.writeOp, at, slot.out.data(), slot.outSize);
+            };
+            // Free slot(index) for reuse: the segment it last held must be on disk.
+            auto reclaim = [&](uint64_t index)
+            {
+                if (index < pipeline.depth())
+                    return true;
+                const uint64_t prev = index - pipeline.depth();
+                while (flushed <= prev)
+                {
+                    if (!flush(flushed++))
+                        return false;
+                }
+                SegmentSlot& slot = pipeline.slot(prev);
+                size_t n = 0;
+                return out.finish(slot.writeOp, n) && n == slot.outSize;
+            };
+            auto readAhead = [&](uint64_t upTo)
+            {
+                for (; issued < upTo; ++issued)
+                {
+                    if (!reclaim(issued))
+                        return false;
+                    SegmentSlot& slot = pipeline.slot(issued);
+                    if (!in.beginRead(slot.readOp,
+                                      issued * seal::cfg::SEGMENT_LEN,
+                                      slot.in.data(),
+                                      seal::cfg::SEGMENT_LEN))
+                        return false;
+                }
+                return true;
+            };
+            auto finishRead = [&](uint64_t index, size_t& got)
+            { return in.finish(pipeline.slot(index).readOp, got); };
+
+            // Settle every request before the slot buffers go away; after a
+            // failure whatever is still queued is cancelled first.
+            auto settle = [&]
+            {
+                if (!ioOk)
+                {
+                    in.cancel();
+                    out.cancel();
+                }
+                for (uint64_t s = 0; s < pipeline.depth(); ++s)
+                {
+                    SegmentSlot& slot = pipeline.slot(s);
+                    size_t n = 0;
+                    if (slot.readOp.pending)
+                        (void)in.finish(slot.readOp, n);
+                    if (slot.writeOp.pending)
+                    {
+                        const bool wrote = out.finish(slot.writeOp, n) && n == slot.outSize;
+                        ioOk = ioOk && wrote;
+                    }
+                }
+            };
+
+            try
+            {
+                // Segment 0, the peek at segment 1, and one more read in flight.
+                size_t have = 0;
+                ioOk = ioOk && readAhead(3) && finishRead(0, have);
+                for (uint64_t i = 0; ioOk; ++i)
+                {
+                    // A short read means end of file; a full one needs a peek ahead.
+                    size_t ahead = 0;
+                    if (have == seal::cfg::SEGMENT_LEN && !(ioOk = finishRead(i + 1, ahead)))
+                        break;
+                    const bool last = ahead == 0;
+                    pipeline.slot(i).inSize = have;
+                    pipeline.submit(i, last);
+                    submitted = i + 1;
+                    if (last)
+                        break;
+                    have = ahead;
+                    // Writes trail the workers by one segment each; reads run ahead.
+                    while (ioOk && flushed + workers <= i)
+                        ioOk = flush(flushed++);
+                    ioOk = ioOk && readAhead(i + 4);
+                }
+                while (ioOk && flushed < submitted)
+                    ioOk = flush(flushed++);
+            }
+            catch (...)
+            {
+                ioOk = false;
+                settle();
+                throw;
+            }
+            settle();
+            // Any segments still in flight are finished (and wiped) by the
+            // pipeline destructor before key is cleansed below.
+        }
+        if (ioOk && compress)
+        {
+            const auto sealedTable = seal::Cryptography::sealSegmentTable(key, header, table);
+            AsyncOp op;
+            size_t n = 0;
+            ioOk = out.beginWrite(op, writeAt, sealedTable.data(), sealedTable.size()) &&
+                   out.finish(op, n) && n == sealedTable.size();
+        }
+    }
+    catch (const std::exception& e)
     {
-        std::cerr << "(decrypt-stream) file too short: " << srcPath << "\n";
-        return false;
+        std::cerr << "(encrypt-stream) " << e.what() << ": " << srcPath << "\n";
+        ioOk = false;
+    }
+    catch (...)
+    {
+        ioOk = false;
     }
+    in.close();
+    out.close();
+    seal::Cryptography::cleanseString(key);
 
-    // Read and verify AAD header
-    if (!aadExpected.empty())
+    if (ioOk)
     {
-        std::vector<unsigned char> aadBuf(aadExpected.size());
-        in.read(reinterpret_cast<char*>(aadBuf.data()), (std::streamsize)aadBuf.size());
-        if (std::memcmp(aadBuf.data(), aadExpected.data(), aadExpected.size()) != 0)
+        flushFileToDisk(tmpPath);
+
+        if (!MoveFileExA(tmpPath.c_str(), dstPath.c_str(), MOVEFILE_REPLACE_EXISTING))
         {
-            std::cerr << "(decrypt-stream) bad AAD header: " << srcPath << "\n";
+            std::cerr << "(encrypt-stream) cannot rename to destination: " << dstPath << "\n";
+            DeleteFileA(tmpPath.c_str());
             return false;
         }
+        return true;
     }
 
-    // Read salt and IV
-    std::vector<unsigned char> salt(seal::cfg::SALT_LEN);
-    in.read(reinterpret_cast<char*>(salt.data()), (std::streamsize)salt.size());
-    std::vector<unsigned char> iv(seal::cfg::IV_LEN);
-    in.read(reinterpret_cast<char*>(iv.data()), (std::streamsize)iv.size());
+    std::cerr << "(encrypt-stream) I/O error: " << srcPath << " -> " << tmpPath << "\n";
+    DeleteFileA(tmpPath.c_str());
+    return false;
+}
 
-    size_t ctLen = fileSize - headerSize - seal::cfg::TAG_LEN;
+// Single-pass decryption of the segmented format on a SegmentPipeline.
+// Every segment is authenticated before its plaintext is written, so
+// nothing unauthenticated reaches disk while the file is read and decrypted
+// only once. A failed segment deletes the temp file; the partial output
+// never becomes visible at dstPath.
+//
+// Reads and writes are overlapped with the workers as in
+// encryptFileStreaming. The plaintext output is written unbuffered where
+// the volume allows it; the final segment is padded to a whole sector and
+// the file trimmed to its real length afterwards.
+//
+// Compressed files read their segment table first; it gives every
+// segment's offset, so the pipeline runs exactly as for fixed strides.
+template <secure_password SecurePwd>
+bool FileOperations::decryptSegmentedFile(const std::string& srcPath,
+                                          const std::string& dstPath,
+                                          const SecurePwd& pwd,
+                                          unsigned threads,
+                                          FileKeyring* keyring)
+{
+    OverlappedFile in;
+    uint64_t fileSize = 0;
+    if (!in.openRead(srcPath, false) || !in.size(fileSize))
+    {
+        std::cerr << "(decrypt-stream) cannot open: " << srcPath << "\n";
+        return false;
+    }
 
-    // Read the GCM tag from the end of the file, then seek back to ciphertext start
-    auto ctStartPos = in.tellg();
-    in.seekg(-(std::streamoff)seal::cfg::TAG_LEN, std::ios::end);
-    std::vector<unsigned char> tag(seal::cfg::TAG_LEN);
-    in.read(reinterpret_cast<char*>(tag.data()), (std::streamsize)tag.size());
-    in.seekg(ctStartPos);
+    // Read enough for either header variant, then keep the one the magic names.
+    std::vector<unsigned char> header(std::min<uint64_t>(
+        fileSize, seal::cfg::SEGMENT_KEYED_HEADER_LEN + seal::cfg::KDF_PARAMS_LEN));
+    size_t segLen = 0;
+    try
+    {
+        AsyncOp op;
+        size_t got = 0;
+        if (header.size() < seal::cfg::SEGMENT_HEADER_LEN ||
+            !in.beginRead(op, 0, header.data(), header.size()) || !in.finish(op, got) ||
+            got != header.size())
+            throw std::runtime_error("Ciphertext too short");
+        segLen = seal::Cryptography::segmentSize(header);
+        header.resize(seal::Cryptography::segmentHeaderSize(header));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "(decrypt-stream) " << e.what() << ": " << srcPath << "\n";
+        return false;
+    }
+
+    const bool compressed = seal::Cryptography::isCompressedSegmentPacket(header);
+    const uint64_t stride = segLen + seal::cfg::TAG_LEN;
+    const uint64_t bodyLen = fileSize - header.size();
+    if (!compressed && (bodyLen < seal::cfg::TAG_LEN ||
+                        (bodyLen % stride != 0 && bodyLen % stride < seal::cfg::TAG_LEN)))
+    {
+        std::cerr << "(decrypt-stream) truncated or malformed file: " << srcPath << "\n";
+        return false;
+    }
+    uint64_t segments = (bodyLen + stride - 1) / stride;
+    uint64_t plainTotal = bodyLen - segments * seal::cfg::TAG_LEN;
+
+    std::string tmpPath = dstPath + ".tmp";
+    OverlappedFile out;
+    if (!out.create(tmpPath, true))
+    {
+        std::cerr << "(decrypt-stream) cannot write temp file: " << tmpPath << "\n";
+        return false;
+    }
 
+    seal::Cryptography::LockedKeyBuffer key;
+    bool ok = true;
     try
     {
-        auto key = seal::Cryptography::deriveKey(pwd, std::span<const unsigned char>(salt));
+        key = keyring ? keyring->fileKey(pwd, header)
+                      : seal::Cryptography::deriveSegmentKey(pwd, header);
 
-        // Helper: initialise a GCM decrypt context with the shared key/IV/AAD.
-        auto initCtx = [&](seal::EvpCipherCtx& ctx)
+        // Compressed: segment i is at offsets[i], table.entries[i] long.
+        seal::Cryptography::SegmentTable table;
+        std::vector<uint64_t> offsets;
+        if (compressed)
         {
-            seal::Cryptography::opensslCheck(
-                EVP_DecryptInit_ex(ctx.p, EVP_aes_256_gcm(), nullptr, nullptr, nullptr),
-                "DecryptInit(cipher) failed");
-            seal::Cryptography::opensslCheck(
-                EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)seal::cfg::IV_LEN, nullptr),
-                "SET_IVLEN failed");
-            seal::Cryptography::opensslCheck(
-                EVP_DecryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv.data()),
-                "DecryptInit(key/iv) failed");
-            if (!aadExpected.empty())
+            table = readSegmentTable(in, fileSize, key, header);
+            segments = table.entries.size();
+            plainTotal = table.plainSize;
+            offsets.resize(segments);
+            uint64_t at = header.size();
+            for (uint64_t i = 0; i < segments; ++i)
             {
-                int tmp = 0;
-                seal::Cryptography::opensslCheck(
-                    EVP_DecryptUpdate(
-                        ctx.p, nullptr, &tmp, aadExpected.data(), (int)aadExpected.size()),
-                    "DecryptUpdate(AAD) failed");
+                offsets[i] = at;
+                at += seal::Cryptography::SegmentTable::storedSize(table.entries[i]);
             }
+        }
+        auto plainSize = [&](uint64_t index)
+        { return static_cast<size_t>(std::min<uint64_t>(segLen, plainTotal - index * segLen)); };
+
+        const unsigned workers = resolveThreads(threads);
+        SegmentPipeline pipeline(
+            workers,
+            stride,
+            segLen,
+            [&](SegmentSlot& slot)
+            {
+                auto sealed = std::span<unsigned char>(slot.in.data(), slot.inSize);
+                if (compressed)
+                    return seal::Cryptography::openCompressedSegment(
+                        key,
+                        header,
+                        slot.index,
+                        slot.entry,
+                        sealed,
+                        std::span<unsigned char>(slot.out.data(), plainSize(slot.index)));
+                return seal::Cryptography::openSegment(
+                    key, header, slot.index, slot.last, sealed, slot.out.data());
+            });
+
+        uint64_t issued = 0;   // reads begun for segments [0, issued)
+        uint64_t flushed = 0;  // writes begun for segments [0, flushed)
+
+        // Begin writing segment `index` once it has authenticated; plaintext
+        // leaves strictly in order. Unbuffered writes cover whole sectors.
+        auto flush = [&](uint64_t index)
+        {
+            SegmentSlot& slot = pipeline.slot(index);
+            if (!pipeline.wait(index))
+            {
+                std::cerr << "(decrypt-stream) authentication failed: " << srcPath << "\n";
+                return false;
+            }
+            const size_t plainLen = plainSize(index);
+            slot.outSize = plainLen;
+            if (const DWORD sector = out.sectorSize())
+            {
+                slot.outSize = (plainLen + sector - 1) / sector * sector;
+                std::memset(slot.out.data() + plainLen, 0, slot.outSize - plainLen);
+            }
+            return out.beginWrite(slot.writeOp, index * segLen, slot.out.data(), slot.outSize);
         };
-
-        // Reusable buffers for both passes.
-        std::vector<unsigned char> ctBuf(seal::cfg::FILE_CHUNK);
-        std::vector<unsigned char> plainBuf(seal::cfg::FILE_CHUNK + 16);
-
-        // --- Pass 1: verify GCM tag without writing plaintext to disk ---
+        // Free slot(index) for reuse: the plaintext it last held must be on
+        // disk, and is wiped from the slot straight after.
+        auto reclaim = [&](uint64_t index)
         {
-            seal::EvpCipherCtx verifyCtx;
-            initCtx(verifyCtx);
+            if (index < pipeline.depth())
+                return true;
+            const uint64_t prev = index - pipeline.depth();
+            while (flushed <= prev)
+            {
+                if (!flush(flushed++))
+                    return false;
+            }
+            SegmentSlot& slot = pipeline.slot(prev);
+            size_t n = 0;
+            const bool wrote = out.finish(slot.writeOp, n) && n == slot.outSize;
+            SecureZeroMemory(slot.out.data(), slot.outSize);
+            if (!wrote)
+                std::cerr << "(decrypt-stream) write error: " << tmpPath << "\n";
+            return wrote;
+        };
+        auto take = [&](uint64_t index)
+        {
+            return compressed ? seal::Cryptography::SegmentTable::storedSize(table.entries[index])
+                              : std::min(stride, bodyLen - index * stride);
+        };
+        auto offset = [&](uint64_t index)
+        { return compressed ? offsets[index] : header.size() + index * stride; };
+        auto readAhead = [&](uint64_t upTo)
+        {
+            for (upTo = std::min(upTo, segments); issued < upTo; ++issued)
+            {
+                if (!reclaim(issued))
+                    return false;
+                SegmentSlot& slot = pipeline.slot(issued);
+                if (!in.beginRead(slot.readOp,
+                                  offset(issued),
+                                  slot.in.data(),
+                                  static_cast<size_t>(take(issued))))
+                    return false;
+            }
+            return true;
+        };
 
-            size_t remaining = ctLen;
-            while (remaining > 0)
+        for (uint64_t index = 0; ok && index < segments; ++index)
+        {
+            // This segment plus one more read in flight.
+            if (!(ok = readAhead(index + 2)))
+                break;
+            SegmentSlot& slot = pipeline.slot(index);
+            size_t got = 0;
+            if (!in.finish(slot.readOp, got) || got != take(index))
             {
-                size_t toRead = std::min(remaining, seal::cfg::FILE_CHUNK);
-                in.read(reinterpret_cast<char*>(ctBuf.data()), (std::streamsize)toRead);
+                std::cerr << "(decrypt-stream) read error: " << srcPath << "\n";
+                ok = false;
+                break;
+            }
+            slot.inSize = got;
+            slot.entry = compressed ? table.entries[index] : 0;
+            pipeline.submit(index, index + 1 == segments);
+            while (ok && flushed + workers <= index)
+                ok = flush(flushed++);
+        }
+        while (ok && flushed < segments)
+            ok = flush(flushed++);
+
+        // Settle every request before the slot buffers go away; after a
+        // failure whatever is still queued is cancelled first.
+        if (!ok)
+        {
+            in.cancel();
+            out.cancel();
+        }
+        for (uint64_t s = 0; s < pipeline.depth(); ++s)
+        {
+            SegmentSlot& slot = pipeline.slot(s);
+            size_t n = 0;
+            if (slot.readOp.pending)
+                (void)in.finish(slot.readOp, n);
+            if (slot.writeOp.pending)
+            {
+                const bool wrote = out.finish(slot.writeOp, n) && n == slot.outSize;
+                ok = ok && wrote;
+            }
+        }
+        if (ok && out.sectorSize() && !out.truncate(plainTotal))
+        {
+            std::cerr << "(decrypt-stream) write error: " << tmpPath << "\n";
+            ok = false;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "(decrypt-stream) " << e.what() << "\n";
+        ok = false;
+    }
+    in.close();
+    out.close();
+    seal::Cryptography::cleanseString(key);
+
+    if (!ok)
+    {
+        DeleteFileA(tmpPath.c_str());
+        return false;
+    }
+    flushFileToDisk(tmpPath);
+    if (!MoveFileExA(tmpPath.c_str(), dstPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        std::cerr << "(decrypt-stream) cannot rename to destination: " << dstPath << "\n";
+        DeleteFileA(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Streaming decryption. Segmented files go through decryptSegmentedFile in
+// a single pass; legacy single-tag packets use two-pass authentication.
+//
+// Pass 1 (verify): streams the entire ciphertext through GCM decryption into
+// a scratch buffer (immediately wiped) and checks the authentication tag via
+// EVP_DecryptFinal_ex. No plaintext is written to disk during this pass.
+// If the tag fails, the function returns false without ever creating a file.
+//
+// Pass 2 (write): re-reads the ciphertext and decrypts again, this time
+// writing plaintext to a temp file. Since authentication passed in pass 1,
+// the data is known-authentic. The temp file is flushed, renamed to the
+// destination, and the key is wiped.
+//
+// The two-pass approach costs one extra file read and one extra decrypt, but
+// guarantees that unauthenticated plaintext never reaches disk -- critical for
+// a credential manager where tampered ciphertext must not produce recoverable
+// plaintext.
+template <secure_password SecurePwd>
+bool FileOperations::decryptFileStreaming(const std::string& srcPath,
+                                          const std::string& dstPath,
+                                          const SecurePwd& pwd,
+                                          unsigned threads,
+                                          FileKeyring* keyring)
+{
+    // Snapshot the file's last-write time before reading so we can detect
+    // modifications between the verification pass and the write pass (TOCTOU).
+    WIN32_FILE_ATTRIBUTE_DATA fileAttrBefore{};
+    if (!GetFileAttributesExA(srcPath.c_str(), GetFileExInfoStandard, &fileAttrBefore))
+    {
+        std::cerr << "(decrypt-stream) cannot stat: " << srcPath << "\n";
+        return false;
+    }
+
+    std::ifstream in(srcPath, std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "(decrypt-stream) cannot open: " << srcPath << "\n";
+        return false;
+    }
+
+    // Determine file size
+    in.seekg(0, std::ios::end);
+    auto fileSize = static_cast<size_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    {
+        unsigned char magic[seal::cfg::SEGMENT_HDR_LEN]{};
+        in.read(reinterpret_cast<char*>(magic), sizeof(magic));
+        const bool segmented = static_cast<size_t>(in.gcount()) == sizeof(magic) &&
+                               seal::Cryptography::isSegmentedPacket(magic);
+        in.clear();
+        in.seekg(0, std::ios::beg);
+        if (segmented)
+        {
+            in.close();
+            return decryptSegmentedFile(srcPath, dstPath, pwd, threads, keyring);
+        }
+    }
+
+    // Read and verify the AAD header: "seal", or "slp2" and the KDF bytes.
+    std::vector<unsigned char> aadBuf(std::min(fileSize, seal::cfg::PACKET_KDF_AAD_LEN));
+    in.read(reinterpret_cast<char*>(aadBuf.data()), (std::streamsize)aadBuf.size());
+    std::span<const unsigned char> aadExpected;
+    seal::KdfParams kdf;
+    try
+    {
+        aadExpected = seal::Cryptography::packetAad(aadBuf);
+        kdf = seal::Cryptography::packetKdf(aadBuf);
+    }
+    catch (const std::exception&)
+    {
+        std::cerr << "(decrypt-stream) bad AAD header: " << srcPath << "\n";
+        return false;
+    }
+    size_t headerSize = aadExpected.size() + seal::cfg::SALT_LEN + seal::cfg::IV_LEN;
+
+    if (fileSize < headerSize + seal::cfg::TAG_LEN)
+    {
+        std::cerr << "(decrypt-stream) file too short: " << srcPath << "\n";
+        return false;
+    }
+    in.clear();
+    in.seekg((std::streamoff)aadExpected.size(), std::ios::beg);
+
+    // Read salt and IV
+    std::vector<unsigned char> salt(seal::cfg::SALT_LEN);
+    in.read(reinterpret_cast<char*>(salt.data()), (std::streamsize)salt.size());
+    std::vector<unsigned char> iv(seal::cfg::IV_LEN);
+    in.read(reinterpret_cast<char*>(iv.data()), (std::streamsize)iv.size());
+
+    size_t ctLen = fileSize - headerSize - seal::cfg::TAG_LEN;
+
+    // Read the GCM tag from the end of the file, then seek back to ciphertext start
+    auto ctStartPos = in.tellg();
+    in.seekg(-(std::streamoff)seal::cfg::TAG_LEN, std::ios::end);
+    std::vector<unsigned char> tag(seal::cfg::TAG_LEN);
+    in.read(reinterpret_cast<char*>(tag.data()), (std::streamsize)tag.size());
+    in.seekg(ctStartPos);
+
+    try
+    {
+        auto key = seal::Cryptography::deriveKey(pwd, std::span<const unsigned char>(salt), kdf);
+
+        // Helper: initialise a GCM decrypt context with the shared key/IV/AAD.
+        auto initCtx = [&](seal::CachedCipherCtx& ctx)
+        {
+            seal::Cryptography::opensslCheck(
+                EVP_DecryptInit_ex(ctx.p, seal::aes256Gcm(), nullptr, nullptr, nullptr),
+                "DecryptInit(cipher) failed");
+            seal::Cryptography::opensslCheck(
+                EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)seal::cfg::IV_LEN, nullptr),
+                "SET_IVLEN failed");
+            seal::Cryptography::opensslCheck(
+                EVP_DecryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv.data()),
+                "DecryptInit(key/iv) failed");
+            if (!aadExpected.empty())
+            {
+                int tmp = 0;
+                seal::Cryptography::opensslCheck(
+                    EVP_DecryptUpdate(
+                        ctx.p, nullptr, &tmp, aadExpected.data(), (int)aadExpected.size()),
+                    "DecryptUpdate(AAD) failed");
+            }
+        };
+
+        // Reusable buffers for both passes.
+        std::vector<unsigned char> ctBuf(seal::cfg::FILE_CHUNK);
+        std::vector<unsigned char> plainBuf(seal::cfg::FILE_CHUNK + 16);
+
+        // --- Pass 1: verify GCM tag without writing plaintext to disk ---
+        {
+            seal::CachedCipherCtx verifyCtx;
+            initCtx(verifyCtx);
+
+            size_t remaining = ctLen;
+            while (remaining > 0)
+            {
+                size_t toRead = std::min(remaining, seal::cfg::FILE_CHUNK);
+                in.read(reinterpret_cast<char*>(ctBuf.data()), (std::streamsize)toRead);
                 auto bytesRead = static_cast<size_t>(in.gcount());
                 if (bytesRead == 0)
                     break;
@@ -1234,147 +3418,1444 @@ bool FileOperations::decryptFileStreaming(const std::string& srcPath,
                 remaining -= bytesRead;
             }
 
-            seal::Cryptography::opensslCheck(
-                EVP_CIPHER_CTX_ctrl(
-                    verifyCtx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tag.data()),
-                "SET_TAG failed");
+            seal::Cryptography::opensslCheck(
+                EVP_CIPHER_CTX_ctrl(
+                    verifyCtx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tag.data()),
+                "SET_TAG failed");
+
+            unsigned char finBuf[16]{};
+            int fin = 0;
+            int ok = EVP_DecryptFinal_ex(verifyCtx.p, finBuf, &fin);
+            SecureZeroMemory(finBuf, sizeof(finBuf));
+
+            if (ok != 1)
+            {
+                seal::Cryptography::cleanseString(key);
+                SecureZeroMemory(ctBuf.data(), ctBuf.size());
+                SecureZeroMemory(plainBuf.data(), plainBuf.size());
+                std::cerr << "(decrypt-stream) authentication failed: " << srcPath << "\n";
+                return false;
+            }
+        }
+
+        // --- TOCTOU guard: verify the file wasn't modified during pass 1 ---
+        // If another process wrote to the file between our verification and
+        // the write pass, the authentication guarantee from pass 1 is void.
+        WIN32_FILE_ATTRIBUTE_DATA fileAttrAfter{};
+        if (!GetFileAttributesExA(srcPath.c_str(), GetFileExInfoStandard, &fileAttrAfter) ||
+            fileAttrBefore.ftLastWriteTime.dwLowDateTime !=
+                fileAttrAfter.ftLastWriteTime.dwLowDateTime ||
+            fileAttrBefore.ftLastWriteTime.dwHighDateTime !=
+                fileAttrAfter.ftLastWriteTime.dwHighDateTime ||
+            fileAttrBefore.nFileSizeLow != fileAttrAfter.nFileSizeLow ||
+            fileAttrBefore.nFileSizeHigh != fileAttrAfter.nFileSizeHigh)
+        {
+            seal::Cryptography::cleanseString(key);
+            SecureZeroMemory(ctBuf.data(), ctBuf.size());
+            SecureZeroMemory(plainBuf.data(), plainBuf.size());
+            std::cerr << "(decrypt-stream) file modified during verification: " << srcPath << "\n";
+            return false;
+        }
+
+        // --- Pass 2: re-read and decrypt to disk (data is now authenticated) ---
+        in.clear();
+        in.seekg(ctStartPos);
+
+        seal::CachedCipherCtx writeCtx;
+        initCtx(writeCtx);
+
+        std::string tmpPath = dstPath + ".tmp";
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "(decrypt-stream) cannot write temp file: " << tmpPath << "\n";
+            seal::Cryptography::cleanseString(key);
+            return false;
+        }
+
+        size_t remaining = ctLen;
+        bool ioOk = true;
+
+        while (remaining > 0)
+        {
+            size_t toRead = std::min(remaining, seal::cfg::FILE_CHUNK);
+            in.read(reinterpret_cast<char*>(ctBuf.data()), (std::streamsize)toRead);
+            auto bytesRead = static_cast<size_t>(in.gcount());
+            if (bytesRead == 0)
+                break;
+
+            int outlen = 0;
+            seal::Cryptography::opensslCheck(EVP_DecryptUpdate(writeCtx.p,
+                                                               plainBuf.data(),
+                                                               &outlen,
+                                                               ctBuf.data(),
+                                                               static_cast<int>(bytesRead)),
+                                             "DecryptUpdate(CT/write) failed");
+
+            out.write(reinterpret_cast<const char*>(plainBuf.data()), outlen);
+            SecureZeroMemory(plainBuf.data(), static_cast<size_t>(outlen));
+            if (!out)
+            {
+                ioOk = false;
+                break;
+            }
+            remaining -= bytesRead;
+        }
+        in.close();
+
+        if (!ioOk)
+        {
+            seal::Cryptography::cleanseString(key);
+            SecureZeroMemory(ctBuf.data(), ctBuf.size());
+            SecureZeroMemory(plainBuf.data(), plainBuf.size());
+            out.close();
+            DeleteFileA(tmpPath.c_str());
+            return false;
+        }
+
+        // Finalize the write-pass context (tag is already verified; this
+        // call flushes any remaining block padding).
+        seal::Cryptography::opensslCheck(
+            EVP_CIPHER_CTX_ctrl(
+                writeCtx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tag.data()),
+            "SET_TAG(write) failed");
+
+        unsigned char finBuf[16]{};
+        int fin = 0;
+        (void)EVP_DecryptFinal_ex(writeCtx.p, finBuf, &fin);
+        if (fin > 0)
+        {
+            out.write(reinterpret_cast<const char*>(finBuf), fin);
+        }
+        SecureZeroMemory(finBuf, sizeof(finBuf));
+
+        seal::Cryptography::cleanseString(key);
+        SecureZeroMemory(ctBuf.data(), ctBuf.size());
+        SecureZeroMemory(plainBuf.data(), plainBuf.size());
+
+        out.flush();
+        ioOk = out.good();
+        out.close();
+
+        if (ioOk)
+        {
+            flushFileToDisk(tmpPath);
+
+            if (!MoveFileExA(tmpPath.c_str(), dstPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+            {
+                std::cerr << "(decrypt-stream) cannot rename to destination: " << dstPath << "\n";
+                DeleteFileA(tmpPath.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        std::cerr << "(decrypt-stream) write error: " << tmpPath << "\n";
+        DeleteFileA(tmpPath.c_str());
+        return false;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "(decrypt-stream) " << e.what() << "\n";
+        return false;
+    }
+}
+
+namespace
+{
+
+// Read extents 0 .. count-1 of @p in in order, extent(i) giving the
+// {offset, size} of each (size at most @p block), with the next one in
+// flight while consume(index, data, size) handles the current one. Returns
+// false on a read error or once consume returns false. Every request is
+// settled before this returns or rethrows.
+template <class Extent, class Consume>
+bool readExtents(OverlappedFile& in,
+                 uint64_t count,
+                 size_t block,
+                 const Extent& extent,
+                 const Consume& consume)
+{
+    std::array<std::vector<unsigned char>, 2> bufs;
+    std::array<AsyncOp, 2> ops;
+    auto issue = [&](uint64_t i)
+    {
+        auto& buf = bufs[i % 2];
+        buf.resize(block);
+        const auto [offset, size] = extent(i);
+        return in.beginRead(ops[i % 2], offset, buf.data(), size);
+    };
+    auto settle = [&]
+    {
+        if (std::none_of(ops.begin(), ops.end(), [](const AsyncOp& op) { return op.pending; }))
+            return;
+        in.cancel();
+        for (auto& op : ops)
+        {
+            size_t n = 0;
+            if (op.pending)
+                (void)in.finish(op, n);
+        }
+    };
+
+    bool ok = true;
+    try
+    {
+        ok = count == 0 || issue(0);
+        for (uint64_t i = 0; ok && i < count; ++i)
+        {
+            size_t got = 0;
+            ok = in.finish(ops[i % 2], got) && got == extent(i).second &&
+                 (i + 1 == count || issue(i + 1)) && consume(i, bufs[i % 2].data(), got);
+        }
+    }
+    catch (...)
+    {
+        settle();
+        throw;
+    }
+    settle();
+    return ok;
+}
+
+// Read [offset, offset + length) of @p in front to back in @p block-sized
+// pieces through readExtents().
+template <class Consume>
+bool readBlocks(OverlappedFile& in,
+                uint64_t offset,
+                uint64_t length,
+                size_t block,
+                const Consume& consume)
+{
+    return readExtents(
+        in,
+        (length + block - 1) / block,
+        block,
+        [&](uint64_t i)
+        {
+            const uint64_t size = std::min<uint64_t>(block, length - i * block);
+            return std::pair<uint64_t, size_t>(offset + i * block, static_cast<size_t>(size));
+        },
+        consume);
+}
+
+}  // namespace
+
+// Verification only: one front-to-back read, every tag checked, nothing
+// written. Segmented files are opened segment by segment with
+// Cryptography::openSegment(); classic packets stream through one GCM
+// context as in pass 1 of decryptFileStreaming.
+template <secure_password SecurePwd>
+void FileOperations::verifyFile(const std::string& path,
+                                const SecurePwd& pwd,
+                                FileKeyring* keyring)
+{
+    OverlappedFile in;
+    uint64_t fileSize = 0;
+    if (!in.openRead(path, false) || !in.size(fileSize))
+        throw std::runtime_error("Cannot open file");
+
+    // Enough for any segmented header and for a classic packet's AAD,
+    // salt and IV.
+    std::vector<unsigned char> header(std::min<uint64_t>(
+        fileSize, seal::cfg::SEGMENT_KEYED_HEADER_LEN + seal::cfg::KDF_PARAMS_LEN));
+    readExact(in, 0, header.data(), header.size());
+
+    const char* const authFailed = "Authentication failed (bad password or corrupted data)";
+    PageBuffer scratch;
+    bool authentic = true;
+
+    if (seal::Cryptography::isSegmentedPacket(header))
+    {
+        if (header.size() < seal::cfg::SEGMENT_HEADER_LEN ||
+            header.size() < seal::Cryptography::segmentHeaderSize(header))
+            throw std::runtime_error("Ciphertext too short");
+        const size_t segLen = seal::Cryptography::segmentSize(header);
+        header.resize(seal::Cryptography::segmentHeaderSize(header));
+
+        const bool compressed = seal::Cryptography::isCompressedSegmentPacket(header);
+        const uint64_t stride = segLen + seal::cfg::TAG_LEN;
+        const uint64_t bodyLen = fileSize - header.size();
+        if (!compressed && (bodyLen < seal::cfg::TAG_LEN ||
+                            (bodyLen % stride != 0 && bodyLen % stride < seal::cfg::TAG_LEN)))
+            throw std::runtime_error("Truncated or malformed file");
+        const uint64_t segments = (bodyLen + stride - 1) / stride;
+
+        auto key = keyring ? keyring->fileKey(pwd, header)
+                           : seal::Cryptography::deriveSegmentKey(pwd, header);
+        scratch.allocate(segLen);
+        bool read = false;
+        try
+        {
+            if (compressed)
+            {
+                // The table authenticates the layout; each segment is then
+                // opened and decompressed, so a verified file will decrypt.
+                const auto table = readSegmentTable(in, fileSize, key, header);
+                std::vector<uint64_t> offsets(table.entries.size());
+                uint64_t at = header.size();
+                for (size_t i = 0; i < offsets.size(); ++i)
+                {
+                    offsets[i] = at;
+                    at += seal::Cryptography::SegmentTable::storedSize(table.entries[i]);
+                }
+                read = readExtents(
+                    in,
+                    table.entries.size(),
+                    static_cast<size_t>(stride),
+                    [&](uint64_t i)
+                    {
+                        return std::pair<uint64_t, size_t>(
+                            offsets[i],
+                            seal::Cryptography::SegmentTable::storedSize(table.entries[i]));
+                    },
+                    [&](uint64_t index, unsigned char* sealed, size_t size)
+                    {
+                        const uint64_t plain =
+                            std::min<uint64_t>(segLen, table.plainSize - index * segLen);
+                        authentic = seal::Cryptography::openCompressedSegment(
+                            key,
+                            header,
+                            index,
+                            table.entries[index],
+                            std::span<unsigned char>(sealed, size),
+                            std::span<unsigned char>(scratch.data(), static_cast<size_t>(plain)));
+                        return authentic;
+                    });
+            }
+            else
+            {
+                read = readBlocks(in,
+                                  header.size(),
+                                  bodyLen,
+                                  static_cast<size_t>(stride),
+                                  [&](uint64_t index, const unsigned char* sealed, size_t size)
+                                  {
+                                      authentic = seal::Cryptography::openSegment(
+                                          key,
+                                          header,
+                                          index,
+                                          index + 1 == segments,
+                                          std::span<const unsigned char>(sealed, size),
+                                          scratch.data());
+                                      return authentic;
+                                  });
+            }
+        }
+        catch (...)
+        {
+            seal::Cryptography::cleanseString(key);
+            throw;
+        }
+        seal::Cryptography::cleanseString(key);
+        if (!authentic)
+            throw std::runtime_error(authFailed);
+        if (!read)
+            throw std::runtime_error("Read error");
+        return;
+    }
+
+    // Classic packet: [ AAD | salt | IV | ciphertext | tag ].
+    const std::span<const unsigned char> aad = seal::Cryptography::packetAad(header);
+    const seal::KdfParams kdf = seal::Cryptography::packetKdf(header);
+    const size_t headerSize = aad.size() + seal::cfg::SALT_LEN + seal::cfg::IV_LEN;
+    if (fileSize < headerSize + seal::cfg::TAG_LEN)
+        throw std::runtime_error("Ciphertext too short");
+    const unsigned char* salt = header.data() + aad.size();
+    const unsigned char* iv = salt + seal::cfg::SALT_LEN;
+    const uint64_t ctLen = fileSize - headerSize - seal::cfg::TAG_LEN;
+    unsigned char tag[seal::cfg::TAG_LEN];
+    readExact(in, fileSize - seal::cfg::TAG_LEN, tag, sizeof(tag));
+
+    auto key = seal::Cryptography::deriveKey(
+        pwd, std::span<const unsigned char>(salt, seal::cfg::SALT_LEN), kdf);
+    bool read = false;
+    try
+    {
+        seal::CachedCipherCtx ctx;
+        seal::Cryptography::opensslCheck(
+            EVP_DecryptInit_ex(ctx.p, seal::aes256Gcm(), nullptr, nullptr, nullptr),
+            "DecryptInit(cipher) failed");
+        seal::Cryptography::opensslCheck(
+            EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_IVLEN, (int)seal::cfg::IV_LEN, nullptr),
+            "SET_IVLEN failed");
+        seal::Cryptography::opensslCheck(
+            EVP_DecryptInit_ex(ctx.p, nullptr, nullptr, key.data(), iv),
+            "DecryptInit(key/iv) failed");
+        if (!aad.empty())
+        {
+            int tmp = 0;
+            seal::Cryptography::opensslCheck(
+                EVP_DecryptUpdate(ctx.p, nullptr, &tmp, aad.data(), (int)aad.size()),
+                "DecryptUpdate(AAD) failed");
+        }
+
+        scratch.allocate(seal::cfg::FILE_CHUNK + 16);
+        read = readBlocks(in,
+                          headerSize,
+                          ctLen,
+                          seal::cfg::FILE_CHUNK,
+                          [&](uint64_t, const unsigned char* ct, size_t size)
+                          {
+                              int outlen = 0;
+                              seal::Cryptography::opensslCheck(
+                                  EVP_DecryptUpdate(
+                                      ctx.p, scratch.data(), &outlen, ct, static_cast<int>(size)),
+                                  "DecryptUpdate(CT/verify) failed");
+                              return true;
+                          });
+        if (read)
+        {
+            seal::Cryptography::opensslCheck(
+                EVP_CIPHER_CTX_ctrl(ctx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tag),
+                "SET_TAG failed");
+            unsigned char finBuf[16]{};
+            int fin = 0;
+            authentic = EVP_DecryptFinal_ex(ctx.p, finBuf, &fin) == 1;
+            SecureZeroMemory(finBuf, sizeof(finBuf));
+        }
+    }
+    catch (...)
+    {
+        seal::Cryptography::cleanseString(key);
+        throw;
+    }
+    seal::Cryptography::cleanseString(key);
+    if (!read)
+        throw std::runtime_error("Read error");
+    if (!authentic)
+        throw std::runtime_error(authFailed);
+}
+
+// Range reads: the segments covering the range are located without
+// touching the rest of the file, read through readExtents() and opened
+// into a locked scratch buffer; only the requested slice of each leaves it.
+template <secure_password SecurePwd>
+uint64_t FileOperations::decryptRange(const std::string& path,
+                                      uint64_t offset,
+                                      uint64_t length,
+                                      std::ostream& out,
+                                      const SecurePwd& pwd,
+                                      FileKeyring* keyring)
+{
+    OverlappedFile in;
+    uint64_t fileSize = 0;
+    if (!in.openRead(path, false) || !in.size(fileSize))
+        throw std::runtime_error("Cannot open file");
+
+    std::vector<unsigned char> header(std::min<uint64_t>(
+        fileSize, seal::cfg::SEGMENT_KEYED_HEADER_LEN + seal::cfg::KDF_PARAMS_LEN));
+    readExact(in, 0, header.data(), header.size());
+
+    if (!seal::Cryptography::isSegmentedPacket(header))
+    {
+        // Sized for the longer, KDF-tagged AAD, as in decryptFileTo().
+        constexpr size_t kFramingOverhead = std::max(seal::cfg::AAD_LEN,
+                                                     seal::cfg::PACKET_KDF_AAD_LEN) +
+                                            seal::cfg::SALT_LEN + seal::cfg::IV_LEN +
+                                            seal::cfg::TAG_LEN;
+        if (fileSize > seal::cfg::FILE_CHUNK + kFramingOverhead)
+            throw std::runtime_error("Range reads of large files need the segmented format");
+        std::vector<unsigned char> blob(static_cast<size_t>(fileSize));
+        readExact(in, 0, blob.data(), blob.size());
+        auto plain = seal::Cryptography::decryptPacket(std::span<const unsigned char>(blob), pwd);
+        const uint64_t begin = std::min<uint64_t>(offset, plain.size());
+        const uint64_t n = std::min<uint64_t>(length, plain.size() - begin);
+        out.write(reinterpret_cast<const char*>(plain.data() + begin),
+                  static_cast<std::streamsize>(n));
+        seal::Cryptography::cleanseString(plain);
+        if (!out)
+            throw std::runtime_error("Write error");
+        return n;
+    }
+
+    if (header.size() < seal::cfg::SEGMENT_HEADER_LEN ||
+        header.size() < seal::Cryptography::segmentHeaderSize(header))
+        throw std::runtime_error("Ciphertext too short");
+    const size_t segLen = seal::Cryptography::segmentSize(header);
+    header.resize(seal::Cryptography::segmentHeaderSize(header));
+
+    const bool compressed = seal::Cryptography::isCompressedSegmentPacket(header);
+    const uint64_t stride = segLen + seal::cfg::TAG_LEN;
+    const uint64_t bodyLen = fileSize - header.size();
+    if (!compressed && (bodyLen < seal::cfg::TAG_LEN ||
+                        (bodyLen % stride != 0 && bodyLen % stride < seal::cfg::TAG_LEN)))
+        throw std::runtime_error("Truncated or malformed file");
+
+    auto key = keyring ? keyring->fileKey(pwd, header)
+                       : seal::Cryptography::deriveSegmentKey(pwd, header);
+    PageBuffer scratch;
+    bool authentic = true;
+    bool read = false;
+    uint64_t written = 0;
+    try
+    {
+        // Where segment i starts and how many stored bytes it has: the
+        // fixed stride, or the authenticated table of a compressed file.
+        seal::Cryptography::SegmentTable table;
+        std::vector<uint64_t> offsets;
+        uint64_t segments = 0;
+        uint64_t plainSize = 0;
+        if (compressed)
+        {
+            table = readSegmentTable(in, fileSize, key, header);
+            offsets.resize(table.entries.size());
+            uint64_t at = header.size();
+            for (size_t i = 0; i < offsets.size(); ++i)
+            {
+                offsets[i] = at;
+                at += seal::Cryptography::SegmentTable::storedSize(table.entries[i]);
+            }
+            segments = table.entries.size();
+            plainSize = table.plainSize;
+        }
+        else
+        {
+            segments = (bodyLen + stride - 1) / stride;
+            plainSize = bodyLen - segments * seal::cfg::TAG_LEN;
+        }
+
+        if (offset < plainSize && length > 0)
+        {
+            length = std::min(length, plainSize - offset);
+            const uint64_t first = offset / segLen;
+            const uint64_t last = (offset + length - 1) / segLen;
+            scratch.allocate(segLen);
+            read = readExtents(
+                in,
+                last - first + 1,
+                static_cast<size_t>(stride),
+                [&](uint64_t i)
+                {
+                    const uint64_t index = first + i;
+                    if (compressed)
+                        return std::pair<uint64_t, size_t>(
+                            offsets[index],
+                            seal::Cryptography::SegmentTable::storedSize(table.entries[index]));
+                    return std::pair<uint64_t, size_t>(
+                        header.size() + index * stride,
+                        static_cast<size_t>(std::min(stride, bodyLen - index * stride)));
+                },
+                [&](uint64_t i, unsigned char* sealed, size_t size)
+                {
+                    const uint64_t index = first + i;
+                    const uint64_t base = index * segLen;
+                    const uint64_t plain = std::min<uint64_t>(segLen, plainSize - base);
+                    authentic =
+                        compressed
+                            ? seal::Cryptography::openCompressedSegment(
+                                  key,
+                                  header,
+                                  index,
+                                  table.entries[index],
+                                  std::span<unsigned char>(sealed, size),
+                                  std::span<unsigned char>(scratch.data(),
+                                                           static_cast<size_t>(plain)))
+                            : seal::Cryptography::openSegment(
+                                  key,
+                                  header,
+                                  index,
+                                  index + 1 == segments,
+                                  std::span<const unsigned char>(sealed, size),
+                                  scratch.data());
+                    if (!authentic)
+                        return false;
+                    const uint64_t begin = index == first ? offset - base : 0;
+                    const uint64_t end = index == last ? offset + length - base : plain;
+                    out.write(reinterpret_cast<const char*>(scratch.data() + begin),
+                              static_cast<std::streamsize>(end - begin));
+                    written += end - begin;
+                    return static_cast<bool>(out);
+                });
+        }
+        else if (!compressed)
+        {
+            // Nothing in range, but the key must still be checked (the
+            // table already was, for a compressed file): open the final
+            // segment so a bad password or a cut-off file fails here too.
+            const uint64_t index = segments - 1;
+            std::vector<unsigned char> sealed(static_cast<size_t>(bodyLen - index * stride));
+            readExact(in, header.size() + index * stride, sealed.data(), sealed.size());
+            scratch.allocate(segLen);
+            authentic = seal::Cryptography::openSegment(
+                key, header, index, true, sealed, scratch.data());
+            read = true;
+        }
+        else
+        {
+            read = true;
+        }
+    }
+    catch (...)
+    {
+        seal::Cryptography::cleanseString(key);
+        throw;
+    }
+    seal::Cryptography::cleanseString(key);
+    if (!authentic)
+        throw std::runtime_error("Authentication failed (bad password or corrupted data)");
+    if (!out)
+        throw std::runtime_error("Write error");
+    if (!read)
+        throw std::runtime_error("Read error");
+    return written;
+}
+
+template <secure_password SecurePwd>
+VerifySummary FileOperations::verifyDirectory(const std::string& dir,
+                                              const SecurePwd& pwd,
+                                              std::ostream& out)
+{
+    namespace fs = std::filesystem;
+
+    struct VerifyJob
+    {
+        fs::path path;
+        std::string rel;
+        std::string error;  // empty once the file verified
+    };
+
+    VerifySummary summary;
+    std::error_code ec;
+    const fs::path root = fs::absolute(dir, ec);
+    if (ec)
+    {
+        std::cerr << "(verify) bad path: " << dir << "\n";
+        summary.listed = false;
+        return summary;
+    }
+
+    // Listing first keeps the output order independent of which worker
+    // finished when; the jobs vector is not resized after this.
+    std::vector<VerifyJob> jobs;
+    const auto options = fs::directory_options::skip_permission_denied;
+    for (fs::recursive_directory_iterator it(root, options, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        if (it->is_symlink(ec))
+        {
+            if (it->is_directory(ec))
+                it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file(ec) ||
+            !seal::utils::endsWithCi(it->path().filename().string(), ".seal"))
+            continue;
+        jobs.push_back({it->path(), it->path().lexically_relative(root).generic_string(), {}});
+    }
+    if (ec)
+    {
+        std::cerr << "(verify) cannot list: " << dir << "\n";
+        summary.listed = false;
+    }
+
+    FileKeyring keyring;
+    std::atomic<size_t> pending{jobs.size()};
+    auto& scheduler = GetScheduler();
+    for (auto& job : jobs)
+    {
+        scheduler.spawn(
+            [&job, &pending, &pwd, &keyring]
+            {
+                try
+                {
+                    verifyFile(job.path.string(), pwd, &keyring);
+                }
+                catch (const std::exception& e)
+                {
+                    job.error = e.what();
+                    if (job.error.empty())
+                        job.error = "Verification failed";
+                }
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    GetScheduler().notifyAll();
+            });
+    }
+    scheduler.runUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
+
+    std::sort(jobs.begin(),
+              jobs.end(),
+              [](const VerifyJob& a, const VerifyJob& b) { return a.rel < b.rel; });
+    for (const auto& job : jobs)
+    {
+        if (job.error.empty())
+        {
+            ++summary.passed;
+            out << job.rel << ": OK\n";
+        }
+        else
+        {
+            ++summary.failed;
+            out << job.rel << ": FAILED (" << job.error << ")\n";
+        }
+    }
+    out.flush();
+    return summary;
+}
+
+namespace
+{
+
+constexpr std::string_view kArchiveIndexInfo = "seal/archive/index/v1";
+
+// Archive integers are big-endian, like the vault format's.
+void storeU64BE(unsigned char* p, uint64_t v)
+{
+    for (int i = 7; i >= 0; --i, v >>= 8)
+        p[i] = static_cast<unsigned char>(v & 0xFFu);
+}
+
+uint64_t loadU64BE(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+uint64_t fileTimeTicks(const FILETIME& ft)
+{
+    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+}
+
+// Member paths are stored as UTF-8, so names outside the ANSI code page
+// survive the round trip.
+std::string utf8Path(const std::filesystem::path& rel)
+{
+    const std::u8string u = rel.generic_u8string();
+    return std::string(u.begin(), u.end());
+}
+
+std::filesystem::path fromUtf8Path(std::string_view s)
+{
+    return std::filesystem::path(std::u8string(s.begin(), s.end()));
+}
+
+// A member may only name a file below the extraction root.
+bool safeMemberPath(const std::filesystem::path& rel)
+{
+    if (rel.empty() || rel.has_root_name() || rel.has_root_directory())
+        return false;
+    for (const auto& part : rel)
+    {
+        if (part.empty() || part == "." || part == "..")
+            return false;
+    }
+    return true;
+}
+
+// Appends to the archive through one cfg::ARCHIVE_WRITE_BUFFER buffer, so
+// thousands of tiny members cost a handful of WriteFile calls. Callers
+// serialise on their own lock. Only ciphertext passes through it.
+class ArchiveWriter
+{
+public:
+    ArchiveWriter() = default;
+    ~ArchiveWriter() { close(); }
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    bool create(const std::string& path)
+    {
+        m_Handle = CreateFileA(path.c_str(),
+                               GENERIC_WRITE,
+                               0,
+                               nullptr,
+                               CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                               nullptr);
+        m_Buffer.reserve(seal::cfg::ARCHIVE_WRITE_BUFFER);
+        return m_Handle != INVALID_HANDLE_VALUE;
+    }
+
+    // Archive offset the next append() lands at.
+    uint64_t offset() const { return m_Offset; }
+
+    bool append(const unsigned char* data, size_t size)
+    {
+        if (m_Failed)
+            return false;
+        m_Offset += size;
+        if (m_Buffer.size() + size > m_Buffer.capacity() && !drain())
+            return false;
+        if (size >= m_Buffer.capacity())
+            return keep(writeHandle(m_Handle, data, size));
+        m_Buffer.insert(m_Buffer.end(), data, data + size);
+        return true;
+    }
+
+    // Write what is buffered and flush the file to disk, once per archive.
+    bool finish() { return drain() && keep(FlushFileBuffers(m_Handle) != 0); }
+
+    void close()
+    {
+        if (m_Handle != INVALID_HANDLE_VALUE)
+            CloseHandle(m_Handle);
+        m_Handle = INVALID_HANDLE_VALUE;
+    }
+
+private:
+    bool drain()
+    {
+        const bool ok = m_Buffer.empty() || writeHandle(m_Handle, m_Buffer.data(), m_Buffer.size());
+        m_Buffer.clear();
+        return keep(ok);
+    }
+
+    bool keep(bool ok)
+    {
+        m_Failed = m_Failed || !ok;
+        return !m_Failed;
+    }
 
-            unsigned char finBuf[16]{};
-            int fin = 0;
-            int ok = EVP_DecryptFinal_ex(verifyCtx.p, finBuf, &fin);
-            SecureZeroMemory(finBuf, sizeof(finBuf));
+    HANDLE m_Handle = INVALID_HANDLE_VALUE;
+    std::vector<unsigned char> m_Buffer;
+    uint64_t m_Offset = 0;
+    bool m_Failed = false;
+};
 
-            if (ok != 1)
-            {
-                seal::Cryptography::cleanseString(key);
-                SecureZeroMemory(ctBuf.data(), ctBuf.size());
-                SecureZeroMemory(plainBuf.data(), plainBuf.size());
-                std::cerr << "(decrypt-stream) authentication failed: " << srcPath << "\n";
-                return false;
-            }
-        }
+struct PackJob
+{
+    std::filesystem::path path;
+    uint64_t listedSize = 0;
+    seal::ArchiveMember member;
+    std::array<unsigned char, seal::cfg::SEGMENT_FILE_NONCE_LEN> nonce{};
+    std::string error;
+    bool done = false;
+};
 
-        // --- TOCTOU guard: verify the file wasn't modified during pass 1 ---
-        // If another process wrote to the file between our verification and
-        // the write pass, the authentication guarantee from pass 1 is void.
-        WIN32_FILE_ATTRIBUTE_DATA fileAttrAfter{};
-        if (!GetFileAttributesExA(srcPath.c_str(), GetFileExInfoStandard, &fileAttrAfter) ||
-            fileAttrBefore.ftLastWriteTime.dwLowDateTime !=
-                fileAttrAfter.ftLastWriteTime.dwLowDateTime ||
-            fileAttrBefore.ftLastWriteTime.dwHighDateTime !=
-                fileAttrAfter.ftLastWriteTime.dwHighDateTime ||
-            fileAttrBefore.nFileSizeLow != fileAttrAfter.nFileSizeLow ||
-            fileAttrBefore.nFileSizeHigh != fileAttrAfter.nFileSizeHigh)
+// Seal one file as a keyed segmented packet under the archive salt and
+// hand the header, then each sealed segment, to sink(data, size). Size and
+// last-write time come from the open handle, so they describe exactly the
+// bytes sealed; a file that shrinks meanwhile fails instead of being cut.
+template <class Sink>
+void sealArchiveMember(PackJob& job,
+                       std::span<const unsigned char> masterKey,
+                       std::span<const unsigned char> salt,
+                       const seal::KdfParams& kdf,
+                       const Sink& sink)
+{
+    HANDLE h = CreateFileW(job.path.c_str(),
+                           GENERIC_READ,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr,
+                           OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN,
+                           nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot open file");
+    struct HandleGuard
+    {
+        HANDLE h;
+        ~HandleGuard() { CloseHandle(h); }
+    } guard{h};
+
+    LARGE_INTEGER size{};
+    FILETIME written{};
+    if (!GetFileSizeEx(h, &size) || !GetFileTime(h, nullptr, nullptr, &written))
+        throw std::runtime_error("Cannot stat file");
+    job.member.size = static_cast<uint64_t>(size.QuadPart);
+    job.member.writeTime = fileTimeTicks(written);
+
+    auto header =
+        seal::Cryptography::makeSegmentHeader(salt, true, kdf, false, seal::Cryptography::aead());
+    std::copy_n(
+        header.begin() + seal::cfg::SEGMENT_HEADER_LEN, job.nonce.size(), job.nonce.begin());
+    const size_t segLen = seal::Cryptography::segmentSize(header);
+    const uint64_t segments = std::max<uint64_t>(1, (job.member.size + segLen - 1) / segLen);
+    job.member.length = header.size() + job.member.size + segments * seal::cfg::TAG_LEN;
+
+    PageBuffer plain;
+    plain.allocate(static_cast<size_t>(
+        std::min<uint64_t>(segLen, std::max<uint64_t>(job.member.size, 1))));
+    std::vector<unsigned char> sealed(plain.size() + seal::cfg::TAG_LEN);
+    auto key = seal::Cryptography::segmentFileKey(masterKey, header);
+    try
+    {
+        if (!sink(header.data(), header.size()))
+            throw std::runtime_error("Archive write failed");
+        for (uint64_t i = 0; i < segments; ++i)
         {
-            seal::Cryptography::cleanseString(key);
-            SecureZeroMemory(ctBuf.data(), ctBuf.size());
-            SecureZeroMemory(plainBuf.data(), plainBuf.size());
-            std::cerr << "(decrypt-stream) file modified during verification: " << srcPath << "\n";
-            return false;
+            const size_t want =
+                static_cast<size_t>(std::min<uint64_t>(segLen, job.member.size - i * segLen));
+            size_t got = 0;
+            if (!readHandle(h, plain.data(), want, got) || got != want)
+                throw std::runtime_error("File changed while packing");
+            seal::Cryptography::sealSegment(key,
+                                            header,
+                                            i,
+                                            i + 1 == segments,
+                                            std::span<const unsigned char>(plain.data(), want),
+                                            sealed.data());
+            if (!sink(sealed.data(), want + seal::cfg::TAG_LEN))
+                throw std::runtime_error("Archive write failed");
         }
+    }
+    catch (...)
+    {
+        seal::Cryptography::cleanseString(key);
+        throw;
+    }
+    seal::Cryptography::cleanseString(key);
+}
 
-        // --- Pass 2: re-read and decrypt to disk (data is now authenticated) ---
-        in.clear();
-        in.seekg(ctStartPos);
+// One index line per member, after a `count \t dataEnd` line:
+// `offset \t length \t size \t writeTime \t nonce \t path`. Windows file
+// names cannot contain tabs or newlines.
+std::string archiveIndexText(const std::vector<PackJob>& jobs, uint64_t dataEnd)
+{
+    std::string text = std::to_string(jobs.size()) + '\t' + std::to_string(dataEnd) + '\n';
+    for (const auto& job : jobs)
+    {
+        const auto& m = job.member;
+        text += std::to_string(m.offset) + '\t' + std::to_string(m.length) + '\t' +
+                std::to_string(m.size) + '\t' + std::to_string(m.writeTime) + '\t' +
+                seal::utils::to_hex(job.nonce) + '\t' + m.path + '\n';
+    }
+    return text;
+}
 
-        seal::EvpCipherCtx writeCtx;
-        initCtx(writeCtx);
+// An archive opened for reading: header and trailer checked, master key
+// derived once, index authenticated and parsed. extract() may run on
+// several threads at once; each read is a separate overlapped request.
+class ArchiveReader
+{
+public:
+    struct Entry
+    {
+        seal::ArchiveMember member;
+        std::array<unsigned char, seal::cfg::SEGMENT_FILE_NONCE_LEN> nonce{};
+    };
 
-        std::string tmpPath = dstPath + ".tmp";
-        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
-        if (!out)
+    ArchiveReader() = default;
+    ~ArchiveReader() { seal::Cryptography::cleanseString(m_Master); }
+    ArchiveReader(const ArchiveReader&) = delete;
+    ArchiveReader& operator=(const ArchiveReader&) = delete;
+
+    template <seal::secure_password SecurePwd>
+    void open(const std::string& path, const SecurePwd& password)
+    {
+        uint64_t fileSize = 0;
+        if (!m_File.openRead(path, false) || !m_File.size(fileSize))
+            throw std::runtime_error("Cannot open archive");
+        constexpr size_t kFraming = seal::cfg::ARCHIVE_HEADER_LEN + seal::cfg::ARCHIVE_TRAILER_LEN;
+        if (fileSize < kFraming)
+            throw std::runtime_error("Not a seal archive");
+
+        std::array<unsigned char, seal::cfg::ARCHIVE_HEADER_LEN> header{};
+        std::array<unsigned char, seal::cfg::ARCHIVE_TRAILER_LEN> trailer{};
+        readExact(m_File, 0, header.data(), header.size());
+        readExact(m_File, fileSize - trailer.size(), trailer.data(), trailer.size());
+        const auto magic =
+            std::span<const char>(seal::cfg::ARCHIVE_HDR, seal::cfg::ARCHIVE_HDR_LEN);
+        if (!std::equal(magic.begin(), magic.end(), header.begin()) ||
+            !std::equal(magic.begin(), magic.end(), trailer.begin() + 8))
+            throw std::runtime_error("Not a seal archive");
+
+        std::copy_n(header.begin() + seal::cfg::ARCHIVE_HDR_LEN, m_Salt.size(), m_Salt.begin());
+        const auto kdf = seal::KdfParams::decode(
+            std::span<const unsigned char>(header).subspan(seal::cfg::ARCHIVE_HDR_LEN +
+                                                           seal::cfg::SALT_LEN));
+        if (!kdf)
+            throw std::runtime_error("Unsupported KDF parameters");
+
+        const uint64_t indexLen = loadU64BE(trailer.data());
+        if (indexLen < seal::Cryptography::keyedPacketSize(8) || indexLen > fileSize - kFraming)
+            throw std::runtime_error("Truncated or malformed archive");
+        const uint64_t indexOffset = fileSize - trailer.size() - indexLen;
+        std::vector<unsigned char> sealed(static_cast<size_t>(indexLen));
+        readExact(m_File, indexOffset, sealed.data(), sealed.size());
+
+        m_Master = seal::Cryptography::deriveMasterKey(password, m_Salt, *kdf);
+        auto indexKey = seal::Cryptography::deriveSubkey(m_Master, kArchiveIndexInfo);
+        std::vector<unsigned char> payload;
+        try
         {
-            std::cerr << "(decrypt-stream) cannot write temp file: " << tmpPath << "\n";
-            seal::Cryptography::cleanseString(key);
-            return false;
+            payload = seal::Cryptography::decryptWithKey(sealed, indexKey);
         }
+        catch (...)
+        {
+            seal::Cryptography::cleanseString(indexKey);
+            throw;
+        }
+        seal::Cryptography::cleanseString(indexKey);
 
-        size_t remaining = ctLen;
-        bool ioOk = true;
-
-        while (remaining > 0)
+        // [ rawLength(8) | compressed index text ]
+        std::vector<unsigned char> raw;
+        try
         {
-            size_t toRead = std::min(remaining, seal::cfg::FILE_CHUNK);
-            in.read(reinterpret_cast<char*>(ctBuf.data()), (std::streamsize)toRead);
-            auto bytesRead = static_cast<size_t>(in.gcount());
-            if (bytesRead == 0)
-                break;
+            if (payload.size() < 8 || loadU64BE(payload.data()) > seal::cfg::ARCHIVE_INDEX_MAX)
+                throw std::runtime_error("Malformed archive index");
+            raw.resize(static_cast<size_t>(loadU64BE(payload.data())));
+            seal::compression::decompress(std::span<const unsigned char>(payload).subspan(8),
+                                          raw);
+            parse(std::string_view(reinterpret_cast<const char*>(raw.data()), raw.size()),
+                  indexOffset);
+        }
+        catch (...)
+        {
+            seal::Cryptography::cleanseString(payload, raw);
+            throw;
+        }
+        seal::Cryptography::cleanseString(payload, raw);
+    }
 
-            int outlen = 0;
-            seal::Cryptography::opensslCheck(EVP_DecryptUpdate(writeCtx.p,
-                                                               plainBuf.data(),
-                                                               &outlen,
-                                                               ctBuf.data(),
-                                                               static_cast<int>(bytesRead)),
-                                             "DecryptUpdate(CT/write) failed");
+    const std::vector<Entry>& entries() const { return m_Entries; }
 
-            out.write(reinterpret_cast<const char*>(plainBuf.data()), outlen);
-            SecureZeroMemory(plainBuf.data(), static_cast<size_t>(outlen));
-            if (!out)
+    // Decrypt one member to @p dst, authenticating each segment before its
+    // plaintext is written. A failed extraction deletes @p dst again.
+    void extract(const Entry& entry, const std::filesystem::path& dst)
+    {
+        const auto& m = entry.member;
+        std::vector<unsigned char> header(static_cast<size_t>(std::min<uint64_t>(
+            m.length, seal::cfg::SEGMENT_KEYED_HEADER_LEN + seal::cfg::KDF_PARAMS_LEN)));
+        readExact(m_File, m.offset, header.data(), header.size());
+        if (!seal::Cryptography::isKeyedSegmentPacket(header) ||
+            seal::Cryptography::isCompressedSegmentPacket(header) ||
+            header.size() < seal::Cryptography::segmentHeaderSize(header))
+            throw std::runtime_error("Malformed archive member");
+        header.resize(seal::Cryptography::segmentHeaderSize(header));
+        // The index authenticates the file nonce, which selects the member's
+        // key; the segments authenticate the rest of the header. Together
+        // they stop members being swapped around inside the archive.
+        if (!std::equal(entry.nonce.begin(),
+                        entry.nonce.end(),
+                        header.begin() + seal::cfg::SEGMENT_HEADER_LEN))
+            throw std::runtime_error("Archive member does not match its index entry");
+
+        const size_t segLen = seal::Cryptography::segmentSize(header);
+        const uint64_t stride = segLen + seal::cfg::TAG_LEN;
+        const uint64_t bodyLen = m.length - header.size();
+        const uint64_t segments = std::max<uint64_t>(1, (bodyLen + stride - 1) / stride);
+        if (bodyLen < seal::cfg::TAG_LEN || bodyLen != m.size + segments * seal::cfg::TAG_LEN)
+            throw std::runtime_error("Malformed archive member");
+
+        HANDLE out = CreateFileW(dst.c_str(),
+                                 GENERIC_WRITE,
+                                 0,
+                                 nullptr,
+                                 CREATE_ALWAYS,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                 nullptr);
+        if (out == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot create file");
+
+        std::vector<unsigned char> sealed(static_cast<size_t>(std::min(stride, bodyLen)));
+        PageBuffer plain;
+        plain.allocate(sealed.size());
+        auto key = seal::Cryptography::segmentFileKey(m_Master, header);
+        try
+        {
+            for (uint64_t i = 0; i < segments; ++i)
             {
-                ioOk = false;
-                break;
+                const size_t n = static_cast<size_t>(std::min(stride, bodyLen - i * stride));
+                readExact(m_File, m.offset + header.size() + i * stride, sealed.data(), n);
+                const auto packet = std::span<const unsigned char>(sealed.data(), n);
+                if (!seal::Cryptography::openSegment(
+                        key, header, i, i + 1 == segments, packet, plain.data()))
+                    throw std::runtime_error(
+                        "Authentication failed (bad password or corrupted data)");
+                if (!writeHandle(out, plain.data(), n - seal::cfg::TAG_LEN))
+                    throw std::runtime_error("Write failed");
             }
-            remaining -= bytesRead;
+            FILETIME written{};
+            written.dwLowDateTime = static_cast<DWORD>(m.writeTime);
+            written.dwHighDateTime = static_cast<DWORD>(m.writeTime >> 32);
+            SetFileTime(out, nullptr, nullptr, &written);
         }
-        in.close();
-
-        if (!ioOk)
+        catch (...)
         {
             seal::Cryptography::cleanseString(key);
-            SecureZeroMemory(ctBuf.data(), ctBuf.size());
-            SecureZeroMemory(plainBuf.data(), plainBuf.size());
-            out.close();
-            DeleteFileA(tmpPath.c_str());
-            return false;
+            CloseHandle(out);
+            DeleteFileW(dst.c_str());
+            throw;
         }
+        seal::Cryptography::cleanseString(key);
+        CloseHandle(out);
+    }
 
-        // Finalize the write-pass context (tag is already verified; this
-        // call flushes any remaining block padding).
-        seal::Cryptography::opensslCheck(
-            EVP_CIPHER_CTX_ctrl(
-                writeCtx.p, EVP_CTRL_GCM_SET_TAG, (int)seal::cfg::TAG_LEN, tag.data()),
-            "SET_TAG(write) failed");
+private:
+    void parse(std::string_view body, uint64_t dataEnd)
+    {
+        auto fail = [] { throw std::runtime_error("Malformed archive index"); };
+        auto nextLine = [&]
+        {
+            const size_t eol = body.find('\n');
+            if (eol == std::string_view::npos)
+                fail();
+            std::string_view line = body.substr(0, eol);
+            body.remove_prefix(eol + 1);
+            return line;
+        };
+        auto field = [&](std::string_view& line)
+        {
+            const size_t tab = line.find('\t');
+            if (tab == std::string_view::npos)
+                fail();
+            std::string_view f = line.substr(0, tab);
+            line.remove_prefix(tab + 1);
+            return f;
+        };
+        auto number = [&](std::string_view f)
+        {
+            uint64_t v = 0;
+            auto [end, ec] = std::from_chars(f.data(), f.data() + f.size(), v);
+            if (ec != std::errc{} || end != f.data() + f.size())
+                fail();
+            return v;
+        };
 
-        unsigned char finBuf[16]{};
-        int fin = 0;
-        (void)EVP_DecryptFinal_ex(writeCtx.p, finBuf, &fin);
-        if (fin > 0)
+        std::string_view first = nextLine();
+        const uint64_t count = number(field(first));
+        if (number(first) != dataEnd)
+            fail();
+        m_Entries.clear();
+        while (!body.empty())
         {
-            out.write(reinterpret_cast<const char*>(finBuf), fin);
+            std::string_view line = nextLine();
+            Entry e;
+            e.member.offset = number(field(line));
+            e.member.length = number(field(line));
+            e.member.size = number(field(line));
+            e.member.writeTime = number(field(line));
+            std::vector<unsigned char> nonce;
+            if (!seal::utils::from_hex(field(line), nonce) || nonce.size() != e.nonce.size())
+                fail();
+            std::copy(nonce.begin(), nonce.end(), e.nonce.begin());
+            e.member.path = std::string(line);
+            if (e.member.path.empty() || e.member.offset < seal::cfg::ARCHIVE_HEADER_LEN ||
+                e.member.offset > dataEnd || e.member.length > dataEnd - e.member.offset)
+                fail();
+            m_Entries.push_back(std::move(e));
         }
-        SecureZeroMemory(finBuf, sizeof(finBuf));
+        if (m_Entries.size() != count)
+            fail();
+        std::sort(m_Entries.begin(),
+                  m_Entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.member.path < b.member.path; });
+    }
 
-        seal::Cryptography::cleanseString(key);
-        SecureZeroMemory(ctBuf.data(), ctBuf.size());
-        SecureZeroMemory(plainBuf.data(), plainBuf.size());
+    OverlappedFile m_File;
+    std::array<unsigned char, seal::cfg::SALT_LEN> m_Salt{};
+    seal::Cryptography::LockedKeyBuffer m_Master;
+    std::vector<Entry> m_Entries;
+};
 
-        out.flush();
-        ioOk = out.good();
-        out.close();
+}  // namespace
 
-        if (ioOk)
+// Pack: list the tree, then seal files on the scheduler and append each
+// finished member to the archive under one lock. Member order in the file
+// is completion order; the index maps paths to offsets.
+template <secure_password SecurePwd>
+bool FileOperations::packDirectory(const std::string& dir,
+                                   const std::string& archivePath,
+                                   const SecurePwd& password)
+{
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    const fs::path root = fs::absolute(dir, ec);
+    if (ec || !fs::is_directory(root, ec))
+    {
+        std::cerr << "(pack) not a directory: " << dir << "\n";
+        return false;
+    }
+    const fs::path target = fs::absolute(archivePath, ec);
+
+    std::vector<PackJob> jobs;
+    bool ok = true;
+    const auto options = fs::directory_options::skip_permission_denied;
+    for (fs::recursive_directory_iterator it(root, options, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        if (it->is_symlink(ec))
         {
-            flushFileToDisk(tmpPath);
+            if (it->is_directory(ec))
+                it.disable_recursion_pending();
+            continue;
+        }
+        if (!it->is_regular_file(ec))
+            continue;
+        // An earlier archive inside the tree it packs is not packed again.
+        std::error_code same;
+        if (fs::equivalent(it->path(), target, same))
+            continue;
+        PackJob job;
+        job.path = it->path();
+        job.listedSize = it->file_size(ec);
+        job.member.path = utf8Path(it->path().lexically_relative(root));
+        jobs.push_back(std::move(job));
+    }
+    if (ec)
+    {
+        std::cerr << "(pack) cannot list: " << dir << "\n";
+        return false;
+    }
 
-            if (!MoveFileExA(tmpPath.c_str(), dstPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+    const std::string tmpPath = archivePath + ".tmp";
+    ArchiveWriter writer;
+    if (!writer.create(tmpPath))
+    {
+        std::cerr << "(pack) cannot create: " << tmpPath << "\n";
+        return false;
+    }
+
+    try
+    {
+        std::array<unsigned char, seal::cfg::SALT_LEN> salt{};
+        if (RAND_bytes(salt.data(), static_cast<int>(salt.size())) != 1)
+            throw std::runtime_error("RAND_bytes(archive salt) failed");
+        const seal::KdfParams kdf = seal::Cryptography::kdfParams();
+        std::array<unsigned char, seal::cfg::ARCHIVE_HEADER_LEN> header{};
+        std::copy_n(seal::cfg::ARCHIVE_HDR, seal::cfg::ARCHIVE_HDR_LEN, header.begin());
+        std::copy(salt.begin(), salt.end(), header.begin() + seal::cfg::ARCHIVE_HDR_LEN);
+        const auto kdfBytes = kdf.encode();
+        std::copy(kdfBytes.begin(),
+                  kdfBytes.end(),
+                  header.begin() + seal::cfg::ARCHIVE_HDR_LEN + seal::cfg::SALT_LEN);
+        if (!writer.append(header.data(), header.size()))
+            throw std::runtime_error("Archive write failed");
+
+        // The one KDF run of the whole archive.
+        auto master = seal::Cryptography::deriveMasterKey(password, salt, kdf);
+        std::mutex writerMutex;
+        std::atomic<size_t> pending{jobs.size()};
+        auto& scheduler = GetScheduler();
+        for (auto& job : jobs)
+        {
+            scheduler.spawn(
+                [&]
+                {
+                    try
+                    {
+                        if (job.listedSize <= seal::cfg::ARCHIVE_BUFFERED)
+                        {
+                            // Small files are sealed off the lock and appended whole.
+                            std::vector<unsigned char> packet;
+                            sealArchiveMember(job,
+                                              master,
+                                              salt,
+                                              kdf,
+                                              [&](const unsigned char* p, size_t n)
+                                              {
+                                                  packet.insert(packet.end(), p, p + n);
+                                                  return true;
+                                              });
+                            std::lock_guard lock(writerMutex);
+                            job.member.offset = writer.offset();
+                            if (!writer.append(packet.data(), packet.size()))
+                                throw std::runtime_error("Archive write failed");
+                        }
+                        else
+                        {
+                            // Large files are sealed into a spool off the
+                            // lock, then copied into the archive in one
+                            // locked run, which keeps their members
+                            // contiguous without serialising the sealing.
+                            CiphertextSpool spool;
+                            sealArchiveMember(job,
+                                              master,
+                                              salt,
+                                              kdf,
+                                              [&](const unsigned char* p, size_t n)
+                                              { return spool.append(p, n); });
+                            if (!spool.rewind())
+                                throw std::runtime_error("Cannot stage member");
+                            std::vector<unsigned char> chunk(seal::cfg::FILE_CHUNK);
+                            std::lock_guard lock(writerMutex);
+                            job.member.offset = writer.offset();
+                            for (uint64_t left = job.member.length; left > 0;)
+                            {
+                                const size_t want =
+                                    static_cast<size_t>(std::min<uint64_t>(left, chunk.size()));
+                                size_t got = 0;
+                                if (!spool.read(chunk.data(), want, got) || got != want)
+                                    throw std::runtime_error("Cannot stage member");
+                                if (!writer.append(chunk.data(), got))
+                                    throw std::runtime_error("Archive write failed");
+                                left -= got;
+                            }
+                        }
+                        job.done = true;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        job.error = e.what();
+                    }
+                    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        GetScheduler().notifyAll();
+                });
+        }
+        scheduler.runUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
+
+        std::sort(jobs.begin(),
+                  jobs.end(),
+                  [](const PackJob& a, const PackJob& b) { return a.member.path < b.member.path; });
+        for (const auto& job : jobs)
+        {
+            if (!job.done)
             {
-                std::cerr << "(decrypt-stream) cannot rename to destination: " << dstPath << "\n";
-                DeleteFileA(tmpPath.c_str());
-                return false;
+                std::cerr << "(pack) " << job.error << ": " << job.member.path << "\n";
+                ok = false;
             }
-            return true;
         }
 
-        std::cerr << "(decrypt-stream) write error: " << tmpPath << "\n";
+        if (ok)
+        {
+            // [ rawLength(8) | compressed index text ], sealed under the
+            // index subkey, then the trailer that points back at it.
+            std::string text = archiveIndexText(jobs, writer.offset());
+            const auto raw = std::span<const unsigned char>(
+                reinterpret_cast<const unsigned char*>(text.data()), text.size());
+            auto packed = seal::compression::compress(raw);
+            std::vector<unsigned char> payload(8);
+            storeU64BE(payload.data(), raw.size());
+            payload.insert(payload.end(), packed.begin(), packed.end());
+            seal::Cryptography::cleanseString(text, packed);
+
+            auto indexKey = seal::Cryptography::deriveSubkey(master, kArchiveIndexInfo);
+            auto index = seal::Cryptography::encryptWithKey(payload, indexKey);
+            seal::Cryptography::cleanseString(indexKey, payload);
+
+            std::array<unsigned char, seal::cfg::ARCHIVE_TRAILER_LEN> trailer{};
+            storeU64BE(trailer.data(), index.size());
+            std::copy_n(seal::cfg::ARCHIVE_HDR, seal::cfg::ARCHIVE_HDR_LEN, trailer.begin() + 8);
+            ok = writer.append(index.data(), index.size()) &&
+                 writer.append(trailer.data(), trailer.size()) && writer.finish();
+            if (!ok)
+                std::cerr << "(pack) write failed: " << tmpPath << "\n";
+        }
+        seal::Cryptography::cleanseString(master);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "(pack) " << e.what() << ": " << archivePath << "\n";
+        ok = false;
+    }
+    writer.close();
+
+    if (ok && !MoveFileExA(tmpPath.c_str(),
+                           archivePath.c_str(),
+                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        std::cerr << "(pack) cannot rename: " << tmpPath << "\n";
+        ok = false;
+    }
+    if (!ok)
         DeleteFileA(tmpPath.c_str());
-        return false;
+    return ok;
+}
+
+template <secure_password SecurePwd>
+std::vector<ArchiveMember> FileOperations::listArchive(const std::string& archivePath,
+                                                       const SecurePwd& password)
+{
+    ArchiveReader reader;
+    reader.open(archivePath, password);
+    std::vector<ArchiveMember> members;
+    members.reserve(reader.entries().size());
+    for (const auto& entry : reader.entries())
+        members.push_back(entry.member);
+    return members;
+}
+
+template <secure_password SecurePwd>
+bool FileOperations::unpackArchive(const std::string& archivePath,
+                                   const std::string& dstDir,
+                                   const SecurePwd& password,
+                                   const std::string& member)
+{
+    namespace fs = std::filesystem;
+
+    struct UnpackJob
+    {
+        const ArchiveReader::Entry* entry;
+        fs::path dst;
+        std::string error;
+    };
+
+    ArchiveReader reader;
+    try
+    {
+        reader.open(archivePath, password);
     }
     catch (const std::exception& e)
     {
-        std::cerr << "(decrypt-stream) " << e.what() << "\n";
+        std::cerr << "(unpack) " << e.what() << ": " << archivePath << "\n";
+        return false;
+    }
+
+    std::error_code ec;
+    const fs::path root = fs::absolute(dstDir, ec);
+    if (ec)
+    {
+        std::cerr << "(unpack) bad path: " << dstDir << "\n";
+        return false;
+    }
+
+    std::vector<UnpackJob> jobs;
+    std::set<fs::path> dirs{root};
+    for (const auto& entry : reader.entries())
+    {
+        if (!member.empty() && entry.member.path != member)
+            continue;
+        const fs::path rel = fromUtf8Path(entry.member.path).lexically_normal();
+        if (!safeMemberPath(rel))
+        {
+            std::cerr << "(unpack) unsafe member path: " << entry.member.path << "\n";
+            return false;
+        }
+        jobs.push_back({&entry, root / rel, {}});
+        dirs.insert(jobs.back().dst.parent_path());
+    }
+    if (!member.empty() && jobs.empty())
+    {
+        std::cerr << "(unpack) no such member: " << member << "\n";
         return false;
     }
+    for (const auto& d : dirs)
+    {
+        fs::create_directories(d, ec);
+        if (ec)
+        {
+            std::cerr << "(unpack) cannot create: " << d.string() << "\n";
+            return false;
+        }
+    }
+
+    std::atomic<size_t> pending{jobs.size()};
+    auto& scheduler = GetScheduler();
+    for (auto& job : jobs)
+    {
+        scheduler.spawn(
+            [&job, &pending, &reader]
+            {
+                try
+                {
+                    reader.extract(*job.entry, job.dst);
+                }
+                catch (const std::exception& e)
+                {
+                    job.error = e.what();
+                    if (job.error.empty())
+                        job.error = "Extraction failed";
+                }
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    GetScheduler().notifyAll();
+            });
+    }
+    scheduler.runUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
+
+    bool ok = true;
+    for (const auto& job : jobs)
+    {
+        if (!job.error.empty())
+        {
+            std::cerr << "(unpack) " << job.error << ": " << job.entry->member.path << "\n";
+            ok = false;
+        }
+    }
+    return ok;
 }
 
 using SecNarrow = seal::secure_string<>;
@@ -1385,44 +4866,118 @@ using SecWide = seal::basic_secure_string<wchar_t>;
 // unresolved-symbol errors.
 template bool FileOperations::encryptFileTo(const std::string&,
                                             const std::string&,
-                                            const SecNarrow&);
-template bool FileOperations::encryptFileTo(const std::string&, const std::string&, const SecWide&);
+                                            const SecNarrow&,
+                                            unsigned,
+                                            FileKeyring*);
+template bool FileOperations::encryptFileTo(const std::string&,
+                                            const std::string&,
+                                            const SecWide&,
+                                            unsigned,
+                                            FileKeyring*);
 
 template bool FileOperations::decryptFileTo(const std::string&,
                                             const std::string&,
-                                            const SecNarrow&);
-template bool FileOperations::decryptFileTo(const std::string&, const std::string&, const SecWide&);
+                                            const SecNarrow&,
+                                            unsigned,
+                                            FileKeyring*);
+template bool FileOperations::decryptFileTo(const std::string&,
+                                            const std::string&,
+                                            const SecWide&,
+                                            unsigned,
+                                            FileKeyring*);
 
 template std::string FileOperations::encryptLine(const std::string&, const SecNarrow&);
 template std::string FileOperations::encryptLine(const std::string&, const SecWide&);
 
 template seal::secure_string<seal::locked_allocator<char>> FileOperations::decryptLine(
-    const std::string&, const SecNarrow&);
+    std::string_view, const SecNarrow&);
 template seal::secure_string<seal::locked_allocator<char>> FileOperations::decryptLine(
-    const std::string&, const SecWide&);
+    std::string_view, const SecWide&);
 
 template bool FileOperations::parseTriples(
     std::string_view, std::vector<seal::secure_triplet16<seal::locked_allocator<wchar_t>>>&);
 
-template bool FileOperations::processDirectory(const std::string&, const SecWide&, bool);
-template bool FileOperations::processFilePath(const std::string&, const SecWide&);
+template bool FileOperations::processDirectory(const std::string&,
+                                               const SecWide&,
+                                               bool,
+                                               FileKeyring*);
+template bool FileOperations::processFilePath(const std::string&, const SecWide&, FileKeyring*);
+
+template bool FileOperations::syncDirectory(const std::string&,
+                                            const std::string&,
+                                            const SecNarrow&);
+template bool FileOperations::syncDirectory(const std::string&,
+                                            const std::string&,
+                                            const SecWide&);
 
 template void FileOperations::processBatch(const std::vector<std::string>&, bool, const SecWide&);
+template void FileOperations::processBatch(std::span<const std::string_view>,
+                                            bool,
+                                            const SecWide&);
 
 template bool FileOperations::encryptFileStreaming(const std::string&,
                                                    const std::string&,
-                                                   const SecNarrow&);
+                                                   const SecNarrow&,
+                                                   unsigned,
+                                                   FileKeyring*);
 template bool FileOperations::encryptFileStreaming(const std::string&,
                                                    const std::string&,
-                                                   const SecWide&);
+                                                   const SecWide&,
+                                                   unsigned,
+                                                   FileKeyring*);
 
 template bool FileOperations::decryptFileStreaming(const std::string&,
                                                    const std::string&,
-                                                   const SecNarrow&);
+                                                   const SecNarrow&,
+                                                   unsigned,
+                                                   FileKeyring*);
 template bool FileOperations::decryptFileStreaming(const std::string&,
                                                    const std::string&,
-                                                   const SecWide&);
+                                                   const SecWide&,
+                                                   unsigned,
+                                                   FileKeyring*);
 
+template bool FileOperations::decryptSegmentedFile(const std::string&,
+                                                   const std::string&,
+                                                   const SecNarrow&,
+                                                   unsigned,
+                                                   FileKeyring*);
+template bool FileOperations::decryptSegmentedFile(const std::string&,
+                                                   const std::string&,
+                                                   const SecWide&,
+                                                   unsigned,
+                                                   FileKeyring*);
+
+template void FileOperations::verifyFile(const std::string&, const SecNarrow&, FileKeyring*);
+template void FileOperations::verifyFile(const std::string&, const SecWide&, FileKeyring*);
+template uint64_t FileOperations::decryptRange(
+    const std::string&, uint64_t, uint64_t, std::ostream&, const SecNarrow&, FileKeyring*);
+template uint64_t FileOperations::decryptRange(
+    const std::string&, uint64_t, uint64_t, std::ostream&, const SecWide&, FileKeyring*);
+template VerifySummary FileOperations::verifyDirectory(const std::string&,
+                                                       const SecNarrow&,
+                                                       std::ostream&);
+template VerifySummary FileOperations::verifyDirectory(const std::string&,
+                                                       const SecWide&,
+                                                       std::ostream&);
+template bool FileOperations::packDirectory(const std::string&,
+                                            const std::string&,
+                                            const SecNarrow&);
+template bool FileOperations::packDirectory(const std::string&,
+                                            const std::string&,
+                                            const SecWide&);
+template std::vector<ArchiveMember> FileOperations::listArchive(const std::string&,
+                                                                const SecNarrow&);
+template std::vector<ArchiveMember> FileOperations::listArchive(const std::string&,
+                                                                const SecWide&);
+template bool FileOperations::unpackArchive(const std::string&,
+                                            const std::string&,
+                                            const SecNarrow&,
+                                            const std::string&);
+template bool FileOperations::unpackArchive(const std::string&,
+                                            const std::string&,
+                                            const SecWide&,
+                                            const std::string&);
 template bool FileOperations::streamEncrypt(const SecWide&);
 template bool FileOperations::streamDecrypt(const SecWide&);
 
@@ -2,6 +2,9 @@
 
 #include "Cryptography.h"
 
+#include <cstdint>
+#include <iosfwd>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -9,6 +12,46 @@
 namespace seal
 {
 
+class FileKeyring;
+
+/**
+ * @brief Digest computed by FileOperations::hashFile() and hashDirectory().
+ * @ingroup IO_FileOperations
+ */
+enum class HashAlgorithm
+{
+    Sha256,  ///< SHA-256; OpenSSL uses the CPU's SHA extensions when present.
+    Blake2b  ///< BLAKE2b-512; roughly 2x SHA-256 per core on CPUs without them.
+};
+
+/**
+ * @struct VerifySummary
+ * @brief Outcome of FileOperations::verifyDirectory().
+ * @ingroup IO_FileOperations
+ */
+struct VerifySummary
+{
+    size_t passed = 0;   ///< Files whose password and tags checked out
+    size_t failed = 0;   ///< Files that did not verify
+    bool listed = true;  ///< False if the tree could not be fully listed
+
+    [[nodiscard]] bool ok() const noexcept { return listed && failed == 0; }
+};
+
+/**
+ * @struct ArchiveMember
+ * @brief One file of a FileOperations::packDirectory() archive, as its index records it.
+ * @ingroup IO_FileOperations
+ */
+struct ArchiveMember
+{
+    std::string path;        ///< UTF-8 path relative to the packed root, `/`-separated
+    uint64_t size = 0;       ///< Plaintext bytes
+    uint64_t writeTime = 0;  ///< Last-write FILETIME, restored on extraction
+    uint64_t offset = 0;     ///< Start of the member's packet within the archive
+    uint64_t length = 0;     ///< Bytes of that packet
+};
+
 /**
  * @class FileOperations
  * @brief Static utility class for file-level encryption, decryption,
@@ -31,17 +74,30 @@ namespace seal
  *
  * ## :material-folder-lock: Directory & Batch Processing
  *
- * processDirectory() walks a directory tree with `FindFirstFileA`,
+ * processDirectory() walks a directory tree with `FindFirstFileExA`,
  * encrypting or decrypting each file based on its `.seal` extension
  * and renaming in place. processBatch() dispatches mixed CLI input
  * (file paths, hex tokens, raw plaintext) through the appropriate
  * encrypt/decrypt path, with support for masked credential display
- * in censored mode via MaskedCredentialView.
+ * in censored mode via MaskedCredentialView. Both share one FileKeyring
+ * across the files they touch, so a batch pays for scrypt once.
+ *
+ * ## :material-archive-lock: Archives
+ *
+ * packDirectory() streams a whole tree into one archive instead of one
+ * `.seal` file per input: one KDF run, one output file and one flush,
+ * however many files there are. Every member is a keyed segmented packet
+ * under the archive's salt, and an encrypted, compressed index at the
+ * end records where each one starts. listArchive() and unpackArchive()
+ * read only the trailer and the index, then seek straight to the members
+ * they need, so listing or extracting one file never decrypts the rest.
  *
  * ## :material-pipe: Stream Mode
  *
  * streamEncrypt() / streamDecrypt() provide stdin-to-stdout binary
  * piping for shell integration (`seal -e < input > output.seal`).
+ * Both work in `cfg::FILE_CHUNK` pieces on the raw standard handles,
+ * so memory use is bounded regardless of how much data is piped.
  *
  * ## :material-format-list-group: Triple Helpers
  *
@@ -65,16 +121,24 @@ public:
      * @p srcPath is never modified -- the caller should delete it only after
      * this method returns `true`.
      *
+     * With a @p keyring, files of every size are written in the keyed
+     * segmented format under the keyring's batch salt, so a batch runs
+     * scrypt once.
+     *
      * @tparam SecurePwd Secure password container.
      * @param srcPath Source file to read (left unmodified).
      * @param dstPath Destination path for the encrypted output.
      * @param pwd     Master password for key derivation.
+     * @param threads Worker threads for segmented files (0 = one per CPU).
+     * @param keyring Batch keyring, or `nullptr` for a per-file scrypt.
      * @return `true` on success, `false` on I/O or encryption error.
      */
     template <secure_password SecurePwd>
     static bool encryptFileTo(const std::string& srcPath,
                               const std::string& dstPath,
-                              const SecurePwd& pwd);
+                              const SecurePwd& pwd,
+                              unsigned threads = 1,
+                              FileKeyring* keyring = nullptr);
 
     /**
      * @brief Decrypt a file to a new destination without modifying the source.
@@ -88,12 +152,17 @@ public:
      * @param srcPath Encrypted source file to read (left unmodified).
      * @param dstPath Destination path for the decrypted output.
      * @param pwd     Master password for key derivation.
+     * @param threads Worker threads for segmented files (0 = one per CPU).
+     * @param keyring Batch keyring whose cached master keys are reused for
+     *                keyed files, or `nullptr`.
      * @return `true` on success, `false` on I/O or authentication error.
      */
     template <secure_password SecurePwd>
     static bool decryptFileTo(const std::string& srcPath,
                               const std::string& dstPath,
-                              const SecurePwd& pwd);
+                              const SecurePwd& pwd,
+                              unsigned threads = 1,
+                              FileKeyring* keyring = nullptr);
 
     /**
      * @brief Encrypt a UTF-8 string and return the result as a hex string.
@@ -120,47 +189,160 @@ public:
      */
     template <secure_password SecurePwd>
     [[nodiscard]] static seal::secure_string<seal::locked_allocator<char>> decryptLine(
-        const std::string& rawHex, const SecurePwd& pwd);
+        std::string_view rawHex, const SecurePwd& pwd);
 
     /**
      * @brief Encrypt a file to a new destination using chunked streaming I/O.
      *
-     * For files larger than `cfg::FILE_CHUNK` (1 MiB), reads the source in
-     * chunks and feeds them incrementally to AES-256-GCM via `EVP_EncryptUpdate`,
-     * avoiding loading the entire file into memory. The wire format is identical
-     * to `encryptPacket` so the output is interoperable with all existing decrypt
-     * paths. For small files, delegates to the single-shot `encryptFileTo` path.
+     * For files larger than `cfg::FILE_CHUNK` (1 MiB), reads the source one
+     * `cfg::SEGMENT_LEN` segment at a time and writes the segmented (STREAM)
+     * format, with every segment sealed under its own GCM tag. Segments are
+     * sealed on @p threads workers and written in order through a bounded
+     * reorder ring, so throughput scales with cores rather than one GCM lane.
+     * Reads and writes use overlapped I/O so the disk stays busy while the
+     * workers seal; the plaintext source is read with `FILE_FLAG_NO_BUFFERING`
+     * where the volume allows it. The output is accepted by
+     * decryptFileStreaming(), `Cryptography::decryptPacket` and
+     * `Cryptography::verifyPacket`. Small files use the single-shot
+     * `encryptFileTo` path and the classic packet layout.
      *
      * @tparam SecurePwd Secure password container.
      * @param srcPath Source file to read (left unmodified).
      * @param dstPath Destination path for the encrypted output.
      * @param pwd     Master password for key derivation.
+     * @param threads Worker threads for segmented files (0 = one per CPU).
+     * @param keyring Batch keyring (keyed header), or `nullptr`.
      * @return `true` on success, `false` on I/O or encryption error.
      */
     template <secure_password SecurePwd>
     static bool encryptFileStreaming(const std::string& srcPath,
                                      const std::string& dstPath,
-                                     const SecurePwd& pwd);
+                                     const SecurePwd& pwd,
+                                     unsigned threads = 1,
+                                     FileKeyring* keyring = nullptr);
 
     /**
      * @brief Decrypt a file to a new destination using chunked streaming I/O.
      *
-     * For files larger than `cfg::FILE_CHUNK` (1 MiB) plus framing overhead,
-     * reads the ciphertext in chunks and feeds them incrementally to
-     * `EVP_DecryptUpdate`. The GCM authentication tag is read from the end of
-     * the file before the streaming pass begins. For small files, delegates to
-     * the single-shot `decryptFileTo` path.
+     * Used for files larger than `cfg::FILE_CHUNK` (1 MiB) plus framing
+     * overhead. Segmented files are decrypted in a single pass on @p threads
+     * workers, each segment being authenticated before its plaintext is
+     * written in order, with overlapped reads and (where the volume allows
+     * it) unbuffered plaintext writes. Classic single-tag
+     * packets need two passes: one to verify the tag read from the end of
+     * the file, one to write. For small files, delegates to the single-shot
+     * `decryptFileTo` path.
      *
      * @tparam SecurePwd Secure password container.
      * @param srcPath Encrypted source file to read (left unmodified).
      * @param dstPath Destination path for the decrypted output.
      * @param pwd     Master password for key derivation.
+     * @param threads Worker threads for segmented files (0 = one per CPU).
+     * @param keyring Batch keyring for keyed files, or `nullptr`.
      * @return `true` on success, `false` on I/O or authentication error.
      */
     template <secure_password SecurePwd>
     static bool decryptFileStreaming(const std::string& srcPath,
                                      const std::string& dstPath,
-                                     const SecurePwd& pwd);
+                                     const SecurePwd& pwd,
+                                     unsigned threads = 1,
+                                     FileKeyring* keyring = nullptr);
+
+    /**
+     * @brief Single-pass decryption of a segmented file (see decryptFileStreaming()).
+     *
+     * Opens @p srcPath itself for overlapped reads; the caller has only
+     * checked the magic.
+     */
+    template <secure_password SecurePwd>
+    static bool decryptSegmentedFile(const std::string& srcPath,
+                                     const std::string& dstPath,
+                                     const SecurePwd& pwd,
+                                     unsigned threads,
+                                     FileKeyring* keyring);
+
+    /**
+     * @brief Check the password and every GCM tag of an encrypted file.
+     *
+     * The file is read front to back once, in fixed buffers, with the next
+     * read in flight while the current one is authenticated: one segment
+     * at a time for the segmented format, `cfg::FILE_CHUNK` pieces for
+     * classic packets (whose tag is read from the end first). Peak memory
+     * does not depend on the file size, nothing is written, and decrypted
+     * bytes never leave a locked scratch buffer.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param path    Encrypted file.
+     * @param pwd     Master password for key derivation.
+     * @param keyring Batch keyring, so keyed files of one batch share a KDF
+     *                run; or `nullptr`.
+     * @throw std::runtime_error on authentication failure, a malformed file,
+     *        or a read error.
+     */
+    template <secure_password SecurePwd>
+    static void verifyFile(const std::string& path,
+                           const SecurePwd& pwd,
+                           FileKeyring* keyring = nullptr);
+
+    /**
+     * @brief Decrypt plaintext bytes [@p offset, @p offset + @p length) of an encrypted file.
+     *
+     * Segmented files are random access: only the segments covering the
+     * range are read, authenticated and opened, so the cost depends on
+     * @p length rather than the file size. Plain segmented files locate
+     * them by their fixed stride; compressed ones read and authenticate
+     * the segment table first. A range that ends before the last segment
+     * cannot see truncation after it; one that reaches the end checks the
+     * final-segment flag as a full decrypt does. An empty range (@p length
+     * 0, or @p offset at or past the end) still opens the final segment, so
+     * a wrong password fails whatever the range.
+     *
+     * A classic packet has one tag over the whole ciphertext, so no byte
+     * can be released before all of it is checked. Small ones are opened
+     * in memory; larger ones are refused.
+     *
+     * Each segment is authenticated before any of its bytes reach @p out,
+     * so on failure @p out holds an authentic prefix of the range.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param path    Encrypted file.
+     * @param offset  First plaintext byte.
+     * @param length  Bytes wanted; the range is clipped at the end of the plaintext.
+     * @param out     Receives the plaintext (binary).
+     * @param pwd     Master password for key derivation.
+     * @param keyring Batch keyring, or `nullptr`.
+     * @return Bytes written to @p out; 0 if @p offset is at or past the end.
+     * @throw std::runtime_error on authentication failure, a malformed file,
+     *        a classic packet too large to open in memory, or an I/O error.
+     */
+    template <secure_password SecurePwd>
+    static uint64_t decryptRange(const std::string& path,
+                                 uint64_t offset,
+                                 uint64_t length,
+                                 std::ostream& out,
+                                 const SecurePwd& pwd,
+                                 FileKeyring* keyring = nullptr);
+
+    /**
+     * @brief Verify every `.seal` file under a directory in parallel.
+     *
+     * Files are checked with verifyFile() as tasks on the processDirectory()
+     * scheduler, sharing one FileKeyring, so keyed files written by one
+     * directory batch pay for the KDF once. Once all are done, one
+     * `relative/path: OK` or `relative/path: FAILED (<reason>)` line per
+     * file is written to @p out, sorted by path, as `sha256sum -c` reports.
+     * Reparse points are not followed.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param dir Root directory.
+     * @param pwd Master password for key derivation.
+     * @param out Destination for the per-file lines.
+     * @return Pass and fail counts.
+     */
+    template <secure_password SecurePwd>
+    static VerifySummary verifyDirectory(const std::string& dir,
+                                         const SecurePwd& pwd,
+                                         std::ostream& out);
 
     /**
      * @brief Compute the serialized wide-character length of a triple as `s:u:p`.
@@ -200,12 +382,20 @@ public:
     /**
      * @brief Encrypt/decrypt all files in a directory tree (CLI path).
      *
-     * Walks the directory with `FindFirstFileA`, skipping `.exe` and the
-     * `seal` binary itself. Each file is encrypted or decrypted based on
-     * its `.seal` extension and renamed in place after successful I/O.
-     * Subdirectory recursion is parallelised via a fixed-size worker pool
-     * (`min(hardware_concurrency, 8)` threads, bounded task queue); files
-     * within a single directory are processed sequentially.
+     * Walks the directory with `FindFirstFileExA` (basic info, large
+     * fetch), skipping `.exe` and the `seal` binary itself. Each file is
+     * encrypted or decrypted based on its `.seal` extension and renamed
+     * in place after successful I/O.
+     * Every file and subdirectory becomes a task on a work-stealing
+     * scheduler (`min(hardware_concurrency, 8)` workers, one deque each).
+     * Tasks never wait on each other, so tree depth cannot starve the
+     * pool; the calling thread helps run tasks until the whole tree is
+     * done. Each directory prints its summary once its last task ends.
+     * At most 4096 file tasks are queued at a time; a listing that hits
+     * the cap runs queued files itself, so enumeration and crypto overlap
+     * without a task per entry piling up on huge directories.
+     * The whole walk shares one FileKeyring, so encrypting (or decrypting)
+     * the tree runs scrypt once rather than once per file.
      *
      * @note This is the CLI-mode directory processor. The GUI-mode
      *       seal::encryptDirectory() / seal::decryptDirectory() in Vault.h
@@ -216,12 +406,124 @@ public:
      * @param dir      Root directory path.
      * @param password Master password for key derivation.
      * @param recurse  Recurse into subdirectories when `true`.
+     * @param keyring  Keyring to share with the caller's batch; `nullptr`
+     *                 gives the walk its own.
      * @return `true` if all processed files succeeded.
      */
     template <secure_password SecurePwd>
     static bool processDirectory(const std::string& dir,
                                  const SecurePwd& password,
-                                 bool recurse = true);
+                                 bool recurse = true,
+                                 FileKeyring* keyring = nullptr);
+
+    /**
+     * @brief Incrementally mirror a directory tree into an encrypted copy.
+     *
+     * Every regular file under @p srcDir is encrypted to
+     * `dstDir/<relative path>.seal`; the source tree is never modified.
+     * A DirectoryManifest at `dstDir/.seal-manifest` records the size,
+     * last-write time and hashFile() digest of each file sealed, and the
+     * next run only touches what changed:
+     *
+     * - Same size and last-write time as recorded: skipped without reading.
+     * - Different time but same size and hash (touched, not edited): only
+     *   the recorded time is refreshed.
+     * - Otherwise the file is hashed and re-encrypted.
+     * - Recorded files that no longer exist in the source have their
+     *   `.seal` copy removed.
+     *
+     * Changed files are encrypted on the processDirectory() scheduler with
+     * one FileKeyring for the run. The manifest is checkpointed every 64
+     * files or 1 GiB, so an interrupted run resumes from its last
+     * checkpoint on the next call instead of starting over.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param srcDir   Plaintext tree to mirror.
+     * @param dstDir   Encrypted mirror; created if missing. Must not lie
+     *                 inside @p srcDir or contain it.
+     * @param password Master password for the files and the manifest.
+     * @return `true` if every new or changed file was sealed and the
+     *         manifest saved; `false` on any failure, including a manifest
+     *         that does not open under @p password.
+     */
+    template <secure_password SecurePwd>
+    static bool syncDirectory(const std::string& srcDir,
+                              const std::string& dstDir,
+                              const SecurePwd& password);
+
+    /**
+     * @brief Pack every file under a directory into one encrypted archive.
+     *
+     * Layout: `"sla1" | salt(16) | kdf(4)`, then one member per file, then
+     * the index, then `indexLength(8) | "sla1"`. A member is a complete
+     * keyed segmented packet (Cryptography::makeSegmentHeader() with
+     * `keyed = true`) under the archive salt, so each is authenticated
+     * segment by segment and could be cut out and decrypted on its own
+     * with just the password. The index lists every member's path, size,
+     * last-write time, offset, length and file nonce; it is compressed
+     * (compression::compress()) and sealed with Cryptography::encryptWithKey()
+     * under the HKDF subkey `"seal/archive/index/v1"` of the archive's
+     * master key.
+     *
+     * Files are read and sealed in parallel on the processDirectory()
+     * scheduler and appended in whatever order they finish, through one
+     * buffered writer. Members are sealed off the writer lock, in memory up
+     * to `cfg::ARCHIVE_BUFFERED` bytes and through a temp-file spool above
+     * it, and the lock is held only to append them. The archive is written to
+     * `archivePath.tmp`, flushed once and renamed into place. Only regular
+     * files are packed: reparse points are skipped and empty directories
+     * are not recorded.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param dir         Root directory; left untouched.
+     * @param archivePath Archive to create (replaced if it exists).
+     * @param password    Master password.
+     * @return `true` if every file was packed and the archive renamed into place.
+     */
+    template <secure_password SecurePwd>
+    static bool packDirectory(const std::string& dir,
+                              const std::string& archivePath,
+                              const SecurePwd& password);
+
+    /**
+     * @brief List the members of a packDirectory() archive.
+     *
+     * Reads the trailer and the index only: one KDF run and one small
+     * read, whatever the archive size.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param archivePath Archive file.
+     * @param password    Master password.
+     * @return Members sorted by path.
+     * @throw std::runtime_error if the file is not an archive, is truncated,
+     *        or its index fails authentication (wrong password or tampering).
+     */
+    template <secure_password SecurePwd>
+    [[nodiscard]] static std::vector<ArchiveMember> listArchive(const std::string& archivePath,
+                                                                const SecurePwd& password);
+
+    /**
+     * @brief Extract a packDirectory() archive, or one member of it.
+     *
+     * Members are extracted in parallel on the processDirectory() scheduler,
+     * each read straight from its offset, with every segment authenticated
+     * before its plaintext is written; a member that fails is deleted
+     * again. Last-write times are restored from the index. Paths that are
+     * absolute or climb out of @p dstDir are refused.
+     *
+     * @tparam SecurePwd Secure password container.
+     * @param archivePath Archive file.
+     * @param dstDir      Directory to extract into; created if missing.
+     * @param password    Master password.
+     * @param member      Extract only this member path (as listArchive() prints
+     *                    it); empty extracts everything.
+     * @return `true` if every requested member was extracted.
+     */
+    template <secure_password SecurePwd>
+    static bool unpackArchive(const std::string& archivePath,
+                              const std::string& dstDir,
+                              const SecurePwd& password,
+                              const std::string& member = {});
 
     /**
      * @brief Process a single file path or convenience token.
@@ -234,10 +536,13 @@ public:
      * @tparam SecurePwd Secure password container.
      * @param raw      Raw path string (may be quoted).
      * @param password Master password for key derivation.
+     * @param keyring  Batch keyring, or `nullptr` for a per-file scrypt.
      * @return `true` if the path was recognized and processed successfully.
      */
     template <secure_password SecurePwd>
-    static bool processFilePath(const std::string& raw, const SecurePwd& password);
+    static bool processFilePath(const std::string& raw,
+                                const SecurePwd& password,
+                                FileKeyring* keyring = nullptr);
 
     /**
      * @brief Batch dispatcher for mixed CLI input.
@@ -246,19 +551,33 @@ public:
      * - File paths are encrypted/decrypted/renamed via processFilePath().
      * - Hex tokens are decrypted; if they contain triples, they are
      *   aggregated for the masked interactive view; otherwise the plaintext
-     *   is copied to the clipboard with a TTL scrub.
-     * - Other text is encrypted and the hex is printed to stdout.
+     *   is copied to the clipboard with a TTL scrub. The tokens of all
+     *   lines are decrypted in parallel on the worker pool, each exactly
+     *   once up front (censored clicks re-decrypt a single token).
+     * - Other text is encrypted and the hex is printed to stdout. All such
+     *   lines go through one Cryptography::encryptBatch(), so they share a
+     *   single scrypt run.
      *
      * In censored mode (`uncensored == false`), decrypted plaintext is
      * never printed: triples go to MaskedCredentialView and non-triples
      * are echoed as `*` characters.
      *
+     * The lines are only read, never copied wholesale: hex tokens and
+     * plaintext are processed as views into them, so the caller keeps
+     * ownership and wipes the buffer afterwards.
+     *
      * @tparam SecurePwd Secure password container.
      * @param lines      Input lines to process.
      * @param uncensored Print plaintext when `true`, mask when `false`.
      * @param password   Master password for key derivation.
      */
     template <secure_password SecurePwd>
+    static void processBatch(std::span<const std::string_view> lines,
+                             bool uncensored,
+                             const SecurePwd& password);
+
+    /// @brief processBatch() over owned lines, e.g. from readBulkLinesDualFrom().
+    template <secure_password SecurePwd>
     static void processBatch(const std::vector<std::string>& lines,
                              bool uncensored,
                              const SecurePwd& password);
@@ -266,8 +585,9 @@ public:
     /**
      * @brief Stream encryption: read from stdin, encrypt, write binary to stdout.
      *
-     * Reads all data from `std::cin`, encrypts via AES-256-GCM, and writes
-     * the binary packet to `std::cout`. Use with shell redirection:
+     * Reads stdin in `cfg::FILE_CHUNK` pieces, encrypts via AES-256-GCM,
+     * and writes the binary packet to stdout as it goes. The output has
+     * the same layout as `encryptPacket`. Use with shell redirection:
      * `seal -e < input.txt > output.seal`
      *
      * @tparam SecurePwd Secure password container.
@@ -280,9 +600,12 @@ public:
     /**
      * @brief Stream decryption: read binary from stdin, decrypt, write to stdout.
      *
-     * Reads a binary encrypted packet from `std::cin`, decrypts via
-     * AES-256-GCM, and writes the plaintext to `std::cout`. Use with
-     * shell redirection: `seal -d < input.seal > output.txt`
+     * Reads a binary encrypted packet from stdin, decrypts via
+     * AES-256-GCM, and writes the plaintext to stdout. The tag is
+     * verified before any plaintext is written: seekable input is read
+     * twice, pipe input is staged (ciphertext only) in memory or a
+     * delete-on-close temp file. Use with shell redirection:
+     * `seal -d < input.seal > output.txt`
      *
      * @tparam SecurePwd Secure password container.
      * @param password Master password for key derivation.
@@ -294,8 +617,13 @@ public:
     /**
      * @brief Securely delete a file by overwriting with random data then removing.
      *
-     * Performs three overwrite passes (random, zeros, random) to prevent
-     * data recovery, then deletes the file.
+     * On rotational media, performs three overwrite passes (random, zeros,
+     * random) to prevent data recovery, then deletes the file. Volumes
+     * without a seek penalty (SSDs, per `IOCTL_STORAGE_QUERY_PROPERTY`)
+     * get one random pass followed by `FSCTL_FILE_LEVEL_TRIM`, since wear
+     * levelling remaps every rewrite anyway. Passes are written unbuffered
+     * and write-through, with `cfg::SHRED_DEPTH` overlapped requests of
+     * `cfg::SHRED_CHUNK` bytes in flight.
      *
      * @param path Filesystem path to the file to shred.
      * @return `true` on success, `false` on error.
@@ -303,14 +631,52 @@ public:
     static bool shredFile(const std::string& path);
 
     /**
-     * @brief Compute the SHA-256 hash of a file.
+     * @brief Shred every file under a directory, then remove the tree.
+     *
+     * Files are grouped by volume and shredded as in shredFile(): one at
+     * a time on a rotational volume, `cfg::SHRED_SSD_LANES` at a time on
+     * flash, and all volumes in parallel on the processDirectory()
+     * scheduler. Symbolic links and junctions are removed, never followed.
+     *
+     * @param dir Root directory.
+     * @return `true` if every file was shredded and the tree removed; after
+     *         a failed file (reported on stderr) the directories are kept.
+     */
+    static bool shredDirectory(const std::string& dir);
+
+    /**
+     * @brief Compute the SHA-256 (or BLAKE2b) hash of a file.
      *
-     * Reads the file in 64KB chunks and produces a hex-encoded hash string.
+     * Files of at least `cfg::HASH_MAP_MIN` bytes are hashed straight from
+     * `cfg::HASH_MAP_VIEW` views of a read-only file mapping, so the data
+     * is never copied into a user buffer; smaller ones are read in 64KB
+     * chunks. Both open the file for sequential scan.
      *
      * @param path Filesystem path to the file.
-     * @return Hex-encoded SHA-256 hash, or empty string on error.
+     * @param algo Digest to compute.
+     * @return Hex-encoded digest, or empty string on error (including an
+     *         in-page error while reading a mapped view).
+     */
+    [[nodiscard]] static std::string hashFile(const std::string& path,
+                                              HashAlgorithm algo = HashAlgorithm::Sha256);
+
+    /**
+     * @brief Hash every file under a directory in parallel.
+     *
+     * Files are hashed with hashFile() as tasks on the processDirectory()
+     * scheduler. Once all are done, one `digest  relative/path` line per
+     * file is written to @p out, sorted by path, which is the format
+     * `sha256sum -c` reads. Reparse points are not followed.
+     *
+     * @param dir  Root directory.
+     * @param out  Destination for the manifest lines.
+     * @param algo Digest to compute.
+     * @return `true` if every file was hashed; a failed file is reported
+     *         on stderr and left out of the manifest.
      */
-    [[nodiscard]] static std::string hashFile(const std::string& path);
+    static bool hashDirectory(const std::string& dir,
+                              std::ostream& out,
+                              HashAlgorithm algo = HashAlgorithm::Sha256);
 };
 
 }  // namespace seal
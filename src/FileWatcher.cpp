@@ -0,0 +1,167 @@
+#include "FileWatcher.h"
+
+#include <windows.h>
+
+#include <array>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+namespace seal
+{
+
+namespace
+{
+
+constexpr DWORD kNotifyFilter =
+    FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+// Whether any notification in @p buffer names @p name. Every action counts:
+// a replace by rename shows up as removed/renamed/added rather than modified.
+bool namesFile(const unsigned char* buffer, DWORD bytes, const std::wstring& name)
+{
+    for (DWORD offset = 0; offset < bytes;)
+    {
+        const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+        const int length = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+        if (CompareStringOrdinal(
+                info->FileName, length, name.c_str(), static_cast<int>(name.size()), TRUE) ==
+            CSTR_EQUAL)
+            return true;
+        if (info->NextEntryOffset == 0)
+            break;
+        offset += info->NextEntryOffset;
+    }
+    return false;
+}
+
+}  // namespace
+
+FileWatcher::FileWatcher(std::string path, Callback onChange, std::chrono::milliseconds debounce)
+    : m_Path(std::move(path)),
+      m_OnChange(std::move(onChange)),
+      m_Debounce(debounce)
+{
+    const std::filesystem::path file(m_Path);
+    m_Name = file.filename().wstring();
+    std::filesystem::path directory = file.parent_path();
+    if (directory.empty())
+        directory = ".";
+
+    HANDLE handle = CreateFileW(directory.c_str(),
+                                FILE_LIST_DIRECTORY,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                                nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot watch directory");
+    m_Directory = handle;
+    m_Stop = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    HANDLE ready = m_Stop ? CreateEventW(nullptr, TRUE, FALSE, nullptr) : nullptr;
+    if (!ready)
+    {
+        if (m_Stop)
+            CloseHandle(m_Stop);
+        CloseHandle(handle);
+        throw std::runtime_error("CreateEvent failed");
+    }
+    // Wait for the thread to arm its first read: until then a change to
+    // the file would go unreported.
+    m_Thread = std::thread([this, ready] { run(ready); });
+    WaitForSingleObject(ready, INFINITE);
+    CloseHandle(ready);
+}
+
+FileWatcher::~FileWatcher()
+{
+    SetEvent(m_Stop);
+    if (m_Thread.joinable())
+        m_Thread.join();
+    CloseHandle(m_Stop);
+    CloseHandle(m_Directory);
+}
+
+// Signals @p ready once the first read is armed, or once it is clear that
+// none will be.
+void FileWatcher::run(void* ready)
+{
+    alignas(DWORD) std::array<unsigned char, 16 << 10> buffer{};
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!overlapped.hEvent)
+    {
+        SetEvent(ready);
+        return;
+    }
+
+    bool reading = false;
+    bool pending = false;  // a change is waiting out the debounce interval
+    std::chrono::steady_clock::time_point deadline{};
+    for (;;)
+    {
+        if (!reading)
+        {
+            ResetEvent(overlapped.hEvent);
+            const BOOL armed = ReadDirectoryChangesW(m_Directory,
+                                                     buffer.data(),
+                                                     static_cast<DWORD>(buffer.size()),
+                                                     FALSE,
+                                                     kNotifyFilter,
+                                                     nullptr,
+                                                     &overlapped,
+                                                     nullptr);
+            if (ready)
+            {
+                SetEvent(ready);
+                ready = nullptr;
+            }
+            // The directory itself went away (share unmounted, folder
+            // deleted): nothing more will arrive.
+            if (!armed)
+                break;
+            reading = true;
+        }
+
+        DWORD timeout = INFINITE;
+        if (pending)
+        {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            timeout = left.count() > 0 ? static_cast<DWORD>(left.count()) : 0;
+        }
+        const HANDLE handles[] = {m_Stop, overlapped.hEvent};
+        const DWORD wait = WaitForMultipleObjects(2, handles, FALSE, timeout);
+        if (wait == WAIT_TIMEOUT)
+        {
+            pending = false;
+            m_OnChange();
+            continue;
+        }
+        if (wait != WAIT_OBJECT_0 + 1)
+            break;
+
+        DWORD bytes = 0;
+        reading = false;
+        if (!GetOverlappedResult(m_Directory, &overlapped, &bytes, FALSE))
+            break;
+        // Zero bytes means the notifications overflowed the buffer and were
+        // dropped; assume the file was among them.
+        if (bytes == 0 || namesFile(buffer.data(), bytes, m_Name))
+        {
+            pending = true;
+            deadline = std::chrono::steady_clock::now() + m_Debounce;
+        }
+    }
+
+    if (reading)
+    {
+        DWORD bytes = 0;
+        CancelIoEx(m_Directory, &overlapped);
+        GetOverlappedResult(m_Directory, &overlapped, &bytes, TRUE);
+    }
+    CloseHandle(overlapped.hEvent);
+}
+
+}  // namespace seal
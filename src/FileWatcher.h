@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CryptoConfig.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace seal
+{
+
+/**
+ * @class FileWatcher
+ * @brief Reports changes to one file, debounced, from a background thread.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Vault
+ *
+ * Watches the file's parent directory with ReadDirectoryChangesW and
+ * filters the notifications by file name, so it also sees the file being
+ * replaced by a rename -- how sync clients (OneDrive, Dropbox) and our own
+ * full saves write. A burst of notifications (a writer flushing in chunks,
+ * a temp file renamed over the target) is coalesced: the callback runs
+ * once the file has been quiet for the debounce interval.
+ *
+ * The callback runs on the watcher thread and must be cheap and
+ * thread-safe; the usual body posts to the owner's thread. It also fires
+ * for the owner's own writes, so the owner tells those apart itself (e.g.
+ * by comparing the file's stamp with what it last wrote).
+ *
+ * If the directory's change buffer overflows, the watcher reports a change
+ * rather than risk missing one.
+ *
+ * @see vaultFileChanged
+ */
+class FileWatcher
+{
+public:
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief Start watching @p path.
+     *
+     * Returns once the first directory read is armed, so a change made
+     * right after construction is reported.
+     *
+     * @param path     File to watch (ANSI, as passed to the Win32 `A` APIs).
+     * @param onChange Invoked on the watcher thread after each settled change.
+     * @param debounce Quiet time required after the last notification.
+     * @throw std::runtime_error if the parent directory cannot be opened.
+     */
+    FileWatcher(std::string path,
+                Callback onChange,
+                std::chrono::milliseconds debounce =
+                    std::chrono::milliseconds(cfg::FILE_WATCH_DEBOUNCE_MS));
+
+    /// @brief Destructor. Stops the thread; no callback runs after it returns.
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /// @brief Path being watched.
+    [[nodiscard]] const std::string& path() const { return m_Path; }
+
+private:
+    void run(void* ready);
+
+    std::string m_Path;                    ///< Watched file.
+    std::wstring m_Name;                   ///< File name component, matched case-insensitively.
+    Callback m_OnChange;                   ///< Invoked after a settled change.
+    std::chrono::milliseconds m_Debounce;  ///< Quiet time before m_OnChange runs.
+    void* m_Directory = nullptr;           ///< Parent directory handle (overlapped).
+    void* m_Stop = nullptr;                ///< Manual-reset event signalled by the destructor.
+    std::thread m_Thread;                  ///< Runs run().
+};
+
+}  // namespace seal
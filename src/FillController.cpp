@@ -3,14 +3,21 @@
 #include "FillController.h"
 #include "Clipboard.h"
 #include "Logging.h"
+#include "Metrics.h"
 
 #include <QtCore/QThread>
 #include <QtGui/QGuiApplication>
 #include <QtGui/QWindow>
 
 #include <oleacc.h>
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 namespace seal
 {
@@ -22,6 +29,20 @@ constexpr int kMaxUiaAncestorDepth = 8;
 constexpr int kMaxUiaDescendantDepth = 6;
 constexpr int kMaxUiaDescendantNodes = 64;
 
+// Per-call UIA timeouts (IUIAutomation2). A hung target app otherwise holds
+// the probe worker for UIA's 20-second default.
+constexpr DWORD kUiaConnectionTimeoutMs = 1000;
+constexpr DWORD kUiaTransactionTimeoutMs = 1500;
+
+// How long performType() waits for the probe after Ctrl is released before
+// falling back to sequential detection.
+constexpr std::chrono::milliseconds kProbeWait{2000};
+
+// Probe results remembered per top-level window. Short enough that a page
+// navigating under an unchanged window rectangle is not answered stale for long.
+constexpr std::chrono::seconds kProbeCacheTtl{10};
+constexpr size_t kMaxCachedProbes = 16;
+
 struct UiaPasswordObservation
 {
     bool observed = false;
@@ -39,7 +60,7 @@ QString takeBstr(BSTR text)
     return out;
 }
 
-QString currentStringProperty(IUIAutomationElement* element, PROPERTYID propertyId)
+QString cachedStringProperty(IUIAutomationElement* element, PROPERTYID propertyId)
 {
     if (!element)
         return {};
@@ -48,7 +69,7 @@ QString currentStringProperty(IUIAutomationElement* element, PROPERTYID property
     VariantInit(&val);
 
     QString out;
-    const HRESULT hr = element->GetCurrentPropertyValue(propertyId, &val);
+    const HRESULT hr = element->GetCachedPropertyValue(propertyId, &val);
     if (SUCCEEDED(hr))
     {
         if (val.vt == VT_BSTR && val.bstrVal)
@@ -84,6 +105,25 @@ bool containsPasswordHint(const QString& rawText)
     return false;
 }
 
+struct StringPropertyProbe
+{
+    PROPERTYID propertyId;
+    const char* label;
+};
+
+// Free-text properties that may carry a password hint, in the order checked.
+constexpr std::array<StringPropertyProbe, 7> kHintProperties = {{
+    {UIA_AutomationIdPropertyId, "AutomationId"},
+    {UIA_NamePropertyId, "Name"},
+    {UIA_HelpTextPropertyId, "HelpText"},
+    {UIA_FullDescriptionPropertyId, "FullDescription"},
+    {UIA_ItemTypePropertyId, "ItemType"},
+    {UIA_AriaRolePropertyId, "AriaRole"},
+    {UIA_AriaPropertiesPropertyId, "AriaProperties"},
+}};
+
+// Elements passed to the inspect* helpers come from *BuildCache calls, so
+// every property read below is answered from the cache without a round trip.
 UiaPasswordObservation inspectPasswordHintMetadata(IUIAutomationElement* element,
                                                    bool skipControlTypeGate = false)
 {
@@ -94,7 +134,7 @@ UiaPasswordObservation inspectPasswordHintMetadata(IUIAutomationElement* element
     if (!skipControlTypeGate)
     {
         CONTROLTYPEID controlType = 0;
-        if (FAILED(element->get_CurrentControlType(&controlType)))
+        if (FAILED(element->get_CachedControlType(&controlType)))
             controlType = 0;
 
         const bool editableLike =
@@ -104,25 +144,9 @@ UiaPasswordObservation inspectPasswordHintMetadata(IUIAutomationElement* element
             return observation;
     }
 
-    struct StringPropertyProbe
-    {
-        PROPERTYID propertyId;
-        const char* label;
-    };
-
-    static const std::array<StringPropertyProbe, 7> kPropertyProbes = {{
-        {UIA_AutomationIdPropertyId, "AutomationId"},
-        {UIA_NamePropertyId, "Name"},
-        {UIA_HelpTextPropertyId, "HelpText"},
-        {UIA_FullDescriptionPropertyId, "FullDescription"},
-        {UIA_ItemTypePropertyId, "ItemType"},
-        {UIA_AriaRolePropertyId, "AriaRole"},
-        {UIA_AriaPropertiesPropertyId, "AriaProperties"},
-    }};
-
-    for (const StringPropertyProbe& probe : kPropertyProbes)
+    for (const StringPropertyProbe& probe : kHintProperties)
     {
-        const QString value = currentStringProperty(element, probe.propertyId);
+        const QString value = cachedStringProperty(element, probe.propertyId);
         if (!containsPasswordHint(value))
             continue;
 
@@ -200,13 +224,13 @@ bool rectContainsPoint(const RECT& rect, LONG x, LONG y)
     return x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom;
 }
 
-bool tryGetCurrentBoundingRect(IUIAutomationElement* element, RECT* rect)
+bool tryGetCachedBoundingRect(IUIAutomationElement* element, RECT* rect)
 {
     if (!element || !rect)
         return false;
 
     RECT current{};
-    if (FAILED(element->get_CurrentBoundingRectangle(&current)))
+    if (FAILED(element->get_CachedBoundingRectangle(&current)))
         return false;
     if (current.left >= current.right || current.top >= current.bottom)
         return false;
@@ -224,7 +248,7 @@ UiaPasswordObservation inspectElementPasswordState(IUIAutomationElement* element
 
     VARIANT val;
     VariantInit(&val);
-    HRESULT hr = element->GetCurrentPropertyValue(UIA_IsPasswordPropertyId, &val);
+    HRESULT hr = element->GetCachedPropertyValue(UIA_IsPasswordPropertyId, &val);
     if (SUCCEEDED(hr) && val.vt == VT_BOOL)
     {
         observation.observed = true;
@@ -236,28 +260,20 @@ UiaPasswordObservation inspectElementPasswordState(IUIAutomationElement* element
     if (observation.isPassword)
         return observation;
 
-    IUnknown* patternUnknown = nullptr;
-    hr = element->GetCurrentPattern(UIA_LegacyIAccessiblePatternId, &patternUnknown);
-    if (SUCCEEDED(hr) && patternUnknown)
+    // The LegacyIAccessible state is cached as a plain property, so the
+    // pattern object itself is never fetched.
+    VariantInit(&val);
+    hr = element->GetCachedPropertyValue(UIA_LegacyIAccessibleStatePropertyId, &val);
+    if (SUCCEEDED(hr) && val.vt == VT_I4)
     {
-        auto* legacyPattern = static_cast<IUIAutomationLegacyIAccessiblePattern*>(nullptr);
-        hr = patternUnknown->QueryInterface(IID_PPV_ARGS(&legacyPattern));
-        patternUnknown->Release();
-        if (SUCCEEDED(hr) && legacyPattern)
+        observation.observed = true;
+        if (val.lVal & STATE_SYSTEM_PROTECTED)
         {
-            DWORD legacyState = 0;
-            if (SUCCEEDED(legacyPattern->get_CurrentState(&legacyState)))
-            {
-                observation.observed = true;
-                if (legacyState & STATE_SYSTEM_PROTECTED)
-                {
-                    observation.isPassword = true;
-                    observation.source = QStringLiteral("LegacyState");
-                }
-            }
-            legacyPattern->Release();
+            observation.isPassword = true;
+            observation.source = QStringLiteral("LegacyState");
         }
     }
+    VariantClear(&val);
 
     if (observation.isPassword)
         return observation;
@@ -270,6 +286,8 @@ UiaPasswordObservation inspectElementPasswordState(IUIAutomationElement* element
     return observation;
 }
 
+// Debug-only (evaluated inside qCDebug), so the live reads below cost
+// nothing unless the fill category is enabled.
 QString describeAutomationElement(IUIAutomationElement* element)
 {
     if (!element)
@@ -291,7 +309,7 @@ QString describeAutomationElement(IUIAutomationElement* element)
 
     RECT rect{};
     QString rectText = QStringLiteral("<none>");
-    if (tryGetCurrentBoundingRect(element, &rect))
+    if (tryGetCachedBoundingRect(element, &rect))
     {
         rectText = QStringLiteral("[%1,%2 %3x%4]")
                        .arg(rect.left)
@@ -311,6 +329,7 @@ QString describeAutomationElement(IUIAutomationElement* element)
 }
 
 bool searchDescendantsForPassword(IUIAutomationTreeWalker* walker,
+                                  IUIAutomationCacheRequest* cacheRequest,
                                   IUIAutomationElement* root,
                                   LONG x,
                                   LONG y,
@@ -322,18 +341,18 @@ bool searchDescendantsForPassword(IUIAutomationTreeWalker* walker,
         return false;
 
     IUIAutomationElement* child = nullptr;
-    HRESULT hr = walker->GetFirstChildElement(root, &child);
+    HRESULT hr = walker->GetFirstChildElementBuildCache(root, cacheRequest, &child);
     if (FAILED(hr) || !child)
         return false;
 
     while (child && nodesRemaining > 0)
     {
         IUIAutomationElement* next = nullptr;
-        walker->GetNextSiblingElement(child, &next);
+        walker->GetNextSiblingElementBuildCache(child, cacheRequest, &next);
 
         bool shouldInspect = true;
         RECT rect{};
-        if (tryGetCurrentBoundingRect(child, &rect))
+        if (tryGetCachedBoundingRect(child, &rect))
             shouldInspect = rectContainsPoint(rect, x, y);
 
         if (shouldInspect)
@@ -356,7 +375,7 @@ bool searchDescendantsForPassword(IUIAutomationTreeWalker* walker,
             }
 
             if (searchDescendantsForPassword(
-                    walker, child, x, y, depth + 1, nodesRemaining, observedAny))
+                    walker, cacheRequest, child, x, y, depth + 1, nodesRemaining, observedAny))
             {
                 child->Release();
                 if (next)
@@ -372,8 +391,266 @@ bool searchDescendantsForPassword(IUIAutomationTreeWalker* walker,
     return false;
 }
 
+bool tryGetAccessibleRect(IAccessible* acc, const VARIANT& child, RECT* rect)
+{
+    long left = 0;
+    long top = 0;
+    long width = 0;
+    long height = 0;
+    if (FAILED(acc->accLocation(&left, &top, &width, &height, child)) || width <= 0 ||
+        height <= 0)
+        return false;
+
+    *rect = RECT{left, top, left + width, top + height};
+    return true;
+}
+
 }  // namespace
 
+// Owns the UI Automation client on a dedicated MTA thread. A UIA client
+// should not live on a UI thread: every cross-process query blocks its
+// caller, and the STA it runs in has to stay responsive to the providers
+// calling back. The worker creates the client, the cache request, and the
+// raw-view walker once, at startup, and then answers one probe at a time.
+class UiaProber
+{
+public:
+    UiaProber()
+        : m_Thread([this] { run(); })
+    {
+    }
+
+    ~UiaProber()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopped = true;
+        }
+        m_Wake.notify_one();
+    }
+
+    UiaProber(const UiaProber&) = delete;
+    UiaProber& operator=(const UiaProber&) = delete;
+
+    // Queue a probe of the element at screen (x, y). Cheap enough to call
+    // from the mouse hook. A request the worker has not picked up yet is
+    // superseded and resolves to -1.
+    std::future<int> probe(LONG x, LONG y)
+    {
+        std::promise<int> promise;
+        std::future<int> result = promise.get_future();
+        {
+            std::lock_guard lock(m_Mutex);
+            if (m_Pending)
+                m_Pending->result.set_value(-1);
+            m_Pending = Request{x, y, std::move(promise)};
+        }
+        m_Wake.notify_one();
+        return result;
+    }
+
+private:
+    struct Request
+    {
+        LONG x = 0;
+        LONG y = 0;
+        std::promise<int> result;
+    };
+
+    // One probed field: the window it was in, where that window was, and
+    // the screen rectangle of the field itself.
+    struct RecentProbe
+    {
+        HWND window = nullptr;
+        RECT windowRect{};
+        RECT fieldRect{};
+        int result = -1;
+        std::chrono::steady_clock::time_point at;
+    };
+
+    void run();
+    bool createClient();
+    void releaseClient();
+    int probeCached(LONG x, LONG y);
+    int probeIsPassword(LONG x, LONG y, RECT* fieldRect);
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    std::optional<Request> m_Pending;
+    bool m_Stopped = false;
+
+    // Worker thread only.
+    IUIAutomation* m_UIA = nullptr;
+    IUIAutomationCacheRequest* m_CacheRequest = nullptr;
+    IUIAutomationTreeWalker* m_Walker = nullptr;
+    std::vector<RecentProbe> m_Recent;
+
+    // Declared last so the members above exist before the worker starts
+    // and outlive its join.
+    std::jthread m_Thread;
+};
+
+void UiaProber::run()
+{
+    const HRESULT hrCo = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    const bool ready = SUCCEEDED(hrCo) && createClient();
+    if (FAILED(hrCo))
+        qCWarning(logFill) << "UIA worker CoInitializeEx failed: 0x" << Qt::hex << hrCo;
+
+    for (;;)
+    {
+        std::optional<Request> request;
+        {
+            std::unique_lock lock(m_Mutex);
+            m_Wake.wait(lock, [this] { return m_Stopped || m_Pending.has_value(); });
+            if (m_Stopped)
+            {
+                if (m_Pending)
+                    m_Pending->result.set_value(-1);
+                break;
+            }
+            request = std::move(m_Pending);
+            m_Pending.reset();
+        }
+
+        int result = -1;
+        if (ready)
+        {
+            try
+            {
+                result = probeCached(request->x, request->y);
+            }
+            catch (...)
+            {
+                result = -1;
+            }
+        }
+        request->result.set_value(result);
+    }
+
+    releaseClient();
+    if (SUCCEEDED(hrCo))
+        CoUninitialize();
+}
+
+bool UiaProber::createClient()
+{
+    HRESULT hr = CoCreateInstance(__uuidof(CUIAutomation),
+                                  nullptr,
+                                  CLSCTX_INPROC_SERVER,
+                                  __uuidof(IUIAutomation),
+                                  reinterpret_cast<void**>(&m_UIA));
+    if (FAILED(hr) || !m_UIA)
+    {
+        qCWarning(logFill) << "UIA CoCreateInstance failed: 0x" << Qt::hex << hr
+                           << "- will fall back to sequential detection";
+        m_UIA = nullptr;
+        return false;
+    }
+
+    IUIAutomation2* uia2 = nullptr;
+    if (SUCCEEDED(m_UIA->QueryInterface(IID_PPV_ARGS(&uia2))) && uia2)
+    {
+        uia2->put_ConnectionTimeout(kUiaConnectionTimeoutMs);
+        uia2->put_TransactionTimeout(kUiaTransactionTimeoutMs);
+        uia2->Release();
+    }
+
+    // One cache request carries every property the inspect* helpers read,
+    // so each element costs a single round trip to the provider.
+    hr = m_UIA->CreateCacheRequest(&m_CacheRequest);
+    if (FAILED(hr) || !m_CacheRequest)
+    {
+        qCWarning(logFill) << "UIA CreateCacheRequest failed: 0x" << Qt::hex << hr;
+        releaseClient();
+        return false;
+    }
+    m_CacheRequest->AddProperty(UIA_IsPasswordPropertyId);
+    m_CacheRequest->AddProperty(UIA_ControlTypePropertyId);
+    m_CacheRequest->AddProperty(UIA_BoundingRectanglePropertyId);
+    m_CacheRequest->AddProperty(UIA_LegacyIAccessibleStatePropertyId);
+    for (const StringPropertyProbe& probe : kHintProperties)
+        m_CacheRequest->AddProperty(probe.propertyId);
+
+    // The probe walks the raw view; the default control-view filter would
+    // drop the text and wrapper nodes browsers put around their inputs.
+    IUIAutomationCondition* rawView = nullptr;
+    if (SUCCEEDED(m_UIA->get_RawViewCondition(&rawView)) && rawView)
+    {
+        m_CacheRequest->put_TreeFilter(rawView);
+        rawView->Release();
+    }
+
+    hr = m_UIA->get_RawViewWalker(&m_Walker);
+    if (FAILED(hr))
+    {
+        qCDebug(logFill) << "UIA get_RawViewWalker failed: 0x" << Qt::hex << hr;
+        m_Walker = nullptr;
+    }
+
+    qCDebug(logFill) << "UIA worker ready";
+    return true;
+}
+
+void UiaProber::releaseClient()
+{
+    if (m_Walker)
+    {
+        m_Walker->Release();
+        m_Walker = nullptr;
+    }
+    if (m_CacheRequest)
+    {
+        m_CacheRequest->Release();
+        m_CacheRequest = nullptr;
+    }
+    if (m_UIA)
+    {
+        m_UIA->Release();
+        m_UIA = nullptr;
+    }
+}
+
+int UiaProber::probeCached(LONG x, LONG y)
+{
+    // Key results by the top-level window under the click and that
+    // window's rectangle: moving or resizing it invalidates every entry.
+    // Only these two user32 calls run before a hit, no COM at all.
+    const POINT pt = {x, y};
+    const HWND window = GetAncestor(WindowFromPoint(pt), GA_ROOT);
+    RECT windowRect{};
+    const bool haveWindow = window && GetWindowRect(window, &windowRect);
+
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(m_Recent,
+                  [now](const RecentProbe& recent) { return now - recent.at > kProbeCacheTtl; });
+
+    if (haveWindow)
+    {
+        for (const RecentProbe& recent : m_Recent)
+        {
+            if (recent.window == window && EqualRect(&recent.windowRect, &windowRect) &&
+                rectContainsPoint(recent.fieldRect, x, y))
+            {
+                qCDebug(logFill) << "probeIsPassword: reusing result" << recent.result
+                                 << "for this field";
+                return recent.result;
+            }
+        }
+    }
+
+    RECT fieldRect{};
+    const int result = probeIsPassword(x, y, &fieldRect);
+    if (haveWindow && result >= 0 && fieldRect.left < fieldRect.right &&
+        fieldRect.top < fieldRect.bottom)
+    {
+        if (m_Recent.size() >= kMaxCachedProbes)
+            m_Recent.erase(m_Recent.begin());
+        m_Recent.push_back(RecentProbe{window, windowRect, fieldRect, result, now});
+    }
+    return result;
+}
+
 // Only one controller can own the global hooks at a time.
 // Windows global low-level hooks are per-thread and cannot be multiplexed;
 // a second FillController installing hooks would silently replace the first
@@ -385,6 +662,9 @@ FillController::FillController(QObject* parent)
 {
     m_TimeoutTimer.setInterval(1000);
     connect(&m_TimeoutTimer, &QTimer::timeout, this, &FillController::onTimeoutTick);
+
+    // Start the UIA worker now so the client is warm before the first arm().
+    m_Prober = std::make_unique<UiaProber>();
 }
 
 FillController::~FillController()
@@ -475,7 +755,9 @@ bool FillController::arm(
     int recordIndex,
     const std::vector<seal::VaultRecord>& records,
     const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPw,
-    const uint64_t& ownerGeneration)
+    const uint64_t& ownerGeneration,
+    seal::VaultKeyCache* keyCache,
+    seal::CredentialPrefetch* prefetch)
 {
     // If already armed (e.g. user clicked a different record), tear down
     // the previous session before starting a new one.
@@ -489,29 +771,14 @@ bool FillController::arm(
     m_RecordIndex = recordIndex;
     m_Records = &records;
     m_MasterPw = &masterPw;
+    m_KeyCache = keyCache;
+    m_Prefetch = prefetch;
     m_OwnerGeneration = &ownerGeneration;
     m_SnapshotGeneration = ownerGeneration;
     m_RemainingSeconds = FILL_TIMEOUT_SECONDS;
     m_PendingTarget.store(TypeTarget::Auto);
     m_TypedFields = TypedNone;
-
-    // Lazy-init the UI Automation client for password field detection.
-    // Qt's main thread is STA (OleInitialize for drag-and-drop), so
-    // CoCreateInstance for the in-process UIA server is safe here.
-    if (!m_UIA)
-    {
-        HRESULT hr = CoCreateInstance(__uuidof(CUIAutomation),
-                                      nullptr,
-                                      CLSCTX_INPROC_SERVER,
-                                      __uuidof(IUIAutomation),
-                                      reinterpret_cast<void**>(&m_UIA));
-        if (FAILED(hr))
-        {
-            qCWarning(logFill) << "UIA CoCreateInstance failed: 0x" << Qt::hex << hr
-                               << "- will fall back to sequential detection";
-            m_UIA = nullptr;
-        }
-    }
+    m_Probe = {};
 
     // Register as the singleton so the static hook callbacks can find us.
     s_instance.store(this);
@@ -525,6 +792,8 @@ bool FillController::arm(
         m_RecordIndex = -1;
         m_Records = nullptr;
         m_MasterPw = nullptr;
+        m_KeyCache = nullptr;
+        m_Prefetch = nullptr;
         emit fillError(QStringLiteral("Failed to install input hooks"));
         return false;
     }
@@ -552,14 +821,12 @@ void FillController::cancel()
     m_RecordIndex = -1;
     m_Records = nullptr;
     m_MasterPw = nullptr;
+    m_KeyCache = nullptr;
+    m_Prefetch = nullptr;
     m_OwnerGeneration = nullptr;
     m_SnapshotGeneration = 0;
     m_TypedFields = TypedNone;
-    if (m_UIA)
-    {
-        m_UIA->Release();
-        m_UIA = nullptr;
-    }
+    m_Probe = {};
     m_RemainingSeconds = 0;
     emit countdownSecondsChanged();
     emit fillCancelled();
@@ -627,11 +894,7 @@ LRESULT CALLBACK FillController::mouseHookProc(int nCode, WPARAM wParam, LPARAM
 
         if (ctrlDown && curState == State::Armed)
         {
-            // Capture the click coordinates so performType() can probe the
-            // UIA element at this screen position for password detection.
             auto* mhs = reinterpret_cast<MSLLHOOKSTRUCT*>(lParam);
-            self->m_ClickX.store(mhs->pt.x);
-            self->m_ClickY.store(mhs->pt.y);
 
             // Modifier key overrides let the user force a specific field:
             // Shift forces password, Alt forces username.
@@ -648,6 +911,14 @@ LRESULT CALLBACK FillController::mouseHookProc(int nCode, WPARAM wParam, LPARAM
                 target = TypeTarget::Auto;
 
             self->m_PendingTarget.store(target);
+
+            // Probe the UIA element at the click position now, so the probe
+            // overlaps the wait for Ctrl release in performType(). Low-level
+            // hooks run on the installing (Qt) thread, the same thread as
+            // performType(), so m_Probe needs no lock.
+            if (target == TypeTarget::Auto)
+                self->m_Probe = self->m_Prober->probe(mhs->pt.x, mhs->pt.y);
+
             qCInfo(logFill) << "Ctrl+Click detected: target="
                             << (target == TypeTarget::Username   ? "username"
                                 : target == TypeTarget::Password ? "password"
@@ -723,14 +994,23 @@ void FillController::performType()
             // Guard against cancel() being called while we were polling.
             if (m_State.load() != State::Typing)
                 return;
+            const auto fillStarted = std::chrono::steady_clock::now();
 
             // Resolve the target field. Shift/Alt overrides are already
-            // resolved in the hook; Auto means we probe the clicked element
-            // via Windows UI Automation to detect password fields.
+            // resolved in the hook; Auto means the hook queued a UI Automation
+            // probe of the clicked element, which has usually finished by now.
             TypeTarget target = pendingTarget;
             if (target == TypeTarget::Auto)
             {
-                int probe = probeIsPassword(m_ClickX.load(), m_ClickY.load());
+                int probe = -1;
+                if (m_Probe.valid())
+                {
+                    if (m_Probe.wait_for(kProbeWait) == std::future_status::ready)
+                        probe = m_Probe.get();
+                    else
+                        qCWarning(logFill) << "UIA probe timed out";
+                    m_Probe = {};
+                }
                 if (probe > 0)
                 {
                     target = TypeTarget::Password;
@@ -794,9 +1074,12 @@ void FillController::performType()
                 return;
             }
 
+            // A credential prefetched on row selection skips the decrypt;
+            // take() only hands it over for this record and generation.
             try
             {
-                cred = seal::decryptCredentialOnDemand(record, *masterPw);
+                if (!m_Prefetch || !m_Prefetch->take(recordIndex, m_SnapshotGeneration, cred))
+                    cred = seal::decryptCredentialOnDemand(record, *masterPw, m_KeyCache);
             }
             catch (const std::exception& e)
             {
@@ -828,10 +1111,8 @@ void FillController::performType()
                 success = seal::typeSecret(cred.password.data(), (int)cred.password.size(), 0);
 
             // Wipe plaintext immediately after typing. cleanse() overwrites
-            // the decrypted buffers with zeros, then trimWorkingSet() calls
-            // SetProcessWorkingSetSize(-1,-1) to flush dirty pages out of
-            // physical RAM so the plaintext can't be recovered from a memory
-            // dump or swap file.
+            // the decrypted buffers with zeros in their locked pages, then
+            // trimWorkingSet() returns the wiped regions this thread parked.
             cred.cleanse();
             seal::Cryptography::trimWorkingSet();
 
@@ -843,6 +1124,8 @@ void FillController::performType()
                 return;
             }
 
+            seal::metrics::record(seal::metrics::Latency::Fill,
+                                  std::chrono::steady_clock::now() - fillStarted);
             QString service = QString::fromUtf8(record.platform.c_str());
 
             // Track which field was typed and check for completion.
@@ -861,15 +1144,12 @@ void FillController::performType()
                 // notify the backend so it can restore the window.
                 m_TimeoutTimer.stop();
                 removeHooks();
-                if (m_UIA)
-                {
-                    m_UIA->Release();
-                    m_UIA = nullptr;
-                }
                 transitionTo(State::Idle);
                 m_RecordIndex = -1;
                 m_Records = nullptr;
                 m_MasterPw = nullptr;
+                m_KeyCache = nullptr;
+                m_Prefetch = nullptr;
                 m_TypedFields = TypedNone;
                 m_RemainingSeconds = 0;
                 emit countdownSecondsChanged();
@@ -887,7 +1167,10 @@ void FillController::performType()
     poll->start();
 }
 
-int FillController::probeIsPassword(LONG x, LONG y)
+// Returns +1 for a password field, 0 for another field, -1 when nothing
+// could be inspected. fieldRect receives the screen rectangle of the field
+// when the hit is field-sized, so probeCached() can reuse the answer.
+int UiaProber::probeIsPassword(LONG x, LONG y, RECT* fieldRect)
 {
     POINT pt = {x, y};
 
@@ -909,6 +1192,7 @@ int FillController::probeIsPassword(LONG x, LONG y)
         if (SUCCEEDED(hr) && state.vt == VT_I4 && (state.lVal & STATE_SYSTEM_PROTECTED))
         {
             qCDebug(logFill) << "probeIsPassword: MSAA STATE_SYSTEM_PROTECTED detected";
+            tryGetAccessibleRect(pAcc, varChild, fieldRect);
             VariantClear(&state);
             pAcc->Release();
             VariantClear(&varChild);
@@ -939,6 +1223,7 @@ int FillController::probeIsPassword(LONG x, LONG y)
                 if (containsPasswordHint(nameStr))
                 {
                     qCDebug(logFill) << "probeIsPassword: MSAA accName matched:" << nameStr;
+                    tryGetAccessibleRect(pAcc, varChild, fieldRect);
                     pAcc->Release();
                     VariantClear(&varChild);
                     return 1;
@@ -952,6 +1237,7 @@ int FillController::probeIsPassword(LONG x, LONG y)
                 if (containsPasswordHint(descStr))
                 {
                     qCDebug(logFill) << "probeIsPassword: MSAA accDescription matched:" << descStr;
+                    tryGetAccessibleRect(pAcc, varChild, fieldRect);
                     pAcc->Release();
                     VariantClear(&varChild);
                     return 1;
@@ -966,11 +1252,11 @@ int FillController::probeIsPassword(LONG x, LONG y)
     // Phase 2: UIA probe. The MSAA call above warmed the accessibility tree,
     // so ElementFromPoint should now return the actual input element even in
     // browsers that lazily initialize their UIA providers.
-    if (!m_UIA)
+    if (!m_UIA || !m_CacheRequest)
         return -1;
 
     IUIAutomationElement* element = nullptr;
-    hr = m_UIA->ElementFromPoint(pt, &element);
+    hr = m_UIA->ElementFromPointBuildCache(pt, m_CacheRequest, &element);
     if (FAILED(hr) || !element)
     {
         qCDebug(logFill) << "probeIsPassword: ElementFromPoint failed: 0x" << Qt::hex << hr;
@@ -979,6 +1265,12 @@ int FillController::probeIsPassword(LONG x, LONG y)
 
     qCDebug(logFill) << "probeIsPassword: UIA hit element =" << describeAutomationElement(element);
 
+    // Only an edit hit is remembered. A hit on a renderer pane or a form
+    // group covers sibling fields whose answer may differ.
+    CONTROLTYPEID hitType = 0;
+    if (SUCCEEDED(element->get_CachedControlType(&hitType)) && hitType == UIA_EditControlTypeId)
+        tryGetCachedBoundingRect(element, fieldRect);
+
     bool observedAny = false;
     UiaPasswordObservation hitObservation = inspectElementPasswordState(element);
     observedAny = hitObservation.observed;
@@ -993,11 +1285,8 @@ int FillController::probeIsPassword(LONG x, LONG y)
         return 1;
     }
 
-    IUIAutomationTreeWalker* rawWalker = nullptr;
-    hr = m_UIA->get_RawViewWalker(&rawWalker);
-    if (FAILED(hr) || !rawWalker)
+    if (!m_Walker)
     {
-        qCDebug(logFill) << "probeIsPassword: get_RawViewWalker failed: 0x" << Qt::hex << hr;
         element->Release();
         return observedAny ? 0 : -1;
     }
@@ -1010,7 +1299,7 @@ int FillController::probeIsPassword(LONG x, LONG y)
     for (int depth = 0; depth < kMaxUiaAncestorDepth; ++depth)
     {
         IUIAutomationElement* parent = nullptr;
-        hr = rawWalker->GetParentElement(current, &parent);
+        hr = m_Walker->GetParentElementBuildCache(current, m_CacheRequest, &parent);
         current->Release();
         current = nullptr;
 
@@ -1018,7 +1307,7 @@ int FillController::probeIsPassword(LONG x, LONG y)
             break;
 
         RECT rect{};
-        if (tryGetCurrentBoundingRect(parent, &rect) && !rectContainsPoint(rect, x, y))
+        if (tryGetCachedBoundingRect(parent, &rect) && !rectContainsPoint(rect, x, y))
         {
             current = parent;
             continue;
@@ -1036,7 +1325,6 @@ int FillController::probeIsPassword(LONG x, LONG y)
                                                                    : observation.matchedText)
                              << describeAutomationElement(parent);
             parent->Release();
-            rawWalker->Release();
             element->Release();
             return 1;
         }
@@ -1047,9 +1335,8 @@ int FillController::probeIsPassword(LONG x, LONG y)
         current->Release();
 
     int nodesRemaining = kMaxUiaDescendantNodes;
-    const bool descendantMatched =
-        searchDescendantsForPassword(rawWalker, element, x, y, 0, nodesRemaining, observedAny);
-    rawWalker->Release();
+    const bool descendantMatched = searchDescendantsForPassword(
+        m_Walker, m_CacheRequest, element, x, y, 0, nodesRemaining, observedAny);
     element->Release();
 
     if (descendantMatched)
@@ -8,6 +8,8 @@
 #include <UIAutomation.h>
 #include <windows.h>
 #include <atomic>
+#include <future>
+#include <memory>
 #include <vector>
 
 #include "Cryptography.h"
@@ -16,6 +18,8 @@
 namespace seal
 {
 
+class UiaProber;
+
 /**
  * @class FillController
  * @brief Manages credential auto-fill via global Windows input hooks.
@@ -57,6 +61,17 @@ namespace seal
  *   be typed in any order. Bit flags track which fields have been filled.
  * - **Typing** - keystrokes being sent, hooks still installed.
  *
+ * ## :material-magnify: Password Field Detection
+ *
+ * The UI Automation client lives on a dedicated MTA worker (UiaProber)
+ * created with the controller, so the first Ctrl+Click does not pay for
+ * client creation. The mouse hook queues the probe the moment the click
+ * lands, and it runs while performType() waits for Ctrl to be released.
+ * Each element is fetched with a cache request that carries every property
+ * the probe inspects, and the result for a field is remembered per
+ * top-level window for a few seconds, so repeat fills into the same form
+ * skip the cross-process queries entirely.
+ *
  * ## :material-keyboard: Modifier Keys
  *
  * While armed, the user can override which field gets typed:
@@ -144,13 +159,18 @@ public:
      * @param masterPw        Master password for on-demand decryption (must outlive the fill)
      * @param ownerGeneration Monotonic counter owned by the caller; incremented on every
      *                        records/password mutation.
+     * @param keyCache        Optional derived-key cache (must outlive the fill)
+     * @param prefetch        Optional credential prefetch to take the record from
+     *                        instead of decrypting (must outlive the fill)
      * @return `true` if hooks were installed and arming succeeded.
      */
     [[nodiscard]] bool arm(
         int recordIndex,
         const std::vector<seal::VaultRecord>& records,
         const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPw,
-        const uint64_t& ownerGeneration);
+        const uint64_t& ownerGeneration,
+        seal::VaultKeyCache* keyCache = nullptr,
+        seal::CredentialPrefetch* prefetch = nullptr);
 
     /**
      * @brief Cancel the current fill operation and remove all hooks.
@@ -233,10 +253,6 @@ private:
         TypedBoth = TypedUsername | TypedPassword,
     };
 
-    /// @brief Probe the UIA element at screen (x, y) for the IsPassword property.
-    /// @return +1 if IsPassword=TRUE, 0 if IsPassword=FALSE, -1 on probe failure.
-    int probeIsPassword(LONG x, LONG y);
-
     std::atomic<State> m_State{State::Idle};  ///< Current state machine state.
     int m_RecordIndex = -1;                   ///< Index of the armed vault record.
     const std::vector<seal::VaultRecord>* m_Records =
@@ -244,6 +260,8 @@ private:
     const seal::basic_secure_string<wchar_t,
                                     seal::locked_allocator<wchar_t>>* m_MasterPw =
         nullptr;  ///< Borrowed pointer to master password.
+    seal::VaultKeyCache* m_KeyCache = nullptr;       ///< Borrowed derived-key cache (may be null).
+    seal::CredentialPrefetch* m_Prefetch = nullptr;  ///< Borrowed prefetch (may be null).
 
     const uint64_t* m_OwnerGeneration = nullptr;  ///< Points to owner's generation counter.
     uint64_t m_SnapshotGeneration = 0;  ///< Generation at arm() time; mismatch means stale.
@@ -256,11 +274,10 @@ private:
     QString m_StatusText;                                       ///< Human-readable status for QML.
     std::atomic<TypeTarget> m_PendingTarget{TypeTarget::Auto};  ///< Field to type on next click.
 
-    std::atomic<LONG> m_ClickX{0};  ///< Screen X captured in mouseHookProc.
-    std::atomic<LONG> m_ClickY{0};  ///< Screen Y captured in mouseHookProc.
-
     uint8_t m_TypedFields = TypedNone;  ///< Which fields have been typed so far.
-    IUIAutomation* m_UIA = nullptr;     ///< Cached UI Automation client; lazy-init in arm().
+
+    std::unique_ptr<UiaProber> m_Prober;  ///< MTA worker owning the UI Automation client.
+    std::future<int> m_Probe;  ///< Probe of the last Ctrl+Click: +1 password, 0 not, -1 unknown.
 
     static constexpr int FILL_TIMEOUT_SECONDS = 30;  ///< Max seconds to wait for user click.
 };
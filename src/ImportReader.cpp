@@ -0,0 +1,157 @@
+#include "ImportReader.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <istream>
+
+namespace seal
+{
+
+namespace
+{
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\v' || c == '\f';
+}
+
+std::string_view trimmed(std::string_view s)
+{
+    while (!s.empty() && isSpace(s.front()))
+        s.remove_prefix(1);
+    while (!s.empty() && isSpace(s.back()))
+        s.remove_suffix(1);
+    return s;
+}
+
+// UTF-8 to UTF-16 straight into locked memory, with no pageable copy.
+basic_secure_string<wchar_t> toSecureWide(std::string_view utf8)
+{
+    basic_secure_string<wchar_t> wide;
+    const int n = MultiByteToWideChar(
+        CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), nullptr, 0);
+    if (n <= 0)
+        return wide;
+    wide.s.resize(static_cast<size_t>(n));
+    MultiByteToWideChar(
+        CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), wide.s.data(), n);
+    return wide;
+}
+
+}  // namespace
+
+void ImportEntry::cleanse()
+{
+    SecureZeroMemory(platform.data(), platform.size());
+    platform.clear();
+    username.clear();
+    password.clear();
+}
+
+ImportReader::ImportReader(std::istream& in)
+    : m_In(in)
+{
+    m_Chunk.s.resize(kChunk);
+    m_Token.s.reserve(kMaxEntry);
+}
+
+ImportReader::~ImportReader() = default;
+
+// Collect bytes up to the next separator into m_Token. Returns false once
+// the source is exhausted with nothing collected.
+bool ImportReader::nextToken(bool& tooLong)
+{
+    SecureZeroMemory(m_Token.s.data(), m_Token.size());
+    m_Token.s.clear();
+    tooLong = false;
+    for (;;)
+    {
+        if (m_Pos == m_Size)
+        {
+            SecureZeroMemory(m_Chunk.data(), m_Size);
+            m_Pos = m_Size = 0;
+            if (m_Eof)
+                return !m_Token.s.empty() || tooLong;
+            m_In.read(m_Chunk.data(), static_cast<std::streamsize>(m_Chunk.size()));
+            m_Size = static_cast<size_t>(m_In.gcount());
+            if (m_In.bad())
+                m_Failed = true;
+            if (!m_In)
+                m_Eof = true;
+            continue;
+        }
+        const char c = m_Chunk.data()[m_Pos++];
+        if (c == ',' || c == '\n' || c == '\r')
+            return true;
+        if (m_Token.size() < kMaxEntry)
+            m_Token.push_back(c);
+        else
+            tooLong = true;
+    }
+}
+
+ImportReader::Status ImportReader::next(ImportEntry& out)
+{
+    bool tooLong = false;
+    while (nextToken(tooLong))
+    {
+        const std::string_view token = trimmed(m_Token.view());
+        if (token.empty() && !tooLong)
+            continue;
+        ++m_Index;
+        m_EntryLength = token.size();
+        if (tooLong)
+            return Status::TooLong;
+
+        const size_t firstColon = token.find(':');
+        if (firstColon == std::string_view::npos)
+            return Status::MissingFirstColon;
+        const size_t secondColon = token.find(':', firstColon + 1);
+        if (secondColon == std::string_view::npos)
+            return Status::MissingSecondColon;
+        // The format is strictly platform:username:password; a third colon
+        // makes the field boundaries ambiguous and breaks export round-trips.
+        if (token.find(':', secondColon + 1) != std::string_view::npos)
+            return Status::TooManyColons;
+
+        const std::string_view platform = trimmed(token.substr(0, firstColon));
+        const std::string_view user =
+            trimmed(token.substr(firstColon + 1, secondColon - firstColon - 1));
+        const std::string_view pass = token.substr(secondColon + 1);
+        if (platform.empty() || user.empty() || pass.empty())
+            return Status::EmptyField;
+
+        out.platform.assign(platform);
+        out.username = toSecureWide(user);
+        out.password = toSecureWide(pass);
+        return Status::Entry;
+    }
+    return m_Failed ? Status::ReadError : Status::End;
+}
+
+std::string_view ImportReader::reason(Status status) noexcept
+{
+    switch (status)
+    {
+        case Status::Entry:
+            return "ok";
+        case Status::End:
+            return "end";
+        case Status::MissingFirstColon:
+            return "missing_first_colon";
+        case Status::MissingSecondColon:
+            return "missing_second_colon";
+        case Status::TooManyColons:
+            return "too_many_colons";
+        case Status::EmptyField:
+            return "empty_field";
+        case Status::TooLong:
+            return "entry_too_long";
+        case Status::ReadError:
+            return "read_failed";
+    }
+    return "unknown";
+}
+
+}  // namespace seal
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "SecureString.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace seal
+{
+
+/**
+ * @struct ImportEntry
+ * @brief One parsed `platform:username:password` import entry.
+ * @ingroup CLI
+ */
+struct ImportEntry
+{
+    std::string platform;                  ///< UTF-8, trimmed; listed in the clear like VaultRecord
+    basic_secure_string<wchar_t> username;  ///< Trimmed username in locked memory
+    basic_secure_string<wchar_t> password;  ///< Password in locked memory, inner spaces kept
+
+    /// @brief Wipe all three fields.
+    void cleanse();
+};
+
+/**
+ * @class ImportReader
+ * @brief Incremental parser of `seal import` text.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup CLI
+ *
+ * Entries are `platform:username:password`, separated by commas or line
+ * breaks. The source is read in fixed `kChunk` pieces into locked memory
+ * and each entry is handed out as soon as its separator arrives, so an
+ * import of any size holds only one chunk and one entry of plaintext at
+ * a time. Consumed bytes are wiped before the buffer is refilled.
+ *
+ * Parsing rules match what import has always accepted: blank entries are
+ * skipped, the platform and username are trimmed, and an entry needs
+ * exactly two colons and three non-empty fields.
+ */
+class ImportReader
+{
+public:
+    /// @brief Bytes read from the source per refill.
+    static constexpr size_t kChunk = 64 << 10;
+
+    /// @brief Longest entry accepted, separators excluded.
+    static constexpr size_t kMaxEntry = 16 << 10;
+
+    /// @brief Result of next().
+    enum class Status : uint8_t
+    {
+        Entry,               ///< An entry was parsed
+        End,                 ///< Source exhausted
+        MissingFirstColon,   ///< No `:` in the entry
+        MissingSecondColon,  ///< Only one `:` in the entry
+        TooManyColons,       ///< More than two `:`; fields would be ambiguous
+        EmptyField,          ///< Platform, username or password is empty
+        TooLong,             ///< Entry exceeds kMaxEntry
+        ReadError            ///< The stream failed
+    };
+
+    /// @brief Read from @p in, which must outlive the reader.
+    explicit ImportReader(std::istream& in);
+
+    /// @brief Destructor. Wipes the chunk and entry buffers.
+    ~ImportReader();
+
+    ImportReader(const ImportReader&) = delete;
+    ImportReader& operator=(const ImportReader&) = delete;
+
+    /**
+     * @brief Parse the next entry.
+     * @param[out] out Receives the entry on Status::Entry; untouched otherwise.
+     * @return Status::Entry, Status::End, or the reason the entry was rejected.
+     */
+    Status next(ImportEntry& out);
+
+    /// @brief 1-based index of the entry last returned or rejected.
+    [[nodiscard]] size_t entryIndex() const noexcept { return m_Index; }
+
+    /// @brief Trimmed length of the entry last returned or rejected.
+    [[nodiscard]] size_t entryLength() const noexcept { return m_EntryLength; }
+
+    /// @brief snake_case diagnostic reason of an error status (e.g. `empty_field`).
+    [[nodiscard]] static std::string_view reason(Status status) noexcept;
+
+private:
+    bool nextToken(bool& tooLong);
+
+    std::istream& m_In;
+    secure_string<> m_Chunk;
+    size_t m_Pos = 0;
+    size_t m_Size = 0;
+    secure_string<> m_Token;
+    size_t m_Index = 0;
+    size_t m_EntryLength = 0;
+    bool m_Eof = false;
+    bool m_Failed = false;
+};
+
+}  // namespace seal
@@ -0,0 +1,122 @@
+#include "KdfParams.h"
+
+#include <charconv>
+
+namespace seal
+{
+
+uint64_t KdfParams::memoryBytes() const noexcept
+{
+    if (log2Cost >= 40)
+        return UINT64_MAX;
+    if (algorithm == KdfAlgorithm::Argon2id)
+        return (uint64_t{1} << log2Cost) * 1024;
+    return 128ULL * rounds * (uint64_t{1} << log2Cost);
+}
+
+bool KdfParams::valid() const noexcept
+{
+    if (lanes < 1 || lanes > seal::cfg::KDF_MAX_LANES || rounds < 1)
+        return false;
+    switch (algorithm)
+    {
+        case KdfAlgorithm::Scrypt:
+            // Below N = 2^10 scrypt no longer slows down a guessing attack.
+            if (log2Cost < 10 || rounds > 32)
+                return false;
+            break;
+        case KdfAlgorithm::Argon2id:
+            // 8 MiB floor: RFC 9106 only needs 8 KiB per lane, but that little
+            // memory does nothing against GPU guessing.
+            if (log2Cost < 13 || rounds > 16)
+                return false;
+            break;
+        default:
+            return false;
+    }
+    return memoryBytes() <= seal::cfg::KDF_MAX_MEMORY;
+}
+
+std::array<unsigned char, seal::cfg::KDF_PARAMS_LEN> KdfParams::encode() const noexcept
+{
+    return {static_cast<unsigned char>(algorithm), log2Cost, rounds, lanes};
+}
+
+std::optional<KdfParams> KdfParams::decode(std::span<const unsigned char> bytes) noexcept
+{
+    if (bytes.size() < seal::cfg::KDF_PARAMS_LEN)
+        return std::nullopt;
+    KdfParams p;
+    p.algorithm = static_cast<KdfAlgorithm>(bytes[0]);
+    p.log2Cost = bytes[1];
+    p.rounds = bytes[2];
+    p.lanes = bytes[3];
+    if (!p.valid())
+        return std::nullopt;
+    return p;
+}
+
+std::optional<KdfParams> KdfParams::parse(std::string_view spec)
+{
+    KdfParams p;
+    const size_t colon = spec.find(':');
+    const std::string_view name = spec.substr(0, colon);
+    std::string_view fields = colon == std::string_view::npos ? std::string_view{}
+                                                              : spec.substr(colon + 1);
+    if (name == "argon2id")
+    {
+        p.algorithm = KdfAlgorithm::Argon2id;
+        p.log2Cost = 16;  // 64 MiB
+        p.rounds = 3;
+        p.lanes = 4;
+    }
+    else if (name != "scrypt")
+    {
+        return std::nullopt;
+    }
+
+    while (!fields.empty())
+    {
+        const size_t comma = fields.find(',');
+        std::string_view field = fields.substr(0, comma);
+        fields = comma == std::string_view::npos ? std::string_view{} : fields.substr(comma + 1);
+
+        const size_t eq = field.find('=');
+        if (eq == std::string_view::npos)
+            return std::nullopt;
+        const std::string_view key = field.substr(0, eq);
+        const std::string_view text = field.substr(eq + 1);
+        unsigned value = 0;
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{} || end != text.data() + text.size() || value > 0xFFFF)
+            return std::nullopt;
+
+        const bool argon = p.algorithm == KdfAlgorithm::Argon2id;
+        if (!argon && key == "ln" && value <= 0xFF)
+            p.log2Cost = static_cast<uint8_t>(value);
+        else if (argon && key == "m" && std::has_single_bit(value))
+            p.log2Cost = static_cast<uint8_t>(std::countr_zero(value) + 10);  // MiB -> log2 KiB
+        else if (key == (argon ? "t" : "r") && value <= 0xFF)
+            p.rounds = static_cast<uint8_t>(value);
+        else if (key == "p" && value <= 0xFF)
+            p.lanes = static_cast<uint8_t>(value);
+        else
+            return std::nullopt;
+    }
+    if (!p.valid())
+        return std::nullopt;
+    return p;
+}
+
+std::string KdfParams::str() const
+{
+    if (algorithm == KdfAlgorithm::Argon2id)
+    {
+        return "argon2id:m=" + std::to_string(memoryBytes() >> 20) +
+               ",t=" + std::to_string(rounds) + ",p=" + std::to_string(lanes);
+    }
+    return "scrypt:ln=" + std::to_string(log2Cost) + ",r=" + std::to_string(rounds) +
+           ",p=" + std::to_string(lanes);
+}
+
+}  // namespace seal
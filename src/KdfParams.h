@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CryptoConfig.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace seal
+{
+
+/**
+ * @brief Password-hashing function selected by a KdfParams block.
+ * @ingroup Crypto
+ */
+enum class KdfAlgorithm : uint8_t
+{
+    Scrypt = 1,   ///< scrypt (RFC 7914); the built-in default
+    Argon2id = 2  ///< Argon2id (RFC 9106) with parallel lanes; needs OpenSSL 3.2+
+};
+
+/**
+ * @struct KdfParams
+ * @brief Cost parameters of the password KDF, as stored next to each salt.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Crypto
+ *
+ * Four bytes on the wire (encode() / decode()):
+ * `algorithm | log2Cost | rounds | lanes`.
+ *
+ * | Field      | scrypt          | Argon2id                      |
+ * |------------|-----------------|-------------------------------|
+ * | `log2Cost` | $\log_2 N$      | $\log_2$ of the memory in KiB |
+ * | `rounds`   | block size $r$  | passes $t$                    |
+ * | `lanes`    | parallelism $p$ | lanes, one thread each        |
+ *
+ * OpenSSL computes scrypt's $p$ blocks one after another, so only
+ * Argon2id turns extra lanes into lower wall-clock latency.
+ *
+ * decode() rejects parameters outside the bounds valid() checks
+ * (at most cfg::KDF_MAX_MEMORY and cfg::KDF_MAX_LANES), so a hostile
+ * header cannot make a reader allocate or spin without limit.
+ *
+ * @see Cryptography::deriveKey, Cryptography::calibrateKdf
+ */
+struct KdfParams
+{
+    KdfAlgorithm algorithm = KdfAlgorithm::Scrypt;
+    uint8_t log2Cost = std::countr_zero(seal::cfg::SCRYPT_N);
+    uint8_t rounds = static_cast<uint8_t>(seal::cfg::SCRYPT_R);
+    uint8_t lanes = static_cast<uint8_t>(seal::cfg::SCRYPT_P);
+
+    /// @brief The cfg::SCRYPT_N / R / P parameters every older format implies.
+    [[nodiscard]] static constexpr KdfParams legacy() noexcept { return {}; }
+
+    /// @brief True for the legacy() parameters.
+    [[nodiscard]] constexpr bool isLegacy() const noexcept { return *this == legacy(); }
+
+    /// @brief Working-set size of one derivation in bytes.
+    [[nodiscard]] uint64_t memoryBytes() const noexcept;
+
+    /// @brief True if the parameters are within the bounds readers accept.
+    [[nodiscard]] bool valid() const noexcept;
+
+    /// @brief Wire encoding (cfg::KDF_PARAMS_LEN bytes).
+    [[nodiscard]] std::array<unsigned char, seal::cfg::KDF_PARAMS_LEN> encode() const noexcept;
+
+    /**
+     * @brief Parse a wire encoding.
+     * @param bytes At least cfg::KDF_PARAMS_LEN bytes; only the first ones are read.
+     * @return The parameters, or `std::nullopt` if short, unknown or out of bounds.
+     */
+    [[nodiscard]] static std::optional<KdfParams> decode(
+        std::span<const unsigned char> bytes) noexcept;
+
+    /**
+     * @brief Parse a textual spec, as str() prints and `SEAL_KDF` / `--kdf` take.
+     *
+     * `scrypt:ln=16,r=8,p=1` (ln is $\log_2 N$) or `argon2id:m=256,t=3,p=4`
+     * (m in MiB, a power of 2). Omitted fields keep the legacy() value for
+     * scrypt, and `m=64,t=3,p=4` for Argon2id.
+     *
+     * @return The parameters, or `std::nullopt` if malformed or out of bounds.
+     */
+    [[nodiscard]] static std::optional<KdfParams> parse(std::string_view spec);
+
+    /// @brief Textual spec accepted by parse().
+    [[nodiscard]] std::string str() const;
+
+    bool operator==(const KdfParams&) const = default;
+};
+
+}  // namespace seal
@@ -5,7 +5,10 @@
 #include <windows.h>
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstring>
+#include <exception>
 #include <new>
 
 namespace seal
@@ -21,7 +24,15 @@ namespace seal
  * front guard page. The header is page-aligned so that payload
  * protection changes (via VirtualProtect) never affect the header.
  *
- * @see locked_allocator, header_from_payload
+ * The header also tracks the payload's protection, so callers only pay
+ * for a VirtualProtect (a syscall plus a TLB flush) when the page
+ * protection actually changes: @c noAccess is the state the payload
+ * rests in, and @c rwScopes counts the open RWGuard scopes that hold it
+ * READWRITE meanwhile. A shared secret (the master password, say) is read
+ * under RWGuard scopes from many workers at once, so both fields and the
+ * VirtualProtect transitions they drive are serialised by @c protectLock.
+ *
+ * @see locked_allocator, header_from_payload, RWGuard
  */
 struct locked_header
 {
@@ -33,6 +44,9 @@ struct locked_header
     size_t payloadSpan;  //!< Committed payload span (usable + canary + slack)
     uint32_t magic;      //!< Integrity check value (must match kMagic)
     uint32_t version;    //!< Header version (must match kVersion)
+    uint32_t rwScopes;   //!< Open RWGuard scopes holding the payload READWRITE
+    uint32_t noAccess;   //!< Non-zero if the payload rests at PAGE_NOACCESS
+    SRWLOCK protectLock;  //!< Guards rwScopes, noAccess and the payload protection
 };
 
 /// @brief Cached system page size (thread-safe, computed once).
@@ -60,6 +74,456 @@ inline locked_header* header_from_payload(const T* payload)
     return reinterpret_cast<locked_header*>(addr);
 }
 
+/// @brief Set the protection of the payload that follows @p hdr.
+inline void set_payload_protection(locked_header* hdr, DWORD prot) noexcept
+{
+    DWORD oldProt;
+    (void)VirtualProtect(
+        reinterpret_cast<BYTE*>(hdr) + hdr->headerSize, hdr->payloadSpan, prot, &oldProt);
+}
+
+/// @brief Open an RWGuard scope: the first one lifts a PAGE_NOACCESS payload.
+inline void open_rw_scope(locked_header* hdr) noexcept
+{
+    AcquireSRWLockExclusive(&hdr->protectLock);
+    if (hdr->rwScopes++ == 0 && hdr->noAccess)
+        set_payload_protection(hdr, PAGE_READWRITE);
+    ReleaseSRWLockExclusive(&hdr->protectLock);
+}
+
+/// @brief Close an RWGuard scope: the last one restores the resting protection.
+inline void close_rw_scope(locked_header* hdr) noexcept
+{
+    AcquireSRWLockExclusive(&hdr->protectLock);
+    if (--hdr->rwScopes == 0 && hdr->noAccess)
+        set_payload_protection(hdr, PAGE_NOACCESS);
+    ReleaseSRWLockExclusive(&hdr->protectLock);
+}
+
+/**
+ * @class locked_pool
+ * @brief Per-thread cache of locked regions between guard pages.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Memory
+ *
+ * A fresh region costs a reserve, a commit and a VirtualLock, and handing
+ * it back costs a VirtualUnlock and a VirtualFree. Buffers that live for
+ * one file (derived keys, segment buffers) would pay that on every file of
+ * a directory, so released regions are parked here and handed out again
+ * to the next request for the same size on the same thread.
+ *
+ * - Parked regions are already wiped, stay locked and READWRITE, and keep
+ *   their guard pages.
+ * - Each thread keeps at most cfg::LOCKED_POOL_MAX_REGIONS regions and
+ *   cfg::LOCKED_POOL_MAX_BYTES committed bytes; the rest go back to the OS.
+ * - A region released on another thread joins that thread's pool.
+ * - A thread's pool is returned to the OS when the thread exits; releases
+ *   after that (later thread_local destructors) free directly.
+ * - Process-wide counters of locked bytes and refused VirtualLock calls
+ *   feed working_set::stats(); a refused lock leaves the region pageable,
+ *   so the counter is the only sign of it.
+ *
+ * @see locked_allocator, working_set
+ */
+class locked_pool
+{
+public:
+    /**
+     * @brief Get a committed, locked region with a guard page on each side.
+     * @param middleSize Committed size; a multiple of the page size.
+     * @return Start of the committed span. The front guard page is the page before it.
+     * @throw std::bad_alloc on overflow or if VirtualAlloc fails.
+     */
+    static BYTE* acquire(SIZE_T middleSize)
+    {
+        if (!t_Gone)
+        {
+            auto& pool = local();
+            for (size_t i = 0; i < pool.m_Count; ++i)
+            {
+                if (pool.m_Slots[i].size != middleSize)
+                    continue;
+                BYTE* middle = pool.m_Slots[i].middle;
+                pool.m_Slots[i] = pool.m_Slots[--pool.m_Count];
+                pool.m_Bytes -= middleSize;
+                return middle;
+            }
+        }
+
+        SIZE_T page = cachedPageSize();
+        if (middleSize > SIZE_MAX - 2 * page)
+            throw std::bad_alloc();
+
+        // Reserve the entire region as PAGE_NOACCESS - the two guard pages at
+        // each end stay NOACCESS permanently to trap out-of-bounds access.
+        BYTE* base =
+            (BYTE*)VirtualAlloc(nullptr, middleSize + 2 * page, MEM_RESERVE, PAGE_NOACCESS);
+        if (!base)
+            throw std::bad_alloc();
+
+        // Commit only the middle as read-write.
+        BYTE* middle = (BYTE*)VirtualAlloc(base + page, middleSize, MEM_COMMIT, PAGE_READWRITE);
+        if (!middle)
+        {
+            VirtualFree(base, 0, MEM_RELEASE);
+            throw std::bad_alloc();
+        }
+
+        // Pin committed pages in physical RAM so they're never swapped to disk.
+        // Best-effort: requires SeLockMemoryPrivilege or sufficient working-set
+        // quota (see working_set::reserve()); a refusal is counted, not fatal.
+        if (VirtualLock(middle, middleSize))
+        {
+            s_LockedBytes.fetch_add(middleSize, std::memory_order_relaxed);
+            s_LockedRegions.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            s_LockFailures.fetch_add(1, std::memory_order_relaxed);
+        }
+        return middle;
+    }
+
+    /**
+     * @brief Hand back a region from acquire().
+     * @param middle     Pointer returned by acquire().
+     * @param middleSize Size passed to acquire().
+     * @pre The committed span is wiped and READWRITE.
+     */
+    static void release(BYTE* middle, SIZE_T middleSize) noexcept
+    {
+        if (!t_Gone)
+        {
+            auto& pool = local();
+            if (pool.m_Count < cfg::LOCKED_POOL_MAX_REGIONS &&
+                pool.m_Bytes + middleSize <= cfg::LOCKED_POOL_MAX_BYTES)
+            {
+                pool.m_Slots[pool.m_Count++] = {middle, middleSize};
+                pool.m_Bytes += middleSize;
+                return;
+            }
+        }
+        unmap(middle, middleSize);
+    }
+
+    /// @brief Number of regions parked on the calling thread.
+    static size_t parked() noexcept { return t_Gone ? 0 : local().m_Count; }
+
+    /**
+     * @brief Return every region parked on the calling thread to the OS.
+     * @return Committed bytes released.
+     *
+     * Parked regions are wiped and hold no secret, but they keep their
+     * share of the locked working set until the thread exits.
+     */
+    static SIZE_T drain() noexcept
+    {
+        if (t_Gone)
+            return 0;
+        auto& pool = local();
+        const SIZE_T bytes = pool.m_Bytes;
+        while (pool.m_Count)
+        {
+            const slot& s = pool.m_Slots[--pool.m_Count];
+            unmap(s.middle, s.size);
+        }
+        pool.m_Bytes = 0;
+        return bytes;
+    }
+
+    /// @brief Bytes currently pinned by VirtualLock, process-wide (parked regions included).
+    static size_t lockedBytes() noexcept { return s_LockedBytes.load(std::memory_order_relaxed); }
+
+    /// @brief Regions currently pinned by VirtualLock, process-wide.
+    static size_t lockedRegions() noexcept
+    {
+        return s_LockedRegions.load(std::memory_order_relaxed);
+    }
+
+    /// @brief VirtualLock calls refused since process start (those regions are pageable).
+    static size_t lockFailures() noexcept
+    {
+        return s_LockFailures.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct slot
+    {
+        BYTE* middle;
+        SIZE_T size;
+    };
+
+    locked_pool() = default;
+    ~locked_pool()
+    {
+        t_Gone = true;
+        for (size_t i = 0; i < m_Count; ++i)
+            unmap(m_Slots[i].middle, m_Slots[i].size);
+    }
+
+    static locked_pool& local() noexcept
+    {
+        static thread_local locked_pool pool;
+        return pool;
+    }
+
+    // Unlock the pinned pages and release the whole reservation, guard
+    // pages included, back to the OS.
+    static void unmap(BYTE* middle, SIZE_T middleSize) noexcept
+    {
+        // Fails with ERROR_NOT_LOCKED for a region whose lock was refused.
+        if (VirtualUnlock(middle, middleSize))
+        {
+            s_LockedBytes.fetch_sub(middleSize, std::memory_order_relaxed);
+            s_LockedRegions.fetch_sub(1, std::memory_order_relaxed);
+        }
+        (void)VirtualFree(middle - cachedPageSize(), 0, MEM_RELEASE);
+    }
+
+    // Trivially destructible, so it can still be read after the pool itself
+    // has been destroyed at thread exit.
+    static inline thread_local bool t_Gone = false;
+
+    static inline std::atomic<size_t> s_LockedBytes{0};
+    static inline std::atomic<size_t> s_LockedRegions{0};
+    static inline std::atomic<size_t> s_LockFailures{0};
+
+    slot m_Slots[cfg::LOCKED_POOL_MAX_REGIONS]{};
+    size_t m_Count = 0;
+    SIZE_T m_Bytes = 0;
+};
+
+/**
+ * @class locked_slab
+ * @brief Slab backend for small locked allocations.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Memory
+ *
+ * A page-backed allocation spends four pages (guard, header, payload,
+ * guard) on even a 12-character secret, which exhausts the working-set
+ * quota that VirtualLock draws on once a vault holds a few thousand
+ * decrypted fields. Requests up to cfg::LOCKED_SLAB_MAX_SLOT bytes
+ * (header and canary included) are instead carved out of shared arenas.
+ *
+ * - Each arena is a cfg::LOCKED_SLAB_ARENA locked region from locked_pool,
+ *   bounded by guard pages, split into slots of one power-of-2 size class.
+ * - Each slot is [slot_header | payload | canary | slack]; the canary is
+ *   verified and the whole slot wiped on free, as for page allocations.
+ * - Slab payloads are never page-aligned (the slot header precedes them),
+ *   which is how owns() tells them from page-backed payloads.
+ * - Slots share pages, so protect_noaccess() / protect_readwrite() leave
+ *   them READWRITE.
+ * - Arenas are shared by all threads under one SRW lock. An arena that
+ *   empties is released unless it is the last one of its class.
+ *
+ * @see locked_allocator, locked_pool
+ */
+class locked_slab
+{
+public:
+    static constexpr size_t kSlotHeader = 16;  //!< Bytes of slot_header before each payload.
+    static constexpr size_t kMaxUsable =
+        cfg::LOCKED_SLAB_MAX_SLOT - kSlotHeader - cfg::LOCKED_SLAB_CANARY_BYTES;
+
+    /// @brief True if @p p is a payload returned by allocate().
+    static bool owns(const void* p) noexcept
+    {
+        return cfg::LOCKED_SLAB && p &&
+               (reinterpret_cast<uintptr_t>(p) & (cachedPageSize() - 1)) != 0;
+    }
+
+    /**
+     * @brief Allocate @p usable bytes from a slab arena.
+     * @pre usable <= kMaxUsable.
+     * @return 16-byte aligned payload, zero-filled.
+     * @throw std::bad_alloc if a new arena cannot be allocated.
+     */
+    static void* allocate(size_t usable)
+    {
+        const size_t cls = classIndex(kSlotHeader + usable + cfg::LOCKED_SLAB_CANARY_BYTES);
+
+        AcquireSRWLockExclusive(&s_Lock);
+        arena* a = s_Arenas[cls];
+        while (a && a->used == a->capacity)
+            a = a->next;
+        if (!a)
+        {
+            BYTE* mem = nullptr;
+            try
+            {
+                mem = locked_pool::acquire(cfg::LOCKED_SLAB_ARENA);
+            }
+            catch (...)
+            {
+                ReleaseSRWLockExclusive(&s_Lock);
+                throw;
+            }
+            const uint32_t slotSize = static_cast<uint32_t>(cfg::LOCKED_SLAB_MIN_SLOT << cls);
+            a = reinterpret_cast<arena*>(mem);
+            a->magic = kSlabMagic;
+            a->slotSize = slotSize;
+            a->first = static_cast<uint32_t>(align_up(sizeof(arena), slotSize));
+            a->capacity = static_cast<uint32_t>((cfg::LOCKED_SLAB_ARENA - a->first) / slotSize);
+            a->used = 0;
+            a->bump = 0;
+            a->freeList = nullptr;
+            a->next = s_Arenas[cls];
+            s_Arenas[cls] = a;
+            ++s_ArenaCount;
+        }
+
+        unsigned char* slot = nullptr;
+        if (a->freeList)
+        {
+            // Free slots are linked through their first bytes.
+            slot = a->freeList;
+            std::memcpy(&a->freeList, slot, sizeof(a->freeList));
+            SecureZeroMemory(slot, sizeof(a->freeList));
+        }
+        else
+        {
+            slot = reinterpret_cast<unsigned char*>(a) + a->first +
+                   static_cast<size_t>(a->bump++) * a->slotSize;
+        }
+        ++a->used;
+        ReleaseSRWLockExclusive(&s_Lock);
+
+        auto* h = reinterpret_cast<slot_header*>(slot);
+        h->owner = a;
+        h->usable = static_cast<uint32_t>(usable);
+        h->magic = kSlabMagic;
+
+        unsigned char* payload = slot + kSlotHeader;
+        memset(payload + usable, 0xD0, cfg::LOCKED_SLAB_CANARY_BYTES);
+        return payload;
+    }
+
+    /**
+     * @brief Verify, wipe and free a payload from allocate().
+     *
+     * Calls `__fastfail` on a corrupted slot header or an overwritten
+     * canary, like locked_allocator::deallocate().
+     */
+    static void deallocate(void* p) noexcept
+    {
+        unsigned char* slot = static_cast<unsigned char*>(p) - kSlotHeader;
+        auto* h = reinterpret_cast<slot_header*>(slot);
+        arena* a = h->owner;
+        if (h->magic != kSlabMagic || !a || a->magic != kSlabMagic ||
+            h->usable + kSlotHeader + cfg::LOCKED_SLAB_CANARY_BYTES > a->slotSize)
+        {
+            corrupted(1);
+        }
+
+        const size_t usable = h->usable;
+        const unsigned char* bytes = static_cast<const unsigned char*>(p);
+        bool canary_ok = true;
+        bool looks_wiped = true;
+        for (size_t i = 0; i < cfg::LOCKED_SLAB_CANARY_BYTES; ++i)
+            canary_ok &= bytes[usable + i] == 0xD0;
+        for (size_t i = 0; i < usable + cfg::LOCKED_SLAB_CANARY_BYTES; ++i)
+            looks_wiped &= bytes[i] == 0;
+        // A pre-wiped slot (cleanseString) is expected, not a corruption.
+        if (!canary_ok && !looks_wiped)
+            corrupted(2);
+
+        const size_t slotSize = a->slotSize;
+        SecureZeroMemory(slot, slotSize);
+
+        arena* empty = nullptr;
+        AcquireSRWLockExclusive(&s_Lock);
+        std::memcpy(slot, &a->freeList, sizeof(a->freeList));
+        a->freeList = slot;
+        --a->used;
+        const size_t cls = classIndex(slotSize);
+        if (a->used == 0 && (s_Arenas[cls] != a || a->next))
+        {
+            arena** link = &s_Arenas[cls];
+            while (*link != a)
+                link = &(*link)->next;
+            *link = a->next;
+            --s_ArenaCount;
+            empty = a;
+        }
+        ReleaseSRWLockExclusive(&s_Lock);
+
+        if (empty)
+        {
+            // Slots are wiped already; this clears the control block and
+            // the free-list links so the region goes back clean.
+            SecureZeroMemory(empty, cfg::LOCKED_SLAB_ARENA);
+            locked_pool::release(reinterpret_cast<BYTE*>(empty), cfg::LOCKED_SLAB_ARENA);
+        }
+    }
+
+    /// @brief Requested payload bytes of a slab allocation.
+    static size_t usable(const void* p) noexcept
+    {
+        return reinterpret_cast<const slot_header*>(static_cast<const unsigned char*>(p) -
+                                                    kSlotHeader)
+            ->usable;
+    }
+
+    /// @brief Number of live slab arenas across all threads.
+    static size_t arenas() noexcept
+    {
+        AcquireSRWLockShared(&s_Lock);
+        size_t n = s_ArenaCount;
+        ReleaseSRWLockShared(&s_Lock);
+        return n;
+    }
+
+private:
+    static constexpr uint32_t kSlabMagic = 0x626C7373u;  // "sslb"
+    static constexpr size_t kClasses =
+        std::bit_width(cfg::LOCKED_SLAB_MAX_SLOT / cfg::LOCKED_SLAB_MIN_SLOT);
+
+    // Control block at the start of each arena; slots follow at `first`.
+    struct arena
+    {
+        uint32_t magic;
+        uint32_t slotSize;
+        uint32_t first;     // offset of slot 0
+        uint32_t capacity;  // slots per arena
+        uint32_t used;      // slots handed out
+        uint32_t bump;      // slots ever handed out; beyond it memory is untouched
+        unsigned char* freeList;
+        arena* next;  // next arena of the same class
+    };
+
+    struct slot_header
+    {
+        arena* owner;
+        uint32_t usable;
+        uint32_t magic;
+    };
+    static_assert(sizeof(slot_header) <= kSlotHeader);
+
+    static size_t classIndex(size_t need) noexcept
+    {
+        size_t cls = 0;
+        while ((cfg::LOCKED_SLAB_MIN_SLOT << cls) < need)
+            ++cls;
+        return cls;
+    }
+
+    [[noreturn]] static void corrupted(int code) noexcept
+    {
+#ifdef _MSC_VER
+        __fastfail(code);
+#else
+        (void)code;
+        std::terminate();
+#endif
+    }
+
+    // The lock and lists are trivially destructible, so allocations freed
+    // from static destructors still find them intact.
+    static inline SRWLOCK s_Lock = SRWLOCK_INIT;
+    static inline arena* s_Arenas[kClasses]{};
+    static inline size_t s_ArenaCount = 0;
+};
+
 /**
  * @brief Secure allocator with guard pages, canary sentinels, and page locking.
  * @author Alex (https://github.com/lextpf)
@@ -90,8 +554,12 @@ inline locked_header* header_from_payload(const T* payload)
  * - Committed pages are pinned in RAM via VirtualLock (best-effort).
  * - Canary bytes (0xD0) after the payload detect buffer overruns.
  * - deallocate() verifies the canary and calls `__fastfail` on corruption.
+ * - Freed regions are wiped and parked in the thread's locked_pool, so
+ *   repeated allocations of one size skip the VirtualAlloc/VirtualLock work.
+ * - With cfg::LOCKED_SLAB, requests up to locked_slab::kMaxUsable bytes come
+ *   from a shared locked_slab arena instead, with a per-slot canary.
  *
- * @see locked_header, protect_noaccess, protect_readwrite
+ * @see locked_header, locked_pool, locked_slab, protect_noaccess, protect_readwrite
  */
 template <class T>
 struct locked_allocator
@@ -118,6 +586,12 @@ struct locked_allocator
             throw std::bad_alloc();
         SIZE_T needBytes = n * sizeof(T);
 
+        if constexpr (cfg::LOCKED_SLAB && alignof(T) <= locked_slab::kSlotHeader)
+        {
+            if (needBytes <= locked_slab::kMaxUsable)
+                return static_cast<T*>(locked_slab::allocate(needBytes));
+        }
+
         SIZE_T page = cachedPageSize();
 
         // Layout: [guard page | header | payload + canary + slack | guard page]
@@ -139,23 +613,10 @@ struct locked_allocator
         }
         SIZE_T total = middleNeed + 2 * page;  // add front + back guard pages
 
-        // Reserve the entire region as PAGE_NOACCESS - the two guard pages at
-        // each end stay NOACCESS permanently to trap out-of-bounds access.
-        BYTE* base = (BYTE*)VirtualAlloc(nullptr, total, MEM_RESERVE, PAGE_NOACCESS);
-        if (!base)
-            throw std::bad_alloc();
-
-        // Commit only the middle (header + payload) as read-write.
-        BYTE* middle = (BYTE*)VirtualAlloc(base + page, middleNeed, MEM_COMMIT, PAGE_READWRITE);
-        if (!middle)
-        {
-            VirtualFree(base, 0, MEM_RELEASE);
-            throw std::bad_alloc();
-        }
-
-        // Pin committed pages in physical RAM so they're never swapped to disk.
-        // Best-effort: requires SeLockMemoryPrivilege or sufficient working-set quota.
-        (void)VirtualLock(middle, middleNeed);
+        // Reuses a region this thread released earlier when one of the same
+        // size is parked; otherwise reserves, commits and locks a new one.
+        BYTE* middle = locked_pool::acquire(middleNeed);
+        BYTE* base = middle - page;
 
         // Write metadata into the header at the start of the committed region.
         auto* hdr = reinterpret_cast<locked_header*>(middle);
@@ -168,6 +629,9 @@ struct locked_allocator
             middleNeed - headerSize;  // everything after header (usable + canary + slack)
         hdr->magic = kMagic;
         hdr->version = kVersion;
+        hdr->rwScopes = 0;
+        hdr->noAccess = 0;
+        InitializeSRWLock(&hdr->protectLock);
 
         BYTE* payload = middle + headerSize;
 
@@ -188,6 +652,11 @@ struct locked_allocator
     {
         if (!p)
             return;
+        if (locked_slab::owns(p))
+        {
+            locked_slab::deallocate(p);
+            return;
+        }
 
         auto* hdr = header_from_payload(p);
         BYTE* bytes = reinterpret_cast<BYTE*>(p);
@@ -211,10 +680,14 @@ struct locked_allocator
         SIZE_T payloadSpan = hdr->payloadSpan;
         SIZE_T usable = hdr->usable;
 
-        // The payload might be PAGE_NOACCESS (e.g. after protect_noaccess).
-        // Temporarily restore RW so we can inspect the canary and wipe.
-        DWORD oldProt{}, dummy{};
-        (void)VirtualProtect(bytes, payloadSpan, PAGE_READWRITE, &oldProt);
+        // The payload might be PAGE_NOACCESS (after protect_noaccess); if so,
+        // restore RW so we can inspect the canary and wipe. The header knows,
+        // so the common READWRITE case costs no syscall.
+        if (hdr->noAccess && hdr->rwScopes == 0)
+        {
+            DWORD oldProt{};
+            (void)VirtualProtect(bytes, payloadSpan, PAGE_READWRITE, &oldProt);
+        }
 
         // Check the 0xD0 canary sentinel placed after the usable region.
         // A corrupted canary means something wrote past the end of the buffer.
@@ -245,9 +718,10 @@ struct locked_allocator
 
         // Scrub everything from payload through the end of committed pages.
         // SecureZeroMemory is not elided by the optimizer.
+        // The payload stays READWRITE: the region is either released or
+        // parked for reuse, and locked_pool expects the latter writable.
         if (payloadSpan)
             SecureZeroMemory(bytes, payloadSpan);
-        (void)VirtualProtect(bytes, payloadSpan, oldProt, &dummy);
 
         // A genuine canary mismatch (not caused by pre-wiping) means a buffer
         // overrun occurred. This is a security-critical condition - crash
@@ -264,12 +738,10 @@ struct locked_allocator
         // Wipe the header so metadata (pointers, sizes) doesn't linger in memory.
         SecureZeroMemory(hdr, sizeof(locked_header));
 
-        // Unlock pinned pages and release the entire reserved region
-        // (guard pages + committed pages) back to the OS.
-        if (middleSize)
-            (void)VirtualUnlock((LPVOID)((BYTE*)hdr), middleSize);
-        if (base)
-            (void)VirtualFree(base, 0, MEM_RELEASE);
+        // Park the wiped region for this thread's next allocation of the
+        // same size, or release it (guard pages included) to the OS.
+        if (base && middleSize)
+            locked_pool::release(reinterpret_cast<BYTE*>(hdr), middleSize);
     }
 
     template <class U>
@@ -286,30 +758,73 @@ inline bool operator==(const locked_allocator<T>&, const locked_allocator<U>&)
     return true;
 }
 
+/// @brief Requested payload bytes of a locked_allocator allocation (either backend).
+/// @pre @p p was returned by locked_allocator::allocate().
+template <class T>
+inline size_t locked_usable(const T* p)
+{
+    if (locked_slab::owns(p))
+        return locked_slab::usable(p);
+    return header_from_payload(p)->usable;
+}
+
 /// @brief Switch the payload protection to PAGE_NOACCESS.
 /// @pre @p p was returned by locked_allocator::allocate() (or is null).
+/// @note No-op for slab payloads, which share their pages, and for payloads
+///       already at rest NOACCESS. Inside an RWGuard scope the change is
+///       deferred until the last scope closes.
 template <class T>
 inline void protect_noaccess(const T* p)
 {
-    if (!p)
+    if (!p || locked_slab::owns(p))
         return;
     auto* hdr = header_from_payload(p);
-    DWORD oldProt;
-    (void)VirtualProtect(
-        const_cast<std::remove_cv_t<T>*>(p), hdr->payloadSpan, PAGE_NOACCESS, &oldProt);
+    AcquireSRWLockExclusive(&hdr->protectLock);
+    if (!hdr->noAccess)
+    {
+        hdr->noAccess = 1;
+        if (!hdr->rwScopes)
+            set_payload_protection(hdr, PAGE_NOACCESS);
+    }
+    ReleaseSRWLockExclusive(&hdr->protectLock);
 }
 
 /// @brief Switch the payload protection to PAGE_READWRITE.
 /// @pre @p p was returned by locked_allocator::allocate() (or is null).
+/// @note No-op for slab payloads, which are always READWRITE, and for
+///       payloads that already are (the usual case: a syscall is only made
+///       when a prior protect_noaccess() is being undone).
 template <class T>
 inline void protect_readwrite(const T* p)
 {
-    if (!p)
+    if (!p || locked_slab::owns(p))
         return;
     auto* hdr = header_from_payload(p);
-    DWORD oldProt;
-    (void)VirtualProtect(
-        const_cast<std::remove_cv_t<T>*>(p), hdr->payloadSpan, PAGE_READWRITE, &oldProt);
+    AcquireSRWLockExclusive(&hdr->protectLock);
+    if (hdr->noAccess)
+    {
+        hdr->noAccess = 0;
+        if (!hdr->rwScopes)
+            set_payload_protection(hdr, PAGE_READWRITE);
+    }
+    ReleaseSRWLockExclusive(&hdr->protectLock);
+}
+
+/// @brief Whether the payload currently rests at PAGE_NOACCESS.
+/// @pre @p p was returned by locked_allocator::allocate() (or is null).
+/// @note Always false for slab payloads and null. An open RWGuard does not
+///       change the answer: it lends READWRITE access without moving the
+///       resting state.
+template <class T>
+inline bool is_noaccess(const T* p)
+{
+    if (!p || locked_slab::owns(p))
+        return false;
+    auto* hdr = header_from_payload(p);
+    AcquireSRWLockShared(&hdr->protectLock);
+    const bool noAccess = hdr->noAccess != 0;
+    ReleaseSRWLockShared(&hdr->protectLock);
+    return noAccess;
 }
 
 }  // namespace seal
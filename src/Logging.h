@@ -2,7 +2,10 @@
 
 #ifdef USE_QT_UI
 
+#include "Diagnostics.h"
+
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
 
 /**
  * @brief Qt logging categories and message handler for the seal application.
@@ -27,6 +30,23 @@ Q_DECLARE_LOGGING_CATEGORY(logApp)      // Application lifecycle and general eve
 Q_DECLARE_LOGGING_CATEGORY(logCamera)   // Camera enumeration, probing, and selection.
 Q_DECLARE_LOGGING_CATEGORY(logQr)       // QR capture loop and frame decoding.
 
+/**
+ * @brief Emit one logfmt line whose fields are built only if it will be shown.
+ *
+ * @p level is a Qt category macro (`qCDebug`, `qCInfo`, `qCWarning`,
+ * `qCCritical`). Qt evaluates the streamed expression only when
+ * @p category is enabled for that level, so the diag::kv() fields in the
+ * variadic arguments cost nothing for a filtered-out line (e.g. under
+ * `QT_LOGGING_RULES="seal.*.info=false"`). Passing the fields to a helper
+ * function instead builds every string before the check.
+ *
+ * ```cpp
+ * SEAL_LOG(qCInfo, logVault, "event=vault.load.ok", seal::diag::kv("op", op));
+ * ```
+ */
+#define SEAL_LOG(level, category, ...) \
+    level(category).noquote() << QString::fromStdString(seal::diag::joinFields({__VA_ARGS__}))
+
 /**
  * @brief Install the seal-specific Qt message handler.
  *
@@ -0,0 +1,186 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+
+using seal::metrics::kBuckets;
+
+constexpr size_t kCounters = static_cast<size_t>(seal::metrics::Counter::Count_);
+constexpr size_t kLatencies = static_cast<size_t>(seal::metrics::Latency::Count_);
+
+struct Histogram
+{
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sumNs{0};
+    std::atomic<uint64_t> maxNs{0};
+    std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+};
+
+std::array<std::atomic<uint64_t>, kCounters> g_Counters{};
+std::array<Histogram, kLatencies> g_Latencies{};
+// steady_clock ticks at process start (or the last reset()).
+std::atomic<int64_t> g_StartTicks{std::chrono::steady_clock::now().time_since_epoch().count()};
+
+size_t bucketFor(uint64_t ns) noexcept
+{
+    const uint64_t us = ns / 1000;
+    return std::min<size_t>(std::bit_width(us), kBuckets - 1);
+}
+
+// Exclusive upper bound of bucket i in microseconds.
+uint64_t bucketLimitUs(size_t i) noexcept
+{
+    return uint64_t{1} << i;
+}
+
+}  // namespace
+
+namespace seal::metrics
+{
+
+void add(Counter c, uint64_t n) noexcept
+{
+    g_Counters[static_cast<size_t>(c)].fetch_add(n, std::memory_order_relaxed);
+}
+
+void record(Latency l, std::chrono::nanoseconds elapsed) noexcept
+{
+    const uint64_t ns = elapsed.count() > 0 ? static_cast<uint64_t>(elapsed.count()) : 0;
+    Histogram& h = g_Latencies[static_cast<size_t>(l)];
+    h.count.fetch_add(1, std::memory_order_relaxed);
+    h.sumNs.fetch_add(ns, std::memory_order_relaxed);
+    h.buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t seen = h.maxNs.load(std::memory_order_relaxed);
+    while (ns > seen && !h.maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64_t HistogramSnapshot::quantileUs(double q) const noexcept
+{
+    if (count == 0)
+        return 0;
+    const double target = std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count));
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(target));
+    const uint64_t maxUs = (maxNs + 999) / 1000;
+    uint64_t seen = 0;
+    for (size_t i = 0; i + 1 < kBuckets; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(bucketLimitUs(i), maxUs);
+    }
+    return maxUs;
+}
+
+Snapshot snapshot() noexcept
+{
+    Snapshot s;
+    const int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+    const int64_t start = g_StartTicks.load(std::memory_order_relaxed);
+    s.uptime = std::chrono::steady_clock::duration(now - start);
+    for (size_t i = 0; i < kCounters; ++i)
+        s.counters[i] = g_Counters[i].load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kLatencies; ++i)
+    {
+        const Histogram& h = g_Latencies[i];
+        HistogramSnapshot& out = s.latencies[i];
+        out.count = h.count.load(std::memory_order_relaxed);
+        out.sumNs = h.sumNs.load(std::memory_order_relaxed);
+        out.maxNs = h.maxNs.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < kBuckets; ++b)
+            out.buckets[b] = h.buckets[b].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void reset() noexcept
+{
+    for (auto& c : g_Counters)
+        c.store(0, std::memory_order_relaxed);
+    for (auto& h : g_Latencies)
+    {
+        h.count.store(0, std::memory_order_relaxed);
+        h.sumNs.store(0, std::memory_order_relaxed);
+        h.maxNs.store(0, std::memory_order_relaxed);
+        for (auto& b : h.buckets)
+            b.store(0, std::memory_order_relaxed);
+    }
+    g_StartTicks.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                    std::memory_order_relaxed);
+}
+
+std::string_view name(Counter c) noexcept
+{
+    switch (c)
+    {
+        case Counter::PacketsSealed:
+            return "packets_sealed";
+        case Counter::PacketsOpened:
+            return "packets_opened";
+        case Counter::AuthFailures:
+            return "auth_failures";
+        case Counter::BytesSealed:
+            return "bytes_sealed";
+        case Counter::BytesOpened:
+            return "bytes_opened";
+        case Counter::KeyDerivations:
+            return "key_derivations";
+        default:
+            return "unknown";
+    }
+}
+
+std::string_view name(Latency l) noexcept
+{
+    switch (l)
+    {
+        case Latency::KeyDerivation:
+            return "kdf";
+        case Latency::VaultLoad:
+            return "vault_load";
+        case Latency::VaultSave:
+            return "vault_save";
+        case Latency::Fill:
+            return "fill";
+        case Latency::QrScan:
+            return "qr_scan";
+        default:
+            return "unknown";
+    }
+}
+
+std::string report(const Snapshot& s)
+{
+    const double seconds = std::chrono::duration<double>(s.uptime).count();
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    out << "metric=uptime seconds=" << seconds << '\n';
+    for (size_t i = 0; i < kCounters; ++i)
+    {
+        const uint64_t total = s.counters[i];
+        out << "metric=" << name(static_cast<Counter>(i)) << " total=" << total
+            << " per_s=" << (seconds > 0 ? static_cast<double>(total) / seconds : 0.0) << '\n';
+    }
+    for (size_t i = 0; i < kLatencies; ++i)
+    {
+        const HistogramSnapshot& h = s.latencies[i];
+        if (h.count == 0)
+            continue;
+        out << "metric=" << name(static_cast<Latency>(i)) << " count=" << h.count
+            << " mean_ms=" << static_cast<double>(h.sumNs) / static_cast<double>(h.count) / 1e6
+            << " p50_ms=" << static_cast<double>(h.quantileUs(0.50)) / 1e3
+            << " p99_ms=" << static_cast<double>(h.quantileUs(0.99)) / 1e3
+            << " max_ms=" << static_cast<double>(h.maxNs) / 1e6 << '\n';
+    }
+    return out.str();
+}
+
+}  // namespace seal::metrics
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace seal
+{
+/**
+ * @namespace seal::metrics
+ * @brief In-process counters and fixed-bucket latency histograms.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Logging
+ *
+ * The set of metrics is fixed at compile time and every cell is a relaxed
+ * atomic, so recording is a handful of uncontended atomic adds: no locks,
+ * no allocation, and nothing to check against a logging category. That
+ * makes it safe on paths too hot for a log line, such as every AES-GCM
+ * seal and open.
+ *
+ * Latencies land in power-of-two microsecond buckets (see kBuckets), which
+ * bounds the memory and keeps quantiles within a factor of two of the
+ * true value -- plenty to tell a 300 ms unlock from a 3 s one.
+ *
+ * report() renders a snapshot as logfmt lines; the GUI console prints it
+ * for `:stats` and the command line for `--stats`.
+ *
+ * ```cpp
+ * {
+ *     seal::metrics::ScopedTimer timer(seal::metrics::Latency::VaultLoad);
+ *     // ... work ...
+ * }
+ * seal::metrics::add(seal::metrics::Counter::BytesSealed, plain.size());
+ * ```
+ */
+namespace metrics
+{
+
+/**
+ * @brief Monotonic event counters.
+ * @ingroup Logging
+ */
+enum class Counter : uint8_t
+{
+    PacketsSealed,   ///< AES-GCM seals: packets, segments and vault records
+    PacketsOpened,   ///< AES-GCM opens that authenticated
+    AuthFailures,    ///< AES-GCM opens rejected by the tag check
+    BytesSealed,     ///< Plaintext bytes encrypted
+    BytesOpened,     ///< Plaintext bytes decrypted
+    KeyDerivations,  ///< Password KDF runs
+    Count_
+};
+
+/**
+ * @brief Operations whose latency is recorded.
+ * @ingroup Logging
+ */
+enum class Latency : uint8_t
+{
+    KeyDerivation,  ///< One password KDF run (scrypt or Argon2id)
+    VaultLoad,      ///< loadVaultIndex(), open to parsed index
+    VaultSave,      ///< saveVaultV2(), begin to committed file
+    Fill,           ///< Auto-fill of one field: probe, decrypt and keystrokes
+    QrScan,         ///< captureQrFromWebcam(), camera ready to decoded payload
+    Count_
+};
+
+/// @brief Histogram buckets: 0 is under 1 us, i is [2^(i-1), 2^i) us, the last is open-ended.
+inline constexpr size_t kBuckets = 32;
+
+/// @brief Add @p n to counter @p c.
+void add(Counter c, uint64_t n = 1) noexcept;
+
+/// @brief Record one observation of @p l taking @p elapsed.
+void record(Latency l, std::chrono::nanoseconds elapsed) noexcept;
+
+/**
+ * @class ScopedTimer
+ * @brief Records the lifetime of the object as one observation of a Latency.
+ * @ingroup Logging
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Latency l) noexcept
+        : m_Latency(l),
+          m_Start(std::chrono::steady_clock::now())
+    {
+    }
+    ~ScopedTimer() { record(m_Latency, std::chrono::steady_clock::now() - m_Start); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Latency m_Latency;
+    std::chrono::steady_clock::time_point m_Start;
+};
+
+/**
+ * @struct HistogramSnapshot
+ * @brief Point-in-time copy of one latency histogram.
+ * @ingroup Logging
+ */
+struct HistogramSnapshot
+{
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+    uint64_t maxNs = 0;
+    std::array<uint64_t, kBuckets> buckets{};
+
+    /**
+     * @brief Upper bound of the bucket holding quantile @p q.
+     * @param q Quantile in [0, 1] (0.5 = median).
+     * @return Microseconds, capped at the largest observation; 0 if empty.
+     */
+    [[nodiscard]] uint64_t quantileUs(double q) const noexcept;
+};
+
+/**
+ * @struct Snapshot
+ * @brief Point-in-time copy of every metric.
+ * @ingroup Logging
+ *
+ * Cells are read one at a time, so a snapshot taken while other threads
+ * record may be off by the operations in flight; each value on its own
+ * is exact.
+ */
+struct Snapshot
+{
+    std::chrono::nanoseconds uptime{};  ///< Since process start or the last reset()
+    std::array<uint64_t, static_cast<size_t>(Counter::Count_)> counters{};
+    std::array<HistogramSnapshot, static_cast<size_t>(Latency::Count_)> latencies{};
+
+    [[nodiscard]] uint64_t counter(Counter c) const noexcept
+    {
+        return counters[static_cast<size_t>(c)];
+    }
+    [[nodiscard]] const HistogramSnapshot& latency(Latency l) const noexcept
+    {
+        return latencies[static_cast<size_t>(l)];
+    }
+};
+
+/// @brief Copy the current value of every metric.
+[[nodiscard]] Snapshot snapshot() noexcept;
+
+/// @brief Zero every metric and restart the uptime clock.
+void reset() noexcept;
+
+/// @brief logfmt name of a counter (e.g. `bytes_sealed`).
+[[nodiscard]] std::string_view name(Counter c) noexcept;
+
+/// @brief logfmt name of a latency (e.g. `kdf`).
+[[nodiscard]] std::string_view name(Latency l) noexcept;
+
+/**
+ * @brief Render a snapshot as logfmt lines, one per metric.
+ * @ingroup Logging
+ *
+ * ```
+ * metric=uptime seconds=12.40
+ * metric=packets_sealed total=120 per_s=9.68
+ * metric=kdf count=3 mean_ms=310.25 p50_ms=262.14 p99_ms=524.29 max_ms=402.10
+ * ```
+ *
+ * Latencies with no observations are left out.
+ */
+[[nodiscard]] std::string report(const Snapshot& s);
+
+}  // namespace metrics
+}  // namespace seal
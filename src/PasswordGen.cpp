@@ -10,44 +10,99 @@
 namespace seal
 {
 
-secure_string<> GeneratePassword(int length)
+namespace
 {
-    length = std::clamp(length, 8, 128);
 
-    static constexpr char charset[] =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!@#$%^&*()-_=+";
-    static constexpr int charsetLen = sizeof(charset) - 1;
+constexpr char kCharset[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!@#$%^&*()-_=+";
+constexpr int kCharsetLen = sizeof(kCharset) - 1;
 
-    // Rejection sampling: Integer division truncates so `limit` is
-    // the largest multiple of charsetLen that fits in a byte.
-    static constexpr unsigned char limit =
-        static_cast<unsigned char>((256 / charsetLen) * charsetLen);
+// Rejection sampling: Integer division truncates so `kLimit` is
+// the largest multiple of kCharsetLen that fits in a byte.
+constexpr unsigned char kLimit = static_cast<unsigned char>((256 / kCharsetLen) * kCharsetLen);
 
-    secure_string<> password;
-    password.s.reserve(static_cast<size_t>(length));
+// Largest RAND_bytes request; one block covers ~40 passwords of 128 chars.
+constexpr size_t kRandomBlock = 8192;
 
-    unsigned char rndBuf[128];
-    int filled = 0;
-    while (filled < length)
-    {
-        int need = length - filled;
+// Hands out uniformly distributed charset characters from RAND_bytes
+// blocks. Each block is consumed in full before the next is drawn, and
+// is wiped on refill and on destruction.
+class CharsetSampler
+{
+public:
+    // expected: characters the caller will take, to size small requests.
+    explicit CharsetSampler(size_t expected)
         // Over-request to reduce the number of RAND_bytes round-trips;
-        // each byte has a ~70% acceptance rate (196/256 for charsetLen=76).
-        int request = std::min(need * 2, static_cast<int>(sizeof(rndBuf)));
-        if (RAND_bytes(rndBuf, request) != 1)
-            throw std::runtime_error("RAND_bytes failed");
-        for (int i = 0; i < request && filled < length; ++i)
+        // each byte has a ~89% acceptance rate (228/256 for kCharsetLen=76).
+        : m_Request(std::clamp<size_t>(expected * 2, 16, kRandomBlock))
+    {
+    }
+
+    ~CharsetSampler() { SecureZeroMemory(m_Block, sizeof(m_Block)); }
+
+    CharsetSampler(const CharsetSampler&) = delete;
+    CharsetSampler& operator=(const CharsetSampler&) = delete;
+
+    // Write n characters to out.
+    void fill(char* out, size_t n)
+    {
+        while (n > 0)
         {
-            if (rndBuf[i] < limit)
+            if (m_Pos == m_Size)
+                refill();
+            const unsigned char b = m_Block[m_Pos++];
+            if (b < kLimit)
             {
-                password.push_back(charset[rndBuf[i] % charsetLen]);
-                ++filled;
+                *out++ = kCharset[b % kCharsetLen];
+                --n;
             }
         }
     }
-    SecureZeroMemory(rndBuf, sizeof(rndBuf));
 
+private:
+    void refill()
+    {
+        if (RAND_bytes(m_Block, static_cast<int>(m_Request)) != 1)
+            throw std::runtime_error("RAND_bytes failed");
+        m_Size = m_Request;
+        m_Pos = 0;
+    }
+
+    unsigned char m_Block[kRandomBlock];
+    size_t m_Request;
+    size_t m_Size = 0;
+    size_t m_Pos = 0;
+};
+
+}  // namespace
+
+secure_string<> GeneratePassword(int length)
+{
+    length = std::clamp(length, 8, 128);
+
+    secure_string<> password;
+    password.s.resize(static_cast<size_t>(length));
+    CharsetSampler sampler(password.size());
+    sampler.fill(password.s.data(), password.size());
     return password;
 }
 
+PasswordBatch GeneratePasswords(size_t count, int length)
+{
+    PasswordBatch batch;
+    batch.length = static_cast<size_t>(std::clamp(length, 8, 128));
+    batch.count = std::clamp<size_t>(count, 1, kMaxPasswordBatch);
+
+    const size_t stride = batch.length + 1;
+    batch.text.s.resize(batch.count * stride);
+    CharsetSampler sampler(batch.text.size());
+    char* out = batch.text.s.data();
+    for (size_t i = 0; i < batch.count; ++i, out += stride)
+    {
+        sampler.fill(out, batch.length);
+        out[batch.length] = '\n';
+    }
+    return batch;
+}
+
 }  // namespace seal
@@ -2,6 +2,9 @@
 
 #include "SecureString.h"
 
+#include <cstddef>
+#include <string_view>
+
 namespace seal
 {
 
@@ -23,4 +26,42 @@ namespace seal
  */
 [[nodiscard]] secure_string<> GeneratePassword(int length);
 
+/// @brief Largest number of passwords GeneratePasswords() makes in one batch.
+inline constexpr size_t kMaxPasswordBatch = 1'000'000;
+
+/**
+ * @struct PasswordBatch
+ * @brief Passwords from one GeneratePasswords() call, in one locked buffer.
+ *
+ * Each password is followed by `\n`, so `text` can be written out in a
+ * single call; password() returns one of them without the newline.
+ */
+struct PasswordBatch
+{
+    secure_string<> text;  ///< `count` passwords, each terminated by `\n`
+    size_t length = 0;     ///< Characters per password
+    size_t count = 0;      ///< Number of passwords
+
+    /// @brief Password @p index, without its newline. @pre `index < count`.
+    [[nodiscard]] std::string_view password(size_t index) const
+    {
+        return std::string_view(text.data() + index * (length + 1), length);
+    }
+};
+
+/**
+ * @brief Generate many passwords at once for bulk provisioning.
+ *
+ * Same charset, clamping and rejection sampling as GeneratePassword(),
+ * but randomness is drawn in large `RAND_bytes` blocks that are sampled
+ * in full, and every password is written straight into the one locked
+ * output buffer, so there is no per-password allocation.
+ *
+ * @param count  Number of passwords (clamped to 1..kMaxPasswordBatch).
+ * @param length Characters per password (clamped to 8..128).
+ * @return The batch in locked memory.
+ * @throw std::runtime_error if `RAND_bytes` fails.
+ */
+[[nodiscard]] PasswordBatch GeneratePasswords(size_t count, int length);
+
 }  // namespace seal
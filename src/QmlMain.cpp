@@ -14,7 +14,10 @@
 #include <QtQuick/QQuickWindow>
 #include <QtQuickControls2/QQuickStyle>
 
+#include <windows.h>
+
 #include <algorithm>
+#include <chrono>
 
 // Compute a DPI-aware text scale factor.
 // Baseline: 1920 physical pixels = 1.0 (no scaling).
@@ -43,8 +46,30 @@ static qreal computeUiScale()
     return std::clamp(textScale, kMinScale, kMaxScale);
 }
 
+// Milliseconds since the OS created this process, so startup timings also
+// cover image loading, static initialisers and CRT startup before main().
+// Returns -1 if the creation time is unavailable.
+static long long msSinceProcessStart()
+{
+    FILETIME created{};
+    FILETIME exited{};
+    FILETIME kernel{};
+    FILETIME user{};
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user))
+        return -1;
+    FILETIME now{};
+    GetSystemTimePreciseAsFileTime(&now);
+
+    const auto ticks = [](const FILETIME& ft)
+    { return (static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime; };
+    // FILETIME counts 100 ns intervals.
+    return static_cast<long long>((ticks(now) - ticks(created)) / 10'000);
+}
+
 int RunQMLMode(int argc, char* argv[])
 {
+    const auto started = std::chrono::steady_clock::now();
+
     // "Basic" is a non-native Qt Quick Controls style with no platform look-and-feel.
     // This ensures our custom Theme.qml palette/colors take full effect on all OSes.
     QQuickStyle::setStyle("Basic");
@@ -54,8 +79,11 @@ int RunQMLMode(int argc, char* argv[])
     app.setApplicationName("seal");
     app.setOrganizationName("seal");
     const qreal uiScale = computeUiScale();
-    qCInfo(logApp).noquote() << QString::fromStdString(seal::diag::joinFields(
-        {"event=app.startup.begin", "mode=gui", seal::diag::kv("ui_scale", uiScale, 2)}));
+    qCInfo(logApp).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=app.startup.begin",
+                                "mode=gui",
+                                seal::diag::kv("ui_scale", uiScale, 2),
+                                seal::diag::kv("since_process_ms", msSinceProcessStart())}));
     if (seal::Cryptography::isRemoteSession())
     {
         qCCritical(logApp).noquote() << QString::fromStdString(
@@ -65,6 +93,9 @@ int RunQMLMode(int argc, char* argv[])
     }
 
     seal::Backend backend;
+    seal::Backend::setQmlInstance(&backend);
+    // Find the vault to auto-load while the engine builds the window.
+    backend.startVaultDiscovery();
     QQmlApplicationEngine engine;
     // If QML object creation fails (e.g. syntax error in Main.qml), abort
     // immediately rather than displaying an empty window the user can't interact with.
@@ -76,8 +107,9 @@ int RunQMLMode(int argc, char* argv[])
         [] { QCoreApplication::exit(1); },
         Qt::QueuedConnection);
 
-    engine.rootContext()->setContextProperty("UiScale", uiScale);   // DPI-aware text scale factor
-    engine.rootContext()->setContextProperty("Backend", &backend);  // vault + crypto operations
+    // Backend reaches QML as the module's registered singleton (see Backend.h),
+    // which lets qmlcachegen compile the bindings that use it.
+    engine.rootContext()->setContextProperty("UiScale", uiScale);  // DPI-aware text scale factor
     engine.loadFromModule("seal", "Main");
 
     if (engine.rootObjects().isEmpty())
@@ -87,8 +119,39 @@ int RunQMLMode(int argc, char* argv[])
         return 1;
     }
 
-    qCInfo(logApp).noquote() << QString::fromStdString(
-        seal::diag::joinFields({"event=app.qml.load.ok", "result=ok"}));
+    // Startup timeline: process start -> QML loaded -> first frame on screen
+    // -> first vault ready.
+    const auto logStartupStep = [started](const char* event)
+    {
+        qCInfo(logApp).noquote() << QString::fromStdString(seal::diag::joinFields(
+            {event,
+             "result=ok",
+             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)),
+             seal::diag::kv("since_process_ms", msSinceProcessStart())}));
+    };
+    logStartupStep("event=app.qml.load.ok");
+
+    // frameSwapped comes from the render thread, so the handler runs queued here.
+    if (auto* window = qobject_cast<QQuickWindow*>(engine.rootObjects().constFirst()))
+    {
+        QObject::connect(
+            window,
+            &QQuickWindow::frameSwapped,
+            &app,
+            [logStartupStep]() { logStartupStep("event=app.startup.first_frame"); },
+            static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::SingleShotConnection));
+    }
+    QMetaObject::Connection vaultReady;
+    vaultReady = QObject::connect(&backend,
+                                  &seal::Backend::vaultLoadedChanged,
+                                  &app,
+                                  [&backend, &vaultReady, logStartupStep]()
+                                  {
+                                      if (!backend.vaultLoaded())
+                                          return;
+                                      QObject::disconnect(vaultReady);
+                                      logStartupStep("event=app.startup.vault_ready");
+                                  });
     return app.exec();
 }
 
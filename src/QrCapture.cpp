@@ -4,6 +4,7 @@
 #include "ConsoleStyle.h"
 #include "Diagnostics.h"
 #include "Logging.h"
+#include "Metrics.h"
 
 #include <QtCore/QString>
 
@@ -19,10 +20,16 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <stop_token>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace
@@ -66,6 +73,24 @@ constexpr int kMaxFrameDimension = 3840;
 // QR v40 max is ~4296 bytes; anything larger is anomalous.
 constexpr size_t kMaxQrDataBytes = 4096;
 
+// Frame widths tried, coarse to fine, while no candidate is tracked.
+constexpr std::array<int, 2> kPyramidWidths = {480, 960};
+
+// Without a tracked candidate, frames wider than the finest pyramid level
+// get a full-resolution decode only on every kFullFrameEvery-th frame; at
+// 1080p that decode costs more than the rest of the pyramid together.
+constexpr int kFullFrameEvery = 3;
+
+// Frames a located candidate stays tracked after it was last detected.
+constexpr int kTrackFrames = 15;
+
+// A tracked region is padded by this fraction of its size on every side,
+// so a hand-held code stays inside it from one frame to the next.
+constexpr double kTrackMargin = 0.3;
+
+// Tracked regions larger than this are downscaled before decoding.
+constexpr int kMaxRoiDimension = 800;
+
 // 1 GiB process memory cap to block heap-spray / decompression bombs.
 constexpr SIZE_T kCaptureMemoryLimitBytes = 1ULL << 30;
 
@@ -133,6 +158,136 @@ struct CaptureJobGuard
     CaptureJobGuard& operator=(const CaptureJobGuard&) = delete;
 };
 
+// One-slot mailbox between the capture loop and the decoder. post()
+// replaces whatever frame is still waiting, so the decoder always picks up
+// the newest frame and never falls behind the camera.
+class FrameMailbox
+{
+public:
+    void post(cv::Mat frame)
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Frame = std::move(frame);
+        }
+        m_Ready.notify_one();
+    }
+
+    // Wait for the next frame. Returns false once @p stop is requested.
+    bool take(cv::Mat& out, std::stop_token stop)
+    {
+        std::unique_lock lock(m_Mutex);
+        if (!m_Ready.wait(lock, stop, [this] { return !m_Frame.empty(); }))
+            return false;
+        out = m_Frame;
+        m_Frame.release();
+        return true;
+    }
+
+private:
+    std::mutex m_Mutex;
+    std::condition_variable_any m_Ready;
+    cv::Mat m_Frame;
+};
+
+// Decoder stage of the capture pipeline. Once a QR candidate has been
+// located - decoded or not - later frames are decoded only in a padded
+// region around it, at up to full resolution, which is both much cheaper
+// than a whole-frame search and better at resolving a small or distant
+// code. Without a candidate it walks a coarse-to-fine pyramid and falls
+// back to a full-resolution decode every few frames.
+class QrTracker
+{
+public:
+    // Decoded payload, or an empty string. The caller wipes the result.
+    std::string decode(const cv::Mat& frame)
+    {
+        cv::Mat gray;
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        m_Bounds = cv::Rect(0, 0, gray.cols, gray.rows);
+
+        if (m_TrackFramesLeft > 0)
+            return decodeTracked(gray);
+
+        for (size_t i = 0; i < kPyramidWidths.size() && kPyramidWidths[i] < gray.cols; ++i)
+        {
+            const double scale = static_cast<double>(kPyramidWidths[i]) / gray.cols;
+            // Inverted codes (white modules on black) are only retried on the
+            // coarsest level; inverting every level doubles the miss cost.
+            std::string data = decodeLevel(gray, scale, cv::Point(), i == 0);
+            if (!data.empty())
+                return data;
+            if (m_TrackFramesLeft > 0)
+                return decodeTracked(gray);
+        }
+
+        if (gray.cols > kPyramidWidths.back() && ++m_FramesSinceFull < kFullFrameEvery)
+            return {};
+        m_FramesSinceFull = 0;
+        std::string data = decodeLevel(gray, 1.0, cv::Point(), gray.cols <= kPyramidWidths[0]);
+        if (data.empty() && m_TrackFramesLeft > 0)
+            return decodeTracked(gray);
+        return data;
+    }
+
+private:
+    std::string decodeTracked(const cv::Mat& gray)
+    {
+        --m_TrackFramesLeft;
+        const cv::Rect roi = m_Roi & m_Bounds;
+        if (roi.empty())
+        {
+            m_TrackFramesLeft = 0;
+            return {};
+        }
+        const double scale =
+            std::min(1.0, static_cast<double>(kMaxRoiDimension) / std::max(roi.width, roi.height));
+        return decodeLevel(gray(roi), scale, roi.tl(), true);
+    }
+
+    // Decode @p gray at @p scale. A detected candidate, decoded or not, is
+    // tracked from then on; @p offset maps @p gray back into the frame.
+    std::string decodeLevel(const cv::Mat& gray, double scale, cv::Point offset, bool tryInverted)
+    {
+        cv::Mat level = gray;
+        if (scale < 1.0)
+            cv::resize(gray, level, cv::Size(), scale, scale, cv::INTER_AREA);
+
+        std::vector<cv::Point> points;
+        std::string data = m_Detector.detectAndDecode(level, points);
+        if (data.empty() && points.empty() && tryInverted)
+        {
+            cv::Mat inverted;
+            cv::bitwise_not(level, inverted);
+            data = m_Detector.detectAndDecode(inverted, points);
+        }
+
+        if (!points.empty())
+            track(cv::boundingRect(points), scale, offset);
+        return data;
+    }
+
+    void track(const cv::Rect& box, double scale, cv::Point offset)
+    {
+        const double x = offset.x + box.x / scale;
+        const double y = offset.y + box.y / scale;
+        const double w = box.width / scale;
+        const double h = box.height / scale;
+        const cv::Rect padded(static_cast<int>(x - w * kTrackMargin),
+                              static_cast<int>(y - h * kTrackMargin),
+                              static_cast<int>(w * (1.0 + 2.0 * kTrackMargin)),
+                              static_cast<int>(h * (1.0 + 2.0 * kTrackMargin)));
+        m_Roi = padded & m_Bounds;
+        m_TrackFramesLeft = m_Roi.empty() ? 0 : kTrackFrames;
+    }
+
+    cv::QRCodeDetector m_Detector;
+    cv::Rect m_Bounds;
+    cv::Rect m_Roi;
+    int m_TrackFramesLeft = 0;
+    int m_FramesSinceFull = 0;
+};
+
 }  // namespace
 
 seal::secure_string<> seal::captureQrFromWebcam()
@@ -188,13 +343,77 @@ seal::secure_string<> seal::captureQrFromWebcam()
 
     writeQrDiag(seal::console::Tone::Info, {"event=qr.capture.ready", "result=ok"});
 
-    // QR decode loop
-    cv::QRCodeDetector qrDetector;
+    // Two-stage pipeline: this thread captures, validates and previews
+    // frames at the camera's own rate and posts each one to a one-slot
+    // mailbox; the decoder thread always takes the newest frame. Reading
+    // continuously keeps the driver queue empty, so no stale frames need
+    // flushing, and a slow decode never stalls the preview.
     const auto captureStart = std::chrono::steady_clock::now();
     const int captureTimeoutSec =
         seal::EnvIntOrDefault("SEAL_CAPTURE_TIMEOUT_SEC", kDefaultCaptureTimeoutSec, 5, 300);
 
-    while (true)
+    FrameMailbox mailbox;
+    std::atomic<bool> decoded{false};
+    std::jthread decoder(
+        [&](std::stop_token stop)
+        {
+            QrTracker tracker;
+            cv::Mat next;
+            int framesDecoded = 0;
+            while (mailbox.take(next, stop))
+            {
+                std::string data;
+                try
+                {
+                    data = tracker.decode(next);
+                }
+                catch (const cv::Exception& e)
+                {
+                    writeQrDiag(seal::console::Tone::Warning,
+                                {"event=qr.decode.skip",
+                                 "result=skip",
+                                 "reason=opencv_error",
+                                 seal::diag::kv("code", e.code)});
+                    continue;
+                }
+                ++framesDecoded;
+                if (data.empty())
+                    continue;
+
+                // Reject anomalously large payloads. QR v40 max is ~4296 bytes;
+                // anything bigger likely comes from a crafted virtual-camera frame.
+                if (data.size() > kMaxQrDataBytes)
+                {
+                    writeQrDiag(seal::console::Tone::Warning,
+                                {"event=qr.decode.skip",
+                                 "result=skip",
+                                 "reason=payload_too_large",
+                                 seal::diag::kv("payload_len", data.size()),
+                                 seal::diag::kv("limit_bytes", kMaxQrDataBytes)});
+                    SecureZeroMemory(data.data(), data.size());
+                    continue;
+                }
+
+                // Move decoded text into locked secure memory, then wipe the
+                // pageable std::string so the credential doesn't linger on a
+                // swappable heap page. The capture thread reads result only
+                // after joining this one.
+                result.s.assign(data.begin(), data.end());
+                SecureZeroMemory(data.data(), data.size());
+                seal::metrics::record(seal::metrics::Latency::QrScan,
+                                      std::chrono::steady_clock::now() - captureStart);
+                writeQrDiag(seal::console::Tone::Success,
+                            {"event=qr.decode.finish",
+                             "result=ok",
+                             seal::diag::kv("payload_len", result.size()),
+                             seal::diag::kv("frames_decoded", framesDecoded),
+                             seal::diag::kv("duration_ms", seal::diag::elapsedMs(captureStart))});
+                decoded.store(true, std::memory_order_release);
+                return;
+            }
+        });
+
+    while (!decoded.load(std::memory_order_acquire))
     {
         // Enforce capture timeout.
         {
@@ -210,79 +429,34 @@ seal::secure_string<> seal::captureQrFromWebcam()
             }
         }
 
-        // Flush 2 stale frames from the driver's internal queue. VideoCapture
-        // buffers frames; without this, cap.read() returns an old frame and QR
-        // detection lags behind the live camera view by several hundred ms.
-        for (int i = 0; i < 2; ++i)
-            cap.grab();
-        if (!cap.read(frame) || frame.empty())
+        // A fresh Mat per read: the decoder may still hold the previous
+        // frame, and read() would otherwise overwrite it in place.
+        cv::Mat live;
+        if (!cap.read(live) || live.empty())
             break;
 
         // Reject oversized frames from malicious virtual-camera drivers.
-        if (frame.cols > kMaxFrameDimension || frame.rows > kMaxFrameDimension)
+        if (live.cols > kMaxFrameDimension || live.rows > kMaxFrameDimension)
         {
             writeQrDiag(seal::console::Tone::Warning,
                         {"event=qr.frame.skip",
                          "result=skip",
                          "reason=frame_too_large",
-                         seal::diag::kv("width", frame.cols),
-                         seal::diag::kv("height", frame.rows),
+                         seal::diag::kv("width", live.cols),
+                         seal::diag::kv("height", live.rows),
                          seal::diag::kv("limit_px", kMaxFrameDimension)});
             continue;
         }
 
-        // Convert to grayscale and downscale to 480px wide for fast QR detection.
-        // QR finder patterns are high-contrast; colour info adds no value but doubles
-        // the pixel count. Downscaling further cuts detection time ~4x on 1080p frames.
-        cv::Mat gray;
-        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
-        const double scale = std::min(1.0, 480.0 / gray.cols);
-        if (scale < 1.0)
-            cv::resize(gray, gray, cv::Size(), scale, scale, cv::INTER_AREA);
-
-        // Try standard (dark-on-light) QR first, then invert and retry.
-        // Inverted QR codes (white modules on black background) are used by
-        // some generators; bitwise_not flips them to the standard polarity.
-        std::vector<cv::Point> points;
-        std::string data = qrDetector.detectAndDecode(gray, points);
-        if (data.empty())
-        {
-            cv::bitwise_not(gray, gray);
-            points.clear();
-            data = qrDetector.detectAndDecode(gray, points);
-        }
-
-        // Move decoded text into locked secure memory, then wipe the pageable
-        // std::string so the credential doesn't linger on a swappable heap page.
-        if (!data.empty())
-        {
-            // Reject anomalously large payloads. QR v40 max is ~4296 bytes;
-            // anything bigger likely comes from a crafted virtual-camera frame.
-            if (data.size() > kMaxQrDataBytes)
-            {
-                writeQrDiag(seal::console::Tone::Warning,
-                            {"event=qr.decode.skip",
-                             "result=skip",
-                             "reason=payload_too_large",
-                             seal::diag::kv("payload_len", data.size()),
-                             seal::diag::kv("limit_bytes", kMaxQrDataBytes)});
-                SecureZeroMemory(data.data(), data.size());
-                continue;
-            }
-            result.s.assign(data.begin(), data.end());
-            writeQrDiag(seal::console::Tone::Success,
-                        {"event=qr.decode.finish",
-                         "result=ok",
-                         seal::diag::kv("payload_len", result.size())});
-            SecureZeroMemory(data.data(), data.size());
-            break;
-        }
-
-        cv::imshow("webcam", frame);
+        mailbox.post(live);
+        cv::imshow("webcam", live);
         if (cv::waitKey(1) == 27)
             break;  // ESC = cancel
     }
 
+    decoder.request_stop();
+    decoder.join();
+
     cap.release();
     cv::destroyAllWindows();
 
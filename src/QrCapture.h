@@ -32,7 +32,10 @@ namespace seal
  *
  * 1. A DirectShow camera is selected via priority scoring.
  * 2. A live preview window opens while auto-exposure settles.
- * 3. `cv::QRCodeDetector` scans each frame (grayscale + downscale).
+ * 3. The capture thread reads and previews frames at the camera's rate and
+ *    hands the newest one to a decoder thread through a one-slot mailbox.
+ *    The decoder runs `cv::QRCodeDetector` on a coarse-to-fine pyramid and,
+ *    once a candidate is located, only on a padded region around it.
  * 4. On first decode the text is moved into `secure_string` and the
  *    OpenCV `std::string` is wiped with `SecureZeroMemory`.
  * 5. The user can press Escape to cancel at any point.
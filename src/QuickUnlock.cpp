@@ -0,0 +1,145 @@
+#ifdef USE_QT_UI
+
+#include "QuickUnlock.h"
+
+#include <UserConsentVerifierInterop.h>
+#include <winrt/Windows.Foundation.h>
+#include <winrt/Windows.Security.Credentials.UI.h>
+
+#include <string>
+#include <utility>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "windowsapp.lib")
+#endif
+
+namespace seal
+{
+
+namespace wscui = winrt::Windows::Security::Credentials::UI;
+
+QuickUnlock::~QuickUnlock()
+{
+    clear();
+}
+
+void QuickUnlock::park(seal::basic_secure_string<wchar_t>& password,
+                       VaultKeyCache& keys,
+                       std::chrono::minutes lifetime)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    clearLocked();
+    m_Password = std::move(password);
+    seal::Cryptography::cleanseString(password);
+    m_Guard = seal::DPAPIGuard<seal::basic_secure_string<wchar_t>>(&m_Password);
+    keys.moveTo(m_Keys);
+    m_Expiry = std::chrono::steady_clock::now() + lifetime;
+    m_Parked = true;
+}
+
+bool QuickUnlock::restore(seal::basic_secure_string<wchar_t>& password, VaultKeyCache& keys)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_Parked)
+        return false;
+    if (expiredLocked())
+    {
+        clearLocked();
+        return false;
+    }
+    // Dropping the guard decrypts the buffer in place, so the password
+    // leaves here in the clear; the caller wraps it in its own guard.
+    m_Guard = {};
+    seal::Cryptography::cleanseString(password);
+    password = std::move(m_Password);
+    seal::Cryptography::cleanseString(m_Password);
+    m_Keys.moveTo(keys);
+    m_Expiry = {};
+    m_Parked = false;
+    return true;
+}
+
+bool QuickUnlock::parked() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Parked && !expiredLocked();
+}
+
+void QuickUnlock::sweep()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Parked && expiredLocked())
+        clearLocked();
+}
+
+void QuickUnlock::clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    clearLocked();
+}
+
+void QuickUnlock::clearLocked()
+{
+    m_Guard = {};
+    seal::Cryptography::cleanseString(m_Password);
+    m_Keys.clear();
+    m_Expiry = {};
+    m_Parked = false;
+}
+
+bool QuickUnlock::expiredLocked() const
+{
+    return std::chrono::steady_clock::now() >= m_Expiry;
+}
+
+QuickUnlock::Presence QuickUnlock::verifyPresence(HWND owner, std::wstring_view message)
+{
+    // The caller's worker thread has no apartment yet; join the MTA so the
+    // blocking get() below is allowed.
+    bool initialized = false;
+    try
+    {
+        winrt::init_apartment(winrt::apartment_type::multi_threaded);
+        initialized = true;
+    }
+    catch (const winrt::hresult_error&)
+    {
+        // Already in an apartment (RPC_E_CHANGED_MODE); use it as is.
+    }
+
+    Presence result = Presence::Unavailable;
+    try
+    {
+        if (wscui::UserConsentVerifier::CheckAvailabilityAsync().get() ==
+            wscui::UserConsentVerifierAvailability::Available)
+        {
+            // Desktop apps have no CoreWindow, so the prompt is parented
+            // through the interop factory instead of RequestVerificationAsync().
+            auto interop = winrt::get_activation_factory<wscui::UserConsentVerifier,
+                                                         IUserConsentVerifierInterop>();
+            const winrt::hstring text(message);
+            winrt::Windows::Foundation::IAsyncOperation<wscui::UserConsentVerificationResult> op{
+                nullptr};
+            winrt::check_hresult(interop->RequestVerificationForWindowAsync(
+                owner,
+                static_cast<HSTRING>(winrt::get_abi(text)),
+                winrt::guid_of<decltype(op)>(),
+                winrt::put_abi(op)));
+            result = op.get() == wscui::UserConsentVerificationResult::Verified
+                         ? Presence::Verified
+                         : Presence::Declined;
+        }
+    }
+    catch (const winrt::hresult_error&)
+    {
+        result = Presence::Unavailable;
+    }
+
+    if (initialized)
+        winrt::uninit_apartment();
+    return result;
+}
+
+}  // namespace seal
+
+#endif  // USE_QT_UI
@@ -0,0 +1,117 @@
+#pragma once
+
+#ifdef USE_QT_UI
+
+#include <windows.h>
+
+#include <chrono>
+#include <mutex>
+#include <string_view>
+
+#include "Cryptography.h"
+#include "Vault.h"
+
+namespace seal
+{
+
+/**
+ * @class QuickUnlock
+ * @brief Session secrets parked across lockVault() for an opt-in fast re-unlock.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Backend
+ *
+ * Locking normally wipes the master password and every derived vault key,
+ * so the next action costs a password prompt and a full KDF run. With
+ * quick unlock on, lock hands both to park() instead: the password stays in
+ * locked memory under a DPAPIGuard, the keys keep the CryptProtectMemory
+ * (same-process scope) protection they already had in the VaultKeyCache.
+ * After a successful verifyPresence() (Windows Hello), restore() hands
+ * them back and the session resumes with no KDF work at all.
+ *
+ * - The secrets live for the lifetime given to park(). sweep() wipes them
+ *   once it passes; restore() refuses them after that even if nobody swept.
+ * - clear() wipes them at once: cleanup(), session end, or a password
+ *   typed in by hand.
+ * - Nothing is written to disk, so the parked secrets never outlive the
+ *   process or the logon session it runs in.
+ *
+ * All members except verifyPresence() are safe to call from any thread.
+ *
+ * @see VaultKeyCache, DPAPIGuard
+ */
+class QuickUnlock
+{
+public:
+    /// @brief Outcome of verifyPresence().
+    enum class Presence
+    {
+        Verified,    ///< The user confirmed with Windows Hello
+        Declined,    ///< The prompt was cancelled or failed
+        Unavailable  ///< No Windows Hello device or policy; fall back to the password
+    };
+
+    QuickUnlock() = default;
+
+    /// @brief Destructor. Wipes anything still parked.
+    ~QuickUnlock();
+
+    QuickUnlock(const QuickUnlock&) = delete;
+    QuickUnlock& operator=(const QuickUnlock&) = delete;
+
+    /**
+     * @brief Take over the session secrets, replacing anything parked before.
+     * @param password Master password; moved out, so it is empty on return.
+     * @param keys     Session key cache; its keys are moved out.
+     * @param lifetime How long the secrets may be restored.
+     */
+    void park(seal::basic_secure_string<wchar_t>& password,
+              VaultKeyCache& keys,
+              std::chrono::minutes lifetime);
+
+    /**
+     * @brief Hand the parked secrets back.
+     * @param[out] password Receives the master password (unprotected).
+     * @param[out] keys     Receives the parked vault keys.
+     * @return `true` on success. Nothing parked, or a lifetime that has
+     *         passed, leaves both outputs untouched.
+     */
+    [[nodiscard]] bool restore(seal::basic_secure_string<wchar_t>& password, VaultKeyCache& keys);
+
+    /// @brief Whether restore() would currently succeed.
+    [[nodiscard]] bool parked() const;
+
+    /// @brief Wipe the secrets if their lifetime has passed.
+    void sweep();
+
+    /// @brief Wipe the parked secrets now.
+    void clear();
+
+    /**
+     * @brief Ask the user to confirm their presence with Windows Hello.
+     *
+     * Blocks until the prompt is answered. Must not run on the GUI thread:
+     * it waits on a WinRT operation, which is not allowed on an STA.
+     *
+     * @param owner   Window the prompt is parented to.
+     * @param message Text shown in the prompt.
+     * @return Verified, Declined, or Unavailable when Windows Hello is not
+     *         set up (or the API fails).
+     */
+    [[nodiscard]] static Presence verifyPresence(HWND owner, std::wstring_view message);
+
+private:
+    void clearLocked();
+    [[nodiscard]] bool expiredLocked() const;
+
+    mutable std::mutex m_Mutex;
+    seal::basic_secure_string<wchar_t> m_Password;     ///< Parked master password.
+    seal::DPAPIGuard<seal::basic_secure_string<wchar_t>>
+        m_Guard;                                       ///< Keeps m_Password encrypted while parked.
+    VaultKeyCache m_Keys;                              ///< Parked vault keys, DPAPI-protected.
+    std::chrono::steady_clock::time_point m_Expiry{};  ///< restore() refuses them after this.
+    bool m_Parked = false;                             ///< park() ran and nothing wiped it since.
+};
+
+}  // namespace seal
+
+#endif  // USE_QT_UI
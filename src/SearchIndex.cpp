@@ -0,0 +1,122 @@
+#include "SearchIndex.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace seal
+{
+
+void PlatformSearchIndex::clear()
+{
+    m_Texts.clear();
+    m_Postings.clear();
+}
+
+void PlatformSearchIndex::truncate(std::size_t count)
+{
+    while (m_Texts.size() > count)
+    {
+        const auto id = static_cast<uint32_t>(m_Texts.size() - 1);
+        removeGrams(id, m_Texts.back());
+        m_Texts.pop_back();
+    }
+}
+
+void PlatformSearchIndex::assign(uint32_t id, std::string folded)
+{
+    if (id >= m_Texts.size())
+        m_Texts.resize(static_cast<std::size_t>(id) + 1);
+    if (m_Texts[id] == folded)
+        return;
+    removeGrams(id, m_Texts[id]);
+    m_Texts[id] = std::move(folded);
+    addGrams(id, m_Texts[id]);
+}
+
+std::string_view PlatformSearchIndex::text(uint32_t id) const
+{
+    if (id >= m_Texts.size())
+        return {};
+    return m_Texts[id];
+}
+
+void PlatformSearchIndex::find(std::string_view needle, std::vector<uint32_t>& out) const
+{
+    out.clear();
+    if (needle.empty())
+    {
+        for (std::size_t i = 0; i < m_Texts.size(); ++i)
+            out.push_back(static_cast<uint32_t>(i));
+        return;
+    }
+
+    // Pick the rarest n-gram of the needle; a missing one means no match.
+    const std::size_t gramLen = std::min(needle.size(), kMaxGram);
+    const std::vector<uint32_t>* rarest = nullptr;
+    for (std::size_t pos = 0; pos + gramLen <= needle.size(); ++pos)
+    {
+        auto it = m_Postings.find(gramKey(needle.substr(pos, gramLen)));
+        if (it == m_Postings.end())
+            return;
+        if (!rarest || it->second.size() < rarest->size())
+            rarest = &it->second;
+    }
+
+    // A needle no longer than an n-gram is its own posting list.
+    if (needle.size() <= kMaxGram)
+    {
+        out.assign(rarest->begin(), rarest->end());
+        return;
+    }
+    for (uint32_t id : *rarest)
+    {
+        if (m_Texts[id].find(needle) != std::string::npos)
+            out.push_back(id);
+    }
+}
+
+// Key: gram length in the top byte, then up to three bytes of text.
+uint32_t PlatformSearchIndex::gramKey(std::string_view gram)
+{
+    uint32_t key = static_cast<uint32_t>(gram.size()) << 24;
+    for (std::size_t i = 0; i < gram.size(); ++i)
+        key |= static_cast<uint32_t>(static_cast<unsigned char>(gram[i])) << (16 - 8 * i);
+    return key;
+}
+
+void PlatformSearchIndex::addGrams(uint32_t id, std::string_view text)
+{
+    for (std::size_t len = 1; len <= kMaxGram; ++len)
+    {
+        for (std::size_t pos = 0; pos + len <= text.size(); ++pos)
+        {
+            auto& posting = m_Postings[gramKey(text.substr(pos, len))];
+            // Ids mostly arrive in order while building, so this is
+            // usually an append; repeated grams within one text are skipped.
+            auto it = std::lower_bound(posting.begin(), posting.end(), id);
+            if (it == posting.end() || *it != id)
+                posting.insert(it, id);
+        }
+    }
+}
+
+void PlatformSearchIndex::removeGrams(uint32_t id, std::string_view text)
+{
+    for (std::size_t len = 1; len <= kMaxGram; ++len)
+    {
+        for (std::size_t pos = 0; pos + len <= text.size(); ++pos)
+        {
+            auto found = m_Postings.find(gramKey(text.substr(pos, len)));
+            if (found == m_Postings.end())
+                continue;
+            auto& posting = found->second;
+            auto it = std::lower_bound(posting.begin(), posting.end(), id);
+            if (it != posting.end() && *it == id)
+                posting.erase(it);
+            if (posting.empty())
+                m_Postings.erase(found);
+        }
+    }
+}
+
+}  // namespace seal
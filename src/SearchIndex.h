@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace seal
+{
+
+/**
+ * @class PlatformSearchIndex
+ * @brief In-memory n-gram index for substring search over platform names.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup VaultModel
+ *
+ * Every entry is indexed under each of its 1-, 2- and 3-byte substrings.
+ * find() answers a query from the posting list of its rarest n-gram and
+ * only checks those candidates against the full needle, so a keystroke
+ * costs time proportional to the matches rather than to the vault size,
+ * and allocates nothing once the output vector has grown.
+ *
+ * The index is byte-oriented: callers case-fold text (and the needle)
+ * before handing it over. For UTF-8 input a byte substring match is
+ * exactly a character substring match.
+ *
+ * Entries are addressed by dense ids (the record index); assign() keeps
+ * posting lists sorted, so results come back in ascending id order.
+ *
+ * @see VaultListModel
+ */
+class PlatformSearchIndex
+{
+public:
+    /// @brief Drop every entry.
+    void clear();
+
+    /// @brief Number of entry slots (highest assigned id + 1).
+    [[nodiscard]] std::size_t size() const { return m_Texts.size(); }
+
+    /// @brief Drop the entries with id >= @p count.
+    void truncate(std::size_t count);
+
+    /**
+     * @brief Index (or re-index) entry @p id under @p folded.
+     * @param id     Entry id; slots below it that were never assigned stay empty.
+     * @param folded Case-folded entry text.
+     */
+    void assign(uint32_t id, std::string folded);
+
+    /// @brief Folded text of entry @p id (empty if unassigned).
+    [[nodiscard]] std::string_view text(uint32_t id) const;
+
+    /**
+     * @brief Collect the ids of all entries containing @p needle.
+     * @param needle Case-folded query; an empty needle matches every entry.
+     * @param[out] out Receives matching ids in ascending order (cleared first).
+     */
+    void find(std::string_view needle, std::vector<uint32_t>& out) const;
+
+private:
+    static constexpr std::size_t kMaxGram = 3;
+
+    static uint32_t gramKey(std::string_view gram);
+    void addGrams(uint32_t id, std::string_view text);
+    void removeGrams(uint32_t id, std::string_view text);
+
+    std::vector<std::string> m_Texts;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_Postings;
+};
+
+}  // namespace seal
@@ -103,7 +103,8 @@ struct basic_secure_string
     {
         if (!s.empty())
         {
-            // Restore RW in case the buffer was marked PAGE_NOACCESS.
+            // Restore RW in case the buffer was marked PAGE_NOACCESS
+            // (no syscall otherwise: the header tracks the state).
             seal::protect_readwrite(s.data());
             // Wipe in bytes - sizeof(CharT) may be 2 (wchar_t) or 4 (char32_t).
             SecureZeroMemory(s.data(), s.size() * sizeof(CharT));
@@ -143,41 +144,40 @@ using secure_string = basic_secure_string<char, A>;
 
 /**
  * @struct RWGuard
- * @brief RAII guard that temporarily sets a locked payload to PAGE_READWRITE.
+ * @brief RAII scope that holds a locked payload at PAGE_READWRITE.
  * @ingroup Memory
  * @tparam T Element type of the guarded allocation.
  *
- * On construction, flips the payload protection to PAGE_READWRITE.
- * On destruction, restores the original protection (typically PAGE_NOACCESS).
+ * Scopes are reference-counted in the allocation's header: the first
+ * scope to open on a PAGE_NOACCESS payload makes it READWRITE, the last
+ * to close puts it back, and every scope in between, nested or not,
+ * costs an uncontended lock and no syscall. A payload that already
+ * rests READWRITE (the common case) is never re-protected. Scopes on the
+ * same allocation may be opened from several threads at once.
  * Non-copyable and non-movable.
  *
- * @pre The pointer must have been returned by locked_allocator::allocate().
+ * @pre The pointer must have been returned by locked_allocator::allocate(),
+ *      and the allocation must outlive the guard.
+ * @see RWGuardSet, protect_noaccess
  */
 template <class T>
 struct RWGuard
 {
-    const T* p{};
-    DWORD oldProt{};
-    bool changed{false};
-    explicit RWGuard(const T* ptr)
-        : p(ptr)
+    locked_header* hdr{};
+    explicit RWGuard(const T* p)
     {
-        if (!p)
+        // Slab payloads share their pages and are never made NOACCESS.
+        if (!p || locked_slab::owns(p))
             return;
-        // Flip the payload span to PAGE_READWRITE, saving the previous
-        // protection so we can restore it when the guard goes out of scope.
-        auto* hdr = header_from_payload(p);
-        changed = !!VirtualProtect(
-            const_cast<std::remove_cv_t<T>*>(p), hdr->payloadSpan, PAGE_READWRITE, &oldProt);
+        hdr = header_from_payload(p);
+        open_rw_scope(hdr);
     }
     ~RWGuard()
     {
-        if (!p || !changed)
-            return;
-        // Restore the original protection (typically PAGE_NOACCESS).
-        auto* hdr = header_from_payload(p);
-        DWORD tmp;
-        (void)VirtualProtect(const_cast<std::remove_cv_t<T>*>(p), hdr->payloadSpan, oldProt, &tmp);
+        // The last scope out restores the resting protection, which may have
+        // been changed with protect_noaccess() / protect_readwrite() meanwhile.
+        if (hdr)
+            close_rw_scope(hdr);
     }
     RWGuard(const RWGuard&) = delete;
     RWGuard& operator=(const RWGuard&) = delete;
@@ -185,6 +185,69 @@ struct RWGuard
     RWGuard& operator=(RWGuard&&) = delete;
 };
 
+/**
+ * @class RWGuardSet
+ * @brief One RWGuard scope over a whole group of allocations.
+ * @ingroup Memory
+ *
+ * For loops that touch many secrets in a row (printing a batch of
+ * decrypted triples, say): add() every string first, do the work, and
+ * let the set close. Each distinct allocation gets exactly one scope
+ * however often it is added; slab payloads and empty strings are
+ * skipped, so the set usually ends up with little to do. Allocations
+ * are separate reservations between their own guard pages, so their
+ * page runs cannot be merged into one VirtualProtect; what the set saves
+ * is every toggle beyond the first open and last close per allocation.
+ *
+ * Scopes close in reverse order on close() or destruction.
+ *
+ * @pre Every added allocation must outlive the set's scopes: close() the
+ *      set before cleansing or growing the strings it covers.
+ */
+class RWGuardSet
+{
+public:
+    RWGuardSet() = default;
+    ~RWGuardSet() { close(); }
+    RWGuardSet(const RWGuardSet&) = delete;
+    RWGuardSet& operator=(const RWGuardSet&) = delete;
+
+    /// @brief Open a scope on @p p unless the set already holds one.
+    template <class T>
+    void add(const T* p)
+    {
+        if (!p || locked_slab::owns(p))
+            return;
+        locked_header* hdr = header_from_payload(p);
+        for (const locked_header* h : m_Open)
+            if (h == hdr)
+                return;
+        m_Open.push_back(hdr);
+        open_rw_scope(hdr);
+    }
+
+    /// @brief Open a scope on the buffer of @p s.
+    template <class CharT, class A>
+    void add(const basic_secure_string<CharT, A>& s)
+    {
+        add(s.s.data());
+    }
+
+    /// @brief Close every scope, most recent first. Idempotent.
+    void close() noexcept
+    {
+        for (auto it = m_Open.rbegin(); it != m_Open.rend(); ++it)
+            close_rw_scope(*it);
+        m_Open.clear();
+    }
+
+    /// @brief Number of distinct allocations held open.
+    size_t size() const noexcept { return m_Open.size(); }
+
+private:
+    std::vector<locked_header*> m_Open;
+};
+
 /**
  * @brief Move-only holder for three wide secure strings with tuple-like access.
  * @author Alex (https://github.com/lextpf)
@@ -1,8 +1,27 @@
 #include "Utils.h"
 
-#include <openssl/evp.h>
-
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SEAL_CODEC_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define SEAL_CODEC_X86 0
+#endif
+
+// MSVC compiles intrinsics of any ISA in any function; GCC and Clang need
+// the kernels marked for the ISA they use.
+#if defined(__GNUC__) || defined(__clang__)
+#define SEAL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SEAL_TARGET(isa)
+#endif
 
 namespace seal::utils
 {
@@ -36,7 +55,7 @@ bool endsWithCi(const std::string& s, const char* suf)
     return ends_with_ci(std::string_view{s}, std::string_view{suf});
 }
 
-std::string stripSpaces(const std::string& s)
+std::string stripSpaces(std::string_view s)
 {
     std::string r;
     r.reserve(s.size());
@@ -46,48 +65,6 @@ std::string stripSpaces(const std::string& s)
     return r;
 }
 
-std::vector<std::string> extractHexTokens(const std::string& raw)
-{
-    std::vector<std::string> tokens;
-    std::string cur;
-    for (unsigned char c : raw)
-    {
-        if (std::isspace(c))
-        {
-            if (!cur.empty())
-            {
-                tokens.push_back(cur);
-                cur.clear();
-            }
-        }
-        else
-        {
-            cur.push_back((char)c);
-        }
-    }
-    if (!cur.empty())
-        tokens.push_back(cur);
-
-    // Minimum hex length: a valid ciphertext blob must contain at least
-    // salt + IV + GCM tag (all hex-encoded, so *2). Anything shorter cannot
-    // be a real AES-256-GCM ciphertext and is filtered out to avoid false matches.
-    constexpr size_t min_hex_chars = (cfg::SALT_LEN + cfg::IV_LEN + cfg::TAG_LEN) * 2;
-    std::vector<std::string> good;
-    for (auto& t : tokens)
-    {
-        // Must be even length (each byte = 2 hex chars) and at least as long
-        // as the mandatory header fields, and consist entirely of hex digits.
-        if ((t.size() % 2) == 0 && t.size() >= min_hex_chars)
-        {
-            bool allhex = std::all_of(
-                t.begin(), t.end(), [](unsigned char c) { return std::isxdigit(c) != 0; });
-            if (allhex)
-                good.push_back(t);
-        }
-    }
-    return good;
-}
-
 std::string add_ext(const std::string& s, std::string_view ext)
 {
     std::string result;
@@ -166,41 +143,657 @@ std::string secureWideToUtf8(
     return out;
 }
 
+// Hex and Base64 codecs. Each has a scalar loop plus SSE4.1 and AVX2
+// kernels that handle whole blocks and leave the tail to the scalar loop.
+// The widest ISA the CPU (and the OS, for the AVX state) supports is
+// picked once per process.
+namespace
+{
+enum class CodecIsa
+{
+    Scalar,
+    Sse41,
+    Avx2
+};
+
+CodecIsa detectCodecIsa() noexcept
+{
+#if SEAL_CODEC_X86 && defined(_MSC_VER)
+    int regs[4]{};
+    __cpuid(regs, 0);
+    const int maxLeaf = regs[0];
+    __cpuid(regs, 1);
+    const bool sse41 = (regs[2] & (1 << 19)) != 0;
+    const bool osAvx = (regs[2] & (1 << 27)) != 0 && (regs[2] & (1 << 28)) != 0 &&
+                       (_xgetbv(0) & 0x6) == 0x6;  // XMM and YMM state enabled
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osAvx)
+    {
+        __cpuidex(regs, 7, 0);
+        avx2 = (regs[1] & (1 << 5)) != 0;
+    }
+    return avx2 ? CodecIsa::Avx2 : sse41 ? CodecIsa::Sse41 : CodecIsa::Scalar;
+#elif SEAL_CODEC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return CodecIsa::Avx2;
+    return __builtin_cpu_supports("sse4.1") ? CodecIsa::Sse41 : CodecIsa::Scalar;
+#else
+    return CodecIsa::Scalar;
+#endif
+}
+
+CodecIsa codecIsa() noexcept
+{
+    static const CodecIsa isa = detectCodecIsa();
+    return isa;
+}
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+constexpr char kBase64Digits[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Character -> value tables; 0xFF marks an invalid character.
+constexpr auto kHexValues = []
+{
+    std::array<unsigned char, 256> t{};
+    t.fill(0xFF);
+    for (int i = 0; i < 16; ++i)
+    {
+        t[static_cast<unsigned char>(kHexDigits[i])] = static_cast<unsigned char>(i);
+        t[static_cast<unsigned char>(kHexDigits[i] & ~0x20)] = static_cast<unsigned char>(i);
+    }
+    for (int i = 0; i < 10; ++i)
+        t['0' + i] = static_cast<unsigned char>(i);
+    return t;
+}();
+
+constexpr auto kBase64Values = []
+{
+    std::array<unsigned char, 256> t{};
+    t.fill(0xFF);
+    for (int i = 0; i < 64; ++i)
+        t[static_cast<unsigned char>(kBase64Digits[i])] = static_cast<unsigned char>(i);
+    return t;
+}();
+
+#if SEAL_CODEC_X86
+// 16 bytes -> 32 hex characters per step. Returns the bytes consumed.
+SEAL_TARGET("sse4.1") size_t hexEncodeSse41(const unsigned char* in, size_t n, char* out)
+{
+    const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexDigits));
+    const __m128i low4 = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), low4));
+        const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, low4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+// 32 bytes -> 64 hex characters per step.
+SEAL_TARGET("avx2") size_t hexEncodeAvx2(const unsigned char* in, size_t n, char* out)
+{
+    const __m256i lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexDigits)));
+    const __m256i low4 = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i hi =
+            _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+        const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low4));
+        // unpack works per 128-bit lane: a = bytes 0-7 | 16-23, b = 8-15 | 24-31.
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),
+                            _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32),
+                            _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+}
+
+// Map 16 hex characters to nibbles; @p valid gets 0xFF per valid character.
+SEAL_TARGET("sse4.1") inline __m128i hexNibbles(__m128i c, __m128i& valid)
+{
+    const __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    const __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i alpha = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    valid = _mm_or_si128(digit, alpha);
+    return _mm_or_si128(_mm_and_si128(digit, d),
+                        _mm_and_si128(alpha, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+SEAL_TARGET("avx2") inline __m256i hexNibbles(__m256i c, __m256i& valid)
+{
+    const __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const __m256i digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    const __m256i l =
+        _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+    valid = _mm256_or_si256(digit, alpha);
+    return _mm256_or_si256(_mm256_and_si256(digit, d),
+                           _mm256_and_si256(alpha, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+}
+
+// 32 hex characters -> 16 bytes per step. Returns the characters consumed,
+// stopping early at a block with an invalid character (the scalar loop
+// then reports it).
+SEAL_TARGET("sse4.1") size_t hexDecodeSse41(const char* in, size_t n, unsigned char* out)
+{
+    // maddubs weights: high nibble * 16 + low nibble.
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m128i okA, okB;
+        const __m128i a =
+            hexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), okA);
+        const __m128i b =
+            hexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), okB);
+        if (_mm_movemask_epi8(_mm_and_si128(okA, okB)) != 0xFFFF)
+            break;
+        const __m128i bytes =
+            _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), bytes);
+    }
+    return i;
+}
+
+// 64 hex characters -> 32 bytes per step.
+SEAL_TARGET("avx2") size_t hexDecodeAvx2(const char* in, size_t n, unsigned char* out)
+{
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        __m256i okA, okB;
+        const __m256i a =
+            hexNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), okA);
+        const __m256i b =
+            hexNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32)), okB);
+        if (_mm256_movemask_epi8(_mm256_and_si256(okA, okB)) != -1)
+            break;
+        // packus works per lane; put the 64-bit quarters back in order.
+        const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights),
+                                                   _mm256_maddubs_epi16(b, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return i;
+}
+
+// Base64 kernels follow Muła and Lemire, "Faster Base64 Encoding and
+// Decoding Using AVX2 Instructions" (2018): split 3 bytes into 4 sextets
+// with multiplies, then map sextets to characters (and back) with pshufb
+// lookups on the high nibble.
+
+// 16 sextets (one per byte) -> their Base64 characters.
+SEAL_TARGET("sse4.1") inline __m128i base64Chars(__m128i sextets)
+{
+    __m128i shift = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+    shift = _mm_or_si128(shift, _mm_and_si128(less, _mm_set1_epi8(13)));
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, shift), sextets);
+}
+
+SEAL_TARGET("avx2") inline __m256i base64Chars(__m256i sextets)
+{
+    __m256i shift = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+    shift = _mm256_or_si256(shift, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const __m256i offsets = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, shift), sextets);
+}
+
+// 12 bytes -> 16 characters per step; each load reads 16 bytes.
+SEAL_TARGET("sse4.1") size_t base64EncodeSse41(const unsigned char* in, size_t n, char* out)
+{
+    const __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t i = 0, o = 0;
+    for (; i + 16 <= n; i += 12, o += 16)
+    {
+        const __m128i v = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), spread);
+        const __m128i ac =
+            _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0FC0FC00)),
+                            _mm_set1_epi32(0x04000040));
+        const __m128i bd =
+            _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003F03F0)),
+                            _mm_set1_epi32(0x01000010));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), base64Chars(_mm_or_si128(ac, bd)));
+    }
+    return i;
+}
+
+// 24 bytes -> 32 characters per step, 12 bytes per lane.
+SEAL_TARGET("avx2") size_t base64EncodeAvx2(const unsigned char* in, size_t n, char* out)
+{
+    const __m256i spread = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    size_t i = 0, o = 0;
+    for (; i + 28 <= n; i += 24, o += 32)
+    {
+        const __m256i raw = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)),
+            1);
+        const __m256i v = _mm256_shuffle_epi8(raw, spread);
+        const __m256i ac =
+            _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)),
+                               _mm256_set1_epi32(0x04000040));
+        const __m256i bd =
+            _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)),
+                               _mm256_set1_epi32(0x01000010));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + o),
+                            base64Chars(_mm256_or_si256(ac, bd)));
+    }
+    return i;
+}
+
+// 16 characters -> 12 bytes per step, storing 16 (so @p outRoom must allow
+// it). Stops at the first block holding anything but the 64 digits, '='
+// included; the scalar loop finishes from there.
+SEAL_TARGET("sse4.1") size_t base64DecodeSse41(const char* in,
+                                               size_t n,
+                                               unsigned char* out,
+                                               size_t outRoom)
+{
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll =
+        _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2F = _mm_set1_epi8(0x2F);
+    const __m128i gather = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0, o = 0;
+    for (; i + 16 <= n && o + 16 <= outRoom; i += 16, o += 12)
+    {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(c, 4), mask2F);
+        const __m128i lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(c, mask2F));
+        const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        if (!_mm_testz_si128(lo, hi))
+            break;
+        const __m128i roll =
+            _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(c, mask2F), hiNibbles));
+        c = _mm_add_epi8(c, roll);  // now sextets
+        const __m128i ab = _mm_maddubs_epi16(c, _mm_set1_epi32(0x01400140));
+        const __m128i abc = _mm_madd_epi16(ab, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_shuffle_epi8(abc, gather));
+    }
+    return i;
+}
+
+// 32 characters -> 24 bytes per step, storing 32.
+SEAL_TARGET("avx2") size_t base64DecodeAvx2(const char* in,
+                                            size_t n,
+                                            unsigned char* out,
+                                            size_t outRoom)
+{
+    const __m256i lutLo = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B,
+        0x1A));
+    const __m256i lutHi = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10));
+    const __m256i lutRoll = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+    const __m256i gather = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    size_t i = 0, o = 0;
+    for (; i + 32 <= n && o + 32 <= outRoom; i += 32, o += 24)
+    {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(c, 4), mask2F);
+        const __m256i lo = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(c, mask2F));
+        const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        if (!_mm256_testz_si256(lo, hi))
+            break;
+        const __m256i roll = _mm256_shuffle_epi8(
+            lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(c, mask2F), hiNibbles));
+        c = _mm256_add_epi8(c, roll);
+        const __m256i ab = _mm256_maddubs_epi16(c, _mm256_set1_epi32(0x01400140));
+        const __m256i abc = _mm256_madd_epi16(ab, _mm256_set1_epi32(0x00011000));
+        const __m256i packed =
+            _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(abc, gather), compact);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + o), packed);
+    }
+    return i;
+}
+#endif  // SEAL_CODEC_X86
+
+bool isAsciiSpace(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+}  // namespace
+
+void hexEncode(std::span<const unsigned char> bytes, std::span<char> out) noexcept
+{
+    const unsigned char* in = bytes.data();
+    const size_t n = bytes.size();
+    char* dst = out.data();
+    size_t i = 0;
+#if SEAL_CODEC_X86
+    switch (codecIsa())
+    {
+        case CodecIsa::Avx2:
+            i = hexEncodeAvx2(in, n, dst);
+            break;
+        case CodecIsa::Sse41:
+            i = hexEncodeSse41(in, n, dst);
+            break;
+        default:
+            break;
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        dst[2 * i] = kHexDigits[in[i] >> 4];
+        dst[2 * i + 1] = kHexDigits[in[i] & 0x0F];
+    }
+}
+
+bool hexDecode(std::string_view hex, std::span<unsigned char> out) noexcept
+{
+    if (hex.size() & 1)
+        return false;
+    const char* in = hex.data();
+    const size_t n = hex.size();
+    unsigned char* dst = out.data();
+    size_t i = 0;
+#if SEAL_CODEC_X86
+    switch (codecIsa())
+    {
+        case CodecIsa::Avx2:
+            i = hexDecodeAvx2(in, n, dst);
+            break;
+        case CodecIsa::Sse41:
+            i = hexDecodeSse41(in, n, dst);
+            break;
+        default:
+            break;
+    }
+#endif
+    for (; i < n; i += 2)
+    {
+        const unsigned hi = kHexValues[static_cast<unsigned char>(in[i])];
+        const unsigned lo = kHexValues[static_cast<unsigned char>(in[i + 1])];
+        if ((hi | lo) > 0x0F)
+            return false;
+        dst[i / 2] = static_cast<unsigned char>((hi << 4) | lo);
+    }
+    return true;
+}
+
+size_t base64Encode(std::span<const unsigned char> bytes, std::span<char> out) noexcept
+{
+    const unsigned char* in = bytes.data();
+    const size_t n = bytes.size();
+    char* dst = out.data();
+    size_t i = 0;
+#if SEAL_CODEC_X86
+    switch (codecIsa())
+    {
+        case CodecIsa::Avx2:
+            i = base64EncodeAvx2(in, n, dst);
+            break;
+        case CodecIsa::Sse41:
+            i = base64EncodeSse41(in, n, dst);
+            break;
+        default:
+            break;
+    }
+#endif
+    size_t o = i / 3 * 4;
+    for (; i + 3 <= n; i += 3, o += 4)
+    {
+        const uint32_t v = (uint32_t{in[i]} << 16) | (uint32_t{in[i + 1]} << 8) | in[i + 2];
+        dst[o] = kBase64Digits[v >> 18];
+        dst[o + 1] = kBase64Digits[(v >> 12) & 0x3F];
+        dst[o + 2] = kBase64Digits[(v >> 6) & 0x3F];
+        dst[o + 3] = kBase64Digits[v & 0x3F];
+    }
+    if (i < n)
+    {
+        const bool two = n - i == 2;
+        const uint32_t v = (uint32_t{in[i]} << 16) | (two ? uint32_t{in[i + 1]} << 8 : 0);
+        dst[o] = kBase64Digits[v >> 18];
+        dst[o + 1] = kBase64Digits[(v >> 12) & 0x3F];
+        dst[o + 2] = two ? kBase64Digits[(v >> 6) & 0x3F] : '=';
+        dst[o + 3] = '=';
+        o += 4;
+    }
+    return o;
+}
+
+std::optional<size_t> base64Decode(std::string_view b64, std::span<unsigned char> out) noexcept
+{
+    while (!b64.empty() && isAsciiSpace(b64.front()))
+        b64.remove_prefix(1);
+    while (!b64.empty() && isAsciiSpace(b64.back()))
+        b64.remove_suffix(1);
+    if (b64.size() % 4 != 0)
+        return std::nullopt;
+    if (b64.empty())
+        return 0;
+
+    // The last quantum may carry padding; everything before it is digits.
+    const char* in = b64.data();
+    const size_t body = b64.size() - 4;
+    unsigned char* dst = out.data();
+    size_t i = 0;
+#if SEAL_CODEC_X86
+    switch (codecIsa())
+    {
+        case CodecIsa::Avx2:
+            i = base64DecodeAvx2(in, body, dst, out.size());
+            break;
+        case CodecIsa::Sse41:
+            i = base64DecodeSse41(in, body, dst, out.size());
+            break;
+        default:
+            break;
+    }
+#endif
+    size_t o = i / 4 * 3;
+    for (; i < body; i += 4, o += 3)
+    {
+        const unsigned a = kBase64Values[static_cast<unsigned char>(in[i])];
+        const unsigned b = kBase64Values[static_cast<unsigned char>(in[i + 1])];
+        const unsigned c = kBase64Values[static_cast<unsigned char>(in[i + 2])];
+        const unsigned d = kBase64Values[static_cast<unsigned char>(in[i + 3])];
+        if ((a | b | c | d) > 0x3F)
+            return std::nullopt;
+        const uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+        dst[o] = static_cast<unsigned char>(v >> 16);
+        dst[o + 1] = static_cast<unsigned char>(v >> 8);
+        dst[o + 2] = static_cast<unsigned char>(v);
+    }
+
+    const size_t pad = (in[body + 3] == '=') + (in[body + 3] == '=' && in[body + 2] == '=');
+    const unsigned a = kBase64Values[static_cast<unsigned char>(in[body])];
+    const unsigned b = kBase64Values[static_cast<unsigned char>(in[body + 1])];
+    const unsigned c = pad == 2 ? 0 : kBase64Values[static_cast<unsigned char>(in[body + 2])];
+    const unsigned d = pad >= 1 ? 0 : kBase64Values[static_cast<unsigned char>(in[body + 3])];
+    if ((a | b | c | d) > 0x3F)
+        return std::nullopt;
+    const uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+    dst[o++] = static_cast<unsigned char>(v >> 16);
+    if (pad < 2)
+        dst[o++] = static_cast<unsigned char>(v >> 8);
+    if (pad < 1)
+        dst[o++] = static_cast<unsigned char>(v);
+    return o;
+}
+
 std::string toBase64(std::span<const unsigned char> data)
 {
-    if (data.empty())
-        return {};
-    // EVP_EncodeBlock output size: 4 * ceil(n/3) + 1 (null terminator)
-    size_t outLen = 4 * ((data.size() + 2) / 3) + 1;
-    std::string out(outLen, '\0');
-    int written = EVP_EncodeBlock(
-        reinterpret_cast<unsigned char*>(out.data()), data.data(), static_cast<int>(data.size()));
-    out.resize(static_cast<size_t>(written));
+    std::string out(base64EncodedSize(data.size()), '\0');
+    base64Encode(data, out);
     return out;
 }
 
 std::vector<unsigned char> fromBase64(const std::string& b64)
 {
-    if (b64.empty())
-        return {};
-    // EVP_DecodeBlock output size: 3 * ceil(n/4)
-    size_t maxOut = 3 * ((b64.size() + 3) / 4);
-    std::vector<unsigned char> out(maxOut);
-    int written = EVP_DecodeBlock(out.data(),
-                                  reinterpret_cast<const unsigned char*>(b64.data()),
-                                  static_cast<int>(b64.size()));
-    if (written < 0)
+    std::vector<unsigned char> out(3 * (b64.size() / 4));
+    const auto written = base64Decode(b64, out);
+    if (!written)
         return {};
-    // EVP_DecodeBlock doesn't account for padding - trim trailing zeros from '=' padding
-    size_t pad = 0;
-    if (b64.size() >= 2 && b64[b64.size() - 1] == '=')
-        ++pad;
-    if (b64.size() >= 2 && b64[b64.size() - 2] == '=')
-        ++pad;
-    out.resize(static_cast<size_t>(written) - pad);
+    out.resize(*written);
     return out;
 }
 
+// Hex token scanner. Each block of input is classified into two bitmasks,
+// whitespace and not-a-hex-digit, and tokens are cut on the whitespace
+// bits; a run of hex digits (the bulk of a pasted ciphertext) costs one
+// test per block.
+namespace
+{
+struct ByteClasses
+{
+    uint32_t space;   // bit i: byte i is ASCII whitespace
+    uint32_t nonHex;  // bit i: byte i is not a hex digit
+};
+
+ByteClasses classifyScalar(const char* in, size_t n) noexcept
+{
+    ByteClasses m{0, 0};
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (isAsciiSpace(in[i]))
+            m.space |= uint32_t{1} << i;
+        if (kHexValues[static_cast<unsigned char>(in[i])] > 0x0F)
+            m.nonHex |= uint32_t{1} << i;
+    }
+    return m;
+}
+
+#if SEAL_CODEC_X86
+SEAL_TARGET("sse4.1") ByteClasses classifySse41(const char* in) noexcept
+{
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    // Whitespace is ' ' or '\t'..'\r'.
+    const __m128i t = _mm_sub_epi8(c, _mm_set1_epi8('\t'));
+    const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(4)), t));
+    __m128i valid;
+    (void)hexNibbles(c, valid);
+    return {static_cast<uint32_t>(_mm_movemask_epi8(space)),
+            static_cast<uint32_t>(_mm_movemask_epi8(valid)) ^ 0xFFFFu};
+}
+
+SEAL_TARGET("avx2") ByteClasses classifyAvx2(const char* in) noexcept
+{
+    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    const __m256i t = _mm256_sub_epi8(c, _mm256_set1_epi8('\t'));
+    const __m256i space =
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')),
+                        _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(4)), t));
+    __m256i valid;
+    (void)hexNibbles(c, valid);
+    return {static_cast<uint32_t>(_mm256_movemask_epi8(space)),
+            ~static_cast<uint32_t>(_mm256_movemask_epi8(valid))};
+}
+#endif  // SEAL_CODEC_X86
+}  // namespace
+
+std::vector<std::string_view> findHexTokens(std::string_view raw)
+{
+    // Minimum hex length: a valid ciphertext blob must contain at least
+    // salt + IV + GCM tag (all hex-encoded, so *2). Anything shorter cannot
+    // be a real AES-256-GCM ciphertext and is filtered out to avoid false matches.
+    constexpr size_t min_hex_chars = (cfg::SALT_LEN + cfg::IV_LEN + cfg::TAG_LEN) * 2;
+
+    const char* in = raw.data();
+    const size_t n = raw.size();
+#if SEAL_CODEC_X86
+    const CodecIsa isa = codecIsa();
+    const size_t width = isa == CodecIsa::Sse41 ? 16 : 32;
+#else
+    const size_t width = 32;
+#endif
+    auto classify = [&](size_t base, size_t len)
+    {
+#if SEAL_CODEC_X86
+        if (len == width && isa == CodecIsa::Avx2)
+            return classifyAvx2(in + base);
+        if (len == width && isa == CodecIsa::Sse41)
+            return classifySse41(in + base);
+#endif
+        return classifyScalar(in + base, len);
+    };
+
+    std::vector<std::string_view> good;
+    size_t start = 0;
+    bool inToken = false;
+    bool allHex = true;
+    // Must be even length (each byte = 2 hex chars), at least as long as
+    // the mandatory header fields, and consist entirely of hex digits.
+    auto finish = [&](size_t end)
+    {
+        const size_t len = end - start;
+        if (allHex && (len % 2) == 0 && len >= min_hex_chars)
+            good.emplace_back(in + start, len);
+        inToken = false;
+    };
+
+    for (size_t base = 0; base < n; base += width)
+    {
+        const size_t len = std::min(width, n - base);
+        const ByteClasses m = classify(base, len);
+        const uint32_t lanes = len == 32 ? ~uint32_t{0} : (uint32_t{1} << len) - 1;
+        size_t p = 0;
+        while (p < len)
+        {
+            if (!inToken)
+            {
+                const uint32_t text = (~m.space & lanes) >> p;
+                if (text == 0)
+                    break;
+                p += std::countr_zero(text);
+                start = base + p;
+                inToken = true;
+                allHex = true;
+                continue;
+            }
+            const uint32_t spaces = m.space >> p;
+            const size_t end = spaces ? p + std::countr_zero(spaces) : len;
+            const uint32_t run = end - p == 32 ? ~uint32_t{0} : (uint32_t{1} << (end - p)) - 1;
+            if ((m.nonHex >> p) & run)
+                allHex = false;
+            p = end;
+            if (end < len)
+                finish(base + end);
+        }
+    }
+    if (inToken)
+        finish(n);
+    return good;
+}
+
+std::vector<std::string> extractHexTokens(const std::string& raw)
+{
+    const auto tokens = findHexTokens(raw);
+    return std::vector<std::string>(tokens.begin(), tokens.end());
+}
+
 bool isBase64(const std::string& s)
 {
     if (s.empty() || s.size() < 4)
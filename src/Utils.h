@@ -6,6 +6,9 @@
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <optional>
+#include <span>
+#include <string_view>
 
 namespace seal::utils
 {
@@ -72,9 +75,37 @@ template <class CharT>
  */
 [[nodiscard]] bool endsWithCi(const std::string& s, const char* suf);
 
+/**
+ * @brief Encode bytes as lowercase hex into a pre-sized buffer.
+ * @ingroup Utilities
+ *
+ * Runtime kernel behind to_hex(): AVX2 or SSE4.1 when the CPU has them
+ * (checked once), scalar otherwise.
+ *
+ * @param bytes Bytes to encode.
+ * @param out   At least `2 * bytes.size()` characters.
+ */
+void hexEncode(std::span<const unsigned char> bytes, std::span<char> out) noexcept;
+
+/**
+ * @brief Validate and decode hex into a pre-sized buffer in a single pass.
+ * @ingroup Utilities
+ *
+ * Runtime kernel behind from_hex(), dispatched like hexEncode().
+ *
+ * @param hex Hex text, either case.
+ * @param out At least `hex.size() / 2` bytes; contents unspecified on failure.
+ * @return `false` on odd length or a non-hex character.
+ */
+[[nodiscard]] bool hexDecode(std::string_view hex, std::span<unsigned char> out) noexcept;
+
 /**
  * @brief Encode a byte range as lowercase hex.
  * @ingroup Utilities
+ *
+ * Contiguous ranges go through hexEncode() at run time; the scalar loop
+ * remains for other ranges and for constant evaluation.
+ *
  * @tparam R Input range of byte-like elements.
  * @param range Bytes to encode.
  * @return Lowercase hex string (two characters per byte).
@@ -84,6 +115,18 @@ template <std::ranges::input_range R>
 [[nodiscard]] constexpr std::string to_hex(R&& range)
 {
     std::string out;
+    if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R>)
+    {
+        if !consteval
+        {
+            const auto n = static_cast<size_t>(std::ranges::size(range));
+            out.resize(2 * n);
+            hexEncode({reinterpret_cast<const unsigned char*>(std::ranges::data(range)), n}, out);
+            return out;
+        }
+    }
+    if constexpr (std::ranges::sized_range<R>)
+        out.reserve(2 * static_cast<size_t>(std::ranges::size(range)));
     constexpr auto hex_str = "0123456789abcdef";
     for (auto&& byte : range)
     {
@@ -129,16 +172,32 @@ template <std::ranges::input_range R>
 /**
  * @brief Decode hex into a contiguous container.
  * @ingroup Utilities
+ *
+ * At run time the container is sized once and filled by hexDecode();
+ * constant evaluation uses from_hex_sv().
+ *
  * @tparam Cont Contiguous byte-like container (e.g. `std::vector<unsigned char>`).
  * @param hex Hex-encoded input.
- * @param out Destination container (cleared and resized).
- * @return `true` on success, `false` on invalid hex.
+ * @param out Destination container (cleared and resized; empty on failure).
+ * @return `true` on success, `false` on empty or invalid hex.
  */
 template <std::ranges::contiguous_range Cont>
     requires byte_like<std::ranges::range_value_t<Cont>>
 [[nodiscard]] constexpr bool from_hex(std::string_view hex, Cont& out)
 {
     out.clear();
+    if !consteval
+    {
+        if (hex.empty())
+            return false;
+        out.resize(hex.size() / 2);
+        if (!hexDecode(hex, {reinterpret_cast<unsigned char*>(std::ranges::data(out)), out.size()}))
+        {
+            out.clear();
+            return false;
+        }
+        return true;
+    }
     out.reserve(hex.size() / 2);
     return from_hex_sv(hex, std::back_inserter(out));
 }
@@ -149,17 +208,31 @@ template <std::ranges::contiguous_range Cont>
  * @param s Input string.
  * @return A copy with all whitespace removed.
  */
-[[nodiscard]] std::string stripSpaces(const std::string& s);
+[[nodiscard]] std::string stripSpaces(std::string_view s);
+
+/**
+ * @brief Find candidate hex tokens in free text without copying it.
+ * @ingroup Utilities
+ *
+ * One pass over @p raw: whitespace and hex digits are classified a block
+ * at a time (SSE4.1 / AVX2, dispatched like hexEncode()), so tokens are
+ * cut and validated in the same scan.
+ *
+ * @param raw Input text potentially containing hex-encoded data.
+ * @return Views into @p raw, valid as long as it is. Tokens shorter than
+ *         the minimum AES-256-GCM framing overhead (salt + IV + tag = 88
+ *         hex chars) are discarded. Actual packets also contain a 4-byte
+ *         AAD header, so the true minimum packet length is 96 hex chars;
+ *         this threshold is intentionally lenient to avoid rejecting
+ *         candidate tokens.
+ */
+[[nodiscard]] std::vector<std::string_view> findHexTokens(std::string_view raw);
 
 /**
  * @brief Extract candidate hex tokens from free text.
  * @ingroup Utilities
  * @param raw Input text potentially containing hex-encoded data.
- * @return Vector of hex token strings. Tokens shorter than the minimum
- *         AES-256-GCM framing overhead (salt + IV + tag = 88 hex chars)
- *         are discarded. Actual packets also contain a 4-byte AAD header,
- *         so the true minimum packet length is 96 hex chars; this threshold
- *         is intentionally lenient to avoid rejecting candidate tokens.
+ * @return Copies of the tokens findHexTokens() selects.
  */
 [[nodiscard]] std::vector<std::string> extractHexTokens(const std::string& raw);
 
@@ -262,6 +335,41 @@ template <std::ranges::range PathLike, std::ranges::contiguous_range Cont>
 [[nodiscard]] std::string secureWideToUtf8(
     const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& wide);
 
+/**
+ * @brief Length of the padded Base64 encoding of @p n bytes.
+ * @ingroup Utilities
+ */
+[[nodiscard]] constexpr size_t base64EncodedSize(size_t n) noexcept
+{
+    return 4 * ((n + 2) / 3);
+}
+
+/**
+ * @brief Encode bytes as padded standard Base64 into a pre-sized buffer.
+ * @ingroup Utilities
+ *
+ * AVX2 or SSE4.1 when the CPU has them, scalar otherwise.
+ *
+ * @param bytes Bytes to encode.
+ * @param out   At least `base64EncodedSize(bytes.size())` characters.
+ * @return Characters written (`base64EncodedSize(bytes.size())`).
+ */
+size_t base64Encode(std::span<const unsigned char> bytes, std::span<char> out) noexcept;
+
+/**
+ * @brief Validate and decode padded standard Base64 in a single pass.
+ * @ingroup Utilities
+ *
+ * Leading and trailing ASCII whitespace is ignored. The remaining text
+ * must be a multiple of 4 characters, with `=` only as final padding.
+ *
+ * @param b64 Base64 text.
+ * @param out At least `3 * (b64.size() / 4)` bytes; contents unspecified on failure.
+ * @return Bytes written, or `std::nullopt` on invalid input.
+ */
+[[nodiscard]] std::optional<size_t> base64Decode(std::string_view b64,
+                                                 std::span<unsigned char> out) noexcept;
+
 /**
  * @brief Encode binary data as a Base64 string.
  * @ingroup Utilities
@@ -2,30 +2,45 @@
 
 #include "Vault.h"
 
+#include "BreachIndex.h"
 #include "Cryptography.h"
 #include "Diagnostics.h"
+#include "FileKeyring.h"
 #include "FileOperations.h"
 #include "Logging.h"
+#include "Metrics.h"
+#include "PasswordGen.h"
 #include "Utils.h"
 
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QString>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 
 #include <windows.h>
+#include <wincrypt.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <limits>
 #include <span>
+#include <shared_mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace
@@ -47,12 +62,45 @@ void wipeStdString(std::string& s)
     s.clear();
     s.shrink_to_fit();
 }
-// Vault binary format (V2):
-//   magic(4 bytes "SVH2") + version(1 byte) + count(4 bytes BE) + N records
-// Each record: platformLen(4 BE) + platformBlob + credLen(4 BE) + credBlob
-// The entire binary frame is hex-encoded into a single text string on disk.
+// Vault binary format (V3/V4):
+//   magic(4 bytes "SVH2") + version(1 byte) + salt(16, version 2+)
+//   + kdf(4, version 4 only) + count(4 bytes BE) + N records
+// Each record: id(8 BE, version 3+) + platformLen(4 BE) + platformBlob
+//   + credLen(4 BE) + credBlob
+// Version 3 files are stored as the raw frame by default; the hex encoding
+// (one text line per frame) is kept for export and for older files.
+//
+// Version 1 packets are self-salted (Cryptography::encryptPacket), so every
+// packet costs one scrypt. Version 2 derives one key from the header salt
+// and seals every packet under it with a fresh IV. Version 3 adds stable
+// record ids so later saves can append journal entries instead of rewriting
+// (version 4 is version 3 with the salt's KdfParams stored next to it; it is
+// only written for non-default parameters, so default vaults stay readable
+// by older builds):
+//   magic(4 bytes "SVJ3") + seq(4 BE) + packetLen(4 BE) + packet
+// (hex encoding: "\n" + hex of the same, one entry per line)
+// where packet seals seq(4 BE) + opCount(4 BE) + ops under the journal key.
+// Each op is type(1) + id(8 BE), followed for an upsert by the record's
+// platformLen + platformBlob + credLen + credBlob.
 constexpr unsigned char kVaultMagic[4] = {'S', 'V', 'H', '2'};
-constexpr unsigned char kVaultFormatVersion = 1;
+constexpr unsigned char kVaultFormatLegacy = 1;
+constexpr unsigned char kVaultFormatKeyed = 2;
+constexpr unsigned char kVaultFormatVersion = 3;
+constexpr unsigned char kVaultFormatKdf = 4;
+
+// HKDF label for the record-sealing key. Bumping it invalidates every
+// keyed vault, so it is tied to the format version (versions 2 to 4
+// share it; versions 3 and 4 only change the framing).
+constexpr std::string_view kVaultRecordKeyInfo = "seal/vault/v2/record";
+
+constexpr unsigned char kJournalMagic[4] = {'S', 'V', 'J', '3'};
+constexpr std::string_view kVaultJournalKeyInfo = "seal/vault/v3/journal";
+constexpr unsigned char kJournalOpUpsert = 1;
+constexpr unsigned char kJournalOpDelete = 2;
+
+// Journal growth that triggers a full rewrite (compaction) on the next
+// save: too many entries to replay, or more journal bytes than base frame.
+constexpr uint32_t kJournalCompactEntries = 32;
 
 // All multi-byte integers use big-endian (network byte order) so the vault
 // file is portable across machines regardless of native endianness.
@@ -64,7 +112,7 @@ void appendU32BE(std::vector<unsigned char>& out, uint32_t v)
     out.push_back(static_cast<unsigned char>(v & 0xFFu));
 }
 
-bool readU32BE(const std::vector<unsigned char>& in, size_t& pos, uint32_t& out)
+bool readU32BE(std::span<const unsigned char> in, size_t& pos, uint32_t& out)
 {
     if (pos + 4 > in.size())
         return false;
@@ -74,7 +122,23 @@ bool readU32BE(const std::vector<unsigned char>& in, size_t& pos, uint32_t& out)
     return true;
 }
 
-bool readSizedBlob(const std::vector<unsigned char>& in,
+void appendU64BE(std::vector<unsigned char>& out, uint64_t v)
+{
+    appendU32BE(out, static_cast<uint32_t>(v >> 32));
+    appendU32BE(out, static_cast<uint32_t>(v & 0xFFFFFFFFu));
+}
+
+bool readU64BE(std::span<const unsigned char> in, size_t& pos, uint64_t& out)
+{
+    uint32_t hi = 0;
+    uint32_t lo = 0;
+    if (!readU32BE(in, pos, hi) || !readU32BE(in, pos, lo))
+        return false;
+    out = (static_cast<uint64_t>(hi) << 32) | lo;
+    return true;
+}
+
+bool readSizedBlob(std::span<const unsigned char> in,
                    size_t& pos,
                    uint32_t len,
                    std::vector<unsigned char>& out)
@@ -86,6 +150,55 @@ bool readSizedBlob(const std::vector<unsigned char>& in,
     pos += n;
     return true;
 }
+
+// Like readSizedBlob, but only records where the blob starts (mapped loads).
+bool skipSizedBlob(std::span<const unsigned char> in, size_t& pos, uint32_t len, size_t& start)
+{
+    const size_t n = static_cast<size_t>(len);
+    if (pos > in.size() || n > (in.size() - pos))
+        return false;
+    start = pos;
+    pos += n;
+    return true;
+}
+
+// Random record id; ids only need to be unique within one vault, and zero
+// is reserved for "not yet assigned".
+uint64_t newRecordId()
+{
+    uint64_t id = 0;
+    while (id == 0)
+    {
+        if (RAND_bytes(reinterpret_cast<unsigned char*>(&id), static_cast<int>(sizeof(id))) != 1)
+            throw std::runtime_error("RAND_bytes(record id) failed");
+    }
+    return id;
+}
+
+// Identity of one sealing of a credential packet: the low half of its GCM
+// tag, which a fresh random IV makes unique per encryption. Comparing it
+// tells whether a record was re-sealed without touching the ciphertext.
+uint64_t packetTag(std::span<const unsigned char> packet)
+{
+    if (packet.size() < seal::cfg::TAG_LEN)
+        return 0;
+    uint64_t tag = 0;
+    std::memcpy(&tag, packet.data() + packet.size() - sizeof(tag), sizeof(tag));
+    return tag;
+}
+
+// Size and last-write time of a file, used to detect whether a vault was
+// replaced or touched by someone else since we last read or wrote it.
+bool fileStamp(const std::string& path, uint64_t& size, uint64_t& lastWrite)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data))
+        return false;
+    size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    lastWrite = (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                data.ftLastWriteTime.dwLowDateTime;
+    return true;
+}
 }  // namespace
 
 namespace seal
@@ -96,14 +209,443 @@ void DecryptedCredential::cleanse()
     seal::Cryptography::cleanseString(username, password);
 }
 
-static std::vector<unsigned char> encryptString(
-    const std::string& plaintext,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPassword)
+// CryptProtectMemory works in whole blocks; record keys are protected in place.
+static_assert(seal::cfg::KEY_LEN % CRYPTPROTECTMEMORY_BLOCK_SIZE == 0,
+              "Record keys must fill whole DPAPI blocks");
+
+VaultKeyCache::~VaultKeyCache()
+{
+    clear();
+}
+
+bool VaultKeyCache::lookup(std::span<const unsigned char> keySalt,
+                           Cryptography::LockedKeyBuffer& key) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = std::find_if(m_Entries.begin(),
+                           m_Entries.end(),
+                           [&](const Entry& entry)
+                           {
+                               return std::equal(entry.keySalt.begin(),
+                                                 entry.keySalt.end(),
+                                                 keySalt.begin(),
+                                                 keySalt.end());
+                           });
+    if (it == m_Entries.end())
+        return false;
+
+    // Decrypt a copy so the cached entry never leaves DPAPI protection.
+    Cryptography::LockedKeyBuffer copy(it->key.begin(), it->key.end());
+    if (!CryptUnprotectMemory(
+            copy.data(), static_cast<DWORD>(copy.size()), CRYPTPROTECTMEMORY_SAME_PROCESS))
+    {
+        seal::Cryptography::cleanseString(copy);
+        return false;
+    }
+    seal::Cryptography::cleanseString(key);
+    key = std::move(copy);
+    return true;
+}
+
+void VaultKeyCache::store(std::span<const unsigned char> keySalt,
+                          std::span<const unsigned char> key)
+{
+    if (keySalt.size() != seal::cfg::KDF_SALT_LEN || key.size() != seal::cfg::KEY_LEN)
+        return;
+
+    Entry entry;
+    std::copy_n(keySalt.begin(), entry.keySalt.size(), entry.keySalt.begin());
+    entry.key.assign(key.begin(), key.end());
+    // The cache is only an accelerator: if DPAPI is unavailable, drop the
+    // key rather than hold it in the clear for the rest of the session.
+    if (!CryptProtectMemory(entry.key.data(),
+                            static_cast<DWORD>(entry.key.size()),
+                            CRYPTPROTECTMEMORY_SAME_PROCESS))
+    {
+        seal::Cryptography::cleanseString(entry.key);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = std::find_if(m_Entries.begin(),
+                           m_Entries.end(),
+                           [&](const Entry& e) { return e.keySalt == entry.keySalt; });
+    if (it != m_Entries.end())
+    {
+        seal::Cryptography::cleanseString(it->key);
+        it->key = std::move(entry.key);
+        return;
+    }
+    m_Entries.push_back(std::move(entry));
+}
+
+void VaultKeyCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto& entry : m_Entries)
+        seal::Cryptography::cleanseString(entry.key);
+    m_Entries.clear();
+}
+
+void VaultKeyCache::moveTo(VaultKeyCache& target)
+{
+    if (&target == this)
+        return;
+    std::scoped_lock lock(m_Mutex, target.m_Mutex);
+    for (auto& entry : target.m_Entries)
+        seal::Cryptography::cleanseString(entry.key);
+    target.m_Entries = std::move(m_Entries);
+    m_Entries.clear();
+}
+
+std::size_t VaultKeyCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Entries.size();
+}
+
+// CryptProtectMemory works in whole blocks, so a prefetched field is padded
+// with zeros to the next block before it is encrypted in place.
+static bool protectPrefetched(seal::basic_secure_string<wchar_t>& field)
+{
+    if (field.empty())
+        return true;
+    constexpr size_t kBlockChars = CRYPTPROTECTMEMORY_BLOCK_SIZE / sizeof(wchar_t);
+    field.s.resize((field.size() + kBlockChars - 1) / kBlockChars * kBlockChars, L'\0');
+    return CryptProtectMemory(field.data(),
+                              static_cast<DWORD>(field.size() * sizeof(wchar_t)),
+                              CRYPTPROTECTMEMORY_SAME_PROCESS);
+}
+
+static bool unprotectPrefetched(seal::basic_secure_string<wchar_t>& field, size_t length)
+{
+    if (field.empty())
+        return true;
+    if (!CryptUnprotectMemory(field.data(),
+                              static_cast<DWORD>(field.size() * sizeof(wchar_t)),
+                              CRYPTPROTECTMEMORY_SAME_PROCESS))
+        return false;
+    field.s.resize(length);
+    return true;
+}
+
+struct CredentialPrefetch::State
+{
+    std::mutex mutex;
+    uint64_t epoch = 0;  // bumped by start() and clear(); older decrypts are discarded
+    int index = -1;
+    uint64_t generation = 0;
+    bool ready = false;
+    std::chrono::steady_clock::time_point expires;
+    DecryptedCredential cred;  // DPAPI-protected while ready
+    size_t usernameLength = 0;
+    size_t passwordLength = 0;
+
+    void drop()
+    {
+        cred.cleanse();
+        ready = false;
+        index = -1;
+    }
+};
+
+CredentialPrefetch::CredentialPrefetch(std::chrono::milliseconds ttl)
+    : m_Ttl(ttl),
+      m_State(std::make_shared<State>())
+{
+}
+
+CredentialPrefetch::~CredentialPrefetch()
+{
+    clear();
+}
+
+void CredentialPrefetch::start(
+    int index,
+    uint64_t generation,
+    VaultRecord record,
+    seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>> password,
+    std::shared_ptr<VaultKeyCache> keyCache)
+{
+    uint64_t epoch = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_State->mutex);
+        m_State->drop();
+        epoch = ++m_State->epoch;
+        m_State->index = index;
+        m_State->generation = generation;
+    }
+
+    // QThreadPool copies its task, so the move-only password rides in a
+    // shared job that the task wipes whether or not it runs to the end.
+    struct Job
+    {
+        VaultRecord record;
+        seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>> password;
+        std::shared_ptr<VaultKeyCache> keyCache;
+    };
+    auto job = std::make_shared<Job>(
+        Job{std::move(record), std::move(password), std::move(keyCache)});
+    QThreadPool::globalInstance()->start(
+        [state = m_State, ttl = m_Ttl, epoch, job]()
+        {
+            auto stale = [&]
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                return state->epoch != epoch;
+            };
+            DecryptedCredential cred;
+            bool ok = false;
+            if (!stale())
+            {
+                try
+                {
+                    cred = decryptCredentialOnDemand(
+                        job->record, job->password, job->keyCache.get());
+                    ok = true;
+                }
+                catch (...)
+                {
+                    // A failed prefetch is a miss; the fill decrypts again
+                    // and reports the error itself.
+                }
+            }
+            seal::Cryptography::cleanseString(job->password);
+
+            const size_t usernameLength = cred.username.size();
+            const size_t passwordLength = cred.password.size();
+            ok = ok && protectPrefetched(cred.username) && protectPrefetched(cred.password);
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!ok || state->epoch != epoch)
+            {
+                cred.cleanse();
+                return;
+            }
+            state->cred = std::move(cred);
+            state->usernameLength = usernameLength;
+            state->passwordLength = passwordLength;
+            state->expires = std::chrono::steady_clock::now() + ttl;
+            state->ready = true;
+        });
+}
+
+bool CredentialPrefetch::take(int index, uint64_t generation, DecryptedCredential& out)
+{
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    State& st = *m_State;
+    if (!st.ready)
+        return false;
+    if (std::chrono::steady_clock::now() >= st.expires)
+    {
+        st.drop();
+        return false;
+    }
+    if (st.index != index || st.generation != generation)
+        return false;
+
+    if (!unprotectPrefetched(st.cred.username, st.usernameLength) ||
+        !unprotectPrefetched(st.cred.password, st.passwordLength))
+    {
+        st.drop();
+        return false;
+    }
+    out.cleanse();
+    out = std::move(st.cred);
+    st.drop();
+    return true;
+}
+
+void CredentialPrefetch::sweep()
 {
-    return seal::Cryptography::encryptPacket(
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    if (m_State->ready && std::chrono::steady_clock::now() >= m_State->expires)
+        m_State->drop();
+}
+
+void CredentialPrefetch::clear()
+{
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    m_State->drop();
+    ++m_State->epoch;
+}
+
+bool CredentialPrefetch::ready() const
+{
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    return m_State->ready && std::chrono::steady_clock::now() < m_State->expires;
+}
+
+VaultMapping::VaultMapping(std::string path)
+    : m_Path(std::move(path))
+{
+    if (!map())
+        throw std::runtime_error("Cannot map vault file");
+}
+
+VaultMapping::~VaultMapping()
+{
+    unmap();
+}
+
+uint32_t VaultMapping::generation() const
+{
+    std::shared_lock lock(m_Mutex);
+    return m_Generation;
+}
+
+bool VaultMapping::mapped() const
+{
+    std::shared_lock lock(m_Mutex);
+    return m_View != nullptr;
+}
+
+std::span<const unsigned char> VaultMapping::bytes() const
+{
+    std::shared_lock lock(m_Mutex);
+    return {m_View, static_cast<size_t>(m_Size)};
+}
+
+std::vector<unsigned char> VaultMapping::copy(uint64_t offset,
+                                              uint32_t size,
+                                              uint32_t generation) const
+{
+    std::shared_lock lock(m_Mutex);
+    if (generation != m_Generation || !m_View)
+        throw std::runtime_error("Vault file was replaced; reload the vault");
+    if (offset > m_Size || size > m_Size - offset)
+        throw std::runtime_error("Corrupted vault file");
+    return {m_View + offset, m_View + offset + size};
+}
+
+bool VaultMapping::replaceFile(const std::function<bool()>& replace)
+{
+    std::unique_lock lock(m_Mutex);
+    unmap();
+    const bool replaced = replace();
+    if (replaced)
+        ++m_Generation;
+    map();
+    return replaced;
+}
+
+// Open and map m_Path. Writers may still append (FILE_SHARE_WRITE); the
+// view only covers the size at mapping time.
+bool VaultMapping::map()
+{
+    HANDLE file = CreateFileA(m_Path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+        // An empty file cannot be mapped; it is also not worth mapping.
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!section)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(section);
+        CloseHandle(file);
+        return false;
+    }
+    m_File = file;
+    m_Section = section;
+    m_View = static_cast<const unsigned char*>(view);
+    m_Size = static_cast<uint64_t>(size.QuadPart);
+    return true;
+}
+
+void VaultMapping::unmap()
+{
+    if (m_View)
+        UnmapViewOfFile(m_View);
+    if (m_Section)
+        CloseHandle(static_cast<HANDLE>(m_Section));
+    if (m_File)
+        CloseHandle(static_cast<HANDLE>(m_File));
+    m_View = nullptr;
+    m_Section = nullptr;
+    m_File = nullptr;
+    m_Size = 0;
+}
+
+// Derive the record-sealing key of a version 2+ vault: one password KDF over
+// the header salt, then an HKDF expand so the KDF output never keys AES
+// directly and other subkeys can be split off later without a format change.
+// keySalt is the key id: salt(16) + the KdfParams it is derived under.
+static Cryptography::LockedKeyBuffer deriveRecordKey(
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    std::span<const unsigned char> keySalt)
+{
+    if (keySalt.size() != seal::cfg::KDF_SALT_LEN)
+        throw std::runtime_error("Invalid vault key salt");
+    const auto kdf = seal::KdfParams::decode(keySalt.subspan(seal::cfg::SALT_LEN));
+    if (!kdf)
+        throw std::runtime_error("Unsupported vault KDF parameters");
+    auto masterKey = seal::Cryptography::deriveMasterKey(
+        password, keySalt.first(seal::cfg::SALT_LEN), *kdf);
+    auto recordKey = seal::Cryptography::deriveSubkey(masterKey, kVaultRecordKeyInfo);
+    seal::Cryptography::cleanseString(masterKey);
+    return recordKey;
+}
+
+// Worker count for decrypting version 1 records, each of which runs its own
+// scrypt. Bounded by core count and by how many scrypt working sets
+// (128 * r * N bytes each, capped by SCRYPT_MAXMEM) fit in half of the
+// currently available physical memory.
+static int legacyDecryptWorkers(size_t jobs)
+{
+    int workers = std::max(1, QThread::idealThreadCount());
+    constexpr uint64_t kScryptWorkingSet =
+        std::min<uint64_t>(128ULL * seal::cfg::SCRYPT_R * seal::cfg::SCRYPT_N,
+                           seal::cfg::SCRYPT_MAXMEM);
+    MEMORYSTATUSEX mem{};
+    mem.dwLength = sizeof(mem);
+    if (GlobalMemoryStatusEx(&mem))
+    {
+        const uint64_t fit = (mem.ullAvailPhys / 2) / kScryptWorkingSet;
+        workers = static_cast<int>(std::min<uint64_t>(workers, std::max<uint64_t>(fit, 1)));
+    }
+    return static_cast<int>(std::min<size_t>(static_cast<size_t>(workers), jobs));
+}
+
+// deriveRecordKey() behind the session cache. Keys are not stored here:
+// callers store a key only once it has authenticated a packet (or sealed
+// new ones), so a mistyped password cannot poison the cache.
+static Cryptography::LockedKeyBuffer cachedRecordKey(
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    std::span<const unsigned char> keySalt,
+    const VaultKeyCache* keyCache,
+    bool& hit)
+{
+    Cryptography::LockedKeyBuffer recordKey;
+    hit = keyCache && keyCache->lookup(keySalt, recordKey);
+    if (!hit)
+        recordKey = deriveRecordKey(password, keySalt);
+    return recordKey;
+}
+
+static std::vector<unsigned char> encryptString(const std::string& plaintext,
+                                                std::span<const unsigned char> recordKey)
+{
+    return seal::Cryptography::encryptWithKey(
         std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(plaintext.data()),
                                        plaintext.size()),
-        masterPassword);
+        recordKey);
 }
 
 // Decrypt a packet and return the plaintext as a regular std::string.
@@ -121,273 +663,1252 @@ static std::string decryptToString(
     return result;
 }
 
+// Keyed counterpart of decryptToString() for version 2 packets.
+static std::string decryptToString(const std::vector<unsigned char>& packet,
+                                   std::span<const unsigned char> recordKey)
+{
+    auto plainBytes =
+        seal::Cryptography::decryptWithKey(std::span<const unsigned char>(packet), recordKey);
+    std::string result(reinterpret_cast<const char*>(plainBytes.data()), plainBytes.size());
+    seal::Cryptography::cleanseString(plainBytes);
+    return result;
+}
+
+// A record's credential packet: its own copy, or read from its mapping.
+static std::vector<unsigned char> credentialPacket(const VaultRecord& record)
+{
+    if (record.mapping && record.encryptedBlob.empty())
+        return record.mapping->copy(record.blobOffset, record.blobSize, record.mappingGeneration);
+    return record.encryptedBlob;
+}
+
+static size_t credentialPacketSize(const VaultRecord& record)
+{
+    if (record.mapping && record.encryptedBlob.empty())
+        return record.blobSize;
+    return record.encryptedBlob.size();
+}
+
+// Key for sealing new packets under @p keySalt. A freshly derived key must
+// first open a packet already sealed under that salt before it seals or
+// is cached, so a mistyped password cannot seal records under the wrong
+// key. Only a vault with no record under @p keySalt yet takes a new key.
+static Cryptography::LockedKeyBuffer sealingRecordKey(
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    std::span<const unsigned char> keySalt,
+    std::span<const VaultRecord> records,
+    VaultKeyCache* keyCache)
+{
+    bool cacheHit = false;
+    auto recordKey = cachedRecordKey(password, keySalt, keyCache, cacheHit);
+    if (cacheHit)
+        return recordKey;
+
+    const auto probe = std::find_if(records.begin(),
+                                    records.end(),
+                                    [&](const VaultRecord& r)
+                                    { return r.keyed && std::ranges::equal(r.keySalt, keySalt); });
+    if (probe != records.end())
+    {
+        try
+        {
+            std::vector<unsigned char> blob;
+            std::span<const unsigned char> packet(probe->encryptedPlatform);
+            if (packet.empty())
+            {
+                blob = credentialPacket(*probe);
+                packet = blob;
+            }
+            auto plainBytes = seal::Cryptography::decryptWithKey(packet, recordKey);
+            seal::Cryptography::cleanseString(plainBytes);
+        }
+        catch (...)
+        {
+            seal::Cryptography::cleanseString(recordKey);
+            throw;
+        }
+    }
+    if (keyCache)
+        keyCache->store(keySalt, recordKey);
+    return recordKey;
+}
+
+// Decrypt a record's credential blob with whichever scheme sealed it.
+static std::vector<unsigned char> openCredentialBlob(
+    const VaultRecord& record,
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache)
+{
+    const std::vector<unsigned char> packet = credentialPacket(record);
+    if (!record.keyed)
+    {
+        return seal::Cryptography::decryptPacket(std::span<const unsigned char>(packet), password);
+    }
+    bool cacheHit = false;
+    auto recordKey = cachedRecordKey(password, record.keySalt, keyCache, cacheHit);
+    std::vector<unsigned char> plainBytes;
+    try
+    {
+        plainBytes =
+            seal::Cryptography::decryptWithKey(std::span<const unsigned char>(packet), recordKey);
+    }
+    catch (...)
+    {
+        seal::Cryptography::cleanseString(recordKey);
+        throw;
+    }
+    if (keyCache && !cacheHit)
+        keyCache->store(record.keySalt, recordKey);
+    seal::Cryptography::cleanseString(recordKey);
+    return plainBytes;
+}
+
+std::array<unsigned char, seal::cfg::KDF_SALT_LEN> vaultKeySalt(
+    const std::vector<VaultRecord>& records)
+{
+    for (const auto& rec : records)
+    {
+        if (rec.keyed && !rec.deleted)
+            return rec.keySalt;
+    }
+    std::array<unsigned char, seal::cfg::KDF_SALT_LEN> salt{};
+    if (RAND_bytes(salt.data(), static_cast<int>(seal::cfg::SALT_LEN)) != 1)
+        throw std::runtime_error("RAND_bytes(vault salt) failed");
+    const auto kdf = seal::Cryptography::kdfParams().encode();
+    std::copy(kdf.begin(), kdf.end(), salt.begin() + seal::cfg::SALT_LEN);
+    return salt;
+}
+
 std::vector<VaultRecord> loadVaultIndex(
     const QString& vaultPath,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password)
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache,
+    const VaultProgress& progress,
+    VaultJournalState* journal,
+    VaultLoadMode mode,
+    const std::vector<VaultRecord>* known)
 {
     const std::string opId = seal::diag::nextOpId("vault_index_load");
     const auto started = std::chrono::steady_clock::now();
-    const std::string pathMeta = seal::diag::pathSummary(vaultPath.toUtf8().toStdString());
-    auto logInfo = [](std::initializer_list<std::string> fields)
-    { qCInfo(logVault).noquote() << QString::fromStdString(seal::diag::joinFields(fields)); };
-    auto logWarn = [](std::initializer_list<std::string> fields)
-    { qCWarning(logVault).noquote() << QString::fromStdString(seal::diag::joinFields(fields)); };
+    seal::metrics::ScopedTimer timer(seal::metrics::Latency::VaultLoad);
+    // Only evaluated inside SEAL_LOG, i.e. when the line is actually logged.
+    auto pathMeta = [&] { return seal::diag::pathSummary(vaultPath.toUtf8().toStdString()); };
 
-    logInfo({"event=vault.index.load.begin", "result=start", seal::diag::kv("op", opId), pathMeta});
+    SEAL_LOG(qCInfo,
+             logVault,
+             "event=vault.index.load.begin",
+             "result=start",
+             seal::diag::kv("op", opId),
+             pathMeta());
+    if (journal)
+        *journal = {};
     std::ifstream in(vaultPath.toStdString(), std::ios::in | std::ios::binary);
     if (!in)
     {
-        logWarn({"event=vault.index.load.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=open_failed",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         throw std::runtime_error("Cannot open vault file");
     }
 
-    // Step 1: Read the entire file as a hex-encoded text string.
-    std::string raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
-    // Strip any whitespace that may have been inserted (e.g. line breaks).
-    std::string compact = seal::utils::stripSpaces(raw);
-    if (compact.empty())
+    // Mapped mode: parse a binary vault straight out of a read-only view and
+    // leave the credential packets there. Anything that cannot be mapped, or
+    // is not binary, is read the normal way.
+    std::shared_ptr<VaultMapping> mapping;
+    if (mode == VaultLoadMode::Mapped)
     {
-        logInfo({"event=vault.index.load.finish",
-                 "result=ok",
-                 seal::diag::kv("op", opId),
-                 seal::diag::kv("record_count", 0),
-                 "reason=empty_input",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
-        return {};
+        try
+        {
+            mapping = std::make_shared<VaultMapping>(vaultPath.toStdString());
+            const auto view = mapping->bytes();
+            if (view.size() < sizeof(kVaultMagic) ||
+                !std::equal(kVaultMagic, kVaultMagic + sizeof(kVaultMagic), view.begin()))
+                mapping.reset();
+        }
+        catch (const std::exception&)
+        {
+            mapping.reset();
+        }
     }
 
-    // Step 2: Hex-decode the text back into the raw binary frame.
-    // The vault file is stored as one long hex string so it stays a safe
-    // single-line text blob (no embedded NULs, no encoding ambiguity).
+    // Step 1: Read the whole file straight into the frame buffer. Binary
+    // vaults (the default since format version 3) are parsed in place.
     std::vector<unsigned char> framed;
-    if (!seal::utils::from_hex(std::string_view{compact}, framed))
+    std::streamoff fileBytes = 0;
+    if (mapping)
     {
-        logWarn({"event=vault.index.load.finish",
-                 "result=fail",
-                 seal::diag::kv("op", opId),
-                 "reason=invalid_hex",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
-        throw std::runtime_error("Invalid vault format");
+        fileBytes = static_cast<std::streamoff>(mapping->bytes().size());
+    }
+    else
+    {
+        in.seekg(0, std::ios::end);
+        fileBytes = in.tellg();
+        in.seekg(0, std::ios::beg);
+        if (fileBytes > 0)
+        {
+            framed.resize(static_cast<size_t>(fileBytes));
+            in.read(reinterpret_cast<char*>(framed.data()),
+                    static_cast<std::streamsize>(fileBytes));
+        }
+        if (fileBytes < 0 || !in)
+        {
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.load.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     "reason=read_failed",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+            throw std::runtime_error("Cannot read vault file");
+        }
+    }
+    in.close();
+    std::span<const unsigned char> frame =
+        mapping ? mapping->bytes() : std::span<const unsigned char>(framed);
+    // Hex text never starts with the magic ('S' is not a hex digit).
+    const bool binary =
+        frame.size() >= sizeof(kVaultMagic) &&
+        std::equal(kVaultMagic, kVaultMagic + sizeof(kVaultMagic), frame.begin());
+
+    // Step 2 (hex encoding): the first line holds the base frame; version 3+
+    // files may follow it with journal lines. Only version 3+ gives line
+    // breaks a meaning: older files are a single hex blob that may have been
+    // wrapped, so they are decoded as a whole.
+    std::string raw;
+    size_t baseEnd = frame.size();
+    bool journaled = false;
+    if (!binary)
+    {
+        raw.assign(framed.begin(), framed.end());
+        framed.clear();
+        baseEnd = std::min(raw.find('\n'), raw.size());
+        // Strip any whitespace that may have been inserted (e.g. line breaks).
+        std::string compact = seal::utils::stripSpaces(raw.substr(0, baseEnd));
+        if (compact.size() >= 10)
+        {
+            std::vector<unsigned char> peek;
+            journaled = seal::utils::from_hex(std::string_view{compact}.substr(0, 10), peek) &&
+                        std::equal(kVaultMagic, kVaultMagic + sizeof(kVaultMagic), peek.begin()) &&
+                        (peek[4] == kVaultFormatVersion || peek[4] == kVaultFormatKdf);
+        }
+        if (!journaled && baseEnd < raw.size())
+        {
+            compact = seal::utils::stripSpaces(raw);
+            baseEnd = raw.size();
+        }
+        if (compact.empty())
+        {
+            SEAL_LOG(qCInfo,
+                     logVault,
+                     "event=vault.index.load.finish",
+                     "result=ok",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("record_count", 0),
+                     "reason=empty_input",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+            return {};
+        }
+
+        // Hex-decode the text back into the raw binary frame.
+        framed.reserve(compact.size() / 2);
+        if (!seal::utils::from_hex(std::string_view{compact}, framed))
+        {
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.load.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     "reason=invalid_hex",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+            throw std::runtime_error("Invalid vault format");
+        }
+        frame = framed;
     }
 
     // Step 3: Parse the binary frame header: magic(4) + version(1) + count(4) = 9 bytes min.
     size_t pos = 0;
-    if (framed.size() < 9)
+    if (frame.size() < 9)
     {
-        logWarn({"event=vault.index.load.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=payload_too_short",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         throw std::runtime_error("Corrupted vault file");
     }
     for (unsigned char b : kVaultMagic)
     {
-        if (framed[pos++] != b)
+        if (frame[pos++] != b)
         {
-            logWarn({"event=vault.index.load.finish",
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.load.finish",
                      "result=fail",
                      seal::diag::kv("op", opId),
                      "reason=bad_magic",
-                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
             throw std::runtime_error("Invalid vault format");
         }
     }
-    const unsigned char version = framed[pos++];
-    if (version != kVaultFormatVersion)
+    const unsigned char version = frame[pos++];
+    if (version != kVaultFormatKdf && version != kVaultFormatVersion &&
+        version != kVaultFormatKeyed && version != kVaultFormatLegacy)
     {
-        logWarn({"event=vault.index.load.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=unsupported_version",
                  seal::diag::kv("version", version),
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         throw std::runtime_error("Unsupported vault format version");
     }
+    const bool keyedFormat = version >= kVaultFormatKeyed;
+    const bool hasIds = version >= kVaultFormatVersion;
+
+    // Key id: the header salt followed by its KDF parameters, which only
+    // version 4 stores; older versions imply the legacy scrypt parameters.
+    std::array<unsigned char, seal::cfg::KDF_SALT_LEN> keySalt{};
+    const size_t keyIdLen =
+        version == kVaultFormatKdf ? seal::cfg::KDF_SALT_LEN : seal::cfg::SALT_LEN;
+    if (keyedFormat)
+    {
+        if (frame.size() - pos < keyIdLen)
+        {
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.load.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     "reason=missing_key_salt",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+            throw std::runtime_error("Corrupted vault file");
+        }
+        std::copy_n(frame.begin() + pos, keyIdLen, keySalt.begin());
+        pos += keyIdLen;
+        if (version != kVaultFormatKdf)
+        {
+            const auto legacy = seal::KdfParams::legacy().encode();
+            std::copy(legacy.begin(), legacy.end(), keySalt.begin() + seal::cfg::SALT_LEN);
+        }
+        else if (!seal::KdfParams::decode(std::span(keySalt).subspan(seal::cfg::SALT_LEN)))
+        {
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.load.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     "reason=unsupported_kdf",
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+            throw std::runtime_error("Unsupported vault KDF parameters");
+        }
+    }
 
     uint32_t entryCount = 0;
-    if (!readU32BE(framed, pos, entryCount))
+    if (!readU32BE(frame, pos, entryCount))
     {
-        logWarn({"event=vault.index.load.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=missing_entry_count",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         throw std::runtime_error("Corrupted vault file");
     }
-    // Sanity check: each record needs at least 8 bytes (two u32 length fields),
-    // so reject counts that would be impossible given the remaining data.
-    if (entryCount > (framed.size() - pos) / 8)
+    // Sanity check: each record needs at least 8 bytes (two u32 length fields,
+    // plus the u64 id in version 3), so reject counts that would be impossible
+    // given the remaining data.
+    const size_t minRecordBytes = hasIds ? 16 : 8;
+    if (entryCount > (frame.size() - pos) / minRecordBytes)
     {
-        logWarn({"event=vault.index.load.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=impossible_entry_count",
                  seal::diag::kv("entry_count", entryCount),
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         throw std::runtime_error("Corrupted vault file");
     }
 
-    // Step 4: Read each length-prefixed record: [platformLen][platformBlob][credLen][credBlob].
+    // Step 4: Read each length-prefixed record: [id][platformLen][platformBlob][credLen][credBlob].
     // We decrypt *only* the platform name here (for display in the list view);
     // the credential blob stays encrypted until the user explicitly requests it.
+    // Framing is parsed up front so decryption can run over a complete list.
     std::vector<VaultRecord> records;
     records.reserve(entryCount);
-
     for (uint32_t i = 0; i < entryCount; ++i)
     {
-        std::vector<unsigned char> platformBlob, credBlob;
+        VaultRecord rec;
         uint32_t platformLen = 0;
         uint32_t credLen = 0;
-        if (!readU32BE(framed, pos, platformLen) ||
-            !readSizedBlob(framed, pos, platformLen, platformBlob) ||
-            !readU32BE(framed, pos, credLen) || !readSizedBlob(framed, pos, credLen, credBlob))
+        size_t blobStart = 0;
+        if ((hasIds && !readU64BE(frame, pos, rec.id)) ||
+            !readU32BE(frame, pos, platformLen) ||
+            !readSizedBlob(frame, pos, platformLen, rec.encryptedPlatform) ||
+            !readU32BE(frame, pos, credLen) ||
+            !(mapping ? skipSizedBlob(frame, pos, credLen, blobStart)
+                      : readSizedBlob(frame, pos, credLen, rec.encryptedBlob)))
         {
-            logWarn({"event=vault.index.load.finish",
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.load.finish",
                      "result=fail",
                      seal::diag::kv("op", opId),
                      "reason=truncated_payload",
                      seal::diag::kv("entry_index", i),
-                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+            throw std::runtime_error("Corrupted vault file");
+        }
+        // Older formats have no ids; assign fresh ones that the migrating
+        // save will persist.
+        if (!hasIds)
+            rec.id = newRecordId();
+        if (mapping)
+        {
+            rec.mapping = mapping;
+            rec.blobOffset = blobStart;
+            rec.blobSize = credLen;
+            rec.mappingGeneration = mapping->generation();
+        }
+        rec.keySalt = keySalt;
+        rec.keyed = keyedFormat;
+        rec.sealTag = mapping ? packetTag(frame.subspan(blobStart, credLen))
+                              : packetTag(rec.encryptedBlob);
+        rec.dirty = false;
+        rec.deleted = false;
+        records.push_back(std::move(rec));
+    }
+
+    // Step 5 (version 3): frame the journal entries that follow the base.
+    // An entry that fails to frame is tolerated only at the very end of the
+    // file: that is an append torn by a crash, and the committed content
+    // ends before it.
+    struct JournalFrame
+    {
+        uint32_t seq = 0;
+        std::vector<unsigned char> packet;
+    };
+    std::vector<JournalFrame> journalFrames;
+    size_t committedSize = baseEnd;
+    bool tornTail = false;
+    auto noteTornTail = [&]()
+    {
+        tornTail = true;
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.journal",
+                 "result=skip",
+                 seal::diag::kv("op", opId),
+                 "reason=torn_tail",
+                 seal::diag::kv("entry_index", journalFrames.size()));
+    };
+    // Parse one frame: magic(4) + seq(4) + packetLen(4) + packet. Returns
+    // false when the frame is cut short, is not a journal frame at all, or
+    // (with wholeBuffer) does not span the rest of the buffer exactly.
+    auto readFrame = [&](std::span<const unsigned char> buf, size_t& fpos, bool wholeBuffer)
+    {
+        JournalFrame jf;
+        uint32_t packetLen = 0;
+        if (buf.size() - fpos < sizeof(kJournalMagic) + 8 ||
+            !std::equal(kJournalMagic, kJournalMagic + sizeof(kJournalMagic), buf.begin() + fpos))
+            return false;
+        fpos += sizeof(kJournalMagic);
+        if (!readU32BE(buf, fpos, jf.seq) || !readU32BE(buf, fpos, packetLen) ||
+            !readSizedBlob(buf, fpos, packetLen, jf.packet) || (wholeBuffer && fpos != buf.size()))
+            return false;
+        if (jf.seq != journalFrames.size() + 1)
+        {
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.load.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     "reason=journal_out_of_order",
+                     seal::diag::kv("entry_index", journalFrames.size()),
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
             throw std::runtime_error("Corrupted vault file");
         }
+        journalFrames.push_back(std::move(jf));
+        return true;
+    };
+    auto failJournalFrame = [&]()
+    {
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
+                 "result=fail",
+                 seal::diag::kv("op", opId),
+                 "reason=journal_bad_frame",
+                 seal::diag::kv("entry_index", journalFrames.size()),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+        throw std::runtime_error("Corrupted vault file");
+    };
+    if (binary && hasIds)
+    {
+        // Binary: entries are concatenated after the base frame. A torn
+        // append is a frame that runs past end of file, or an extension the
+        // crash left zero-filled.
+        journaled = true;
+        baseEnd = pos;
+        committedSize = pos;
+        while (pos < frame.size())
+        {
+            size_t fpos = pos;
+            if (!readFrame(frame, fpos, false))
+            {
+                const bool cutShort =
+                    frame.size() - pos < sizeof(kJournalMagic) + 8 ||
+                    std::equal(kJournalMagic,
+                               kJournalMagic + sizeof(kJournalMagic),
+                               frame.begin() + pos) ||
+                    std::all_of(frame.begin() + pos,
+                                frame.end(),
+                                [](unsigned char b) { return b == 0; });
+                if (!cutShort)
+                    failJournalFrame();
+                noteTornTail();
+                pos = frame.size();
+                break;
+            }
+            pos = fpos;
+            committedSize = pos;
+        }
+    }
+    for (size_t lineStart = baseEnd; !binary && journaled && lineStart < raw.size();)
+    {
+        // Hex: one entry per line.
+        ++lineStart;  // past the '\n'
+        const size_t lineEnd = std::min(raw.find('\n', lineStart), raw.size());
+        const std::string lineText =
+            seal::utils::stripSpaces(raw.substr(lineStart, lineEnd - lineStart));
+        if (!lineText.empty())
+        {
+            std::vector<unsigned char> lineFrame;
+            size_t fpos = 0;
+            if (!seal::utils::from_hex(std::string_view{lineText}, lineFrame) ||
+                !readFrame(lineFrame, fpos, true))
+            {
+                if (raw.find_first_not_of(" \t\r\n", lineEnd) != std::string::npos)
+                    failJournalFrame();
+                noteTornTail();
+                break;
+            }
+            committedSize = lineEnd;
+        }
+        lineStart = lineEnd;
+    }
+
+    // Keyed formats: the single key derivation for the whole vault. A vault
+    // with nothing to authenticate against skips the KDF.
+    const bool needsKey = keyedFormat && (entryCount > 0 || !journalFrames.empty());
+    Cryptography::LockedKeyBuffer recordKey;
+    Cryptography::LockedKeyBuffer journalKey;
+    bool cacheHit = false;
+    if (needsKey)
+    {
+        recordKey = cachedRecordKey(password, keySalt, keyCache, cacheHit);
+    }
+
+    auto openPlatform = [&](VaultRecord& rec)
+    {
+        rec.platform = keyedFormat ? decryptToString(rec.encryptedPlatform, recordKey)
+                                   : decryptToString(rec.encryptedPlatform, password);
+    };
+    // Reload: a record still carrying the credential packet of a clean known
+    // record was not re-sealed, and every edit re-seals, so its platform
+    // name is unchanged and needs no decryption.
+    std::unordered_map<uint64_t, const VaultRecord*> knownById;
+    if (known && keyedFormat)
+    {
+        knownById.reserve(known->size());
+        for (const auto& rec : *known)
+        {
+            if (rec.keyed && !rec.dirty && !rec.deleted && rec.sealTag != 0 &&
+                rec.keySalt == keySalt)
+                knownById.emplace(rec.id, &rec);
+        }
+    }
+    size_t reusedCount = 0;
+    auto reuseKnown = [&](VaultRecord& rec)
+    {
+        auto it = knownById.find(rec.id);
+        if (it == knownById.end() || it->second->sealTag != rec.sealTag)
+            return false;
+        rec.platform = it->second->platform;
+        ++reusedCount;
+        return true;
+    };
+    auto failCancelled = [&](size_t done)
+    {
+        seal::Cryptography::cleanseString(recordKey, journalKey);
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
+                 "result=fail",
+                 seal::diag::kv("op", opId),
+                 "reason=cancelled",
+                 seal::diag::kv("decrypted_count", done),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+        throw std::runtime_error("Operation cancelled");
+    };
+    auto failWrongPassword = [&](size_t entryIndex)
+    {
+        seal::Cryptography::cleanseString(recordKey, journalKey);
+        // Fail on the very first decryption failure so a wrong password
+        // never reveals how many records the vault holds.  If we kept
+        // going, an attacker could measure how far parsing progressed
+        // and infer the record count even without the correct password.
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
+                 "result=fail",
+                 seal::diag::kv("op", opId),
+                 "reason=wrong_password",
+                 seal::diag::kv("entry_index", entryIndex),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+        throw std::runtime_error("Wrong password");
+    };
+    auto failJournal = [&](size_t entryIndex)
+    {
+        seal::Cryptography::cleanseString(recordKey, journalKey);
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
+                 "result=fail",
+                 seal::diag::kv("op", opId),
+                 "reason=journal_bad_entry",
+                 seal::diag::kv("entry_index", entryIndex),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+        throw std::runtime_error("Corrupted vault file");
+    };
+
+    // Record 0 always decrypts alone on this thread, so a wrong password
+    // costs exactly one KDF and is rejected before any fan-out.
+    int workers = 1;
+    if (!records.empty())
+    {
+        try
+        {
+            openPlatform(records.front());
+        }
+        catch (...)
+        {
+            failWrongPassword(0);
+        }
+        if (progress && !progress(1, records.size()))
+            failCancelled(1);
+    }
+
+    if (records.size() > 1 && !keyedFormat)
+    {
+        // Version 1 packets each run their own scrypt, so the remainder is
+        // spread across cores, capped so the concurrent scrypt working sets
+        // fit comfortably in available memory.
+        workers = legacyDecryptWorkers(records.size() - 1);
+        QThreadPool pool;
+        pool.setMaxThreadCount(workers);
+        std::atomic<size_t> firstFailure{std::numeric_limits<size_t>::max()};
+        std::atomic<size_t> done{1};
+        std::atomic<bool> cancelled{false};
+        QtConcurrent::blockingMap(&pool,
+                                  records.begin() + 1,
+                                  records.end(),
+                                  [&](VaultRecord& rec)
+                                  {
+                                      // Once one record fails the rest are moot.
+                                      if (cancelled.load(std::memory_order_relaxed) ||
+                                          firstFailure.load(std::memory_order_relaxed) !=
+                                              std::numeric_limits<size_t>::max())
+                                          return;
+                                      try
+                                      {
+                                          openPlatform(rec);
+                                      }
+                                      catch (...)
+                                      {
+                                          size_t expected = std::numeric_limits<size_t>::max();
+                                          firstFailure.compare_exchange_strong(
+                                              expected,
+                                              static_cast<size_t>(&rec - records.data()));
+                                          return;
+                                      }
+                                      const size_t n = done.fetch_add(1) + 1;
+                                      if (progress && !progress(n, records.size()))
+                                          cancelled.store(true, std::memory_order_relaxed);
+                                  });
+        const size_t failedAt = firstFailure.load();
+        if (failedAt != std::numeric_limits<size_t>::max())
+            failWrongPassword(failedAt);
+        if (cancelled.load())
+            failCancelled(done.load());
+    }
+    else
+    {
+        for (size_t i = 1; i < records.size(); ++i)
+        {
+            try
+            {
+                if (!reuseKnown(records[i]))
+                    openPlatform(records[i]);
+            }
+            catch (...)
+            {
+                failWrongPassword(i);
+            }
+            if (progress && !progress(i + 1, records.size()))
+                failCancelled(i + 1);
+        }
+    }
 
-        try
+    // Step 6 (version 3): replay the journal over the base records in
+    // sequence order. Each entry authenticates as a whole, so it is either
+    // applied completely or the load fails.
+    if (!journalFrames.empty())
+    {
+        std::unordered_map<uint64_t, size_t> byId;
+        byId.reserve(records.size());
+        for (size_t i = 0; i < records.size(); ++i)
         {
-            std::string platformName = decryptToString(platformBlob, password);
-
-            VaultRecord rec;
-            rec.platform = std::move(platformName);
-            rec.encryptedPlatform = std::move(platformBlob);
-            rec.encryptedBlob = std::move(credBlob);
-            rec.dirty = false;
-            rec.deleted = false;
-            records.push_back(std::move(rec));
+            if (!byId.emplace(records[i].id, i).second)
+                failJournal(0);
         }
-        catch (...)
+        journalKey = seal::Cryptography::deriveSubkey(recordKey, kVaultJournalKeyInfo);
+        for (size_t e = 0; e < journalFrames.size(); ++e)
         {
-            // Fail on the very first decryption failure so a wrong password
-            // never reveals how many records the vault holds.  If we kept
-            // going, an attacker could measure how far parsing progressed
-            // and infer the record count even without the correct password.
-            logWarn({"event=vault.index.load.finish",
-                     "result=fail",
-                     seal::diag::kv("op", opId),
-                     "reason=wrong_password",
-                     seal::diag::kv("entry_index", i),
-                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
-            throw std::runtime_error("Wrong password");
+            std::vector<unsigned char> body;
+            try
+            {
+                body = seal::Cryptography::decryptWithKey(
+                    std::span<const unsigned char>(journalFrames[e].packet), journalKey);
+            }
+            catch (...)
+            {
+                // With no base record to vouch for the key, the first
+                // entry is what checks the password.
+                if (e == 0 && entryCount == 0)
+                    failWrongPassword(0);
+                failJournal(e);
+            }
+            size_t bpos = 0;
+            uint32_t innerSeq = 0;
+            uint32_t opCount = 0;
+            if (!readU32BE(body, bpos, innerSeq) || innerSeq != journalFrames[e].seq ||
+                !readU32BE(body, bpos, opCount))
+                failJournal(e);
+            for (uint32_t op = 0; op < opCount; ++op)
+            {
+                uint64_t id = 0;
+                if (bpos >= body.size())
+                    failJournal(e);
+                const unsigned char type = body[bpos++];
+                if (!readU64BE(body, bpos, id))
+                    failJournal(e);
+                if (type == kJournalOpDelete)
+                {
+                    // Deleting a record that never reached the file is a no-op.
+                    auto it = byId.find(id);
+                    if (it != byId.end())
+                        records[it->second].deleted = true;
+                    continue;
+                }
+
+                VaultRecord rec;
+                uint32_t platformLen = 0;
+                uint32_t credLen = 0;
+                if (type != kJournalOpUpsert || !readU32BE(body, bpos, platformLen) ||
+                    !readSizedBlob(body, bpos, platformLen, rec.encryptedPlatform) ||
+                    !readU32BE(body, bpos, credLen) ||
+                    !readSizedBlob(body, bpos, credLen, rec.encryptedBlob))
+                    failJournal(e);
+                rec.id = id;
+                rec.keySalt = keySalt;
+                rec.keyed = true;
+                rec.sealTag = packetTag(rec.encryptedBlob);
+                try
+                {
+                    if (!reuseKnown(rec))
+                        openPlatform(rec);
+                }
+                catch (...)
+                {
+                    failJournal(e);
+                }
+                auto [it, inserted] = byId.try_emplace(id, records.size());
+                if (inserted)
+                    records.push_back(std::move(rec));
+                else
+                    records[it->second] = std::move(rec);
+            }
+            if (bpos != body.size())
+                failJournal(e);
+        }
+        std::erase_if(records, [](const VaultRecord& r) { return r.deleted; });
+    }
+
+    // Mapped records re-seal their platform packet on the next full save
+    // rather than keep a heap copy of it for the session.
+    if (mapping)
+    {
+        for (auto& rec : records)
+        {
+            if (rec.mapping)
+                std::vector<unsigned char>().swap(rec.encryptedPlatform);
         }
     }
-    // Step 5: Verify we consumed every byte.  Trailing bytes would indicate
+
+    // Every packet authenticated, so the key is known-good and can serve
+    // later on-demand decrypts without another derivation.
+    if (keyCache && needsKey && !cacheHit)
+        keyCache->store(keySalt, recordKey);
+    // Step 7: Verify we consumed every byte.  Trailing bytes would indicate
     // file corruption, accidental concatenation, or a tampered payload.
-    if (pos != framed.size())
+    seal::Cryptography::cleanseString(recordKey, journalKey);
+    if (pos != frame.size())
     {
-        logWarn({"event=vault.index.load.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.load.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=trailing_bytes",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         throw std::runtime_error("Corrupted vault file");
     }
 
-    logInfo({"event=vault.index.load.finish",
+    // Remember where the committed content ends so the next save can
+    // append to it. The state is only trusted while the file on disk is
+    // still exactly what was read here.
+    if (journal && journaled)
+    {
+        journal->path = vaultPath.toStdString();
+        journal->keySalt = keySalt;
+        journal->baseSize = baseEnd;
+        journal->committedSize = committedSize;
+        journal->entries = static_cast<uint32_t>(journalFrames.size());
+        journal->encoding = binary ? VaultEncoding::Binary : VaultEncoding::Hex;
+        journal->valid = fileStamp(journal->path, journal->fileSize, journal->lastWrite) &&
+                         journal->fileSize == static_cast<uint64_t>(fileBytes);
+    }
+
+    SEAL_LOG(qCInfo,
+             logVault,
+             "event=vault.index.load.finish",
              "result=ok",
              seal::diag::kv("op", opId),
              seal::diag::kv("record_count", records.size()),
-             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+             seal::diag::kv("format_version", static_cast<unsigned>(version)),
+             binary ? "encoding=binary" : "encoding=hex",
+             seal::diag::kv("mapped", mapping != nullptr),
+             seal::diag::kv("journal_entries", journalFrames.size()),
+             seal::diag::kv("journal_torn_tail", tornTail),
+             seal::diag::kv("reused_count", reusedCount),
+             seal::diag::kv("key_cache_hit", cacheHit),
+             seal::diag::kv("decrypt_workers", workers),
+             seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
     return records;
 }
 
+// Whether a save may append to the existing file rather than rewrite it:
+// the file must still be exactly what @p journal describes, every live
+// record must already be sealed under its key, and the journal must still
+// be small next to the base frame (otherwise the save compacts).
+static bool canAppendJournal(const VaultJournalState* journal,
+                             const std::string& path,
+                             const std::vector<VaultRecord>& records,
+                             VaultEncoding encoding)
+{
+    if (!journal || !journal->valid || journal->path != path || journal->encoding != encoding)
+        return false;
+    // A torn tail is cleaned up by a rewrite rather than truncated here:
+    // truncation is refused while the file is memory-mapped.
+    if (journal->entries >= kJournalCompactEntries ||
+        journal->committedSize - journal->baseSize >= journal->baseSize ||
+        journal->committedSize != journal->fileSize)
+        return false;
+    for (const auto& rec : records)
+    {
+        if (!rec.deleted && (!rec.keyed || rec.keySalt != journal->keySalt || rec.id == 0))
+            return false;
+    }
+    uint64_t size = 0;
+    uint64_t lastWrite = 0;
+    return fileStamp(path, size, lastWrite) && size == journal->fileSize &&
+           lastWrite == journal->lastWrite;
+}
+
+// Append one journal entry holding every dirty or deleted record at the end
+// of the committed file. The entry only becomes part of the vault once its
+// last byte is on disk: a write interrupted by a crash leaves an entry that
+// fails to frame and is dropped on the next load.
+static bool appendJournalEntry(const std::string& path,
+                               std::vector<VaultRecord>& records,
+                               std::span<const unsigned char> recordKey,
+                               VaultJournalState& journal,
+                               const VaultProgress& progress,
+                               size_t& opCount,
+                               std::string& failReason)
+{
+    const uint32_t seq = journal.entries + 1;
+    const size_t changedCount = static_cast<size_t>(std::count_if(
+        records.begin(), records.end(), [](const VaultRecord& r) { return r.dirty || r.deleted; }));
+
+    std::vector<unsigned char> body;
+    appendU32BE(body, seq);
+    appendU32BE(body, 0);  // op count, patched below
+    for (auto& rec : records)
+    {
+        if (rec.deleted)
+        {
+            body.push_back(kJournalOpDelete);
+            appendU64BE(body, rec.id);
+        }
+        else if (rec.dirty)
+        {
+            rec.encryptedPlatform = encryptString(rec.platform, recordKey);
+            if (rec.encryptedPlatform.size() > std::numeric_limits<uint32_t>::max() ||
+                rec.encryptedBlob.size() > std::numeric_limits<uint32_t>::max())
+            {
+                failReason = "field_too_large";
+                return false;
+            }
+            rec.sealTag = packetTag(rec.encryptedBlob);
+            body.push_back(kJournalOpUpsert);
+            appendU64BE(body, rec.id);
+            appendU32BE(body, static_cast<uint32_t>(rec.encryptedPlatform.size()));
+            body.insert(body.end(), rec.encryptedPlatform.begin(), rec.encryptedPlatform.end());
+            appendU32BE(body, static_cast<uint32_t>(rec.encryptedBlob.size()));
+            body.insert(body.end(), rec.encryptedBlob.begin(), rec.encryptedBlob.end());
+        }
+        else
+        {
+            continue;
+        }
+        ++opCount;
+        if (progress && !progress(opCount, changedCount))
+        {
+            failReason = "cancelled";
+            return false;
+        }
+    }
+    if (opCount == 0)
+        return true;
+    body[4] = static_cast<unsigned char>((opCount >> 24) & 0xFFu);
+    body[5] = static_cast<unsigned char>((opCount >> 16) & 0xFFu);
+    body[6] = static_cast<unsigned char>((opCount >> 8) & 0xFFu);
+    body[7] = static_cast<unsigned char>(opCount & 0xFFu);
+
+    auto journalKey = seal::Cryptography::deriveSubkey(recordKey, kVaultJournalKeyInfo);
+    std::vector<unsigned char> packet;
+    try
+    {
+        packet = seal::Cryptography::encryptWithKey(body, journalKey);
+    }
+    catch (...)
+    {
+        seal::Cryptography::cleanseString(journalKey);
+        throw;
+    }
+    seal::Cryptography::cleanseString(journalKey);
+
+    std::vector<unsigned char> frame;
+    frame.reserve(sizeof(kJournalMagic) + 8 + packet.size());
+    frame.insert(frame.end(), kJournalMagic, kJournalMagic + sizeof(kJournalMagic));
+    appendU32BE(frame, seq);
+    appendU32BE(frame, static_cast<uint32_t>(packet.size()));
+    frame.insert(frame.end(), packet.begin(), packet.end());
+    // Binary vaults take the frame as is; hex vaults one hex line per entry.
+    std::string hexLine;
+    std::span<const unsigned char> bytes(frame);
+    if (journal.encoding == VaultEncoding::Hex)
+    {
+        hexLine = "\n" + seal::utils::to_hex(frame);
+        bytes = std::span<const unsigned char>(
+            reinterpret_cast<const unsigned char*>(hexLine.data()), hexLine.size());
+    }
+    if (bytes.size() > MAXDWORD)
+    {
+        failReason = "field_too_large";
+        return false;
+    }
+
+    HANDLE file = CreateFileA(path.c_str(),
+                              GENERIC_WRITE,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        failReason = "open_failed";
+        return false;
+    }
+    LARGE_INTEGER committed{};
+    committed.QuadPart = static_cast<LONGLONG>(journal.committedSize);
+    DWORD written = 0;
+    const bool ok =
+        SetFilePointerEx(file, committed, nullptr, FILE_BEGIN) &&
+        WriteFile(file, bytes.data(), static_cast<DWORD>(bytes.size()), &written, nullptr) &&
+        written == bytes.size() && FlushFileBuffers(file);
+    CloseHandle(file);
+    if (!ok)
+    {
+        // The file no longer matches the recorded stamp, so the next save
+        // takes the full-rewrite path and replaces whatever was left behind.
+        failReason = "write_failed";
+        return false;
+    }
+
+    journal.committedSize += bytes.size();
+    journal.entries = seq;
+    journal.valid = fileStamp(path, journal.fileSize, journal.lastWrite) &&
+                    journal.fileSize == journal.committedSize;
+    return true;
+}
+
 bool saveVaultV2(
     const QString& vaultPath,
-    const std::vector<VaultRecord>& records,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password)
+    std::vector<VaultRecord>& records,
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache,
+    const VaultProgress& progress,
+    VaultJournalState* journal,
+    VaultEncoding encoding)
 {
     const std::string opId = seal::diag::nextOpId("vault_index_save");
     const auto started = std::chrono::steady_clock::now();
-    const std::string pathMeta = seal::diag::pathSummary(vaultPath.toUtf8().toStdString());
-    auto logInfo = [](std::initializer_list<std::string> fields)
-    { qCInfo(logVault).noquote() << QString::fromStdString(seal::diag::joinFields(fields)); };
-    auto logWarn = [](std::initializer_list<std::string> fields)
-    { qCWarning(logVault).noquote() << QString::fromStdString(seal::diag::joinFields(fields)); };
+    seal::metrics::ScopedTimer timer(seal::metrics::Latency::VaultSave);
+    // Only evaluated inside SEAL_LOG, i.e. when the line is actually logged.
+    auto pathMeta = [&] { return seal::diag::pathSummary(vaultPath.toUtf8().toStdString()); };
 
-    logInfo({"event=vault.index.save.begin",
+    SEAL_LOG(qCInfo,
+             logVault,
+             "event=vault.index.save.begin",
              "result=start",
              seal::diag::kv("op", opId),
              seal::diag::kv("record_count", records.size()),
-             pathMeta});
+             pathMeta());
 
-    // Atomic save: write to a temporary file, flush, then rename over the target.
-    // This prevents data loss if the process crashes mid-write.
     std::string finalPath = vaultPath.toStdString();
+
+    // Incremental save: append one journal entry with just the changed
+    // records, costing crypto and I/O proportional to the change.
+    if (canAppendJournal(journal, finalPath, records, encoding))
+    {
+        size_t opCount = 0;
+        std::string failReason;
+        bool ok = false;
+        Cryptography::LockedKeyBuffer recordKey;
+        try
+        {
+            recordKey = sealingRecordKey(password, journal->keySalt, records, keyCache);
+            ok = appendJournalEntry(
+                finalPath, records, recordKey, *journal, progress, opCount, failReason);
+        }
+        catch (const std::exception& e)
+        {
+            failReason = "append_failed";
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.save.journal",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())));
+        }
+        seal::Cryptography::cleanseString(recordKey);
+        if (!ok)
+        {
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.save.finish",
+                     "result=fail",
+                     seal::diag::kv("op", opId),
+                     "mode=append",
+                     "reason=" + failReason,
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+            return false;
+        }
+        SEAL_LOG(qCInfo,
+                 logVault,
+                 "event=vault.index.save.finish",
+                 "result=ok",
+                 seal::diag::kv("op", opId),
+                 "mode=append",
+                 seal::diag::kv("changed_count", opCount),
+                 seal::diag::kv("journal_entries", journal->entries),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+        return true;
+    }
+
+    // Full save: write the compacted base frame to a temporary file, flush,
+    // then rename over the target. This prevents data loss if the process
+    // crashes mid-write, and folds any journal back into the base.
     std::string tmpPath = finalPath + ".tmp";
 
     std::ofstream out(tmpPath, std::ios::out | std::ios::trunc | std::ios::binary);
     if (!out)
     {
-        logWarn({"event=vault.index.save.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.save.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=open_temp_failed",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         return false;
     }
 
     struct SerializedRecord
     {
+        size_t index = 0;  ///< Position in records
+        uint64_t id = 0;
         std::vector<unsigned char> platform;
         std::vector<unsigned char> credential;
+        size_t credentialOffset = 0;  ///< Where the packet lands in the new frame
     };
 
+    // One key derivation covers every record in the file. Records sealed
+    // under another key (version 1 packets, or a vault merged from another
+    // file) are re-sealed under this one; each distinct foreign salt costs
+    // one extra derivation, each version 1 record one scrypt.
     std::vector<SerializedRecord> serialized;
     serialized.reserve(records.size());
-    for (const auto& rec : records)
+    const size_t liveCount = static_cast<size_t>(std::count_if(
+        records.begin(), records.end(), [](const VaultRecord& r) { return !r.deleted; }));
+    size_t migratedCount = 0;
+    std::array<unsigned char, seal::cfg::KDF_SALT_LEN> keySalt{};
+    Cryptography::LockedKeyBuffer recordKey;
+    std::vector<std::pair<std::array<unsigned char, seal::cfg::KDF_SALT_LEN>,
+                          Cryptography::LockedKeyBuffer>>
+        foreignKeys;
+    try
     {
-        if (rec.deleted)
-            continue;
+        keySalt = vaultKeySalt(records);
+        recordKey = sealingRecordKey(password, keySalt, records, keyCache);
 
-        // Use existing encrypted platform if available, otherwise encrypt it
-        std::vector<unsigned char> platformBlob;
-        if (!rec.encryptedPlatform.empty() && !rec.dirty)
-        {
-            platformBlob = rec.encryptedPlatform;
-        }
-        else
+        for (auto& rec : records)
         {
-            platformBlob = encryptString(rec.platform, password);
-        }
+            if (rec.deleted)
+                continue;
 
-        if (platformBlob.size() > std::numeric_limits<uint32_t>::max() ||
-            rec.encryptedBlob.size() > std::numeric_limits<uint32_t>::max())
-        {
-            logWarn({"event=vault.index.save.finish",
-                     "result=fail",
-                     seal::diag::kv("op", opId),
-                     "reason=field_too_large",
-                     seal::diag::kv("platform_blob_len", platformBlob.size()),
-                     seal::diag::kv("credential_blob_len", rec.encryptedBlob.size()),
-                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
-            out.close();
-            DeleteFileA(tmpPath.c_str());
-            return false;
-        }
+            if (!rec.keyed || rec.keySalt != keySalt)
+            {
+                std::vector<unsigned char> credPlain;
+                if (!rec.keyed)
+                {
+                    const auto packet = credentialPacket(rec);
+                    credPlain = seal::Cryptography::decryptPacket(
+                        std::span<const unsigned char>(packet), password);
+                }
+                else
+                {
+                    auto it = std::find_if(foreignKeys.begin(),
+                                           foreignKeys.end(),
+                                           [&](const auto& entry)
+                                           { return entry.first == rec.keySalt; });
+                    if (it == foreignKeys.end())
+                    {
+                        bool foreignHit = false;
+                        foreignKeys.emplace_back(
+                            rec.keySalt,
+                            cachedRecordKey(password, rec.keySalt, keyCache, foreignHit));
+                        it = std::prev(foreignKeys.end());
+                    }
+                    const auto packet = credentialPacket(rec);
+                    credPlain = seal::Cryptography::decryptWithKey(
+                        std::span<const unsigned char>(packet), it->second);
+                }
+                rec.encryptedBlob = seal::Cryptography::encryptWithKey(credPlain, recordKey);
+                rec.mapping.reset();
+                seal::Cryptography::cleanseString(credPlain);
+                rec.encryptedPlatform = encryptString(rec.platform, recordKey);
+                rec.keySalt = keySalt;
+                rec.keyed = true;
+                ++migratedCount;
+            }
+            else if (rec.encryptedPlatform.empty() || rec.dirty)
+            {
+                rec.encryptedPlatform = encryptString(rec.platform, recordKey);
+            }
+
+            if (rec.encryptedPlatform.size() > std::numeric_limits<uint32_t>::max() ||
+                credentialPacketSize(rec) > std::numeric_limits<uint32_t>::max())
+            {
+                SEAL_LOG(qCWarning,
+                         logVault,
+                         "event=vault.index.save.finish",
+                         "result=fail",
+                         seal::diag::kv("op", opId),
+                         "reason=field_too_large",
+                         seal::diag::kv("platform_blob_len", rec.encryptedPlatform.size()),
+                         seal::diag::kv("credential_blob_len", credentialPacketSize(rec)),
+                         seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+                out.close();
+                DeleteFileA(tmpPath.c_str());
+                return false;
+            }
 
-        serialized.push_back({std::move(platformBlob), rec.encryptedBlob});
+            if (rec.id == 0)
+                rec.id = newRecordId();
+            serialized.push_back({static_cast<size_t>(&rec - records.data()),
+                                  rec.id,
+                                  rec.encryptedPlatform,
+                                  credentialPacket(rec)});
+            rec.sealTag = packetTag(serialized.back().credential);
+            if (progress && !progress(serialized.size(), liveCount))
+            {
+                SEAL_LOG(qCWarning,
+                         logVault,
+                         "event=vault.index.save.finish",
+                         "result=fail",
+                         seal::diag::kv("op", opId),
+                         "reason=cancelled",
+                         seal::diag::kv("serialized_count", serialized.size()),
+                         seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+                out.close();
+                DeleteFileA(tmpPath.c_str());
+                return false;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // Typically a version 1 record that does not open with this password.
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.save.finish",
+                 "result=fail",
+                 seal::diag::kv("op", opId),
+                 "reason=migration_failed",
+                 seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
+        out.close();
+        DeleteFileA(tmpPath.c_str());
+        return false;
     }
+    seal::Cryptography::cleanseString(recordKey);
+    foreignKeys.clear();
 
     if (serialized.size() > std::numeric_limits<uint32_t>::max())
     {
-        logWarn({"event=vault.index.save.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.save.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=too_many_records",
                  seal::diag::kv("serialized_count", serialized.size()),
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         out.close();
         DeleteFileA(tmpPath.c_str());
         return false;
@@ -395,9 +1916,14 @@ bool saveVaultV2(
 
     // Build the binary frame: magic + version + count + records (same layout
     // that loadVaultIndex expects to parse back).
-    size_t framedSize = 4 + 1 + 4;  // magic(4) + version(1) + entryCount(4)
+    // Default KDF parameters keep the version 3 header, which they imply.
+    const auto kdf = seal::KdfParams::decode(std::span(keySalt).subspan(seal::cfg::SALT_LEN));
+    const bool legacyKdf = !kdf || kdf->isLegacy();
+    const size_t keyIdLen = legacyKdf ? seal::cfg::SALT_LEN : seal::cfg::KDF_SALT_LEN;
+    size_t framedSize = 4 + 1 + keyIdLen + 4;  // magic + version + salt[+kdf] + entryCount
     for (const auto& rec : serialized)
     {
+        framedSize += 8;                          // id
         framedSize += 4 + rec.platform.size();    // platformLen + platformBlob
         framedSize += 4 + rec.credential.size();  // credLen + credBlob
     }
@@ -405,19 +1931,32 @@ bool saveVaultV2(
     std::vector<unsigned char> framed;
     framed.reserve(framedSize);
     framed.insert(framed.end(), kVaultMagic, kVaultMagic + sizeof(kVaultMagic));
-    framed.push_back(kVaultFormatVersion);
+    framed.push_back(legacyKdf ? kVaultFormatVersion : kVaultFormatKdf);
+    framed.insert(framed.end(), keySalt.begin(), keySalt.begin() + keyIdLen);
     appendU32BE(framed, static_cast<uint32_t>(serialized.size()));
-    for (const auto& rec : serialized)
+    for (auto& rec : serialized)
     {
+        appendU64BE(framed, rec.id);
         appendU32BE(framed, static_cast<uint32_t>(rec.platform.size()));
         framed.insert(framed.end(), rec.platform.begin(), rec.platform.end());
         appendU32BE(framed, static_cast<uint32_t>(rec.credential.size()));
+        rec.credentialOffset = framed.size();
         framed.insert(framed.end(), rec.credential.begin(), rec.credential.end());
     }
 
     // Hex-encode the entire binary frame so the file is plain text on disk.
-    const std::string hexBlob = seal::utils::to_hex(framed);
-    out.write(hexBlob.data(), static_cast<std::streamsize>(hexBlob.size()));
+    // Binary is written as framed. The hex export encodes the whole frame
+    // as a single line of plain text.
+    std::string hexBlob;
+    std::span<const unsigned char> bytes(framed);
+    if (encoding == VaultEncoding::Hex)
+    {
+        hexBlob = seal::utils::to_hex(framed);
+        bytes = std::span<const unsigned char>(
+            reinterpret_cast<const unsigned char*>(hexBlob.data()), hexBlob.size());
+    }
+    out.write(reinterpret_cast<const char*>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
     out.flush();
     bool ok = out.good();
     out.close();
@@ -428,31 +1967,95 @@ bool saveVaultV2(
         // MoveFileExA with MOVEFILE_REPLACE_EXISTING performs an atomic rename
         // on NTFS, so readers never see a half-written vault.  MOVEFILE_COPY_ALLOWED
         // is a fallback that lets the OS copy+delete if src/dst are on different volumes.
-        if (!MoveFileExA(tmpPath.c_str(),
-                         finalPath.c_str(),
-                         MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED))
+        auto replaceTarget = [&]()
+        {
+            return MoveFileExA(tmpPath.c_str(),
+                               finalPath.c_str(),
+                               MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED) != 0;
+        };
+        // A mapped target cannot be replaced, so the swap runs with the
+        // view unmapped, under the mapping's lock.
+        std::shared_ptr<VaultMapping> targetMapping;
+        for (const auto& rec : records)
         {
-            logWarn({"event=vault.index.save.finish",
+            if (rec.mapping && rec.mapping->path() == finalPath)
+            {
+                targetMapping = rec.mapping;
+                break;
+            }
+        }
+        if (!(targetMapping ? targetMapping->replaceFile(replaceTarget) : replaceTarget()))
+        {
+            SEAL_LOG(qCWarning,
+                     logVault,
+                     "event=vault.index.save.finish",
                      "result=fail",
                      seal::diag::kv("op", opId),
                      "reason=rename_failed",
-                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                     seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
             DeleteFileA(tmpPath.c_str());
             return false;
         }
-        logInfo({"event=vault.index.save.finish",
+        // Records that read from the replaced file now point at their packet
+        // in the new binary frame, dropping any heap copies. A hex file
+        // cannot be mapped, so they keep the packet copied out during the save.
+        if (targetMapping)
+        {
+            const bool rebind = encoding == VaultEncoding::Binary && targetMapping->mapped();
+            const uint32_t generation = targetMapping->generation();
+            for (auto& ser : serialized)
+            {
+                VaultRecord& rec = records[ser.index];
+                if (rebind)
+                {
+                    rec.mapping = targetMapping;
+                    rec.blobOffset = ser.credentialOffset;
+                    rec.blobSize = static_cast<uint32_t>(ser.credential.size());
+                    rec.mappingGeneration = generation;
+                    std::vector<unsigned char>().swap(rec.encryptedBlob);
+                    std::vector<unsigned char>().swap(rec.encryptedPlatform);
+                }
+                else if (rec.mapping)
+                {
+                    rec.encryptedBlob = std::move(ser.credential);
+                    rec.mapping.reset();
+                }
+            }
+        }
+
+        // The fresh base frame is the whole committed file; later saves
+        // append journal entries after it.
+        if (journal)
+        {
+            *journal = {};
+            journal->path = finalPath;
+            journal->keySalt = keySalt;
+            journal->encoding = encoding;
+            journal->baseSize = bytes.size();
+            journal->committedSize = bytes.size();
+            journal->valid = fileStamp(finalPath, journal->fileSize, journal->lastWrite) &&
+                             journal->fileSize == bytes.size();
+        }
+        SEAL_LOG(qCInfo,
+                 logVault,
+                 "event=vault.index.save.finish",
                  "result=ok",
                  seal::diag::kv("op", opId),
+                 "mode=rewrite",
+                 encoding == VaultEncoding::Hex ? "encoding=hex" : "encoding=binary",
                  seal::diag::kv("record_count", serialized.size()),
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("migrated_count", migratedCount),
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
     }
     else
     {
-        logWarn({"event=vault.index.save.finish",
+        SEAL_LOG(qCWarning,
+                 logVault,
+                 "event=vault.index.save.finish",
                  "result=fail",
                  seal::diag::kv("op", opId),
                  "reason=write_failed",
-                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+                 seal::diag::kv("duration_ms", seal::diag::elapsedMs(started)));
         DeleteFileA(tmpPath.c_str());
     }
     return ok;
@@ -460,16 +2063,16 @@ bool saveVaultV2(
 
 DecryptedCredential decryptCredentialOnDemand(
     const VaultRecord& record,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password)
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache)
 {
     qCDebug(logVault).noquote() << QString::fromStdString(seal::diag::joinFields(
         {"event=credential.decrypt.begin",
          seal::diag::kv("platform_len", record.platform.size()),
-         seal::diag::kv("encrypted_blob_len", record.encryptedBlob.size())}));
+         seal::diag::kv("encrypted_blob_len", credentialPacketSize(record))}));
     // The encrypted credential blob contains "username\0password" -- a single
     // null byte separates the two fields inside the decrypted plaintext.
-    auto plainBytes = seal::Cryptography::decryptPacket(
-        std::span<const unsigned char>(record.encryptedBlob), password);
+    auto plainBytes = openCredentialBlob(record, password, keyCache);
 
     const char* data = reinterpret_cast<const char*>(plainBytes.data());
     size_t len = plainBytes.size();
@@ -491,7 +2094,7 @@ DecryptedCredential decryptCredentialOnDemand(
             {"event=credential.decrypt.finish",
              "result=fail",
              "reason=malformed_blob",
-             seal::diag::kv("encrypted_blob_len", record.encryptedBlob.size())}));
+             seal::diag::kv("encrypted_blob_len", credentialPacketSize(record))}));
         seal::Cryptography::cleanseString(plainBytes);
         throw std::runtime_error("Malformed credential blob");
     }
@@ -528,10 +2131,15 @@ VaultRecord encryptCredential(
     const std::string& platform,
     const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& username,
     const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPassword)
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPassword,
+    std::span<const unsigned char> keySalt,
+    std::span<const VaultRecord> vaultRecords,
+    VaultKeyCache* keyCache)
 {
     qCDebug(logVault).noquote() << QString::fromStdString(seal::diag::joinFields(
         {"event=credential.encrypt.begin", seal::diag::kv("platform_len", platform.size())}));
+    if (keySalt.size() != seal::cfg::KDF_SALT_LEN)
+        throw std::runtime_error("Invalid vault key salt");
     // Convert wide-char credentials to UTF-8 for the on-disk format.
     std::string userUtf8 = seal::utils::secureWideToUtf8(username);
     std::string passUtf8 = seal::utils::secureWideToUtf8(password);
@@ -547,19 +2155,31 @@ VaultRecord encryptCredential(
     wipeStdString(userUtf8);
     wipeStdString(passUtf8);
 
-    // Encrypt the combined credential blob with the master password.
-    auto credBlob = seal::Cryptography::encryptPacket(
-        std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(credPlain.data()),
-                                       credPlain.size()),
-        masterPassword);
+    // Seal both packets under the vault key: one derivation for the pair.
+    std::vector<unsigned char> credBlob, platformBlob;
+    Cryptography::LockedKeyBuffer recordKey;
+    try
+    {
+        recordKey = sealingRecordKey(masterPassword, keySalt, vaultRecords, keyCache);
+        credBlob = encryptString(credPlain, recordKey);
+        platformBlob = encryptString(platform, recordKey);
+    }
+    catch (...)
+    {
+        wipeStdString(credPlain);
+        seal::Cryptography::cleanseString(recordKey);
+        throw;
+    }
     wipeStdString(credPlain);
-
-    auto platformBlob = encryptString(platform, masterPassword);
+    seal::Cryptography::cleanseString(recordKey);
 
     VaultRecord rec;
     rec.platform = platform;
     rec.encryptedPlatform = std::move(platformBlob);
     rec.encryptedBlob = std::move(credBlob);
+    std::copy_n(keySalt.begin(), rec.keySalt.size(), rec.keySalt.begin());
+    rec.id = newRecordId();
+    rec.keyed = true;
     rec.dirty = true;
     rec.deleted = false;
     qCDebug(logVault).noquote() << QString::fromStdString(
@@ -570,6 +2190,370 @@ VaultRecord encryptCredential(
     return rec;
 }
 
+size_t rotateCredentialPasswords(
+    std::vector<VaultRecord>& records,
+    std::span<const size_t> indices,
+    int length,
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPassword,
+    std::span<const unsigned char> keySalt,
+    VaultKeyCache* keyCache)
+{
+    if (keySalt.size() != seal::cfg::KDF_SALT_LEN)
+        throw std::runtime_error("Invalid vault key salt");
+    std::array<unsigned char, seal::cfg::KDF_SALT_LEN> vaultSalt{};
+    std::copy_n(keySalt.begin(), vaultSalt.size(), vaultSalt.begin());
+
+    std::vector<size_t> targets;
+    targets.reserve(indices.size());
+    for (size_t index : indices)
+    {
+        if (index < records.size() && !records[index].deleted)
+            targets.push_back(index);
+    }
+    if (targets.empty())
+        return 0;
+
+    const auto started = std::chrono::steady_clock::now();
+    const PasswordBatch batch = GeneratePasswords(targets.size(), length);
+
+    // Packets for every target are built first and swapped in at the end,
+    // so a record that fails to open leaves the whole batch unapplied.
+    struct Sealed
+    {
+        size_t index;
+        std::vector<unsigned char> credential;
+        std::vector<unsigned char> platform;
+    };
+    std::vector<Sealed> sealed;
+    sealed.reserve(targets.size());
+
+    auto recordKey = sealingRecordKey(masterPassword, vaultSalt, records, keyCache);
+    try
+    {
+        for (size_t k = 0; k < targets.size(); ++k)
+        {
+            const VaultRecord& rec = records[targets[k]];
+            std::vector<unsigned char> plainBytes;
+            if (rec.keyed && rec.keySalt == vaultSalt)
+            {
+                const auto packet = credentialPacket(rec);
+                plainBytes = seal::Cryptography::decryptWithKey(
+                    std::span<const unsigned char>(packet), recordKey);
+            }
+            else
+            {
+                plainBytes = openCredentialBlob(rec, masterPassword, keyCache);
+            }
+
+            const char* data = reinterpret_cast<const char*>(plainBytes.data());
+            const auto sep = std::find(data, data + plainBytes.size(), '\0');
+            if (sep == data + plainBytes.size())
+            {
+                seal::Cryptography::cleanseString(plainBytes);
+                throw std::runtime_error("Malformed credential blob");
+            }
+
+            // Keep "username\0" and replace everything after the separator.
+            const std::string_view password = batch.password(k);
+            std::string credPlain;
+            credPlain.reserve(static_cast<size_t>(sep - data) + 1 + password.size());
+            credPlain.append(data, sep + 1);
+            credPlain.append(password);
+            seal::Cryptography::cleanseString(plainBytes);
+            try
+            {
+                sealed.push_back({targets[k],
+                                  encryptString(credPlain, recordKey),
+                                  encryptString(rec.platform, recordKey)});
+            }
+            catch (...)
+            {
+                wipeStdString(credPlain);
+                throw;
+            }
+            wipeStdString(credPlain);
+        }
+    }
+    catch (...)
+    {
+        seal::Cryptography::cleanseString(recordKey);
+        qCWarning(logVault).noquote() << QString::fromStdString(
+            seal::diag::joinFields({"event=credential.rotate.finish",
+                                    "result=fail",
+                                    seal::diag::kv("records", targets.size()),
+                                    seal::diag::kv("opened", sealed.size())}));
+        throw;
+    }
+    seal::Cryptography::cleanseString(recordKey);
+
+    for (auto& s : sealed)
+    {
+        VaultRecord& rec = records[s.index];
+        rec.encryptedBlob = std::move(s.credential);
+        rec.encryptedPlatform = std::move(s.platform);
+        rec.mapping.reset();
+        rec.keySalt = vaultSalt;
+        rec.keyed = true;
+        rec.dirty = true;
+        rec.audit = 0;
+    }
+    qCInfo(logVault).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=credential.rotate.finish",
+                                "result=ok",
+                                seal::diag::kv("records", sealed.size()),
+                                seal::diag::kv("key_cache_hit", cacheHit),
+                                seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+    return sealed.size();
+}
+
+std::vector<VaultRecord> detachedCopies(const std::vector<VaultRecord>& records,
+                                        std::span<const size_t> indices)
+{
+    std::vector<VaultRecord> copies;
+    copies.reserve(indices.size());
+    for (size_t index : indices)
+    {
+        if (index >= records.size() || records[index].deleted)
+            continue;
+        const VaultRecord& src = records[index];
+        VaultRecord rec;
+        rec.platform = src.platform;
+        rec.encryptedPlatform = src.encryptedPlatform;
+        rec.encryptedBlob = credentialPacket(src);
+        rec.keySalt = src.keySalt;
+        rec.id = newRecordId();
+        rec.keyed = src.keyed;
+        rec.dirty = true;
+        copies.push_back(std::move(rec));
+    }
+    return copies;
+}
+
+std::vector<uint8_t> auditCredentials(
+    const std::vector<VaultRecord>& records,
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache,
+    const BreachIndex* breaches,
+    const VaultProgress& progress,
+    VaultAuditSummary* summary)
+{
+    using Digest = std::array<unsigned char, 20>;
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<size_t> live;
+    live.reserve(records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        if (!records[i].deleted)
+            live.push_back(i);
+    }
+
+    // One digest per live record, in locked memory: an unsalted SHA-1 of a
+    // weak password is as good as the password. hasPassword[k] is false for
+    // an empty one.
+    std::vector<Digest, seal::locked_allocator<Digest>> digests(live.size());
+    std::vector<uint8_t> hasPassword(live.size(), 0);
+    auto wipeDigests = [&] { SecureZeroMemory(digests.data(), digests.size() * sizeof(Digest)); };
+    auto hashOne = [&](size_t k)
+    {
+        std::vector<unsigned char> plainBytes =
+            openCredentialBlob(records[live[k]], password, keyCache);
+        const auto sep = std::find(plainBytes.begin(), plainBytes.end(), '\0');
+        if (sep == plainBytes.end())
+        {
+            seal::Cryptography::cleanseString(plainBytes);
+            throw std::runtime_error("Malformed credential blob");
+        }
+        const std::span<const unsigned char> pass(std::next(sep), plainBytes.end());
+        if (!pass.empty())
+        {
+            BreachIndex::sha1(pass, digests[k]);
+            hasPassword[k] = 1;
+        }
+        seal::Cryptography::cleanseString(plainBytes);
+    };
+
+    // Record 0 runs alone so its key derivation lands in the cache (and a
+    // wrong password fails) before the fan-out.
+    try
+    {
+        if (!live.empty())
+            hashOne(0);
+        if (live.size() > 1)
+        {
+            std::atomic<bool> failed{false};
+            std::atomic<bool> cancelled{false};
+            std::atomic<size_t> done{1};
+            QThreadPool pool;
+            QtConcurrent::blockingMap(&pool,
+                                      digests.begin() + 1,
+                                      digests.end(),
+                                      [&](Digest& digest)
+                                      {
+                                          const size_t k = &digest - digests.data();
+                                          if (failed.load(std::memory_order_relaxed) ||
+                                              cancelled.load(std::memory_order_relaxed))
+                                              return;
+                                          try
+                                          {
+                                              hashOne(k);
+                                          }
+                                          catch (const std::exception&)
+                                          {
+                                              failed.store(true, std::memory_order_relaxed);
+                                              return;
+                                          }
+                                          const size_t n = done.fetch_add(1) + 1;
+                                          if (progress && !progress(n, live.size()))
+                                              cancelled.store(true, std::memory_order_relaxed);
+                                      });
+            if (failed.load())
+                throw std::runtime_error("Wrong password");
+            if (cancelled.load())
+                throw std::runtime_error("Operation cancelled");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        wipeDigests();
+        qCWarning(logVault).noquote() << QString::fromStdString(seal::diag::joinFields(
+            {"event=vault.audit.finish",
+             "result=fail",
+             seal::diag::kv("records", live.size()),
+             seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what()))}));
+        throw;
+    }
+
+    std::vector<uint8_t> flags(records.size(), 0);
+    VaultAuditSummary totals;
+    std::vector<size_t> order;
+    order.reserve(live.size());
+    for (size_t k = 0; k < live.size(); ++k)
+    {
+        if (!hasPassword[k])
+            continue;
+        order.push_back(k);
+        ++totals.checked;
+        if (breaches && breaches->contains(digests[k]))
+        {
+            flags[live[k]] |= AuditBreached;
+            ++totals.breached;
+        }
+    }
+    // Equal passwords have equal digests, so sorting groups the reuse.
+    std::sort(order.begin(),
+              order.end(),
+              [&](size_t a, size_t b) { return digests[a] < digests[b]; });
+    for (size_t first = 0; first < order.size();)
+    {
+        size_t last = first + 1;
+        while (last < order.size() && digests[order[last]] == digests[order[first]])
+            ++last;
+        if (last - first > 1)
+        {
+            ++totals.reuseGroups;
+            totals.reused += last - first;
+            for (size_t j = first; j < last; ++j)
+                flags[live[order[j]]] |= AuditReused;
+        }
+        first = last;
+    }
+    wipeDigests();
+
+    qCInfo(logVault).noquote() << QString::fromStdString(
+        seal::diag::joinFields({"event=vault.audit.finish",
+                                "result=ok",
+                                seal::diag::kv("records", totals.checked),
+                                seal::diag::kv("breach_index", breaches != nullptr),
+                                seal::diag::kv("breached", totals.breached),
+                                seal::diag::kv("reused", totals.reused),
+                                seal::diag::kv("reuse_groups", totals.reuseGroups),
+                                seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))}));
+    if (summary)
+        *summary = totals;
+    return flags;
+}
+
+bool vaultFileChanged(const VaultJournalState& journal)
+{
+    if (!journal.valid)
+        return false;
+    uint64_t size = 0;
+    uint64_t lastWrite = 0;
+    return !fileStamp(journal.path, size, lastWrite) || size != journal.fileSize ||
+           lastWrite != journal.lastWrite;
+}
+
+VaultMergeResult mergeReloadedRecords(std::vector<VaultRecord>& records,
+                                      std::vector<VaultRecord> fresh)
+{
+    VaultMergeResult result;
+    std::unordered_map<uint64_t, size_t> freshById;
+    freshById.reserve(fresh.size());
+    for (size_t i = 0; i < fresh.size(); ++i)
+        freshById.emplace(fresh[i].id, i);
+
+    std::vector<bool> matched(fresh.size(), false);
+    std::vector<VaultRecord> merged;
+    std::vector<VaultRecord> conflicted;
+    merged.reserve(std::max(records.size(), fresh.size()));
+    for (auto& rec : records)
+    {
+        const bool unsaved = rec.dirty || rec.deleted;
+        auto it = freshById.find(rec.id);
+        if (it == freshById.end())
+        {
+            // Gone from disk. A clean record follows; an unsaved edit of a
+            // record the other side deleted is kept, and a record deleted on
+            // both sides needs nothing more.
+            if (!unsaved)
+            {
+                ++result.removed;
+                continue;
+            }
+            if (rec.deleted)
+                continue;
+            if (rec.sealTag != 0)
+                ++result.kept;
+            merged.push_back(std::move(rec));
+            continue;
+        }
+
+        VaultRecord& disk = fresh[it->second];
+        matched[it->second] = true;
+        if (!unsaved)
+        {
+            if (disk.sealTag != rec.sealTag)
+                ++result.updated;
+            else
+                disk.audit = rec.audit;
+            merged.push_back(std::move(disk));
+            continue;
+        }
+        // Changed here and re-sealed on disk since it was last read: keep
+        // the local version and save the disk one beside it.
+        if (disk.sealTag != rec.sealTag)
+        {
+            ++result.conflicts;
+            disk.platform += " (conflicted copy)";
+            disk.id = newRecordId();
+            disk.sealTag = 0;
+            disk.dirty = true;
+            conflicted.push_back(std::move(disk));
+        }
+        merged.push_back(std::move(rec));
+    }
+    for (size_t i = 0; i < fresh.size(); ++i)
+    {
+        if (matched[i])
+            continue;
+        ++result.added;
+        merged.push_back(std::move(fresh[i]));
+    }
+    std::move(conflicted.begin(), conflicted.end(), std::back_inserter(merged));
+    records = std::move(merged);
+    return result;
+}
+
 int encryptDirectory(
     const QString& dirPath,
     const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password)
@@ -610,10 +2594,12 @@ int encryptDirectory(
             filePaths.push_back(entry.path().string());
         }
 
+        // One keyring for the run: scrypt once, per-file keys via HKDF.
+        FileKeyring keyring;
         for (const auto& filePath : filePaths)
         {
             std::string newPath = filePath + ".seal";
-            if (FileOperations::encryptFileTo(filePath, newPath, password))
+            if (FileOperations::encryptFileTo(filePath, newPath, password, 1, &keyring))
             {
                 DeleteFileA(filePath.c_str());
                 count++;
@@ -683,10 +2669,13 @@ int decryptDirectory(
             filePaths.push_back(entry.path().string());
         }
 
+        // Files from one encrypt run share a salt, so the keyring derives
+        // its master key once for all of them.
+        FileKeyring keyring;
         for (const auto& filePath : filePaths)
         {
             std::string newPath = seal::utils::strip_ext_ci(filePath, ".seal");
-            if (FileOperations::decryptFileTo(filePath, newPath, password))
+            if (FileOperations::decryptFileTo(filePath, newPath, password, 1, &keyring))
             {
                 DeleteFileA(filePath.c_str());
                 count++;
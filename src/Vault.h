@@ -4,6 +4,15 @@
 
 #include <QtCore/QString>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -12,6 +21,95 @@
 namespace seal
 {
 
+class BreachIndex;
+
+/**
+ * @class VaultMapping
+ * @brief Read-only memory mapping of a binary vault file.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Vault
+ *
+ * Records loaded with VaultLoadMode::Mapped keep only the offset of their
+ * credential packet and copy it out of the mapping when it is decrypted.
+ * The packets then live in clean, file-backed pages the OS can drop under
+ * memory pressure rather than in private heap copies, so the working set
+ * follows the records actually used instead of the vault size.
+ *
+ * A mapped file cannot be replaced, so a full save swaps the file through
+ * replaceFile() and maps the new one. Every swap advances generation();
+ * offsets taken under an older generation are refused rather than read
+ * from the wrong file. All members are safe to call from worker threads.
+ *
+ * @see loadVaultIndex, saveVaultV2
+ */
+class VaultMapping
+{
+public:
+    /**
+     * @brief Map @p path read-only.
+     * @param path Vault file path (ANSI, as passed to the Win32 `A` APIs).
+     * @throw std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit VaultMapping(std::string path);
+
+    /// @brief Destructor. Unmaps the view and closes the file.
+    ~VaultMapping();
+
+    VaultMapping(const VaultMapping&) = delete;
+    VaultMapping& operator=(const VaultMapping&) = delete;
+
+    /// @brief Path of the mapped file.
+    [[nodiscard]] const std::string& path() const { return m_Path; }
+
+    /// @brief Current generation; advanced by each replaceFile().
+    [[nodiscard]] uint32_t generation() const;
+
+    /// @brief Whether a view is currently mapped.
+    [[nodiscard]] bool mapped() const;
+
+    /**
+     * @brief The whole view, for parsing right after construction.
+     * @warning Only valid until the next replaceFile().
+     */
+    [[nodiscard]] std::span<const unsigned char> bytes() const;
+
+    /**
+     * @brief Copy @p size bytes at @p offset out of the view.
+     * @param offset     Byte offset into the file.
+     * @param size       Number of bytes.
+     * @param generation Generation the offset was taken under.
+     * @throw std::runtime_error if the range is outside the view or
+     *        @p generation is stale.
+     */
+    [[nodiscard]] std::vector<unsigned char> copy(uint64_t offset,
+                                                  uint32_t size,
+                                                  uint32_t generation) const;
+
+    /**
+     * @brief Unmap, run @p replace to swap the file on disk, then map again.
+     *
+     * Readers block for the duration. The file at path() is remapped
+     * whether or not @p replace succeeds; the generation only advances
+     * when it does.
+     *
+     * @param replace Callback performing the swap; returns `true` on success.
+     * @return Result of @p replace.
+     */
+    bool replaceFile(const std::function<bool()>& replace);
+
+private:
+    bool map();
+    void unmap();
+
+    std::string m_Path;
+    mutable std::shared_mutex m_Mutex;
+    void* m_File = nullptr;     ///< HANDLE of the open file.
+    void* m_Section = nullptr;  ///< HANDLE of the file mapping object.
+    const unsigned char* m_View = nullptr;
+    uint64_t m_Size = 0;
+    uint32_t m_Generation = 0;
+};
+
 /**
  * @struct VaultRecord
  * @brief One record in the vault index.
@@ -22,7 +120,7 @@ namespace seal
  * as separate AES-256-GCM packets.  The cleartext platform is held
  * in memory only (decrypted on load) so the UI can list accounts.
  *
- * Binary format:
+ * Binary format (version 3; version 4 adds `kdf(4)` after the salt):
  *
  * ```mermaid
  * ---
@@ -30,10 +128,12 @@ namespace seal
  *   theme: dark
  * ---
  * block-beta
- *   columns 8
+ *   columns 10
  *   magic["magic(4)"]:1
  *   ver["ver(1)"]:1
+ *   salt["salt(16)"]:1
  *   count["count(4)"]:1
+ *   id["id(8)"]:1
  *   pLen["platLen(4)"]:1
  *   pBlob["platform packet"]:1
  *   cLen["credLen(4)"]:1
@@ -41,8 +141,21 @@ namespace seal
  *   more["..."]:1
  * ```
  *
- * The binary payload is hex-encoded as a single line when stored on disk;
- * loadVaultIndex() decodes the hex before parsing the binary framing.
+ * The header salt feeds a single scrypt run that yields the vault key;
+ * an HKDF expand of that key seals every packet with its own random IV
+ * (see Cryptography::encryptWithKey).  Version 4 files follow the salt
+ * with the four KdfParams bytes it is derived under; they are written only
+ * when those differ from the legacy scrypt defaults, which version 3
+ * implies.  Version 2 files are identical to version 3 without the record
+ * ids.  Version 1 files have no header salt and carry self-salted packets
+ * instead (one scrypt per packet).  Both are still read and are migrated
+ * on the next save.
+ *
+ * Vaults are stored as the raw binary frame, which loadVaultIndex() parses
+ * in place.  The older encoding -- the frame hex-encoded as a single line of
+ * text -- is still read and can be written on request (VaultEncoding::Hex).
+ * Version 3 frames may be followed by journal entries, each one sealed set
+ * of upserts and deletes keyed by record id (see saveVaultV2()).
  *
  * @see loadVaultIndex, encryptCredential
  */
@@ -55,8 +168,18 @@ struct VaultRecord
     std::string platform;
     std::vector<unsigned char> encryptedPlatform;  ///< AES-256-GCM packet of platform name
     std::vector<unsigned char> encryptedBlob;      ///< AES-256-GCM packet of "username\0password"
-    bool dirty = false;                            ///< True if created or modified since last save
-    bool deleted = false;                          ///< Soft-deleted; skipped on save and display
+    std::array<unsigned char, seal::cfg::KDF_SALT_LEN> keySalt{};  ///< Vault key id (when keyed)
+    uint64_t id = 0;       ///< Stable record id; journal entries refer to records by it
+    uint64_t sealTag = 0;  ///< Credential packet tag as last read or written; 0 if never on disk
+    /// Mapped records leave encryptedBlob empty and read the packet from here.
+    std::shared_ptr<VaultMapping> mapping;
+    uint64_t blobOffset = 0;         ///< Credential packet offset in @c mapping
+    uint32_t blobSize = 0;           ///< Credential packet size in @c mapping
+    uint32_t mappingGeneration = 0;  ///< Mapping generation @c blobOffset belongs to
+    bool keyed = false;    ///< Packets sealed under the vault key; false for version 1 packets
+    bool dirty = false;    ///< True if created or modified since last save
+    bool deleted = false;  ///< Soft-deleted; skipped on save and display
+    uint8_t audit = 0;     ///< VaultAuditFlag bits from the last audit (in-memory only)
 };
 
 /**
@@ -79,14 +202,228 @@ struct DecryptedCredential
     void cleanse();
 };
 
+/**
+ * @class VaultKeyCache
+ * @brief Session cache of derived vault record keys, indexed by key salt.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Vault
+ *
+ * Holds the HKDF record key of each vault key salt seen this session so
+ * on-demand decrypts cost one AES-GCM open instead of a full scrypt run.
+ * Keys live in locked_allocator pages and stay DPAPI-encrypted
+ * (CryptProtectMemory, same-process scope) while cached; lookup() decrypts
+ * a private copy for the caller.
+ *
+ * A cached key is only valid for the master password it was derived
+ * from, so the owner must call clear() whenever that password is wiped
+ * or replaced. All members are safe to call from worker threads.
+ *
+ * @see decryptCredentialOnDemand, loadVaultIndex
+ */
+class VaultKeyCache
+{
+public:
+    VaultKeyCache() = default;
+
+    /// @brief Destructor. Wipes every cached key.
+    ~VaultKeyCache();
+
+    VaultKeyCache(const VaultKeyCache&) = delete;
+    VaultKeyCache& operator=(const VaultKeyCache&) = delete;
+
+    /**
+     * @brief Copy out the cached record key for @p keySalt.
+     * @param keySalt Vault key salt of the record.
+     * @param[out] key Receives the plaintext key on a hit; untouched on a miss.
+     * @return `true` on a cache hit.
+     */
+    [[nodiscard]] bool lookup(std::span<const unsigned char> keySalt,
+                              Cryptography::LockedKeyBuffer& key) const;
+
+    /**
+     * @brief Cache @p key for @p keySalt, replacing any previous entry.
+     * @param keySalt Vault key salt the key was derived from.
+     * @param key     Record key (seal::cfg::KEY_LEN bytes); the caller keeps ownership.
+     */
+    void store(std::span<const unsigned char> keySalt, std::span<const unsigned char> key);
+
+    /// @brief Wipe and drop every cached key.
+    void clear();
+
+    /**
+     * @brief Hand every cached key to @p target and leave this cache empty.
+     *
+     * The keys stay DPAPI-protected throughout; @p target's previous keys are wiped.
+     *
+     * @param target Cache that takes the keys (a no-op when it is this cache).
+     */
+    void moveTo(VaultKeyCache& target);
+
+    /// @brief Number of cached keys.
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    struct Entry
+    {
+        std::array<unsigned char, seal::cfg::KDF_SALT_LEN> keySalt{};
+        Cryptography::LockedKeyBuffer key;  ///< DPAPI-protected while cached.
+    };
+
+    mutable std::mutex m_Mutex;
+    std::vector<Entry> m_Entries;
+};
+
+/**
+ * @class CredentialPrefetch
+ * @brief One credential decrypted ahead of a fill, DPAPI-protected until taken.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Vault
+ *
+ * Selecting a row is nearly always followed by typing or filling it, so
+ * the owner can start() the decrypt on the thread pool as soon as the
+ * selection lands; the fill then take()s the result instead of paying
+ * for decryptCredentialOnDemand() after the click.
+ *
+ * - Both fields sit in locked memory, encrypted with CryptProtectMemory
+ *   (same-process scope) from the moment the decrypt finishes; take()
+ *   decrypts them into the caller's credential and empties the slot.
+ * - A result lives for the TTL given at construction. sweep() drops it
+ *   once that passes; take() refuses it after that even if nobody swept.
+ * - start() and clear() drop the previous result, and a decrypt still
+ *   running for it is discarded when it finishes.
+ * - A result is only handed to a take() with the same record index and
+ *   records generation it was started for.
+ *
+ * Destroying the prefetch drops the result; a decrypt in flight keeps its
+ * own state alive and wipes its output when it completes. All members are
+ * safe to call from any thread.
+ *
+ * @see decryptCredentialOnDemand, VaultKeyCache
+ */
+class CredentialPrefetch
+{
+public:
+    /// @param ttl How long a finished decrypt stays available.
+    explicit CredentialPrefetch(std::chrono::milliseconds ttl);
+
+    /// @brief Destructor. Wipes any prefetched credential.
+    ~CredentialPrefetch();
+
+    CredentialPrefetch(const CredentialPrefetch&) = delete;
+    CredentialPrefetch& operator=(const CredentialPrefetch&) = delete;
+
+    /**
+     * @brief Start decrypting @p record in the background, replacing any prior prefetch.
+     * @param index      Record index the result will be matched against.
+     * @param generation Records generation the result will be matched against.
+     * @param record     Snapshot of the record to decrypt.
+     * @param password   Private copy of the master password; wiped by the worker.
+     * @param keyCache   Optional session key cache, shared with the worker.
+     */
+    void start(int index,
+               uint64_t generation,
+               VaultRecord record,
+               seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>> password,
+               std::shared_ptr<VaultKeyCache> keyCache);
+
+    /**
+     * @brief Hand over the prefetched credential for @p index.
+     * @param index      Record index about to be typed.
+     * @param generation Current records generation.
+     * @param[out] out   Receives the credential on a hit; untouched on a miss.
+     * @return `true` on a hit. A miss (not started, still running, failed,
+     *         expired or for another record) leaves the caller to decrypt.
+     */
+    [[nodiscard]] bool take(int index, uint64_t generation, DecryptedCredential& out);
+
+    /// @brief Drop the result if its TTL has passed.
+    void sweep();
+
+    /// @brief Drop the result and discard any decrypt in flight.
+    void clear();
+
+    /// @brief True if a finished, unexpired result is waiting.
+    [[nodiscard]] bool ready() const;
+
+private:
+    struct State;
+    std::chrono::milliseconds m_Ttl;
+    std::shared_ptr<State> m_State;
+};
+
+/**
+ * @brief Progress callback for long-running vault operations.
+ *
+ * Receives the number of records processed so far and the total. May be
+ * invoked concurrently from worker threads. Returning `false` asks the
+ * operation to stop at the next record boundary.
+ */
+using VaultProgress = std::function<bool(size_t done, size_t total)>;
+
+/**
+ * @brief On-disk encoding of a vault file.
+ * @ingroup Vault
+ */
+enum class VaultEncoding
+{
+    Binary,  ///< Raw binary frame (default; half the size of hex)
+    Hex      ///< Frame as hex text, one line per frame (export, older files)
+};
+
+/**
+ * @brief How loadVaultIndex() holds credential packets.
+ * @ingroup Vault
+ */
+enum class VaultLoadMode
+{
+    Resident,  ///< Copy every packet into its record (default)
+    Mapped     ///< Map binary vaults and read packets on demand (see VaultMapping)
+};
+
+/**
+ * @struct VaultJournalState
+ * @brief Where the last load or save of a version 3+ vault left the file.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Vault
+ *
+ * Filled by loadVaultIndex() and consumed and updated by saveVaultV2(), so
+ * a later save can append a journal entry instead of rewriting the file.
+ * It is only honored while the file on disk still has the recorded size
+ * and last-write time; anything else falls back to a full rewrite.
+ *
+ * @see saveVaultV2
+ */
+struct VaultJournalState
+{
+    std::string path;                                              ///< Vault file described
+    std::array<unsigned char, seal::cfg::KDF_SALT_LEN> keySalt{};  ///< Base frame key id
+    uint64_t fileSize = 0;       ///< File size when last read or written
+    uint64_t lastWrite = 0;      ///< Last-write FILETIME when last read or written
+    uint64_t baseSize = 0;       ///< Bytes of the base frame line
+    uint64_t committedSize = 0;  ///< End of the last complete journal entry
+    uint32_t entries = 0;        ///< Journal entries after the base frame
+    VaultEncoding encoding = VaultEncoding::Binary;  ///< Encoding of the file
+    bool valid = false;          ///< False until a version 3+ load or save fills it
+};
+
 /**
  * @brief Load the vault index.
  *
  * Decrypts platform names on load so the UI can list accounts.
  * Credentials remain encrypted until explicitly requested.
- * File format is a single hex blob containing a framed binary payload:
- * `magic(4) + version(1) + record_count(4) + records...`.
- * Each record is `platform_len(4) + platform_packet + cred_len(4) + cred_packet`.
+ * File format is a framed binary payload, stored raw or as hex text:
+ * `magic(4) + version(1) + salt(16) + record_count(4) + records...`.
+ * Each record is `id(8) + platform_len(4) + platform_packet + cred_len(4) + cred_packet`.
+ * The encoding is detected from the first bytes; binary files are read
+ * straight into the frame buffer with no decoding pass.
+ *
+ * Version 2 and 3 files cost one key derivation regardless of record count.
+ * Version 3 journal entries are replayed over the base records in order; a
+ * final entry torn by a crash mid-append is ignored.
+ * Version 1 files (no header salt, self-salted packets) are still accepted
+ * and cost one key derivation per record; records after the first are
+ * decrypted on a thread pool sized to the core count and to how many scrypt
+ * working sets fit in available memory.
  *
  * Decryption fails fast on the first record: if the master password is
  * wrong the function throws immediately rather than attempting remaining
@@ -94,29 +431,138 @@ struct DecryptedCredential
  *
  * @param vaultPath Absolute path to the `.seal` vault file.
  * @param password  Master password for key derivation.
+ * @param keyCache  Optional session cache; seeded with the vault key once
+ *                  it has authenticated the first record.
+ * @param progress  Optional per-record progress callback; returning `false` cancels.
+ * @param journal   Optional; receives the file state an incremental save needs.
+ * @param mode      VaultLoadMode::Mapped maps binary vaults instead of reading them;
+ *                  hex vaults, or files that cannot be mapped, are read as usual.
+ * @param known     Optional records from an earlier load of the same vault. A
+ *                  record whose id, key salt and platform packet match a clean
+ *                  known record takes its platform name without decrypting;
+ *                  only records whose ciphertext changed are opened. Record 0
+ *                  is always decrypted, so the password is still checked.
  * @return Vector of vault records with decrypted platform names.
- * @throw std::runtime_error on wrong password, corrupt file, or I/O error.
+ * @throw std::runtime_error on wrong password, corrupt file, I/O error, or
+ *        cancellation ("Operation cancelled").
  */
 std::vector<VaultRecord> loadVaultIndex(
     const QString& vaultPath,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password);
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache = nullptr,
+    const VaultProgress& progress = {},
+    VaultJournalState* journal = nullptr,
+    VaultLoadMode mode = VaultLoadMode::Resident,
+    const std::vector<VaultRecord>* known = nullptr);
+
+/**
+ * @brief Whether the file @p journal describes changed since it was recorded.
+ *
+ * Compares the file's current size and last-write time against the stamp
+ * taken by the last loadVaultIndex() or saveVaultV2(). A file that can no
+ * longer be read counts as changed.
+ *
+ * @param journal State from the last load or save.
+ * @return `false` for an invalid @p journal, which has no stamp to compare.
+ */
+[[nodiscard]] bool vaultFileChanged(const VaultJournalState& journal);
+
+/**
+ * @struct VaultMergeResult
+ * @brief What mergeReloadedRecords() did to the open records.
+ * @ingroup Vault
+ */
+struct VaultMergeResult
+{
+    size_t added = 0;      ///< Records new on disk
+    size_t updated = 0;    ///< Clean records whose packets changed on disk
+    size_t removed = 0;    ///< Clean records no longer on disk
+    size_t conflicts = 0;  ///< Records changed both here and on disk
+    size_t kept = 0;       ///< Records edited here but deleted on disk; kept
+
+    /// @brief Whether the merge changed anything.
+    [[nodiscard]] bool changed() const
+    {
+        return added || updated || removed || conflicts || kept;
+    }
+};
+
+/**
+ * @brief Merge a fresh load of the vault file into the open records.
+ *
+ * Records are matched by id. Clean records take the disk version, so
+ * unchanged records simply pick up their location in the new file.
+ * Records with unsaved changes (dirty or deleted) are kept as they are;
+ * if the disk version of one also changed, it is added next to it as a
+ * "(conflicted copy)" with a fresh id, so neither side's write is lost.
+ * Dirty records the disk does not have are kept too: they are new here,
+ * or were edited here and deleted on disk (counted in `kept`).
+ * Audit flags survive on records whose packet did not change.
+ *
+ * @param records Open records; merged in place.
+ * @param fresh   Records from loadVaultIndex() of the changed file; consumed.
+ * @return Counts of what changed.
+ */
+VaultMergeResult mergeReloadedRecords(std::vector<VaultRecord>& records,
+                                      std::vector<VaultRecord> fresh);
 
 /**
  * @brief Save vault with fully-encrypted records.
  *
- * Writes a single framed hex blob (same format as loadVaultIndex()).
- * Deleted records are omitted. Untouched records reuse their existing
- * encrypted platform packet (no re-encryption).
+ * With a valid @p journal for the same, unchanged file, appends one sealed
+ * journal entry holding only the dirty and deleted records: crypto and I/O
+ * scale with the change, not the vault.  The entry is written and flushed
+ * in place after the last committed byte, so an interrupted append leaves
+ * the previous state intact.
+ *
+ * Otherwise -- no journal, a version 1/2 file, records needing migration,
+ * a journal grown past its compaction threshold, or a change of encoding --
+ * writes a single frame in the current format (version 3, or 4 for non-default
+ * KDF parameters) through a temporary file and an atomic rename.  Deleted
+ * records are omitted. Records already sealed under the vault key reuse
+ * their existing packets (no re-encryption). Version 1 records, or records
+ * sealed under a different key salt or KDF parameters, are re-sealed under
+ * the vault key; this is how older vault files are migrated.
  *
  * @param vaultPath Absolute path to the `.seal` vault file.
  * @param records   Records to save (deleted records are skipped).
  * @param password  Master password for key derivation.
- * @return `true` on success, `false` on I/O error.
+ * @param keyCache  Optional session cache consulted before deriving a key.
+ * @param progress  Optional per-record progress callback; returning `false`
+ *                  cancels and leaves the existing file untouched.
+ * @param journal   Optional state from loadVaultIndex() or a previous save;
+ *                  updated to describe the file as written.
+ * @param encoding  Binary (default) or the hex text export.
+ * @return `true` on success, `false` on I/O error, failed migration, or cancellation.
+ *
+ * A full rewrite of a mapped vault swaps the file under the mapping's lock
+ * (VaultMapping::replaceFile()). Binary rewrites then point every record at
+ * its packet in the new file; hex rewrites copy the packets into the records.
+ *
+ * @post Migrated records are updated in place, so later saves reuse them.
  */
 bool saveVaultV2(
     const QString& vaultPath,
-    const std::vector<VaultRecord>& records,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password);
+    std::vector<VaultRecord>& records,
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache = nullptr,
+    const VaultProgress& progress = {},
+    VaultJournalState* journal = nullptr,
+    VaultEncoding encoding = VaultEncoding::Binary);
+
+/**
+ * @brief Select the vault key salt new records should be sealed under.
+ *
+ * Returns the key id of the first live keyed record, so records added to an
+ * open vault share its key. A vault with no keyed records gets a fresh
+ * random salt followed by the current Cryptography::kdfParams().
+ *
+ * @param records Current vault records.
+ * @return Key salt for encryptCredential() and saveVaultV2().
+ * @throw std::runtime_error if the random generator fails.
+ */
+std::array<unsigned char, seal::cfg::KDF_SALT_LEN> vaultKeySalt(
+    const std::vector<VaultRecord>& records);
 
 /**
  * @brief Decrypt a single record on demand.
@@ -124,38 +570,156 @@ bool saveVaultV2(
  * Only the requested record's blob is decrypted.  The caller must call
  * cleanse() on the result (or let it destruct) immediately after use.
  *
+ * With a @p keyCache that already holds the record's vault key, no key
+ * derivation runs and the call costs a single AES-GCM open.
+ *
  * @param record   The vault record whose credential to decrypt.
  * @param password Master password for key derivation.
+ * @param keyCache Optional session cache of derived vault keys.
  * @return Decrypted credential pair in locked memory.
  * @throw std::runtime_error on authentication failure or malformed data.
  */
 DecryptedCredential decryptCredentialOnDemand(
     const VaultRecord& record,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password);
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache = nullptr);
 
 /**
  * @brief Encrypt a credential pair into a new VaultRecord.
  *
- * The record is marked dirty so the next save writes it.
+ * Both packets are sealed under the vault key derived from @p keySalt
+ * (one key derivation per call). The record is marked dirty so the next
+ * save writes it.
+ *
+ * A key that is not in @p keyCache is derived and must then open a record
+ * of @p vaultRecords already sealed under @p keySalt before it is used or
+ * cached, so a mistyped master password fails here instead of sealing the
+ * record under the wrong key.
  *
  * @param platform       Cleartext platform/service name (UTF-8).
  * @param username       Username in secure wide string.
  * @param password       Password in secure wide string.
  * @param masterPassword Master password for key derivation.
+ * @param keySalt        Vault key id (salt and KDF parameters), usually from
+ *                       vaultKeySalt().
+ * @param vaultRecords   Records of the vault the new record joins; empty for
+ *                       a vault that has none under @p keySalt yet.
+ * @param keyCache       Optional session cache consulted before deriving a key.
  * @return Newly constructed VaultRecord with encrypted blobs.
- * @throw std::runtime_error on OpenSSL encryption failure.
+ * @throw std::runtime_error on OpenSSL encryption failure, or if the derived
+ *        key does not open an existing record (wrong master password).
  */
 VaultRecord encryptCredential(
     const std::string& platform,
     const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& username,
     const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
-    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPassword);
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPassword,
+    std::span<const unsigned char> keySalt,
+    std::span<const VaultRecord> vaultRecords,
+    VaultKeyCache* keyCache = nullptr);
+
+/**
+ * @brief Give several records freshly generated passwords in one pass.
+ *
+ * The new passwords come from a single GeneratePasswords() batch and every
+ * record is re-sealed under the vault key for @p keySalt, which is derived
+ * (or taken from @p keyCache) once for the whole batch.  Records already
+ * sealed under that key are opened with it as well; only version 1 records
+ * or records under another key pay for their own derivation.  Usernames,
+ * platforms and ids are kept; rotated records are marked dirty and their
+ * audit flags cleared.
+ *
+ * All packets are built before any record is touched, so a failure leaves
+ * @p records unchanged.
+ *
+ * @param records        Vault records; rotated in place.
+ * @param indices        Records to rotate; deleted or out-of-range entries are skipped.
+ * @param length         Characters per new password (clamped like GeneratePasswords()).
+ * @param masterPassword Master password for key derivation.
+ * @param keySalt        Vault key id, usually from vaultKeySalt().
+ * @param keyCache       Optional session cache consulted before deriving a key.
+ * @return Number of records rotated.
+ * @throw std::runtime_error on authentication failure, a malformed blob, or
+ *        a failing random generator.
+ */
+size_t rotateCredentialPasswords(
+    std::vector<VaultRecord>& records,
+    std::span<const size_t> indices,
+    int length,
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& masterPassword,
+    std::span<const unsigned char> keySalt,
+    VaultKeyCache* keyCache = nullptr);
+
+/**
+ * @brief Copy records out of a vault so another vault can take them.
+ *
+ * Copies carry their packets (mapped records are read from their mapping),
+ * get fresh ids and are marked dirty, so saveVaultV2() writes them into the
+ * target and re-seals them there if it uses a different key.
+ *
+ * @param records Source vault records.
+ * @param indices Records to copy; deleted or out-of-range entries are skipped.
+ * @return The detached copies, in @p indices order.
+ */
+std::vector<VaultRecord> detachedCopies(const std::vector<VaultRecord>& records,
+                                        std::span<const size_t> indices);
+
+/**
+ * @brief Findings auditCredentials() sets on a record.
+ * @ingroup Vault
+ */
+enum VaultAuditFlag : uint8_t
+{
+    AuditBreached = 1,  ///< Password appears in the breach index
+    AuditReused = 2,    ///< Another record has the same password
+};
+
+/**
+ * @struct VaultAuditSummary
+ * @brief Totals of one auditCredentials() run.
+ * @ingroup Vault
+ */
+struct VaultAuditSummary
+{
+    size_t checked = 0;      ///< Live records whose password was hashed
+    size_t breached = 0;     ///< Records flagged AuditBreached
+    size_t reused = 0;       ///< Records flagged AuditReused
+    size_t reuseGroups = 0;  ///< Distinct passwords shared by two or more records
+};
+
+/**
+ * @brief Check every password against a breach index and for reuse.
+ *
+ * Each credential is opened, its password (UTF-8, as stored) hashed with
+ * SHA-1 and wiped; only the digests are compared, and they are wiped too
+ * before returning.  Record 0 is opened first on the calling thread, so a
+ * wrong password costs one key derivation and the parallel pass that
+ * follows runs on the cached vault key.  Empty passwords are skipped.
+ *
+ * @param records   Vault records; deleted records are skipped and get 0.
+ * @param password  Master password for key derivation.
+ * @param keyCache  Optional session cache of derived vault keys.
+ * @param breaches  Breach index to look digests up in; null audits reuse only.
+ * @param progress  Optional; records done / total. Returning false cancels.
+ * @param summary   Optional; receives the totals.
+ * @return VaultAuditFlag bits, one entry per record in @p records.
+ * @throw std::runtime_error on authentication failure, a malformed blob,
+ *        or cancellation ("Operation cancelled").
+ */
+std::vector<uint8_t> auditCredentials(
+    const std::vector<VaultRecord>& records,
+    const seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>& password,
+    VaultKeyCache* keyCache,
+    const BreachIndex* breaches,
+    const VaultProgress& progress = {},
+    VaultAuditSummary* summary = nullptr);
 
 /**
  * @brief Encrypt a directory recursively (skips .seal, .exe, .dll, and .pdb files).
  *
  * Symlinks and junction points are skipped to prevent escape from the
- * intended directory tree.
+ * intended directory tree. All files are written through one FileKeyring,
+ * so the run costs a single scrypt; each file stays decryptable on its own.
  *
  * @param dirPath  Root directory path.
  * @param password Master password for key derivation.
@@ -172,7 +736,8 @@ int encryptDirectory(
  * @brief Decrypt `.seal` files in a directory recursively.
  *
  * Symlinks and junction points are skipped to prevent escape from the
- * intended directory tree.
+ * intended directory tree. A FileKeyring caches the master key of each
+ * batch salt it meets, so files from one encrypt run cost a single scrypt.
  *
  * @param dirPath  Root directory path.
  * @param password Master password for key derivation.
@@ -4,6 +4,10 @@
 #include "Diagnostics.h"
 #include "Logging.h"
 
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
 namespace seal
 {
 
@@ -51,6 +55,8 @@ QVariant VaultListModel::data(const QModelIndex& index, int role) const
                 "\u2022\u2022\u2022\u2022\u2022\u2022\u2022\u2022\u2022\u2022\u2022\u2022");
         case static_cast<int>(Roles::RecordIndex):
             return realIdx;
+        case static_cast<int>(Roles::AuditFlags):
+            return static_cast<int>(rec.audit);
         default:
             return {};
     }
@@ -61,7 +67,8 @@ QHash<int, QByteArray> VaultListModel::roleNames() const
     return {{static_cast<int>(Roles::Platform), "platform"},
             {static_cast<int>(Roles::MaskedUsername), "maskedUsername"},
             {static_cast<int>(Roles::MaskedPassword), "maskedPassword"},
-            {static_cast<int>(Roles::RecordIndex), "recordIndex"}};
+            {static_cast<int>(Roles::RecordIndex), "recordIndex"},
+            {static_cast<int>(Roles::AuditFlags), "auditFlags"}};
 }
 
 void VaultListModel::setRecords(const std::vector<seal::VaultRecord>* records,
@@ -70,7 +77,17 @@ void VaultListModel::setRecords(const std::vector<seal::VaultRecord>* records,
     m_Records = records;
     m_OwnerGeneration = ownerGeneration;
     m_SnapshotGeneration = ownerGeneration ? *ownerGeneration : 0;
-    refresh();
+    // A new backing store invalidates everything the index knows.
+    m_SearchIndex.clear();
+    m_IndexedHashes.clear();
+    m_IndexedGeneration = UINT64_MAX;
+    int oldCount = (int)m_FilteredIndices.size();
+    syncSearchIndex();
+    rebuildFilteredIndices(m_NextIndices);
+    resetRows();
+    if ((int)m_FilteredIndices.size() != oldCount)
+        emit countChanged();
+    emit recordsChanged();
 }
 
 void VaultListModel::setFilter(const QString& filter)
@@ -78,6 +95,7 @@ void VaultListModel::setFilter(const QString& filter)
     if (m_Filter == filter)
         return;
     m_Filter = filter;
+    m_FoldedFilter = filter.toCaseFolded().toUtf8().toStdString();
     qCDebug(logBackend).noquote() << QString::fromStdString(
         seal::diag::joinFields({"event=model.filter.set",
                                 seal::diag::kv("active", !filter.isEmpty()),
@@ -91,15 +109,12 @@ void VaultListModel::refresh()
     // Sync the generation snapshot so data() doesn't reject requests as
     // stale. The owner bumps the counter before calling refresh(), so the
     // snapshot must be updated here to match.
+    const uint64_t previousGeneration = m_SnapshotGeneration;
     if (m_OwnerGeneration)
         m_SnapshotGeneration = *m_OwnerGeneration;
-    // beginResetModel / endResetModel tells every connected QML view to
-    // discard its cached state and re-query all rows.  This is simpler
-    // (and fast enough for our data size) than emitting fine-grained
-    // row-insert/remove signals when the filter or record set changes.
-    beginResetModel();
-    rebuildFilteredIndices();
-    endResetModel();
+    syncSearchIndex();
+    rebuildFilteredIndices(m_NextIndices);
+    applyFilteredIndices();
     qCDebug(logBackend).noquote() << QString::fromStdString(
         seal::diag::joinFields({"event=model.refresh",
                                 seal::diag::kv("previous_visible", oldCount),
@@ -107,6 +122,137 @@ void VaultListModel::refresh()
                                 seal::diag::kv("filter_active", !m_Filter.isEmpty())}));
     if ((int)m_FilteredIndices.size() != oldCount)
         emit countChanged();
+    if (m_SnapshotGeneration != previousGeneration)
+        emit recordsChanged();
+}
+
+// Full reset: every attached view discards its delegates and re-queries
+// all rows.  Reserved for a new backing store, where no row identity
+// carries over.
+void VaultListModel::resetRows()
+{
+    beginResetModel();
+    m_FilteredIndices.swap(m_NextIndices);
+    m_FilteredIds.clear();
+    for (int idx : m_FilteredIndices)
+        m_FilteredIds.push_back((*m_Records)[idx].id);
+    endResetModel();
+}
+
+// Move from m_FilteredIndices to m_NextIndices with row-level signals so
+// QML keeps delegates (and scroll position) for rows that survive.  Rows
+// are identified by record id rather than record index because a save
+// purges soft-deleted records and shifts the indices of everything after.
+// Records never change relative order (adds append, purges preserve
+// order), so the surviving rows are a subsequence of the new ones and the
+// diff is one removal pass plus one insertion pass.
+void VaultListModel::applyFilteredIndices()
+{
+    if (!m_Records)
+    {
+        m_NextIndices.clear();
+        if (!m_FilteredIndices.empty())
+        {
+            beginRemoveRows(QModelIndex(), 0, (int)m_FilteredIndices.size() - 1);
+            m_FilteredIndices.clear();
+            m_FilteredIds.clear();
+            endRemoveRows();
+        }
+        return;
+    }
+
+    m_NextRows.clear();
+    for (int idx : m_NextIndices)
+        m_NextRows.emplace((*m_Records)[idx].id, idx);
+
+    // Point surviving rows at their (possibly shifted) record index before
+    // any signal goes out, and poison the rest so data() returns nothing
+    // for them while they are being removed.
+    bool shifted = false;
+    for (size_t row = 0; row < m_FilteredIds.size(); ++row)
+    {
+        auto it = m_NextRows.find(m_FilteredIds[row]);
+        const int idx = it != m_NextRows.end() ? it->second : -1;
+        shifted |= idx >= 0 && idx != m_FilteredIndices[row];
+        m_FilteredIndices[row] = idx;
+    }
+
+    for (size_t row = 0; row < m_FilteredIndices.size();)
+    {
+        if (m_FilteredIndices[row] >= 0)
+        {
+            ++row;
+            continue;
+        }
+        size_t end = row + 1;
+        while (end < m_FilteredIndices.size() && m_FilteredIndices[end] < 0)
+            ++end;
+        beginRemoveRows(QModelIndex(), (int)row, (int)end - 1);
+        m_FilteredIndices.erase(m_FilteredIndices.begin() + row, m_FilteredIndices.begin() + end);
+        m_FilteredIds.erase(m_FilteredIds.begin() + row, m_FilteredIds.begin() + end);
+        endRemoveRows();
+    }
+
+    size_t row = 0;
+    for (size_t next = 0; next < m_NextIndices.size();)
+    {
+        if (row < m_FilteredIndices.size() && m_FilteredIndices[row] == m_NextIndices[next])
+        {
+            ++row;
+            ++next;
+            continue;
+        }
+        size_t end = next + 1;
+        while (end < m_NextIndices.size() &&
+               (row >= m_FilteredIndices.size() || m_FilteredIndices[row] != m_NextIndices[end]))
+            ++end;
+        beginInsertRows(QModelIndex(), (int)row, (int)(row + (end - next)) - 1);
+        m_FilteredIndices.insert(m_FilteredIndices.begin() + row,
+                                 m_NextIndices.begin() + next,
+                                 m_NextIndices.begin() + end);
+        m_FilteredIds.insert(m_FilteredIds.begin() + row, end - next, 0);
+        for (size_t i = next; i < end; ++i)
+            m_FilteredIds[row + (i - next)] = (*m_Records)[m_NextIndices[i]].id;
+        endInsertRows();
+        row += end - next;
+        next = end;
+    }
+
+    // The subsequence assumption only fails if a reload reused ids in a
+    // different order; fall back to a reset rather than show wrong rows.
+    if (m_FilteredIndices != m_NextIndices)
+    {
+        qCDebug(logBackend).noquote() << QString::fromStdString(seal::diag::joinFields(
+            {"event=model.refresh.reset", "reason=order_changed"}));
+        resetRows();
+        return;
+    }
+
+    // Rows that stayed put but whose platform text was edited.
+    for (uint32_t rec : m_ReindexedRecords)
+    {
+        auto it = std::lower_bound(m_FilteredIndices.begin(), m_FilteredIndices.end(), (int)rec);
+        if (it == m_FilteredIndices.end() || *it != (int)rec)
+            continue;
+        QModelIndex changed = index((int)(it - m_FilteredIndices.begin()));
+        emit dataChanged(changed, changed, {static_cast<int>(Roles::Platform)});
+    }
+    // A purge moved surviving records; their RecordIndex role is stale.
+    if (shifted && !m_FilteredIndices.empty())
+    {
+        emit dataChanged(index(0),
+                         index((int)m_FilteredIndices.size() - 1),
+                         {static_cast<int>(Roles::RecordIndex)});
+    }
+}
+
+void VaultListModel::auditChanged()
+{
+    if (m_FilteredIndices.empty())
+        return;
+    emit dataChanged(index(0),
+                     index((int)m_FilteredIndices.size() - 1),
+                     {static_cast<int>(Roles::AuditFlags)});
 }
 
 int VaultListModel::count() const
@@ -121,28 +267,64 @@ int VaultListModel::recordIndexForRow(int row) const
     return m_FilteredIndices[row];
 }
 
-// Walk every record and collect the indices of those that are not deleted
-// and match the current search filter.  The resulting m_FilteredIndices
-// vector becomes the authoritative row-to-record mapping for QML.
-void VaultListModel::rebuildFilteredIndices()
+// Bring the search index in line with m_Records.  With an owner generation
+// the work is skipped entirely while it is unchanged (every keystroke), and
+// otherwise only records whose platform hash moved are re-folded.
+void VaultListModel::syncSearchIndex()
 {
-    m_FilteredIndices.clear();
+    m_ReindexedRecords.clear();
     if (!m_Records)
+    {
+        m_SearchIndex.clear();
+        m_IndexedHashes.clear();
+        return;
+    }
+    if (m_OwnerGeneration && m_IndexedGeneration == m_SnapshotGeneration &&
+        m_IndexedHashes.size() == m_Records->size())
         return;
 
-    for (size_t i = 0; i < m_Records->size(); ++i)
+    const size_t count = m_Records->size();
+    m_SearchIndex.truncate(count);
+    const size_t previous = std::min(m_IndexedHashes.size(), count);
+    m_IndexedHashes.resize(count);
+    for (size_t i = 0; i < count; ++i)
     {
-        const auto& rec = (*m_Records)[i];
-        if (rec.deleted)
+        const std::string& platform = (*m_Records)[i].platform;
+        const size_t hash = std::hash<std::string_view>{}(platform);
+        if (i < previous && m_IndexedHashes[i] == hash)
+            continue;
+        m_IndexedHashes[i] = hash;
+        m_SearchIndex.assign(
+            static_cast<uint32_t>(i),
+            QString::fromUtf8(platform.c_str()).toCaseFolded().toUtf8().toStdString());
+        m_ReindexedRecords.push_back(static_cast<uint32_t>(i));
+    }
+    m_IndexedGeneration = m_SnapshotGeneration;
+    if (!m_ReindexedRecords.empty())
+    {
+        qCDebug(logBackend).noquote() << QString::fromStdString(
+            seal::diag::joinFields({"event=model.index.sync", seal::diag::kv("records", count),
+                                    seal::diag::kv("reindexed", m_ReindexedRecords.size())}));
+    }
+}
+
+// Collect the indices of records that are not deleted and match the current
+// search filter.  Candidates come from the search index in ascending record
+// order; applyFilteredIndices() turns the result into the row-to-record
+// mapping QML sees.
+void VaultListModel::rebuildFilteredIndices(std::vector<int>& out)
+{
+    out.clear();
+    if (!m_Records)
+        return;
+
+    m_SearchIndex.find(m_FoldedFilter, m_SearchHits);
+    for (uint32_t i : m_SearchHits)
+    {
+        if (i >= m_Records->size() || (*m_Records)[i].deleted)
             continue;
-        if (!m_Filter.isEmpty())
-        {
-            QString platform = QString::fromUtf8(rec.platform.c_str());
-            if (!platform.contains(m_Filter, Qt::CaseInsensitive))
-                continue;
-        }
         // Store the real index so data() and recordIndexForRow() can map back.
-        m_FilteredIndices.push_back((int)i);
+        out.push_back((int)i);
     }
 }
 
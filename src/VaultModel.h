@@ -4,10 +4,13 @@
 
 #include <QAbstractListModel>
 #include <QString>
+#include <QtQml/qqmlregistration.h>
 
+#include <unordered_map>
 #include <vector>
 
 #include "Cryptography.h"
+#include "SearchIndex.h"
 #include "Vault.h"
 
 namespace seal
@@ -33,13 +36,25 @@ namespace seal
  * that pass the filter. An empty filter string shows all non-deleted
  * records.
  *
+ * Lookups go through a PlatformSearchIndex of case-folded platform
+ * names rather than a scan of every record, so a keystroke only touches
+ * the candidate rows. The index is refreshed incrementally when the
+ * owner's generation moves: only records whose platform changed are
+ * re-folded and re-indexed.
+ *
  * ## :material-sync: Model Updates
  *
  * The model does not own the record data; it holds a non-owning
  * pointer set via setRecords(). Call refresh() after any mutation
- * (add, edit, delete, load) to trigger a full `beginResetModel` /
- * `endResetModel` cycle, which re-filters and notifies all attached
- * views.
+ * (add, edit, delete, load, filter change) to re-filter and notify
+ * attached views.
+ *
+ * refresh() diffs the new filtered rows against the current ones by
+ * record id and emits `beginRemoveRows` / `beginInsertRows` for the
+ * runs that changed plus `dataChanged` for rows whose platform was
+ * edited, so delegates and scroll position survive. Only setRecords()
+ * (or a diff that cannot be expressed as removes and inserts) falls
+ * back to a full `beginResetModel` / `endResetModel` cycle.
  *
  * ## :material-format-list-numbered: Roles
  *
@@ -49,12 +64,15 @@ namespace seal
  * - **MaskedUsername** - fixed asterisk placeholder
  * - **MaskedPassword** - fixed asterisk placeholder
  * - **RecordIndex** - real index for decrypt-on-demand lookups
+ * - **AuditFlags** - seal::VaultAuditFlag bits from the last audit
  *
  * @see Backend
  */
 class VaultListModel : public QAbstractListModel
 {
     Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("Provided by Backend.vaultModel")
     Q_PROPERTY(int count READ count NOTIFY countChanged)
 
 public:
@@ -65,7 +83,8 @@ public:
         Platform = Qt::UserRole + 1,  ///< Cleartext service/platform name.
         MaskedUsername,               ///< Fixed asterisk placeholder for username.
         MaskedPassword,               ///< Fixed asterisk placeholder for password.
-        RecordIndex                   ///< Real index for decrypt-on-demand lookups.
+        RecordIndex,                  ///< Real index for decrypt-on-demand lookups.
+        AuditFlags                    ///< seal::VaultAuditFlag bits from the last audit.
     };
 
     /// @brief Construct the model with no backing data.
@@ -94,6 +113,9 @@ public:
     /// @brief Force a full model reset (re-filter + notify views).
     void refresh();
 
+    /// @brief Notify views that the AuditFlags role of every row changed.
+    void auditChanged();
+
     /// @brief Number of visible (filtered) records.
     int count() const;
 
@@ -104,15 +126,30 @@ public:
 
 signals:
     void countChanged();
+    /// The backing records changed since the last refresh; record indices
+    /// held by views (e.g. a multi-selection) may now name other records.
+    void recordsChanged();
 
 private:
-    void rebuildFilteredIndices();
+    void syncSearchIndex();
+    void rebuildFilteredIndices(std::vector<int>& out);
+    void resetRows();
+    void applyFilteredIndices();
 
     const std::vector<seal::VaultRecord>* m_Records = nullptr;
     const uint64_t* m_OwnerGeneration = nullptr;  ///< Owner's mutation counter (null = unchecked).
     uint64_t m_SnapshotGeneration = 0;  ///< Generation at last setRecords(); stale = skip.
     QString m_Filter;
+    std::string m_FoldedFilter;  ///< m_Filter case-folded to UTF-8, computed once per change.
     std::vector<int> m_FilteredIndices;
+    std::vector<uint64_t> m_FilteredIds;  ///< Record id per visible row (row identity).
+    std::vector<int> m_NextIndices;       ///< Reused target of the next refresh().
+    std::unordered_map<uint64_t, int> m_NextRows;  ///< Record id -> record index in m_NextIndices.
+    std::vector<uint32_t> m_ReindexedRecords;      ///< Records whose platform changed this sync.
+    PlatformSearchIndex m_SearchIndex;
+    std::vector<size_t> m_IndexedHashes;  ///< Hash of each record's platform when indexed.
+    uint64_t m_IndexedGeneration = UINT64_MAX;  ///< Owner generation the index reflects.
+    std::vector<uint32_t> m_SearchHits;         ///< Reused find() output.
 };
 
 }  // namespace seal
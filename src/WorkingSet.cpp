@@ -0,0 +1,101 @@
+#include "WorkingSet.h"
+
+#include "LockedAllocator.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+
+namespace seal::working_set
+{
+
+namespace
+{
+
+std::mutex g_Lock;
+SIZE_T g_StartMin = 0;  // the quota before the first reserve()
+SIZE_T g_StartMax = 0;
+std::atomic<uint64_t> g_Budget{0};
+
+}  // namespace
+
+uint64_t estimate(size_t records, uint64_t kdfBytes) noexcept
+{
+    const uint64_t kdf = (std::min)(kdfBytes, cfg::KDF_MAX_MEMORY);
+    return cfg::WORKING_SET_BASE + static_cast<uint64_t>(records) * cfg::WORKING_SET_RECORD_BYTES +
+           kdf;
+}
+
+bool reserve(size_t records, uint64_t kdfBytes) noexcept
+{
+    const uint64_t want = estimate(records, kdfBytes);
+    // std::mutex::lock() may throw; this is noexcept, so report it as a
+    // refused reservation instead.
+    std::unique_lock lock(g_Lock, std::defer_lock);
+    try
+    {
+        lock.lock();
+    }
+    catch (const std::system_error&)
+    {
+        return false;
+    }
+    if (want <= g_Budget.load(std::memory_order_relaxed))
+        return true;
+
+    HANDLE self = GetCurrentProcess();
+    SIZE_T curMin = 0, curMax = 0;
+    DWORD flags = 0;
+    if (!GetProcessWorkingSetSizeEx(self, &curMin, &curMax, &flags))
+        return false;
+    if (!g_StartMin)
+    {
+        g_StartMin = curMin;
+        g_StartMax = curMax;
+    }
+    if (want > SIZE_MAX - g_StartMax)
+        return false;
+
+    const SIZE_T newMin = (std::max)(curMin, static_cast<SIZE_T>(g_StartMin + want));
+    const SIZE_T newMax = (std::max)(curMax, newMin + (g_StartMax - g_StartMin));
+    if (!SetProcessWorkingSetSizeEx(self,
+                                    newMin,
+                                    newMax,
+                                    QUOTA_LIMITS_HARDWS_MIN_DISABLE |
+                                        QUOTA_LIMITS_HARDWS_MAX_DISABLE))
+        return false;
+    g_Budget.store(want, std::memory_order_relaxed);
+    return true;
+}
+
+Stats stats() noexcept
+{
+    Stats s;
+    s.lockedBytes = locked_pool::lockedBytes();
+    s.lockedRegions = locked_pool::lockedRegions();
+    s.lockFailures = locked_pool::lockFailures();
+    s.budgetBytes = g_Budget.load(std::memory_order_relaxed);
+    SIZE_T curMin = 0, curMax = 0;
+    DWORD flags = 0;
+    if (GetProcessWorkingSetSizeEx(GetCurrentProcess(), &curMin, &curMax, &flags))
+    {
+        s.minimum = curMin;
+        s.maximum = curMax;
+    }
+    return s;
+}
+
+std::string report(const Stats& s)
+{
+    std::ostringstream out;
+    out << "metric=locked_memory bytes=" << s.lockedBytes << " regions=" << s.lockedRegions
+        << " lock_failures=" << s.lockFailures << " budget_bytes=" << s.budgetBytes
+        << " ws_min=" << s.minimum << " ws_max=" << s.maximum << '\n';
+    return out.str();
+}
+
+}  // namespace seal::working_set
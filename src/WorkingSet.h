@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace seal
+{
+/**
+ * @namespace seal::working_set
+ * @brief Working-set quota for locked memory, sized to the vault.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Memory
+ *
+ * VirtualLock draws on the process's minimum working set, which Windows
+ * starts at a few hundred KiB. Past that, locked_pool's VirtualLock calls
+ * are refused and new secrets silently stay pageable. reserve() raises
+ * the minimum once, to the demand estimate() predicts for a vault,
+ * whenever a vault loads: a larger vault raises it further, a smaller
+ * one leaves it alone.
+ *
+ * The estimate covers the fixed locked working set (one thread's pool
+ * plus slab arenas), every record's three decrypted fields, and the KDF
+ * buffer, which is resident during unlock and would otherwise push
+ * locked pages against the cap.
+ *
+ * stats() reports what is actually locked, so `:stats` and `--stats`
+ * show whether the budget holds.
+ *
+ * @see locked_pool
+ */
+namespace working_set
+{
+
+/**
+ * @struct Stats
+ * @brief Point-in-time view of locked memory and the working-set quota.
+ */
+struct Stats
+{
+    size_t lockedBytes = 0;    ///< Bytes pinned by VirtualLock
+    size_t lockedRegions = 0;  ///< Regions pinned by VirtualLock
+    size_t lockFailures = 0;   ///< VirtualLock refusals since process start
+    uint64_t budgetBytes = 0;  ///< Locked demand last reserved; 0 before the first reserve()
+    size_t minimum = 0;        ///< Current working-set minimum
+    size_t maximum = 0;        ///< Current working-set maximum
+};
+
+/**
+ * @brief Predict the locked bytes needed for a vault.
+ * @param records  Vault record count.
+ * @param kdfBytes Memory of one password KDF run (KdfParams::memoryBytes()).
+ */
+[[nodiscard]] uint64_t estimate(size_t records, uint64_t kdfBytes) noexcept;
+
+/**
+ * @brief Raise the working-set minimum to cover estimate(records, kdfBytes).
+ *
+ * The new minimum is the process's starting minimum plus the estimate;
+ * the maximum keeps its starting headroom above it. Both limits stay
+ * soft, so the memory manager can still trim unlocked pages. A demand no
+ * larger than one already reserved changes nothing.
+ *
+ * @return False if Windows refused the new quota, or the quota lock could
+ *         not be taken (locking stays best-effort).
+ */
+bool reserve(size_t records, uint64_t kdfBytes) noexcept;
+
+/// @brief Current counters and quota.
+[[nodiscard]] Stats stats() noexcept;
+
+/**
+ * @brief Render @p s as one logfmt line in the style of metrics::report().
+ *
+ * ```
+ * metric=locked_memory bytes=17039360 regions=3 lock_failures=0 budget_bytes=88080384 ...
+ * ```
+ */
+[[nodiscard]] std::string report(const Stats& s);
+
+}  // namespace working_set
+}  // namespace seal
@@ -23,6 +23,8 @@
  *      Repository:   https://github.com/lextpf/seal
  *      License:      MIT
  */
+#include "Agent.h"
+#include "BreachIndex.h"
 #include "CliModes.h"
 #include "Clipboard.h"
 #include "Console.h"
@@ -30,21 +32,35 @@
 #include "Cryptography.h"
 #include "Diagnostics.h"
 #include "FileOperations.h"
+#include "Metrics.h"
 #include "PasswordGen.h"
 #include "ScopedDpapiUnprotect.h"
 #include "Utils.h"
 #include "Version.h"
+#include "WorkingSet.h"
 
 #ifdef USE_QT_UI
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/QString>
+#include <QtCore/QThreadPool>
+#include "ImportReader.h"
 #include "Logging.h"
 #include "Vault.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -71,7 +87,16 @@ enum class Mode
     Shred,
     Hash,
     Verify,
-    Wipe
+    Cat,
+    Wipe,
+    Sync,
+    Pack,
+    Unpack,
+    KdfCalibrate,
+    Agent,
+    Lookup,
+    Lock,
+    Audit
 };
 
 struct ProgramOptions
@@ -82,6 +107,27 @@ struct ProgramOptions
     std::string outputPath;     // secondary / destination path
     std::string stringData;     // inline text for -e/-d
     int genLength = 20;
+    size_t genCount = 1;           // gen: passwords to generate (1 = copy to clipboard)
+    bool hexVault = false;         // import: write the vault as hex text
+    bool blake2 = false;           // hash: BLAKE2b-512 instead of SHA-256
+    bool listOnly = false;         // unpack: list members instead of extracting
+    std::string member;            // unpack: extract only this member
+    std::string pwnedPath;         // audit: breach index, or a sorted HIBP dump to index
+    bool bloom = false;            // audit: give a newly built index a Bloom filter
+    uint64_t catOffset = 0;        // cat: first plaintext byte
+    uint64_t catLength =           // cat: bytes to print (default: to the end)
+        UINT64_MAX;
+    unsigned threads = 0;          // encrypt/decrypt: worker threads (0 = one per CPU)
+    bool compress = false;         // encrypt/sync: compress segments before sealing
+    std::string kdfSpec;           // KDF parameters for new output (else SEAL_KDF)
+    unsigned kdfTargetMs = 500;    // kdf-calibrate: target derivation time
+    unsigned kdfMemoryMiB = 256;   // kdf-calibrate: largest working set
+    bool stats = false;            // print metrics::report() to stderr on exit
+    bool useAgent = false;         // -e/-d: go through the running agent
+    unsigned agentTtlMinutes =     // agent: idle minutes before it exits (0 = never)
+        static_cast<unsigned>(seal::agent::kDefaultTtl.count());
+    // encrypt/pack/sync: cipher of new segmented output (unset = preferredAead())
+    std::optional<seal::AeadAlgorithm> aead;
 };
 
 void writeCliDiag(std::ostream& os,
@@ -128,18 +174,29 @@ static void printHelp()
     std::cout << "Commands:\n";
     std::cout << "  encrypt <file> [output]   Encrypt a file (output defaults to <file>.seal)\n";
     std::cout << "  decrypt <file> [output]   Decrypt a file (output defaults to original name)\n";
-    std::cout << "  gen [length]              Generate a random password (default: 20)\n";
-    std::cout << "  shred <file>              Securely delete a file (3-pass overwrite + remove)\n";
-    std::cout << "  hash <file>               Compute SHA-256 hash of a file\n";
-    std::cout << "  verify <file.seal>        Verify password for an encrypted file\n";
+    std::cout << "  gen [length] [--count N]  Generate a random password (default: 20)\n";
+    std::cout << "  shred <path>              Securely delete a file or directory (see below)\n";
+    std::cout << "  hash <path> [manifest]    SHA-256 of a file, or of every file in a directory\n";
+    std::cout << "  verify <path>             Verify a .seal file, or every one in a directory\n";
+    std::cout << "  cat <file>                Print a decrypted byte range (see below)\n";
     std::cout << "  wipe                      Clear clipboard and console buffer\n";
+    std::cout << "  sync <dir> <mirror>       Encrypt new/changed files of <dir> into <mirror>\n";
+    std::cout << "  pack <dir> [archive]      Pack a directory into one encrypted archive\n";
+    std::cout << "  unpack <archive> [dir]    List or extract an archive (see below)\n";
+    std::cout << "  kdf-calibrate [ms]        Measure KDF parameters for an unlock time (500)\n";
+    std::cout << "  agent [vault]             Unlock once and serve scripted requests (see below)\n";
+    std::cout << "  lookup <platform>         Print a vault credential from the running agent\n";
+    std::cout << "  lock                      Stop the running agent and wipe its keys\n";
     std::cout << "  import <data> [output]    Import credentials into a vault file\n";
-    std::cout << "  export <input> [output]   Export vault to plaintext (re-importable format)\n\n";
+    std::cout << "  export <input> [output]   Export vault to plaintext (re-importable format)\n";
+    std::cout << "  audit <vault>             List breached and reused passwords (see below)\n\n";
     std::cout << "Options:\n";
     std::cout << "  -e, --text-encrypt [text] Encrypt a string, output hex\n";
     std::cout << "  -d, --text-decrypt [hex]  Decrypt a hex string, output plaintext\n";
     std::cout << "  -u, --ui                  Launch graphical user interface\n";
     std::cout << "  -c, --cli                 Launch command-line interactive mode\n";
+    std::cout << "  --stats                   Print KDF, crypto and fill metrics on exit\n";
+    std::cout << "  --agent                   With -e/-d, use the running agent (no prompt)\n";
     std::cout << "  -v, --version             Display version information\n";
     std::cout << "  -h, --help                Display this help message\n";
     std::cout << "  (no args)                 GUI mode (default)\n\n";
@@ -147,7 +204,50 @@ static void printHelp()
     std::cout << "  <data> is comma-separated entries: plat:user:pass, plat:user:pass,...\n";
     std::cout << "  <data> can also be a path to a text file containing entries\n";
     std::cout << "  Use '-' as <data> to read entries from stdin (pipe or paste)\n";
-    std::cout << "  [output] is the vault file path (default: .seal)\n\n";
+    std::cout << "  [output] is the vault file path (default: .seal)\n";
+    std::cout << "  --hex writes the vault as hex text instead of binary\n\n";
+    std::cout << "Hash options:\n";
+    std::cout << "  --blake2     Use BLAKE2b-512 instead of SHA-256 (faster per core)\n";
+    std::cout << "  A directory is hashed in parallel into a sha256sum-style manifest,\n";
+    std::cout << "  written to [manifest] or stdout\n\n";
+    std::cout << "Gen options:\n";
+    std::cout << "  --count N    Print N passwords, one per line, without touching the\n";
+    std::cout << "               clipboard (1..1000000, default: 1)\n\n";
+    std::cout << "Pack options:\n";
+    std::cout << "  [archive] defaults to <dir>.seal; unpack's [dir] to the archive name\n";
+    std::cout << "  without .seal. The index is compressed and encrypted with the files\n";
+    std::cout << "  --list           Print the size and path of every member\n";
+    std::cout << "  --member <path>  Extract only this member (path as --list shows it)\n\n";
+    std::cout << "Shred:\n";
+    std::cout << "  Hard disks get 3 overwrite passes; SSDs get one pass plus TRIM\n";
+    std::cout << "  A directory is shredded in parallel across volumes, then removed\n\n";
+    std::cout << "File options:\n";
+    std::cout << "  --threads N  Worker threads for encrypt/decrypt of large files\n";
+    std::cout << "               (default: one per CPU; 0 also means one per CPU)\n";
+    std::cout << "  --compress   Compress each segment before encrypting it; segments\n";
+    std::cout << "               that do not shrink are stored as they are\n";
+    std::cout << "  --cipher C   Cipher for new files: auto, aes-gcm or chacha20 (default:\n";
+    std::cout << "               auto, AES-GCM where the CPU has AES instructions)\n\n";
+    std::cout << "Cat options:\n";
+    std::cout << "  --offset N   First plaintext byte to print (default: 0)\n";
+    std::cout << "  --length N   Bytes to print (default: to the end of the file)\n";
+    std::cout << "  Only the segments covering the range are read and authenticated\n\n";
+    std::cout << "KDF options:\n";
+    std::cout << "  --kdf <spec>  Key derivation for new files, packets and vaults, e.g.\n";
+    std::cout << "                scrypt:ln=17,r=8,p=1 or argon2id:m=256,t=3,p=4\n";
+    std::cout << "                (default: $SEAL_KDF, else scrypt:ln=16,r=8,p=1)\n";
+    std::cout << "  --memory N    kdf-calibrate: largest working set in MiB (default: 256)\n";
+    std::cout << "  Existing output always opens with the parameters stored in it\n\n";
+    std::cout << "Agent options:\n";
+    std::cout << "  --ttl N      Idle minutes before the agent exits (default: 15, 0 = never)\n";
+    std::cout << "  The agent keeps the password DPAPI-encrypted in locked memory and\n";
+    std::cout << "  answers only this user's local connections in this logon session\n\n";
+    std::cout << "Audit options:\n";
+    std::cout << "  --pwned <file>  Breach list: a .sidx index, or the sorted SHA-1 Pwned\n";
+    std::cout << "                  Passwords dump, indexed once into <file>.sidx\n";
+    std::cout << "  --bloom         Add a Bloom filter to a newly built index (~1.25 bytes\n";
+    std::cout << "                  per hash; answers most misses without a search)\n";
+    std::cout << "  Without --pwned only reuse is reported. Passwords never leave memory\n\n";
     std::cout << "Export format:\n";
     std::cout << "  <input> is the vault file path (e.g. vault.seal)\n";
     std::cout << "  [output] is the plaintext output path (default: stdout)\n\n";
@@ -156,21 +256,41 @@ static void printHelp()
     std::cout << "  seal decrypt secret.txt.seal             Produces secret.txt\n";
     std::cout << "  seal encrypt photo.png encrypted.seal    Custom output name\n";
     std::cout << "  seal decrypt encrypted.seal photo.png    Custom output name\n";
+    std::cout << "  seal encrypt disk.img --threads 8        Encrypt on 8 worker threads\n";
+    std::cout << "  seal encrypt app.log --compress          Compress, then encrypt\n";
+    std::cout << "  seal encrypt vm.img --cipher chacha20    ChaCha20-Poly1305 segments\n";
     std::cout << "  seal -e \"Hello World\"                    Encrypt string to hex\n";
     std::cout << "  seal -d <hex>                            Decrypt hex to plaintext\n";
     std::cout << "  echo \"Hello\" | seal -e                   Encrypt from stdin\n";
     std::cout << "  echo \"Hello\" | seal -e | seal -d         Round-trip via pipe\n";
     std::cout << "  seal gen                                 Random 20-char password\n";
     std::cout << "  seal gen 40                              Random 40-char password\n";
+    std::cout << "  seal gen 24 --count 10000 > pw.txt       Bulk-provision 10000 passwords\n";
     std::cout << "  seal shred secret.txt                    Securely delete file\n";
+    std::cout << "  seal shred D:\\old-project                Securely delete a whole tree\n";
     std::cout << "  seal hash document.pdf                   SHA-256 hash\n";
+    std::cout << "  seal hash D:\\backup sums.txt             Hash a whole tree into sums.txt\n";
     std::cout << "  seal verify secret.txt.seal              Check password correctness\n";
+    std::cout << "  seal verify E:\\backup                    Audit every .seal file in a tree\n";
+    std::cout << "  seal cat app.log.seal --offset 1000000   Print from byte 1000000 on\n";
     std::cout << "  seal wipe                                Clear clipboard + console\n";
+    std::cout << "  seal sync D:\\docs E:\\backup\\docs         Nightly incremental mirror\n";
+    std::cout << "  seal pack D:\\mail mail.seal              Many small files, one archive\n";
+    std::cout << "  seal unpack mail.seal --list             List members without extracting\n";
+    std::cout << "  seal unpack mail.seal --member a/b.eml   Extract a single member\n";
+    std::cout << "  seal kdf-calibrate 1000 --memory 512     Tune for a one-second unlock\n";
+    std::cout << "  seal verify big.seal --stats             Also print KDF and GCM timings\n";
+    std::cout << "  seal agent vault.seal --ttl 30           Unlock once for scripted access\n";
+    std::cout << "  seal -e --agent \"token\"                  Encrypt with no prompt or KDF\n";
+    std::cout << "  seal lookup github                       Username and password, one per line\n";
+    std::cout << "  seal lock                                Stop the agent\n";
     std::cout << "  seal import \"github:alice:pw123\"         Import to default .seal\n";
     std::cout << "  seal import entries.txt vault.seal       Import from file to vault\n";
     std::cout << "  seal import - vault.seal < entries.txt   Read entries from stdin\n";
+    std::cout << "  seal import entries.txt vault.seal --hex Import to a hex text vault\n";
     std::cout << "  seal export vault.seal                   Print credentials to stdout\n";
     std::cout << "  seal export vault.seal export.txt        Save credentials to file\n";
+    std::cout << "  seal audit vault.seal --pwned pwned.txt  Check against the HIBP dump\n";
     std::cout << "  seal --ui                                Launch GUI mode\n";
     std::cout << "  seal --cli                               Launch interactive CLI\n";
 }
@@ -286,6 +406,14 @@ static int parseArguments(int argc, char* argv[], ProgramOptions& opts)
                 return 1;
             }
         }
+        else if (arg == "audit")
+        {
+            if (!trySetMode(opts, Mode::Audit))
+                return 1;
+            if (!parseRequiredPath(
+                    argc, argv, i, opts, "audit", "seal audit <vault> [--pwned <file>]"))
+                return 1;
+        }
         else if (arg == "encrypt")
         {
             if (!trySetMode(opts, Mode::FileEncrypt))
@@ -328,21 +456,28 @@ static int parseArguments(int argc, char* argv[], ProgramOptions& opts)
         {
             if (!trySetMode(opts, Mode::Shred))
                 return 1;
-            if (!parseRequiredPath(argc, argv, i, opts, "shred", "seal shred <file>"))
+            if (!parseRequiredPath(argc, argv, i, opts, "shred", "seal shred <path>"))
                 return 1;
         }
         else if (arg == "hash")
         {
             if (!trySetMode(opts, Mode::Hash))
                 return 1;
-            if (!parseRequiredPath(argc, argv, i, opts, "hash", "seal hash <file>"))
+            if (!parseRequiredPath(argc, argv, i, opts, "hash", "seal hash <path> [manifest]"))
                 return 1;
         }
         else if (arg == "verify")
         {
             if (!trySetMode(opts, Mode::Verify))
                 return 1;
-            if (!parseRequiredPath(argc, argv, i, opts, "verify", "seal verify <file.seal>"))
+            if (!parseRequiredPath(argc, argv, i, opts, "verify", "seal verify <path>"))
+                return 1;
+        }
+        else if (arg == "cat")
+        {
+            if (!trySetMode(opts, Mode::Cat))
+                return 1;
+            if (!parseRequiredPath(argc, argv, i, opts, "cat", "seal cat <file>"))
                 return 1;
         }
         else if (arg == "wipe")
@@ -350,6 +485,328 @@ static int parseArguments(int argc, char* argv[], ProgramOptions& opts)
             if (!trySetMode(opts, Mode::Wipe))
                 return 1;
         }
+        else if (arg == "sync")
+        {
+            if (!trySetMode(opts, Mode::Sync))
+                return 1;
+            if (!parseRequiredPath(argc, argv, i, opts, "sync", "seal sync <dir> <mirror>"))
+                return 1;
+            if (opts.outputPath.empty())
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "command=sync",
+                              "reason=missing_argument"});
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Info,
+                             "USAGE",
+                             {"syntax=seal_sync_dir_mirror"});
+                return 1;
+            }
+        }
+        else if (arg == "pack")
+        {
+            if (!trySetMode(opts, Mode::Pack))
+                return 1;
+            if (!parseRequiredPath(argc, argv, i, opts, "pack", "seal pack <dir> [archive]"))
+                return 1;
+        }
+        else if (arg == "unpack")
+        {
+            if (!trySetMode(opts, Mode::Unpack))
+                return 1;
+            if (!parseRequiredPath(argc, argv, i, opts, "unpack", "seal unpack <archive> [dir]"))
+                return 1;
+        }
+        else if (arg == "kdf-calibrate")
+        {
+            if (!trySetMode(opts, Mode::KdfCalibrate))
+                return 1;
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+            {
+                try
+                {
+                    opts.kdfTargetMs = static_cast<unsigned>(std::stoul(argv[++i]));
+                }
+                catch (...)
+                {
+                    opts.kdfTargetMs = 0;
+                }
+                if (opts.kdfTargetMs == 0)
+                {
+                    writeCliDiag(std::cerr,
+                                 seal::console::Tone::Error,
+                                 "ARGS",
+                                 {"event=cli.args.parse",
+                                  "result=fail",
+                                  "command=kdf-calibrate",
+                                  "reason=invalid_target_ms"});
+                    return 1;
+                }
+            }
+        }
+        else if (arg == "agent")
+        {
+            if (!trySetMode(opts, Mode::Agent))
+                return 1;
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+                opts.inputPath = argv[++i];
+        }
+        else if (arg == "lookup")
+        {
+            if (!trySetMode(opts, Mode::Lookup))
+                return 1;
+            if (!parseRequiredPath(argc, argv, i, opts, "lookup", "seal lookup <platform>"))
+                return 1;
+        }
+        else if (arg == "lock")
+        {
+            if (!trySetMode(opts, Mode::Lock))
+                return 1;
+        }
+        else if (arg == "--agent")
+        {
+            opts.useAgent = true;
+        }
+        else if (arg == "--ttl")
+        {
+            int n = -1;
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+            {
+                try
+                {
+                    n = std::stoi(argv[++i]);
+                }
+                catch (...)
+                {
+                    n = -1;
+                }
+            }
+            if (n < 0)
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=ttl",
+                              "reason=invalid_ttl_minutes"});
+                return 1;
+            }
+            opts.agentTtlMinutes = static_cast<unsigned>(n);
+        }
+        else if (arg == "--kdf")
+        {
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+                opts.kdfSpec = argv[++i];
+            if (opts.kdfSpec.empty())
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=kdf",
+                              "reason=missing_argument"});
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Info,
+                             "USAGE",
+                             {"syntax=seal_--kdf_scrypt:ln=17,r=8,p=1"});
+                return 1;
+            }
+        }
+        else if (arg == "--memory")
+        {
+            int n = 0;
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+            {
+                try
+                {
+                    n = std::stoi(argv[++i]);
+                }
+                catch (...)
+                {
+                    n = 0;
+                }
+            }
+            if (n <= 0 || static_cast<uint64_t>(n) > (seal::cfg::KDF_MAX_MEMORY >> 20))
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=memory",
+                              "reason=invalid_memory_mib"});
+                return 1;
+            }
+            opts.kdfMemoryMiB = static_cast<unsigned>(n);
+        }
+        else if (arg == "--hex")
+        {
+            opts.hexVault = true;
+        }
+        else if (arg == "--blake2")
+        {
+            opts.blake2 = true;
+        }
+        else if (arg == "--pwned")
+        {
+            if (i + 1 >= argc || isOptionToken(argv[i + 1]))
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=pwned",
+                              "reason=missing_pwned_path"});
+                return 1;
+            }
+            opts.pwnedPath = argv[++i];
+        }
+        else if (arg == "--bloom")
+        {
+            opts.bloom = true;
+        }
+        else if (arg == "--list")
+        {
+            opts.listOnly = true;
+        }
+        else if (arg == "--member")
+        {
+            if (i + 1 >= argc || isOptionToken(argv[i + 1]))
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=member",
+                              "reason=missing_member_path"});
+                return 1;
+            }
+            opts.member = argv[++i];
+        }
+        else if (arg == "--offset" || arg == "--length")
+        {
+            unsigned long long n = 0;
+            bool valid = false;
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+            {
+                try
+                {
+                    n = std::stoull(argv[++i]);
+                    valid = true;
+                }
+                catch (...)
+                {
+                    valid = false;
+                }
+            }
+            if (!valid)
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              seal::diag::kv("option", arg.substr(2)),
+                              "reason=invalid_byte_count"});
+                return 1;
+            }
+            (arg == "--offset" ? opts.catOffset : opts.catLength) = n;
+        }
+        else if (arg == "--cipher")
+        {
+            const std::string name = i + 1 < argc && !isOptionToken(argv[i + 1]) ? argv[++i] : "";
+            if (name == "aes-gcm")
+                opts.aead = seal::AeadAlgorithm::Aes256Gcm;
+            else if (name == "chacha20")
+                opts.aead = seal::AeadAlgorithm::ChaCha20Poly1305;
+            else if (name == "auto")
+                opts.aead.reset();
+            else
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=cipher",
+                              "reason=unknown_cipher"});
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Info,
+                             "USAGE",
+                             {"syntax=seal_--cipher_auto|aes-gcm|chacha20"});
+                return 1;
+            }
+        }
+        else if (arg == "--compress")
+        {
+            opts.compress = true;
+        }
+        else if (arg == "--stats")
+        {
+            opts.stats = true;
+        }
+        else if (arg == "--threads")
+        {
+            int n = -1;
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+            {
+                try
+                {
+                    n = std::stoi(argv[++i]);
+                }
+                catch (...)
+                {
+                    n = -1;
+                }
+            }
+            if (n < 0)
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=threads",
+                              "reason=invalid_thread_count"});
+                return 1;
+            }
+            opts.threads = static_cast<unsigned>(n);
+        }
+        else if (arg == "--count")
+        {
+            long long n = 0;
+            if (i + 1 < argc && !isOptionToken(argv[i + 1]))
+            {
+                try
+                {
+                    n = std::stoll(argv[++i]);
+                }
+                catch (...)
+                {
+                    n = 0;
+                }
+            }
+            if (n < 1 || n > static_cast<long long>(seal::kMaxPasswordBatch))
+            {
+                writeCliDiag(std::cerr,
+                             seal::console::Tone::Error,
+                             "ARGS",
+                             {"event=cli.args.parse",
+                              "result=fail",
+                              "option=count",
+                              "reason=invalid_count"});
+                return 1;
+            }
+            opts.genCount = static_cast<size_t>(n);
+        }
         else if (arg == "-v" || arg == "--version")
         {
             std::cout << "seal " << SEAL_VERSION << "\n";
@@ -378,6 +835,45 @@ static int parseArguments(int argc, char* argv[], ProgramOptions& opts)
     return -1;
 }
 
+// Select the KDF parameters new output is written with: --kdf, else the
+// SEAL_KDF environment variable, else the built-in scrypt defaults.
+// Returns 0 on success, 1 on an invalid or unavailable spec.
+static int applyKdfOptions(const ProgramOptions& opts)
+{
+    std::string spec = opts.kdfSpec;
+    if (spec.empty())
+    {
+        if (const char* env = std::getenv("SEAL_KDF"))
+            spec = env;
+    }
+    if (spec.empty())
+        return 0;
+
+    const auto kdf = seal::KdfParams::parse(spec);
+    try
+    {
+        if (!kdf)
+            throw std::invalid_argument("Invalid KDF spec");
+        seal::Cryptography::setKdfParams(*kdf);
+    }
+    catch (const std::exception& e)
+    {
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Error,
+                     "ARGS",
+                     {"event=cli.kdf.select",
+                      "result=fail",
+                      seal::diag::kv("kdf", seal::diag::sanitizeAscii(spec)),
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what()))});
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Info,
+                     "USAGE",
+                     {"syntax=scrypt:ln=N,r=R,p=P_or_argon2id:m=MiB,t=T,p=LANES"});
+        return 1;
+    }
+    return 0;
+}
+
 // Apply all process-wide security mitigations in dependency order.
 // Returns 0 on success, 1 if a critical mitigation fails.
 static int initializeSecurity(bool allowDynamicCode)
@@ -431,143 +927,83 @@ static int initializeSecurity(bool allowDynamicCode)
 }
 
 #ifdef USE_QT_UI
-static void loadImportDataFromFile(std::string& importData)
+// Import and export run as pipelines over fixed windows of entries: parse
+// (or pick) a window, seal (or open) it on the thread pool, hand it on in
+// order, wipe it. Plaintext in memory is bounded by one window plus the
+// reader's chunk, however large the credential set.
+constexpr size_t kTransferWindow = 256;
+
+// Progress on stderr at most once a second, so small transfers stay quiet.
+class TransferProgress
 {
-    std::string fileContent;
-    const std::string sourcePath = importData;
+public:
+    TransferProgress(std::string_view tag, std::string_view event, std::string opId)
+        : m_Tag(tag),
+          m_Event(event),
+          m_OpId(std::move(opId))
+    {
+    }
+
+    void update(size_t done)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - m_Last < std::chrono::seconds(1))
+            return;
+        m_Last = now;
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Step,
+                     m_Tag,
+                     {seal::diag::kv("event", m_Event),
+                      "result=progress",
+                      seal::diag::kv("op", m_OpId),
+                      seal::diag::kv("done", done),
+                      seal::diag::kv("elapsed_ms", seal::diag::elapsedMs(m_Started))});
+    }
 
+private:
+    std::string_view m_Tag;
+    std::string_view m_Event;
+    std::string m_OpId;
+    std::chrono::steady_clock::time_point m_Started = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point m_Last = m_Started;
+};
+
+// Open the import source: stdin for "-", the file if one exists at that
+// path, otherwise the argument itself as inline entries.
+static std::istream& openImportSource(const std::string& importData,
+                                      std::ifstream& file,
+                                      std::istringstream& text)
+{
     if (importData == "-")
     {
-        // Read from stdin - supports piping and paste (Ctrl+Z to end on Windows).
-        fileContent.assign(std::istreambuf_iterator<char>(std::cin),
-                           std::istreambuf_iterator<char>());
+        // Supports piping and paste (Ctrl+Z to end on Windows).
         writeCliDiag(std::cerr,
                      seal::console::Tone::Step,
                      "IMPORT",
                      {"event=import.read.begin", "source=stdin"});
+        return std::cin;
     }
-    else
+    file.open(importData, std::ios::binary);
+    if (file.good())
     {
-        std::ifstream testFile(importData);
-        if (!testFile.good())
-            return;
-
-        fileContent.assign(std::istreambuf_iterator<char>(testFile),
-                           std::istreambuf_iterator<char>());
-        testFile.close();
         writeCliDiag(
             std::cerr,
             seal::console::Tone::Step,
             "IMPORT",
-            {"event=import.read.begin", "source=file", seal::diag::pathSummary(sourcePath)});
+            {"event=import.read.begin", "source=file", seal::diag::pathSummary(importData)});
+        return file;
     }
-
-    // Replace newlines with commas so entries can be one-per-line or comma-separated.
-    std::replace_if(
-        fileContent.begin(), fileContent.end(), [](char c) { return c == '\n' || c == '\r'; }, ',');
-    importData = fileContent;
+    text.str(importData);
+    return text;
 }
 
-static int parseImportEntries(
-    const std::string& importData,
-    std::vector<std::tuple<std::string, std::string, std::string>>& entries)
+static int handleImportMode(std::string& importData,
+                            const std::string& importOutputPath,
+                            bool hexVault)
 {
-    std::string remaining = importData;
-    size_t entryIndex = 0;
-    while (!remaining.empty())
-    {
-        size_t commaPos = remaining.find(',');
-        std::string token =
-            (commaPos != std::string::npos) ? remaining.substr(0, commaPos) : remaining;
-        remaining = (commaPos != std::string::npos) ? remaining.substr(commaPos + 1) : "";
-
-        token = seal::utils::trim(token);
-        if (token.empty())
-            continue;
-        ++entryIndex;
-
-        size_t firstColon = token.find(':');
-        if (firstColon == std::string::npos)
-        {
-            writeCliDiag(std::cerr,
-                         seal::console::Tone::Error,
-                         "IMPORT",
-                         {"event=import.parse.finish",
-                          "result=fail",
-                          "reason=missing_first_colon",
-                          seal::diag::kv("entry_index", entryIndex),
-                          seal::diag::kv("token_len", token.size())});
-            return 1;
-        }
-        size_t secondColon = token.find(':', firstColon + 1);
-        if (secondColon == std::string::npos)
-        {
-            writeCliDiag(std::cerr,
-                         seal::console::Tone::Error,
-                         "IMPORT",
-                         {"event=import.parse.finish",
-                          "result=fail",
-                          "reason=missing_second_colon",
-                          seal::diag::kv("entry_index", entryIndex),
-                          seal::diag::kv("token_len", token.size())});
-            return 1;
-        }
-
-        // Reject entries with more than 2 colons: the format is strictly
-        // platform:username:password, so 3+ colons means ambiguous field
-        // boundaries that cannot be round-tripped through export/import.
-        if (token.find(':', secondColon + 1) != std::string::npos)
-        {
-            writeCliDiag(std::cerr,
-                         seal::console::Tone::Error,
-                         "IMPORT",
-                         {"event=import.parse.finish",
-                          "result=fail",
-                          "reason=too_many_colons",
-                          seal::diag::kv("entry_index", entryIndex),
-                          seal::diag::kv("token_len", token.size())});
-            return 1;
-        }
-
-        std::string platform = seal::utils::trim(token.substr(0, firstColon));
-        std::string user =
-            seal::utils::trim(token.substr(firstColon + 1, secondColon - firstColon - 1));
-        std::string pass = token.substr(secondColon + 1);
-
-        if (platform.empty() || user.empty() || pass.empty())
-        {
-            writeCliDiag(std::cerr,
-                         seal::console::Tone::Error,
-                         "IMPORT",
-                         {"event=import.parse.finish",
-                          "result=fail",
-                          "reason=empty_field",
-                          seal::diag::kv("entry_index", entryIndex),
-                          seal::diag::kv("token_len", token.size())});
-            return 1;
-        }
-        entries.emplace_back(platform, user, pass);
-    }
-    return 0;
-}
-
-static int handleImportMode(std::string& importData, const std::string& importOutputPath)
-{
-    loadImportDataFromFile(importData);
-
-    std::vector<std::tuple<std::string, std::string, std::string>> entries;
-    int rc = parseImportEntries(importData, entries);
-    if (rc != 0)
-        return rc;
-
-    if (entries.empty())
-    {
-        writeCliDiag(std::cerr,
-                     seal::console::Tone::Error,
-                     "IMPORT",
-                     {"event=import.finish", "result=fail", "reason=no_valid_entries"});
-        return 1;
-    }
+    std::ifstream sourceFile;
+    std::istringstream sourceText;
+    std::istream& source = openImportSource(importData, sourceFile, sourceText);
 
     const std::string opId = seal::diag::nextOpId("cli_import");
     writeCliDiag(std::cerr,
@@ -576,9 +1012,58 @@ static int handleImportMode(std::string& importData, const std::string& importOu
                  {"event=import.begin",
                   "result=start",
                   seal::diag::kv("op", opId),
-                  seal::diag::kv("entry_count", entries.size()),
                   seal::diag::pathSummary(importOutputPath)});
 
+    seal::ImportReader reader(source);
+    std::vector<seal::ImportEntry> window(kTransferWindow);
+    auto cleanseWindow = [&]
+    {
+        for (auto& entry : window)
+            entry.cleanse();
+        seal::Cryptography::cleanseString(importData);
+    };
+    // Parse up to one window; false (after reporting) on a rejected entry.
+    auto status = seal::ImportReader::Status::Entry;
+    auto fillWindow = [&](size_t& n)
+    {
+        n = 0;
+        while (n < window.size() &&
+               (status = reader.next(window[n])) == seal::ImportReader::Status::Entry)
+            ++n;
+        if (status == seal::ImportReader::Status::Entry ||
+            status == seal::ImportReader::Status::End)
+            return true;
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Error,
+                     "IMPORT",
+                     {"event=import.parse.finish",
+                      "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("reason", seal::ImportReader::reason(status)),
+                      seal::diag::kv("entry_index", reader.entryIndex()),
+                      seal::diag::kv("token_len", reader.entryLength())});
+        cleanseWindow();
+        return false;
+    };
+
+    // The first window is parsed before the password prompt, so malformed
+    // or empty input fails without asking for it.
+    size_t n = 0;
+    if (!fillWindow(n))
+        return 1;
+    if (n == 0)
+    {
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Error,
+                     "IMPORT",
+                     {"event=import.finish",
+                      "result=fail",
+                      seal::diag::kv("op", opId),
+                      "reason=no_valid_entries"});
+        cleanseWindow();
+        return 1;
+    }
+
     seal::basic_secure_string<wchar_t> masterPassword;
     try
     {
@@ -593,6 +1078,7 @@ static int handleImportMode(std::string& importData, const std::string& importOu
                       "result=fail",
                       seal::diag::kv("op", opId),
                       "reason=password_read_failed"});
+        cleanseWindow();
         return 1;
     }
     // DPAPIGuard wraps the master password with CryptProtectMemory while idle.
@@ -600,30 +1086,86 @@ static int handleImportMode(std::string& importData, const std::string& importOu
     // (or destructor) re-encrypts it so the plaintext key is short-lived.
     seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> importDpapi(&masterPassword);
 
+    // Only sealed records accumulate; the vault frame carries the record
+    // count up front, so it is written once the last window is sealed.
     std::vector<seal::VaultRecord> records;
-    records.reserve(entries.size());
     try
     {
         ScopedUnprotect dpapiScope(importDpapi);
-        for (const auto& [platform, user, pass] : entries)
+        const auto keySalt = seal::vaultKeySalt(records);
+        // Every imported record shares the vault key salt; the cache makes
+        // the first entry derive the record key and the rest reuse it, so
+        // the whole import costs one scrypt.
+        seal::VaultKeyCache keyCache;
+        TransferProgress progress("IMPORT", "import.progress", opId);
+        QThreadPool pool;
+        std::mutex failureMutex;
+        std::string failure;
+
+        auto sealEntry = [&](seal::ImportEntry& entry, seal::VaultRecord& record)
         {
-            auto secUser = seal::utils::utf8ToSecureWide(user);
-            auto secPass = seal::utils::utf8ToSecureWide(pass);
-            records.push_back(seal::encryptCredential(platform, secUser, secPass, masterPassword));
-            // Wipe the wide copies immediately; the encrypted VaultRecord now owns the data.
-            seal::Cryptography::cleanseString(secUser, secPass);
+            // The import writes a new vault, so there is no record to check the key against.
+            record = seal::encryptCredential(entry.platform,
+                                             entry.username,
+                                             entry.password,
+                                             masterPassword,
+                                             keySalt,
+                                             {},
+                                             &keyCache);
+            // Wipe the plaintext immediately; the encrypted VaultRecord now owns the data.
+            entry.cleanse();
+        };
+
+        for (;;)
+        {
+            const size_t base = records.size();
+            records.resize(base + n);
+            size_t first = 0;
+            if (base == 0)
+            {
+                // Seed the key cache on this thread so the workers do not
+                // all miss it and run the KDF side by side.
+                sealEntry(window[0], records[0]);
+                first = 1;
+            }
+            QtConcurrent::blockingMap(&pool,
+                                      window.begin() + first,
+                                      window.begin() + n,
+                                      [&](seal::ImportEntry& entry)
+                                      {
+                                          const size_t i = &entry - window.data();
+                                          try
+                                          {
+                                              sealEntry(entry, records[base + i]);
+                                          }
+                                          catch (const std::exception& e)
+                                          {
+                                              entry.cleanse();
+                                              std::lock_guard lock(failureMutex);
+                                              if (failure.empty())
+                                                  failure = e.what();
+                                          }
+                                      });
+            if (!failure.empty())
+                throw std::runtime_error(failure);
+            progress.update(records.size());
+            if (status == seal::ImportReader::Status::End)
+                break;
+            if (!fillWindow(n))
+            {
+                seal::Cryptography::cleanseString(masterPassword);
+                return 1;
+            }
         }
+        seal::Cryptography::cleanseString(importData);
 
         QString outputPath = QString::fromUtf8(importOutputPath.c_str());
         if (!outputPath.endsWith(".seal", Qt::CaseInsensitive))
             outputPath += ".seal";
 
-        // Cleanse the original plaintext entry strings now that every credential
-        // has been encrypted into a VaultRecord. This limits the plaintext lifetime.
-        for (auto& [p, u, pw] : entries)
-            seal::Cryptography::cleanseString(p, u, pw);
-
-        if (seal::saveVaultV2(outputPath, records, masterPassword))
+        const auto encoding = hexVault ? seal::VaultEncoding::Hex : seal::VaultEncoding::Binary;
+        if (seal::saveVaultV2(
+                outputPath, records, masterPassword, &keyCache, {}, nullptr, encoding))
         {
             writeCliDiag(std::cerr,
                          seal::console::Tone::Success,
@@ -657,6 +1199,7 @@ static int handleImportMode(std::string& importData, const std::string& importOu
                       seal::diag::kv("op", opId),
                       seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
                       seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what()))});
+        cleanseWindow();
         seal::Cryptography::cleanseString(masterPassword);
     }
     return 1;
@@ -697,11 +1240,14 @@ static int handleExportMode(const std::string& inputPath, const std::string& out
     }
     seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> exportDpapi(&masterPassword);
 
+    // Seeded by the load, so opening the credentials below costs no
+    // further key derivation.
+    seal::VaultKeyCache keyCache;
     std::vector<seal::VaultRecord> records;
     try
     {
         ScopedUnprotect dpapiScope(exportDpapi);
-        records = seal::loadVaultIndex(vaultPath, masterPassword);
+        records = seal::loadVaultIndex(vaultPath, masterPassword, &keyCache);
     }
     catch (const std::runtime_error& e)
     {
@@ -717,6 +1263,7 @@ static int handleExportMode(const std::string& inputPath, const std::string& out
         seal::Cryptography::cleanseString(masterPassword);
         return 1;
     }
+    std::erase_if(records, [](const seal::VaultRecord& rec) { return rec.deleted; });
 
     if (records.empty())
     {
@@ -729,9 +1276,6 @@ static int handleExportMode(const std::string& inputPath, const std::string& out
         return 0;
     }
 
-    // Stream each credential directly to the output instead of accumulating
-    // all plaintext in a heap buffer. This limits plaintext exposure to one
-    // record at a time rather than the entire vault.
     std::ofstream outFile;
     std::ostream* out = &std::cout;
     if (!outputPath.empty())
@@ -755,62 +1299,78 @@ static int handleExportMode(const std::string& inputPath, const std::string& out
 
     size_t exportedCount = 0;
     bool hasColonWarning = false;
-    size_t recordIndex = 0;
+    std::vector<seal::DecryptedCredential> window(kTransferWindow);
     try
     {
         ScopedUnprotect dpapiScope(exportDpapi);
-        for (const auto& rec : records)
+        TransferProgress progress("EXPORT", "export.progress", opId);
+        QThreadPool pool;
+        std::atomic<bool> failed{false};
+        for (size_t base = 0; base < records.size(); base += window.size())
         {
-            ++recordIndex;
-            if (rec.deleted)
+            // Open one window of credentials in parallel, then write it in
+            // vault order and wipe it before the next window is opened.
+            const size_t n = std::min(window.size(), records.size() - base);
+            QtConcurrent::blockingMap(&pool,
+                                      window.begin(),
+                                      window.begin() + n,
+                                      [&](seal::DecryptedCredential& cred)
+                                      {
+                                          const size_t i = &cred - window.data();
+                                          try
+                                          {
+                                              cred = seal::decryptCredentialOnDemand(
+                                                  records[base + i], masterPassword, &keyCache);
+                                          }
+                                          catch (const std::exception&)
+                                          {
+                                              failed.store(true, std::memory_order_relaxed);
+                                          }
+                                      });
+            if (failed.load(std::memory_order_relaxed))
+                throw std::runtime_error("decrypt failed");
+
+            for (size_t i = 0; i < n; ++i)
             {
-                continue;
-            }
-            // The export format is "platform:username:password" with exactly 2
-            // colon delimiters. If platform or username contain ':', the output
-            // cannot be round-tripped through --import because the parser splits
-            // on the first two colons. Warn the user so they can fix the data.
-            if (!hasColonWarning && (rec.platform.find(':') != std::string::npos))
-            {
-                writeCliDiag(std::cerr,
-                             seal::console::Tone::Warning,
-                             "EXPORT",
-                             {"event=export.data.warn",
-                              "result=warn",
-                              "reason=platform_contains_colon",
-                              seal::diag::kv("record_index", recordIndex),
-                              seal::diag::kv("platform_len", rec.platform.size())});
-                hasColonWarning = true;
-            }
-            auto cred = seal::decryptCredentialOnDemand(rec, masterPassword);
-            std::string user = seal::utils::secureWideToUtf8(cred.username);
-            std::string pass = seal::utils::secureWideToUtf8(cred.password);
-            if (!hasColonWarning && user.find(':') != std::string::npos)
-            {
-                writeCliDiag(std::cerr,
-                             seal::console::Tone::Warning,
-                             "EXPORT",
-                             {"event=export.data.warn",
-                              "result=warn",
-                              "reason=username_contains_colon",
-                              seal::diag::kv("record_index", recordIndex),
-                              seal::diag::kv("platform_len", rec.platform.size()),
-                              seal::diag::kv("username_len", user.size())});
-                hasColonWarning = true;
+                const auto& rec = records[base + i];
+                auto& cred = window[i];
+                // The export format is "platform:username:password" with exactly 2
+                // colon delimiters. If platform or username contain ':', the output
+                // cannot be round-tripped through --import because the parser splits
+                // on the first two colons. Warn the user so they can fix the data.
+                std::string user = seal::utils::secureWideToUtf8(cred.username);
+                std::string pass = seal::utils::secureWideToUtf8(cred.password);
+                const bool platformColon = rec.platform.find(':') != std::string::npos;
+                if (!hasColonWarning && (platformColon || user.find(':') != std::string::npos))
+                {
+                    writeCliDiag(std::cerr,
+                                 seal::console::Tone::Warning,
+                                 "EXPORT",
+                                 {"event=export.data.warn",
+                                  "result=warn",
+                                  platformColon ? "reason=platform_contains_colon"
+                                                : "reason=username_contains_colon",
+                                  seal::diag::kv("record_index", base + i + 1),
+                                  seal::diag::kv("platform_len", rec.platform.size()),
+                                  seal::diag::kv("username_len", user.size())});
+                    hasColonWarning = true;
+                }
+                // Write directly to output, cleanse immediately: only the
+                // current window is ever in memory, one line of it pageable.
+                if (exportedCount > 0)
+                    *out << ',';
+                *out << rec.platform << ':' << user << ':' << pass;
+                ++exportedCount;
+                seal::Cryptography::cleanseString(user, pass);
+                cred.cleanse();
             }
-            // Write directly to output, cleanse immediately. No intermediate
-            // accumulation buffer means only one credential is in pageable
-            // memory at any moment.
-            if (exportedCount > 0)
-                *out << ',';
-            *out << rec.platform << ':' << user << ':' << pass;
-            ++exportedCount;
-            seal::Cryptography::cleanseString(user, pass);
-            cred.cleanse();
+            progress.update(exportedCount);
         }
     }
     catch (const std::exception&)
     {
+        for (auto& cred : window)
+            cred.cleanse();
         seal::Cryptography::cleanseString(masterPassword);
         writeCliDiag(std::cerr,
                      seal::console::Tone::Error,
@@ -837,6 +1397,158 @@ static int handleExportMode(const std::string& inputPath, const std::string& out
     }
     return 0;
 }
+
+// Open the breach list named by --pwned, reporting a first-use index build.
+static std::unique_ptr<seal::BreachIndex> openBreachIndex(const std::string& pwnedPath,
+                                                          bool bloom,
+                                                          const std::string& opId)
+{
+    const auto started = std::chrono::steady_clock::now();
+    auto report = [&](uint64_t bytesRead)
+    {
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Step,
+                     "AUDIT",
+                     {"event=audit.index.build.progress",
+                      "result=progress",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("bytes_read", bytesRead),
+                      seal::diag::kv("elapsed_ms", seal::diag::elapsedMs(started))});
+        return true;
+    };
+    seal::BreachIndex::BuildStats built;
+    auto index = seal::BreachIndex::openOrBuild(pwnedPath, bloom, report, &built);
+    if (built.lines != 0)
+    {
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Success,
+                     "AUDIT",
+                     {"event=audit.index.build.finish",
+                      "result=ok",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("lines", built.lines),
+                      seal::diag::kv("entries", built.entries),
+                      seal::diag::kv("bloom_bits", built.bloomBits),
+                      seal::diag::kv("index_bytes", built.indexBytes),
+                      seal::diag::pathSummary(pwnedPath + ".sidx", "dst"),
+                      seal::diag::kv("duration_ms", seal::diag::elapsedMs(started))});
+    }
+    return index;
+}
+
+static int handleAuditMode(const std::string& inputPath, const std::string& pwnedPath, bool bloom)
+{
+    QString vaultPath = QString::fromUtf8(inputPath.c_str());
+    if (!vaultPath.endsWith(".seal", Qt::CaseInsensitive))
+        vaultPath += ".seal";
+
+    const std::string opId = seal::diag::nextOpId("cli_audit");
+    writeCliDiag(std::cerr,
+                 seal::console::Tone::Step,
+                 "AUDIT",
+                 {"event=audit.begin",
+                  "result=start",
+                  seal::diag::kv("op", opId),
+                  seal::diag::pathSummary(vaultPath.toUtf8().toStdString(), "src"),
+                  seal::diag::kv("breach_list", !pwnedPath.empty())});
+
+    // The (possibly long) index build runs before the password is read, so
+    // the password is never held in memory while it does.
+    std::unique_ptr<seal::BreachIndex> breaches;
+    if (!pwnedPath.empty())
+    {
+        try
+        {
+            breaches = openBreachIndex(pwnedPath, bloom, opId);
+        }
+        catch (const std::exception& e)
+        {
+            writeCliDiag(std::cerr,
+                         seal::console::Tone::Error,
+                         "AUDIT",
+                         {"event=audit.finish",
+                          "result=fail",
+                          seal::diag::kv("op", opId),
+                          seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                          seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                          seal::diag::pathSummary(pwnedPath, "pwned")});
+            return 1;
+        }
+    }
+
+    seal::basic_secure_string<wchar_t> masterPassword;
+    try
+    {
+        masterPassword = seal::readPasswordConsole();
+    }
+    catch (...)
+    {
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Error,
+                     "AUDIT",
+                     {"event=audit.finish",
+                      "result=fail",
+                      seal::diag::kv("op", opId),
+                      "reason=password_read_failed"});
+        return 1;
+    }
+    seal::DPAPIGuard<seal::basic_secure_string<wchar_t>> auditDpapi(&masterPassword);
+
+    seal::VaultKeyCache keyCache;
+    std::vector<seal::VaultRecord> records;
+    std::vector<uint8_t> flags;
+    seal::VaultAuditSummary summary;
+    try
+    {
+        ScopedUnprotect dpapiScope(auditDpapi);
+        records = seal::loadVaultIndex(vaultPath, masterPassword, &keyCache);
+        flags = seal::auditCredentials(
+            records, masterPassword, &keyCache, breaches.get(), {}, &summary);
+    }
+    catch (const std::runtime_error& e)
+    {
+        writeCliDiag(std::cerr,
+                     seal::console::Tone::Error,
+                     "AUDIT",
+                     {"event=audit.finish",
+                      "result=fail",
+                      seal::diag::kv("op", opId),
+                      seal::diag::kv("reason", seal::diag::reasonFromMessage(e.what())),
+                      seal::diag::kv("detail", seal::diag::sanitizeAscii(e.what())),
+                      seal::diag::pathSummary(vaultPath.toUtf8().toStdString(), "src")});
+        seal::Cryptography::cleanseString(masterPassword);
+        return 1;
+    }
+    seal::Cryptography::cleanseString(masterPassword);
+
+    // Findings go to stdout, one flagged platform per line; no credential
+    // material is ever printed.
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        if (flags[i] == 0)
+            continue;
+        const bool breached = (flags[i] & seal::AuditBreached) != 0;
+        const bool reused = (flags[i] & seal::AuditReused) != 0;
+        std::cout << (breached && reused ? "breached,reused" : breached ? "breached" : "reused")
+                  << '\t' << records[i].platform << '\n';
+    }
+    std::cout.flush();
+
+    writeCliDiag(std::cerr,
+                 summary.breached || summary.reused ? seal::console::Tone::Warning
+                                                    : seal::console::Tone::Success,
+                 "AUDIT",
+                 {"event=audit.finish",
+                  "result=ok",
+                  seal::diag::kv("op", opId),
+                  seal::diag::kv("checked", summary.checked),
+                  seal::diag::kv("breached", summary.breached),
+                  seal::diag::kv("reused", summary.reused),
+                  seal::diag::kv("reuse_groups", summary.reuseGroups),
+                  breaches ? seal::diag::kv("breach_entries", breaches->size())
+                           : "breach_list=none"});
+    return 0;
+}
 #endif  // USE_QT_UI
 
 // Process the "seal" input file (a text file named literally "seal" in the cwd).
@@ -917,17 +1629,20 @@ static int handleCliMode()
 
         for (;;)
         {
-            std::pair<std::vector<std::string>, bool> batch;
+            seal::BulkInput batch;
             if (!seal::readBulkLinesDualOrEsc(batch))
             {
                 (void)handleEscSealFile(dpapi, password);
                 return 0;
             }
-            if (batch.first.empty())
+            if (batch.lines.empty())
                 break;
 
-            ScopedUnprotect dpapiScope(dpapi);
-            seal::FileOperations::processBatch(batch.first, batch.second, password);
+            {
+                ScopedUnprotect dpapiScope(dpapi);
+                seal::FileOperations::processBatch(batch.lines, batch.uncensored, password);
+            }
+            batch.cleanse();
         }
         seal::Cryptography::cleanseString(password);
         seal::wipeConsoleBuffer();
@@ -975,6 +1690,13 @@ int main(int argc, char* argv[])
     if (rc != 0)
         return rc;
 
+    rc = applyKdfOptions(opts);
+    if (rc != 0)
+        return rc;
+    seal::Cryptography::setSegmentCompression(opts.compress);
+    if (opts.aead)
+        seal::Cryptography::setAead(*opts.aead);
+
     // Set OpenCV environment variables while still single-threaded.
     // captureQrFromWebcam() runs on a worker thread and reads these via
     // std::getenv; setting them here avoids a data race on the process
@@ -988,11 +1710,24 @@ int main(int argc, char* argv[])
         ~ClipboardShutdownGuard() { seal::Clipboard::shutdown(); }
     } clipGuard;
 
+    // --stats: dump the in-process counters and latency histograms once the
+    // command has finished, however it returns.
+    struct StatsGuard
+    {
+        bool enabled;
+        ~StatsGuard()
+        {
+            if (enabled)
+                std::cerr << seal::metrics::report(seal::metrics::snapshot())
+                          << seal::working_set::report(seal::working_set::stats());
+        }
+    } statsGuard{opts.stats};
+
     switch (opts.mode)
     {
         case Mode::Import:
 #ifdef USE_QT_UI
-            return handleImportMode(opts.inputPath, opts.outputPath);
+            return handleImportMode(opts.inputPath, opts.outputPath, opts.hexVault);
 #else
             writeCliDiag(std::cerr,
                          seal::console::Tone::Error,
@@ -1018,24 +1753,59 @@ int main(int argc, char* argv[])
             return 1;
 #endif
 
+        case Mode::Audit:
+#ifdef USE_QT_UI
+            return handleAuditMode(opts.inputPath, opts.pwnedPath, opts.bloom);
+#else
+            writeCliDiag(std::cerr,
+                         seal::console::Tone::Error,
+                         "CLI",
+                         {"event=cli.mode.dispatch",
+                          "result=fail",
+                          "command=audit",
+                          "reason=qt_ui_unavailable"});
+            return 1;
+#endif
+
         case Mode::Gen:
-            return seal::HandleGenMode(opts.genLength);
+            return seal::HandleGenMode(opts.genLength, opts.genCount);
         case Mode::Shred:
             return seal::HandleShredMode(opts.inputPath);
         case Mode::Hash:
-            return seal::HandleHashMode(opts.inputPath);
+            return seal::HandleHashMode(opts.inputPath, opts.outputPath, opts.blake2);
         case Mode::Verify:
             return seal::HandleVerifyMode(opts.inputPath);
+        case Mode::Cat:
+            return seal::HandleCatMode(opts.inputPath, opts.catOffset, opts.catLength);
         case Mode::Wipe:
             return seal::HandleWipeMode();
+        case Mode::Sync:
+            return seal::HandleSyncMode(opts.inputPath, opts.outputPath);
+        case Mode::Pack:
+            return seal::HandlePackMode(opts.inputPath, opts.outputPath);
+        case Mode::Unpack:
+            return seal::HandleUnpackMode(
+                opts.inputPath, opts.outputPath, opts.member, opts.listOnly);
+        case Mode::KdfCalibrate:
+            return seal::HandleKdfCalibrateMode(opts.kdfTargetMs, opts.kdfMemoryMiB);
         case Mode::FileEncrypt:
-            return seal::HandleFileEncrypt(opts.inputPath, opts.outputPath);
+            return seal::HandleFileEncrypt(opts.inputPath, opts.outputPath, opts.threads);
         case Mode::FileDecrypt:
-            return seal::HandleFileDecrypt(opts.inputPath, opts.outputPath);
+            return seal::HandleFileDecrypt(opts.inputPath, opts.outputPath, opts.threads);
         case Mode::TextEncrypt:
+            if (opts.useAgent)
+                return seal::HandleAgentStringMode(true, opts.stringData);
             return seal::HandleStringMode(true, opts.stringData);
         case Mode::TextDecrypt:
+            if (opts.useAgent)
+                return seal::HandleAgentStringMode(false, opts.stringData);
             return seal::HandleStringMode(false, opts.stringData);
+        case Mode::Agent:
+            return seal::HandleAgentMode(opts.inputPath, opts.agentTtlMinutes);
+        case Mode::Lookup:
+            return seal::HandleLookupMode(opts.inputPath);
+        case Mode::Lock:
+            return seal::HandleLockMode();
 
         case Mode::Gui:
 #ifdef USE_QT_UI
@@ -0,0 +1,176 @@
+/**
+ * @file test_agent.cpp
+ * @brief Tests for the agent wire protocol and its in-process request handler
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "test_helpers.h"
+
+#include "../src/Agent.h"
+#include "../src/Metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <span>
+#include <string>
+#include <vector>
+
+using seal::agent::Verb;
+
+namespace
+{
+
+seal::agent::Server::Password makeWidePassword(const std::wstring& s)
+{
+    seal::agent::Server::Password result;
+    for (wchar_t c : s)
+        result.push_back(c);
+    return result;
+}
+
+std::string b64(const std::string& s)
+{
+    return seal::utils::toBase64(
+        std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(s.data()), s.size()));
+}
+
+std::string unb64(const std::string& s)
+{
+    auto bytes = seal::utils::fromBase64(s);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+// Payload of an `ok` reply; fails the test on anything else.
+std::string okPayload(const std::string& line)
+{
+    auto reply = seal::agent::parseReply(line);
+    EXPECT_TRUE(reply.has_value());
+    if (!reply)
+        return {};
+    EXPECT_TRUE(reply->ok) << line;
+    return reply->payload;
+}
+
+}  // namespace
+
+TEST(AgentProtocolTest, ParsesVerbAndPayload)
+{
+    auto request = seal::agent::parseRequest("encrypt aGVsbG8=\r\n");
+    ASSERT_TRUE(request.has_value());
+    EXPECT_EQ(request->verb, Verb::Encrypt);
+    EXPECT_EQ(request->payload, "aGVsbG8=");
+
+    request = seal::agent::parseRequest("lookup my bank");
+    ASSERT_TRUE(request.has_value());
+    EXPECT_EQ(request->verb, Verb::Lookup);
+    EXPECT_EQ(request->payload, "my bank");
+
+    request = seal::agent::parseRequest("ping");
+    ASSERT_TRUE(request.has_value());
+    EXPECT_EQ(request->verb, Verb::Ping);
+    EXPECT_TRUE(request->payload.empty());
+
+    EXPECT_FALSE(seal::agent::parseRequest("").has_value());
+    EXPECT_FALSE(seal::agent::parseRequest("encrypted x").has_value());
+    EXPECT_FALSE(seal::agent::parseRequest("PING").has_value());
+}
+
+TEST(AgentProtocolTest, RequestsAndRepliesRoundTrip)
+{
+    for (Verb verb : {Verb::Ping, Verb::Encrypt, Verb::Decrypt, Verb::Lookup, Verb::Lock})
+    {
+        const std::string line = seal::agent::formatRequest(verb, "payload");
+        ASSERT_EQ(line.back(), '\n');
+        auto request = seal::agent::parseRequest(line);
+        ASSERT_TRUE(request.has_value());
+        EXPECT_EQ(request->verb, verb);
+        EXPECT_EQ(request->payload, "payload");
+    }
+
+    EXPECT_EQ(seal::agent::formatReply(true), "ok\n");
+    auto reply = seal::agent::parseReply(seal::agent::formatReply(false, "not_found"));
+    ASSERT_TRUE(reply.has_value());
+    EXPECT_FALSE(reply->ok);
+    EXPECT_EQ(reply->payload, "not_found");
+    EXPECT_FALSE(seal::agent::parseReply("maybe later").has_value());
+}
+
+TEST(AgentServerTest, RequestsShareOneKeyDerivation)
+{
+    seal::agent::Server server(makeWidePassword(L"agent_password"));
+    seal::metrics::reset();
+
+    std::vector<std::string> packets;
+    for (int i = 0; i < 5; ++i)
+        packets.push_back(okPayload(server.handle(
+            seal::agent::formatRequest(Verb::Encrypt, b64("secret " + std::to_string(i))))));
+    for (int i = 0; i < 5; ++i)
+    {
+        const std::string plain =
+            okPayload(server.handle(seal::agent::formatRequest(Verb::Decrypt, packets[i])));
+        EXPECT_EQ(unb64(plain), "secret " + std::to_string(i));
+    }
+
+    EXPECT_EQ(seal::metrics::snapshot().counter(seal::metrics::Counter::KeyDerivations), 1u);
+    seal::metrics::reset();
+}
+
+TEST(AgentServerTest, AgentPacketsDecryptWithThePasswordAlone)
+{
+    seal::agent::Server server(makeWidePassword(L"agent_password"));
+    const std::string hex =
+        okPayload(server.handle(seal::agent::formatRequest(Verb::Encrypt, b64("standalone"))));
+
+    std::vector<unsigned char> packet;
+    ASSERT_TRUE(seal::utils::from_hex(std::string_view{hex}, packet));
+    auto password = makeWidePassword(L"agent_password");
+    auto plain =
+        seal::Cryptography::decryptPacket(std::span<const unsigned char>(packet), password);
+    EXPECT_EQ(std::string(plain.begin(), plain.end()), "standalone");
+}
+
+TEST(AgentServerTest, DecryptsPacketsSealedElsewhere)
+{
+    auto password = makeWidePassword(L"agent_password");
+    const std::string text = "from seal -e";
+    auto packet = seal::Cryptography::encryptPacket(
+        std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(text.data()),
+                                       text.size()),
+        password);
+
+    seal::agent::Server server(makeWidePassword(L"agent_password"));
+    const std::string viaHex = okPayload(server.handle(
+        seal::agent::formatRequest(Verb::Decrypt, seal::utils::to_hex(packet))));
+    EXPECT_EQ(unb64(viaHex), text);
+    const std::string viaB64 = okPayload(server.handle(
+        seal::agent::formatRequest(Verb::Decrypt, seal::utils::toBase64(packet))));
+    EXPECT_EQ(unb64(viaB64), text);
+}
+
+TEST(AgentServerTest, WrongPasswordAndBadInputAreRefused)
+{
+    seal::agent::Server sealer(makeWidePassword(L"right_password"));
+    const std::string hex =
+        okPayload(sealer.handle(seal::agent::formatRequest(Verb::Encrypt, b64("secret"))));
+
+    seal::agent::Server server(makeWidePassword(L"wrong_password"));
+    EXPECT_EQ(server.handle(seal::agent::formatRequest(Verb::Decrypt, hex)),
+              "err decrypt_failed\n");
+    EXPECT_EQ(server.handle(seal::agent::formatRequest(Verb::Encrypt, "not base64!")),
+              "err invalid_encoding\n");
+    EXPECT_EQ(server.handle("shutdown now"), "err bad_request\n");
+    EXPECT_EQ(server.handle(seal::agent::formatRequest(Verb::Lookup, "github")),
+              "err no_vault\n");
+}
+
+TEST(AgentServerTest, LockRefusesLaterRequests)
+{
+    seal::agent::Server server(makeWidePassword(L"agent_password"));
+    EXPECT_EQ(server.handle("ping\n"), "ok\n");
+    EXPECT_FALSE(server.locked());
+    EXPECT_EQ(server.handle("lock\n"), "ok\n");
+    EXPECT_TRUE(server.locked());
+    EXPECT_EQ(server.handle(seal::agent::formatRequest(Verb::Encrypt, b64("late"))),
+              "err locked\n");
+}
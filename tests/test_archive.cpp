@@ -0,0 +1,159 @@
+/**
+ * @file test_archive.cpp
+ * @brief Tests for `seal pack` / `seal unpack` archives and the index compressor
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "test_helpers.h"
+
+#include "../src/Compression.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class ArchiveTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() / "seal_archive_tests";
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root / "src" / "sub" / "deeper");
+        m_Src = m_Root / "src";
+        m_Archive = m_Root / "out.seal";
+        m_Dst = m_Root / "dst";
+
+        write(m_Src / "a.txt", "alpha");
+        write(m_Src / "empty.txt", "");
+        write(m_Src / "sub" / "b.txt", "bravo");
+        // Spans several segments, so it takes the streaming path.
+        m_Large.resize(2 * seal::cfg::SEGMENT_LEN + 123);
+        for (size_t i = 0; i < m_Large.size(); ++i)
+            m_Large[i] = static_cast<char>(i * 31 + 7);
+        write(m_Src / "sub" / "deeper" / "large.bin", m_Large);
+    }
+
+    void TearDown() override { fs::remove_all(m_Root); }
+
+    static void write(const fs::path& p, const std::string& content)
+    {
+        std::ofstream out(p, std::ios::binary | std::ios::trunc);
+        out << content;
+    }
+
+    static std::string read(const fs::path& p)
+    {
+        std::ifstream in(p, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    }
+
+    bool pack()
+    {
+        return seal::FileOperations::packDirectory(m_Src.string(), m_Archive.string(), password);
+    }
+
+    seal::secure_string<> password = make_secure_string("test_password");
+    fs::path m_Root;
+    fs::path m_Src;
+    fs::path m_Archive;
+    fs::path m_Dst;
+    std::string m_Large;
+};
+
+TEST_F(ArchiveTest, ListShowsEveryFileSortedByPath)
+{
+    ASSERT_TRUE(pack());
+    EXPECT_FALSE(fs::exists(m_Archive.string() + ".tmp"));
+
+    const auto members = seal::FileOperations::listArchive(m_Archive.string(), password);
+    ASSERT_EQ(members.size(), 4u);
+    EXPECT_EQ(members[0].path, "a.txt");
+    EXPECT_EQ(members[1].path, "empty.txt");
+    EXPECT_EQ(members[2].path, "sub/b.txt");
+    EXPECT_EQ(members[3].path, "sub/deeper/large.bin");
+    EXPECT_EQ(members[0].size, 5u);
+    EXPECT_EQ(members[1].size, 0u);
+    EXPECT_EQ(members[3].size, m_Large.size());
+}
+
+TEST_F(ArchiveTest, UnpackRestoresTheTree)
+{
+    ASSERT_TRUE(pack());
+    ASSERT_TRUE(seal::FileOperations::unpackArchive(m_Archive.string(), m_Dst.string(), password));
+    EXPECT_EQ(read(m_Dst / "a.txt"), "alpha");
+    EXPECT_EQ(read(m_Dst / "empty.txt"), "");
+    EXPECT_EQ(read(m_Dst / "sub" / "b.txt"), "bravo");
+    EXPECT_EQ(read(m_Dst / "sub" / "deeper" / "large.bin"), m_Large);
+    EXPECT_EQ(fs::last_write_time(m_Dst / "a.txt"), fs::last_write_time(m_Src / "a.txt"));
+}
+
+TEST_F(ArchiveTest, SingleMemberIsExtractedAlone)
+{
+    ASSERT_TRUE(pack());
+    ASSERT_TRUE(seal::FileOperations::unpackArchive(
+        m_Archive.string(), m_Dst.string(), password, "sub/b.txt"));
+    EXPECT_EQ(read(m_Dst / "sub" / "b.txt"), "bravo");
+    EXPECT_FALSE(fs::exists(m_Dst / "a.txt"));
+
+    EXPECT_FALSE(seal::FileOperations::unpackArchive(
+        m_Archive.string(), m_Dst.string(), password, "missing.txt"));
+}
+
+TEST_F(ArchiveTest, WrongPasswordIsRejected)
+{
+    ASSERT_TRUE(pack());
+    auto wrong = make_secure_string("wrong_password");
+    EXPECT_THROW((void)seal::FileOperations::listArchive(m_Archive.string(), wrong),
+                 std::runtime_error);
+    EXPECT_FALSE(seal::FileOperations::unpackArchive(m_Archive.string(), m_Dst.string(), wrong));
+    EXPECT_FALSE(fs::exists(m_Dst / "a.txt"));
+}
+
+TEST_F(ArchiveTest, TamperedMemberFailsAndLeavesNoFile)
+{
+    ASSERT_TRUE(pack());
+    const auto members = seal::FileOperations::listArchive(m_Archive.string(), password);
+    const auto& large = members[3];
+    {
+        std::fstream f(m_Archive, std::ios::binary | std::ios::in | std::ios::out);
+        const auto pos = static_cast<std::streamoff>(large.offset + large.length / 2);
+        f.seekg(pos);
+        char c = 0;
+        f.get(c);
+        f.seekp(pos);
+        f.put(static_cast<char>(c ^ 0x01));
+    }
+
+    EXPECT_FALSE(seal::FileOperations::unpackArchive(m_Archive.string(), m_Dst.string(), password));
+    EXPECT_FALSE(fs::exists(m_Dst / "sub" / "deeper" / "large.bin"));
+    // The other members are independent and still extract.
+    EXPECT_EQ(read(m_Dst / "sub" / "b.txt"), "bravo");
+}
+
+TEST(CompressionTest, RoundTripsAndChecksTheRawLength)
+{
+    std::string text;
+    for (int i = 0; i < 2000; ++i)
+        text += "path/to/member" + std::to_string(i % 50) + "\t12345\n";
+    const auto raw = std::span<const unsigned char>(
+        reinterpret_cast<const unsigned char*>(text.data()), text.size());
+
+    const auto packed = seal::compression::compress(raw);
+    EXPECT_LT(packed.size(), raw.size() / 4);
+
+    std::vector<unsigned char> out(raw.size());
+    seal::compression::decompress(packed, out);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), raw.begin()));
+
+    std::vector<unsigned char> shortOut(raw.size() - 1);
+    EXPECT_THROW(seal::compression::decompress(packed, shortOut), std::runtime_error);
+    EXPECT_TRUE(seal::compression::compress({}).empty());
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_breach_index.cpp
+ * @brief Tests for the memory-mapped breached-password index
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "../src/BreachIndex.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+using Digest = std::array<unsigned char, 20>;
+
+Digest digestOf(const std::string& password)
+{
+    Digest out{};
+    seal::BreachIndex::sha1(
+        {reinterpret_cast<const unsigned char*>(password.data()), password.size()}, out);
+    return out;
+}
+
+Digest digestFromHex(const std::string& hex)
+{
+    Digest out{};
+    for (size_t i = 0; i < out.size(); ++i)
+        out[i] = static_cast<unsigned char>(std::stoi(hex.substr(i * 2, 2), nullptr, 16));
+    return out;
+}
+
+// Sorted the way HIBP publishes it; "password" and "123456" are real entries.
+const char* kDump =
+    "0000000000000000000000000000000000000001:3\r\n"
+    "5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8:9545824\r\n"
+    "7C4A8D09CA3762AF61E59520943DC26494F8941B:24230577\r\n"
+    "\r\n"
+    "FFFFFFFFFFFFFFFF000000000000000000000000:1\r\n";
+
+}  // namespace
+
+class BreachIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() / "seal_breach_tests";
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root);
+        m_Index = (m_Root / "pwned.sidx").string();
+    }
+
+    void TearDown() override { fs::remove_all(m_Root); }
+
+    seal::BreachIndex::BuildStats build(const std::string& dump, uint64_t bloomEntries = 0)
+    {
+        std::istringstream in(dump);
+        return seal::BreachIndex::build(in, m_Index, bloomEntries);
+    }
+
+    fs::path m_Root;
+    std::string m_Index;
+};
+
+TEST(BreachIndexHash, Sha1MatchesKnownVector)
+{
+    EXPECT_EQ(digestOf("password"), digestFromHex("5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8"));
+}
+
+TEST_F(BreachIndexTest, FindsListedHashesAndRejectsOthers)
+{
+    const auto stats = build(kDump);
+    EXPECT_EQ(stats.lines, 4u);
+    EXPECT_EQ(stats.entries, 4u);
+    EXPECT_EQ(stats.bloomBits, 0u);
+    EXPECT_EQ(stats.indexBytes, fs::file_size(m_Index));
+
+    seal::BreachIndex index(m_Index);
+    EXPECT_EQ(index.size(), 4u);
+    EXPECT_FALSE(index.hasBloom());
+    EXPECT_TRUE(index.contains(digestOf("password")));
+    EXPECT_TRUE(index.contains(digestOf("123456")));
+    EXPECT_TRUE(index.contains(digestFromHex("FFFFFFFFFFFFFFFF000000000000000000000000")));
+    EXPECT_FALSE(index.contains(digestOf("correct horse battery staple")));
+    EXPECT_FALSE(index.contains(digestFromHex("0000000000000002000000000000000000000000")));
+}
+
+TEST_F(BreachIndexTest, BloomFilterKeepsEveryHit)
+{
+    const auto stats = build(kDump, 4);
+    EXPECT_GT(stats.bloomBits, 0u);
+    EXPECT_EQ(stats.bloomBits % 64, 0u);
+
+    seal::BreachIndex index(m_Index);
+    EXPECT_TRUE(index.hasBloom());
+    EXPECT_TRUE(index.contains(digestOf("password")));
+    EXPECT_TRUE(index.contains(digestOf("123456")));
+    EXPECT_FALSE(index.contains(digestOf("correct horse battery staple")));
+}
+
+TEST_F(BreachIndexTest, AcceptsBareHashesWithLineFeeds)
+{
+    build("5baa61e4c9b93f3f0682250b6cf8331b7ee68fd8\n7c4a8d09ca3762af61e59520943dc26494f8941b\n");
+    seal::BreachIndex index(m_Index);
+    EXPECT_TRUE(index.contains(digestOf("password")));
+}
+
+TEST_F(BreachIndexTest, StoresASharedPrefixOnce)
+{
+    const auto stats = build(
+        "5BAA61E4C9B93F3F0000000000000000000000AA:1\n"
+        "5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8:2\n");
+    EXPECT_EQ(stats.lines, 2u);
+    EXPECT_EQ(stats.entries, 1u);
+    seal::BreachIndex index(m_Index);
+    EXPECT_TRUE(index.contains(digestOf("password")));
+}
+
+TEST_F(BreachIndexTest, RejectsUnsortedDump)
+{
+    EXPECT_THROW(build("7C4A8D09CA3762AF61E59520943DC26494F8941B:1\n"
+                       "5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8:1\n"),
+                 std::runtime_error);
+    EXPECT_FALSE(fs::exists(m_Index));
+    EXPECT_FALSE(fs::exists(m_Index + ".tmp"));
+}
+
+TEST_F(BreachIndexTest, RejectsMalformedLine)
+{
+    EXPECT_THROW(build("5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8:1\nnot a hash\n"),
+                 std::runtime_error);
+    EXPECT_THROW(build("5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8x\n"), std::runtime_error);
+    EXPECT_FALSE(fs::exists(m_Index));
+}
+
+TEST_F(BreachIndexTest, CancelledBuildLeavesNoFile)
+{
+    // Large enough to cross a progress report.
+    std::string dump;
+    const std::string line = "5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8:1\n";
+    while (dump.size() < (65u << 20))
+        dump += line;
+    std::istringstream in(dump);
+    EXPECT_THROW(seal::BreachIndex::build(in, m_Index, 0, [](uint64_t) { return false; }),
+                 std::runtime_error);
+    EXPECT_FALSE(fs::exists(m_Index));
+    EXPECT_FALSE(fs::exists(m_Index + ".tmp"));
+}
+
+TEST_F(BreachIndexTest, DetectsIndexFiles)
+{
+    build(kDump);
+    const std::string dumpPath = (m_Root / "pwned.txt").string();
+    std::ofstream(dumpPath, std::ios::binary) << kDump;
+    EXPECT_TRUE(seal::BreachIndex::isIndexFile(m_Index));
+    EXPECT_FALSE(seal::BreachIndex::isIndexFile(dumpPath));
+    EXPECT_FALSE(seal::BreachIndex::isIndexFile((m_Root / "missing").string()));
+}
+
+TEST_F(BreachIndexTest, OpeningANonIndexThrows)
+{
+    const std::string dumpPath = (m_Root / "pwned.txt").string();
+    std::ofstream(dumpPath, std::ios::binary) << kDump;
+    EXPECT_THROW(seal::BreachIndex{dumpPath}, std::runtime_error);
+    EXPECT_THROW(seal::BreachIndex{(m_Root / "missing").string()}, std::runtime_error);
+}
+
+TEST_F(BreachIndexTest, OpeningATruncatedIndexThrows)
+{
+    build(kDump);
+    fs::resize_file(m_Index, fs::file_size(m_Index) - 8);
+    EXPECT_THROW(seal::BreachIndex{m_Index}, std::runtime_error);
+}
+
+TEST_F(BreachIndexTest, OpenOrBuildIndexesADumpOnce)
+{
+    const std::string dumpPath = (m_Root / "pwned.txt").string();
+    std::ofstream(dumpPath, std::ios::binary) << kDump;
+
+    seal::BreachIndex::BuildStats built;
+    {
+        auto index = seal::BreachIndex::openOrBuild(dumpPath, true, {}, &built);
+        EXPECT_EQ(built.entries, 4u);
+        EXPECT_TRUE(index->hasBloom());
+        EXPECT_TRUE(index->contains(digestOf("password")));
+    }
+    EXPECT_TRUE(seal::BreachIndex::isIndexFile(dumpPath + ".sidx"));
+
+    // The index is now newer than the dump, so it is reused as it is.
+    auto again = seal::BreachIndex::openOrBuild(dumpPath, false, {}, &built);
+    EXPECT_EQ(built.lines, 0u);
+    EXPECT_TRUE(again->hasBloom());
+
+    // An index path opens directly.
+    auto direct = seal::BreachIndex::openOrBuild(dumpPath + ".sidx", false, {}, &built);
+    EXPECT_EQ(built.lines, 0u);
+    EXPECT_EQ(direct->size(), 4u);
+}
@@ -9,9 +9,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace std::string_literals;
@@ -191,3 +194,578 @@ TEST_F(CryptoTest, UnicodeText)
     std::string decryptedStr(decrypted.begin(), decrypted.end());
     EXPECT_EQ(decryptedStr, unicodeText);
 }
+
+// Test suite for the keyed packet API (deriveMasterKey / deriveSubkey /
+// encryptWithKey / decryptWithKey) used by the vault key hierarchy.
+class KeyedCryptoTest : public ::testing::Test
+{
+protected:
+    std::vector<unsigned char> salt = std::vector<unsigned char>(seal::cfg::SALT_LEN, 0x5A);
+};
+
+TEST_F(KeyedCryptoTest, MasterKeyIsDeterministicPerSalt)
+{
+    auto password = make_secure_string("test_password");
+
+    auto key1 = seal::Cryptography::deriveMasterKey(password, salt);
+    auto key2 = seal::Cryptography::deriveMasterKey(password, salt);
+    EXPECT_EQ(key1.size(), seal::cfg::KEY_LEN);
+    EXPECT_TRUE(std::equal(key1.begin(), key1.end(), key2.begin(), key2.end()));
+
+    std::vector<unsigned char> otherSalt(seal::cfg::SALT_LEN, 0xA5);
+    auto key3 = seal::Cryptography::deriveMasterKey(password, otherSalt);
+    EXPECT_FALSE(std::equal(key1.begin(), key1.end(), key3.begin(), key3.end()));
+}
+
+TEST_F(KeyedCryptoTest, ShortSaltThrows)
+{
+    auto password = make_secure_string("test_password");
+    std::vector<unsigned char> shortSalt(4, 0x01);
+
+    EXPECT_THROW((void)seal::Cryptography::deriveMasterKey(password, shortSalt),
+                 std::runtime_error);
+}
+
+TEST_F(KeyedCryptoTest, SubkeysAreDomainSeparated)
+{
+    std::vector<unsigned char> master(seal::cfg::KEY_LEN, 0x11);
+
+    auto a = seal::Cryptography::deriveSubkey(master, "seal/test/a");
+    auto a2 = seal::Cryptography::deriveSubkey(master, "seal/test/a");
+    auto b = seal::Cryptography::deriveSubkey(master, "seal/test/b");
+
+    EXPECT_EQ(a.size(), seal::cfg::KEY_LEN);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), a2.begin(), a2.end()));
+    EXPECT_FALSE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+}
+
+TEST_F(KeyedCryptoTest, KeyedRoundtrip)
+{
+    std::vector<unsigned char> key(seal::cfg::KEY_LEN, 0x42);
+    std::string plaintext = "platform name";
+    std::vector<unsigned char> plainBytes(plaintext.begin(), plaintext.end());
+
+    auto packet = seal::Cryptography::encryptWithKey(plainBytes, key);
+    EXPECT_EQ(packet.size(),
+              seal::cfg::AAD_LEN + seal::cfg::IV_LEN + plainBytes.size() + seal::cfg::TAG_LEN);
+
+    auto decrypted = seal::Cryptography::decryptWithKey(packet, key);
+    EXPECT_EQ(decrypted, plainBytes);
+
+    // Fresh IV per packet.
+    EXPECT_NE(packet, seal::Cryptography::encryptWithKey(plainBytes, key));
+}
+
+TEST_F(KeyedCryptoTest, KeyedEmptyPlaintext)
+{
+    std::vector<unsigned char> key(seal::cfg::KEY_LEN, 0x42);
+    std::vector<unsigned char> empty;
+
+    auto packet = seal::Cryptography::encryptWithKey(empty, key);
+    EXPECT_TRUE(seal::Cryptography::decryptWithKey(packet, key).empty());
+}
+
+TEST_F(KeyedCryptoTest, KeyedWrongKeyOrTamperFails)
+{
+    std::vector<unsigned char> key(seal::cfg::KEY_LEN, 0x42);
+    std::vector<unsigned char> wrongKey(seal::cfg::KEY_LEN, 0x43);
+    std::vector<unsigned char> plainBytes = {0x00, 0xFF, 0x80, 0x7F};
+
+    auto packet = seal::Cryptography::encryptWithKey(plainBytes, key);
+    EXPECT_THROW((void)seal::Cryptography::decryptWithKey(packet, wrongKey), std::runtime_error);
+
+    auto corrupted = packet;
+    corrupted[corrupted.size() / 2] ^= 0xFF;
+    EXPECT_THROW((void)seal::Cryptography::decryptWithKey(corrupted, key), std::runtime_error);
+
+    std::vector<unsigned char> truncated(packet.begin(), packet.begin() + 10);
+    EXPECT_THROW((void)seal::Cryptography::decryptWithKey(truncated, key), std::runtime_error);
+}
+
+TEST_F(KeyedCryptoTest, InvalidKeyLengthThrows)
+{
+    std::vector<unsigned char> shortKey(16, 0x42);
+    std::vector<unsigned char> plainBytes = {0x01};
+
+    EXPECT_THROW((void)seal::Cryptography::encryptWithKey(plainBytes, shortKey),
+                 std::runtime_error);
+}
+
+TEST_F(KeyedCryptoTest, IntoBuffersRoundtrip)
+{
+    std::vector<unsigned char> key(seal::cfg::KEY_LEN, 0x42);
+    std::vector<unsigned char> plainBytes = {'p', 'l', 'a', 't'};
+
+    std::vector<unsigned char> packet(seal::Cryptography::keyedPacketSize(plainBytes.size()));
+    EXPECT_EQ(seal::Cryptography::encryptWithKeyInto(plainBytes, key, packet), packet.size());
+    EXPECT_EQ(seal::Cryptography::decryptWithKey(packet, key), plainBytes);
+
+    // Decrypt into locked memory; a failed tag leaves it wiped.
+    seal::Cryptography::LockedKeyBuffer plain(plainBytes.size());
+    EXPECT_EQ(seal::Cryptography::decryptWithKeyInto(packet, key, plain), plainBytes.size());
+    EXPECT_TRUE(std::equal(plain.begin(), plain.end(), plainBytes.begin(), plainBytes.end()));
+
+    packet.back() ^= 0x01;
+    EXPECT_THROW((void)seal::Cryptography::decryptWithKeyInto(packet, key, plain),
+                 std::runtime_error);
+    EXPECT_TRUE(std::all_of(plain.begin(), plain.end(), [](unsigned char c) { return c == 0; }));
+}
+
+TEST_F(KeyedCryptoTest, IntoBuffersRejectShortOutput)
+{
+    std::vector<unsigned char> key(seal::cfg::KEY_LEN, 0x42);
+    std::vector<unsigned char> plainBytes(10, 0x33);
+
+    std::vector<unsigned char> small(seal::Cryptography::keyedPacketSize(plainBytes.size()) - 1);
+    EXPECT_THROW((void)seal::Cryptography::encryptWithKeyInto(plainBytes, key, small),
+                 std::runtime_error);
+
+    auto packet = seal::Cryptography::encryptWithKey(plainBytes, key);
+    std::vector<unsigned char> shortPlain(plainBytes.size() - 1);
+    EXPECT_THROW((void)seal::Cryptography::decryptWithKeyInto(packet, key, shortPlain),
+                 std::runtime_error);
+}
+
+TEST_F(CryptoTest, PacketIntoMatchesPacketSize)
+{
+    auto password = make_secure_string("test_password");
+    std::vector<unsigned char> plainBytes = {'s', 'e', 'c', 'r', 'e', 't'};
+
+    // Extra room at the end must be left alone.
+    std::vector<unsigned char> buf(seal::Cryptography::packetSize(plainBytes.size()) + 8, 0xEE);
+    const size_t n = seal::Cryptography::encryptPacketInto(plainBytes, password, buf);
+    EXPECT_EQ(n, seal::Cryptography::packetSize(plainBytes.size()));
+    EXPECT_TRUE(std::all_of(buf.begin() + n, buf.end(), [](unsigned char c) { return c == 0xEE; }));
+
+    std::span<const unsigned char> packet(buf.data(), n);
+    EXPECT_EQ(seal::Cryptography::decryptPacket(packet, password), plainBytes);
+
+    seal::Cryptography::LockedKeyBuffer plain(plainBytes.size());
+    EXPECT_EQ(seal::Cryptography::decryptPacketInto(packet, password, plain), plainBytes.size());
+    EXPECT_TRUE(std::equal(plain.begin(), plain.end(), plainBytes.begin(), plainBytes.end()));
+}
+
+TEST_F(CryptoTest, EncryptBatchItemsDecryptIndependently)
+{
+    auto password = make_secure_string("test_password");
+    std::vector<std::vector<unsigned char>> items = {
+        {},
+        {'a', 'b', 'c'},
+        std::vector<unsigned char>(seal::cfg::SEGMENT_LEN + 7, 0x5C),
+        {'a', 'b', 'c'},
+    };
+    std::vector<std::span<const unsigned char>> views(items.begin(), items.end());
+
+    auto packets = seal::Cryptography::encryptBatch(views, password);
+    ASSERT_EQ(packets.size(), items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        EXPECT_TRUE(seal::Cryptography::isKeyedSegmentPacket(packets[i])) << i;
+        EXPECT_EQ(seal::Cryptography::decryptPacket(packets[i], password), items[i]) << i;
+    }
+
+    // Same plaintext, same batch: still distinct packets.
+    EXPECT_NE(packets[1], packets[3]);
+    EXPECT_EQ(packets[1].size(), seal::Cryptography::packetSize(3) + 12);
+
+    auto wrong = make_secure_string("wrong_password");
+    EXPECT_THROW((void)seal::Cryptography::decryptPacket(packets[1], wrong), std::runtime_error);
+}
+
+TEST(CachedCipherCtxTest, ThreadContextIsReusedAndNestingWorks)
+{
+    EVP_CIPHER_CTX* first = nullptr;
+    {
+        seal::CachedCipherCtx a;
+        first = a.p;
+        seal::CachedCipherCtx nested;
+        EXPECT_NE(nested.p, a.p);
+    }
+    seal::CachedCipherCtx again;
+    EXPECT_EQ(again.p, first);
+    EXPECT_EQ(EVP_CIPHER_CTX_get0_cipher(again.p), nullptr);  // reset on release
+
+    // A packet sealed while the thread's context is leased still round-trips.
+    std::vector<unsigned char> key(seal::cfg::KEY_LEN, 0x42);
+    std::vector<unsigned char> plainBytes = {1, 2, 3};
+    auto packet = seal::Cryptography::encryptWithKey(plainBytes, key);
+    EXPECT_EQ(seal::Cryptography::decryptWithKey(packet, key), plainBytes);
+}
+
+// ============================================================================
+// Locked Pool Tests
+// ============================================================================
+
+// Larger than any slab slot, so these allocations are page-backed.
+constexpr size_t kPageBacked = 4096;
+
+TEST(LockedPoolTest, FreedBufferIsReusedWiped)
+{
+    const unsigned char* first = nullptr;
+    {
+        seal::Cryptography::LockedKeyBuffer buf(kPageBacked, 0xAB);
+        first = buf.data();
+    }
+    EXPECT_GE(seal::locked_pool::parked(), 1u);
+
+    // Same size on the same thread: the parked region comes back, wiped.
+    // reserve() only allocates, so the bytes seen are what the pool left.
+    seal::Cryptography::LockedKeyBuffer again;
+    again.reserve(kPageBacked);
+    const unsigned char* raw = again.data();
+    EXPECT_EQ(raw, first);
+    EXPECT_TRUE(std::all_of(raw, raw + kPageBacked, [](unsigned char b) { return b == 0; }));
+}
+
+TEST(LockedPoolTest, PoolIsBounded)
+{
+    std::vector<seal::Cryptography::LockedKeyBuffer> bufs;
+    for (size_t i = 0; i < seal::cfg::LOCKED_POOL_MAX_REGIONS * 2; ++i)
+        bufs.emplace_back(kPageBacked, static_cast<unsigned char>(i));
+    bufs.clear();
+
+    EXPECT_LE(seal::locked_pool::parked(), seal::cfg::LOCKED_POOL_MAX_REGIONS);
+}
+
+// ============================================================================
+// Locked Slab Tests
+// ============================================================================
+
+TEST(LockedSlabTest, SmallSecretsShareAnArena)
+{
+    if constexpr (!seal::cfg::LOCKED_SLAB)
+        GTEST_SKIP() << "built with ENABLE_LOCKED_SLAB=OFF";
+
+    seal::basic_secure_string<wchar_t> a = seal::utils::utf8ToSecureWide("alice@example");
+    seal::basic_secure_string<wchar_t> b = seal::utils::utf8ToSecureWide("bob@example");
+    ASSERT_TRUE(seal::locked_slab::owns(a.data()));
+    ASSERT_TRUE(seal::locked_slab::owns(b.data()));
+
+    auto pa = reinterpret_cast<uintptr_t>(a.data());
+    auto pb = reinterpret_cast<uintptr_t>(b.data());
+    EXPECT_LT((pa > pb ? pa - pb : pb - pa), seal::cfg::LOCKED_SLAB_ARENA);
+    EXPECT_EQ(pa % 16, 0u);
+}
+
+TEST(LockedSlabTest, LargeAllocationsStayPageBacked)
+{
+    seal::Cryptography::LockedKeyBuffer big(kPageBacked);
+    EXPECT_FALSE(seal::locked_slab::owns(big.data()));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(big.data()) % seal::cachedPageSize(), 0u);
+}
+
+TEST(LockedSlabTest, FreedSlotIsReusedWiped)
+{
+    if constexpr (!seal::cfg::LOCKED_SLAB)
+        GTEST_SKIP() << "built with ENABLE_LOCKED_SLAB=OFF";
+
+    const unsigned char* first = nullptr;
+    {
+        seal::Cryptography::LockedKeyBuffer key(seal::cfg::KEY_LEN, 0xAB);
+        first = key.data();
+    }
+    seal::Cryptography::LockedKeyBuffer again;
+    again.reserve(seal::cfg::KEY_LEN);
+    const unsigned char* raw = again.data();
+    EXPECT_EQ(raw, first);
+    EXPECT_TRUE(
+        std::all_of(raw, raw + seal::cfg::KEY_LEN, [](unsigned char b) { return b == 0; }));
+}
+
+TEST(LockedSlabTest, CleanseAndProtectWorkOnSlabStrings)
+{
+    seal::basic_secure_string<wchar_t> s = seal::utils::utf8ToSecureWide("hunter2");
+    seal::protect_noaccess(s.data());  // a no-op for slab slots
+    seal::protect_readwrite(s.data());
+    EXPECT_EQ(s.s[0], L'h');
+    seal::Cryptography::cleanseString(s);
+    EXPECT_TRUE(s.empty());
+}
+
+TEST(LockedSlabTest, EmptyArenasAreReleased)
+{
+    if constexpr (!seal::cfg::LOCKED_SLAB)
+        GTEST_SKIP() << "built with ENABLE_LOCKED_SLAB=OFF";
+
+    const size_t before = seal::locked_slab::arenas();
+    {
+        // Enough 64-byte slots to need several arenas of that class.
+        std::vector<seal::Cryptography::LockedKeyBuffer> keys;
+        const size_t perArena = seal::cfg::LOCKED_SLAB_ARENA / seal::cfg::LOCKED_SLAB_MIN_SLOT;
+        for (size_t i = 0; i < perArena * 3; ++i)
+            keys.emplace_back(8, static_cast<unsigned char>(i));
+        EXPECT_GE(seal::locked_slab::arenas(), before + 2);
+    }
+    // Only the last arena of a class is kept once it empties.
+    EXPECT_LE(seal::locked_slab::arenas(), before + 1);
+}
+
+// ============================================================================
+// Page Protection Tests
+// ============================================================================
+
+namespace
+{
+
+// Long enough to be page-backed rather than a slab slot.
+seal::basic_secure_string<wchar_t> pageBackedSecret(char c)
+{
+    return seal::utils::utf8ToSecureWide(std::string(kPageBacked, c));
+}
+
+uint32_t openScopes(const seal::basic_secure_string<wchar_t>& s)
+{
+    return seal::header_from_payload(s.data())->rwScopes;
+}
+
+}  // namespace
+
+TEST(PageProtectionTest, NestedGuardsShareOneScope)
+{
+    auto s = pageBackedSecret('x');
+    ASSERT_FALSE(seal::locked_slab::owns(s.data()));
+    seal::protect_noaccess(s.data());
+    ASSERT_TRUE(seal::is_noaccess(s.data()));
+    {
+        seal::RWGuard<wchar_t> outer(s.data());
+        {
+            seal::RWGuard<wchar_t> inner(s.data());
+            EXPECT_EQ(openScopes(s), 2u);
+            EXPECT_EQ(s.s[0], L'x');
+        }
+        // The inner guard closing must not re-protect under the outer one.
+        EXPECT_EQ(s.s[1], L'x');
+        EXPECT_EQ(openScopes(s), 1u);
+    }
+    EXPECT_EQ(openScopes(s), 0u);
+    EXPECT_TRUE(seal::is_noaccess(s.data()));
+
+    // Redundant requests are absorbed by the header's state.
+    seal::protect_noaccess(s.data());
+    seal::protect_readwrite(s.data());
+    seal::protect_readwrite(s.data());
+    EXPECT_FALSE(seal::is_noaccess(s.data()));
+    EXPECT_EQ(s.s.back(), L'x');
+}
+
+TEST(PageProtectionTest, RestingStateChangedInsideAScopeAppliesOnClose)
+{
+    auto s = pageBackedSecret('y');
+    {
+        seal::RWGuard<wchar_t> rw(s.data());
+        seal::protect_noaccess(s.data());  // deferred: the scope is still open
+        EXPECT_EQ(s.s[0], L'y');
+    }
+    EXPECT_TRUE(seal::is_noaccess(s.data()));
+    seal::protect_readwrite(s.data());
+    EXPECT_EQ(s.s[0], L'y');
+}
+
+TEST(PageProtectionTest, GuardsFromManyThreadsKeepTheCount)
+{
+    // deriveKey() opens scopes on the shared master password from every
+    // worker at once; no reader may see the payload re-protected under it.
+    auto s = pageBackedSecret('z');
+    seal::protect_noaccess(s.data());
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 8; ++t)
+        readers.emplace_back(
+            [&s, &mismatches]
+            {
+                for (int i = 0; i < 2000; ++i)
+                {
+                    seal::RWGuard<wchar_t> rw(s.data());
+                    if (s.s[static_cast<size_t>(i) % s.s.size()] != L'z')
+                        ++mismatches;
+                }
+            });
+    for (auto& t : readers)
+        t.join();
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_EQ(openScopes(s), 0u);
+    EXPECT_TRUE(seal::is_noaccess(s.data()));
+    seal::protect_readwrite(s.data());
+}
+
+TEST(PageProtectionTest, GuardSetOpensEachAllocationOnce)
+{
+    auto a = pageBackedSecret('a');
+    auto b = pageBackedSecret('b');
+    seal::basic_secure_string<wchar_t> small = seal::utils::utf8ToSecureWide("tiny");
+    seal::basic_secure_string<wchar_t> empty;
+    seal::protect_noaccess(a.data());
+    seal::protect_noaccess(b.data());
+    {
+        seal::RWGuardSet set;
+        set.add(a);
+        set.add(b);
+        set.add(a);
+        set.add(empty);
+        if (seal::locked_slab::owns(small.data()))
+        {
+            set.add(small);
+            EXPECT_EQ(set.size(), 2u);
+        }
+        EXPECT_EQ(openScopes(a), 1u);
+        EXPECT_EQ(a.s[0], L'a');
+        EXPECT_EQ(b.s[0], L'b');
+
+        set.close();
+        EXPECT_EQ(set.size(), 0u);
+        EXPECT_EQ(openScopes(a), 0u);
+        EXPECT_TRUE(seal::is_noaccess(a.data()));
+        EXPECT_TRUE(seal::is_noaccess(b.data()));
+    }  // the destructor's close() is then a no-op
+
+    // Cleansing and freeing a NOACCESS string opens it just long enough.
+    seal::Cryptography::cleanseString(a);
+    EXPECT_TRUE(a.empty());
+    seal::protect_readwrite(b.data());
+    EXPECT_EQ(b.s[0], L'b');
+}
+
+TEST(KdfParamsTest, EncodingAndSpecRoundtrip)
+{
+    const auto legacy = seal::KdfParams::legacy();
+    EXPECT_TRUE(legacy.valid());
+    EXPECT_EQ(legacy.str(), "scrypt:ln=16,r=8,p=1");
+    EXPECT_EQ(seal::KdfParams::decode(legacy.encode()), legacy);
+
+    auto argon = seal::KdfParams::parse("argon2id:m=256,t=2,p=4");
+    ASSERT_TRUE(argon.has_value());
+    EXPECT_EQ(argon->memoryBytes(), 256u << 20);
+    EXPECT_EQ(seal::KdfParams::parse(argon->str()), argon);
+    EXPECT_EQ(seal::KdfParams::decode(argon->encode()), argon);
+
+    EXPECT_FALSE(seal::KdfParams::parse("scrypt:ln=4").has_value());       // too cheap
+    EXPECT_FALSE(seal::KdfParams::parse("scrypt:ln=40").has_value());      // too big
+    EXPECT_FALSE(seal::KdfParams::parse("argon2id:m=100").has_value());    // not a power of 2
+    EXPECT_FALSE(seal::KdfParams::parse("bcrypt:cost=12").has_value());
+    EXPECT_FALSE(seal::KdfParams::parse("scrypt:ln").has_value());
+    const unsigned char unknown[] = {9, 16, 8, 1};
+    EXPECT_FALSE(seal::KdfParams::decode(unknown).has_value());
+}
+
+// Restores the process default so later tests see the legacy format.
+class KdfParamsPacketTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        seal::Cryptography::setKdfParams(*seal::KdfParams::parse("scrypt:ln=12,r=8,p=1"));
+    }
+    void TearDown() override { seal::Cryptography::setKdfParams(seal::KdfParams::legacy()); }
+};
+
+TEST_F(KdfParamsPacketTest, PacketCarriesItsParameters)
+{
+    auto password = make_secure_string("test_password");
+    std::vector<unsigned char> plainBytes = {'s', 'e', 'c', 'r', 'e', 't'};
+
+    auto packet = seal::Cryptography::encryptPacket(plainBytes, password);
+    ASSERT_GE(packet.size(), 4u);
+    EXPECT_TRUE(std::equal(packet.begin(), packet.begin() + 4, "slp2"));
+    EXPECT_EQ(packet.size(), seal::Cryptography::packetSize(plainBytes.size()));
+    EXPECT_EQ(seal::Cryptography::packetKdf(packet), seal::Cryptography::kdfParams());
+
+    // Readers follow the stored parameters, not the process default.
+    seal::Cryptography::setKdfParams(seal::KdfParams::legacy());
+    EXPECT_EQ(seal::Cryptography::decryptPacket(packet, password), plainBytes);
+    EXPECT_NO_THROW(seal::Cryptography::verifyPacket(packet, password));
+
+    // The parameters are authenticated: changing them breaks the tag.
+    packet[5] ^= 1;
+    EXPECT_THROW((void)seal::Cryptography::decryptPacket(packet, password), std::runtime_error);
+}
+
+TEST_F(KdfParamsPacketTest, ExplicitParametersIgnoreTheDefault)
+{
+    static_assert(seal::Cryptography::packetSize(6, seal::KdfParams::legacy()) ==
+                  seal::cfg::AAD_LEN + seal::cfg::SALT_LEN + seal::cfg::IV_LEN + 6 +
+                      seal::cfg::TAG_LEN);
+
+    auto password = make_secure_string("test_password");
+    std::vector<unsigned char> plainBytes = {'s', 'e', 'c', 'r', 'e', 't'};
+
+    // Sized and sealed with the legacy snapshot while the default is not.
+    const auto legacy = seal::KdfParams::legacy();
+    std::vector<unsigned char> buf(seal::Cryptography::packetSize(plainBytes.size(), legacy));
+    EXPECT_EQ(seal::Cryptography::encryptPacketInto(plainBytes, password, legacy, buf),
+              buf.size());
+    EXPECT_EQ(seal::Cryptography::packetKdf(buf), legacy);
+    EXPECT_EQ(seal::Cryptography::decryptPacket(buf, password), plainBytes);
+}
+
+TEST_F(KdfParamsPacketTest, BatchSegmentsCarryTheirParameters)
+{
+    auto password = make_secure_string("test_password");
+    std::vector<unsigned char> item = {'a', 'b', 'c'};
+    std::vector<std::span<const unsigned char>> views = {item, item};
+
+    auto packets = seal::Cryptography::encryptBatch(views, password);
+    ASSERT_EQ(packets.size(), 2u);
+    for (const auto& packet : packets)
+    {
+        EXPECT_TRUE(seal::Cryptography::isKeyedSegmentPacket(packet));
+        EXPECT_EQ(seal::Cryptography::segmentKdf(packet), seal::Cryptography::kdfParams());
+        EXPECT_EQ(seal::Cryptography::decryptPacket(packet, password), item);
+    }
+}
+
+TEST(KdfParamsTest, InvalidParametersAreRejected)
+{
+    seal::KdfParams bad;
+    bad.lanes = 0;
+    EXPECT_THROW(seal::Cryptography::setKdfParams(bad), std::invalid_argument);
+    EXPECT_TRUE(seal::Cryptography::kdfParams().isLegacy());
+}
+
+TEST(AeadTest, SegmentHeaderRecordsItsCipher)
+{
+    const std::vector<unsigned char> salt(seal::cfg::SALT_LEN, 0x11);
+    const std::vector<unsigned char> key(seal::cfg::KEY_LEN, 0x42);
+    const std::vector<unsigned char> plain = {'s', 'e', 'g', 'm', 'e', 'n', 't'};
+
+    auto gcm = seal::Cryptography::makeSegmentHeader(salt);
+    EXPECT_EQ(seal::Cryptography::segmentAead(gcm), seal::AeadAlgorithm::Aes256Gcm);
+
+    auto header = seal::Cryptography::makeSegmentHeader(
+        salt, false, seal::KdfParams::legacy(), true, seal::AeadAlgorithm::ChaCha20Poly1305);
+    EXPECT_EQ(seal::Cryptography::segmentAead(header), seal::AeadAlgorithm::ChaCha20Poly1305);
+    EXPECT_EQ(seal::Cryptography::segmentSize(header), seal::cfg::SEGMENT_LEN);
+    EXPECT_TRUE(seal::Cryptography::isCompressedSegmentPacket(header));
+
+    std::vector<unsigned char> sealed(plain.size() + seal::cfg::TAG_LEN);
+    seal::Cryptography::sealSegment(key, header, 0, true, plain, sealed.data());
+    std::vector<unsigned char> out(plain.size());
+    EXPECT_TRUE(seal::Cryptography::openSegment(key, header, 0, true, sealed, out.data()));
+    EXPECT_EQ(out, plain);
+
+    // Relabelling the cipher changes both the algorithm and the AAD.
+    auto relabelled = header;
+    relabelled[seal::cfg::SEGMENT_HEADER_LEN - 1] &= ~seal::cfg::SEGMENT_AEAD_MASK;
+    EXPECT_FALSE(seal::Cryptography::openSegment(key, relabelled, 0, true, sealed, out.data()));
+
+    // IDs this build does not know are refused rather than guessed at.
+    auto unknown = header;
+    unknown[seal::cfg::SEGMENT_HEADER_LEN - 1] |= seal::cfg::SEGMENT_AEAD_MASK;
+    EXPECT_THROW((void)seal::Cryptography::segmentAead(unknown), std::runtime_error);
+    EXPECT_THROW((void)seal::Cryptography::openSegment(key, unknown, 0, true, sealed, out.data()),
+                 std::runtime_error);
+}
+
+TEST(AeadTest, BatchPacketsFollowTheProcessCipher)
+{
+    auto password = make_secure_string("test_password");
+    std::vector<unsigned char> item = {'a', 'b', 'c'};
+    std::vector<std::span<const unsigned char>> views = {item};
+
+    seal::Cryptography::setAead(seal::AeadAlgorithm::ChaCha20Poly1305);
+    auto packets = seal::Cryptography::encryptBatch(views, password);
+    seal::Cryptography::setAead(seal::Cryptography::preferredAead());
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(seal::Cryptography::segmentAead(packets[0]), seal::AeadAlgorithm::ChaCha20Poly1305);
+    EXPECT_EQ(seal::Cryptography::decryptPacket(packets[0], password), item);
+    EXPECT_NO_THROW(seal::Cryptography::verifyPacket(packets[0], password));
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_directory_sync.cpp
+ * @brief Tests for incremental directory sync and its encrypted manifest
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "test_helpers.h"
+
+#include "../src/DirectoryManifest.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+class DirectorySyncTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() / "seal_sync_tests";
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root / "src" / "sub");
+        m_Src = m_Root / "src";
+        m_Dst = m_Root / "dst";
+    }
+
+    void TearDown() override { fs::remove_all(m_Root); }
+
+    static void write(const fs::path& p, const std::string& content)
+    {
+        std::ofstream out(p, std::ios::binary | std::ios::trunc);
+        out << content;
+    }
+
+    static std::string read(const fs::path& p)
+    {
+        std::ifstream in(p, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    }
+
+    std::string decryptCopy(const std::string& rel)
+    {
+        fs::path sealed = m_Dst / (rel + ".seal");
+        fs::path plain = m_Root / "out.tmp";
+        if (!seal::FileOperations::decryptFileTo(sealed.string(), plain.string(), password))
+            return "<decrypt failed>";
+        std::string content = read(plain);
+        fs::remove(plain);
+        return content;
+    }
+
+    bool sync()
+    {
+        return seal::FileOperations::syncDirectory(m_Src.string(), m_Dst.string(), password);
+    }
+
+    seal::secure_string<> password = make_secure_string("test_password");
+    fs::path m_Root;
+    fs::path m_Src;
+    fs::path m_Dst;
+};
+
+TEST_F(DirectorySyncTest, FirstRunMirrorsTreeAndKeepsSource)
+{
+    write(m_Src / "a.txt", "alpha");
+    write(m_Src / "sub" / "b.txt", "bravo");
+
+    ASSERT_TRUE(sync());
+    EXPECT_EQ(read(m_Src / "a.txt"), "alpha");
+    EXPECT_EQ(decryptCopy("a.txt"), "alpha");
+    EXPECT_EQ(decryptCopy("sub/b.txt"), "bravo");
+    EXPECT_TRUE(fs::exists(m_Dst / ".seal-manifest"));
+}
+
+TEST_F(DirectorySyncTest, UnchangedFilesAreNotRewritten)
+{
+    write(m_Src / "a.txt", "alpha");
+    write(m_Src / "b.txt", "bravo");
+    ASSERT_TRUE(sync());
+    const auto aTime = fs::last_write_time(m_Dst / "a.txt.seal");
+
+    write(m_Src / "b.txt", "bravo, edited");
+    ASSERT_TRUE(sync());
+
+    EXPECT_EQ(fs::last_write_time(m_Dst / "a.txt.seal"), aTime);
+    EXPECT_EQ(decryptCopy("b.txt"), "bravo, edited");
+}
+
+TEST_F(DirectorySyncTest, TouchedButIdenticalFileKeepsItsCopy)
+{
+    write(m_Src / "a.txt", "alpha");
+    ASSERT_TRUE(sync());
+    const auto copyTime = fs::last_write_time(m_Dst / "a.txt.seal");
+
+    const auto later = fs::last_write_time(m_Src / "a.txt") + std::chrono::hours(1);
+    fs::last_write_time(m_Src / "a.txt", later);
+    ASSERT_TRUE(sync());
+
+    EXPECT_EQ(fs::last_write_time(m_Dst / "a.txt.seal"), copyTime);
+}
+
+TEST_F(DirectorySyncTest, DeletedSourceFilesArePruned)
+{
+    write(m_Src / "a.txt", "alpha");
+    write(m_Src / "sub" / "b.txt", "bravo");
+    ASSERT_TRUE(sync());
+
+    fs::remove(m_Src / "sub" / "b.txt");
+    ASSERT_TRUE(sync());
+
+    EXPECT_FALSE(fs::exists(m_Dst / "sub" / "b.txt.seal"));
+    EXPECT_TRUE(fs::exists(m_Dst / "a.txt.seal"));
+}
+
+TEST_F(DirectorySyncTest, MissingCopyIsRecreated)
+{
+    write(m_Src / "a.txt", "alpha");
+    ASSERT_TRUE(sync());
+
+    fs::remove(m_Dst / "a.txt.seal");
+    ASSERT_TRUE(sync());
+    EXPECT_EQ(decryptCopy("a.txt"), "alpha");
+}
+
+TEST_F(DirectorySyncTest, WrongPasswordLeavesMirrorAlone)
+{
+    write(m_Src / "a.txt", "alpha");
+    ASSERT_TRUE(sync());
+    write(m_Src / "a.txt", "alpha, edited");
+
+    auto wrong = make_secure_string("wrong_password");
+    EXPECT_FALSE(seal::FileOperations::syncDirectory(m_Src.string(), m_Dst.string(), wrong));
+    EXPECT_EQ(decryptCopy("a.txt"), "alpha");
+}
+
+TEST_F(DirectorySyncTest, DestinationInsideSourceIsRejected)
+{
+    write(m_Src / "a.txt", "alpha");
+    EXPECT_FALSE(seal::FileOperations::syncDirectory(
+        m_Src.string(), (m_Src / "mirror").string(), password));
+    EXPECT_FALSE(fs::exists(m_Src / "mirror"));
+}
+
+TEST_F(DirectorySyncTest, ManifestRoundtripsThroughSave)
+{
+    fs::create_directories(m_Dst);
+    const std::string path = (m_Dst / "manifest").string();
+    {
+        seal::DirectoryManifest manifest;
+        manifest.open(path, password);
+        EXPECT_EQ(manifest.size(), 0u);
+        manifest.record("sub/b.txt", {5, 42, "ab12"});
+        manifest.record("a b.txt", {0, 7, "cd34"});
+        ASSERT_TRUE(manifest.save());
+    }
+
+    seal::DirectoryManifest reopened;
+    reopened.open(path, password);
+    ASSERT_EQ(reopened.size(), 2u);
+    auto entry = reopened.find("sub/b.txt");
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(*entry, (seal::DirectoryManifest::Entry{5, 42, "ab12"}));
+    EXPECT_FALSE(reopened.find("missing").has_value());
+
+    seal::DirectoryManifest wrong;
+    auto wrongPassword = make_secure_string("wrong_password");
+    EXPECT_THROW(wrong.open(path, wrongPassword), std::runtime_error);
+}
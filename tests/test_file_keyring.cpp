@@ -0,0 +1,91 @@
+/**
+ * @file test_file_keyring.cpp
+ * @brief Unit tests for batch key derivation of keyed segmented files
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "test_helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+class FileKeyringTest : public ::testing::Test
+{
+protected:
+    seal::secure_string<> password = make_secure_string("test_password");
+    seal::FileKeyring keyring;
+};
+
+TEST_F(FileKeyringTest, EachKeyringDrawsItsOwnSalt)
+{
+    seal::FileKeyring other;
+    ASSERT_EQ(keyring.salt().size(), seal::cfg::SALT_LEN);
+    EXPECT_FALSE(std::equal(keyring.salt().begin(), keyring.salt().end(), other.salt().begin()));
+}
+
+TEST_F(FileKeyringTest, KeyedHeaderCarriesSaltAndFileNonce)
+{
+    auto header = seal::Cryptography::makeSegmentHeader(keyring.salt(), true);
+    ASSERT_EQ(header.size(), seal::cfg::SEGMENT_KEYED_HEADER_LEN);
+    EXPECT_TRUE(seal::Cryptography::isSegmentedPacket(header));
+    EXPECT_TRUE(seal::Cryptography::isKeyedSegmentPacket(header));
+    EXPECT_EQ(seal::Cryptography::segmentHeaderSize(header), header.size());
+    EXPECT_EQ(seal::Cryptography::segmentSize(header), seal::cfg::SEGMENT_LEN);
+    EXPECT_TRUE(std::equal(keyring.salt().begin(),
+                           keyring.salt().end(),
+                           header.begin() + seal::cfg::SEGMENT_HDR_LEN));
+}
+
+// The cached path must produce exactly what a reader without the keyring
+// derives from the header alone.
+TEST_F(FileKeyringTest, FileKeyMatchesIndependentDerivation)
+{
+    auto header = seal::Cryptography::makeSegmentHeader(keyring.salt(), true);
+    auto key = keyring.fileKey(password, header);
+
+    auto master = seal::Cryptography::deriveMasterKey(password, keyring.salt());
+    auto expected = seal::Cryptography::segmentFileKey(master, header);
+    EXPECT_TRUE(seal::Cryptography::ctEqualAny(key, expected));
+    EXPECT_EQ(keyring.size(), 1u);
+}
+
+TEST_F(FileKeyringTest, FilesOfOneBatchGetDistinctKeysFromOneMasterKey)
+{
+    auto first = seal::Cryptography::makeSegmentHeader(keyring.salt(), true);
+    auto second = seal::Cryptography::makeSegmentHeader(keyring.salt(), true);
+    auto a = keyring.fileKey(password, first);
+    auto b = keyring.fileKey(password, second);
+    EXPECT_FALSE(seal::Cryptography::ctEqualAny(a, b));
+    EXPECT_EQ(keyring.size(), 1u);
+}
+
+TEST_F(FileKeyringTest, PlainHeaderUsesPerFileScryptUncached)
+{
+    std::vector<unsigned char> salt(seal::cfg::SALT_LEN, 0x5A);
+    auto header = seal::Cryptography::makeSegmentHeader(salt);
+    auto key = keyring.fileKey(password, header);
+    auto expected = seal::Cryptography::deriveMasterKey(password, salt);
+    EXPECT_TRUE(seal::Cryptography::ctEqualAny(key, expected));
+    EXPECT_EQ(keyring.size(), 0u);
+}
+
+TEST_F(FileKeyringTest, SegmentFileKeyRejectsPlainHeader)
+{
+    auto header = seal::Cryptography::makeSegmentHeader(keyring.salt());
+    auto master = seal::Cryptography::deriveMasterKey(password, keyring.salt());
+    EXPECT_THROW((void)seal::Cryptography::segmentFileKey(master, header), std::runtime_error);
+}
+
+TEST_F(FileKeyringTest, ClearDropsCachedKeys)
+{
+    auto header = seal::Cryptography::makeSegmentHeader(keyring.salt(), true);
+    (void)keyring.fileKey(password, header);
+    ASSERT_EQ(keyring.size(), 1u);
+    keyring.clear();
+    EXPECT_EQ(keyring.size(), 0u);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_file_watcher.cpp
+ * @brief Tests for the debounced vault file watcher
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "../src/FileWatcher.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+class FileWatcherTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() / "seal_watch_tests";
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root);
+        m_Vault = m_Root / "accounts.seal";
+        write(m_Vault, "base");
+    }
+
+    void TearDown() override { fs::remove_all(m_Root); }
+
+    static void write(const fs::path& p, const std::string& content)
+    {
+        std::ofstream out(p, std::ios::binary | std::ios::trunc);
+        out << content;
+    }
+
+    // Poll until @p count reaches @p want or the timeout passes.
+    static bool waitFor(const std::atomic<int>& count, int want)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (count.load() < want && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return count.load() >= want;
+    }
+
+    fs::path m_Root;
+    fs::path m_Vault;
+};
+
+TEST_F(FileWatcherTest, ReportsAWriteToTheFile)
+{
+    std::atomic<int> changes{0};
+    seal::FileWatcher watcher(
+        m_Vault.string(), [&] { ++changes; }, std::chrono::milliseconds(50));
+    write(m_Vault, "changed");
+    EXPECT_TRUE(waitFor(changes, 1));
+}
+
+TEST_F(FileWatcherTest, ReportsAReplaceByRename)
+{
+    std::atomic<int> changes{0};
+    seal::FileWatcher watcher(
+        m_Vault.string(), [&] { ++changes; }, std::chrono::milliseconds(50));
+    const fs::path tmp = m_Root / "accounts.seal.tmp";
+    write(tmp, "replacement");
+    fs::rename(tmp, m_Vault);
+    EXPECT_TRUE(waitFor(changes, 1));
+}
+
+TEST_F(FileWatcherTest, CoalescesABurstIntoOneCallback)
+{
+    std::atomic<int> changes{0};
+    seal::FileWatcher watcher(
+        m_Vault.string(), [&] { ++changes; }, std::chrono::milliseconds(300));
+    for (int i = 0; i < 5; ++i)
+    {
+        write(m_Vault, "chunk " + std::to_string(i));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ASSERT_TRUE(waitFor(changes, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    EXPECT_EQ(changes.load(), 1);
+}
+
+TEST_F(FileWatcherTest, IgnoresOtherFilesInTheDirectory)
+{
+    std::atomic<int> changes{0};
+    seal::FileWatcher watcher(
+        m_Vault.string(), [&] { ++changes; }, std::chrono::milliseconds(50));
+    write(m_Root / "other.seal", "unrelated");
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_EQ(changes.load(), 0);
+}
+
+TEST_F(FileWatcherTest, NoCallbackAfterDestruction)
+{
+    std::atomic<int> changes{0};
+    {
+        seal::FileWatcher watcher(
+            m_Vault.string(), [&] { ++changes; }, std::chrono::seconds(10));
+        write(m_Vault, "pending");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    // The change was still waiting out its debounce; stopping drops it.
+    EXPECT_EQ(changes.load(), 0);
+}
+
+TEST_F(FileWatcherTest, ThrowsForAMissingDirectory)
+{
+    EXPECT_THROW(seal::FileWatcher((m_Root / "missing" / "a.seal").string(), [] {}),
+                 std::runtime_error);
+}
@@ -11,7 +11,9 @@
 #include "../src/Clipboard.h"
 #include "../src/Console.h"
 #include "../src/Cryptography.h"
+#include "../src/FileKeyring.h"
 #include "../src/FileOperations.h"
+#include "../src/SearchIndex.h"
 #include "../src/Utils.h"
 
 /**
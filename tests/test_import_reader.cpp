@@ -0,0 +1,138 @@
+/**
+ * @file test_import_reader.cpp
+ * @brief Tests for the incremental `seal import` parser
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "../src/ImportReader.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using seal::ImportReader;
+using Status = seal::ImportReader::Status;
+
+namespace
+{
+
+std::wstring wide(const seal::basic_secure_string<wchar_t>& s)
+{
+    return std::wstring(s.view());
+}
+
+}  // namespace
+
+TEST(ImportReaderTest, ParsesCommaAndLineSeparatedEntries)
+{
+    std::istringstream in("github:alice:pw1,\r\n  gitlab : bob : p w2  \n\n, ,mail:carol:x");
+    ImportReader reader(in);
+    seal::ImportEntry entry;
+
+    ASSERT_EQ(reader.next(entry), Status::Entry);
+    EXPECT_EQ(entry.platform, "github");
+    EXPECT_EQ(wide(entry.username), L"alice");
+    EXPECT_EQ(wide(entry.password), L"pw1");
+
+    ASSERT_EQ(reader.next(entry), Status::Entry);
+    EXPECT_EQ(entry.platform, "gitlab");
+    EXPECT_EQ(wide(entry.username), L"bob");
+    // Only the ends of the entry are trimmed; inner spaces of a password stay.
+    EXPECT_EQ(wide(entry.password), L" p w2");
+
+    ASSERT_EQ(reader.next(entry), Status::Entry);
+    EXPECT_EQ(entry.platform, "mail");
+    EXPECT_EQ(reader.entryIndex(), 3u);
+
+    EXPECT_EQ(reader.next(entry), Status::End);
+    EXPECT_EQ(reader.next(entry), Status::End);
+
+    entry.cleanse();
+    EXPECT_TRUE(entry.platform.empty());
+    EXPECT_TRUE(entry.username.empty());
+    EXPECT_TRUE(entry.password.empty());
+}
+
+TEST(ImportReaderTest, DecodesUtf8Fields)
+{
+    std::istringstream in("caf\xC3\xA9:j\xC3\xBCrgen:\xE2\x82\xAC" "5");
+    ImportReader reader(in);
+    seal::ImportEntry entry;
+    ASSERT_EQ(reader.next(entry), Status::Entry);
+    EXPECT_EQ(entry.platform, "caf\xC3\xA9");
+    EXPECT_EQ(wide(entry.username), L"j\u00FCrgen");
+    EXPECT_EQ(wide(entry.password), L"\u20AC5");
+}
+
+TEST(ImportReaderTest, RejectsMalformedEntries)
+{
+    struct Case
+    {
+        const char* text;
+        Status status;
+        const char* reason;
+    };
+    const std::vector<Case> cases = {
+        {"a:b:c,nocolon", Status::MissingFirstColon, "missing_first_colon"},
+        {"a:b:c,one:colon", Status::MissingSecondColon, "missing_second_colon"},
+        {"a:b:c,a:b:c:d", Status::TooManyColons, "too_many_colons"},
+        {"a:b:c, :b:c", Status::EmptyField, "empty_field"},
+        {"a:b:c,a: :c", Status::EmptyField, "empty_field"},
+        {"a:b:c,a:b: ", Status::EmptyField, "empty_field"},
+    };
+    for (const auto& c : cases)
+    {
+        std::istringstream in(c.text);
+        ImportReader reader(in);
+        seal::ImportEntry entry;
+        ASSERT_EQ(reader.next(entry), Status::Entry) << c.text;
+        EXPECT_EQ(reader.next(entry), c.status) << c.text;
+        EXPECT_EQ(reader.entryIndex(), 2u) << c.text;
+        EXPECT_EQ(ImportReader::reason(c.status), c.reason);
+        // A rejected entry leaves the previous one untouched.
+        EXPECT_EQ(entry.platform, "a") << c.text;
+    }
+}
+
+TEST(ImportReaderTest, EntriesSpanChunkBoundaries)
+{
+    // Enough entries that several straddle each refill of the chunk buffer.
+    std::string text;
+    const size_t count = 3 * ImportReader::kChunk / 32 + 7;
+    for (size_t i = 0; i < count; ++i)
+        text += "platform" + std::to_string(i) + ":user" + std::to_string(i) + ":secret\n";
+    ASSERT_GT(text.size(), 2 * ImportReader::kChunk);
+
+    std::istringstream in(text);
+    ImportReader reader(in);
+    seal::ImportEntry entry;
+    for (size_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(reader.next(entry), Status::Entry) << i;
+        ASSERT_EQ(entry.platform, "platform" + std::to_string(i));
+        ASSERT_EQ(wide(entry.username), L"user" + std::to_wstring(i));
+    }
+    EXPECT_EQ(reader.next(entry), Status::End);
+}
+
+TEST(ImportReaderTest, OverlongEntryIsRejected)
+{
+    std::string text = "a:b:c,x:y:" + std::string(ImportReader::kMaxEntry, 'z') + ",d:e:f";
+    std::istringstream in(text);
+    ImportReader reader(in);
+    seal::ImportEntry entry;
+    ASSERT_EQ(reader.next(entry), Status::Entry);
+    EXPECT_EQ(reader.next(entry), Status::TooLong);
+    EXPECT_EQ(reader.entryIndex(), 2u);
+    EXPECT_EQ(ImportReader::reason(Status::TooLong), "entry_too_long");
+
+    // The longest accepted entry is exactly kMaxEntry bytes.
+    std::string edge = "x:y:" + std::string(ImportReader::kMaxEntry - 4, 'z');
+    std::istringstream edgeIn(edge);
+    ImportReader edgeReader(edgeIn);
+    EXPECT_EQ(edgeReader.next(entry), Status::Entry);
+    EXPECT_EQ(entry.password.size(), ImportReader::kMaxEntry - 4);
+}
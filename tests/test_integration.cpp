@@ -8,11 +8,14 @@
 #include "test_helpers.h"
 
 #include <gtest/gtest.h>
+#include <openssl/evp.h>
 
 #include <filesystem>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace std::string_literals;
@@ -304,3 +307,686 @@ TEST_F(FileOperationsTest, DecryptCorruptedFileFails)
         seal::FileOperations::decryptFileTo(encFile.string(), decFile.string(), password);
     EXPECT_FALSE(decryptSuccess);
 }
+
+// Files above cfg::FILE_CHUNK are written in the segmented format and
+// decrypted in a single pass.
+TEST_F(FileOperationsTest, LargeFileUsesSegmentedFormat)
+{
+    auto tempFile = GetTestFile("test_segmented.tmp");
+    std::string originalContent(seal::cfg::SEGMENT_LEN * 2 + 12345, '\0');
+    for (size_t i = 0; i < originalContent.size(); ++i)
+        originalContent[i] = static_cast<char>(i * 31 + 7);
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << originalContent;
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_segmented.tmp.seal");
+    auto decFile = GetTestFile("test_segmented_dec.tmp");
+
+    ASSERT_TRUE(seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password));
+
+    std::ifstream in(encFile, std::ios::binary);
+    std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+    in.close();
+    EXPECT_TRUE(seal::Cryptography::isSegmentedPacket(blob));
+    EXPECT_EQ(blob.size(),
+              seal::cfg::SEGMENT_HEADER_LEN + originalContent.size() + 3 * seal::cfg::TAG_LEN);
+    EXPECT_NO_THROW(
+        seal::Cryptography::verifyPacket(std::span<const unsigned char>(blob), password));
+
+    auto plain = seal::Cryptography::decryptPacket(std::span<const unsigned char>(blob), password);
+    EXPECT_EQ(std::string(plain.begin(), plain.end()), originalContent);
+
+    ASSERT_TRUE(seal::FileOperations::decryptFileTo(encFile.string(), decFile.string(), password));
+    std::ifstream in2(decFile, std::ios::binary);
+    std::string decryptedContent((std::istreambuf_iterator<char>(in2)),
+                                 std::istreambuf_iterator<char>());
+    EXPECT_EQ(decryptedContent, originalContent);
+}
+
+// A source that ends exactly on a segment boundary: the read-ahead past
+// end of file must mark the previous segment as last, and the plaintext
+// (a whole number of sectors) must come back without padding.
+TEST_F(FileOperationsTest, SegmentedExactBoundaryRoundtrip)
+{
+    auto tempFile = GetTestFile("test_seg_exact.tmp");
+    std::string originalContent(seal::cfg::SEGMENT_LEN * 3, '\0');
+    for (size_t i = 0; i < originalContent.size(); ++i)
+        originalContent[i] = static_cast<char>(i * 13 + 5);
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << originalContent;
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_seg_exact.tmp.seal");
+    auto decFile = GetTestFile("test_seg_exact_dec.tmp");
+    ASSERT_TRUE(
+        seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password, 2));
+    EXPECT_EQ(std::filesystem::file_size(encFile),
+              seal::cfg::SEGMENT_HEADER_LEN + originalContent.size() + 3 * seal::cfg::TAG_LEN);
+
+    ASSERT_TRUE(
+        seal::FileOperations::decryptFileTo(encFile.string(), decFile.string(), password, 2));
+    std::ifstream in(decFile, std::ios::binary);
+    std::string decryptedContent((std::istreambuf_iterator<char>(in)),
+                                 std::istreambuf_iterator<char>());
+    EXPECT_EQ(decryptedContent, originalContent);
+}
+
+// Dropping whole trailing segments leaves a valid-looking file whose new
+// last segment was not sealed as final; it must be rejected.
+TEST_F(FileOperationsTest, SegmentedTruncationAtBoundaryFails)
+{
+    auto tempFile = GetTestFile("test_seg_trunc.tmp");
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << std::string(seal::cfg::SEGMENT_LEN * 3, 'x');
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_seg_trunc.tmp.seal");
+    auto decFile = GetTestFile("test_seg_trunc_dec.tmp");
+    ASSERT_TRUE(seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password));
+
+    std::filesystem::resize_file(
+        encFile, seal::cfg::SEGMENT_HEADER_LEN + 2 * (seal::cfg::SEGMENT_LEN + seal::cfg::TAG_LEN));
+
+    EXPECT_FALSE(seal::FileOperations::decryptFileTo(encFile.string(), decFile.string(), password));
+    EXPECT_FALSE(std::filesystem::exists(decFile));
+
+    std::ifstream in(encFile, std::ios::binary);
+    std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+    EXPECT_THROW(seal::Cryptography::verifyPacket(std::span<const unsigned char>(blob), password),
+                 std::runtime_error);
+}
+
+TEST_F(FileOperationsTest, SegmentedWrongPasswordFails)
+{
+    auto tempFile = GetTestFile("test_seg_pwd.tmp");
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << std::string(seal::cfg::SEGMENT_LEN + 1, 'y');
+    }
+
+    auto encFile = GetTestFile("test_seg_pwd.tmp.seal");
+    auto decFile = GetTestFile("test_seg_pwd_dec.tmp");
+    ASSERT_TRUE(seal::FileOperations::encryptFileTo(
+        tempFile.string(), encFile.string(), make_secure_string("correct_password")));
+
+    EXPECT_FALSE(seal::FileOperations::decryptFileTo(
+        encFile.string(), decFile.string(), make_secure_string("wrong_password")));
+    EXPECT_FALSE(std::filesystem::exists(decFile));
+}
+
+// Segments are sealed and opened on worker threads but must leave in order;
+// any thread count on either side yields the same plaintext.
+TEST_F(FileOperationsTest, SegmentedParallelRoundtrip)
+{
+    auto tempFile = GetTestFile("test_seg_parallel.tmp");
+    std::string originalContent(seal::cfg::SEGMENT_LEN * 9 + 777, '\0');
+    for (size_t i = 0; i < originalContent.size(); ++i)
+        originalContent[i] = static_cast<char>((i / seal::cfg::SEGMENT_LEN) * 17 + i);
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << originalContent;
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_seg_parallel.tmp.seal");
+    ASSERT_TRUE(
+        seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password, 4));
+
+    for (unsigned threads : {1u, 3u, 0u})
+    {
+        auto decFile = GetTestFile("test_seg_parallel_dec.tmp");
+        ASSERT_TRUE(seal::FileOperations::decryptFileTo(
+            encFile.string(), decFile.string(), password, threads));
+        std::ifstream in(decFile, std::ios::binary);
+        std::string decryptedContent((std::istreambuf_iterator<char>(in)),
+                                     std::istreambuf_iterator<char>());
+        EXPECT_EQ(decryptedContent, originalContent) << "threads=" << threads;
+    }
+}
+
+// With compression on, segments that shrink are stored compressed behind an
+// authenticated segment table and still decrypt in parallel; the in-memory
+// and streaming readers must agree.
+TEST_F(FileOperationsTest, CompressedSegmentsRoundtrip)
+{
+    auto tempFile = GetTestFile("test_seg_compressed.tmp");
+    std::string originalContent;
+    while (originalContent.size() < seal::cfg::SEGMENT_LEN * 3 + 4321)
+        originalContent += "2024-01-01 12:00:00 INFO request handled in " +
+                           std::to_string(originalContent.size() % 997) + " ms\n";
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << originalContent;
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_seg_compressed.tmp.seal");
+    seal::Cryptography::setSegmentCompression(true);
+    const bool encrypted =
+        seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password, 3);
+    seal::Cryptography::setSegmentCompression(false);
+    ASSERT_TRUE(encrypted);
+
+    std::ifstream in(encFile, std::ios::binary);
+    std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+    in.close();
+    EXPECT_TRUE(seal::Cryptography::isCompressedSegmentPacket(blob));
+    EXPECT_LT(blob.size(), originalContent.size() / 2);
+    EXPECT_NO_THROW(seal::FileOperations::verifyFile(encFile.string(), password));
+
+    auto plain = seal::Cryptography::decryptPacket(std::span<const unsigned char>(blob), password);
+    EXPECT_EQ(std::string(plain.begin(), plain.end()), originalContent);
+
+    for (unsigned threads : {1u, 4u})
+    {
+        auto decFile = GetTestFile("test_seg_compressed_dec.tmp");
+        ASSERT_TRUE(seal::FileOperations::decryptFileTo(
+            encFile.string(), decFile.string(), password, threads));
+        std::ifstream din(decFile, std::ios::binary);
+        std::string decryptedContent((std::istreambuf_iterator<char>(din)),
+                                     std::istreambuf_iterator<char>());
+        EXPECT_EQ(decryptedContent, originalContent) << "threads=" << threads;
+    }
+}
+
+// Segments that do not shrink are stored raw, so incompressible input costs
+// only the segment table on top of the plain format.
+TEST_F(FileOperationsTest, CompressedIncompressibleSegmentsStoredRaw)
+{
+    auto tempFile = GetTestFile("test_seg_noisy.tmp");
+    std::string originalContent(seal::cfg::SEGMENT_LEN * 2 + 99, '\0');
+    uint32_t state = 0x12345678u;
+    for (auto& c : originalContent)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        c = static_cast<char>(state);
+    }
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << originalContent;
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_seg_noisy.tmp.seal");
+    auto decFile = GetTestFile("test_seg_noisy_dec.tmp");
+    seal::Cryptography::setSegmentCompression(true);
+    const bool encrypted =
+        seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password);
+    seal::Cryptography::setSegmentCompression(false);
+    ASSERT_TRUE(encrypted);
+
+    const size_t segments = 3;
+    const size_t table = 8 + 4 * segments + seal::cfg::TAG_LEN;
+    EXPECT_EQ(std::filesystem::file_size(encFile),
+              seal::cfg::SEGMENT_HEADER_LEN + originalContent.size() +
+                  segments * seal::cfg::TAG_LEN + table + seal::cfg::SEGMENT_TABLE_TRAILER_LEN);
+
+    ASSERT_TRUE(seal::FileOperations::decryptFileTo(encFile.string(), decFile.string(), password));
+    std::ifstream in(decFile, std::ios::binary);
+    std::string decryptedContent((std::istreambuf_iterator<char>(in)),
+                                 std::istreambuf_iterator<char>());
+    EXPECT_EQ(decryptedContent, originalContent);
+}
+
+// Tampering with a compressed segment or with the table is caught before
+// any plaintext is written.
+TEST_F(FileOperationsTest, CompressedTamperingFails)
+{
+    auto tempFile = GetTestFile("test_seg_ctamper.tmp");
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << std::string(seal::cfg::SEGMENT_LEN * 2 + 5, 'z');
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_seg_ctamper.tmp.seal");
+    auto decFile = GetTestFile("test_seg_ctamper_dec.tmp");
+    seal::Cryptography::setSegmentCompression(true);
+    const bool encrypted =
+        seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password);
+    seal::Cryptography::setSegmentCompression(false);
+    ASSERT_TRUE(encrypted);
+
+    const auto size = std::filesystem::file_size(encFile);
+    for (const auto pos : {static_cast<uintmax_t>(seal::cfg::SEGMENT_HEADER_LEN + 1),
+                           size - seal::cfg::SEGMENT_TABLE_TRAILER_LEN - 1})
+    {
+        std::ifstream in(encFile, std::ios::binary);
+        std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)),
+                                        std::istreambuf_iterator<char>());
+        in.close();
+        blob[pos] ^= 0x01;
+        auto badFile = GetTestFile("test_seg_ctamper_bad.seal");
+        {
+            std::ofstream out(badFile, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(blob.data()),
+                      static_cast<std::streamsize>(blob.size()));
+        }
+        EXPECT_FALSE(
+            seal::FileOperations::decryptFileTo(badFile.string(), decFile.string(), password))
+            << pos;
+        EXPECT_FALSE(std::filesystem::exists(decFile)) << pos;
+        EXPECT_THROW(seal::FileOperations::verifyFile(badFile.string(), password),
+                     std::runtime_error)
+            << pos;
+    }
+}
+
+// Ranges that start, end and straddle segment boundaries come back exactly,
+// from plain and compressed segmented files and from small classic packets.
+TEST_F(FileOperationsTest, DecryptRangeMatchesPlaintext)
+{
+    const size_t seg = seal::cfg::SEGMENT_LEN;
+    std::string originalContent;
+    while (originalContent.size() < seg * 4 + 1000)
+        originalContent += "record " + std::to_string(originalContent.size()) + "\n";
+    auto tempFile = GetTestFile("test_range.tmp");
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << originalContent;
+    }
+    auto smallFile = GetTestFile("test_range_small.tmp");
+    const std::string smallContent = "short\r\nclassic\npacket";
+    {
+        std::ofstream out(smallFile, std::ios::binary);
+        out << smallContent;
+    }
+
+    auto password = make_secure_string("test_password");
+    auto plainEnc = GetTestFile("test_range.tmp.seal");
+    auto compressedEnc = GetTestFile("test_range_c.tmp.seal");
+    auto smallEnc = GetTestFile("test_range_small.tmp.seal");
+    ASSERT_TRUE(
+        seal::FileOperations::encryptFileTo(tempFile.string(), plainEnc.string(), password));
+    ASSERT_TRUE(
+        seal::FileOperations::encryptFileTo(smallFile.string(), smallEnc.string(), password));
+    seal::Cryptography::setSegmentCompression(true);
+    const bool encrypted =
+        seal::FileOperations::encryptFileTo(tempFile.string(), compressedEnc.string(), password);
+    seal::Cryptography::setSegmentCompression(false);
+    ASSERT_TRUE(encrypted);
+
+    auto range = [&](const std::filesystem::path& p, uint64_t offset, uint64_t length)
+    {
+        std::ostringstream out;
+        const uint64_t n =
+            seal::FileOperations::decryptRange(p.string(), offset, length, out, password);
+        EXPECT_EQ(n, out.str().size());
+        return out.str();
+    };
+
+    const std::vector<std::pair<uint64_t, uint64_t>> cases = {
+        {0, 10}, {seg - 3, 7}, {seg, seg}, {seg * 2 + 5, seg * 2}, {100, UINT64_MAX}};
+    for (const auto& p : {plainEnc, compressedEnc})
+    {
+        for (const auto& [offset, length] : cases)
+            EXPECT_EQ(range(p, offset, length), originalContent.substr(offset, length))
+                << p << " @" << offset;
+        EXPECT_EQ(range(p, originalContent.size(), 10), "");
+        EXPECT_EQ(range(p, 5, 0), "");
+    }
+    EXPECT_EQ(range(smallEnc, 6, 8), smallContent.substr(6, 8));
+    EXPECT_EQ(range(smallEnc, 100, 8), "");
+
+    std::ostringstream sink;
+    EXPECT_THROW(seal::FileOperations::decryptRange(
+                     plainEnc.string(), 0, 10, sink, make_secure_string("wrong_password")),
+                 std::runtime_error);
+
+    // An empty range still checks the password, in every layout.
+    const auto wrong = make_secure_string("wrong_password");
+    for (const auto& p : {plainEnc, compressedEnc, smallEnc})
+    {
+        EXPECT_THROW(seal::FileOperations::decryptRange(
+                         p.string(), originalContent.size() + 10, 10, sink, wrong),
+                     std::runtime_error)
+            << p;
+        EXPECT_THROW(seal::FileOperations::decryptRange(p.string(), 5, 0, sink, wrong),
+                     std::runtime_error)
+            << p;
+    }
+    EXPECT_TRUE(sink.str().empty());
+}
+
+// Damage outside the range goes unnoticed; damage inside it is caught
+// before the damaged segment's bytes are written.
+TEST_F(FileOperationsTest, DecryptRangeAuthenticatesOnlyCoveredSegments)
+{
+    const size_t seg = seal::cfg::SEGMENT_LEN;
+    auto tempFile = GetTestFile("test_range_tamper.tmp");
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << std::string(seg * 3, 'q');
+    }
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_range_tamper.tmp.seal");
+    ASSERT_TRUE(seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password));
+    {
+        // One byte into segment 1.
+        std::fstream f(encFile, std::ios::binary | std::ios::in | std::ios::out);
+        const auto pos = static_cast<std::streamoff>(seal::cfg::SEGMENT_HEADER_LEN + seg +
+                                                     seal::cfg::TAG_LEN + 1);
+        f.seekg(pos);
+        char c = 0;
+        f.get(c);
+        f.seekp(pos);
+        f.put(static_cast<char>(c ^ 0x01));
+    }
+
+    std::ostringstream head;
+    EXPECT_EQ(seal::FileOperations::decryptRange(encFile.string(), 0, seg, head, password), seg);
+    std::ostringstream tail;
+    EXPECT_EQ(
+        seal::FileOperations::decryptRange(encFile.string(), seg * 2, seg, tail, password), seg);
+
+    std::ostringstream across;
+    EXPECT_THROW(
+        seal::FileOperations::decryptRange(encFile.string(), seg - 4, 8, across, password),
+        std::runtime_error);
+    EXPECT_EQ(across.str(), std::string(4, 'q'));
+}
+
+// A file sealed with ChaCha20-Poly1305 records it in its header; readers
+// follow the header whatever the process default is.
+TEST_F(FileOperationsTest, ChaChaSegmentsRoundtrip)
+{
+    auto tempFile = GetTestFile("test_seg_chacha.tmp");
+    std::string originalContent(seal::cfg::SEGMENT_LEN * 2 + 321, '\0');
+    for (size_t i = 0; i < originalContent.size(); ++i)
+        originalContent[i] = static_cast<char>(i * 29 + 3);
+    {
+        std::ofstream out(tempFile, std::ios::binary);
+        out << originalContent;
+    }
+
+    auto password = make_secure_string("test_password");
+    auto encFile = GetTestFile("test_seg_chacha.tmp.seal");
+    auto decFile = GetTestFile("test_seg_chacha_dec.tmp");
+    seal::Cryptography::setAead(seal::AeadAlgorithm::ChaCha20Poly1305);
+    const bool encrypted =
+        seal::FileOperations::encryptFileTo(tempFile.string(), encFile.string(), password, 2);
+    seal::Cryptography::setAead(seal::AeadAlgorithm::Aes256Gcm);
+    ASSERT_TRUE(encrypted);
+
+    std::ifstream in(encFile, std::ios::binary);
+    std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+    in.close();
+    EXPECT_EQ(seal::Cryptography::segmentAead(blob), seal::AeadAlgorithm::ChaCha20Poly1305);
+    EXPECT_EQ(blob.size(),
+              seal::cfg::SEGMENT_HEADER_LEN + originalContent.size() + 3 * seal::cfg::TAG_LEN);
+    EXPECT_NO_THROW(seal::FileOperations::verifyFile(encFile.string(), password));
+
+    ASSERT_TRUE(
+        seal::FileOperations::decryptFileTo(encFile.string(), decFile.string(), password, 3));
+    std::ifstream din(decFile, std::ios::binary);
+    std::string decryptedContent((std::istreambuf_iterator<char>(din)),
+                                 std::istreambuf_iterator<char>());
+    EXPECT_EQ(decryptedContent, originalContent);
+
+    std::ostringstream range;
+    seal::FileOperations::decryptRange(
+        encFile.string(), seal::cfg::SEGMENT_LEN - 2, 4, range, password);
+    EXPECT_EQ(range.str(), originalContent.substr(seal::cfg::SEGMENT_LEN - 2, 4));
+    seal::Cryptography::setAead(seal::Cryptography::preferredAead());
+}
+
+TEST_F(FileOperationsTest, ProcessDirectoryDeepTreeRoundtrip)
+{
+    // Deeper than the worker count, with files at every level, so parents
+    // and children are in flight at the same time.
+    auto root = GetTestFile("tree");
+    std::vector<std::pair<std::filesystem::path, std::string>> files;
+    auto level = root;
+    for (int depth = 0; depth < 12; ++depth)
+    {
+        level /= "d" + std::to_string(depth);
+        std::filesystem::create_directories(level / "side");
+        for (int i = 0; i < 3; ++i)
+        {
+            auto name = "f" + std::to_string(i) + ".txt";
+            files.emplace_back(level / name, "depth " + std::to_string(depth) + " file " + name);
+            files.emplace_back(level / "side" / name, "side " + std::to_string(depth) + name);
+        }
+    }
+    for (const auto& [path, content] : files)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    seal::basic_secure_string<wchar_t> password;
+    for (wchar_t c : std::wstring(L"test_password"))
+        password.push_back(c);
+
+    ASSERT_TRUE(seal::FileOperations::processDirectory(root.string(), password));
+    for (const auto& [path, content] : files)
+    {
+        EXPECT_FALSE(std::filesystem::exists(path)) << path;
+        EXPECT_TRUE(std::filesystem::exists(path.string() + ".seal")) << path;
+    }
+
+    ASSERT_TRUE(seal::FileOperations::processDirectory(root.string(), password));
+    for (const auto& [path, content] : files)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string restored((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+        EXPECT_EQ(restored, content) << path;
+    }
+}
+
+// Files of one batch share a salt, yet each must decrypt on its own with
+// just the password, with or without a keyring.
+TEST_F(FileOperationsTest, BatchKeyedFilesDecryptIndependently)
+{
+    auto password = make_secure_string("test_password");
+    seal::FileKeyring keyring;
+    std::vector<std::pair<std::string, std::string>> files = {
+        {"batch_empty.tmp", ""},
+        {"batch_small.tmp", "small config file"},
+        {"batch_large.tmp", std::string(seal::cfg::SEGMENT_LEN + 4321, 'x')},
+    };
+
+    for (const auto& [name, content] : files)
+    {
+        auto src = GetTestFile(name);
+        {
+            std::ofstream out(src, std::ios::binary);
+            out << content;
+        }
+        auto enc = GetTestFile(name + ".seal");
+        ASSERT_TRUE(seal::FileOperations::encryptFileTo(
+            src.string(), enc.string(), password, 1, &keyring));
+
+        std::ifstream in(enc, std::ios::binary);
+        std::vector<unsigned char> blob((std::istreambuf_iterator<char>(in)),
+                                        std::istreambuf_iterator<char>());
+        in.close();
+        ASSERT_TRUE(seal::Cryptography::isKeyedSegmentPacket(blob)) << name;
+        auto plain =
+            seal::Cryptography::decryptPacket(std::span<const unsigned char>(blob), password);
+        EXPECT_EQ(std::string(plain.begin(), plain.end()), content) << name;
+
+        for (seal::FileKeyring* ring : {static_cast<seal::FileKeyring*>(nullptr), &keyring})
+        {
+            auto dec = GetTestFile(name + ".dec");
+            ASSERT_TRUE(seal::FileOperations::decryptFileTo(
+                enc.string(), dec.string(), password, 1, ring))
+                << name;
+            std::ifstream din(dec, std::ios::binary);
+            std::string restored((std::istreambuf_iterator<char>(din)),
+                                 std::istreambuf_iterator<char>());
+            EXPECT_EQ(restored, content) << name;
+        }
+    }
+    EXPECT_EQ(keyring.size(), 1u);
+
+    auto wrong = make_secure_string("wrong_password");
+    seal::FileKeyring other;
+    EXPECT_FALSE(seal::FileOperations::decryptFileTo(GetTestFile("batch_small.tmp.seal").string(),
+                                                     GetTestFile("batch_wrong.tmp").string(),
+                                                     wrong,
+                                                     1,
+                                                     &other));
+}
+
+TEST_F(FileOperationsTest, HashFileKnownDigests)
+{
+    auto path = GetTestFile("hash_abc.tmp");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "abc";
+    }
+    EXPECT_EQ(seal::FileOperations::hashFile(path.string()),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(seal::FileOperations::hashFile(path.string(), seal::HashAlgorithm::Blake2b),
+              "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+              "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+    EXPECT_TRUE(seal::FileOperations::hashFile(GetTestFile("missing.tmp").string()).empty());
+}
+
+// Above cfg::HASH_MAP_MIN the file is hashed from mapped views, with the
+// last view shorter than the rest.
+TEST_F(FileOperationsTest, HashFileMappedMatchesOneShotDigest)
+{
+    std::string content(seal::cfg::HASH_MAP_VIEW + 12345, '\0');
+    for (size_t i = 0; i < content.size(); ++i)
+        content[i] = static_cast<char>(i * 131 + (i >> 12));
+    auto path = GetTestFile("hash_large.tmp");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int mdLen = 0;
+    ASSERT_EQ(EVP_Digest(content.data(), content.size(), md, &mdLen, EVP_sha256(), nullptr), 1);
+    EXPECT_EQ(seal::FileOperations::hashFile(path.string()),
+              seal::utils::to_hex(std::span<const unsigned char>(md, mdLen)));
+}
+
+TEST_F(FileOperationsTest, HashDirectoryWritesSortedManifest)
+{
+    auto root = GetTestFile("hash_tree");
+    std::filesystem::create_directories(root / "sub");
+    const std::vector<std::pair<std::string, std::string>> files = {
+        {"b.txt", "abc"}, {"a.txt", "abc"}, {"sub/c", ""}};
+    for (const auto& [rel, content] : files)
+    {
+        std::ofstream out(root / rel, std::ios::binary);
+        out << content;
+    }
+
+    std::ostringstream manifest;
+    ASSERT_TRUE(seal::FileOperations::hashDirectory(root.string(), manifest));
+    const std::string abc = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+    const std::string empty = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+    EXPECT_EQ(manifest.str(), abc + "  a.txt\n" + abc + "  b.txt\n" + empty + "  sub/c\n");
+}
+
+TEST_F(FileOperationsTest, ShredFileRemovesOddSizedFile)
+{
+    // Not a multiple of any sector size, so the unbuffered tail is padded.
+    auto path = GetTestFile("shred_odd.tmp");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(seal::cfg::SHRED_CHUNK * 2 + 777, 'x');
+    }
+    ASSERT_TRUE(seal::FileOperations::shredFile(path.string()));
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_F(FileOperationsTest, ShredDirectoryRemovesWholeTree)
+{
+    auto root = GetTestFile("shred_tree");
+    std::filesystem::create_directories(root / "sub" / "deeper");
+    std::filesystem::create_directories(root / "empty");
+    for (const char* rel : {"a.txt", "sub/b.bin", "sub/deeper/c", "sub/deeper/zero"})
+    {
+        std::ofstream out(root / rel, std::ios::binary);
+        if (std::string_view(rel) != "sub/deeper/zero")
+            out << std::string(5000, 's');
+    }
+
+    ASSERT_TRUE(seal::FileOperations::shredDirectory(root.string()));
+    EXPECT_FALSE(std::filesystem::exists(root));
+}
+
+TEST_F(FileOperationsTest, VerifyFileStreamsBothFormats)
+{
+    auto password = make_secure_string("test_password");
+    seal::FileKeyring keyring;
+    const std::vector<std::pair<std::string, std::string>> files = {
+        {"verify_small.tmp", "classic packet"},
+        {"verify_large.tmp", std::string(seal::cfg::SEGMENT_LEN * 2 + 99, 'v')},
+    };
+    for (const auto& [name, content] : files)
+    {
+        auto src = GetTestFile(name);
+        {
+            std::ofstream out(src, std::ios::binary);
+            out << content;
+        }
+        auto plainEnc = GetTestFile(name + ".seal");
+        auto keyedEnc = GetTestFile(name + ".keyed.seal");
+        ASSERT_TRUE(
+            seal::FileOperations::encryptFileTo(src.string(), plainEnc.string(), password));
+        ASSERT_TRUE(seal::FileOperations::encryptFileTo(
+            src.string(), keyedEnc.string(), password, 1, &keyring));
+
+        EXPECT_NO_THROW(seal::FileOperations::verifyFile(plainEnc.string(), password)) << name;
+        EXPECT_NO_THROW(seal::FileOperations::verifyFile(keyedEnc.string(), password, &keyring))
+            << name;
+        auto wrong = make_secure_string("wrong_password");
+        EXPECT_THROW(seal::FileOperations::verifyFile(plainEnc.string(), wrong),
+                     std::runtime_error)
+            << name;
+    }
+}
+
+TEST_F(FileOperationsTest, VerifyDirectoryReportsEachFile)
+{
+    auto password = make_secure_string("test_password");
+    auto root = GetTestFile("verify_tree");
+    std::filesystem::create_directories(root / "sub");
+    for (const char* rel : {"a.txt", "sub/b.txt", "sub/c.txt"})
+    {
+        {
+            std::ofstream out(root / rel, std::ios::binary);
+            out << "content of " << rel;
+        }
+        ASSERT_TRUE(seal::FileOperations::encryptFileTo(
+            (root / rel).string(), (root / rel).string() + ".seal", password));
+    }
+
+    // Flip one ciphertext byte past the header; plain files are ignored.
+    {
+        std::fstream f(root / "sub/b.txt.seal", std::ios::binary | std::ios::in | std::ios::out);
+        f.seekg(40);
+        const char byte = static_cast<char>(f.get() ^ 0x5a);
+        f.seekp(40);
+        f.put(byte);
+    }
+
+    std::ostringstream report;
+    const auto summary = seal::FileOperations::verifyDirectory(root.string(), password, report);
+    EXPECT_EQ(summary.passed, 2u);
+    EXPECT_EQ(summary.failed, 1u);
+    EXPECT_FALSE(summary.ok());
+    const std::string text = report.str();
+    EXPECT_EQ(text.find("a.txt.seal: OK\nsub/b.txt.seal: FAILED ("), 0u) << text;
+    EXPECT_NE(text.find("sub/c.txt.seal: OK\n"), std::string::npos) << text;
+}
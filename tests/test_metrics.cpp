@@ -0,0 +1,133 @@
+/**
+ * @file test_metrics.cpp
+ * @brief Tests for the in-process counters and latency histograms
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "test_helpers.h"
+
+#include "../src/Metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using seal::metrics::Counter;
+using seal::metrics::Latency;
+
+class MetricsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { seal::metrics::reset(); }
+    void TearDown() override { seal::metrics::reset(); }
+};
+
+TEST_F(MetricsTest, CountersAccumulateAcrossThreads)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            []
+            {
+                for (int i = 0; i < 1000; ++i)
+                    seal::metrics::add(Counter::BytesSealed, 3);
+            });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    auto s = seal::metrics::snapshot();
+    EXPECT_EQ(s.counter(Counter::BytesSealed), 12000u);
+    EXPECT_EQ(s.counter(Counter::BytesOpened), 0u);
+}
+
+TEST_F(MetricsTest, HistogramQuantilesBracketObservations)
+{
+    for (int ms = 1; ms <= 100; ++ms)
+        seal::metrics::record(Latency::KeyDerivation, std::chrono::milliseconds(ms));
+
+    const auto s = seal::metrics::snapshot();
+    const auto& h = s.latency(Latency::KeyDerivation);
+    EXPECT_EQ(h.count, 100u);
+    EXPECT_EQ(h.maxNs, 100'000'000u);
+    EXPECT_EQ(h.sumNs, 5050u * 1'000'000u);
+
+    // Power-of-two buckets: the median (50 ms) sits in [32.8, 65.5) ms.
+    const uint64_t p50 = h.quantileUs(0.5);
+    EXPECT_GE(p50, 50'000u);
+    EXPECT_LE(p50, 2 * 50'000u);
+    // Quantiles never report more than the largest observation.
+    EXPECT_EQ(h.quantileUs(1.0), 100'000u);
+    EXPECT_LE(h.quantileUs(0.99), 100'000u);
+}
+
+TEST_F(MetricsTest, ScopedTimerRecordsOnce)
+{
+    {
+        seal::metrics::ScopedTimer timer(Latency::VaultLoad);
+        std::this_thread::sleep_for(2ms);
+    }
+    const auto s = seal::metrics::snapshot();
+    const auto& h = s.latency(Latency::VaultLoad);
+    EXPECT_EQ(h.count, 1u);
+    EXPECT_GE(h.maxNs, 2'000'000u);
+}
+
+TEST_F(MetricsTest, ResetClearsEverything)
+{
+    seal::metrics::add(Counter::PacketsSealed, 5);
+    seal::metrics::record(Latency::Fill, 10ms);
+    seal::metrics::reset();
+
+    auto s = seal::metrics::snapshot();
+    EXPECT_EQ(s.counter(Counter::PacketsSealed), 0u);
+    EXPECT_EQ(s.latency(Latency::Fill).count, 0u);
+    EXPECT_EQ(s.latency(Latency::Fill).quantileUs(0.5), 0u);
+}
+
+TEST_F(MetricsTest, ReportListsCountersAndObservedLatencies)
+{
+    seal::metrics::add(Counter::PacketsSealed, 2);
+    seal::metrics::record(Latency::VaultSave, 5ms);
+
+    const std::string report = seal::metrics::report(seal::metrics::snapshot());
+    EXPECT_NE(report.find("metric=uptime seconds="), std::string::npos);
+    EXPECT_NE(report.find("metric=packets_sealed total=2 "), std::string::npos);
+    EXPECT_NE(report.find("metric=vault_save count=1 "), std::string::npos);
+    EXPECT_EQ(report.find("metric=kdf "), std::string::npos);
+}
+
+TEST_F(MetricsTest, PacketRoundtripIsCounted)
+{
+    auto password = make_secure_string("metrics_password");
+    const std::string text = "count me";
+    auto packet = seal::Cryptography::encryptPacket(
+        std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(text.data()),
+                                       text.size()),
+        password);
+    auto plain =
+        seal::Cryptography::decryptPacket(std::span<const unsigned char>(packet), password);
+    ASSERT_EQ(plain.size(), text.size());
+
+    auto s = seal::metrics::snapshot();
+    EXPECT_EQ(s.counter(Counter::PacketsSealed), 1u);
+    EXPECT_EQ(s.counter(Counter::PacketsOpened), 1u);
+    EXPECT_EQ(s.counter(Counter::BytesSealed), text.size());
+    EXPECT_EQ(s.counter(Counter::BytesOpened), text.size());
+    EXPECT_EQ(s.counter(Counter::KeyDerivations), 2u);
+    EXPECT_EQ(s.latency(Latency::KeyDerivation).count, 2u);
+
+    auto wrong = make_secure_string("wrong_password");
+    EXPECT_THROW(
+        (void)seal::Cryptography::decryptPacket(std::span<const unsigned char>(packet), wrong),
+        std::runtime_error);
+    EXPECT_EQ(seal::metrics::snapshot().counter(Counter::AuthFailures), 1u);
+}
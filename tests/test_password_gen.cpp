@@ -0,0 +1,81 @@
+/**
+ * @file test_password_gen.cpp
+ * @brief Tests for single and batched password generation
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "../src/PasswordGen.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+constexpr std::string_view kCharset =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789!@#$%^&*()-_=+";
+
+bool inCharset(std::string_view password)
+{
+    return password.find_first_not_of(kCharset) == std::string_view::npos;
+}
+
+}  // namespace
+
+TEST(PasswordGenTest, LengthIsClamped)
+{
+    EXPECT_EQ(seal::GeneratePassword(20).size(), 20u);
+    EXPECT_EQ(seal::GeneratePassword(1).size(), 8u);
+    EXPECT_EQ(seal::GeneratePassword(1000).size(), 128u);
+    EXPECT_TRUE(inCharset(seal::GeneratePassword(64).view()));
+}
+
+TEST(PasswordGenTest, BatchIsNewlineSeparated)
+{
+    auto batch = seal::GeneratePasswords(500, 24);
+    ASSERT_EQ(batch.count, 500u);
+    ASSERT_EQ(batch.length, 24u);
+    ASSERT_EQ(batch.text.size(), 500u * 25u);
+
+    std::set<std::string> seen;
+    for (size_t i = 0; i < batch.count; ++i)
+    {
+        const std::string_view password = batch.password(i);
+        ASSERT_EQ(password.size(), 24u);
+        EXPECT_TRUE(inCharset(password)) << i;
+        EXPECT_EQ(batch.text.view()[i * 25 + 24], '\n');
+        seen.emplace(password);
+    }
+    // 500 draws from 76^24 values: a collision means the sampler is broken.
+    EXPECT_EQ(seen.size(), batch.count);
+}
+
+TEST(PasswordGenTest, BatchSpansSeveralRandomBlocks)
+{
+    // 1000 x 128 characters needs well over one 8 KiB RAND_bytes block.
+    auto batch = seal::GeneratePasswords(1000, 128);
+    ASSERT_EQ(batch.text.size(), 1000u * 129u);
+
+    size_t counts[256] = {};
+    for (size_t i = 0; i < batch.count; ++i)
+        for (char c : batch.password(i))
+            ++counts[static_cast<unsigned char>(c)];
+    // Every character of the charset shows up with roughly 128000 / 76 ~ 1684 hits.
+    for (char c : kCharset)
+    {
+        EXPECT_GT(counts[static_cast<unsigned char>(c)], 1200u) << c;
+        EXPECT_LT(counts[static_cast<unsigned char>(c)], 2200u) << c;
+    }
+}
+
+TEST(PasswordGenTest, BatchArgumentsAreClamped)
+{
+    auto batch = seal::GeneratePasswords(0, 4);
+    EXPECT_EQ(batch.count, 1u);
+    EXPECT_EQ(batch.length, 8u);
+    EXPECT_EQ(batch.text.size(), 9u);
+}
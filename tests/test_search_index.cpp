@@ -0,0 +1,97 @@
+/**
+ * @file test_search_index.cpp
+ * @brief Unit tests for the platform-name n-gram search index
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "test_helpers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SearchIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        index.assign(0, "github");
+        index.assign(1, "gitlab");
+        index.assign(2, "google mail");
+        index.assign(3, "bank");
+    }
+
+    std::vector<uint32_t> find(const std::string& needle)
+    {
+        std::vector<uint32_t> out;
+        index.find(needle, out);
+        return out;
+    }
+
+    seal::PlatformSearchIndex index;
+};
+
+TEST_F(SearchIndexTest, EmptyNeedleMatchesEveryEntry)
+{
+    EXPECT_EQ(find(""), (std::vector<uint32_t>{0, 1, 2, 3}));
+}
+
+TEST_F(SearchIndexTest, ShortNeedleUsesPostingList)
+{
+    EXPECT_EQ(find("g"), (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_EQ(find("it"), (std::vector<uint32_t>{0, 1}));
+    EXPECT_EQ(find("ban"), (std::vector<uint32_t>{3}));
+}
+
+TEST_F(SearchIndexTest, LongNeedleIsVerifiedAgainstText)
+{
+    EXPECT_EQ(find("gith"), (std::vector<uint32_t>{0}));
+    EXPECT_EQ(find("e mai"), (std::vector<uint32_t>{2}));
+    // Every trigram of "abcde" is indexed, but no single entry contains it.
+    index.assign(4, "abcd");
+    index.assign(5, "bcde");
+    EXPECT_TRUE(find("abcde").empty());
+}
+
+TEST_F(SearchIndexTest, MissingGramReturnsNothing)
+{
+    EXPECT_TRUE(find("z").empty());
+    EXPECT_TRUE(find("gitz").empty());
+}
+
+TEST_F(SearchIndexTest, ReassignReplacesOldGrams)
+{
+    index.assign(3, "bitbucket");
+
+    EXPECT_TRUE(find("ban").empty());
+    EXPECT_EQ(find("bucket"), (std::vector<uint32_t>{3}));
+    EXPECT_EQ(index.text(3), "bitbucket");
+}
+
+TEST_F(SearchIndexTest, TruncateDropsTrailingEntries)
+{
+    index.truncate(2);
+
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_TRUE(find("bank").empty());
+    EXPECT_EQ(find("g"), (std::vector<uint32_t>{0, 1}));
+}
+
+TEST_F(SearchIndexTest, RepeatedGramsAreIndexedOnce)
+{
+    index.assign(4, "aaaa");
+
+    EXPECT_EQ(find("a"), (std::vector<uint32_t>{1, 2, 3, 4}));
+    EXPECT_EQ(find("aaa"), (std::vector<uint32_t>{4}));
+}
+
+TEST_F(SearchIndexTest, MultiByteUtf8Matches)
+{
+    index.assign(4, "caf\xc3\xa9 cr\xc3\xa8me");
+
+    EXPECT_EQ(find("\xc3\xa9 c"), (std::vector<uint32_t>{4}));
+    EXPECT_EQ(find("cr\xc3\xa8me"), (std::vector<uint32_t>{4}));
+}
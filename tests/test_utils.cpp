@@ -9,7 +9,11 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cctype>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace std::string_literals;
@@ -150,6 +154,100 @@ TEST_F(HexUtilsTest, FromHexRoundtripWithToHex)
     EXPECT_EQ(decoded, original);
 }
 
+// Lengths around the 16/32/64-byte SIMD blocks, so each kernel hands a
+// non-empty tail to the scalar loop.
+TEST_F(HexUtilsTest, VectorKernelsMatchAcrossBlockSizes)
+{
+    for (size_t n : {1u, 15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 65u, 100u, 1000u})
+    {
+        std::vector<unsigned char> data(n);
+        for (size_t i = 0; i < n; ++i)
+            data[i] = static_cast<unsigned char>(i * 37 + 11);
+
+        std::string expected;
+        for (unsigned char c : data)
+        {
+            expected.push_back("0123456789abcdef"[c >> 4]);
+            expected.push_back("0123456789abcdef"[c & 0x0F]);
+        }
+        const std::string hex = seal::utils::to_hex(data);
+        EXPECT_EQ(hex, expected) << n;
+
+        std::string upper = hex;
+        for (char& c : upper)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        std::vector<unsigned char> decoded;
+        EXPECT_TRUE(seal::utils::from_hex(upper, decoded)) << n;
+        EXPECT_EQ(decoded, data) << n;
+
+        // An invalid character in the last byte, or deep inside a block.
+        for (size_t pos : {upper.size() - 1, upper.size() / 2})
+        {
+            std::string bad = upper;
+            bad[pos] = 'g';
+            EXPECT_FALSE(seal::utils::from_hex(bad, decoded)) << n << " " << pos;
+            EXPECT_TRUE(decoded.empty());
+        }
+    }
+}
+
+TEST_F(HexUtilsTest, ToHexIsUsableAtCompileTime)
+{
+    constexpr std::array<unsigned char, 3> bytes = {0x01, 0xAB, 0xFF};
+    static_assert(seal::utils::to_hex(bytes) == "01abff");
+    EXPECT_EQ(seal::utils::to_hex(bytes), "01abff");
+}
+
+// Test suite for Base64 encoding/decoding
+class Base64UtilsTest : public ::testing::Test
+{
+};
+
+TEST_F(Base64UtilsTest, Rfc4648Vectors)
+{
+    const std::pair<std::string, std::string> vectors[] = {
+        {"", ""},
+        {"f", "Zg=="},
+        {"fo", "Zm8="},
+        {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"},
+    };
+    for (const auto& [plain, encoded] : vectors)
+    {
+        std::vector<unsigned char> bytes(plain.begin(), plain.end());
+        EXPECT_EQ(seal::utils::toBase64(bytes), encoded);
+        EXPECT_EQ(seal::utils::fromBase64(encoded), bytes);
+    }
+}
+
+TEST_F(Base64UtilsTest, RoundtripAcrossBlockSizes)
+{
+    for (size_t n : {11u, 12u, 13u, 24u, 27u, 28u, 29u, 48u, 100u, 1000u})
+    {
+        std::vector<unsigned char> data(n);
+        for (size_t i = 0; i < n; ++i)
+            data[i] = static_cast<unsigned char>(i * 91 + 7);
+        const std::string b64 = seal::utils::toBase64(data);
+        EXPECT_EQ(b64.size(), seal::utils::base64EncodedSize(n));
+        EXPECT_EQ(seal::utils::fromBase64(b64), data) << n;
+        EXPECT_EQ(seal::utils::fromBase64(" " + b64 + "\r\n"), data) << n;
+
+        std::string bad = b64;
+        bad[b64.size() / 2] = '*';
+        EXPECT_TRUE(seal::utils::fromBase64(bad).empty()) << n;
+    }
+}
+
+TEST_F(Base64UtilsTest, MalformedInputIsRejected)
+{
+    EXPECT_TRUE(seal::utils::fromBase64("Zm9").empty());       // not a multiple of 4
+    EXPECT_TRUE(seal::utils::fromBase64("Zm=v").empty());      // padding before a digit
+    EXPECT_TRUE(seal::utils::fromBase64("Z===").empty());      // too much padding
+    EXPECT_TRUE(seal::utils::fromBase64("Zg==Zm8=").empty());  // padding mid-stream
+}
+
 // Test suite for string manipulation
 class StringUtilsTest : public ::testing::Test
 {
@@ -271,3 +369,114 @@ TEST_F(HexTokenExtractionTest, WhitespaceOnly)
 
     EXPECT_TRUE(tokens.empty());
 }
+
+TEST_F(HexTokenExtractionTest, FindReturnsViewsIntoInput)
+{
+    // Tokens of varying length separated by every kind of whitespace, so
+    // token edges land at every offset of the scanner's blocks.
+    std::string input;
+    std::vector<std::string> expected;
+    const char separators[] = " \t\n\r\v\f";
+    for (size_t i = 0; i < 24; ++i)
+    {
+        std::string tok(88 + 2 * i, "0123456789abcDEF"[i % 16]);
+        input += tok;
+        input.append(1 + i % 3, separators[i % 6]);
+        expected.push_back(std::move(tok));
+        input += "zz ";  // not hex: skipped
+    }
+
+    auto tokens = seal::utils::findHexTokens(input);
+    ASSERT_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        EXPECT_EQ(tokens[i], expected[i]);
+        EXPECT_GE(tokens[i].data(), input.data());
+        EXPECT_LE(tokens[i].data() + tokens[i].size(), input.data() + input.size());
+    }
+}
+
+TEST_F(HexTokenExtractionTest, NonHexByteAnywhereRejectsToken)
+{
+    const std::string hex(128, 'a');
+    for (size_t pos = 0; pos < hex.size(); ++pos)
+    {
+        std::string tok = hex;
+        tok[pos] = static_cast<char>(pos % 2 ? 'g' : 0x80);
+        const std::string input = " " + tok + " " + hex;
+        auto tokens = seal::utils::findHexTokens(input);
+        ASSERT_EQ(tokens.size(), 1u) << "pos " << pos;
+        EXPECT_EQ(tokens[0], hex);
+    }
+}
+
+// ============================================================================
+// Bulk Input Tests
+// ============================================================================
+
+class BulkInputTest : public ::testing::Test
+{
+};
+
+TEST_F(BulkInputTest, LinesAreViewsIntoOneBuffer)
+{
+    std::istringstream in("first line\n\n   \nsecond\r\n?\nafter terminator\n");
+    seal::BulkInput batch;
+    seal::readBulkLinesDualFrom(in, batch);
+
+    ASSERT_EQ(batch.lines.size(), 2u);
+    EXPECT_EQ(batch.lines[0], "first line");
+    EXPECT_EQ(batch.lines[1], "second\r");
+    EXPECT_FALSE(batch.uncensored);
+    for (const auto& line : batch.lines)
+    {
+        EXPECT_GE(line.data(), batch.text.data());
+        EXPECT_LE(line.data() + line.size(), batch.text.data() + batch.text.size());
+    }
+
+    // The rest of the stream is left for the next batch.
+    std::string rest;
+    std::getline(in, rest);
+    EXPECT_EQ(rest, "after terminator");
+}
+
+TEST_F(BulkInputTest, BangTerminatorSelectsUncensored)
+{
+    std::istringstream in("token\n  !  \n");
+    seal::BulkInput batch;
+    seal::readBulkLinesDualFrom(in, batch);
+    ASSERT_EQ(batch.lines.size(), 1u);
+    EXPECT_TRUE(batch.uncensored);
+}
+
+TEST_F(BulkInputTest, MatchesPairOverload)
+{
+    const std::string input = "a\n\nb c\n" + std::string(70000, 'f') + "\n!\n";
+    std::istringstream first(input);
+    std::istringstream second(input);
+    const auto pair = seal::readBulkLinesDualFrom(first);
+    seal::BulkInput batch;
+    seal::readBulkLinesDualFrom(second, batch);
+
+    ASSERT_EQ(batch.lines.size(), pair.first.size());
+    for (size_t i = 0; i < batch.lines.size(); ++i)
+        EXPECT_EQ(batch.lines[i], pair.first[i]);
+    EXPECT_EQ(batch.uncensored, pair.second);
+}
+
+TEST_F(BulkInputTest, CleanseDropsEverything)
+{
+    std::istringstream in("secret\n!\n");
+    seal::BulkInput batch;
+    seal::readBulkLinesDualFrom(in, batch);
+    batch.cleanse();
+    EXPECT_TRUE(batch.text.empty());
+    EXPECT_TRUE(batch.lines.empty());
+    EXPECT_FALSE(batch.uncensored);
+
+    // Reading into a used batch starts from scratch.
+    std::istringstream again("x\n?\n");
+    seal::readBulkLinesDualFrom(again, batch);
+    ASSERT_EQ(batch.lines.size(), 1u);
+    EXPECT_EQ(batch.lines[0], "x");
+}
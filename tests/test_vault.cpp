@@ -0,0 +1,234 @@
+/**
+ * @file test_vault.cpp
+ * @brief Tests for reloading a vault that changed on disk
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "../src/Utils.h"
+#include "../src/Vault.h"
+
+#include <gtest/gtest.h>
+
+#include <QtCore/QString>
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+// A record as it looks after a load: on disk, clean, sealed under @p tag.
+seal::VaultRecord onDisk(uint64_t id, const std::string& platform, uint64_t tag)
+{
+    seal::VaultRecord rec;
+    rec.id = id;
+    rec.platform = platform;
+    rec.sealTag = tag;
+    rec.keyed = true;
+    return rec;
+}
+
+const seal::VaultRecord* findId(const std::vector<seal::VaultRecord>& records, uint64_t id)
+{
+    auto it = std::find_if(
+        records.begin(), records.end(), [id](const auto& rec) { return rec.id == id; });
+    return it != records.end() ? &*it : nullptr;
+}
+
+}  // namespace
+
+TEST(VaultMergeTest, CleanRecordsFollowTheDisk)
+{
+    auto changed = onDisk(1, "mail", 10);
+    changed.audit = 3;
+    auto same = onDisk(2, "bank", 20);
+    same.audit = 5;
+    std::vector<seal::VaultRecord> records = {changed, same, onDisk(3, "gone", 30)};
+    std::vector<seal::VaultRecord> fresh = {
+        onDisk(1, "mail (renamed)", 11), onDisk(2, "bank", 20), onDisk(4, "new", 40)};
+
+    const auto merge = seal::mergeReloadedRecords(records, std::move(fresh));
+    EXPECT_EQ(merge.added, 1u);
+    EXPECT_EQ(merge.updated, 1u);
+    EXPECT_EQ(merge.removed, 1u);
+    EXPECT_EQ(merge.conflicts, 0u);
+    EXPECT_EQ(merge.kept, 0u);
+    EXPECT_TRUE(merge.changed());
+
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(findId(records, 1)->platform, "mail (renamed)");
+    EXPECT_EQ(findId(records, 1)->audit, 0);  // re-sealed: the old audit no longer applies
+    EXPECT_EQ(findId(records, 2)->audit, 5);
+    EXPECT_EQ(findId(records, 3), nullptr);
+    EXPECT_EQ(findId(records, 4)->platform, "new");
+}
+
+TEST(VaultMergeTest, UnsavedEditSurvivesAndConflictGetsACopy)
+{
+    auto edited = onDisk(1, "mail (local)", 10);
+    edited.dirty = true;
+    auto untouched = onDisk(2, "bank (local)", 20);
+    untouched.dirty = true;
+    std::vector<seal::VaultRecord> records = {edited, untouched};
+    std::vector<seal::VaultRecord> fresh = {onDisk(1, "mail (remote)", 11),
+                                            onDisk(2, "bank", 20)};
+
+    const auto merge = seal::mergeReloadedRecords(records, std::move(fresh));
+    EXPECT_EQ(merge.conflicts, 1u);
+    EXPECT_EQ(merge.updated, 0u);
+    EXPECT_EQ(merge.kept, 0u);
+
+    // Both local edits are kept; only the one re-sealed on disk meanwhile
+    // gets the disk version beside it.
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(findId(records, 1)->platform, "mail (local)");
+    EXPECT_TRUE(findId(records, 1)->dirty);
+    EXPECT_EQ(findId(records, 2)->platform, "bank (local)");
+
+    const auto& copy = records.back();
+    EXPECT_EQ(copy.platform, "mail (remote) (conflicted copy)");
+    EXPECT_NE(copy.id, 1u);
+    EXPECT_NE(copy.id, 2u);
+    EXPECT_NE(copy.id, 0u);
+    EXPECT_EQ(copy.sealTag, 0u);
+    EXPECT_TRUE(copy.dirty);
+}
+
+TEST(VaultMergeTest, RecordsMissingOnDisk)
+{
+    auto editedThenRemoved = onDisk(1, "mail", 10);
+    editedThenRemoved.dirty = true;
+    auto deletedBoth = onDisk(2, "bank", 20);
+    deletedBoth.deleted = true;
+    seal::VaultRecord added;  // created here, never saved
+    added.id = 3;
+    added.platform = "shop";
+    added.dirty = true;
+    std::vector<seal::VaultRecord> records = {editedThenRemoved, deletedBoth, added};
+
+    const auto merge = seal::mergeReloadedRecords(records, {});
+    EXPECT_EQ(merge.kept, 1u);
+    EXPECT_EQ(merge.conflicts, 0u);
+    EXPECT_EQ(merge.removed, 0u);
+    EXPECT_EQ(merge.added, 0u);
+
+    // No conflicted copy: there is no disk version to keep.
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(findId(records, 1)->platform, "mail");
+    EXPECT_EQ(findId(records, 2), nullptr);
+    EXPECT_EQ(findId(records, 3)->platform, "shop");
+}
+
+TEST(VaultMergeTest, NothingChanged)
+{
+    std::vector<seal::VaultRecord> records = {onDisk(1, "mail", 10)};
+    const auto merge = seal::mergeReloadedRecords(records, {onDisk(1, "mail", 10)});
+    EXPECT_FALSE(merge.changed());
+    ASSERT_EQ(records.size(), 1u);
+}
+
+class VaultReloadTest : public ::testing::Test
+{
+protected:
+    using WidePassword = seal::basic_secure_string<wchar_t, seal::locked_allocator<wchar_t>>;
+
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() / "seal_vault_tests";
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root);
+        m_Path = QString::fromStdString((m_Root / "accounts.seal").string());
+        m_Master = seal::utils::utf8ToSecureWide("test_master");
+
+        const auto user = seal::utils::utf8ToSecureWide("user@example.com");
+        const auto pass = seal::utils::utf8ToSecureWide("hunter2");
+        std::vector<seal::VaultRecord> records;
+        const auto keySalt = seal::vaultKeySalt(records);
+        for (const char* platform : {"mail", "bank", "shop"})
+        {
+            records.push_back(seal::encryptCredential(
+                platform, user, pass, m_Master, keySalt, records, &m_KeyCache));
+        }
+        ASSERT_TRUE(seal::saveVaultV2(m_Path, records, m_Master, &m_KeyCache));
+    }
+
+    void TearDown() override { fs::remove_all(m_Root); }
+
+    std::vector<seal::VaultRecord> reload(const std::vector<seal::VaultRecord>& known)
+    {
+        return seal::loadVaultIndex(m_Path,
+                                    m_Master,
+                                    &m_KeyCache,
+                                    {},
+                                    nullptr,
+                                    seal::VaultLoadMode::Resident,
+                                    &known);
+    }
+
+    fs::path m_Root;
+    QString m_Path;
+    WidePassword m_Master;
+    seal::VaultKeyCache m_KeyCache;
+};
+
+TEST_F(VaultReloadTest, ReusesUnchangedKnownRecords)
+{
+    auto known = seal::loadVaultIndex(m_Path, m_Master, &m_KeyCache);
+    ASSERT_EQ(known.size(), 3u);
+    // Mark each known name, so a reused one shows up as not decrypted.
+    for (auto& rec : known)
+        rec.platform += " (known)";
+
+    const auto records = reload(known);
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].platform, "mail");  // record 0 always checks the password
+    EXPECT_EQ(records[1].platform, "bank (known)");
+    EXPECT_EQ(records[2].platform, "shop (known)");
+}
+
+TEST_F(VaultReloadTest, DecryptsKnownRecordsThatDoNotMatch)
+{
+    auto known = seal::loadVaultIndex(m_Path, m_Master, &m_KeyCache);
+    ASSERT_EQ(known.size(), 3u);
+    for (auto& rec : known)
+        rec.platform += " (known)";
+    known[1].sealTag ^= 1;     // re-sealed since
+    known[2].keySalt[0] ^= 1;  // sealed under another vault key
+
+    const auto records = reload(known);
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[1].platform, "bank");
+    EXPECT_EQ(records[2].platform, "shop");
+
+    // Unsaved edits are not trusted either.
+    known = seal::loadVaultIndex(m_Path, m_Master, &m_KeyCache);
+    for (auto& rec : known)
+    {
+        rec.platform += " (known)";
+        rec.dirty = true;
+    }
+    const auto fromDirty = reload(known);
+    ASSERT_EQ(fromDirty.size(), 3u);
+    EXPECT_EQ(fromDirty[1].platform, "bank");
+    EXPECT_EQ(fromDirty[2].platform, "shop");
+}
+
+TEST_F(VaultReloadTest, KnownRecordsDoNotSkipThePasswordCheck)
+{
+    const auto known = seal::loadVaultIndex(m_Path, m_Master, &m_KeyCache);
+    const auto wrong = seal::utils::utf8ToSecureWide("wrong_master");
+    EXPECT_THROW((void)seal::loadVaultIndex(m_Path,
+                                            wrong,
+                                            nullptr,
+                                            {},
+                                            nullptr,
+                                            seal::VaultLoadMode::Resident,
+                                            &known),
+                 std::runtime_error);
+}
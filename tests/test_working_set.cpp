@@ -0,0 +1,74 @@
+/**
+ * @file test_working_set.cpp
+ * @brief Tests for the locked-memory working-set budget
+ * @author seal Contributors
+ * @date 2024
+ */
+
+#include "test_helpers.h"
+
+#include "../src/WorkingSet.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace
+{
+
+// Larger than any slab slot, so the buffer gets its own locked region.
+constexpr size_t kRegion = 64 << 10;
+
+}  // namespace
+
+TEST(WorkingSetTest, EstimateGrowsWithTheVault)
+{
+    const uint64_t empty = seal::working_set::estimate(0, 0);
+    EXPECT_EQ(empty, seal::cfg::WORKING_SET_BASE);
+    EXPECT_EQ(seal::working_set::estimate(1000, 0) - empty,
+              1000u * seal::cfg::WORKING_SET_RECORD_BYTES);
+    EXPECT_EQ(seal::working_set::estimate(0, 64 << 20) - empty, 64u << 20);
+    // An invalid KDF reports UINT64_MAX; the estimate stays bounded.
+    EXPECT_EQ(seal::working_set::estimate(0, UINT64_MAX) - empty, seal::cfg::KDF_MAX_MEMORY);
+}
+
+TEST(WorkingSetTest, ReserveRaisesTheMinimumOnce)
+{
+    const auto before = seal::working_set::stats();
+    ASSERT_TRUE(seal::working_set::reserve(5000, 64 << 20));
+    const auto after = seal::working_set::stats();
+    EXPECT_GE(after.budgetBytes, seal::working_set::estimate(5000, 64 << 20));
+    EXPECT_GE(after.minimum, before.minimum);
+    EXPECT_GE(after.minimum, after.budgetBytes);
+    EXPECT_GT(after.maximum, after.minimum);
+
+    // A smaller vault leaves the quota where it is.
+    ASSERT_TRUE(seal::working_set::reserve(10, 0));
+    EXPECT_EQ(seal::working_set::stats().budgetBytes, after.budgetBytes);
+    EXPECT_EQ(seal::working_set::stats().minimum, after.minimum);
+
+    const std::string line = seal::working_set::report(after);
+    EXPECT_EQ(line.rfind("metric=locked_memory bytes=", 0), 0u);
+    EXPECT_NE(line.find(" budget_bytes=" + std::to_string(after.budgetBytes)), std::string::npos);
+}
+
+TEST(WorkingSetTest, LockedBytesFollowRegionsAndTrimReleasesParkedOnes)
+{
+    ASSERT_TRUE(seal::working_set::reserve(0, 0));
+    seal::Cryptography::trimWorkingSet();
+    const auto base = seal::working_set::stats();
+    {
+        seal::Cryptography::LockedKeyBuffer buf(kRegion, 0x11);
+        const auto held = seal::working_set::stats();
+        EXPECT_EQ(held.lockFailures, base.lockFailures);
+        EXPECT_GE(held.lockedBytes, base.lockedBytes + kRegion);
+        EXPECT_EQ(held.lockedRegions, base.lockedRegions + 1);
+    }
+    // Freed into the pool: wiped but still locked until trimmed.
+    EXPECT_GE(seal::locked_pool::parked(), 1u);
+    EXPECT_GT(seal::working_set::stats().lockedBytes, base.lockedBytes);
+
+    seal::Cryptography::trimWorkingSet();
+    EXPECT_EQ(seal::locked_pool::parked(), 0u);
+    EXPECT_EQ(seal::working_set::stats().lockedBytes, base.lockedBytes);
+}